@@ -148,6 +148,16 @@ declare namespace jsb {
     export let onClose: () => void | undefined;
     export let onWindowLeave: () => void | undefined;
     export let onWindowEnter: () => void | undefined;
+    /**
+     * @en Whether the engine is built with the dedicated server profile, which has no pipeline and only an empty gfx device.
+     * @zh 引擎是否以专用服务器配置构建，该配置没有渲染管线，只有空的 gfx 设备。
+     */
+    export const isDedicatedServer: boolean;
+    /**
+     * @en Called on every fixed step of the ServerWorld which advances animation, only in a dedicated server.
+     * @zh 在推进动画的 ServerWorld 的每个固定步调用，仅用于专用服务器。
+     */
+    export let onServerAnimationStep: (dt: number) => void | undefined;
     export function openURL(url: string): void;
     export function garbageCollect(): void;
     enum AudioFormat {
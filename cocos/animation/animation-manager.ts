@@ -22,6 +22,7 @@
  THE SOFTWARE.
 */
 
+import { JSB } from 'internal:constants';
 import { ccclass } from 'cc.decorator';
 import { System, errorID, cclegacy, js } from '../core';
 import { director, Director, DirectorEvent } from '../game/director';
@@ -162,6 +163,12 @@ export class AnimationManager extends System {
 
 director.on(DirectorEvent.INIT, (): void => {
     const animationManager = new AnimationManager();
+    if (JSB && jsb.isDedicatedServer) {
+        // A dedicated server advances animation on the fixed steps of a ServerWorld instead of the director frames.
+        const step = animationManager.update.bind(animationManager);
+        animationManager.update = (): void => {};
+        jsb.onServerAnimationStep = step;
+    }
     director.registerSystem(AnimationManager.ID, animationManager, System.Priority.HIGH);
 });
 
@@ -23,7 +23,7 @@
  THE SOFTWARE.
 */
 
-import { DEBUG, EDITOR, NATIVE, PREVIEW, TEST, EDITOR_NOT_IN_PREVIEW, WECHAT } from 'internal:constants';
+import { DEBUG, EDITOR, JSB, NATIVE, PREVIEW, TEST, EDITOR_NOT_IN_PREVIEW, WECHAT } from 'internal:constants';
 import { systemInfo } from 'pal/system-info';
 import { findCanvas, loadJsFile } from 'pal/env';
 import { Pacer } from 'pal/pacer';
@@ -628,7 +628,7 @@ export class Game extends EventTarget {
             this.resume();
             this._shouldLoadLaunchScene = true;
         }).then((): Promise<void[]> => {
-            if (WECHAT) {
+            if (WECHAT || this._isDedicatedServer) {
                 return Promise.resolve([]);
             } else {
                 return SplashScreen.createInstance().init();
@@ -822,7 +822,7 @@ export class Game extends EventTarget {
             .then((): Promise<void> => effectSettings.init(settings.querySettings(SettingsCategory.RENDERING, 'effectSettingsPath') as string))
             .then((): void => {
                 // initialize custom render pipeline
-                if (!cclegacy.rendering || !cclegacy.rendering.enableEffectImport) {
+                if (!cclegacy.rendering || !cclegacy.rendering.enableEffectImport || this._isDedicatedServer) {
                     return;
                 }
                 const renderMode = settings.querySettings(SettingsCategory.RENDERING, 'renderMode');
@@ -890,6 +890,10 @@ export class Game extends EventTarget {
             .then((): void | Promise<void> => this._setupRenderPipeline())
             .then((): Promise<any[]> => this._loadPreloadAssets())
             .then((): Promise<void[]> => {
+                // A dedicated server has no pipeline to compile materials for and nothing to show a splash on.
+                if (this._isDedicatedServer) {
+                    return Promise.resolve([]);
+                }
                 builtinResMgr.compileBuiltinMaterial();
                 if (WECHAT) {
                     return Promise.resolve([]);
@@ -1146,7 +1150,14 @@ export class Game extends EventTarget {
         return director.isPersistRootNode(node);
     }
 
+    private get _isDedicatedServer (): boolean {
+        return JSB && jsb.isDedicatedServer;
+    }
+
     private _setupRenderPipeline (): void | Promise<void> {
+        if (this._isDedicatedServer) {
+            return;
+        }
         const usesCustomPipeline = settings.querySettings(
             SettingsCategory.RENDERING,
             'customPipeline',
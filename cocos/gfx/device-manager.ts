@@ -143,7 +143,8 @@ export class DeviceManager {
         const renderMode = settings.querySettings(Settings.Category.RENDERING, 'renderMode') as LegacyRenderMode;
         this._canvas = canvas;
         if (this._canvas) { this._canvas.oncontextmenu = (): boolean => false; }
-        this._renderType = this._determineRenderType(renderMode);
+        // A dedicated server never renders, whatever the project settings say.
+        this._renderType = JSB && jsb.isDedicatedServer ? RenderType.HEADLESS : this._determineRenderType(renderMode);
         this._deviceInitialized = false;
         const deviceInfo = new DeviceInfo(bindingMappingInfo);
         // WebGL or WebGPU context created successfully
@@ -179,6 +180,9 @@ export class DeviceManager {
                 }
                 this._initSwapchain();
             }
+        } else if (this._renderType === RenderType.HEADLESS && JSB && jsb.isDedicatedServer) {
+            // The native empty device, there is no swapchain to create.
+            this._gfxDevice = gfx.DeviceManager.create(deviceInfo);
         } else if (this._renderType === RenderType.HEADLESS && cclegacy.EmptyDevice) {
             this._tryInitializeDeviceSync(cclegacy.EmptyDevice, deviceInfo);
             this._initSwapchain();
@@ -27,6 +27,7 @@
 #include "3d/assets/Skeleton.h"
 #include "3d/misc/BufferBlob.h"
 #include "3d/misc/CreateMesh.h"
+#include "3d/misc/MeshOptimizer.h"
 #include "base/std/hash/hash.h"
 #include "core/DataView.h"
 #include "core/assets/RenderingSubMesh.h"
@@ -44,6 +45,8 @@ namespace cc {
 
 namespace {
 
+MeshOptimizeFlagBit defaultOptimizeFlags{MeshOptimizeFlagBit::NONE};
+
 uint32_t getOffset(const gfx::AttributeList &attributes, index_t attributeIndex) {
     uint32_t result = 0;
     for (index_t i = 0; i < attributeIndex; ++i) {
@@ -249,6 +252,40 @@ void convertRG32FToRG16F(const float *src, uint16_t *dst) {
 
 #endif // #if CC_OPTIMIZE_MESH_DATA
 
+// Attributes quantized by MeshOptimizer are read back as the floats they were built from,
+// so callers laying them out in their own float formats (e.g. particles) keep working.
+bool readQuantizedAttribute(const Mesh::IVertexBundle &vertexBundle, uint32_t iAttribute, const uint8_t *src, TypedArray &result) {
+    const auto &attribute = vertexBundle.attributes[iAttribute];
+    float decoded[4];
+    const uint32_t componentCount = MeshOptimizer::decodeAttribute(attribute, src, decoded);
+    if (componentCount == 0) {
+        return false;
+    }
+    const uint32_t vertexCount = vertexBundle.view.count;
+    Float32Array floats(vertexCount * componentCount);
+    for (uint32_t iVertex = 0; iVertex < vertexCount; ++iVertex) {
+        MeshOptimizer::decodeAttribute(attribute, src + vertexBundle.view.stride * iVertex, decoded);
+        for (uint32_t iComponent = 0; iComponent < componentCount; ++iComponent) {
+            floats[componentCount * iVertex + iComponent] = decoded[iComponent];
+        }
+    }
+    result = std::move(floats);
+    return true;
+}
+
+bool copyQuantizedAttribute(const Mesh::IVertexBundle &vertexBundle, uint32_t iAttribute, const uint8_t *src, uint8_t *dst, uint32_t stride) {
+    const auto &attribute = vertexBundle.attributes[iAttribute];
+    float decoded[4];
+    if (MeshOptimizer::decodeAttribute(attribute, src, decoded) == 0) {
+        return false;
+    }
+    for (uint32_t iVertex = 0; iVertex < vertexBundle.view.count; ++iVertex) {
+        const uint32_t componentCount = MeshOptimizer::decodeAttribute(attribute, src + vertexBundle.view.stride * iVertex, decoded);
+        memcpy(dst + stride * iVertex, decoded, componentCount * sizeof(float));
+    }
+    return true;
+}
+
 } // namespace
 
 void MeshUtils::dequantizeMesh(Mesh::IStruct &structInfo, Uint8Array &data) {
@@ -458,6 +495,25 @@ void Mesh::initialize() {
     if (_struct.quantized && !hasFlag(gfx::Device::getInstance()->getFormatFeatures(gfx::Format::RG16F), gfx::FormatFeature::VERTEX_ATTRIBUTE)) {
         MeshUtils::dequantizeMesh(_struct, _data);
     }
+    ccstd::vector<ccstd::vector<Meshlet>> meshlets;
+#if !CC_EDITOR
+    if (!_struct.dynamic.has_value() && _data.buffer()) {
+        auto optimizeFlags = _optimizeFlags.value_or(defaultOptimizeFlags);
+        // quantized attributes are normalized 16 bit integers
+        auto *device = gfx::Device::getInstance();
+        for (const auto format : {gfx::Format::RG16I, gfx::Format::RGBA16I, gfx::Format::RG16UI}) {
+            if (!hasFlag(device->getFormatFeatures(format), gfx::FormatFeature::VERTEX_ATTRIBUTE)) {
+                removeFlags(optimizeFlags, MeshOptimizeFlagBit::QUANTIZE | MeshOptimizeFlagBit::OCTAHEDRAL_NORMAL);
+            }
+        }
+        if (optimizeFlags != MeshOptimizeFlagBit::NONE) {
+            MeshOptimizer::optimize(_struct, _data, optimizeFlags, &_optimizeReport, &meshlets);
+            CC_LOG_DEBUG("Mesh optimized, vertex bytes %u -> %u, ACMR %.3f -> %.3f",
+                         _optimizeReport.vertexBytesBefore, _optimizeReport.vertexBytesAfter,
+                         _optimizeReport.acmrBefore, _optimizeReport.acmrAfter);
+        }
+    }
+#endif
 
     if (_struct.dynamic.has_value()) {
         auto *device = gfx::Device::getInstance();
@@ -594,6 +650,19 @@ void Mesh::initialize() {
             auto *subMesh = ccnew RenderingSubMesh(vbReference, gfxAttributes, prim.primitiveMode, indexBuffer);
             subMesh->setMesh(this);
             subMesh->setSubMeshIdx(static_cast<uint32_t>(i));
+            if (i < meshlets.size() && !meshlets[i].empty()) {
+                const auto &idxView = prim.indexView.value();
+                const uint8_t *ib = buffer.buffer()->getData() + idxView.offset;
+                ccstd::vector<uint32_t> indices(idxView.count);
+                for (uint32_t j = 0; j < idxView.count; ++j) {
+                    switch (idxView.stride) {
+                        case 1: indices[j] = ib[j]; break;
+                        case 2: indices[j] = reinterpret_cast<const uint16_t *>(ib)[j]; break;
+                        default: indices[j] = reinterpret_cast<const uint32_t *>(ib)[j]; break;
+                    }
+                }
+                subMesh->setMeshlets(std::move(meshlets[i]), std::move(indices));
+            }
 
             subMeshes.emplace_back(subMesh);
         }
@@ -613,6 +682,14 @@ void Mesh::initialize() {
     }
 }
 
+void Mesh::setDefaultOptimizeFlags(MeshOptimizeFlagBit flags) {
+    defaultOptimizeFlags = flags;
+}
+
+MeshOptimizeFlagBit Mesh::getDefaultOptimizeFlags() {
+    return defaultOptimizeFlags;
+}
+
 void Mesh::destroyRenderingMesh() {
     if (!_renderingSubMeshes.empty()) {
         for (auto &submesh : _renderingSubMeshes) {
@@ -1068,7 +1145,12 @@ TypedArray Mesh::readAttribute(index_t primitiveIndex, const char *attributeName
             return;
         }
 
-        DataView inputView(_data.buffer(), vertexBundle.view.offset + getOffset(vertexBundle.attributes, static_cast<index_t>(iAttribute)));
+        const uint32_t attributeOffset = vertexBundle.view.offset + getOffset(vertexBundle.attributes, static_cast<index_t>(iAttribute));
+        if (readQuantizedAttribute(vertexBundle, iAttribute, _data.buffer()->getData() + attributeOffset, result)) {
+            return;
+        }
+
+        DataView inputView(_data.buffer(), attributeOffset);
 
         const auto &formatInfo = gfx::GFX_FORMAT_INFOS[static_cast<uint32_t>(format)];
 
@@ -1099,8 +1181,13 @@ bool Mesh::copyAttribute(index_t primitiveIndex, const char *attributeName, Arra
             return;
         }
         const gfx::Format format = vertexBundle.attributes[iAttribute].format;
+        const uint32_t attributeOffset = vertexBundle.view.offset + getOffset(vertexBundle.attributes, static_cast<index_t>(iAttribute));
+        if (copyQuantizedAttribute(vertexBundle, iAttribute, _data.buffer()->getData() + attributeOffset, buffer->getData() + offset, stride)) {
+            written = true;
+            return;
+        }
 
-        DataView inputView(_data.buffer(), vertexBundle.view.offset + getOffset(vertexBundle.attributes, static_cast<index_t>(iAttribute)));
+        DataView inputView(_data.buffer(), attributeOffset);
 
         DataView outputView(buffer, offset);
 
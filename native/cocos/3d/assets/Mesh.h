@@ -39,6 +39,41 @@ namespace cc {
 class Skeleton;
 class RenderingSubMesh;
 
+/**
+ * @en Optimizations applied to the data of static meshes when they are initialized.
+ * @zh 静态网格初始化时对网格数据执行的优化。
+ */
+enum class MeshOptimizeFlagBit : uint32_t {
+    NONE = 0,
+    // Reorder triangles for the post-transform vertex cache.
+    VERTEX_CACHE = 0x1,
+    // Reorder triangle clusters to reduce overdraw, keeps most of the vertex cache gain.
+    OVERDRAW = 0x2,
+    // Reorder vertices in the order they are first used and drop unused ones. Skipped for meshes with morph targets.
+    VERTEX_FETCH = 0x4,
+    // Normals and tangents to snorm16, texture coordinates inside [0, 1] to unorm16. Transparent to shaders.
+    QUANTIZE = 0x8,
+    // Normals to octahedral snorm16x2, shaders decode them with CC_USE_OCT_NORMAL.
+    OCTAHEDRAL_NORMAL = 0x10,
+    ALL = VERTEX_CACHE | OVERDRAW | VERTEX_FETCH | QUANTIZE | OCTAHEDRAL_NORMAL,
+    // Split triangle lists into meshlets for per cluster culling, see Model::setClusterCulling.
+    // Replaces the overdraw order, the vertex cache order is kept inside each meshlet.
+    MESHLETS = 0x20,
+};
+CC_ENUM_BITWISE_OPERATORS(MeshOptimizeFlagBit);
+
+/**
+ * @en The result of the mesh optimizations.
+ * @zh 网格优化的结果。
+ */
+struct MeshOptimizeReport {
+    uint32_t vertexBytesBefore{0};
+    uint32_t vertexBytesAfter{0};
+    // Average cache miss ratio (transformed vertices per triangle) of the indexed triangle lists.
+    float acmrBefore{0.F};
+    float acmrAfter{0.F};
+};
+
 /**
  * @en Mesh asset
  * @zh 网格资源。
@@ -316,6 +351,25 @@ public:
 
     void initialize();
 
+    /**
+     * @en Set the optimizations applied to static meshes initialized afterwards, none by default.
+     * @zh 设置之后初始化的静态网格默认执行的优化，默认不执行。
+     */
+    static void setDefaultOptimizeFlags(MeshOptimizeFlagBit flags);
+    static MeshOptimizeFlagBit getDefaultOptimizeFlags();
+
+    /**
+     * @en Override the optimizations of this mesh, it takes effect only before the mesh is initialized.
+     * @zh 设置此网格执行的优化，仅在网格初始化前生效。
+     */
+    inline void setOptimizeFlags(MeshOptimizeFlagBit flags) { _optimizeFlags = flags; }
+
+    /**
+     * @en The bytes and vertex cache efficiency gained by the optimizations.
+     * @zh 网格优化节省的字节数与顶点缓存效率。
+     */
+    inline const MeshOptimizeReport &getOptimizeReport() const { return _optimizeReport; }
+
     /**
      * @en Destroy the mesh and release all related GPU resources
      * @zh 销毁此网格，并释放它占有的所有 GPU 资源。
@@ -486,6 +540,9 @@ private:
     bool _allowDataAccess{true};
     bool _isMeshDataUploaded{false};
 
+    ccstd::optional<MeshOptimizeFlagBit> _optimizeFlags;
+    MeshOptimizeReport _optimizeReport;
+
     RenderingSubMeshList _renderingSubMeshes;
 
     ccstd::unordered_map<uint64_t, BoneSpaceBounds> _boneSpaceBounds;
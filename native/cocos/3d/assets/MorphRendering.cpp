@@ -24,6 +24,7 @@
 
 #include "3d/assets/MorphRendering.h"
 
+#include <cstring>
 #include <memory>
 #include "3d/assets/Mesh.h"
 #include "3d/assets/Morph.h"
@@ -37,8 +38,73 @@
 #include "renderer/pipeline/Define.h"
 #include "scene/Pass.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define CC_MORPH_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define CC_MORPH_NEON 1
+#endif
+
 namespace cc {
 
+CpuMorphAttributeTarget createCpuMorphAttributeTarget(const Float32Array &displacements, uint32_t nVertices) {
+    CpuMorphAttributeTarget target;
+    for (uint32_t iVertex = 0; iVertex < nVertices; ++iVertex) {
+        if (displacements[3 * iVertex + 0] != 0.F || displacements[3 * iVertex + 1] != 0.F || displacements[3 * iVertex + 2] != 0.F) {
+            target.vertexIndices.emplace_back(iVertex);
+        }
+    }
+
+    const bool sparse = static_cast<float>(target.vertexIndices.size()) < static_cast<float>(nVertices) * MORPH_SPARSE_TARGET_RATIO;
+    if (!sparse) {
+        target.vertexIndices.clear();
+        target.vertexIndices.shrink_to_fit();
+    }
+    const auto nEntries = static_cast<uint32_t>(sparse ? target.vertexIndices.size() : nVertices);
+    target.displacements.resize(4 * nEntries, 0.F);
+    for (uint32_t iEntry = 0; iEntry < nEntries; ++iEntry) {
+        const uint32_t iVertex = sparse ? target.vertexIndices[iEntry] : iEntry;
+        target.displacements[4 * iEntry + 0] = displacements[3 * iVertex + 0];
+        target.displacements[4 * iEntry + 1] = displacements[3 * iVertex + 1];
+        target.displacements[4 * iEntry + 2] = displacements[3 * iVertex + 2];
+    }
+    return target;
+}
+
+namespace {
+
+// dst.xyzw += src.xyzw * weight
+inline void accumulateVec4(float *dst, const float *src, float weight) {
+#if CC_MORPH_SSE2
+    _mm_storeu_ps(dst, _mm_add_ps(_mm_loadu_ps(dst), _mm_mul_ps(_mm_loadu_ps(src), _mm_set1_ps(weight))));
+#elif CC_MORPH_NEON
+    vst1q_f32(dst, vmlaq_n_f32(vld1q_f32(dst), vld1q_f32(src), weight));
+#else
+    dst[0] += src[0] * weight;
+    dst[1] += src[1] * weight;
+    dst[2] += src[2] * weight;
+    dst[3] += src[3] * weight;
+#endif
+}
+
+} // namespace
+
+void accumulateDisplacements(float *values, const CpuMorphAttributeTarget &target, float weight) {
+    const float *displacements = target.displacements.data();
+    const auto nEntries = static_cast<uint32_t>(target.displacements.size() / 4);
+    if (target.vertexIndices.empty()) {
+        for (uint32_t iEntry = 0; iEntry < nEntries; ++iEntry) {
+            accumulateVec4(values + 4 * iEntry, displacements + 4 * iEntry, weight);
+        }
+    } else {
+        const uint32_t *vertexIndices = target.vertexIndices.data();
+        for (uint32_t iEntry = 0; iEntry < nEntries; ++iEntry) {
+            accumulateVec4(values + 4 * vertexIndices[iEntry], displacements + 4 * iEntry, weight);
+        }
+    }
+}
+
 MorphRendering *createMorphRendering(Mesh *mesh, gfx::Device *gfxDevice) {
     return ccnew StdMorphRendering(mesh, gfxDevice);
 }
@@ -116,6 +182,13 @@ public:
         return _valueView;
     }
 
+    /**
+     * Raw pixel values, 4 floats per pixel.
+     */
+    float *getValues() {
+        return reinterpret_cast<float *>(_arrayBuffer->getData());
+    }
+
     /**
      * Destroy the texture. Release its GPU resources.
      */
@@ -167,10 +240,6 @@ struct GpuMorphAttribute {
     IntrusivePtr<MorphTexture> morphTexture;
 };
 
-struct CpuMorphAttributeTarget {
-    Float32Array displacements;
-};
-
 using CpuMorphAttributeTargetList = ccstd::vector<CpuMorphAttributeTarget>;
 
 struct CpuMorphAttribute {
@@ -333,10 +402,12 @@ public:
 
     SubMeshMorphRenderingInstance *createInstance() override;
     const ccstd::vector<CpuMorphAttribute> &getData() const;
+    inline uint32_t getVerticesCount() const { return _verticesCount; }
 
 private:
     ccstd::vector<CpuMorphAttribute> _attributes;
     gfx::Device *_gfxDevice{nullptr};
+    uint32_t _verticesCount{0};
 };
 
 class GpuComputing final : public SubMeshMorphRendering {
@@ -361,6 +432,7 @@ class CpuComputingRenderingInstance final : public SubMeshMorphRenderingInstance
 public:
     explicit CpuComputingRenderingInstance(CpuComputing *owner, uint32_t nVertices, gfx::Device *gfxDevice) {
         _owner = owner; //NOTE: release by mesh`s destroy, it`ll call current instance`s destroy method
+        _verticesCount = nVertices;
         _morphUniforms = ccnew MorphUniforms(gfxDevice, 0 /* TODO? */);
 
         auto vec4TextureFactory = createVec4TextureFactory(gfxDevice, nVertices);
@@ -373,28 +445,23 @@ public:
     }
 
     void setWeights(const ccstd::vector<float> &weights) override {
+        if (weights == _weights) {
+            return;
+        }
+        _weights = weights;
+
         for (size_t iAttribute = 0; iAttribute < _attributes.size(); ++iAttribute) {
             const auto &myAttribute = _attributes[iAttribute];
-            Float32Array &valueView = myAttribute.morphTexture->getValueView();
+            float *values = myAttribute.morphTexture->getValues();
             const auto &attributeMorph = _owner->getData()[iAttribute];
             CC_ASSERT(weights.size() == attributeMorph.targets.size());
+            memset(values, 0, sizeof(float) * 4 * _verticesCount);
             for (size_t iTarget = 0; iTarget < attributeMorph.targets.size(); ++iTarget) {
-                const auto &targetDisplacements = attributeMorph.targets[iTarget].displacements;
                 const float weight = weights[iTarget];
-                const uint32_t nVertices = targetDisplacements.length() / 3;
-                if (iTarget == 0) {
-                    for (uint32_t iVertex = 0; iVertex < nVertices; ++iVertex) {
-                        valueView[4 * iVertex + 0] = targetDisplacements[3 * iVertex + 0] * weight;
-                        valueView[4 * iVertex + 1] = targetDisplacements[3 * iVertex + 1] * weight;
-                        valueView[4 * iVertex + 2] = targetDisplacements[3 * iVertex + 2] * weight;
-                    }
-                } else if (std::fabs(weight) >= std::numeric_limits<float>::epsilon()) {
-                    for (uint32_t iVertex = 0; iVertex < nVertices; ++iVertex) {
-                        valueView[4 * iVertex + 0] += targetDisplacements[3 * iVertex + 0] * weight;
-                        valueView[4 * iVertex + 1] += targetDisplacements[3 * iVertex + 1] * weight;
-                        valueView[4 * iVertex + 2] += targetDisplacements[3 * iVertex + 2] * weight;
-                    }
+                if (std::fabs(weight) < std::numeric_limits<float>::epsilon()) {
+                    continue;
                 }
+                accumulateDisplacements(values, attributeMorph.targets[iTarget], weight);
             }
 
             myAttribute.morphTexture->updatePixels();
@@ -442,6 +509,8 @@ private:
     ccstd::vector<GpuMorphAttribute> _attributes;
     IntrusivePtr<CpuComputing> _owner;
     IntrusivePtr<MorphUniforms> _morphUniforms;
+    ccstd::vector<float> _weights;
+    uint32_t _verticesCount{0};
 };
 
 class GpuComputingRenderingInstance final : public SubMeshMorphRenderingInstance {
@@ -503,21 +572,21 @@ CpuComputing::CpuComputing(Mesh *mesh, uint32_t subMeshIndex, const Morph *morph
     const auto &subMeshMorph = morph->subMeshMorphs[subMeshIndex].value();
     enableVertexId(mesh, subMeshIndex, gfxDevice);
 
+    _verticesCount = mesh->getStruct().vertexBundles[mesh->getStruct().primitives[subMeshIndex].vertexBundelIndices[0]].view.count;
+
     for (size_t attributeIndex = 0, len = subMeshMorph.attributes.size(); attributeIndex < len; ++attributeIndex) {
         const auto &attributeName = subMeshMorph.attributes[attributeIndex];
 
         CpuMorphAttribute attr;
         attr.name = attributeName;
-        attr.targets.resize(subMeshMorph.targets.size());
+        attr.targets.reserve(subMeshMorph.targets.size());
 
-        uint32_t i = 0;
         for (const auto &attributeDisplacement : subMeshMorph.targets) {
             const Mesh::IBufferView &displacementsView = attributeDisplacement.displacements[attributeIndex];
-            attr.targets[i].displacements = Float32Array(mesh->getData().buffer(),
-                                                         mesh->getData().byteOffset() + displacementsView.offset,
-                                                         attributeDisplacement.displacements[attributeIndex].count);
-
-            ++i;
+            Float32Array displacements(mesh->getData().buffer(),
+                                       mesh->getData().byteOffset() + displacementsView.offset,
+                                       displacementsView.count);
+            attr.targets.emplace_back(createCpuMorphAttributeTarget(displacements, std::min(_verticesCount, displacementsView.count / 3)));
         }
 
         _attributes.emplace_back(attr);
@@ -527,7 +596,7 @@ CpuComputing::CpuComputing(Mesh *mesh, uint32_t subMeshIndex, const Morph *morph
 SubMeshMorphRenderingInstance *CpuComputing::createInstance() {
     return ccnew CpuComputingRenderingInstance(
         this,
-        _attributes[0].targets[0].displacements.length() / 3,
+        _verticesCount,
         _gfxDevice);
 }
 
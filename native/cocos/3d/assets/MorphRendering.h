@@ -39,6 +39,31 @@ class Device;
 class DescriptorSet;
 } // namespace gfx
 
+/**
+ * Targets displacing fewer vertices than this ratio are stored sparsely.
+ */
+constexpr float MORPH_SPARSE_TARGET_RATIO = 0.75F;
+
+/**
+ * Displacements of one morph target used by CPU blending, padded to vec4 for SIMD accumulation.
+ * Only displaced vertices are kept, unless most of the vertices are displaced,
+ * in that case `vertexIndices` is empty and all vertices are stored in order.
+ */
+struct CpuMorphAttributeTarget {
+    ccstd::vector<uint32_t> vertexIndices;
+    ccstd::vector<float> displacements;
+};
+
+/**
+ * Converts the vec3 displacements of the first `nVertices` vertices of a morph target.
+ */
+CpuMorphAttributeTarget createCpuMorphAttributeTarget(const Float32Array &displacements, uint32_t nVertices);
+
+/**
+ * Adds the weighted displacements of a target to `values`, 4 floats per vertex.
+ */
+void accumulateDisplacements(float *values, const CpuMorphAttributeTarget &target, float weight);
+
 /**
  * @en The instance of [[MorphRendering]] for dedicated control in the mesh renderer.
  * The root [[MorphRendering]] is owned by [[Mesh]] asset, each [[MeshRenderer]] can have its own morph rendering instance.
@@ -0,0 +1,278 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "3d/misc/MeshCluster.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include "core/geometry/Frustum.h"
+
+namespace cc {
+
+namespace {
+
+// below this the cone covers about a hemisphere and rarely culls anything
+constexpr float MIN_CONE_DOT = 0.1F;
+constexpr uint32_t MORTON_BITS = 10;
+
+uint32_t expandBits(uint32_t v) {
+    v = (v | (v << 16)) & 0x030000FFU;
+    v = (v | (v << 8)) & 0x0300F00FU;
+    v = (v | (v << 4)) & 0x030C30C3U;
+    v = (v | (v << 2)) & 0x09249249U;
+    return v;
+}
+
+uint32_t mortonCode(const Vec3 &p, const Vec3 &min, const Vec3 &invExtent) {
+    constexpr float SCALE = static_cast<float>((1U << MORTON_BITS) - 1);
+    const auto quantize = [](float v) {
+        return static_cast<uint32_t>(std::min(std::max(v, 0.F), 1.F) * SCALE);
+    };
+    return expandBits(quantize((p.x - min.x) * invExtent.x)) |
+           (expandBits(quantize((p.y - min.y) * invExtent.y)) << 1) |
+           (expandBits(quantize((p.z - min.z) * invExtent.z)) << 2);
+}
+
+// one of the six axis directions the face normal is closest to
+uint32_t facingBucket(const Vec3 &n) {
+    const float ax = std::abs(n.x);
+    const float ay = std::abs(n.y);
+    const float az = std::abs(n.z);
+    if (ax >= ay && ax >= az) return n.x >= 0.F ? 0 : 1;
+    if (ay >= az) return n.y >= 0.F ? 2 : 3;
+    return n.z >= 0.F ? 4 : 5;
+}
+
+inline Vec3 readPosition(const float *positions, uint32_t stride, uint32_t index) {
+    const float *p = positions + static_cast<size_t>(index) * stride;
+    return {p[0], p[1], p[2]};
+}
+
+void computeBounds(Meshlet &meshlet, const uint32_t *indices, const float *positions, uint32_t stride) {
+    Vec3 min{FLT_MAX, FLT_MAX, FLT_MAX};
+    Vec3 max{-FLT_MAX, -FLT_MAX, -FLT_MAX};
+    for (uint32_t i = 0; i < meshlet.indexCount; ++i) {
+        const Vec3 p = readPosition(positions, stride, indices[i]);
+        min.set(std::min(min.x, p.x), std::min(min.y, p.y), std::min(min.z, p.z));
+        max.set(std::max(max.x, p.x), std::max(max.y, p.y), std::max(max.z, p.z));
+    }
+    meshlet.center = (min + max) * 0.5F;
+    float radiusSquared = 0.F;
+    for (uint32_t i = 0; i < meshlet.indexCount; ++i) {
+        radiusSquared = std::max(radiusSquared, meshlet.center.distanceSquared(readPosition(positions, stride, indices[i])));
+    }
+    meshlet.radius = std::sqrt(radiusSquared);
+
+    // normal cone, see "Optimizing the Graphics Pipeline with Compute", GDC 2016
+    Vec3 axis;
+    for (uint32_t i = 0; i < meshlet.indexCount; i += 3) {
+        const Vec3 a = readPosition(positions, stride, indices[i]);
+        const Vec3 b = readPosition(positions, stride, indices[i + 1]);
+        const Vec3 c = readPosition(positions, stride, indices[i + 2]);
+        Vec3 n;
+        Vec3::cross(b - a, c - a, &n);
+        if (n.lengthSquared() > 0.F) {
+            n.normalize();
+            axis += n;
+        }
+    }
+    meshlet.coneCutoff = 1.F;
+    if (axis.lengthSquared() <= 0.F) {
+        return;
+    }
+    axis.normalize();
+
+    float minDot = 1.F;
+    float maxT = 0.F;
+    for (uint32_t i = 0; i < meshlet.indexCount; i += 3) {
+        const Vec3 a = readPosition(positions, stride, indices[i]);
+        const Vec3 b = readPosition(positions, stride, indices[i + 1]);
+        const Vec3 c = readPosition(positions, stride, indices[i + 2]);
+        Vec3 n;
+        Vec3::cross(b - a, c - a, &n);
+        if (n.lengthSquared() <= 0.F) {
+            continue;
+        }
+        n.normalize();
+        const float dn = Vec3::dot(axis, n);
+        minDot = std::min(minDot, dn);
+        if (dn > 0.F) {
+            // move the apex back along the axis until it is behind every triangle plane
+            maxT = std::max(maxT, Vec3::dot(meshlet.center - a, n) / dn);
+        }
+    }
+    if (minDot <= MIN_CONE_DOT) {
+        return;
+    }
+    meshlet.coneAxis = axis;
+    meshlet.coneApex = meshlet.center - axis * maxT;
+    meshlet.coneCutoff = std::sqrt(1.F - minDot * minDot);
+}
+
+inline bool isSphereInFrustum(const Vec3 &center, float radius, const geometry::Frustum &frustum) {
+    for (const auto &plane : frustum.planes) {
+        // frustum plane normal points to the inside
+        if (Vec3::dot(plane->n, center) + radius < plane->d) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+ccstd::vector<Meshlet> MeshCluster::build(ccstd::vector<uint32_t> &indices, const float *positions, uint32_t positionStride, uint32_t vertexCount, uint32_t maxTriangles) {
+    ccstd::vector<Meshlet> meshlets;
+    const auto triangleCount = static_cast<uint32_t>(indices.size() / 3);
+    if (triangleCount == 0 || vertexCount == 0 || maxTriangles == 0) {
+        return meshlets;
+    }
+
+    Vec3 min{FLT_MAX, FLT_MAX, FLT_MAX};
+    Vec3 max{-FLT_MAX, -FLT_MAX, -FLT_MAX};
+    for (uint32_t i = 0; i < vertexCount; ++i) {
+        const Vec3 p = readPosition(positions, positionStride, i);
+        min.set(std::min(min.x, p.x), std::min(min.y, p.y), std::min(min.z, p.z));
+        max.set(std::max(max.x, p.x), std::max(max.y, p.y), std::max(max.z, p.z));
+    }
+    const Vec3 extent = max - min;
+    const Vec3 invExtent{extent.x > 0.F ? 1.F / extent.x : 0.F, extent.y > 0.F ? 1.F / extent.y : 0.F, extent.z > 0.F ? 1.F / extent.z : 0.F};
+
+    // facing bucket in the high bits, morton code of the centroid in the low bits
+    ccstd::vector<std::pair<uint64_t, uint32_t>> keys(triangleCount);
+    for (uint32_t t = 0; t < triangleCount; ++t) {
+        const Vec3 a = readPosition(positions, positionStride, indices[t * 3]);
+        const Vec3 b = readPosition(positions, positionStride, indices[t * 3 + 1]);
+        const Vec3 c = readPosition(positions, positionStride, indices[t * 3 + 2]);
+        Vec3 n;
+        Vec3::cross(b - a, c - a, &n);
+        const Vec3 centroid = (a + b + c) / 3.F;
+        keys[t] = {(static_cast<uint64_t>(facingBucket(n)) << 32) | mortonCode(centroid, min, invExtent), t};
+    }
+    std::stable_sort(keys.begin(), keys.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.first < rhs.first;
+    });
+
+    ccstd::vector<uint32_t> sorted(indices.size());
+    for (uint32_t t = 0; t < triangleCount; ++t) {
+        memcpy(&sorted[t * 3], &indices[keys[t].second * 3], sizeof(uint32_t) * 3);
+    }
+    indices.swap(sorted);
+
+    uint32_t first = 0;
+    while (first < triangleCount) {
+        const uint32_t bucket = static_cast<uint32_t>(keys[first].first >> 32);
+        uint32_t last = first + 1;
+        while (last < triangleCount && last - first < maxTriangles && static_cast<uint32_t>(keys[last].first >> 32) == bucket) {
+            ++last;
+        }
+        Meshlet meshlet;
+        meshlet.firstIndex = first * 3;
+        meshlet.indexCount = (last - first) * 3;
+        computeBounds(meshlet, indices.data() + meshlet.firstIndex, positions, positionStride);
+        meshlets.emplace_back(meshlet);
+        first = last;
+    }
+    return meshlets;
+}
+
+uint32_t MeshCluster::cull(const ccstd::vector<Meshlet> &meshlets, const uint32_t *indices, const Mat4 &worldMatrix,
+                           const MeshletCullingView *views, uint32_t viewCount, bool backfaceCulling, uint32_t *out,
+                           MeshletCullingStats *stats) {
+    Vec3 scale;
+    worldMatrix.getScale(&scale);
+    const float maxScale = std::max(std::max(std::abs(scale.x), std::abs(scale.y)), std::abs(scale.z));
+    const float minScale = std::min(std::min(std::abs(scale.x), std::abs(scale.y)), std::abs(scale.z));
+    // the cone can't be transformed by non uniform scales, and mirroring flips the winding
+    const bool coneTest = backfaceCulling && maxScale - minScale <= maxScale * 1e-3F && worldMatrix.determinant() > 0.F;
+
+    uint32_t outCount = 0;
+    uint32_t rangeBegin = 0;
+    uint32_t rangeCount = 0;
+    const auto flush = [&]() {
+        if (rangeCount > 0) {
+            memcpy(out + outCount, indices + rangeBegin, sizeof(uint32_t) * rangeCount);
+            outCount += rangeCount;
+            rangeCount = 0;
+        }
+    };
+
+    MeshletCullingStats result;
+    result.meshletCount = static_cast<uint32_t>(meshlets.size());
+    for (const auto &meshlet : meshlets) {
+        result.triangleCount += meshlet.indexCount / 3;
+
+        Vec3 center;
+        Vec3::transformMat4(meshlet.center, worldMatrix, &center);
+        const float radius = meshlet.radius * maxScale;
+        Vec3 apex;
+        Vec3 axis;
+        const bool testCone = coneTest && meshlet.coneCutoff < 1.F;
+        if (testCone) {
+            Vec3::transformMat4(meshlet.coneApex, worldMatrix, &apex);
+            Vec3::transformMat4Normal(meshlet.coneAxis, worldMatrix, &axis);
+            axis.normalize();
+        }
+
+        bool visible = false;
+        for (uint32_t i = 0; i < viewCount && !visible; ++i) {
+            const auto &view = views[i];
+            if (view.frustum && !isSphereInFrustum(center, radius, *view.frustum)) {
+                continue;
+            }
+            if (testCone && view.perspective) {
+                Vec3 dir = apex - view.position;
+                dir.normalize();
+                if (Vec3::dot(dir, axis) >= meshlet.coneCutoff) {
+                    continue;
+                }
+            }
+            visible = true;
+        }
+
+        if (!visible) {
+            result.culledTriangles += meshlet.indexCount / 3;
+            continue;
+        }
+        ++result.visibleMeshlets;
+        // merge adjacent visible meshlets into one copy
+        if (rangeCount > 0 && rangeBegin + rangeCount != meshlet.firstIndex) {
+            flush();
+        }
+        if (rangeCount == 0) {
+            rangeBegin = meshlet.firstIndex;
+        }
+        rangeCount += meshlet.indexCount;
+    }
+    flush();
+
+    if (stats) {
+        *stats = result;
+    }
+    return outCount;
+}
+
+} // namespace cc
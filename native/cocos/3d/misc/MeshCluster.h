@@ -0,0 +1,97 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include "base/std/container/vector.h"
+#include "math/Mat4.h"
+#include "math/Vec3.h"
+
+namespace cc {
+
+namespace geometry {
+class Frustum;
+} // namespace geometry
+
+/**
+ * @en A small cluster of triangles, culled as a whole, stored as a range of the index buffer.
+ * @zh 作为整体剔除的一小簇三角形，对应索引缓冲中的一段区间。
+ */
+struct Meshlet {
+    uint32_t firstIndex{0};
+    uint32_t indexCount{0};
+    // bounding sphere
+    Vec3 center;
+    float radius{0.F};
+    // normal cone, the meshlet faces away from any viewer for which
+    // dot(normalize(coneApex - viewer), coneAxis) >= coneCutoff, a cutoff of 1 disables the test
+    Vec3 coneApex;
+    Vec3 coneAxis;
+    float coneCutoff{1.F};
+};
+
+/**
+ * @en A viewer the meshlets are culled against, a meshlet is kept if any viewer sees it.
+ * @zh 用于剔除网格簇的观察者，任一观察者可见即保留。
+ */
+struct MeshletCullingView {
+    const geometry::Frustum *frustum{nullptr};
+    Vec3 position;
+    // orthographic views skip the normal cone test
+    bool perspective{true};
+};
+
+struct MeshletCullingStats {
+    uint32_t meshletCount{0};
+    uint32_t visibleMeshlets{0};
+    uint32_t triangleCount{0};
+    uint32_t culledTriangles{0};
+};
+
+class MeshCluster final {
+public:
+    static constexpr uint32_t MAX_MESHLET_TRIANGLES = 128;
+
+    /**
+     * @en Splits a triangle list into meshlets, the indices are reordered so that every meshlet is a contiguous range.
+     * Triangles are grouped by facing first, then by position, to keep the normal cones narrow.
+     * @zh 将三角形列表切分为网格簇，索引会被重排使每个网格簇连续。
+     * @param indices Triangle list indices, reordered in place.
+     * @param positions Vertex positions, `positionStride` floats apart.
+     */
+    static ccstd::vector<Meshlet> build(ccstd::vector<uint32_t> &indices, const float *positions, uint32_t positionStride, uint32_t vertexCount,
+                                        uint32_t maxTriangles = MAX_MESHLET_TRIANGLES);
+
+    /**
+     * @en Culls the meshlets against the views and writes the indices of the visible ones to `out`, which must hold all indices.
+     * @zh 使用观察者剔除网格簇，将可见网格簇的索引紧凑地写入 `out`，`out` 必须能容纳全部索引。
+     * @param backfaceCulling Whether the normal cone test applies, only if the material culls back faces.
+     * @return The number of indices written.
+     */
+    static uint32_t cull(const ccstd::vector<Meshlet> &meshlets, const uint32_t *indices, const Mat4 &worldMatrix,
+                         const MeshletCullingView *views, uint32_t viewCount, bool backfaceCulling, uint32_t *out,
+                         MeshletCullingStats *stats = nullptr);
+};
+
+} // namespace cc
@@ -0,0 +1,458 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "3d/misc/MeshOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "meshopt/meshoptimizer.h"
+
+namespace cc {
+
+namespace {
+
+enum class Conversion {
+    COPY,
+    SNORM16,
+    UNORM16,
+    OCTAHEDRAL,
+};
+
+struct AttributeConversion {
+    Conversion conversion{Conversion::COPY};
+    uint32_t srcOffset{0};
+    uint32_t srcSize{0};
+    uint32_t dstOffset{0};
+    uint32_t components{0};
+};
+
+uint32_t getFormatSize(gfx::Format format) {
+    return gfx::GFX_FORMAT_INFOS[static_cast<uint32_t>(format)].size;
+}
+
+bool isTexCoord(const ccstd::string &name) {
+    return name.compare(0, strlen(gfx::ATTR_NAME_TEX_COORD), gfx::ATTR_NAME_TEX_COORD) == 0;
+}
+
+int16_t quantizeSnorm16(float v) {
+    return static_cast<int16_t>(std::lround(std::max(-1.F, std::min(1.F, v)) * 32767.F));
+}
+
+uint16_t quantizeUnorm16(float v) {
+    return static_cast<uint16_t>(std::lround(std::max(0.F, std::min(1.F, v)) * 65535.F));
+}
+
+bool readIndices(const uint8_t *bytes, const Mesh::IBufferView &view, ccstd::vector<uint32_t> &indices) {
+    indices.resize(view.count);
+    const uint8_t *src = bytes + view.offset;
+    for (uint32_t i = 0; i < view.count; ++i) {
+        switch (view.stride) {
+            case 1: indices[i] = src[i]; break;
+            case 2: {
+                uint16_t index;
+                memcpy(&index, src + i * 2, 2);
+                indices[i] = index;
+            } break;
+            case 4: memcpy(&indices[i], src + i * 4, 4); break;
+            default: return false;
+        }
+    }
+    return true;
+}
+
+void writeIndices(uint8_t *bytes, const Mesh::IBufferView &view, const ccstd::vector<uint32_t> &indices) {
+    uint8_t *dst = bytes + view.offset;
+    const auto count = std::min(view.count, static_cast<uint32_t>(indices.size()));
+    for (uint32_t i = 0; i < count; ++i) {
+        switch (view.stride) {
+            case 1: dst[i] = static_cast<uint8_t>(indices[i]); break;
+            case 2: {
+                const auto index = static_cast<uint16_t>(indices[i]);
+                memcpy(dst + i * 2, &index, 2);
+            } break;
+            default: memcpy(dst + i * 4, &indices[i], 4); break;
+        }
+    }
+}
+
+bool isIndexedTriangleList(const Mesh::ISubMesh &primitive) {
+    return primitive.indexView.has_value() && primitive.primitiveMode == gfx::PrimitiveMode::TRIANGLE_LIST &&
+           !primitive.cluster.has_value() && !primitive.vertexBundelIndices.empty();
+}
+
+bool readPositions(const uint8_t *bytes, const Mesh::IVertexBundle &bundle, ccstd::vector<float> &positions) {
+    uint32_t offset = 0;
+    for (const auto &attribute : bundle.attributes) {
+        if (attribute.name == gfx::ATTR_NAME_POSITION) {
+            if (attribute.format != gfx::Format::RGB32F) {
+                return false;
+            }
+            const auto &view = bundle.view;
+            positions.resize(view.count * 3);
+            for (uint32_t i = 0; i < view.count; ++i) {
+                memcpy(&positions[i * 3], bytes + view.offset + i * view.stride + offset, sizeof(float) * 3);
+            }
+            return true;
+        }
+        offset += getFormatSize(attribute.format);
+    }
+    return false;
+}
+
+bool isInUnitRange(const uint8_t *bytes, const Mesh::IBufferView &view, uint32_t offset) {
+    for (uint32_t i = 0; i < view.count; ++i) {
+        float uv[2];
+        memcpy(uv, bytes + view.offset + i * view.stride + offset, sizeof(uv));
+        if (!(uv[0] >= 0.F && uv[0] <= 1.F && uv[1] >= 0.F && uv[1] <= 1.F)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Reads the indices of an indexed triangle list which are in range of its vertex bundle, returns the vertex count.
+uint32_t readTriangleList(const Mesh::IStruct &structInfo, const uint8_t *bytes, const Mesh::ISubMesh &primitive, ccstd::vector<uint32_t> &indices) {
+    if (!isIndexedTriangleList(primitive) || !readIndices(bytes, *primitive.indexView, indices)) {
+        return 0;
+    }
+    const uint32_t vertexCount = structInfo.vertexBundles[primitive.vertexBundelIndices[0]].view.count;
+    indices.resize(indices.size() / 3 * 3);
+    if (indices.empty() || *std::max_element(indices.begin(), indices.end()) >= vertexCount) {
+        return 0;
+    }
+    return vertexCount;
+}
+
+// Average cache miss ratio of all indexed triangle lists, weighted by triangles.
+float analyzeVertexCache(const Mesh::IStruct &structInfo, const uint8_t *bytes) {
+    ccstd::vector<uint32_t> indices;
+    float misses = 0.F;
+    uint32_t triangles = 0;
+    for (const auto &primitive : structInfo.primitives) {
+        const uint32_t vertexCount = readTriangleList(structInfo, bytes, primitive, indices);
+        if (vertexCount == 0) {
+            continue;
+        }
+        const float acmr = meshopt_analyzeVertexCache(indices.data(), indices.size(), vertexCount, MeshOptimizer::VERTEX_CACHE_SIZE, 0, 0).acmr;
+        misses += acmr * static_cast<float>(indices.size() / 3);
+        triangles += static_cast<uint32_t>(indices.size() / 3);
+    }
+    return triangles > 0 ? misses / static_cast<float>(triangles) : 0.F;
+}
+
+void optimizeIndices(Mesh::IStruct &structInfo, uint8_t *bytes, MeshOptimizeFlagBit flags) {
+    ccstd::vector<uint32_t> indices;
+    ccstd::vector<uint32_t> optimized;
+    ccstd::vector<float> positions;
+
+    for (auto &primitive : structInfo.primitives) {
+        const uint32_t vertexCount = readTriangleList(structInfo, bytes, primitive, indices);
+        if (vertexCount == 0) {
+            continue;
+        }
+        const auto &bundle = structInfo.vertexBundles[primitive.vertexBundelIndices[0]];
+
+        if (hasFlag(flags, MeshOptimizeFlagBit::VERTEX_CACHE)) {
+            optimized = indices;
+            meshopt_optimizeVertexCache(optimized.data(), indices.data(), indices.size(), vertexCount);
+            std::swap(indices, optimized);
+        }
+        // overdraw optimization works on top of the vertex cache order, meshlets reorder triangles anyway
+        if (hasFlag(flags, MeshOptimizeFlagBit::OVERDRAW) && !hasFlag(flags, MeshOptimizeFlagBit::MESHLETS) && readPositions(bytes, bundle, positions)) {
+            optimized = indices;
+            meshopt_optimizeOverdraw(optimized.data(), indices.data(), indices.size(), positions.data(), vertexCount, sizeof(float) * 3, MeshOptimizer::OVERDRAW_THRESHOLD);
+            std::swap(indices, optimized);
+        }
+
+        writeIndices(bytes, *primitive.indexView, indices);
+    }
+}
+
+void buildMeshlets(Mesh::IStruct &structInfo, uint8_t *bytes, MeshOptimizeFlagBit flags, ccstd::vector<ccstd::vector<Meshlet>> &meshlets) {
+    ccstd::vector<uint32_t> indices;
+    ccstd::vector<uint32_t> optimized;
+    ccstd::vector<float> positions;
+
+    meshlets.clear();
+    meshlets.resize(structInfo.primitives.size());
+    for (uint32_t i = 0; i < structInfo.primitives.size(); ++i) {
+        const auto &primitive = structInfo.primitives[i];
+        const uint32_t vertexCount = readTriangleList(structInfo, bytes, primitive, indices);
+        if (vertexCount == 0 || indices.size() != primitive.indexView->count ||
+            !readPositions(bytes, structInfo.vertexBundles[primitive.vertexBundelIndices[0]], positions)) {
+            continue;
+        }
+
+        meshlets[i] = MeshCluster::build(indices, positions.data(), 3, vertexCount);
+        if (hasFlag(flags, MeshOptimizeFlagBit::VERTEX_CACHE)) {
+            for (const auto &meshlet : meshlets[i]) {
+                optimized.assign(indices.begin() + meshlet.firstIndex, indices.begin() + meshlet.firstIndex + meshlet.indexCount);
+                meshopt_optimizeVertexCache(indices.data() + meshlet.firstIndex, optimized.data(), optimized.size(), vertexCount);
+            }
+        }
+        writeIndices(bytes, *primitive.indexView, indices);
+    }
+}
+
+void optimizeVertexFetch(Mesh::IStruct &structInfo, uint8_t *bytes) {
+    // morph targets store displacements per vertex, they would need the same remap
+    if (structInfo.morph.has_value()) {
+        return;
+    }
+
+    ccstd::vector<uint32_t> indices;
+    ccstd::vector<uint32_t> remap;
+    ccstd::vector<uint8_t> vertices;
+    ccstd::vector<uint32_t> primitiveIndices;
+    for (uint32_t bundleIndex = 0; bundleIndex < structInfo.vertexBundles.size(); ++bundleIndex) {
+        auto &view = structInfo.vertexBundles[bundleIndex].view;
+
+        // every primitive using the bundle must be indexed and use this bundle only
+        bool eligible = true;
+        primitiveIndices.clear();
+        for (uint32_t i = 0; i < structInfo.primitives.size(); ++i) {
+            const auto &primitive = structInfo.primitives[i];
+            if (std::find(primitive.vertexBundelIndices.begin(), primitive.vertexBundelIndices.end(), bundleIndex) == primitive.vertexBundelIndices.end()) {
+                continue;
+            }
+            eligible = eligible && primitive.indexView.has_value() && primitive.vertexBundelIndices.size() == 1 &&
+                       !primitive.cluster.has_value();
+            primitiveIndices.push_back(i);
+        }
+        if (!eligible || primitiveIndices.empty()) {
+            continue;
+        }
+
+        indices.clear();
+        for (const auto i : primitiveIndices) {
+            ccstd::vector<uint32_t> primitiveIndexData;
+            readIndices(bytes, *structInfo.primitives[i].indexView, primitiveIndexData);
+            indices.insert(indices.end(), primitiveIndexData.begin(), primitiveIndexData.end());
+        }
+        if (indices.empty() || *std::max_element(indices.begin(), indices.end()) >= view.count) {
+            continue;
+        }
+
+        remap.resize(view.count);
+        const auto uniqueCount = static_cast<uint32_t>(meshopt_optimizeVertexFetchRemap(remap.data(), indices.data(), indices.size(), view.count));
+        vertices.resize(static_cast<size_t>(uniqueCount) * view.stride);
+        meshopt_remapVertexBuffer(vertices.data(), bytes + view.offset, view.count, view.stride, remap.data());
+        memcpy(bytes + view.offset, vertices.data(), vertices.size());
+        view.count = uniqueCount;
+        view.length = uniqueCount * view.stride;
+
+        for (const auto i : primitiveIndices) {
+            const auto &indexView = *structInfo.primitives[i].indexView;
+            readIndices(bytes, indexView, indices);
+            meshopt_remapIndexBuffer(indices.data(), indices.data(), indices.size(), remap.data());
+            writeIndices(bytes, indexView, indices);
+        }
+    }
+}
+
+void quantizeVertices(Mesh::IStruct &structInfo, uint8_t *bytes, MeshOptimizeFlagBit flags) {
+    ccstd::vector<AttributeConversion> conversions;
+    ccstd::vector<uint8_t> vertex;
+    for (auto &bundle : structInfo.vertexBundles) {
+        auto &view = bundle.view;
+        conversions.clear();
+        bool converted = false;
+        uint32_t srcOffset = 0;
+        uint32_t dstOffset = 0;
+        for (auto &attribute : bundle.attributes) {
+            AttributeConversion conversion;
+            conversion.srcOffset = srcOffset;
+            conversion.srcSize = getFormatSize(attribute.format);
+            conversion.dstOffset = dstOffset;
+            conversion.components = gfx::GFX_FORMAT_INFOS[static_cast<uint32_t>(attribute.format)].count;
+
+            if (attribute.name == gfx::ATTR_NAME_NORMAL && attribute.format == gfx::Format::RGB32F) {
+                if (hasFlag(flags, MeshOptimizeFlagBit::OCTAHEDRAL_NORMAL)) {
+                    conversion.conversion = Conversion::OCTAHEDRAL;
+                    attribute.format = gfx::Format::RG16I;
+                } else if (hasFlag(flags, MeshOptimizeFlagBit::QUANTIZE)) {
+                    // padded to 4 components, 6 byte attributes break on Metal and some Android devices
+                    conversion.conversion = Conversion::SNORM16;
+                    attribute.format = gfx::Format::RGBA16I;
+                }
+            } else if (hasFlag(flags, MeshOptimizeFlagBit::QUANTIZE)) {
+                if (attribute.name == gfx::ATTR_NAME_TANGENT && attribute.format == gfx::Format::RGBA32F) {
+                    conversion.conversion = Conversion::SNORM16;
+                    attribute.format = gfx::Format::RGBA16I;
+                } else if (isTexCoord(attribute.name) && attribute.format == gfx::Format::RG32F && isInUnitRange(bytes, view, srcOffset)) {
+                    conversion.conversion = Conversion::UNORM16;
+                    attribute.format = gfx::Format::RG16UI;
+                }
+            }
+            if (conversion.conversion != Conversion::COPY) {
+                attribute.isNormalized = true;
+                converted = true;
+            }
+
+            srcOffset += conversion.srcSize;
+            dstOffset += getFormatSize(attribute.format);
+            conversions.push_back(conversion);
+        }
+        if (!converted || srcOffset != view.stride) {
+            continue;
+        }
+
+        // converted in place, the new stride is never larger
+        const uint32_t dstStride = dstOffset;
+        vertex.resize(view.stride);
+        for (uint32_t i = 0; i < view.count; ++i) {
+            memcpy(vertex.data(), bytes + view.offset + i * view.stride, view.stride);
+            uint8_t *dst = bytes + view.offset + i * dstStride;
+            for (const auto &conversion : conversions) {
+                const uint8_t *src = vertex.data() + conversion.srcOffset;
+                float values[4] = {0.F, 0.F, 0.F, 0.F};
+                if (conversion.conversion != Conversion::COPY) {
+                    memcpy(values, src, conversion.srcSize);
+                }
+                switch (conversion.conversion) {
+                    case Conversion::COPY:
+                        memcpy(dst + conversion.dstOffset, src, conversion.srcSize);
+                        break;
+                    case Conversion::SNORM16: {
+                        int16_t packed[4];
+                        for (uint32_t c = 0; c < 4; ++c) {
+                            packed[c] = quantizeSnorm16(values[c]);
+                        }
+                        memcpy(dst + conversion.dstOffset, packed, sizeof(packed));
+                    } break;
+                    case Conversion::UNORM16: {
+                        const uint16_t packed[2] = {quantizeUnorm16(values[0]), quantizeUnorm16(values[1])};
+                        memcpy(dst + conversion.dstOffset, packed, sizeof(packed));
+                    } break;
+                    case Conversion::OCTAHEDRAL: {
+                        int16_t packed[2];
+                        MeshOptimizer::encodeOctahedralNormal(values, packed);
+                        memcpy(dst + conversion.dstOffset, packed, sizeof(packed));
+                    } break;
+                }
+            }
+        }
+        view.stride = dstStride;
+        view.length = dstStride * view.count;
+    }
+}
+
+} // namespace
+
+void MeshOptimizer::optimize(Mesh::IStruct &structInfo, Uint8Array &data, MeshOptimizeFlagBit flags, MeshOptimizeReport *report,
+                             ccstd::vector<ccstd::vector<Meshlet>> *meshlets) {
+    MeshOptimizeReport result;
+    if (!data.buffer() || flags == MeshOptimizeFlagBit::NONE) {
+        if (report) *report = result;
+        return;
+    }
+
+    uint8_t *bytes = data.buffer()->getData();
+    for (const auto &bundle : structInfo.vertexBundles) {
+        result.vertexBytesBefore += bundle.view.length;
+    }
+
+    result.acmrBefore = analyzeVertexCache(structInfo, bytes);
+
+    optimizeIndices(structInfo, bytes, flags);
+    if (hasFlag(flags, MeshOptimizeFlagBit::MESHLETS) && meshlets) {
+        buildMeshlets(structInfo, bytes, flags, *meshlets);
+    }
+    if (hasFlag(flags, MeshOptimizeFlagBit::VERTEX_FETCH)) {
+        optimizeVertexFetch(structInfo, bytes);
+    }
+    if (hasAnyFlags(flags, MeshOptimizeFlagBit::QUANTIZE | MeshOptimizeFlagBit::OCTAHEDRAL_NORMAL)) {
+        quantizeVertices(structInfo, bytes, flags);
+    }
+
+    for (const auto &bundle : structInfo.vertexBundles) {
+        result.vertexBytesAfter += bundle.view.length;
+    }
+    result.acmrAfter = analyzeVertexCache(structInfo, bytes);
+    if (report) {
+        *report = result;
+    }
+}
+
+void MeshOptimizer::encodeOctahedralNormal(const float *normal, int16_t *out) {
+    // project onto the octahedron, then fold the lower hemisphere over the diagonals,
+    // matches oct_to_float32x3 in common/math/octahedron-transform.chunk
+    const float l1 = std::abs(normal[0]) + std::abs(normal[1]) + std::abs(normal[2]);
+    float x = l1 > 0.F ? normal[0] / l1 : 0.F;
+    float y = l1 > 0.F ? normal[1] / l1 : 0.F;
+    if (normal[2] <= 0.F && l1 > 0.F) {
+        const float foldedX = (1.F - std::abs(y)) * (x >= 0.F ? 1.F : -1.F);
+        const float foldedY = (1.F - std::abs(x)) * (y >= 0.F ? 1.F : -1.F);
+        x = foldedX;
+        y = foldedY;
+    }
+    out[0] = quantizeSnorm16(x);
+    out[1] = quantizeSnorm16(y);
+}
+
+void MeshOptimizer::decodeOctahedralNormal(const int16_t *in, float *normal) {
+    const float x = std::max(static_cast<float>(in[0]) / 32767.F, -1.F);
+    const float y = std::max(static_cast<float>(in[1]) / 32767.F, -1.F);
+    float v[3] = {x, y, 1.F - std::abs(x) - std::abs(y)};
+    if (v[2] < 0.F) {
+        v[0] = (1.F - std::abs(y)) * (x >= 0.F ? 1.F : -1.F);
+        v[1] = (1.F - std::abs(x)) * (y >= 0.F ? 1.F : -1.F);
+    }
+    const float length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    for (uint32_t i = 0; i < 3; ++i) {
+        normal[i] = v[i] / length;
+    }
+}
+
+uint32_t MeshOptimizer::decodeAttribute(const gfx::Attribute &attribute, const uint8_t *src, float *out) {
+    if (!attribute.isNormalized) {
+        return 0;
+    }
+    const bool isNormal = attribute.name == gfx::ATTR_NAME_NORMAL;
+    if (isNormal && attribute.format == gfx::Format::RG16I) {
+        int16_t packed[2];
+        memcpy(packed, src, sizeof(packed));
+        decodeOctahedralNormal(packed, out);
+        return 3;
+    }
+    if ((isNormal || attribute.name == gfx::ATTR_NAME_TANGENT) && attribute.format == gfx::Format::RGBA16I) {
+        int16_t packed[4];
+        memcpy(packed, src, sizeof(packed));
+        for (uint32_t c = 0; c < 4; ++c) {
+            out[c] = std::max(static_cast<float>(packed[c]) / 32767.F, -1.F);
+        }
+        // normals are padded to 4 components
+        return isNormal ? 3 : 4;
+    }
+    if (isTexCoord(attribute.name) && attribute.format == gfx::Format::RG16UI) {
+        uint16_t packed[2];
+        memcpy(packed, src, sizeof(packed));
+        out[0] = static_cast<float>(packed[0]) / 65535.F;
+        out[1] = static_cast<float>(packed[1]) / 65535.F;
+        return 2;
+    }
+    return 0;
+}
+
+} // namespace cc
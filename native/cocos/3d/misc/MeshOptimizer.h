@@ -0,0 +1,61 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include "3d/assets/Mesh.h"
+#include "3d/misc/MeshCluster.h"
+
+namespace cc {
+
+/**
+ * @en Load time optimizations of static mesh data, see MeshOptimizeFlagBit.
+ * Vertex cache, overdraw and vertex fetch passes only touch indexed triangle lists without clusters.
+ * @zh 静态网格数据的加载期优化，参见 MeshOptimizeFlagBit。
+ */
+class MeshOptimizer final {
+public:
+    // FIFO cache size used to measure the average cache miss ratio
+    static constexpr uint32_t VERTEX_CACHE_SIZE = 16;
+    // how much the vertex cache efficiency may degrade to reduce overdraw
+    static constexpr float OVERDRAW_THRESHOLD = 1.05F;
+
+    /**
+     * @param meshlets Receives the meshlets of each primitive with MeshOptimizeFlagBit::MESHLETS,
+     *                 empty for the primitives which couldn't be split.
+     */
+    static void optimize(Mesh::IStruct &structInfo, Uint8Array &data, MeshOptimizeFlagBit flags, MeshOptimizeReport *report = nullptr,
+                         ccstd::vector<ccstd::vector<Meshlet>> *meshlets = nullptr);
+
+    static void encodeOctahedralNormal(const float *normal, int16_t *out);
+    static void decodeOctahedralNormal(const int16_t *in, float *normal);
+
+    /**
+     * Decodes one vertex of an attribute quantized by optimize() back to the floats it was converted from.
+     * @return The number of floats written to `out`, at most 4, or 0 if optimize() doesn't produce the attribute.
+     */
+    static uint32_t decodeAttribute(const gfx::Attribute &attribute, const uint8_t *src, float *out);
+};
+
+} // namespace cc
@@ -46,6 +46,8 @@ const ccstd::string INST_JOINT_ANIM_INFO = "a_jointAnimInfo";
 } // namespace
 namespace cc {
 
+CC_SLAB_ALLOCATOR_IMPL(BakedSkinningModel, 64)
+
 BakedSkinningModel::BakedSkinningModel()
 //, _dataPoolManager(Root::getInstance()->getDataPoolManager())
 {
@@ -48,6 +48,8 @@ struct BakedJointInfo {
 };
 
 class BakedSkinningModel final : public MorphModel {
+    CC_SLAB_ALLOCATED
+
 public:
     using Super = MorphModel;
     BakedSkinningModel();
@@ -25,6 +25,8 @@
 
 namespace cc {
 
+CC_SLAB_ALLOCATOR_IMPL(MorphModel, 64)
+
 ccstd::vector<scene::IMacroPatch> MorphModel::getMacroPatches(index_t subModelIndex) {
     ccstd::vector<scene::IMacroPatch> superMacroPatches = Super::getMacroPatches(subModelIndex);
     if (_morphRenderingInstance) {
@@ -31,6 +31,8 @@
 namespace cc {
 
 class MorphModel : public scene::Model {
+    CC_SLAB_ALLOCATED
+
 public:
     using Super = scene::Model;
 
@@ -59,6 +59,8 @@ ccstd::vector<cc::scene::IMacroPatch> texturePatches{{"CC_USE_SKINNING", true},
 } // namespace
 namespace cc {
 
+CC_SLAB_ALLOCATOR_IMPL(SkinningModel, 64)
+
 SkinningModel::SkinningModel() {
     _type = Model::Type::SKINNING;
 }
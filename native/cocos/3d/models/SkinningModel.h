@@ -48,6 +48,8 @@ struct JointInfo {
 };
 
 class SkinningModel final : public MorphModel {
+    CC_SLAB_ALLOCATED
+
 public:
     using Super = MorphModel;
     SkinningModel();
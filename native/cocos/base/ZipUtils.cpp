@@ -37,6 +37,7 @@
 
 #include <zlib.h>
 #include <cstdlib>
+#include <cstring>
 #include <memory>
 #include "base/Data.h"
 #include "base/Locked.h"
@@ -45,6 +46,18 @@
 #include "platform/FileUtils.h"
 #include "unzip/ioapi_mem.h"
 
+#if (CC_PLATFORM == CC_PLATFORM_WINDOWS)
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <Windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
 // minizip 1.2.0 is same with other platforms
 #ifndef unzGoToFirstFile64
     #define unzGoToFirstFile64(A, B, C, D) unzGoToFirstFile2(A, B, C, D, NULL, 0, NULL, 0) // NOLINT(readability-identifier-naming)
@@ -450,6 +463,104 @@ struct ZipEntryInfo {
     uLong uncompressed_size;
 };
 
+// Entry of the central directory, read straight from the mapped zip file.
+struct ZipMappedEntryInfo {
+    uint32_t localHeaderOffset;
+    uint32_t compressedSize;
+    uint32_t uncompressedSize;
+    uint16_t method;
+};
+
+namespace {
+
+constexpr uint32_t ZIP_LOCAL_HEADER_SIGNATURE = 0x04034b50;
+constexpr uint32_t ZIP_CENTRAL_HEADER_SIGNATURE = 0x02014b50;
+constexpr uint32_t ZIP_END_OF_CENTRAL_DIR_SIGNATURE = 0x06054b50;
+constexpr uint32_t ZIP_LOCAL_HEADER_SIZE = 30;
+constexpr uint32_t ZIP_CENTRAL_HEADER_SIZE = 46;
+constexpr uint32_t ZIP_END_OF_CENTRAL_DIR_SIZE = 22;
+constexpr uint32_t ZIP_MAX_COMMENT_SIZE = 0xFFFF;
+constexpr uint16_t ZIP_FLAG_ENCRYPTED = 0x1;
+constexpr uint16_t ZIP_METHOD_STORED = 0;
+constexpr uint16_t ZIP_METHOD_DEFLATED = Z_DEFLATED;
+constexpr uint32_t ZIP64_MARKER = 0xFFFFFFFF;
+
+inline uint16_t readLE16(const unsigned char *p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+inline uint32_t readLE32(const unsigned char *p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+// Read only mapping of a whole file, shared by all reading threads.
+class MappedFile final {
+public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+
+    bool open(const ccstd::string &path) {
+        close();
+#if (CC_PLATFORM == CC_PLATFORM_WINDOWS)
+        HANDLE file = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER fileSize;
+        if (::GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+            _mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (_mapping) {
+                _data = static_cast<const unsigned char *>(::MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+                _size = static_cast<size_t>(fileSize.QuadPart);
+            }
+        }
+        ::CloseHandle(file);
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+            void *addr = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+            if (addr != MAP_FAILED) {
+                _data = static_cast<const unsigned char *>(addr);
+                _size = static_cast<size_t>(st.st_size);
+            }
+        }
+        ::close(fd);
+#endif
+        if (!_data) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void close() {
+#if (CC_PLATFORM == CC_PLATFORM_WINDOWS)
+        if (_data) ::UnmapViewOfFile(_data);
+        if (_mapping) ::CloseHandle(_mapping);
+        _mapping = nullptr;
+#else
+        if (_data) ::munmap(const_cast<unsigned char *>(_data), _size);
+#endif
+        _data = nullptr;
+        _size = 0;
+    }
+
+    const unsigned char *data() const { return _data; }
+    size_t size() const { return _size; }
+
+private:
+    const unsigned char *_data{nullptr};
+    size_t _size{0};
+#if (CC_PLATFORM == CC_PLATFORM_WINDOWS)
+    HANDLE _mapping{nullptr};
+#endif
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(MappedFile);
+};
+
+} // namespace
+
 class ZipFilePrivate {
 public:
     Locked<unzFile, std::recursive_mutex> zipFile;
@@ -458,8 +569,126 @@ public:
     // ccstd::unordered_map is faster if available on the platform
     using FileListContainer = ccstd::unordered_map<ccstd::string, struct ZipEntryInfo>;
     FileListContainer fileList;
+
+    ccstd::string path;
+    ccstd::string filter;
+
+    // Concurrent reads: the zip file bytes, either mapped from path or the buffer given to createWithBuffer().
+    MappedFile mappedFile;
+    const unsigned char *zipData{nullptr};
+    size_t zipSize{0};
+    bool concurrentReads{false};
+
+    using MappedFileListContainer = ccstd::unordered_map<ccstd::string, ZipMappedEntryInfo>;
+    MappedFileListContainer mappedFileList;
+
+    bool buildMappedFileList();
+    const unsigned char *getMappedEntryData(const ZipMappedEntryInfo &entry) const;
+    bool readMappedEntry(const ZipMappedEntryInfo &entry, unsigned char *dst) const;
 };
 
+bool ZipFilePrivate::buildMappedFileList() {
+    mappedFileList.clear();
+    if (!zipData || zipSize < ZIP_END_OF_CENTRAL_DIR_SIZE) {
+        return false;
+    }
+
+    // the end of central directory record is followed by a comment of up to 64k
+    const unsigned char *eocd = nullptr;
+    const size_t searchEnd = zipSize > ZIP_END_OF_CENTRAL_DIR_SIZE + ZIP_MAX_COMMENT_SIZE ? zipSize - ZIP_END_OF_CENTRAL_DIR_SIZE - ZIP_MAX_COMMENT_SIZE : 0;
+    for (size_t offset = zipSize - ZIP_END_OF_CENTRAL_DIR_SIZE + 1; offset-- > searchEnd;) {
+        if (readLE32(zipData + offset) == ZIP_END_OF_CENTRAL_DIR_SIGNATURE) {
+            eocd = zipData + offset;
+            break;
+        }
+    }
+    if (!eocd) {
+        return false;
+    }
+
+    const uint32_t entryCount = readLE16(eocd + 10);
+    const uint32_t directorySize = readLE32(eocd + 12);
+    const uint32_t directoryOffset = readLE32(eocd + 16);
+    if (directoryOffset == ZIP64_MARKER || static_cast<size_t>(directoryOffset) + directorySize > zipSize) {
+        return false;
+    }
+
+    const unsigned char *p = zipData + directoryOffset;
+    const unsigned char *end = p + directorySize;
+    for (uint32_t i = 0; i < entryCount; ++i) {
+        if (end - p < ZIP_CENTRAL_HEADER_SIZE || readLE32(p) != ZIP_CENTRAL_HEADER_SIGNATURE) {
+            break;
+        }
+        const uint16_t flags = readLE16(p + 8);
+        ZipMappedEntryInfo entry;
+        entry.method = readLE16(p + 10);
+        entry.compressedSize = readLE32(p + 20);
+        entry.uncompressedSize = readLE32(p + 24);
+        entry.localHeaderOffset = readLE32(p + 42);
+        const uint16_t nameLength = readLE16(p + 28);
+        const size_t headerSize = ZIP_CENTRAL_HEADER_SIZE + nameLength + readLE16(p + 30) + readLE16(p + 32);
+        if (static_cast<size_t>(end - p) < headerSize) {
+            break;
+        }
+
+        ccstd::string name(reinterpret_cast<const char *>(p + ZIP_CENTRAL_HEADER_SIZE), nameLength);
+        p += headerSize;
+
+        // ZIP64 and encrypted entries are left to minizip
+        const bool readable = !(flags & ZIP_FLAG_ENCRYPTED) &&
+                              (entry.method == ZIP_METHOD_STORED || entry.method == ZIP_METHOD_DEFLATED) &&
+                              entry.compressedSize != ZIP64_MARKER && entry.uncompressedSize != ZIP64_MARKER &&
+                              entry.localHeaderOffset != ZIP64_MARKER;
+        if (readable && (filter.empty() || name.compare(0, filter.length(), filter) == 0)) {
+            mappedFileList[name] = entry;
+        }
+    }
+    return true;
+}
+
+const unsigned char *ZipFilePrivate::getMappedEntryData(const ZipMappedEntryInfo &entry) const {
+    // the local header repeats the name and has its own extra field, only its sizes tell where the data starts
+    const size_t headerOffset = entry.localHeaderOffset;
+    if (headerOffset + ZIP_LOCAL_HEADER_SIZE > zipSize || readLE32(zipData + headerOffset) != ZIP_LOCAL_HEADER_SIGNATURE) {
+        return nullptr;
+    }
+    const size_t dataOffset = headerOffset + ZIP_LOCAL_HEADER_SIZE + readLE16(zipData + headerOffset + 26) + readLE16(zipData + headerOffset + 28);
+    if (dataOffset + entry.compressedSize > zipSize) {
+        return nullptr;
+    }
+    return zipData + dataOffset;
+}
+
+bool ZipFilePrivate::readMappedEntry(const ZipMappedEntryInfo &entry, unsigned char *dst) const {
+    const unsigned char *src = getMappedEntryData(entry);
+    if (!src) {
+        return false;
+    }
+
+    if (entry.method == ZIP_METHOD_STORED) {
+        if (entry.compressedSize != entry.uncompressedSize) {
+            return false;
+        }
+        memcpy(dst, src, entry.uncompressedSize);
+        return true;
+    }
+
+    // raw deflate stream, inflated on the calling thread
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+        return false;
+    }
+    stream.next_in = const_cast<Bytef *>(src);
+    stream.avail_in = entry.compressedSize;
+    stream.next_out = dst;
+    stream.avail_out = entry.uncompressedSize;
+    const int err = inflate(&stream, Z_FINISH);
+    const bool ok = (err == Z_STREAM_END || (err == Z_BUF_ERROR && entry.uncompressedSize == 0)) && stream.total_out == entry.uncompressedSize;
+    inflateEnd(&stream);
+    return ok;
+}
+
 ZipFile *ZipFile::createWithBuffer(const void *buffer, uint32_t size) {
     auto *zip = ccnew ZipFile();
     if (zip && zip->initWithBuffer(buffer, size)) {
@@ -478,7 +707,8 @@ ZipFile::ZipFile()
 ZipFile::ZipFile(const ccstd::string &zipFile, const ccstd::string &filter)
 : _data(ccnew ZipFilePrivate) {
     auto zipFileL = _data->zipFile.lock();
-    *zipFileL = unzOpen(FileUtils::getInstance()->getSuitableFOpen(zipFile).c_str());
+    _data->path = FileUtils::getInstance()->getSuitableFOpen(zipFile);
+    *zipFileL = unzOpen(_data->path.c_str());
     setFilter(filter);
 }
 
@@ -502,6 +732,10 @@ bool ZipFile::setFilter(const ccstd::string &filter) {
 
         // clear existing file list
         _data->fileList.clear();
+        _data->filter = filter;
+        if (_data->concurrentReads) {
+            _data->buildMappedFileList();
+        }
 
         // UNZ_MAXFILENAMEINZIP + 1 - it is done so in unzLocateFile
         char szCurrentFileName[UNZ_MAXFILENAMEINZIP + 1];
@@ -544,12 +778,82 @@ bool ZipFile::fileExists(const ccstd::string &fileName) const {
     return ret;
 }
 
+bool ZipFile::enableConcurrentReads() {
+    CC_ASSERT(_data);
+    if (_data->concurrentReads) {
+        return true;
+    }
+
+    auto zipFile = _data->zipFile.lock();
+    if (!(*zipFile)) {
+        return false;
+    }
+    if (!_data->zipData) {
+        if (_data->path.empty() || !_data->mappedFile.open(_data->path)) {
+            return false;
+        }
+        _data->zipData = _data->mappedFile.data();
+        _data->zipSize = _data->mappedFile.size();
+    }
+    if (!_data->buildMappedFileList()) {
+        CC_LOG_WARNING("ZipFile: can't index the central directory, concurrent reads are disabled");
+        _data->mappedFile.close();
+        _data->zipData = nullptr;
+        _data->zipSize = 0;
+        return false;
+    }
+    _data->concurrentReads = true;
+    return true;
+}
+
+bool ZipFile::isConcurrentReadsEnabled() const {
+    return _data && _data->concurrentReads;
+}
+
+const unsigned char *ZipFile::getFileView(const ccstd::string &fileName, uint32_t *size) const {
+    if (size) {
+        *size = 0;
+    }
+    if (!isConcurrentReadsEnabled()) {
+        return nullptr;
+    }
+
+    auto it = _data->mappedFileList.find(fileName);
+    if (it == _data->mappedFileList.end() || it->second.method != ZIP_METHOD_STORED ||
+        it->second.compressedSize != it->second.uncompressedSize) {
+        return nullptr;
+    }
+
+    const unsigned char *data = _data->getMappedEntryData(it->second);
+    if (data && size) {
+        *size = it->second.uncompressedSize;
+    }
+    return data;
+}
+
 unsigned char *ZipFile::getFileData(const ccstd::string &fileName, uint32_t *size) {
     unsigned char *buffer = nullptr;
     if (size) {
         *size = 0;
     }
 
+    if (_data->concurrentReads) {
+        auto it = _data->mappedFileList.find(fileName);
+        if (it != _data->mappedFileList.end()) {
+            const uint32_t dataSize = it->second.uncompressedSize;
+            // keep the pointer non null for empty entries, like the minizip path does
+            buffer = static_cast<unsigned char *>(malloc(dataSize > 0 ? dataSize : 1));
+            if (buffer && !_data->readMappedEntry(it->second, buffer)) {
+                free(buffer);
+                buffer = nullptr;
+            }
+            if (buffer && size) {
+                *size = dataSize;
+            }
+            return buffer;
+        }
+    }
+
     auto zipFile = _data->zipFile.lock();
 
     do {
@@ -581,6 +885,14 @@ unsigned char *ZipFile::getFileData(const ccstd::string &fileName, uint32_t *siz
 }
 
 bool ZipFile::getFileData(const ccstd::string &fileName, ResizableBuffer *buffer) {
+    if (_data->concurrentReads) {
+        auto it = _data->mappedFileList.find(fileName);
+        if (it != _data->mappedFileList.end()) {
+            buffer->resize(it->second.uncompressedSize);
+            return it->second.uncompressedSize == 0 || _data->readMappedEntry(it->second, static_cast<unsigned char *>(buffer->buffer()));
+        }
+    }
+
     bool res = false;
     do {
         auto zipFile = _data->zipFile.lock();
@@ -649,6 +961,11 @@ bool ZipFile::initWithBuffer(const void *buffer, uint32_t size) {
 
     *zipFile = unzOpen2(nullptr, &memoryFile);
     if (!(*zipFile)) return false;
+    _data->memfs = std::move(memfs);
+
+    // the buffer outlives the zip file, concurrent reads can use it in place
+    _data->zipData = static_cast<const unsigned char *>(buffer);
+    _data->zipSize = size;
 
     setFilter(EMPTY_FILE_NAME);
     return true;
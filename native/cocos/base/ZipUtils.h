@@ -258,6 +258,29 @@ public:
         */
     bool getFileData(const ccstd::string &fileName, ResizableBuffer *buffer);
 
+    /**
+        * Map the zip file into memory and index its central directory, so that getFileData()
+        * can be called from any thread without serializing on the minizip handle.
+        * Deflated entries are inflated on the calling thread, stored entries are copied
+        * straight from the mapping or accessed in place with getFileView().
+        * Call it once before the ZipFile is shared between threads, setFilter() must not
+        * be called while other threads are reading.
+        * @return True if the zip file could be mapped and indexed. Entries that can't be
+        *         read this way (ZIP64, encrypted) keep using the locked minizip path.
+        */
+    bool enableConcurrentReads();
+    bool isConcurrentReadsEnabled() const;
+
+    /**
+        * Get a stored (uncompressed) entry in place, without copying it.
+        * Only available once enableConcurrentReads() succeeded.
+        * @param fileName File name
+        * @param[out] size If the entry is found, it will be the data size, otherwise 0.
+        * @return A pointer into the mapped zip file which lives as long as this ZipFile,
+        *         nullptr if the entry doesn't exist or is compressed.
+        */
+    const unsigned char *getFileView(const ccstd::string &fileName, uint32_t *size) const;
+
     ccstd::string getFirstFilename();
     ccstd::string getNextFilename();
 
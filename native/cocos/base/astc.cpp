@@ -58,3 +58,680 @@ int astcGetHeight(const astc_byte *pHeader) {
     int ysize = pHeader[ASTC_HEADER_SIZE_Y_BEGIN] + (pHeader[ASTC_HEADER_SIZE_Y_BEGIN + 1] * 256) + (pHeader[ASTC_HEADER_SIZE_Y_BEGIN + 2] * 65536);
     return ysize;
 }
+
+// Block decoding, see the Khronos Data Format Specification, ASTC chapter.
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define ASTC_USE_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define ASTC_USE_NEON
+#endif
+
+namespace {
+
+constexpr uint32_t MAX_WEIGHTS = 64;
+constexpr uint32_t MAX_TEXELS = 144;
+constexpr uint32_t MAX_COLOR_VALUES = 18;
+constexpr uint8_t ERROR_COLOR[4] = {255, 0, 255, 255};
+
+struct IntegerSequence {
+    uint8_t trits;
+    uint8_t quints;
+    uint8_t bits;
+};
+
+// indexed by quantization level: 2, 3, 4, 5, 6, 8, 10, 12, 16, 20, 24, 32, 40, 48, 64, 80, 96, 128, 160, 192, 256
+constexpr IntegerSequence ISE_ENCODINGS[] = {
+    {0, 0, 1}, {1, 0, 0}, {0, 0, 2}, {0, 1, 0}, {1, 0, 1}, {0, 0, 3}, {0, 1, 1}, {1, 0, 2}, {0, 0, 4}, {0, 1, 2}, {1, 0, 3},
+    {0, 0, 5}, {0, 1, 3}, {1, 0, 4}, {0, 0, 6}, {0, 1, 4}, {1, 0, 5}, {0, 0, 7}, {0, 1, 5}, {1, 0, 6}, {0, 0, 8}};
+constexpr uint32_t QUANT_6 = 4;
+constexpr uint32_t QUANT_256 = 20;
+
+class Block128 final {
+public:
+    explicit Block128(const astc_byte *pBlock) {
+        memcpy(&_lo, pBlock, sizeof(_lo));
+        memcpy(&_hi, pBlock + sizeof(_lo), sizeof(_hi));
+    }
+    Block128(uint64_t lo, uint64_t hi) : _lo(lo), _hi(hi) {}
+
+    // reads up to 32 bits, bits past the end of the block read as zero
+    inline uint32_t bits(uint32_t start, uint32_t count) const {
+        if (count == 0 || start >= 128) return 0;
+        uint64_t value = 0;
+        if (start >= 64) {
+            value = _hi >> (start - 64);
+        } else if (start == 0) {
+            value = _lo;
+        } else {
+            value = (_lo >> start) | (_hi << (64 - start));
+        }
+        return static_cast<uint32_t>(value & ((uint64_t(1) << count) - 1));
+    }
+
+    Block128 reversed() const { return {reverse(_hi), reverse(_lo)}; }
+
+private:
+    static uint64_t reverse(uint64_t v) {
+        v = ((v >> 1) & 0x5555555555555555ULL) | ((v & 0x5555555555555555ULL) << 1);
+        v = ((v >> 2) & 0x3333333333333333ULL) | ((v & 0x3333333333333333ULL) << 2);
+        v = ((v >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((v & 0x0F0F0F0F0F0F0F0FULL) << 4);
+        v = ((v >> 8) & 0x00FF00FF00FF00FFULL) | ((v & 0x00FF00FF00FF00FFULL) << 8);
+        v = ((v >> 16) & 0x0000FFFF0000FFFFULL) | ((v & 0x0000FFFF0000FFFFULL) << 16);
+        return (v >> 32) | (v << 32);
+    }
+
+    uint64_t _lo{0};
+    uint64_t _hi{0};
+};
+
+uint32_t getSequenceBitCount(uint32_t count, uint32_t quant) {
+    const IntegerSequence &ise = ISE_ENCODINGS[quant];
+    return ise.bits * count + (ise.trits ? (8 * count + 4) / 5 : 0) + (ise.quints ? (7 * count + 2) / 3 : 0);
+}
+
+// Decodes count values, each stored as (trit or quint) << bits | bits.
+void decodeSequence(const Block128 &block, uint32_t start, uint32_t count, uint32_t quant, uint32_t *pValues) {
+    const IntegerSequence &ise = ISE_ENCODINGS[quant];
+    const uint32_t n = ise.bits;
+    const uint32_t end = start + getSequenceBitCount(count, quant);
+    uint32_t pos = start;
+    auto read = [&](uint32_t bitCount) {
+        uint32_t value = 0;
+        if (pos < end) {
+            uint32_t available = end - pos;
+            value = block.bits(pos, bitCount < available ? bitCount : available);
+        }
+        pos += bitCount;
+        return value;
+    };
+
+    if (ise.trits) {
+        for (uint32_t i = 0; i < count; i += 5) {
+            uint32_t m[5];
+            uint32_t t = 0;
+            m[0] = read(n);
+            t |= read(2);
+            m[1] = read(n);
+            t |= read(2) << 2;
+            m[2] = read(n);
+            t |= read(1) << 4;
+            m[3] = read(n);
+            t |= read(2) << 5;
+            m[4] = read(n);
+            t |= read(1) << 7;
+
+            uint32_t trits[5];
+            uint32_t c = 0;
+            if (((t >> 2) & 7) == 7) {
+                c = (((t >> 5) & 7) << 2) | (t & 3);
+                trits[4] = 2;
+                trits[3] = 2;
+            } else {
+                c = t & 0x1f;
+                if (((t >> 5) & 3) == 3) {
+                    trits[4] = 2;
+                    trits[3] = (t >> 7) & 1;
+                } else {
+                    trits[4] = (t >> 7) & 1;
+                    trits[3] = (t >> 5) & 3;
+                }
+            }
+            if ((c & 3) == 3) {
+                trits[2] = 2;
+                trits[1] = (c >> 4) & 1;
+                trits[0] = (((c >> 3) & 1) << 1) | (((c >> 2) & 1) & ~((c >> 3) & 1));
+            } else if (((c >> 2) & 3) == 3) {
+                trits[2] = 2;
+                trits[1] = 2;
+                trits[0] = c & 3;
+            } else {
+                trits[2] = (c >> 4) & 1;
+                trits[1] = (c >> 2) & 3;
+                trits[0] = (c & 2) | ((c & 1) & ~((c >> 1) & 1));
+            }
+
+            for (uint32_t j = 0; j < 5 && i + j < count; ++j) {
+                pValues[i + j] = (trits[j] << n) | m[j];
+            }
+        }
+    } else if (ise.quints) {
+        for (uint32_t i = 0; i < count; i += 3) {
+            uint32_t m[3];
+            uint32_t q = 0;
+            m[0] = read(n);
+            q |= read(3);
+            m[1] = read(n);
+            q |= read(2) << 3;
+            m[2] = read(n);
+            q |= read(2) << 5;
+
+            uint32_t quints[3];
+            if (((q >> 1) & 3) == 3 && ((q >> 5) & 3) == 0) {
+                uint32_t q0 = q & 1;
+                quints[2] = (q0 << 2) | ((((q >> 4) & 1) & ~q0) << 1) | (((q >> 3) & 1) & ~q0);
+                quints[1] = 4;
+                quints[0] = 4;
+            } else {
+                uint32_t c = 0;
+                if (((q >> 1) & 3) == 3) {
+                    quints[2] = 4;
+                    c = (((q >> 3) & 3) << 3) | ((~(q >> 5) & 3) << 1) | (q & 1);
+                } else {
+                    quints[2] = (q >> 5) & 3;
+                    c = q & 0x1f;
+                }
+                if ((c & 7) == 5) {
+                    quints[1] = 4;
+                    quints[0] = (c >> 3) & 3;
+                } else {
+                    quints[1] = (c >> 3) & 3;
+                    quints[0] = c & 7;
+                }
+            }
+
+            for (uint32_t j = 0; j < 3 && i + j < count; ++j) {
+                pValues[i + j] = (quints[j] << n) | m[j];
+            }
+        }
+    } else {
+        for (uint32_t i = 0; i < count; ++i) {
+            pValues[i] = read(n);
+        }
+    }
+}
+
+inline uint32_t replicate(uint32_t value, uint32_t bits, uint32_t targetBits) {
+    uint32_t result = 0;
+    uint32_t filled = 0;
+    while (filled < targetBits) {
+        result = (result << bits) | value;
+        filled += bits;
+    }
+    return result >> (filled - targetBits);
+}
+
+uint32_t unquantizeColor(uint32_t value, uint32_t quant) {
+    const IntegerSequence &ise = ISE_ENCODINGS[quant];
+    const uint32_t n = ise.bits;
+    if (!ise.trits && !ise.quints) {
+        return replicate(value, n, 8);
+    }
+
+    uint32_t m = value & ((1U << n) - 1);
+    uint32_t d = value >> n;
+    uint32_t a = (m & 1) ? 0x1ff : 0;
+    uint32_t x = m >> 1;
+    uint32_t b = 0;
+    uint32_t c = 0;
+    if (ise.trits) {
+        switch (n) {
+            case 1: c = 204; break;
+            case 2: c = 93, b = (x << 8) | (x << 4) | (x << 2) | (x << 1); break;
+            case 3: c = 44, b = (x << 7) | (x << 2) | x; break;
+            case 4: c = 22, b = (x << 6) | x; break;
+            case 5: c = 11, b = (x << 5) | (x >> 2); break;
+            default: c = 5, b = (x << 4) | (x >> 4); break;
+        }
+    } else {
+        switch (n) {
+            case 1: c = 113; break;
+            case 2: c = 54, b = (x << 8) | (x << 3) | (x << 2); break;
+            case 3: c = 26, b = (x << 7) | (x << 1) | (x >> 1); break;
+            case 4: c = 13, b = (x << 6) | (x >> 1); break;
+            default: c = 6, b = (x << 5) | (x >> 3); break;
+        }
+    }
+    uint32_t t = ((d * c + b) ^ a) & 0x1ff;
+    return (a & 0x80) | (t >> 2);
+}
+
+uint32_t unquantizeWeight(uint32_t value, uint32_t quant) {
+    const IntegerSequence &ise = ISE_ENCODINGS[quant];
+    const uint32_t n = ise.bits;
+    uint32_t result = 0;
+    if (!ise.trits && !ise.quints) {
+        result = replicate(value, n, 6);
+    } else if (n == 0) {
+        static constexpr uint32_t TRIT_WEIGHTS[3] = {0, 32, 63};
+        static constexpr uint32_t QUINT_WEIGHTS[5] = {0, 16, 32, 47, 63};
+        result = ise.trits ? TRIT_WEIGHTS[value] : QUINT_WEIGHTS[value];
+    } else {
+        uint32_t m = value & ((1U << n) - 1);
+        uint32_t d = value >> n;
+        uint32_t a = (m & 1) ? 0x7f : 0;
+        uint32_t x = m >> 1;
+        uint32_t b = 0;
+        uint32_t c = 0;
+        if (ise.trits) {
+            switch (n) {
+                case 1: c = 50; break;
+                case 2: c = 23, b = (x << 6) | (x << 2) | x; break;
+                default: c = 11, b = (x << 5) | x; break;
+            }
+        } else {
+            switch (n) {
+                case 1: c = 28; break;
+                default: c = 13, b = (x << 6) | (x << 1); break;
+            }
+        }
+        uint32_t t = ((d * c + b) ^ a) & 0x7f;
+        result = (a & 0x20) | (t >> 2);
+    }
+    return result > 32 ? result + 1 : result;
+}
+
+struct BlockMode {
+    uint32_t weightsX{0};
+    uint32_t weightsY{0};
+    uint32_t weightQuant{0};
+    bool dualPlane{false};
+};
+
+bool decodeBlockMode(uint32_t mode, BlockMode &out) {
+    uint32_t r = (mode >> 4) & 1;
+    uint32_t h = (mode >> 9) & 1;
+    uint32_t d = (mode >> 10) & 1;
+    uint32_t a = (mode >> 5) & 3;
+
+    if (mode & 3) {
+        r |= (mode & 3) << 1;
+        uint32_t b = (mode >> 7) & 3;
+        switch ((mode >> 2) & 3) {
+            case 0: out.weightsX = b + 4, out.weightsY = a + 2; break;
+            case 1: out.weightsX = b + 8, out.weightsY = a + 2; break;
+            case 2: out.weightsX = a + 2, out.weightsY = b + 8; break;
+            default:
+                b &= 1;
+                if (mode & 0x100) {
+                    out.weightsX = b + 2, out.weightsY = a + 2;
+                } else {
+                    out.weightsX = a + 2, out.weightsY = b + 6;
+                }
+                break;
+        }
+    } else {
+        r |= ((mode >> 2) & 3) << 1;
+        if (((mode >> 2) & 3) == 0) return false;
+        uint32_t b = (mode >> 9) & 3;
+        switch ((mode >> 7) & 3) {
+            case 0: out.weightsX = 12, out.weightsY = a + 2; break;
+            case 1: out.weightsX = a + 2, out.weightsY = 12; break;
+            case 2:
+                out.weightsX = a + 6, out.weightsY = b + 6;
+                d = 0;
+                h = 0;
+                break;
+            default:
+                if (((mode >> 5) & 3) == 0) {
+                    out.weightsX = 6, out.weightsY = 10;
+                } else if (((mode >> 5) & 3) == 1) {
+                    out.weightsX = 10, out.weightsY = 6;
+                } else {
+                    return false;
+                }
+                break;
+        }
+    }
+
+    out.weightQuant = r - 2 + 6 * h;
+    out.dualPlane = d != 0;
+    uint32_t weightCount = out.weightsX * out.weightsY * (d + 1);
+    uint32_t weightBits = getSequenceBitCount(weightCount, out.weightQuant);
+    return weightCount <= MAX_WEIGHTS && weightBits >= 24 && weightBits <= 96;
+}
+
+uint32_t hash52(uint32_t p) {
+    p ^= p >> 15;
+    p -= p << 17;
+    p += p << 7;
+    p += p << 4;
+    p ^= p >> 5;
+    p += p << 16;
+    p ^= p >> 7;
+    p ^= p >> 3;
+    p ^= p << 6;
+    p ^= p >> 17;
+    return p;
+}
+
+uint32_t selectPartition(uint32_t seed, uint32_t x, uint32_t y, uint32_t partitionCount, bool smallBlock) {
+    if (smallBlock) {
+        x <<= 1;
+        y <<= 1;
+    }
+    seed += (partitionCount - 1) * 1024;
+    uint32_t rnum = hash52(seed);
+    uint32_t seeds[8];
+    for (uint32_t i = 0; i < 8; ++i) {
+        uint32_t s = (rnum >> (i * 4)) & 0xf;
+        seeds[i] = s * s;
+    }
+    uint32_t sh1 = 0;
+    uint32_t sh2 = 0;
+    if (seed & 1) {
+        sh1 = (seed & 2) ? 4 : 5;
+        sh2 = partitionCount == 3 ? 6 : 5;
+    } else {
+        sh1 = partitionCount == 3 ? 6 : 5;
+        sh2 = (seed & 2) ? 4 : 5;
+    }
+    // z is always 0 for 2D blocks, so seeds 9 to 12 drop out
+    uint32_t a = ((seeds[0] >> sh1) * x + (seeds[1] >> sh2) * y + (rnum >> 14)) & 0x3f;
+    uint32_t b = ((seeds[2] >> sh1) * x + (seeds[3] >> sh2) * y + (rnum >> 10)) & 0x3f;
+    uint32_t c = ((seeds[4] >> sh1) * x + (seeds[5] >> sh2) * y + (rnum >> 6)) & 0x3f;
+    uint32_t d = ((seeds[6] >> sh1) * x + (seeds[7] >> sh2) * y + (rnum >> 2)) & 0x3f;
+    if (partitionCount < 4) d = 0;
+    if (partitionCount < 3) c = 0;
+    if (a >= b && a >= c && a >= d) return 0;
+    if (b >= c && b >= d) return 1;
+    if (c >= d) return 2;
+    return 3;
+}
+
+inline int clamp255(int v) { return v < 0 ? 0 : (v > 255 ? 255 : v); }
+
+inline void bitTransferSigned(int &a, int &b) {
+    b >>= 1;
+    b |= a & 0x80;
+    a >>= 1;
+    a &= 0x3f;
+    if (a & 0x20) a -= 0x40;
+}
+
+inline void setEndpoint(int *e, int r, int g, int b, int a) {
+    e[0] = clamp255(r);
+    e[1] = clamp255(g);
+    e[2] = clamp255(b);
+    e[3] = clamp255(a);
+}
+
+inline void setBlueContracted(int *e, int r, int g, int b, int a) {
+    setEndpoint(e, (r + b) >> 1, (g + b) >> 1, b, a);
+}
+
+// LDR endpoint modes only, returns false for HDR ones
+bool decodeEndpoints(uint32_t cem, const uint32_t *pValues, int *e0, int *e1) {
+    int v[8];
+    for (uint32_t i = 0; i < ((cem >> 2) + 1) * 2; ++i) {
+        v[i] = static_cast<int>(pValues[i]);
+    }
+    switch (cem) {
+        case 0:
+            setEndpoint(e0, v[0], v[0], v[0], 255);
+            setEndpoint(e1, v[1], v[1], v[1], 255);
+            break;
+        case 1: {
+            int l0 = (v[0] >> 2) | (v[1] & 0xc0);
+            int l1 = l0 + (v[1] & 0x3f);
+            setEndpoint(e0, l0, l0, l0, 255);
+            setEndpoint(e1, l1, l1, l1, 255);
+        } break;
+        case 4:
+            setEndpoint(e0, v[0], v[0], v[0], v[2]);
+            setEndpoint(e1, v[1], v[1], v[1], v[3]);
+            break;
+        case 5:
+            bitTransferSigned(v[1], v[0]);
+            bitTransferSigned(v[3], v[2]);
+            setEndpoint(e0, v[0], v[0], v[0], v[2]);
+            setEndpoint(e1, v[0] + v[1], v[0] + v[1], v[0] + v[1], v[2] + v[3]);
+            break;
+        case 6:
+            setEndpoint(e0, (v[0] * v[3]) >> 8, (v[1] * v[3]) >> 8, (v[2] * v[3]) >> 8, 255);
+            setEndpoint(e1, v[0], v[1], v[2], 255);
+            break;
+        case 8:
+            if (v[1] + v[3] + v[5] >= v[0] + v[2] + v[4]) {
+                setEndpoint(e0, v[0], v[2], v[4], 255);
+                setEndpoint(e1, v[1], v[3], v[5], 255);
+            } else {
+                setBlueContracted(e0, v[1], v[3], v[5], 255);
+                setBlueContracted(e1, v[0], v[2], v[4], 255);
+            }
+            break;
+        case 9:
+            bitTransferSigned(v[1], v[0]);
+            bitTransferSigned(v[3], v[2]);
+            bitTransferSigned(v[5], v[4]);
+            if (v[1] + v[3] + v[5] >= 0) {
+                setEndpoint(e0, v[0], v[2], v[4], 255);
+                setEndpoint(e1, v[0] + v[1], v[2] + v[3], v[4] + v[5], 255);
+            } else {
+                setBlueContracted(e0, v[0] + v[1], v[2] + v[3], v[4] + v[5], 255);
+                setBlueContracted(e1, v[0], v[2], v[4], 255);
+            }
+            break;
+        case 10:
+            setEndpoint(e0, (v[0] * v[3]) >> 8, (v[1] * v[3]) >> 8, (v[2] * v[3]) >> 8, v[4]);
+            setEndpoint(e1, v[0], v[1], v[2], v[5]);
+            break;
+        case 12:
+            if (v[1] + v[3] + v[5] >= v[0] + v[2] + v[4]) {
+                setEndpoint(e0, v[0], v[2], v[4], v[6]);
+                setEndpoint(e1, v[1], v[3], v[5], v[7]);
+            } else {
+                setBlueContracted(e0, v[1], v[3], v[5], v[7]);
+                setBlueContracted(e1, v[0], v[2], v[4], v[6]);
+            }
+            break;
+        case 13:
+            bitTransferSigned(v[1], v[0]);
+            bitTransferSigned(v[3], v[2]);
+            bitTransferSigned(v[5], v[4]);
+            bitTransferSigned(v[7], v[6]);
+            if (v[1] + v[3] + v[5] >= 0) {
+                setEndpoint(e0, v[0], v[2], v[4], v[6]);
+                setEndpoint(e1, v[0] + v[1], v[2] + v[3], v[4] + v[5], v[6] + v[7]);
+            } else {
+                setBlueContracted(e0, v[0] + v[1], v[2] + v[3], v[4] + v[5], v[6] + v[7]);
+                setBlueContracted(e1, v[0], v[2], v[4], v[6]);
+            }
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+// Bilinear infill of the weight grid to one weight per texel, see the "Weight Infill" section.
+void infillWeights(const uint32_t *pGrid, uint32_t gridX, uint32_t gridY, uint32_t stride,
+                   uint32_t blockWidth, uint32_t blockHeight, uint8_t *pOut) {
+    uint32_t ds = (1024 + blockWidth / 2) / (blockWidth - 1);
+    uint32_t dt = (1024 + blockHeight / 2) / (blockHeight - 1);
+    for (uint32_t t = 0; t < blockHeight; ++t) {
+        uint32_t gt = (dt * t * (gridY - 1) + 32) >> 6;
+        uint32_t jt = gt >> 4;
+        uint32_t ft = gt & 0xf;
+        for (uint32_t s = 0; s < blockWidth; ++s) {
+            uint32_t gs = (ds * s * (gridX - 1) + 32) >> 6;
+            uint32_t js = gs >> 4;
+            uint32_t fs = gs & 0xf;
+
+            uint32_t v0 = js + jt * gridX;
+            uint32_t w11 = (fs * ft + 8) >> 4;
+            uint32_t w10 = ft - w11;
+            uint32_t w01 = fs - w11;
+            uint32_t w00 = 16 - fs - ft + w11;
+
+            // the factors of texels past the grid edge are always 0
+            uint32_t p00 = pGrid[v0 * stride];
+            uint32_t p01 = w01 ? pGrid[(v0 + 1) * stride] : 0;
+            uint32_t p10 = w10 ? pGrid[(v0 + gridX) * stride] : 0;
+            uint32_t p11 = w11 ? pGrid[(v0 + gridX + 1) * stride] : 0;
+            pOut[t * blockWidth + s] = static_cast<uint8_t>((p00 * w00 + p01 * w01 + p10 * w10 + p11 * w11 + 8) >> 4);
+        }
+    }
+}
+
+// c = ((e0 * 257) * (64 - w) + (e1 * 257) * w + 32) >> 6, keeping the top 8 bits of the 16 bit result.
+// Per channel weights allow the second plane of dual plane blocks to be merged in.
+inline void interpolate(const int *e0, const int *e1, const uint32_t *w, uint8_t *pOut) {
+#if defined(ASTC_USE_SSE2)
+    __m128i endpoints = _mm_setr_epi16(static_cast<int16_t>(e0[0]), static_cast<int16_t>(e1[0]), static_cast<int16_t>(e0[1]), static_cast<int16_t>(e1[1]),
+                                       static_cast<int16_t>(e0[2]), static_cast<int16_t>(e1[2]), static_cast<int16_t>(e0[3]), static_cast<int16_t>(e1[3]));
+    __m128i weights = _mm_setr_epi16(static_cast<int16_t>(64 - w[0]), static_cast<int16_t>(w[0]), static_cast<int16_t>(64 - w[1]), static_cast<int16_t>(w[1]),
+                                     static_cast<int16_t>(64 - w[2]), static_cast<int16_t>(w[2]), static_cast<int16_t>(64 - w[3]), static_cast<int16_t>(w[3]));
+    __m128i sum = _mm_madd_epi16(endpoints, weights);
+    __m128i c = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(sum, 8), sum), _mm_set1_epi32(32)), 14);
+    c = _mm_packs_epi32(c, c);
+    int32_t packed = _mm_cvtsi128_si32(_mm_packus_epi16(c, c));
+    memcpy(pOut, &packed, 4);
+#elif defined(ASTC_USE_NEON)
+    const uint16_t e0v[4] = {static_cast<uint16_t>(e0[0]), static_cast<uint16_t>(e0[1]), static_cast<uint16_t>(e0[2]), static_cast<uint16_t>(e0[3])};
+    const uint16_t e1v[4] = {static_cast<uint16_t>(e1[0]), static_cast<uint16_t>(e1[1]), static_cast<uint16_t>(e1[2]), static_cast<uint16_t>(e1[3])};
+    const uint16_t w1v[4] = {static_cast<uint16_t>(w[0]), static_cast<uint16_t>(w[1]), static_cast<uint16_t>(w[2]), static_cast<uint16_t>(w[3])};
+    uint16x4_t w1 = vld1_u16(w1v);
+    uint16x4_t w0 = vsub_u16(vdup_n_u16(64), w1);
+    uint32x4_t sum = vmlal_u16(vmull_u16(vld1_u16(e0v), w0), vld1_u16(e1v), w1);
+    uint32x4_t c = vshrq_n_u32(vmlaq_n_u32(vdupq_n_u32(32), sum, 257), 14);
+    uint8x8_t packed = vmovn_u16(vcombine_u16(vmovn_u32(c), vmovn_u32(c)));
+    vst1_lane_u32(reinterpret_cast<uint32_t *>(pOut), vreinterpret_u32_u8(packed), 0);
+#else
+    for (int i = 0; i < 4; ++i) {
+        uint32_t sum = static_cast<uint32_t>(e0[i]) * (64 - w[i]) + static_cast<uint32_t>(e1[i]) * w[i];
+        pOut[i] = static_cast<uint8_t>((sum * 257 + 32) >> 14);
+    }
+#endif
+}
+
+void fillBlock(const uint8_t *color, uint32_t blockWidth, uint32_t blockHeight, astc_byte *pOut, uint32_t outStride) {
+    for (uint32_t y = 0; y < blockHeight; ++y) {
+        for (uint32_t x = 0; x < blockWidth; ++x) {
+            memcpy(pOut + y * outStride + x * 4, color, 4);
+        }
+    }
+}
+
+} // namespace
+
+bool astcDecodeBlock(const astc_byte *pBlock, uint32_t blockWidth, uint32_t blockHeight, astc_byte *pOut, uint32_t outStride) {
+    Block128 block(pBlock);
+
+    auto fail = [&]() {
+        fillBlock(ERROR_COLOR, blockWidth, blockHeight, pOut, outStride);
+        return false;
+    };
+
+    uint32_t mode = block.bits(0, 11);
+    if ((mode & 0x1ff) == 0x1fc) {
+        // void extent: a constant color, HDR ones are not supported by the LDR profile
+        if (mode & 0x200) return fail();
+        uint8_t color[4];
+        for (uint32_t i = 0; i < 4; ++i) {
+            color[i] = static_cast<uint8_t>(block.bits(64 + i * 16, 16) >> 8);
+        }
+        fillBlock(color, blockWidth, blockHeight, pOut, outStride);
+        return true;
+    }
+
+    BlockMode blockMode;
+    if (!decodeBlockMode(mode, blockMode) || blockMode.weightsX > blockWidth || blockMode.weightsY > blockHeight) {
+        return fail();
+    }
+
+    const uint32_t partitionCount = block.bits(11, 2) + 1;
+    if (blockMode.dualPlane && partitionCount == 4) return fail();
+
+    const uint32_t planeCount = blockMode.dualPlane ? 2 : 1;
+    const uint32_t weightCount = blockMode.weightsX * blockMode.weightsY * planeCount;
+    const uint32_t weightBits = getSequenceBitCount(weightCount, blockMode.weightQuant);
+
+    uint32_t cems[4] = {0};
+    uint32_t colorStart = 17;
+    uint32_t belowWeights = 128 - weightBits;
+    if (partitionCount == 1) {
+        cems[0] = block.bits(13, 4);
+    } else {
+        colorStart = 29;
+        uint32_t cemField = block.bits(23, 6);
+        if ((cemField & 3) == 0) {
+            for (uint32_t i = 0; i < partitionCount; ++i) {
+                cems[i] = cemField >> 2;
+            }
+        } else {
+            uint32_t extraBits = 3 * partitionCount - 4;
+            belowWeights -= extraBits;
+            uint32_t encoded = (cemField >> 2) | (block.bits(belowWeights, extraBits) << 4);
+            uint32_t baseClass = (cemField & 3) - 1;
+            for (uint32_t i = 0; i < partitionCount; ++i) {
+                uint32_t c = (encoded >> i) & 1;
+                uint32_t m = (encoded >> (partitionCount + i * 2)) & 3;
+                cems[i] = ((baseClass + c) << 2) | m;
+            }
+        }
+    }
+
+    uint32_t ccs = 0;
+    if (blockMode.dualPlane) {
+        belowWeights -= 2;
+        ccs = block.bits(belowWeights, 2);
+    }
+
+    uint32_t colorValueCount = 0;
+    for (uint32_t i = 0; i < partitionCount; ++i) {
+        colorValueCount += ((cems[i] >> 2) + 1) * 2;
+    }
+    if (colorValueCount > MAX_COLOR_VALUES || belowWeights <= colorStart) return fail();
+
+    const uint32_t colorBits = belowWeights - colorStart;
+    uint32_t colorQuant = QUANT_256;
+    while (colorQuant >= QUANT_6 && getSequenceBitCount(colorValueCount, colorQuant) > colorBits) {
+        --colorQuant;
+    }
+    if (colorQuant < QUANT_6) return fail();
+
+    uint32_t colorValues[MAX_COLOR_VALUES];
+    decodeSequence(block, colorStart, colorValueCount, colorQuant, colorValues);
+    for (uint32_t i = 0; i < colorValueCount; ++i) {
+        colorValues[i] = unquantizeColor(colorValues[i], colorQuant);
+    }
+
+    int endpoints[4][2][4];
+    for (uint32_t i = 0, offset = 0; i < partitionCount; ++i) {
+        if (!decodeEndpoints(cems[i], colorValues + offset, endpoints[i][0], endpoints[i][1])) {
+            return fail();
+        }
+        offset += ((cems[i] >> 2) + 1) * 2;
+    }
+
+    // weights are stored bit reversed from the top of the block
+    uint32_t gridWeights[MAX_WEIGHTS];
+    decodeSequence(block.reversed(), 0, weightCount, blockMode.weightQuant, gridWeights);
+    for (uint32_t i = 0; i < weightCount; ++i) {
+        gridWeights[i] = unquantizeWeight(gridWeights[i], blockMode.weightQuant);
+    }
+
+    const uint32_t texelCount = blockWidth * blockHeight;
+    uint8_t weights[2][MAX_TEXELS];
+    for (uint32_t plane = 0; plane < planeCount; ++plane) {
+        if (blockMode.weightsX == blockWidth && blockMode.weightsY == blockHeight) {
+            for (uint32_t i = 0; i < texelCount; ++i) {
+                weights[plane][i] = static_cast<uint8_t>(gridWeights[i * planeCount + plane]);
+            }
+        } else {
+            infillWeights(gridWeights + plane, blockMode.weightsX, blockMode.weightsY, planeCount, blockWidth, blockHeight, weights[plane]);
+        }
+    }
+
+    const uint32_t partitionSeed = block.bits(13, 10);
+    const bool smallBlock = texelCount < 31;
+    for (uint32_t y = 0; y < blockHeight; ++y) {
+        for (uint32_t x = 0; x < blockWidth; ++x) {
+            uint32_t texel = y * blockWidth + x;
+            uint32_t partition = partitionCount > 1 ? selectPartition(partitionSeed, x, y, partitionCount, smallBlock) : 0;
+            uint32_t w[4];
+            w[0] = w[1] = w[2] = w[3] = weights[0][texel];
+            if (blockMode.dualPlane) {
+                w[ccs] = weights[1][texel];
+            }
+            interpolate(endpoints[partition][0], endpoints[partition][1], w, pOut + y * outStride + x * 4);
+        }
+    }
+
+    return true;
+}
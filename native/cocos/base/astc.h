@@ -48,3 +48,13 @@ int astcGetWidth(const astc_byte *pHeader);
 // Read the image height from a ASTC header
 
 int astcGetHeight(const astc_byte *pHeader);
+
+// Size of an encoded block, in bytes
+
+#define ASTC_BLOCK_SIZE 16
+
+// Decode a 2D LDR block of blockWidth x blockHeight texels into RGBA8 texels,
+// pOut points to the top-left texel and outStride is the row pitch in bytes.
+// HDR and malformed blocks are filled with the error color (magenta) and return false.
+
+bool astcDecodeBlock(const astc_byte *pBlock, uint32_t blockWidth, uint32_t blockHeight, astc_byte *pOut, uint32_t outStride);
@@ -71,3 +71,248 @@ etc2_uint32 etc2_pkm_get_height(const etc2_byte *pHeader) {
 etc2_uint32 etc2_pkm_get_format(const uint8_t *pHeader) {
     return readBEUint16(pHeader + ETC2_PKM_FORMAT_OFFSET);
 }
+
+// Block decoding, see the ETC2 section of the OpenGL ES 3.0 specification.
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define ETC2_USE_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define ETC2_USE_NEON
+#endif
+
+static const int kModifierTable[8][2] = {
+    {2, 8}, {5, 17}, {9, 29}, {13, 42}, {18, 60}, {24, 80}, {33, 106}, {47, 183}};
+
+static const int kDistanceTable[8] = {3, 6, 11, 16, 23, 32, 41, 64};
+
+static const int kEACModifierTable[16][8] = {
+    {-3, -6, -9, -15, 2, 5, 8, 14},
+    {-3, -7, -10, -13, 2, 6, 9, 12},
+    {-2, -5, -8, -13, 1, 4, 7, 12},
+    {-2, -4, -6, -13, 1, 3, 5, 12},
+    {-3, -6, -8, -12, 2, 5, 7, 11},
+    {-3, -7, -9, -11, 2, 6, 8, 10},
+    {-4, -7, -8, -11, 3, 6, 7, 10},
+    {-3, -5, -8, -11, 2, 4, 7, 10},
+    {-2, -6, -8, -10, 1, 5, 7, 9},
+    {-2, -5, -8, -10, 1, 4, 7, 9},
+    {-2, -4, -8, -10, 1, 3, 7, 9},
+    {-2, -5, -7, -10, 1, 4, 6, 9},
+    {-3, -4, -7, -10, 2, 3, 6, 9},
+    {-1, -2, -3, -10, 0, 1, 2, 9},
+    {-4, -6, -8, -9, 3, 5, 7, 8},
+    {-3, -5, -7, -9, 2, 4, 6, 8}};
+
+static inline int extend4to8(int v) { return (v << 4) | v; }
+static inline int extend5to8(int v) { return (v << 3) | (v >> 2); }
+static inline int extend6to8(int v) { return (v << 2) | (v >> 4); }
+static inline int extend7to8(int v) { return (v << 1) | (v >> 6); }
+static inline int signExtend3(int v) { return (v & 4) ? (v & 7) - 8 : (v & 7); }
+static inline int clamp255(int v) { return v < 0 ? 0 : (v > 255 ? 255 : v); }
+
+// Four RGBA8 colors of the form base + offset[i], saturated to [0, 255].
+static void makePalette(const int base[3], const int offsets[4], etc2_byte *pPalette) {
+#if defined(ETC2_USE_SSE2)
+    __m128i b = _mm_setr_epi16(base[0], base[1], base[2], 255, base[0], base[1], base[2], 255);
+    __m128i o01 = _mm_setr_epi16(offsets[0], offsets[0], offsets[0], 0, offsets[1], offsets[1], offsets[1], 0);
+    __m128i o23 = _mm_setr_epi16(offsets[2], offsets[2], offsets[2], 0, offsets[3], offsets[3], offsets[3], 0);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(pPalette), _mm_packus_epi16(_mm_add_epi16(b, o01), _mm_add_epi16(b, o23)));
+#elif defined(ETC2_USE_NEON)
+    const int16_t bv[8] = {static_cast<int16_t>(base[0]), static_cast<int16_t>(base[1]), static_cast<int16_t>(base[2]), 255,
+                           static_cast<int16_t>(base[0]), static_cast<int16_t>(base[1]), static_cast<int16_t>(base[2]), 255};
+    const int16_t o01v[8] = {static_cast<int16_t>(offsets[0]), static_cast<int16_t>(offsets[0]), static_cast<int16_t>(offsets[0]), 0,
+                             static_cast<int16_t>(offsets[1]), static_cast<int16_t>(offsets[1]), static_cast<int16_t>(offsets[1]), 0};
+    const int16_t o23v[8] = {static_cast<int16_t>(offsets[2]), static_cast<int16_t>(offsets[2]), static_cast<int16_t>(offsets[2]), 0,
+                             static_cast<int16_t>(offsets[3]), static_cast<int16_t>(offsets[3]), static_cast<int16_t>(offsets[3]), 0};
+    int16x8_t b = vld1q_s16(bv);
+    vst1q_u8(pPalette, vcombine_u8(vqmovun_s16(vaddq_s16(b, vld1q_s16(o01v))), vqmovun_s16(vaddq_s16(b, vld1q_s16(o23v)))));
+#else
+    for (int i = 0; i < 4; ++i) {
+        pPalette[i * 4 + 0] = static_cast<etc2_byte>(clamp255(base[0] + offsets[i]));
+        pPalette[i * 4 + 1] = static_cast<etc2_byte>(clamp255(base[1] + offsets[i]));
+        pPalette[i * 4 + 2] = static_cast<etc2_byte>(clamp255(base[2] + offsets[i]));
+        pPalette[i * 4 + 3] = 255;
+    }
+#endif
+}
+
+static void decodePlanar(const etc2_byte *pIn, etc2_byte *pOut, etc2_uint32 outStride) {
+    int ro = extend6to8((pIn[0] >> 1) & 0x3f);
+    int go = extend7to8(((pIn[0] & 1) << 6) | ((pIn[1] >> 1) & 0x3f));
+    int bo = extend6to8(((pIn[1] & 1) << 5) | (pIn[2] & 0x18) | ((pIn[2] & 3) << 1) | ((pIn[3] >> 7) & 1));
+    int rh = extend6to8(((pIn[3] >> 1) & 0x3e) | (pIn[3] & 1));
+    int gh = extend7to8((pIn[4] >> 1) & 0x7f);
+    int bh = extend6to8(((pIn[4] & 1) << 5) | ((pIn[5] >> 3) & 0x1f));
+    int rv = extend6to8(((pIn[5] & 7) << 3) | ((pIn[6] >> 5) & 7));
+    int gv = extend7to8(((pIn[6] & 0x1f) << 2) | ((pIn[7] >> 6) & 3));
+    int bv = extend6to8(pIn[7] & 0x3f);
+
+    // c(x, y) = (x * (H - O) + y * (V - O) + 4 * O + 2) >> 2, alpha lanes stay at 4 * 255
+#if defined(ETC2_USE_SSE2)
+    __m128i dh = _mm_setr_epi16(rh - ro, gh - go, bh - bo, 0, rh - ro, gh - go, bh - bo, 0);
+    __m128i dv = _mm_setr_epi16(rv - ro, gv - go, bv - bo, 0, rv - ro, gv - go, bv - bo, 0);
+    __m128i row = _mm_setr_epi16(4 * ro + 2, 4 * go + 2, 4 * bo + 2, 4 * 255 + 2, 4 * ro + 2 + rh - ro, 4 * go + 2 + gh - go, 4 * bo + 2 + bh - bo, 4 * 255 + 2);
+    __m128i dh2 = _mm_slli_epi16(dh, 1);
+    for (int y = 0; y < 4; ++y) {
+        __m128i p01 = _mm_srai_epi16(row, 2);
+        __m128i p23 = _mm_srai_epi16(_mm_add_epi16(row, dh2), 2);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(pOut + y * outStride), _mm_packus_epi16(p01, p23));
+        row = _mm_add_epi16(row, dv);
+    }
+#elif defined(ETC2_USE_NEON)
+    const int16_t dhv[8] = {static_cast<int16_t>(rh - ro), static_cast<int16_t>(gh - go), static_cast<int16_t>(bh - bo), 0,
+                            static_cast<int16_t>(rh - ro), static_cast<int16_t>(gh - go), static_cast<int16_t>(bh - bo), 0};
+    const int16_t dvv[8] = {static_cast<int16_t>(rv - ro), static_cast<int16_t>(gv - go), static_cast<int16_t>(bv - bo), 0,
+                            static_cast<int16_t>(rv - ro), static_cast<int16_t>(gv - go), static_cast<int16_t>(bv - bo), 0};
+    const int16_t rowv[8] = {static_cast<int16_t>(4 * ro + 2), static_cast<int16_t>(4 * go + 2), static_cast<int16_t>(4 * bo + 2), 4 * 255 + 2,
+                             static_cast<int16_t>(3 * ro + 2 + rh), static_cast<int16_t>(3 * go + 2 + gh), static_cast<int16_t>(3 * bo + 2 + bh), 4 * 255 + 2};
+    int16x8_t dv = vld1q_s16(dvv);
+    int16x8_t dh2 = vshlq_n_s16(vld1q_s16(dhv), 1);
+    int16x8_t row = vld1q_s16(rowv);
+    for (int y = 0; y < 4; ++y) {
+        uint8x8_t p01 = vqmovun_s16(vshrq_n_s16(row, 2));
+        uint8x8_t p23 = vqmovun_s16(vshrq_n_s16(vaddq_s16(row, dh2), 2));
+        vst1q_u8(pOut + y * outStride, vcombine_u8(p01, p23));
+        row = vaddq_s16(row, dv);
+    }
+#else
+    for (int y = 0; y < 4; ++y) {
+        etc2_byte *pRow = pOut + y * outStride;
+        for (int x = 0; x < 4; ++x) {
+            pRow[x * 4 + 0] = static_cast<etc2_byte>(clamp255((x * (rh - ro) + y * (rv - ro) + 4 * ro + 2) >> 2));
+            pRow[x * 4 + 1] = static_cast<etc2_byte>(clamp255((x * (gh - go) + y * (gv - go) + 4 * go + 2) >> 2));
+            pRow[x * 4 + 2] = static_cast<etc2_byte>(clamp255((x * (bh - bo) + y * (bv - bo) + 4 * bo + 2) >> 2));
+            pRow[x * 4 + 3] = 255;
+        }
+    }
+#endif
+}
+
+void etc2_decode_rgb_block(const etc2_byte *pIn, etc2_byte *pOut, etc2_uint32 outStride, etc2_bool punchthrough) {
+    // 2 sub-blocks x 4 colors, or 4 paint colors for T and H modes
+    etc2_byte palette[2][16];
+    bool paintMode = false;
+
+    // in punchthrough blocks the diff bit is the opaque bit and the individual mode is unavailable
+    bool diff = punchthrough || (pIn[3] & 2);
+    bool opaque = !punchthrough || (pIn[3] & 2);
+    bool flip = pIn[3] & 1;
+
+    int base1[3];
+    int base2[3];
+    if (diff) {
+        int r = pIn[0] >> 3;
+        int g = pIn[1] >> 3;
+        int b = pIn[2] >> 3;
+        int r2 = r + signExtend3(pIn[0]);
+        int g2 = g + signExtend3(pIn[1]);
+        int b2 = b + signExtend3(pIn[2]);
+
+        if (r2 < 0 || r2 > 31) { // T mode
+            int c1[3] = {extend4to8(((pIn[0] >> 1) & 0xc) | (pIn[0] & 3)), extend4to8(pIn[1] >> 4), extend4to8(pIn[1] & 0xf)};
+            int c2[3] = {extend4to8(pIn[2] >> 4), extend4to8(pIn[2] & 0xf), extend4to8(pIn[3] >> 4)};
+            int d = kDistanceTable[((pIn[3] >> 1) & 6) | (pIn[3] & 1)];
+            const int offsets1[4] = {0, 0, 0, 0};
+            const int offsets2[4] = {0, d, 0, -d};
+            etc2_byte tmp[16];
+            makePalette(c1, offsets1, tmp);
+            makePalette(c2, offsets2, palette[0]);
+            memcpy(palette[0], tmp, 4);
+            paintMode = true;
+        } else if (g2 < 0 || g2 > 31) { // H mode
+            int r1 = (pIn[0] >> 3) & 0xf;
+            int g1 = ((pIn[0] & 7) << 1) | ((pIn[1] >> 4) & 1);
+            int b1 = (pIn[1] & 8) | ((pIn[1] & 3) << 1) | ((pIn[2] >> 7) & 1);
+            int rr2 = (pIn[2] >> 3) & 0xf;
+            int gg2 = ((pIn[2] & 7) << 1) | ((pIn[3] >> 7) & 1);
+            int bb2 = (pIn[3] >> 3) & 0xf;
+            int order = ((r1 << 8) | (g1 << 4) | b1) >= ((rr2 << 8) | (gg2 << 4) | bb2) ? 1 : 0;
+            int d = kDistanceTable[(pIn[3] & 4) | ((pIn[3] & 1) << 1) | order];
+            int c1[3] = {extend4to8(r1), extend4to8(g1), extend4to8(b1)};
+            int c2[3] = {extend4to8(rr2), extend4to8(gg2), extend4to8(bb2)};
+            const int offsets[4] = {d, -d, d, -d};
+            etc2_byte tmp[16];
+            makePalette(c1, offsets, tmp);
+            makePalette(c2, offsets, palette[0]);
+            memcpy(palette[0], tmp, 8);
+            paintMode = true;
+        } else if (b2 < 0 || b2 > 31) {
+            decodePlanar(pIn, pOut, outStride);
+            return;
+        } else {
+            base1[0] = extend5to8(r);
+            base1[1] = extend5to8(g);
+            base1[2] = extend5to8(b);
+            base2[0] = extend5to8(r2);
+            base2[1] = extend5to8(g2);
+            base2[2] = extend5to8(b2);
+        }
+    } else {
+        base1[0] = extend4to8(pIn[0] >> 4);
+        base1[1] = extend4to8(pIn[1] >> 4);
+        base1[2] = extend4to8(pIn[2] >> 4);
+        base2[0] = extend4to8(pIn[0] & 0xf);
+        base2[1] = extend4to8(pIn[1] & 0xf);
+        base2[2] = extend4to8(pIn[2] & 0xf);
+    }
+
+    if (!paintMode) {
+        const int *m1 = kModifierTable[(pIn[3] >> 5) & 7];
+        const int *m2 = kModifierTable[(pIn[3] >> 2) & 7];
+        // pixel index (msb, lsb): 0 -> +a, 1 -> +b, 2 -> -a, 3 -> -b
+        // non-opaque punchthrough blocks drop the small modifier, index 2 becomes transparent later
+        int small1 = opaque ? m1[0] : 0;
+        int small2 = opaque ? m2[0] : 0;
+        const int offsets1[4] = {small1, m1[1], -small1, -m1[1]};
+        const int offsets2[4] = {small2, m2[1], -small2, -m2[1]};
+        makePalette(base1, offsets1, palette[0]);
+        makePalette(base2, offsets2, palette[1]);
+    }
+
+    etc2_uint32 indices = (static_cast<etc2_uint32>(pIn[4]) << 24) | (static_cast<etc2_uint32>(pIn[5]) << 16) |
+                          (static_cast<etc2_uint32>(pIn[6]) << 8) | pIn[7];
+    for (int x = 0; x < 4; ++x) {
+        for (int y = 0; y < 4; ++y) {
+            int i = x * 4 + y;
+            int index = (((indices >> (i + 16)) & 1) << 1) | ((indices >> i) & 1);
+            int sub = paintMode ? 0 : (flip ? (y >= 2) : (x >= 2));
+            etc2_byte *pTexel = pOut + y * outStride + x * 4;
+            if (!opaque && index == 2) {
+                memset(pTexel, 0, 4);
+            } else {
+                memcpy(pTexel, palette[sub] + index * 4, 4);
+            }
+        }
+    }
+}
+
+void etc2_decode_eac_block(const etc2_byte *pIn, etc2_byte *pOut, etc2_uint32 outStride, etc2_uint32 channel) {
+    int base = pIn[0];
+    int multiplier = pIn[1] >> 4;
+    const int *modifiers = kEACModifierTable[pIn[1] & 0xf];
+
+    etc2_byte values[8];
+    for (int i = 0; i < 8; ++i) {
+        if (channel == 3) {
+            values[i] = static_cast<etc2_byte>(clamp255(base + modifiers[i] * multiplier));
+        } else {
+            // 11 bit: base * 8 + 4 + modifier * multiplier * 8, with a multiplier of 0 read as 1/8
+            int value = base * 8 + 4 + (multiplier ? modifiers[i] * multiplier * 8 : modifiers[i]);
+            value = value < 0 ? 0 : (value > 2047 ? 2047 : value);
+            values[i] = static_cast<etc2_byte>(value >> 3);
+        }
+    }
+
+    uint64_t indices = 0;
+    for (int i = 2; i < 8; ++i) {
+        indices = (indices << 8) | pIn[i];
+    }
+    for (int x = 0; x < 4; ++x) {
+        for (int y = 0; y < 4; ++y) {
+            int i = x * 4 + y;
+            pOut[y * outStride + x * 4 + channel] = values[(indices >> (45 - i * 3)) & 7];
+        }
+    }
+}
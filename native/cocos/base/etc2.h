@@ -67,6 +67,22 @@ etc2_uint32 etc2_pkm_get_height(const etc2_byte *pHeader);
 
 etc2_uint32 etc2_pkm_get_format(const etc2_byte *pHeader);
 
+// Size of an encoded block, in bytes. RGBA and RG11 blocks take two of them.
+
+#define ETC2_ENCODED_BLOCK_SIZE 8
+
+// Decode a 4x4 ETC2 RGB block (or ETC1, which is a subset) into RGBA8 texels.
+// pOut points to the top-left texel, outStride is the row pitch in bytes.
+// With punchthrough the block is read as RGB8_A1, otherwise alpha is set to 255.
+
+void etc2_decode_rgb_block(const etc2_byte *pIn, etc2_byte *pOut, etc2_uint32 outStride, etc2_bool punchthrough);
+
+// Decode a 4x4 EAC block into one 8 bit channel (0: R, 1: G, 2: B, 3: A) of RGBA8 texels.
+// Channel 3 reads the alpha block of RGBA8_EAC, the others read unsigned R11/RG11 blocks
+// and keep the top 8 bits.
+
+void etc2_decode_eac_block(const etc2_byte *pIn, etc2_byte *pOut, etc2_uint32 outStride, etc2_uint32 channel);
+
 #ifdef __cplusplus
 }
 #endif
@@ -73,6 +73,7 @@ events::Orientation::Listener EventDispatcher::listenerOrientation;
 events::RestartVM::Listener EventDispatcher::listenerRestartVM;
 events::Close::Listener EventDispatcher::listenerClose;
 events::PointerLock::Listener EventDispatcher::listenerPointerLock;
+events::ServerAnimationStep::Listener EventDispatcher::listenerServerAnimationStep;
 
 uint32_t EventDispatcher::hashListenerId = 1;
 
@@ -103,6 +104,7 @@ void EventDispatcher::init() {
         listenerClose.bind(&dispatchCloseEvent);
         listenerRestartVM.bind(&dispatchRestartVM);
         listenerPointerLock.bind(&dispatchPointerlockChangeEvent);
+        listenerServerAnimationStep.bind(&dispatchServerAnimationStepEvent);
         busListenerInited = true;
     }
 }
@@ -470,6 +472,12 @@ void EventDispatcher::dispatchPointerlockChangeEvent(bool value) {
     EventDispatcher::doDispatchJsEvent("onPointerlockChange", args);
 }
 
+void EventDispatcher::dispatchServerAnimationStepEvent(float dt) {
+    se::ValueArray args;
+    args.emplace_back(se::Value(dt));
+    EventDispatcher::doDispatchJsEvent("onServerAnimationStep", args);
+}
+
 void EventDispatcher::doDispatchJsEvent(const char *jsFunctionName, const std::vector<se::Value> &args) {
     if (!se::ScriptEngine::getInstance()->isValid()) {
         return;
@@ -59,6 +59,7 @@ private:
     static void dispatchRestartVM();
     static void dispatchCloseEvent();
     static void dispatchPointerlockChangeEvent(bool value);
+    static void dispatchServerAnimationStepEvent(float dt);
     static uint32_t hashListenerId; // simple increment hash
 
     static events::EnterForeground::Listener listenerEnterForeground;
@@ -78,6 +79,7 @@ private:
     static events::RestartVM::Listener listenerRestartVM;
     static events::Close::Listener listenerClose;
     static events::PointerLock::Listener listenerPointerLock;
+    static events::ServerAnimationStep::Listener listenerServerAnimationStep;
 };
 
 } // end of namespace cc
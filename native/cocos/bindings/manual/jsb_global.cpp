@@ -1589,6 +1589,12 @@ bool jsb_register_global_variables(se::Object *global) { // NOLINT
     processObj->defineProperty("argv", _SE(JSB_process_get_argv), nullptr);
     __jsbObj->setProperty("process", se::Value(processObj));
 
+#if defined(CC_DEDICATED_SERVER)
+    __jsbObj->setProperty("isDedicatedServer", se::Value(true));
+#else
+    __jsbObj->setProperty("isDedicatedServer", se::Value(false));
+#endif
+
     se::HandleObject zipUtils(se::Object::createPlainObject());
     zipUtils->defineFunction("inflateMemory", _SE(JSB_zipUtils_inflateMemory));
     zipUtils->defineFunction("inflateGZipFile", _SE(JSB_zipUtils_inflateGZipFile));
@@ -32,12 +32,14 @@
 #include "platform/interfaces/modules/ISystemWindowManager.h"
 #include "platform/interfaces/modules/IXRInterface.h"
 #if CC_USE_DEBUG_RENDERER
+    #include "core/assets/FreeTypeFont.h"
     #include "profiler/DebugRenderer.h"
 #endif
 #include "engine/EngineEvents.h"
 #include "profiler/Profiler.h"
 #include "renderer/gfx-base/GFXDevice.h"
 #include "renderer/gfx-base/GFXSwapchain.h"
+#include "renderer/pipeline/ClusterLightCulling.h"
 #include "renderer/pipeline/Define.h"
 #include "renderer/pipeline/GeometryRenderer.h"
 #include "renderer/pipeline/PipelineSceneData.h"
@@ -76,6 +78,8 @@ Root::~Root() {
 }
 
 void Root::initialize(gfx::Swapchain * /*swapchain*/) {
+    // a dedicated server has no window, swapchain nor pipeline, Root only owns the scenes
+#if !defined(CC_DEDICATED_SERVER)
     auto *windowMgr = CC_GET_PLATFORM_INTERFACE(ISystemWindowManager);
     const auto &windows = windowMgr->getWindows();
     for (const auto &pair : windows) {
@@ -96,6 +100,9 @@ void Root::initialize(gfx::Swapchain * /*swapchain*/) {
     pipeline::localDescriptorSetLayoutResizeMaxJoints(maxJoints);
 
     _debugView = std::make_unique<pipeline::DebugView>();
+
+    _uniformRingBuffer = ccnew gfx::FrameRingBuffer(_device, {});
+#endif
 }
 
 render::Pipeline *Root::getCustomPipeline() const {
@@ -159,6 +166,7 @@ void Root::destroy() {
     CC_SAFE_DESTROY_NULL(_pipeline);
 
     CC_SAFE_DELETE(_batcher);
+    _uniformRingBuffer = nullptr;
 
     for (auto *swapchain : _swapchains) {
         CC_SAFE_DELETE(swapchain);
@@ -301,6 +309,11 @@ public:
 } // namespace
 
 bool Root::setRenderPipeline(pipeline::RenderPipeline *rppl /* = nullptr*/) {
+#if defined(CC_DEDICATED_SERVER)
+    CC_UNUSED_PARAM(rppl);
+    CC_LOG_WARNING("A dedicated server has no render pipeline.");
+    return false;
+#else
     if (rppl) {
         if (dynamic_cast<pipeline::DeferredPipeline *>(rppl) != nullptr) {
             _useDeferredPipeline = true;
@@ -311,7 +324,7 @@ bool Root::setRenderPipeline(pipeline::RenderPipeline *rppl /* = nullptr*/) {
         rppl->setPipelineRuntime(_pipelineRuntime.get());
 
         // now cluster just enabled in deferred pipeline
-        if (!_useDeferredPipeline || !_device->hasFeature(gfx::Feature::COMPUTE_SHADER)) {
+        if (!_useDeferredPipeline || !pipeline::ClusterLightCulling::isSupported(_device)) {
             // disable cluster
             _pipeline->setClusterEnabled(false);
         }
@@ -352,6 +365,7 @@ bool Root::setRenderPipeline(pipeline::RenderPipeline *rppl /* = nullptr*/) {
     }
 
     return true;
+#endif
 }
 
 void Root::onGlobalPipelineStateChanged() {
@@ -390,6 +404,10 @@ void Root::frameMoveBegin() {
         _batcher->update();
     }
 
+    if (_uniformRingBuffer) {
+        _uniformRingBuffer->beginFrame();
+    }
+
     //
     _cameraList.clear();
 }
@@ -435,6 +453,7 @@ void Root::frameMoveEnd() {
         }
     #endif
     #if CC_USE_DEBUG_RENDERER
+        FreeTypeFontFace::flushPendingTextures();
         CC_DEBUG_RENDERER->update();
     #endif
 
@@ -465,6 +484,10 @@ void Root::frameMove(float deltaTime, int32_t totalFrames) { // NOLINT
         _fpsTime = 0.0;
     }
 
+#if defined(CC_DEDICATED_SERVER)
+    // nothing to render, the ServerWorlds update the scenes on their own steps
+    CC_UNUSED_PARAM(totalFrames);
+#else
     if (_xr) {
         doXRFrameMove(totalFrames);
     } else {
@@ -472,6 +495,7 @@ void Root::frameMove(float deltaTime, int32_t totalFrames) { // NOLINT
         frameMoveProcess(true, totalFrames);
         frameMoveEnd();
     }
+#endif
 }
 
 scene::RenderWindow *Root::createWindow(scene::IRenderWindowInfo &info) {
@@ -28,6 +28,7 @@
 #include "bindings/event/EventDispatcher.h"
 #include "core/event/Event.h"
 #include "core/memop/Pool.h"
+#include "renderer/gfx-base/GFXFrameRingBuffer.h"
 #include "renderer/pipeline/RenderPipeline.h"
 #include "renderer/pipeline/DebugView.h"
 #include "scene/DrawBatch2D.h"
@@ -241,6 +242,13 @@ public:
      */
     inline Batcher2d *getBatcher2D() const { return _batcher; }
 
+    /**
+     * @en Per frame sub-allocator of dynamic uniform data, bound with dynamic offsets.
+     * Allocate after the frame begins, the legacy and the custom pipeline flush it before submitting their command buffers.
+     * @zh 每帧动态 uniform 数据的子分配器，以动态偏移绑定。帧开始后分配，传统管线与自定义管线在提交命令缓冲前将其上传。
+     */
+    inline gfx::FrameRingBuffer *getUniformRingBuffer() const { return _uniformRingBuffer.get(); }
+
     /**
      * @zh
      * 场景列表
@@ -309,6 +317,7 @@ private:
     gfx::Device *_device{nullptr};
     gfx::Swapchain *_swapchain{nullptr};
     Batcher2d *_batcher{nullptr};
+    IntrusivePtr<gfx::FrameRingBuffer> _uniformRingBuffer;
     IntrusivePtr<scene::RenderWindow> _mainRenderWindow;
     IntrusivePtr<scene::RenderWindow> _curRenderWindow;
     IntrusivePtr<scene::RenderWindow> _tempWindow;
@@ -103,6 +103,8 @@ public:
 
     virtual const FontGlyph *getGlyph(uint32_t code) = 0;
     virtual float getKerning(uint32_t prevCode, uint32_t nextCode) = 0;
+    // upload glyphs loaded since the last call, the engine flushes all FreeType faces once per frame before rendering
+    virtual void flushTextures() {}
 
     inline Font *getFont() const { return _font; }
     inline uint32_t getFontSize() const { return _fontSize; }
@@ -28,12 +28,25 @@
 #include "FreeTypeFont.h"
 #include <freetype/ft2build.h>
 #include FT_FREETYPE_H
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <mutex>
 #include "base/Log.h"
+#include "base/job-system/JobSystem.h"
 #include "gfx-base/GFXDevice.h"
+#include "profiler/Profiler.h"
 
 namespace cc {
 
+namespace {
+// glyphs rasterized by one job, creating a FT_Face per job is not worth it for a few glyphs
+constexpr uint32_t MIN_GLYPHS_PER_JOB = 32U;
+
+// FT_New_Face and FT_Done_Face modify the library, they must not run concurrently
+std::mutex faceMutex;
+} // namespace
+
 /**
  * FTLibrary
  */
@@ -69,6 +82,7 @@ struct FTFace {
 
     ~FTFace() {
         if (face) {
+            std::lock_guard<std::mutex> lock(faceMutex);
             FT_Done_Face(face);
             face = nullptr;
         }
@@ -136,6 +150,7 @@ private:
  * FreeTypeFontFace
  */
 FTLibrary *FreeTypeFontFace::library = nullptr;
+ccstd::vector<FreeTypeFontFace *> FreeTypeFontFace::pendingFaces;
 FreeTypeFontFace::FreeTypeFontFace(Font *font)
 : FontFace(font) {
     if (!library) {
@@ -143,6 +158,12 @@ FreeTypeFontFace::FreeTypeFontFace(Font *font)
     }
 }
 
+FreeTypeFontFace::~FreeTypeFontFace() {
+    if (!_uploads.empty()) {
+        pendingFaces.erase(std::remove(pendingFaces.begin(), pendingFaces.end(), this), pendingFaces.end());
+    }
+}
+
 void FreeTypeFontFace::doInit(const FontFaceInfo &info) {
     const auto &fontData = _font->getData();
     if (fontData.empty()) {
@@ -155,25 +176,37 @@ void FreeTypeFontFace::doInit(const FontFaceInfo &info) {
     _textureHeight = info.textureHeight;
     _allocator = std::make_unique<GlyphAllocator>(_textureWidth, _textureHeight);
 
+    _face = createFace();
+    if (!_face) {
+        return;
+    }
+
+    _lineHeight = static_cast<uint32_t>(_face->face->size->metrics.height >> 6);
+
+    prewarm(info.preLoadedCharacters);
+}
+
+std::unique_ptr<FTFace> FreeTypeFontFace::createFace() const {
+    const auto &fontData = _font->getData();
     FT_Face face{nullptr};
-    FT_Error error = FT_New_Memory_Face(library->lib, fontData.data(), static_cast<FT_Long>(fontData.size()), 0, &face);
+    FT_Error error{0};
+    {
+        std::lock_guard<std::mutex> lock(faceMutex);
+        error = FT_New_Memory_Face(library->lib, fontData.data(), static_cast<FT_Long>(fontData.size()), 0, &face);
+    }
     if (error) {
         CC_LOG_ERROR("FT_New_Memory_Face failed, error code: %d.", error);
-        return;
+        return nullptr;
     }
 
+    auto result = std::make_unique<FTFace>(face);
     error = FT_Set_Pixel_Sizes(face, 0, _fontSize);
     if (error) {
         CC_LOG_ERROR("FT_Set_Pixel_Sizes failed, error code: %d.", error);
-        return;
+        return nullptr;
     }
 
-    _face = std::make_unique<FTFace>(face);
-    _lineHeight = static_cast<uint32_t>(face->size->metrics.height >> 6);
-
-    for (const auto &code : info.preLoadedCharacters) {
-        loadGlyph(code);
-    }
+    return result;
 }
 
 const FontGlyph *FreeTypeFontFace::getGlyph(uint32_t code) {
@@ -212,21 +245,98 @@ float FreeTypeFontFace::getKerning(uint32_t prevCode, uint32_t nextCode) {
     return result;
 }
 
+void FreeTypeFontFace::prewarm(const ccstd::vector<uint32_t> &codes) {
+    CC_PROFILE(FreeTypeFontFacePrewarm);
+    if (!_face) {
+        return;
+    }
+
+    ccstd::vector<uint32_t> newCodes;
+    newCodes.reserve(codes.size());
+    for (const auto code : codes) {
+        if (_glyphs.find(code) == _glyphs.end()) {
+            newCodes.push_back(code);
+        }
+    }
+    std::sort(newCodes.begin(), newCodes.end());
+    newCodes.erase(std::unique(newCodes.begin(), newCodes.end()), newCodes.end());
+
+    ccstd::vector<GlyphBitmap> bitmaps(newCodes.size());
+    for (auto i = 0U; i < newCodes.size(); i++) {
+        bitmaps[i].code = newCodes[i];
+    }
+
+    const auto bitmapCount = static_cast<uint32_t>(bitmaps.size());
+    const auto chunkCount = std::min(JobSystem::getInstance()->threadCount(), (bitmapCount + MIN_GLYPHS_PER_JOB - 1U) / MIN_GLYPHS_PER_JOB);
+    if (chunkCount <= 1U) {
+        for (auto &bitmap : bitmaps) {
+            rasterizeGlyph(_face.get(), bitmap);
+        }
+    } else {
+        const auto chunkSize = (bitmapCount - 1U) / chunkCount + 1U;
+        auto job = [this, &bitmaps, bitmapCount, chunkSize](uint32_t chunk) {
+            auto face = createFace();
+            if (!face) {
+                return; // left to be loaded on demand
+            }
+
+            const auto end = std::min(bitmapCount, (chunk + 1U) * chunkSize);
+            for (auto i = chunk * chunkSize; i < end; i++) {
+                rasterizeGlyph(face.get(), bitmaps[i]);
+            }
+        };
+
+        JobGraph g(JobSystem::getInstance());
+        g.createForEachIndexJob(0U, chunkCount, 1U, job);
+        g.run();
+        g.waitForAll();
+    }
+
+    // atlas packing stays on the calling thread to keep the layout deterministic
+    for (auto &bitmap : bitmaps) {
+        if (bitmap.loaded) {
+            addGlyph(bitmap);
+        }
+    }
+}
+
 const FontGlyph *FreeTypeFontFace::loadGlyph(uint32_t code) {
-    FT_Face face = _face->face;
-    FT_Error error = FT_Load_Char(face, code, FT_LOAD_RENDER);
-    if (error) {
-        CC_LOG_WARNING("FT_Load_Char failed, error code: %d, character: %u.", error, code);
+    GlyphBitmap bitmap;
+    bitmap.code = code;
+    if (!rasterizeGlyph(_face.get(), bitmap)) {
         return nullptr;
     }
 
-    FontGlyph glyph;
-    glyph.width = face->glyph->bitmap.width;
-    glyph.height = face->glyph->bitmap.rows;
-    glyph.bearingX = face->glyph->bitmap_left;
-    glyph.bearingY = face->glyph->bitmap_top;
-    glyph.advance = static_cast<int32_t>(face->glyph->advance.x >> 6); // advance.x's unit is 1/64 pixels
+    return addGlyph(bitmap);
+}
+
+bool FreeTypeFontFace::rasterizeGlyph(FTFace *face, GlyphBitmap &bitmap) const {
+    FT_GlyphSlot slot = face->face->glyph;
+    FT_Error error = FT_Load_Char(face->face, bitmap.code, FT_LOAD_RENDER);
+    if (error) {
+        CC_LOG_WARNING("FT_Load_Char failed, error code: %d, character: %u.", error, bitmap.code);
+        return false;
+    }
+
+    auto &glyph = bitmap.glyph;
+    glyph.width = slot->bitmap.width;
+    glyph.height = slot->bitmap.rows;
+    glyph.bearingX = slot->bitmap_left;
+    glyph.bearingY = slot->bitmap_top;
+    glyph.advance = static_cast<int32_t>(slot->advance.x >> 6); // advance.x's unit is 1/64 pixels
+
+    // rows of the FreeType bitmap may be padded
+    bitmap.buffer.resize(glyph.width * glyph.height);
+    for (auto row = 0U; row < glyph.height; row++) {
+        memcpy(bitmap.buffer.data() + row * glyph.width, slot->bitmap.buffer + row * slot->bitmap.pitch, glyph.width);
+    }
+
+    bitmap.loaded = true;
+    return true;
+}
 
+const FontGlyph *FreeTypeFontFace::addGlyph(GlyphBitmap &bitmap) {
+    auto &glyph = bitmap.glyph;
     uint32_t x = 0U;
     uint32_t y = 0U;
 
@@ -242,22 +352,66 @@ const FontGlyph *FreeTypeFontFace::loadGlyph(uint32_t code) {
             // try new empty texture
             _allocator->reset();
             if (!_allocator->allocate(glyph.width + 1, glyph.height + 1, x, y)) {
-                CC_LOG_WARNING("Glyph allocate failed, character: %u.", code);
+                CC_LOG_WARNING("Glyph allocate failed, character: %u.", bitmap.code);
                 return nullptr;
             }
         }
 
+        if (_uploads.empty()) {
+            pendingFaces.push_back(this);
+        }
         auto page = static_cast<uint32_t>(_textures.size() - 1);
-        updateTexture(page, x, y, glyph.width, glyph.height, face->glyph->bitmap.buffer);
+        _uploads.push_back({page, x, y, glyph.width, glyph.height, std::move(bitmap.buffer)});
 
         glyph.x = x;
         glyph.y = y;
         glyph.page = page;
     }
 
-    _glyphs[code] = glyph;
+    auto &result = _glyphs[bitmap.code];
+    result = glyph;
+
+    return &result;
+}
+
+void FreeTypeFontFace::flushTextures() {
+    if (_uploads.empty()) {
+        return;
+    }
+
+    CC_PROFILE(FreeTypeFontFaceFlushTextures);
+    std::stable_sort(_uploads.begin(), _uploads.end(), [](const TextureUpload &a, const TextureUpload &b) { return a.page < b.page; });
+
+    auto *device = gfx::Device::getInstance();
+    gfx::BufferDataList buffers;
+    gfx::BufferTextureCopyList regions;
+    for (size_t i = 0; i < _uploads.size(); i++) {
+        const auto &upload = _uploads[i];
+        buffers.push_back(upload.buffer.data());
+        regions.push_back({0U,
+                           0U,
+                           0U,
+                           {static_cast<int32_t>(upload.x), static_cast<int32_t>(upload.y), 0U},
+                           {upload.width, upload.height, 1U},
+                           {0U, 0U, 1U}});
+
+        if (i + 1 == _uploads.size() || _uploads[i + 1].page != upload.page) {
+            device->copyBuffersToTexture(buffers, getTexture(upload.page), regions);
+            buffers.clear();
+            regions.clear();
+        }
+    }
+
+    _uploads.clear();
+    pendingFaces.erase(std::remove(pendingFaces.begin(), pendingFaces.end(), this), pendingFaces.end());
+}
 
-    return &_glyphs[code];
+void FreeTypeFontFace::flushPendingTextures() {
+    auto faces = std::move(pendingFaces);
+    pendingFaces.clear();
+    for (auto *face : faces) {
+        face->flushTextures();
+    }
 }
 
 void FreeTypeFontFace::createTexture(uint32_t width, uint32_t height) {
@@ -29,6 +29,7 @@
 #include <memory>
 #include "Font.h"
 #include "base/std/container/string.h"
+#include "base/std/container/vector.h"
 
 namespace cc {
 
@@ -42,7 +43,7 @@ class GlyphAllocator;
 class FreeTypeFontFace : public FontFace {
 public:
     explicit FreeTypeFontFace(Font *font);
-    ~FreeTypeFontFace() override = default;
+    ~FreeTypeFontFace() override;
     FreeTypeFontFace(const FreeTypeFontFace &) = delete;
     FreeTypeFontFace(FreeTypeFontFace &&) = delete;
     FreeTypeFontFace &operator=(const FreeTypeFontFace &) = delete;
@@ -50,17 +51,50 @@ public:
 
     const FontGlyph *getGlyph(uint32_t code) override;
     float getKerning(uint32_t prevCode, uint32_t nextCode) override;
+    void flushTextures() override;
+
+    /**
+     * Rasterize the characters on job workers and pack them into the atlas on the calling thread,
+     * each worker uses its own FT_Face since FreeType faces can not be shared between threads.
+     */
+    void prewarm(const ccstd::vector<uint32_t> &codes);
+
+    // uploads the glyphs of every face loaded since the last call, called by the engine once per frame before rendering
+    static void flushPendingTextures();
     static void destroyFreeType();
 
 private:
+    struct GlyphBitmap {
+        uint32_t code{0U};
+        bool loaded{false};
+        FontGlyph glyph;
+        ccstd::vector<uint8_t> buffer; // tightly packed, glyph.width * glyph.height
+    };
+
+    struct TextureUpload {
+        uint32_t page{0U};
+        uint32_t x{0U};
+        uint32_t y{0U};
+        uint32_t width{0U};
+        uint32_t height{0U};
+        ccstd::vector<uint8_t> buffer;
+    };
+
     void doInit(const FontFaceInfo &info) override;
     const FontGlyph *loadGlyph(uint32_t code);
+    bool rasterizeGlyph(FTFace *face, GlyphBitmap &bitmap) const;
+    const FontGlyph *addGlyph(GlyphBitmap &bitmap);
+    std::unique_ptr<FTFace> createFace() const;
     void createTexture(uint32_t width, uint32_t height);
     void updateTexture(uint32_t page, uint32_t x, uint32_t y, uint32_t width, uint32_t height, const uint8_t *buffer);
 
     std::unique_ptr<GlyphAllocator> _allocator{nullptr};
     std::unique_ptr<FTFace> _face;
+    // glyph bitmaps waiting for flushTextures(), uploaded with one copy per texture
+    ccstd::vector<TextureUpload> _uploads;
     static FTLibrary *library;
+    // faces with glyphs waiting for flushTextures()
+    static ccstd::vector<FreeTypeFontFace *> pendingFaces;
 
     friend class FreeTypeFont;
 };
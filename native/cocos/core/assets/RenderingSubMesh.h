@@ -25,6 +25,7 @@
 #pragma once
 
 #include "3d/assets/Types.h"
+#include "3d/misc/MeshCluster.h"
 #include "base/RefCounted.h"
 #include "base/RefVector.h"
 #include "base/std/variant.h"
@@ -189,6 +190,17 @@ public:
     inline void setSubMeshIdx(const ccstd::optional<uint32_t> &idx) { _subMeshIdx = idx; }
     inline const ccstd::optional<uint32_t> &getSubMeshIdx() const { return _subMeshIdx; }
 
+    /**
+     * @en The meshlets of the sub mesh and a copy of the indices they refer to, used for per cluster culling.
+     * @zh 子网格的网格簇及其引用的索引数据副本，用于逐簇剔除。
+     */
+    inline void setMeshlets(ccstd::vector<Meshlet> meshlets, ccstd::vector<uint32_t> indices) {
+        _meshlets = std::move(meshlets);
+        _meshletIndices = std::move(indices);
+    }
+    inline const ccstd::vector<Meshlet> &getMeshlets() const { return _meshlets; }
+    inline const ccstd::vector<uint32_t> &getMeshletIndices() const { return _meshletIndices; }
+
 private:
     gfx::Buffer *allocVertexIdBuffer(gfx::Device *device);
 
@@ -209,6 +221,9 @@ private:
 
     ccstd::optional<IGeometricInfo> _geometricInfo;
 
+    ccstd::vector<Meshlet> _meshlets;
+    ccstd::vector<uint32_t> _meshletIndices;
+
     // As gfx::InputAssemblerInfo needs the data structure, so not use IntrusivePtr.
     RefVector<gfx::Buffer *> _vertexBuffers;
 
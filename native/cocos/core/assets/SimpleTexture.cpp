@@ -24,6 +24,7 @@
 
 #include "core/assets/SimpleTexture.h"
 #include "core/assets/ImageAsset.h"
+#include "core/assets/TextureDecoder.h"
 #include "core/platform/Debug.h"
 #include "core/platform/Macro.h"
 #include "renderer/gfx-base/GFXDevice.h"
@@ -83,6 +84,19 @@ void SimpleTexture::uploadData(const uint8_t *source, uint32_t level /* = 0 */,
     region.texSubres.mipLevel = level;
     region.texSubres.baseArrayLayer = arrayIndex;
 
+    // The device can't sample the compressed format, expand the blocks to RGBA8 on the CPU.
+    ccstd::vector<uint8_t> decoded;
+    if (_softwareDecodeFormat != gfx::Format::UNKNOWN) {
+        if (region.texExtent.width == 0 || region.texExtent.height == 0) {
+            return;
+        }
+        decoded.resize(static_cast<size_t>(region.texExtent.width) * region.texExtent.height * 4);
+        if (!TextureDecoder::decode(_softwareDecodeFormat, source, region.texExtent.width, region.texExtent.height, decoded.data())) {
+            return;
+        }
+        source = decoded.data();
+    }
+
     const uint8_t *buffers[1]{source};
     gfxDevice->copyBuffersToTexture(buffers, _gfxTexture, &region, 1);
 }
@@ -140,7 +154,13 @@ void SimpleTexture::createTexture(gfx::Device *device) {
         }
     }
 
-    const auto gfxFormat = getGFXFormat();
+    auto gfxFormat = getGFXFormat();
+    _softwareDecodeFormat = gfx::Format::UNKNOWN;
+    if (isCompressed() && TextureDecoder::isSupported(gfxFormat) &&
+        !hasFlag(device->getFormatFeatures(gfxFormat), gfx::FormatFeatureBit::SAMPLED_TEXTURE)) {
+        _softwareDecodeFormat = gfxFormat;
+        gfxFormat = TextureDecoder::getDecodedFormat(gfxFormat);
+    }
     if (hasFlag(gfx::Device::getInstance()->getFormatFeatures(gfxFormat), gfx::FormatFeatureBit::RENDER_TARGET)) {
         usage |= gfx::TextureUsageBit::COLOR_ATTACHMENT;
     }
@@ -171,7 +191,7 @@ gfx::Texture *SimpleTexture::createTextureView(gfx::Device *device) {
     const uint32_t maxLevel = _maxLevel < _mipmapLevel ? _maxLevel : _mipmapLevel - 1;
     auto textureViewCreateInfo = getGfxTextureViewCreateInfo(
         _gfxTexture,
-        getGFXFormat(),
+        _softwareDecodeFormat != gfx::Format::UNKNOWN ? TextureDecoder::getDecodedFormat(_softwareDecodeFormat) : getGFXFormat(),
         _baseLevel,
         maxLevel - _baseLevel + 1);
 
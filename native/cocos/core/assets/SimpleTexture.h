@@ -165,6 +165,9 @@ protected:
     uint32_t _baseLevel{0};
     uint32_t _maxLevel{1000};
 
+    // Compressed format of the source data when it is decoded on upload, UNKNOWN otherwise.
+    gfx::Format _softwareDecodeFormat{gfx::Format::UNKNOWN};
+
     CC_DISALLOW_COPY_MOVE_ASSIGN(SimpleTexture);
 };
 
@@ -0,0 +1,187 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "core/assets/TextureDecoder.h"
+#include <algorithm>
+#include <cstring>
+#include "base/astc.h"
+#include "base/etc2.h"
+#include "base/job-system/JobSystem.h"
+
+namespace cc {
+
+namespace {
+
+constexpr uint32_t MAX_BLOCK_DIM = 12;
+constexpr uint32_t MIN_BLOCK_ROWS_PER_JOB = 16;
+
+struct BlockLayout {
+    uint32_t width{4};
+    uint32_t height{4};
+    uint32_t bytes{8};
+};
+
+constexpr uint32_t ASTC_BLOCK_DIMS[][2] = {
+    {4, 4}, {5, 4}, {5, 5}, {6, 5}, {6, 6}, {8, 5}, {8, 6}, {8, 8}, {10, 5}, {10, 6}, {10, 8}, {10, 10}, {12, 10}, {12, 12}};
+constexpr uint32_t ASTC_FORMAT_COUNT = sizeof(ASTC_BLOCK_DIMS) / sizeof(ASTC_BLOCK_DIMS[0]);
+
+bool isASTC(gfx::Format format) {
+    return format >= gfx::Format::ASTC_RGBA_4X4 && format <= gfx::Format::ASTC_SRGBA_12X12;
+}
+
+BlockLayout getBlockLayout(gfx::Format format) {
+    BlockLayout layout;
+    if (isASTC(format)) {
+        const auto index = (toNumber(format) - toNumber(gfx::Format::ASTC_RGBA_4X4)) % ASTC_FORMAT_COUNT;
+        layout.width = ASTC_BLOCK_DIMS[index][0];
+        layout.height = ASTC_BLOCK_DIMS[index][1];
+        layout.bytes = ASTC_BLOCK_SIZE;
+    } else if (format == gfx::Format::ETC2_RGBA8 || format == gfx::Format::ETC2_SRGB8_A8 || format == gfx::Format::EAC_RG11) {
+        layout.bytes = ETC2_ENCODED_BLOCK_SIZE * 2;
+    } else {
+        layout.bytes = ETC2_ENCODED_BLOCK_SIZE;
+    }
+    return layout;
+}
+
+// Decodes one full block to pOut, which always has room for the whole block.
+void decodeBlock(gfx::Format format, const BlockLayout &layout, const uint8_t *pBlock, uint8_t *pOut, uint32_t outStride) {
+    switch (format) {
+        case gfx::Format::ETC_RGB8:
+        case gfx::Format::ETC2_RGB8:
+        case gfx::Format::ETC2_SRGB8:
+            etc2_decode_rgb_block(pBlock, pOut, outStride, false);
+            break;
+        case gfx::Format::ETC2_RGB8_A1:
+        case gfx::Format::ETC2_SRGB8_A1:
+            etc2_decode_rgb_block(pBlock, pOut, outStride, true);
+            break;
+        case gfx::Format::ETC2_RGBA8:
+        case gfx::Format::ETC2_SRGB8_A8:
+            etc2_decode_rgb_block(pBlock + ETC2_ENCODED_BLOCK_SIZE, pOut, outStride, false);
+            etc2_decode_eac_block(pBlock, pOut, outStride, 3);
+            break;
+        case gfx::Format::EAC_R11:
+        case gfx::Format::EAC_RG11:
+            for (uint32_t y = 0; y < 4; ++y) {
+                for (uint32_t x = 0; x < 4; ++x) {
+                    static constexpr uint8_t OPAQUE_BLACK[4] = {0, 0, 0, 255};
+                    memcpy(pOut + y * outStride + x * 4, OPAQUE_BLACK, 4);
+                }
+            }
+            etc2_decode_eac_block(pBlock, pOut, outStride, 0);
+            if (format == gfx::Format::EAC_RG11) {
+                etc2_decode_eac_block(pBlock + ETC2_ENCODED_BLOCK_SIZE, pOut, outStride, 1);
+            }
+            break;
+        default:
+            astcDecodeBlock(pBlock, layout.width, layout.height, pOut, outStride);
+            break;
+    }
+}
+
+void decodeBlockRows(gfx::Format format, const BlockLayout &layout, const uint8_t *src, uint32_t width, uint32_t height,
+                     uint32_t firstRow, uint32_t lastRow, uint8_t *dst) {
+    const uint32_t blocksX = (width + layout.width - 1) / layout.width;
+    const uint32_t dstStride = width * 4;
+    uint8_t edge[MAX_BLOCK_DIM * MAX_BLOCK_DIM * 4];
+
+    for (uint32_t by = firstRow; by < lastRow; ++by) {
+        const uint8_t *pBlock = src + static_cast<size_t>(by) * blocksX * layout.bytes;
+        const uint32_t y = by * layout.height;
+        const uint32_t rows = std::min(layout.height, height - y);
+        for (uint32_t bx = 0; bx < blocksX; ++bx, pBlock += layout.bytes) {
+            const uint32_t x = bx * layout.width;
+            const uint32_t columns = std::min(layout.width, width - x);
+            uint8_t *pOut = dst + static_cast<size_t>(y) * dstStride + x * 4;
+            if (rows == layout.height && columns == layout.width) {
+                decodeBlock(format, layout, pBlock, pOut, dstStride);
+                continue;
+            }
+            // blocks on the right and bottom edges are cropped
+            decodeBlock(format, layout, pBlock, edge, layout.width * 4);
+            for (uint32_t row = 0; row < rows; ++row) {
+                memcpy(pOut + row * dstStride, edge + row * layout.width * 4, columns * 4);
+            }
+        }
+    }
+}
+
+} // namespace
+
+bool TextureDecoder::isSupported(gfx::Format format) {
+    switch (format) {
+        case gfx::Format::ETC_RGB8:
+        case gfx::Format::ETC2_RGB8:
+        case gfx::Format::ETC2_SRGB8:
+        case gfx::Format::ETC2_RGB8_A1:
+        case gfx::Format::ETC2_SRGB8_A1:
+        case gfx::Format::ETC2_RGBA8:
+        case gfx::Format::ETC2_SRGB8_A8:
+        case gfx::Format::EAC_R11:
+        case gfx::Format::EAC_RG11:
+            return true;
+        default:
+            return isASTC(format);
+    }
+}
+
+gfx::Format TextureDecoder::getDecodedFormat(gfx::Format format) {
+    switch (format) {
+        case gfx::Format::ETC2_SRGB8:
+        case gfx::Format::ETC2_SRGB8_A1:
+        case gfx::Format::ETC2_SRGB8_A8:
+            return gfx::Format::SRGB8_A8;
+        default:
+            return format >= gfx::Format::ASTC_SRGBA_4X4 && format <= gfx::Format::ASTC_SRGBA_12X12 ? gfx::Format::SRGB8_A8 : gfx::Format::RGBA8;
+    }
+}
+
+bool TextureDecoder::decode(gfx::Format format, const uint8_t *src, uint32_t width, uint32_t height, uint8_t *dst) {
+    if (!isSupported(format) || !src || !dst || !width || !height) {
+        return false;
+    }
+
+    const BlockLayout layout = getBlockLayout(format);
+    const uint32_t blockRows = (height + layout.height - 1) / layout.height;
+
+    const uint32_t chunkCount = std::min(JobSystem::getInstance()->threadCount(), blockRows / MIN_BLOCK_ROWS_PER_JOB);
+    if (chunkCount <= 1U) {
+        decodeBlockRows(format, layout, src, width, height, 0U, blockRows, dst);
+        return true;
+    }
+
+    const uint32_t rowsPerChunk = (blockRows - 1U) / chunkCount + 1U;
+    JobGraph g(JobSystem::getInstance());
+    g.createForEachIndexJob(0U, chunkCount, 1U, [&](uint32_t chunk) {
+        const uint32_t first = chunk * rowsPerChunk;
+        const uint32_t last = std::min(blockRows, first + rowsPerChunk);
+        decodeBlockRows(format, layout, src, width, height, first, last, dst);
+    });
+    g.run();
+    g.waitForAll();
+    return true;
+}
+
+} // namespace cc
@@ -0,0 +1,54 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include "base/Macros.h"
+#include "renderer/gfx-base/GFXDef-common.h"
+
+namespace cc {
+
+/**
+ * @en CPU decoder of block compressed textures, for devices that can't sample them natively.
+ * ETC1, ETC2 (RGB, RGB_A1, RGBA, R11, RG11) and ASTC LDR blocks are decoded to RGBA8.
+ * @zh 在设备不支持采样时，用 CPU 将 ETC1、ETC2 和 ASTC LDR 压缩纹理解码为 RGBA8。
+ */
+class CC_DLL TextureDecoder final {
+public:
+    static bool isSupported(gfx::Format format);
+
+    /**
+     * @en RGBA8 or SRGB8_A8, matching the color space of the compressed format.
+     */
+    static gfx::Format getDecodedFormat(gfx::Format format);
+
+    /**
+     * @en Decodes one image of width x height texels, dst receives width * height * 4 bytes.
+     * Large images are split across the job system.
+     */
+    static bool decode(gfx::Format format, const uint8_t *src, uint32_t width, uint32_t height, uint8_t *dst);
+};
+
+} // namespace cc
@@ -0,0 +1,193 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "core/memop/SlabAllocator.h"
+#include <algorithm>
+#include <mutex>
+
+namespace cc {
+
+namespace memop {
+
+namespace {
+
+struct Registry {
+    std::mutex mutex;
+    ccstd::vector<SlabAllocator *> allocators;
+};
+
+Registry &getRegistry() {
+    // leaked on purpose, allocators are leaked as well
+    static auto *registry = ccnew Registry;
+    return *registry;
+}
+
+} // namespace
+
+SlabAllocator::SlabAllocator(const char *name, size_t slotSize, size_t alignment, uint32_t slotsPerSlab)
+: _name(name),
+  _alignment(std::max(alignment, sizeof(void *))),
+  _slotsPerSlab(std::max(slotsPerSlab, 1U)) {
+    const size_t size = std::max(slotSize, sizeof(FreeSlot));
+    _slotSize = (size + _alignment - 1) / _alignment * _alignment;
+
+    auto &registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.allocators.push_back(this);
+}
+
+SlabAllocator::~SlabAllocator() {
+    {
+        auto &registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        auto &allocators = registry.allocators;
+        allocators.erase(std::remove(allocators.begin(), allocators.end(), this), allocators.end());
+    }
+    // live objects keep pointing into the slabs, leak them rather than leaving dangling objects
+    if (_liveObjects > 0) {
+        return;
+    }
+    for (auto *slab : _slabs) {
+        CC_FREE_ALIGN(slab);
+    }
+}
+
+void SlabAllocator::addSlab() {
+    auto *slab = static_cast<uint8_t *>(CC_MALLOC_ALIGN(_slotSize * _slotsPerSlab, _alignment));
+    if (!slab) {
+        return;
+    }
+    _slabs.push_back(slab);
+    // the previous bump range is either exhausted or threaded into the free list by now
+    _bumpCursor = slab;
+    _bumpEnd = slab + _slotSize * _slotsPerSlab;
+}
+
+void *SlabAllocator::allocate(size_t size) {
+    if (size > _slotSize) {
+            ++_allocations;
+        ++_overflowAllocations;
+        return CC_MALLOC_ALIGN(size, _alignment);
+    }
+
+    void *ptr = nullptr;
+    if (_freeList) {
+        ptr = _freeList;
+        _freeList = _freeList->next;
+    } else {
+        if (_bumpCursor == _bumpEnd) {
+            addSlab();
+            if (_bumpCursor == _bumpEnd) {
+                return nullptr;
+            }
+        }
+        ptr = _bumpCursor;
+        _bumpCursor += _slotSize;
+    }
+    ++_allocations;
+    ++_liveObjects;
+    _peakLiveObjects = std::max(_peakLiveObjects, _liveObjects);
+    return ptr;
+}
+
+void SlabAllocator::deallocate(void *ptr, size_t size) {
+    if (!ptr) {
+        return;
+    }
+    if (size > _slotSize) {
+        CC_FREE_ALIGN(ptr);
+        return;
+    }
+
+    CC_ASSERT(_liveObjects > 0);
+    auto *slot = static_cast<FreeSlot *>(ptr);
+    slot->next = _freeList;
+    _freeList = slot;
+    --_liveObjects;
+}
+
+void SlabAllocator::deallocate(void *ptr) {
+    if (owns(ptr)) {
+        deallocate(ptr, _slotSize);
+    } else {
+        CC_FREE_ALIGN(ptr);
+    }
+}
+
+void SlabAllocator::reserve(uint32_t count) {
+    const auto capacity = static_cast<uint32_t>(_slabs.size()) * _slotsPerSlab;
+    if (capacity >= count) {
+        return;
+    }
+    const uint32_t slabCount = (count - capacity + _slotsPerSlab - 1) / _slotsPerSlab;
+    for (uint32_t i = 0; i < slabCount; ++i) {
+        releaseBumpRange();
+        addSlab();
+    }
+}
+
+void SlabAllocator::releaseBumpRange() {
+    for (; _bumpCursor != _bumpEnd; _bumpCursor += _slotSize) {
+        auto *slot = reinterpret_cast<FreeSlot *>(_bumpCursor);
+        slot->next = _freeList;
+        _freeList = slot;
+    }
+}
+
+bool SlabAllocator::owns(const void *ptr) const {
+    const auto *bytes = static_cast<const uint8_t *>(ptr);
+    const size_t slabSize = _slotSize * _slotsPerSlab;
+    return std::any_of(_slabs.begin(), _slabs.end(), [&](const uint8_t *slab) {
+        return bytes >= slab && bytes < slab + slabSize;
+    });
+}
+
+SlabAllocatorStats SlabAllocator::getStats() const {
+    SlabAllocatorStats stats;
+    stats.name = _name;
+    stats.slotSize = static_cast<uint32_t>(_slotSize);
+    stats.slotsPerSlab = _slotsPerSlab;
+    stats.slabCount = static_cast<uint32_t>(_slabs.size());
+    stats.capacity = stats.slabCount * _slotsPerSlab;
+    stats.liveObjects = _liveObjects;
+    stats.peakLiveObjects = _peakLiveObjects;
+    stats.allocations = _allocations;
+    stats.overflowAllocations = _overflowAllocations;
+    return stats;
+}
+
+ccstd::vector<SlabAllocatorStats> SlabAllocator::getAllStats() {
+    auto &registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    ccstd::vector<SlabAllocatorStats> stats;
+    stats.reserve(registry.allocators.size());
+    for (const auto *allocator : registry.allocators) {
+        stats.push_back(allocator->getStats());
+    }
+    return stats;
+}
+
+} // namespace memop
+
+} // namespace cc
@@ -0,0 +1,171 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include "base/Macros.h"
+#include "base/memory/Memory.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+
+namespace memop {
+
+struct SlabAllocatorStats {
+    const char *name{nullptr};
+    uint32_t slotSize{0};
+    uint32_t slotsPerSlab{0};
+    uint32_t slabCount{0};
+    uint32_t capacity{0};
+    uint32_t liveObjects{0};
+    uint32_t peakLiveObjects{0};
+    uint64_t allocations{0};
+    // allocations larger than a slot (derived types), forwarded to the heap
+    uint64_t overflowAllocations{0};
+
+    /**
+     * @en The ratio of slots holding a live object.
+     * @zh 已被占用的槽位比例。
+     */
+    inline float getOccupancy() const {
+        return capacity > 0 ? static_cast<float>(liveObjects) / static_cast<float>(capacity) : 0.F;
+    }
+
+    /**
+     * @en The ratio of slabs that would be released if the live objects were packed together.
+     * @zh 若存活对象紧密排列，可以被释放的 slab 比例。
+     */
+    inline float getFragmentation() const {
+        if (slabCount == 0) {
+            return 0.F;
+        }
+        const uint32_t packedSlabs = (liveObjects + slotsPerSlab - 1) / slotsPerSlab;
+        return 1.F - static_cast<float>(packedSlabs) / static_cast<float>(slabCount);
+    }
+};
+
+/**
+ * @en Fixed size object allocator. Objects are carved out of large slabs which are never moved or released
+ * while the allocator is alive, so addresses are stable and freed slots are recycled through an intrusive free list.
+ * Requests larger than a slot fall back to the heap, which lets derived types share the allocator of their base.
+ * Types opt in with CC_SLAB_ALLOCATED and CC_SLAB_ALLOCATOR_IMPL.
+ * Like the non-atomic reference count of RefCounted, it is not thread safe: objects must be created and released on one thread.
+ * @zh 定长对象分配器。对象从大块内存 (slab) 中切分，slab 在分配器存活期间不会移动或释放，因此对象地址稳定，
+ * 释放的槽位通过侵入式空闲链表复用。超过槽位大小的请求回退到堆上分配，派生类可以共用基类的分配器。
+ * 与 RefCounted 的引用计数一样，它不是线程安全的。
+ */
+class CC_DLL SlabAllocator final {
+public:
+    SlabAllocator(const char *name, size_t slotSize, size_t alignment, uint32_t slotsPerSlab);
+    ~SlabAllocator();
+
+    SlabAllocator(const SlabAllocator &) = delete;
+    SlabAllocator(SlabAllocator &&) = delete;
+    SlabAllocator &operator=(const SlabAllocator &) = delete;
+    SlabAllocator &operator=(SlabAllocator &&) = delete;
+
+    void *allocate(size_t size);
+    // size must be the one passed to allocate, which is what sized operator delete provides
+    void deallocate(void *ptr, size_t size);
+    // slower path for callers that don't know the size, looks up the owning slab
+    void deallocate(void *ptr);
+
+    /**
+     * @en Pre-warm the allocator so that at least `count` objects can live without allocating a new slab.
+     * @zh 预热分配器，保证至少能容纳 `count` 个对象而无需分配新的 slab。
+     */
+    void reserve(uint32_t count);
+
+    bool owns(const void *ptr) const;
+
+    inline const char *getName() const { return _name; }
+    inline size_t getSlotSize() const { return _slotSize; }
+    SlabAllocatorStats getStats() const;
+
+    static ccstd::vector<SlabAllocatorStats> getAllStats();
+
+private:
+    struct FreeSlot {
+        FreeSlot *next{nullptr};
+    };
+
+    void addSlab();
+    void releaseBumpRange();
+
+    const char *_name{nullptr};
+    size_t _slotSize{0};
+    size_t _alignment{0};
+    uint32_t _slotsPerSlab{0};
+
+    ccstd::vector<uint8_t *> _slabs;
+    FreeSlot *_freeList{nullptr};
+    // untouched tail of the newest slab, slots are only threaded into the free list once released
+    uint8_t *_bumpCursor{nullptr};
+    uint8_t *_bumpEnd{nullptr};
+
+    uint32_t _liveObjects{0};
+    uint32_t _peakLiveObjects{0};
+    uint64_t _allocations{0};
+    uint64_t _overflowAllocations{0};
+};
+
+} // namespace memop
+
+} // namespace cc
+
+/**
+ * Routes `new`/`delete` of a class through its slab allocator, placed at the top of the class body.
+ * The allocator itself is defined in the translation unit with CC_SLAB_ALLOCATOR_IMPL.
+ */
+#define CC_SLAB_ALLOCATED                                                                      \
+public:                                                                                        \
+    static ::cc::memop::SlabAllocator &getSlabAllocator();                                     \
+    static void *operator new(size_t size) {                                                   \
+        return getSlabAllocator().allocate(size);                                              \
+    }                                                                                          \
+    static void *operator new(size_t size, const std::nothrow_t & /*tag*/) noexcept {          \
+        return getSlabAllocator().allocate(size);                                              \
+    }                                                                                          \
+    static void *operator new(size_t /*size*/, void *ptr) noexcept {                           \
+        return ptr;                                                                            \
+    }                                                                                          \
+    static void operator delete(void *ptr, size_t size) noexcept {                             \
+        getSlabAllocator().deallocate(ptr, size);                                              \
+    }                                                                                          \
+    static void operator delete(void *ptr, const std::nothrow_t & /*tag*/) noexcept {          \
+        getSlabAllocator().deallocate(ptr);                                                    \
+    }                                                                                          \
+    static void operator delete(void * /*ptr*/, void * /*place*/) noexcept {}                  \
+                                                                                               \
+private:
+
+// The allocator is intentionally never destroyed, objects may still be released during static destruction.
+#define CC_SLAB_ALLOCATOR_IMPL(ClassName, slotsPerSlab)                                                                         \
+    ::cc::memop::SlabAllocator &ClassName::getSlabAllocator() {                                                                 \
+        static auto *allocator = ccnew ::cc::memop::SlabAllocator(#ClassName, sizeof(ClassName), alignof(ClassName), slotsPerSlab); \
+        return *allocator;                                                                                                      \
+    }
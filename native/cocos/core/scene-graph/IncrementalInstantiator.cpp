@@ -0,0 +1,249 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "core/scene-graph/IncrementalInstantiator.h"
+#include <chrono>
+#include "base/Log.h"
+#include "base/Scheduler.h"
+#include "core/scene-graph/Node.h"
+#include "scene/Model.h"
+#include "scene/RenderScene.h"
+
+namespace cc {
+
+namespace {
+const ccstd::string SCHEDULE_KEY{"IncrementalInstantiator"};
+// reading the clock for every node would cost more than cloning small nodes
+constexpr uint32_t BUDGET_CHECK_INTERVAL{8};
+} // namespace
+
+IncrementalInstantiator::IncrementalInstantiator(Node *source, Node *parent, scene::RenderScene *renderScene, bool childrenOnly)
+: _source(source),
+  _parent(parent),
+  _renderScene(renderScene),
+  _childrenOnly(childrenOnly) {
+    CC_ASSERT(source);
+    CC_ASSERT(!childrenOnly || parent);
+}
+
+IncrementalInstantiator::~IncrementalInstantiator() = default;
+
+void IncrementalInstantiator::countNodes() {
+    uint32_t count = 0;
+    _source->walk([&count](Node * /*node*/) { ++count; });
+    _progress.totalNodes = _childrenOnly ? count - 1 : count;
+    _nodePool.reserve(_progress.totalNodes);
+}
+
+bool IncrementalInstantiator::allocateNodes(const std::function<bool()> &outOfBudget) {
+    while (_progress.allocatedNodes < _progress.totalNodes) {
+        if (outOfBudget()) {
+            return false;
+        }
+        _nodePool.emplace_back(ccnew Node());
+        ++_progress.allocatedNodes;
+    }
+    return true;
+}
+
+Node *IncrementalInstantiator::cloneNode(const Node *source, Node *parent) {
+    Node *clone = nullptr;
+    if (!_nodePool.empty()) {
+        clone = _nodePool.back();
+        // the tree holds the node from now on, the pooled reference is dropped after attaching it
+        clone->addRef();
+        _nodePool.pop_back();
+    } else {
+        clone = ccnew Node();
+        clone->addRef();
+    }
+
+    clone->setName(source->getName());
+    clone->setLayer(source->getLayer());
+    clone->setMobility(source->getMobility());
+    clone->setStatic(source->isStatic());
+    clone->setPosition(source->getPosition());
+    clone->setRotation(source->getRotation());
+    clone->setScale(source->getScale());
+    // before attaching it, so that no activation happens for an inactive node
+    clone->setActive(source->isActive());
+    clone->setParent(parent);
+    if (parent == _parent) {
+        _instances.emplace_back(clone);
+    }
+    clone->release();
+
+    ++_progress.builtNodes;
+    ++_progress.lastChunkNodes;
+    return clone;
+}
+
+void IncrementalInstantiator::completeSubtree(const BuildFrame &frame) {
+    // the models of the subtree which are not registered yet, the node's own and those of incomplete descendants
+    const auto end = static_cast<uint32_t>(_pendingModels.size());
+    for (uint32_t i = frame.modelBegin; i < end; ++i) {
+        auto &model = _pendingModels[i];
+        if (_renderScene) {
+            _renderScene->addModel(model);
+        }
+        _registeredModels.emplace_back(std::move(model));
+        ++_progress.registeredModels;
+    }
+    _pendingModels.resize(frame.modelBegin);
+}
+
+bool IncrementalInstantiator::buildNodes(const std::function<bool()> &outOfBudget) {
+    auto pushNode = [this](Node *source, Node *clone) {
+        const auto modelBegin = static_cast<uint32_t>(_pendingModels.size());
+        if (_nodeCallback && clone) {
+            _nodeModels.clear();
+            _nodeCallback(source, clone, _nodeModels);
+            for (auto &model : _nodeModels) {
+                _pendingModels.emplace_back(std::move(model));
+            }
+        }
+        _stack.push_back({source, clone, 0, modelBegin});
+    };
+
+    if (!_started) {
+        _started = true;
+        if (_childrenOnly) {
+            pushNode(_source, nullptr);
+            _stack.back().clone = _parent;
+        } else {
+            _root = cloneNode(_source, _parent);
+            pushNode(_source, _root);
+        }
+    }
+
+    while (!_stack.empty()) {
+        if (outOfBudget()) {
+            return false;
+        }
+        auto &frame = _stack.back();
+        const auto &children = frame.source->getChildren();
+        if (frame.childIndex < children.size()) {
+            Node *childSource = children[frame.childIndex++];
+            // frame is invalidated by the push
+            Node *clone = cloneNode(childSource, frame.clone);
+            pushNode(childSource, clone);
+        } else {
+            const BuildFrame completed = frame;
+            _stack.pop_back();
+            completeSubtree(completed);
+        }
+    }
+    return true;
+}
+
+bool IncrementalInstantiator::step() {
+    if (_progress.done) {
+        return true;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto budget = std::chrono::duration<float, std::milli>(_budgetMs);
+    uint32_t calls = 0;
+    auto outOfBudget = [&]() {
+        // always make some progress, even with a zero budget
+        if (++calls % BUDGET_CHECK_INTERVAL != 0) {
+            return false;
+        }
+        return _budgetMs > 0.F && std::chrono::steady_clock::now() - start >= budget;
+    };
+
+    _progress.lastChunkNodes = 0;
+    if (!_started && _progress.allocatedNodes == 0) {
+        countNodes();
+    }
+    if (allocateNodes(outOfBudget) && buildNodes(outOfBudget)) {
+        _progress.done = true;
+        _nodePool.clear();
+    }
+
+    const float chunkMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    ++_progress.chunks;
+    _progress.lastChunkMs = chunkMs;
+    _progress.maxChunkMs = std::max(_progress.maxChunkMs, chunkMs);
+    _progress.totalMs += chunkMs;
+
+    emit<Progress>(_progress);
+    if (_progress.done) {
+        emit<Completed>(_root.get());
+    }
+    return _progress.done;
+}
+
+void IncrementalInstantiator::finish() {
+    const float budget = _budgetMs;
+    _budgetMs = 0.F;
+    step();
+    _budgetMs = budget;
+    stop();
+}
+
+void IncrementalInstantiator::start(Scheduler *scheduler) {
+    if (_scheduler || _progress.done) {
+        return;
+    }
+    _scheduler = scheduler;
+    // keep alive while scheduled
+    addRef();
+    scheduler->schedule(
+        [this](float /*dt*/) {
+            if (step()) {
+                stop();
+            }
+        },
+        this, 0.F, false, SCHEDULE_KEY);
+}
+
+void IncrementalInstantiator::stop() {
+    if (!_scheduler) {
+        return;
+    }
+    _scheduler->unschedule(SCHEDULE_KEY, this);
+    _scheduler = nullptr;
+    release();
+}
+
+void IncrementalInstantiator::cancel() {
+    if (_renderScene) {
+        for (const auto &model : _registeredModels) {
+            _renderScene->removeModel(model);
+        }
+    }
+    _registeredModels.clear();
+    _pendingModels.clear();
+    for (const auto &instance : _instances) {
+        instance->setParent(nullptr);
+    }
+    _instances.clear();
+    _stack.clear();
+    _nodePool.clear();
+    _progress.done = true;
+    stop();
+}
+
+} // namespace cc
@@ -0,0 +1,165 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include "base/Ptr.h"
+#include "base/RefCounted.h"
+#include "base/std/container/vector.h"
+#include "core/event/Event.h"
+
+namespace cc {
+
+class Node;
+class Scheduler;
+
+namespace scene {
+class Model;
+class RenderScene;
+} // namespace scene
+
+struct InstantiateProgress {
+    uint32_t totalNodes{0};
+    uint32_t allocatedNodes{0};
+    uint32_t builtNodes{0};
+    uint32_t registeredModels{0};
+    uint32_t chunks{0};
+    // nodes built and the time spent by the last chunk
+    uint32_t lastChunkNodes{0};
+    float lastChunkMs{0.F};
+    float maxChunkMs{0.F};
+    float totalMs{0.F};
+    bool done{false};
+
+    inline float getRatio() const { return totalNodes > 0 ? static_cast<float>(builtNodes) / static_cast<float>(totalNodes) : 1.F; }
+};
+
+/**
+ * @en Instantiates a node tree in chunks, each chunk stays within a time budget so that big prefabs and scenes don't hitch.
+ * The nodes are allocated up front into a pool, then the tree is built depth first. The models created for a node by the
+ * node callback are added to the RenderScene only when the subtree of the node is complete.
+ * @zh 分块实例化节点树，每块不超过时间预算，避免大型预制体或场景造成卡顿。先将节点预分配到池中，再深度优先构建节点树。
+ * 节点回调为节点创建的模型仅在该节点的子树构建完成后才加入 RenderScene。
+ */
+class CC_DLL IncrementalInstantiator final : public RefCounted {
+    IMPL_EVENT_TARGET(IncrementalInstantiator)
+    DECLARE_TARGET_EVENT_BEGIN(IncrementalInstantiator)
+    TARGET_EVENT_ARG1(Progress, const InstantiateProgress &)
+    TARGET_EVENT_ARG1(Completed, Node *)
+    DECLARE_TARGET_EVENT_END()
+public:
+    static constexpr float DEFAULT_BUDGET_MS{2.F};
+
+    using ModelList = ccstd::vector<IntrusivePtr<scene::Model>>;
+    /**
+     * @en Called for every cloned node to clone what the node carries, components and models.
+     * The models appended to the list are added to the RenderScene once the subtree of the clone is complete.
+     * @zh 每个节点克隆后调用，用于克隆节点上的组件与模型。加入列表的模型在克隆节点的子树完成后加入 RenderScene。
+     */
+    using NodeCallback = std::function<void(const Node *source, Node *clone, ModelList &models)>;
+
+    /**
+     * @param source The node tree to instantiate, a prefab root or the scene of a SceneAsset.
+     * @param parent The parent of the instance, the instance is attached to it as soon as it is created.
+     * @param renderScene The scene in which the models are registered.
+     * @param childrenOnly Instantiates the children of source under parent, the source node itself is not cloned.
+     */
+    IncrementalInstantiator(Node *source, Node *parent, scene::RenderScene *renderScene, bool childrenOnly = false);
+    ~IncrementalInstantiator() override;
+
+    inline void setBudget(float milliseconds) { _budgetMs = milliseconds; }
+    inline float getBudget() const { return _budgetMs; }
+    inline void setNodeCallback(const NodeCallback &callback) { _nodeCallback = callback; }
+
+    /**
+     * @en Runs one chunk within the budget.
+     * @zh 在预算内执行一块。
+     * @return Whether the instantiation is complete.
+     */
+    bool step();
+    /**
+     * @en Runs the remaining work at once.
+     * @zh 一次性完成剩余工作。
+     */
+    void finish();
+    /**
+     * @en Runs one chunk per frame on the scheduler until the instantiation is complete.
+     * @zh 在调度器上每帧执行一块，直到实例化完成。
+     */
+    void start(Scheduler *scheduler);
+    /**
+     * @en Stops the instantiation, the nodes built so far are detached and their models are removed from the RenderScene.
+     * @zh 停止实例化，已构建的节点被移出父节点，其模型从 RenderScene 中移除。
+     */
+    void cancel();
+
+    /**
+     * @en The clone of the source node, nullptr with childrenOnly or before the first node is built.
+     * @zh 源节点的克隆，childrenOnly 时或首个节点构建前为 nullptr。
+     */
+    inline Node *getRoot() const { return _root.get(); }
+    inline const InstantiateProgress &getProgress() const { return _progress; }
+    inline bool isDone() const { return _progress.done; }
+
+private:
+    struct BuildFrame {
+        Node *source{nullptr};
+        Node *clone{nullptr};
+        uint32_t childIndex{0};
+        // first model of the subtree in _pendingModels
+        uint32_t modelBegin{0};
+    };
+
+    void countNodes();
+    bool allocateNodes(const std::function<bool()> &outOfBudget);
+    bool buildNodes(const std::function<bool()> &outOfBudget);
+    Node *cloneNode(const Node *source, Node *parent);
+    void completeSubtree(const BuildFrame &frame);
+    void stop();
+
+    IntrusivePtr<Node> _source;
+    IntrusivePtr<Node> _parent;
+    IntrusivePtr<scene::RenderScene> _renderScene;
+    IntrusivePtr<Node> _root;
+    NodeCallback _nodeCallback;
+    Scheduler *_scheduler{nullptr};
+
+    ccstd::vector<IntrusivePtr<Node>> _nodePool;
+    ccstd::vector<BuildFrame> _stack;
+    ModelList _pendingModels;
+    ModelList _registeredModels;
+    ModelList _nodeModels;
+    // clones attached to the parent, to detach them on cancel
+    ccstd::vector<IntrusivePtr<Node>> _instances;
+
+    InstantiateProgress _progress;
+    float _budgetMs{DEFAULT_BUDGET_MS};
+    bool _childrenOnly{false};
+    bool _started{false};
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(IncrementalInstantiator);
+};
+
+} // namespace cc
@@ -41,6 +41,8 @@ uint32_t Node::clearRound{1000};
 const uint32_t Node::TRANSFORM_ON{1 << 0};
 uint32_t Node::globalFlagChangeVersion{0};
 
+CC_SLAB_ALLOCATOR_IMPL(Node, 256)
+
 namespace {
 const ccstd::string EMPTY_NODE_NAME;
 IDGenerator idGenerator("Node");
@@ -535,6 +537,7 @@ void Node::invalidateChildren(TransformBit dirtyBit) { // NOLINT(misc-no-recursi
     if (isValid() && (transformFlags & hasChangedFlags & curDirtyBit) != curDirtyBit) {
         _transformFlags = (transformFlags | curDirtyBit);
         setChangedFlags(hasChangedFlags | curDirtyBit);
+        emit<TransformInvalidated>();
 
         for (Node *child : getChildren()) {
             child->invalidateChildren(dirtyBit | TransformBit::POSITION);
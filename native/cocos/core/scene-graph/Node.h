@@ -31,6 +31,7 @@
 // #include "core/event/Event.h"
 #include "core/data/Object.h"
 #include "core/event/EventTarget.h"
+#include "core/memop/SlabAllocator.h"
 #include "core/scene-graph/Layers.h"
 #include "core/scene-graph/NodeEnum.h"
 #include "math/Mat3.h"
@@ -51,6 +52,8 @@ class Scene;
 using TransformDirtyBit = TransformBit;
 
 class Node : public CCObject {
+    CC_SLAB_ALLOCATED
+
     IMPL_EVENT_TARGET_WITH_PARENT(Node, getParent)
     DECLARE_TARGET_EVENT_BEGIN(Node)
     TARGET_EVENT_ARG0(TouchStart)
@@ -91,6 +94,8 @@ class Node : public CCObject {
     TARGET_EVENT_ARG10(LocalRTSUpdated, float, float, float, float, float, float, float, float, float, float)
     TARGET_EVENT_ARG1(EditorAttached, bool)
     TARGET_EVENT_ARG0(LightProbeBakingChanged)
+    // emitted natively whenever the node or one of its ancestors gets a dirty transform, not forwarded to JS
+    TARGET_EVENT_ARG0(TransformInvalidated)
     DECLARE_TARGET_EVENT_END()
 public:
     class UserData : public RefCounted {
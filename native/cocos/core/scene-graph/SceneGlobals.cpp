@@ -51,6 +51,10 @@ SceneGlobals::SceneGlobals() {
 }
 
 void SceneGlobals::activate(Scene *scene) {
+#if defined(CC_DEDICATED_SERVER)
+    // there is no pipeline scene data to activate without a pipeline
+    CC_UNUSED_PARAM(scene);
+#else
     auto *sceneData = Root::getInstance()->getPipeline()->getPipelineSceneData();
     if (_ambientInfo != nullptr) {
         _ambientInfo->activate(sceneData->getAmbient());
@@ -85,6 +89,7 @@ void SceneGlobals::activate(Scene *scene) {
     }
 
     Root::getInstance()->onGlobalPipelineStateChanged();
+#endif
 }
 
 void SceneGlobals::setAmbientInfo(scene::AmbientInfo *info) {
@@ -32,6 +32,7 @@
 #include "bindings/jswrapper/SeApi.h"
 #include "core/builtin/BuiltinResMgr.h"
 #include "engine/EngineEvents.h"
+#include "engine/ServerWorld.h"
 #include "platform/BasePlatform.h"
 #include "platform/FileUtils.h"
 #include "renderer/GFXDeviceManager.h"
@@ -131,9 +132,13 @@ int32_t Engine::init() {
     _scheduler = std::make_shared<Scheduler>();
     _fs = createFileUtils();
     // May create gfx device in render subsystem in future.
+    // A dedicated server only gets the empty device, see DeviceManager::create.
     _gfxDevice = gfx::DeviceManager::create();
     _programLib = ccnew ProgramLib();
     _builtinResMgr = ccnew BuiltinResMgr;
+#if defined(CC_DEDICATED_SERVER)
+    _serverWorlds = ccnew ServerWorldManager();
+#endif
 
 #if CC_USE_DEBUG_RENDERER
     _debugRenderer = ccnew DebugRenderer();
@@ -201,6 +206,10 @@ void Engine::destroy() {
 
     CCObject::deferredDestroy();
 
+#if defined(CC_DEDICATED_SERVER)
+    delete _serverWorlds;
+    _serverWorlds = nullptr;
+#endif
     delete _builtinResMgr;
     delete _programLib;
 
@@ -304,6 +313,10 @@ void Engine::tick() {
         se::ScriptEngine::getInstance()->handlePromiseExceptions();
         events::Tick::broadcast(dt);
         se::ScriptEngine::getInstance()->mainLoopUpdate();
+#if defined(CC_DEDICATED_SERVER)
+        // the worlds measure the real elapsed time for their fixed steps, not the smoothed dt
+        _serverWorlds->tick();
+#endif
 
         cc::DeferredReleasePool::clear();
         if (_xr) _xr->endRenderFrame();
@@ -49,6 +49,7 @@ class Profiler;
 class BuiltinResMgr;
 class ProgramLib;
 class IXRInterface;
+class ServerWorldManager;
 
 #define NANOSECONDS_PER_SECOND 1000000000
 #define NANOSECONDS_60FPS      16666667L
@@ -130,6 +131,11 @@ private:
     BuiltinResMgr *_builtinResMgr{nullptr};
     ProgramLib *_programLib{nullptr};
 
+#if defined(CC_DEDICATED_SERVER)
+    // Fixed step simulation worlds, a dedicated server has no pipeline and only the empty device.
+    ServerWorldManager *_serverWorlds{nullptr};
+#endif
+
     events::WindowEvent::Listener _windowEventListener;
 
     CC_DISALLOW_COPY_MOVE_ASSIGN(Engine);
@@ -348,6 +348,8 @@ DECLARE_BUS_EVENT_ARG0(AfterTick, Engine)
 DECLARE_BUS_EVENT_ARG3(Resize, Engine, int, int, uint32_t /* windowId*/)
 DECLARE_BUS_EVENT_ARG1(Orientation, Engine, int)
 DECLARE_BUS_EVENT_ARG1(PointerLock, Engine, bool)
+// Emitted by the ServerWorld which advances the script animation system, see ServerWorld::setAnimationEnabled.
+DECLARE_BUS_EVENT_ARG1(ServerAnimationStep, Engine, float)
 DECLARE_BUS_EVENT_ARG0(RestartVM, Engine)
 DECLARE_BUS_EVENT_ARG0(Close, Engine)
 DECLARE_BUS_EVENT_ARG0(SceneLoad, Engine)
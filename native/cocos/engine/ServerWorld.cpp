@@ -0,0 +1,291 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "engine/ServerWorld.h"
+#include <algorithm>
+#include "base/Log.h"
+#include "base/Scheduler.h"
+#include "core/scene-graph/Scene.h"
+#include "engine/EngineEvents.h"
+#include "physics/spec/IWorld.h"
+#include "scene/Model.h"
+#include "scene/RenderScene.h"
+
+namespace cc {
+
+namespace {
+ServerWorldManager *instance = nullptr;
+// the world advancing the script animation system, there is one animation system per VM
+ServerWorld *animationWorld = nullptr;
+
+// weight of the last tick in the moving average of the tick time
+constexpr float TICK_TIME_SMOOTHING{0.1F};
+// the elapsed time of a tick is clamped, a stalled process must not simulate minutes at once
+constexpr float MAX_TICK_DELTA_TIME{1.F};
+
+void updateWorldTransforms(Node *node) { // NOLINT(misc-no-recursion)
+    // parents are updated first, so every node only resolves its own dirty bits
+    node->updateWorldTransform();
+    for (const auto &child : node->getChildren()) {
+        if (child && child->isActive()) {
+            updateWorldTransforms(child.get());
+        }
+    }
+}
+} // namespace
+
+ServerWorld::ServerWorld(uint32_t id)
+: _id(id) {
+    _scheduler = std::make_shared<Scheduler>();
+    _renderScene = ccnew scene::RenderScene();
+    _renderScene->initialize({"ServerWorld"});
+}
+
+ServerWorld::~ServerWorld() {
+    setAnimationEnabled(false);
+    _scheduler->unscheduleAll();
+    _renderScene->destroy();
+}
+
+scene::RenderScene *ServerWorld::getRenderScene() const {
+    if (_scene && _scene->getRenderScene()) {
+        return _scene->getRenderScene();
+    }
+    return _renderScene.get();
+}
+
+void ServerWorld::setScene(Scene *scene) {
+    _scene = scene;
+}
+
+bool ServerWorld::setAnimationEnabled(bool enabled) {
+    if (!enabled) {
+        if (animationWorld == this) {
+            animationWorld = nullptr;
+        }
+        return true;
+    }
+    if (animationWorld && animationWorld != this) {
+        CC_LOG_ERROR("ServerWorld %u: animation is already advanced by world %u, script animation states are global to the VM.", _id, animationWorld->getId());
+        return false;
+    }
+    animationWorld = this;
+    return true;
+}
+
+bool ServerWorld::isAnimationEnabled() const {
+    return animationWorld == this;
+}
+
+void ServerWorld::setFixedTimeStep(float step) {
+    if (step <= 0.F) {
+        CC_LOG_WARNING("ServerWorld %u: invalid fixed time step %f.", _id, step);
+        return;
+    }
+    _fixedTimeStep = step;
+    if (_physicsWorld) {
+        _physicsWorld->setFixedTimeStep(step);
+    }
+}
+
+void ServerWorld::resetStats() {
+    _stats = {};
+}
+
+uint32_t ServerWorld::beginTick(float deltaTime) {
+    _tickSteps = 0;
+    _tickTime = {};
+    if (_paused) {
+        return 0;
+    }
+    _accumulator += std::min(deltaTime, MAX_TICK_DELTA_TIME);
+    auto steps = static_cast<uint32_t>(_accumulator / _fixedTimeStep);
+    _accumulator -= static_cast<float>(steps) * _fixedTimeStep;
+    if (steps > _maxStepsPerTick) {
+        // drop the steps the world can't catch up with instead of falling further behind
+        _stats.droppedSteps += steps - _maxStepsPerTick;
+        steps = _maxStepsPerTick;
+    }
+    return steps;
+}
+
+void ServerWorld::step() {
+    const auto start = std::chrono::steady_clock::now();
+    const float dt = _fixedTimeStep;
+
+    _scheduler->update(dt);
+    if (isAnimationEnabled()) {
+        events::ServerAnimationStep::broadcast(dt);
+    }
+    emit<Step>(dt);
+
+    if (_physicsWorld) {
+        _physicsWorld->syncSceneToPhysics();
+        _physicsWorld->step(dt);
+        _physicsWorld->emitEvents();
+    }
+
+    updateTransforms();
+    emit<AfterStep>(dt);
+
+    ++_stepCount;
+    ++_tickSteps;
+    _tickTime += std::chrono::steady_clock::now() - start;
+}
+
+void ServerWorld::endTick() {
+    if (_tickSteps == 0) {
+        return;
+    }
+    const float tickMs = std::chrono::duration<float, std::milli>(_tickTime).count();
+    _stats.totalSteps += _tickSteps;
+    _stats.lastTickSteps = _tickSteps;
+    _stats.lastTickMs = tickMs;
+    _stats.maxTickMs = std::max(_stats.maxTickMs, tickMs);
+    _stats.averageTickMs = _stats.averageTickMs > 0.F ? _stats.averageTickMs + (tickMs - _stats.averageTickMs) * TICK_TIME_SMOOTHING : tickMs;
+    if (_tickBudgetMs > 0.F) {
+        const float usage = tickMs / _tickBudgetMs;
+        _stats.averageBudgetUsage = _stats.averageBudgetUsage > 0.F ? _stats.averageBudgetUsage + (usage - _stats.averageBudgetUsage) * TICK_TIME_SMOOTHING : usage;
+        if (usage > 1.F) {
+            ++_stats.overBudgetTicks;
+        }
+    }
+}
+
+void ServerWorld::advance(float deltaTime) {
+    const auto steps = beginTick(deltaTime);
+    for (uint32_t i = 0; i < steps; ++i) {
+        step();
+        Node::resetChangedFlags();
+    }
+    endTick();
+}
+
+void ServerWorld::updateTransforms() {
+    // every node of the scene, nodes without a model such as physics bodies and hitboxes are read by game code
+    if (_scene) {
+        updateWorldTransforms(_scene.get());
+    }
+    // then the bounds of the models, there are no UBOs to update without a pipeline
+    const auto stamp = static_cast<uint32_t>(_stepCount);
+    for (const auto &model : getRenderScene()->getModels()) {
+        if (model->isEnabled() && model->getNode()) {
+            model->updateTransform(stamp);
+        }
+    }
+}
+
+ServerWorldManager *ServerWorldManager::getInstance() {
+    return instance;
+}
+
+ServerWorldManager::ServerWorldManager() {
+    instance = this;
+}
+
+ServerWorldManager::~ServerWorldManager() {
+    destroyWorlds();
+    instance = nullptr;
+}
+
+ServerWorld *ServerWorldManager::createWorld() {
+    auto *world = ccnew ServerWorld(_nextWorldId++);
+    // the script animation system is advanced by the first world only
+    if (_worlds.empty()) {
+        world->setAnimationEnabled(true);
+    }
+    _worlds.emplace_back(world);
+    return world;
+}
+
+void ServerWorldManager::destroyWorld(ServerWorld *world) {
+    auto iter = std::find(_worlds.begin(), _worlds.end(), world);
+    if (iter != _worlds.end()) {
+        // the world may outlive the manager's reference, hand the animation over now
+        const bool animationEnabled = (*iter)->isAnimationEnabled();
+        (*iter)->setAnimationEnabled(false);
+        _worlds.erase(iter);
+        if (animationEnabled && !_worlds.empty()) {
+            _worlds.front()->setAnimationEnabled(true);
+        }
+    } else {
+        CC_LOG_WARNING("Try to destroy invalid ServerWorld.");
+    }
+}
+
+void ServerWorldManager::destroyWorlds() {
+    for (const auto &world : _worlds) {
+        world->setAnimationEnabled(false);
+    }
+    _worlds.clear();
+}
+
+ServerWorld *ServerWorldManager::getWorld(uint32_t id) const {
+    for (const auto &world : _worlds) {
+        if (world->getId() == id) {
+            return world.get();
+        }
+    }
+    return nullptr;
+}
+
+void ServerWorldManager::tick() {
+    const auto now = std::chrono::steady_clock::now();
+    float deltaTime = 0.F;
+    if (_lastTickTime != std::chrono::steady_clock::time_point{}) {
+        deltaTime = std::chrono::duration<float>(now - _lastTickTime).count();
+    }
+    _lastTickTime = now;
+    tick(deltaTime);
+}
+
+void ServerWorldManager::tick(float deltaTime) {
+    const auto start = std::chrono::steady_clock::now();
+
+    // keep the worlds alive while steps may destroy worlds
+    const auto worlds = _worlds;
+    const auto worldCount = worlds.size();
+    _dueSteps.resize(worldCount);
+    uint32_t rounds = 0;
+    for (size_t i = 0; i < worldCount; ++i) {
+        _dueSteps[i] = worlds[i]->beginTick(deltaTime);
+        rounds = std::max(rounds, _dueSteps[i]);
+    }
+    // the changed flags of the nodes are global, reset them once every world finished the step of the round
+    for (uint32_t round = 0; round < rounds; ++round) {
+        for (size_t i = 0; i < worldCount; ++i) {
+            if (round < _dueSteps[i]) {
+                worlds[i]->step();
+            }
+        }
+        Node::resetChangedFlags();
+    }
+    for (const auto &world : worlds) {
+        world->endTick();
+    }
+
+    _lastTickMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace cc
@@ -0,0 +1,235 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include "base/Ptr.h"
+#include "base/RefCounted.h"
+#include "base/std/container/vector.h"
+#include "core/event/Event.h"
+
+namespace cc {
+
+class Scene;
+class Scheduler;
+
+namespace scene {
+class RenderScene;
+} // namespace scene
+
+namespace physics {
+class IPhysicsWorld;
+} // namespace physics
+
+struct ServerWorldStats {
+    /**
+     * @en Fixed steps simulated since the stats were reset.
+     * @zh 统计重置以来模拟的固定步数。
+     */
+    uint64_t totalSteps{0};
+    /**
+     * @en Fixed steps dropped because a tick was already late by more than maxStepsPerTick.
+     * @zh 因单次 tick 落后超过 maxStepsPerTick 而丢弃的固定步数。
+     */
+    uint64_t droppedSteps{0};
+    /**
+     * @en Ticks which used more CPU time than the budget.
+     * @zh CPU 耗时超出预算的 tick 数。
+     */
+    uint64_t overBudgetTicks{0};
+    uint32_t lastTickSteps{0};
+    float lastTickMs{0.F};
+    float averageTickMs{0.F};
+    float maxTickMs{0.F};
+    /**
+     * @en Average ratio between the CPU time of a tick and the budget.
+     * @zh tick CPU 耗时与预算的平均比值。
+     */
+    float averageBudgetUsage{0.F};
+};
+
+/**
+ * @en A headless simulation world of a dedicated server. It owns a scheduler, and advances it, the assigned scene,
+ * the script animation system and an optional physics world on a fixed timestep.
+ * Worlds are independent, one process can host many of them with ServerWorldManager.
+ * @zh 专用服务器的无渲染模拟世界。拥有独立的调度器，以固定步长推进调度器、所设置的场景、脚本动画系统以及可选的物理世界。
+ * 各世界相互独立，一个进程可通过 ServerWorldManager 承载多个世界。
+ */
+class CC_DLL ServerWorld final : public RefCounted {
+    IMPL_EVENT_TARGET(ServerWorld)
+    DECLARE_TARGET_EVENT_BEGIN(ServerWorld)
+    // Emitted before physics in every fixed step, once animation is advanced, for game systems.
+    TARGET_EVENT_ARG1(Step, float)
+    // Emitted at the end of every fixed step, once physics and transforms are resolved.
+    TARGET_EVENT_ARG1(AfterStep, float)
+    DECLARE_TARGET_EVENT_END()
+public:
+    static constexpr float DEFAULT_FIXED_TIME_STEP{1.F / 30.F};
+    static constexpr uint32_t DEFAULT_MAX_STEPS_PER_TICK{4};
+
+    explicit ServerWorld(uint32_t id);
+    ~ServerWorld() override;
+
+    inline uint32_t getId() const { return _id; }
+
+    inline const std::shared_ptr<Scheduler> &getScheduler() const { return _scheduler; }
+    /**
+     * @en The RenderScene of the assigned scene, or a RenderScene owned by the world if there is no scene.
+     * @zh 所设置场景的 RenderScene，未设置场景时为该世界自有的 RenderScene。
+     */
+    scene::RenderScene *getRenderScene() const;
+
+    inline Scene *getScene() const { return _scene.get(); }
+    /**
+     * @en Sets the scene simulated by this world, the world transforms of all its active nodes are updated every step.
+     * @zh 设置该世界模拟的场景，每步更新其所有激活节点的世界变换。
+     */
+    void setScene(Scene *scene);
+
+    /**
+     * @en Whether the steps of this world advance the script animation system.
+     * Animation states are global to the script VM, so only one world of a process can enable it,
+     * enabling it on a second world logs an error and returns false.
+     * ServerWorldManager enables it on the first world it hosts.
+     * @zh 该世界的固定步是否推进脚本动画系统。动画状态在脚本虚拟机内是全局的，因此一个进程只能有一个世界开启，
+     * 在第二个世界上开启会输出错误并返回 false。ServerWorldManager 会在其承载的第一个世界上开启。
+     */
+    bool setAnimationEnabled(bool enabled);
+    bool isAnimationEnabled() const;
+
+    /**
+     * @en Sets the physics world stepped by this world, it is not owned.
+     * @zh 设置由该世界推进的物理世界，不持有其所有权。
+     */
+    inline void setPhysicsWorld(physics::IPhysicsWorld *world) { _physicsWorld = world; }
+    inline physics::IPhysicsWorld *getPhysicsWorld() const { return _physicsWorld; }
+
+    void setFixedTimeStep(float step);
+    inline float getFixedTimeStep() const { return _fixedTimeStep; }
+
+    inline void setMaxStepsPerTick(uint32_t count) { _maxStepsPerTick = count > 0 ? count : 1; }
+    inline uint32_t getMaxStepsPerTick() const { return _maxStepsPerTick; }
+
+    /**
+     * @en Sets the CPU time budget of a tick in milliseconds, 0 disables the budget check.
+     * @zh 设置每次 tick 的 CPU 时间预算（毫秒），0 表示不检查。
+     */
+    inline void setTickBudget(float milliseconds) { _tickBudgetMs = milliseconds; }
+    inline float getTickBudget() const { return _tickBudgetMs; }
+
+    inline void setPaused(bool paused) { _paused = paused; }
+    inline bool isPaused() const { return _paused; }
+
+    /**
+     * @en The fraction of a fixed step accumulated but not simulated yet, to interpolate snapshots.
+     * @zh 已累计但尚未模拟的固定步比例，用于快照插值。
+     */
+    inline float getInterpolationAlpha() const { return _accumulator / _fixedTimeStep; }
+    inline uint64_t getStepCount() const { return _stepCount; }
+
+    inline const ServerWorldStats &getStats() const { return _stats; }
+    void resetStats();
+
+    /**
+     * @en Accumulates the elapsed time and returns how many fixed steps are due, at most maxStepsPerTick.
+     * @zh 累计经过的时间，返回需要执行的固定步数，最多 maxStepsPerTick。
+     */
+    uint32_t beginTick(float deltaTime);
+    /**
+     * @en Simulates one fixed step.
+     * @zh 模拟一个固定步。
+     */
+    void step();
+    void endTick();
+
+    /**
+     * @en Advances the world on its own, the changed flags of the nodes are reset after every step.
+     * Worlds hosted by ServerWorldManager are advanced by the manager instead.
+     * @zh 单独推进该世界，每步之后重置节点的变化标记。由 ServerWorldManager 承载的世界由管理器推进。
+     */
+    void advance(float deltaTime);
+
+private:
+    void updateTransforms();
+
+    uint32_t _id{0};
+    std::shared_ptr<Scheduler> _scheduler;
+    IntrusivePtr<scene::RenderScene> _renderScene;
+    IntrusivePtr<Scene> _scene;
+    physics::IPhysicsWorld *_physicsWorld{nullptr};
+
+    float _fixedTimeStep{DEFAULT_FIXED_TIME_STEP};
+    float _accumulator{0.F};
+    float _tickBudgetMs{0.F};
+    uint32_t _maxStepsPerTick{DEFAULT_MAX_STEPS_PER_TICK};
+    uint32_t _tickSteps{0};
+    uint64_t _stepCount{0};
+    std::chrono::steady_clock::duration _tickTime{};
+    bool _paused{false};
+
+    ServerWorldStats _stats;
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(ServerWorld);
+};
+
+/**
+ * @en Hosts the ServerWorlds of a process. Every tick, the worlds are stepped in rounds,
+ * the changed flags of the nodes are shared by all worlds and reset once per round.
+ * @zh 管理进程中的所有 ServerWorld。每次 tick 按轮推进各世界，节点变化标记由所有世界共享，每轮重置一次。
+ */
+class CC_DLL ServerWorldManager final {
+public:
+    static ServerWorldManager *getInstance();
+
+    ServerWorldManager();
+    ~ServerWorldManager();
+
+    ServerWorld *createWorld();
+    void destroyWorld(ServerWorld *world);
+    void destroyWorlds();
+    ServerWorld *getWorld(uint32_t id) const;
+    inline const ccstd::vector<IntrusivePtr<ServerWorld>> &getWorlds() const { return _worlds; }
+
+    /**
+     * @en Advances all worlds by the real time elapsed since the last tick.
+     * @zh 以距上次 tick 的真实时间推进所有世界。
+     */
+    void tick();
+    void tick(float deltaTime);
+
+    inline float getLastTickMs() const { return _lastTickMs; }
+
+private:
+    ccstd::vector<IntrusivePtr<ServerWorld>> _worlds;
+    ccstd::vector<uint32_t> _dueSteps;
+    std::chrono::steady_clock::time_point _lastTickTime{};
+    float _lastTickMs{0.F};
+    uint32_t _nextWorldId{1};
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(ServerWorldManager);
+};
+
+} // namespace cc
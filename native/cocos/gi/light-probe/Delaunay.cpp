@@ -25,7 +25,10 @@
 
 #include "Delaunay.h"
 #include <algorithm>
+#include <functional>
 #include "base/Log.h"
+#include "base/job-system/JobSystem.h"
+#include "base/std/container/unordered_map.h"
 #include "core/platform/Debug.h"
 #include "math/Mat3.h"
 #define CC_USE_TETGEN 1
@@ -36,6 +39,114 @@
 namespace cc {
 namespace gi {
 
+namespace {
+// tetrahedron count above which per-tetrahedron work is split across job workers
+constexpr size_t PARALLEL_THRESHOLD{8192U};
+constexpr uint32_t HILBERT_BITS{10U};
+constexpr uint32_t BRIO_MAX_ROUND{15U};
+// mesh vertex closing the convex hull, cells containing it stand for the hull faces
+constexpr int32_t INFINITE_VERTEX{0};
+
+inline uint64_t getTriangleKey(const Triangle &triangle) {
+    return (static_cast<uint64_t>(triangle.vertex0) << 42U) | (static_cast<uint64_t>(triangle.vertex1) << 21U) | static_cast<uint64_t>(triangle.vertex2);
+}
+
+inline uint64_t getEdgeKey(const Edge &edge) {
+    return (static_cast<uint64_t>(edge.vertex0) << 32U) | static_cast<uint64_t>(edge.vertex1);
+}
+
+// six times the signed volume of (a, b, c, d), evaluated in double to keep thin cells stable
+inline double getSignedVolume(const Vec3 &a, const Vec3 &b, const Vec3 &c, const Vec3 &d) {
+    const double abx = static_cast<double>(b.x) - a.x;
+    const double aby = static_cast<double>(b.y) - a.y;
+    const double abz = static_cast<double>(b.z) - a.z;
+    const double acx = static_cast<double>(c.x) - a.x;
+    const double acy = static_cast<double>(c.y) - a.y;
+    const double acz = static_cast<double>(c.z) - a.z;
+    const double adx = static_cast<double>(d.x) - a.x;
+    const double ady = static_cast<double>(d.y) - a.y;
+    const double adz = static_cast<double>(d.z) - a.z;
+
+    return adx * (aby * acz - abz * acy) + ady * (abz * acx - abx * acz) + adz * (abx * acy - aby * acx);
+}
+
+// Skilling's transpose algorithm, maps a point of a 2^10 grid to its index on the 3D Hilbert curve
+uint32_t getHilbertIndex(uint32_t x, uint32_t y, uint32_t z) {
+    uint32_t axes[3] = {x, y, z};
+    constexpr uint32_t highest = 1U << (HILBERT_BITS - 1U);
+
+    for (uint32_t q = highest; q > 1U; q >>= 1U) {
+        const uint32_t p = q - 1U;
+        for (auto &axis : axes) {
+            if (axis & q) {
+                axes[0] ^= p;
+            } else {
+                const uint32_t t = (axes[0] ^ axis) & p;
+                axes[0] ^= t;
+                axis ^= t;
+            }
+        }
+    }
+
+    axes[1] ^= axes[0];
+    axes[2] ^= axes[1];
+
+    uint32_t t = 0U;
+    for (uint32_t q = highest; q > 1U; q >>= 1U) {
+        if (axes[2] & q) {
+            t ^= q - 1U;
+        }
+    }
+
+    uint32_t index = 0U;
+    for (int32_t bit = HILBERT_BITS - 1; bit >= 0; bit--) {
+        for (auto &axis : axes) {
+            index = (index << 1U) | (((axis ^ t) >> bit) & 1U);
+        }
+    }
+
+    return index;
+}
+
+// biased randomized insertion order: round r holds about 1 / 2^(r + 1) of the points, rarer rounds are inserted first
+uint32_t getBrioRound(uint32_t index) {
+    uint32_t hash = index + 0x9e3779b9U;
+    hash = (hash ^ (hash >> 16U)) * 0x7feb352dU;
+    hash = (hash ^ (hash >> 15U)) * 0x846ca68bU;
+    hash ^= hash >> 16U;
+
+    uint32_t round = 0U;
+    while (round < BRIO_MAX_ROUND && (hash & 1U)) {
+        hash >>= 1U;
+        round++;
+    }
+
+    return round;
+}
+
+template <typename Function>
+void parallelFor(uint32_t count, Function &&func) {
+    const uint32_t threadCount = JobSystem::getInstance()->threadCount();
+    if (count < PARALLEL_THRESHOLD || threadCount <= 1U) {
+        func(0U, count);
+        return;
+    }
+
+    const uint32_t chunkCount = threadCount * 4U;
+    const uint32_t chunkSize = (count - 1U) / chunkCount + 1U;
+    auto job = [&func, count, chunkSize](uint32_t chunk) {
+        const auto begin = std::min(count, chunk * chunkSize);
+        const auto end = std::min(count, begin + chunkSize);
+        func(begin, end);
+    };
+
+    JobGraph g(JobSystem::getInstance());
+    g.createForEachIndexJob(0U, chunkCount, 1U, job);
+    g.run();
+    g.waitForAll();
+}
+} // namespace
+
 void CircumSphere::init(const Vec3 &p0, const Vec3 &p1, const Vec3 &p2, const Vec3 &p3) {
     // calculate circumsphere of 4 points in R^3 space.
     Mat3 mat(p1.x - p0.x, p1.y - p0.y, p1.z - p0.z,
@@ -278,22 +389,28 @@ void Delaunay::computeAdjacency() {
         triangleIndex += 4;
     }
 
+    // shared faces are matched through a hash map instead of comparing every pair of triangles
+    ccstd::unordered_map<uint64_t, int32_t> faces;
+    faces.reserve(triangleIndex);
     for (auto i = 0; i < triangleIndex; i++) {
-        if (!_triangles[i].isOuterFace) {
+        auto result = faces.emplace(getTriangleKey(_triangles[i]), i);
+        if (result.second) {
             continue;
         }
 
-        for (auto k = i + 1; k < triangleIndex; k++) {
-            if (_triangles[i].isSame(_triangles[k])) {
-                // update adjacency between tetrahedrons
-                _tetrahedrons[_triangles[i].tetrahedron].neighbours[_triangles[i].index] = _triangles[k].tetrahedron;
-                _tetrahedrons[_triangles[k].tetrahedron].neighbours[_triangles[k].index] = _triangles[i].tetrahedron;
-                _triangles[i].isOuterFace = false;
-                _triangles[k].isOuterFace = false;
-                break;
-            }
+        const auto k = result.first->second;
+        if (!_triangles[k].isOuterFace) {
+            continue;
         }
 
+        // update adjacency between tetrahedrons
+        _tetrahedrons[_triangles[i].tetrahedron].neighbours[_triangles[i].index] = _triangles[k].tetrahedron;
+        _tetrahedrons[_triangles[k].tetrahedron].neighbours[_triangles[k].index] = _triangles[i].tetrahedron;
+        _triangles[i].isOuterFace = false;
+        _triangles[k].isOuterFace = false;
+    }
+
+    for (auto i = 0; i < triangleIndex; i++) {
         if (_triangles[i].isOuterFace) {
             auto &probe0 = _probes[_triangles[i].vertex0];
             auto &probe1 = _probes[_triangles[i].vertex1];
@@ -339,13 +456,15 @@ void Delaunay::computeAdjacency() {
         edgeIndex += 3;
     }
 
+    ccstd::unordered_map<uint64_t, int32_t> edges;
+    edges.reserve(edgeIndex);
     for (auto i = 0; i < edgeIndex; i++) {
-        for (auto k = i + 1; k < edgeIndex; k++) {
-            if (_edges[i].isSame(_edges[k])) {
-                // update adjacency between outer cells
-                _tetrahedrons[_edges[i].tetrahedron].neighbours[_edges[i].index] = _edges[k].tetrahedron;
-                _tetrahedrons[_edges[k].tetrahedron].neighbours[_edges[k].index] = _edges[i].tetrahedron;
-            }
+        auto result = edges.emplace(getEdgeKey(_edges[i]), i);
+        if (!result.second) {
+            // update adjacency between outer cells
+            const auto k = result.first->second;
+            _tetrahedrons[_edges[i].tetrahedron].neighbours[_edges[i].index] = _edges[k].tetrahedron;
+            _tetrahedrons[_edges[k].tetrahedron].neighbours[_edges[k].index] = _edges[i].tetrahedron;
         }
     }
 
@@ -358,13 +477,16 @@ void Delaunay::computeAdjacency() {
 }
 
 void Delaunay::computeMatrices() {
-    for (auto &tetrahedron : _tetrahedrons) {
-        if (tetrahedron.vertex3 >= 0) {
-            computeTetrahedronMatrix(tetrahedron);
-        } else {
-            computeOuterCellMatrix(tetrahedron);
+    parallelFor(static_cast<uint32_t>(_tetrahedrons.size()), [this](uint32_t begin, uint32_t end) {
+        for (auto i = begin; i < end; i++) {
+            auto &tetrahedron = _tetrahedrons[i];
+            if (tetrahedron.vertex3 >= 0) {
+                computeTetrahedronMatrix(tetrahedron);
+            } else {
+                computeOuterCellMatrix(tetrahedron);
+            }
         }
-    }
+    });
 }
 
 void Delaunay::computeTetrahedronMatrix(Tetrahedron &tetrahedron) {
@@ -442,5 +564,784 @@ void Delaunay::computeOuterCellMatrix(Tetrahedron &tetrahedron) {
     tetrahedron.offset.set(m[9], m[10], m[11]);
 }
 
+ccstd::vector<Tetrahedron> Delaunay::buildIncremental() {
+    if (!buildMesh()) {
+        CC_LOG_WARNING("Failed to tetrahedralize light probes incrementally, fall back to a full build.");
+        _cells.clear();
+        return build();
+    }
+
+    return extractTetrahedrons();
+}
+
+ccstd::vector<Tetrahedron> Delaunay::insertProbes() {
+    const auto probeCount = static_cast<int32_t>(_probes.size());
+    if (_cells.empty() || _meshProbeCount > probeCount) {
+        return buildIncremental();
+    }
+
+    ccstd::vector<int32_t> order;
+    order.reserve(probeCount - _meshProbeCount);
+    for (auto i = _meshProbeCount; i < probeCount; i++) {
+        order.push_back(i);
+    }
+    sortInsertionOrder(order);
+
+    _vertexCells.resize(probeCount + 1, -1);
+    if (!insertVertices(order)) {
+        return buildIncremental();
+    }
+    _meshProbeCount = probeCount;
+
+    return extractTetrahedrons();
+}
+
+ccstd::vector<Tetrahedron> Delaunay::removeProbes(ccstd::vector<int32_t> indices) {
+    const auto probeCount = static_cast<int32_t>(_probes.size());
+    std::sort(indices.begin(), indices.end());
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+    indices.erase(std::remove_if(indices.begin(), indices.end(), [probeCount](int32_t index) { return index < 0 || index >= probeCount; }), indices.end());
+
+    // mesh vertices keep their indices until all probes are removed, then they are compacted at once
+    bool meshValid = !_cells.empty() && _meshProbeCount == probeCount;
+    for (const auto index : indices) {
+        meshValid = meshValid && removeVertex(index + 1);
+    }
+
+    ccstd::vector<int32_t> remap(probeCount + 1, INFINITE_VERTEX);
+    _vertexCells.resize(probeCount + 1, -1);
+    auto count = 0;
+    for (auto i = 0, k = 0; i < probeCount; i++) {
+        if (k < static_cast<int32_t>(indices.size()) && indices[k] == i) {
+            k++;
+            continue;
+        }
+
+        remap[i + 1] = count + 1;
+        _vertexCells[count + 1] = _vertexCells[i + 1];
+        _probes[count++] = std::move(_probes[i]);
+    }
+    _probes.resize(count);
+    _vertexCells.resize(count + 1);
+
+    if (!meshValid) {
+        return buildIncremental();
+    }
+
+    for (auto &cell : _cells) {
+        if (!cell.invalid) {
+            for (auto &vertex : cell.vertices) {
+                vertex = remap[vertex];
+            }
+        }
+    }
+
+    _meshProbeCount = count;
+    return extractTetrahedrons();
+}
+
+bool Delaunay::buildMesh() {
+    _cells.clear();
+    _freeCells.clear();
+    _lastCell = -1;
+    _meshProbeCount = 0;
+
+    const auto probeCount = static_cast<int32_t>(_probes.size());
+    if (probeCount < 4) {
+        return false;
+    }
+
+    ccstd::vector<int32_t> order(probeCount);
+    for (auto i = 0; i < probeCount; i++) {
+        order[i] = i;
+    }
+    sortInsertionOrder(order);
+
+    // the first four probes in general position form the initial tetrahedron
+    ccstd::array<int32_t, 4> first{order[0], -1, -1, -1};
+    auto count = 1;
+    for (auto i = 1; i < probeCount && count < 4; i++) {
+        const auto &p0 = _probes[first[0]].position;
+        const auto &position = _probes[order[i]].position;
+        if (count == 1) {
+            count += position.distanceSquared(p0) > math::EPSILON ? 1 : 0;
+        } else if (count == 2) {
+            Vec3 normal;
+            Vec3::cross(_probes[first[1]].position - p0, position - p0, &normal);
+            count += normal.lengthSquared() > math::EPSILON ? 1 : 0;
+        } else {
+            count += std::abs(getSignedVolume(p0, _probes[first[1]].position, _probes[first[2]].position, position)) > math::EPSILON ? 1 : 0;
+        }
+        first[count - 1] = order[i];
+    }
+
+    if (count < 4) {
+        return false; // all probes are coplanar
+    }
+
+    ccstd::array<int32_t, 4> vertices{first[0] + 1, first[1] + 1, first[2] + 1, first[3] + 1};
+    if (getSignedVolume(getMeshPosition(vertices[0]), getMeshPosition(vertices[1]), getMeshPosition(vertices[2]), getMeshPosition(vertices[3])) < 0.0) {
+        std::swap(vertices[2], vertices[3]);
+    }
+
+    _vertexCells.assign(probeCount + 1, -1);
+    ccstd::array<int32_t, 5> initialCells{allocateCell(vertices), -1, -1, -1, -1};
+    for (auto i = 0; i < 4; i++) {
+        // hull cells are flipped so that replacing the infinite vertex with an outer point is positively oriented
+        auto hullVertices = vertices;
+        hullVertices[i] = INFINITE_VERTEX;
+        std::swap(hullVertices[(i + 1) & 3], hullVertices[(i + 2) & 3]);
+        initialCells[i + 1] = allocateCell(hullVertices);
+    }
+
+    for (auto i = 0; i < 5; i++) {
+        for (auto k = i + 1; k < 5; k++) {
+            linkNeighbour(initialCells[i], initialCells[k]);
+            linkNeighbour(initialCells[k], initialCells[i]);
+        }
+    }
+
+    order.erase(std::remove_if(order.begin(), order.end(), [&first](int32_t index) {
+                    return std::find(first.begin(), first.end(), index) != first.end();
+                }),
+                order.end());
+    if (!insertVertices(order)) {
+        return false;
+    }
+    _meshProbeCount = probeCount;
+
+    return true;
+}
+
+bool Delaunay::insertVertices(const ccstd::vector<int32_t> &order) {
+    ccstd::vector<int32_t> pending;
+    for (const auto index : order) {
+        if (!insertVertex(index + 1)) {
+            pending.push_back(index);
+        }
+    }
+
+    // probes rejected by precision errors are retried once their surroundings have changed
+    ccstd::vector<int32_t> remaining;
+    while (!pending.empty()) {
+        remaining.clear();
+        for (const auto index : pending) {
+            if (!insertVertex(index + 1)) {
+                remaining.push_back(index);
+            }
+        }
+
+        if (remaining.size() == pending.size()) {
+            return false;
+        }
+        pending.swap(remaining);
+    }
+
+    return true;
+}
+
+bool Delaunay::insertVertex(int32_t vertex) {
+    const auto &position = getMeshPosition(vertex);
+    const auto start = locate(position);
+    if (start < 0) {
+        return false;
+    }
+
+    // duplicated probe, leave it out of the mesh
+    for (const auto other : _cells[start].vertices) {
+        if (other != INFINITE_VERTEX && getMeshPosition(other).distanceSquared(position) <= math::EPSILON) {
+            return true;
+        }
+    }
+
+    // grow the cavity of cells in conflict with the new vertex
+    _cavity.clear();
+    _cavityFaces.clear();
+    _cavityStack.assign(1, start);
+    _cells[start].invalid = true;
+    while (!_cavityStack.empty()) {
+        const auto index = _cavityStack.back();
+        _cavityStack.pop_back();
+        _cavity.push_back(index);
+
+        for (auto i = 0; i < 4; i++) {
+            const auto neighbour = _cells[index].neighbours[i];
+            if (neighbour >= 0 && _cells[neighbour].invalid) {
+                continue;
+            }
+
+            // also take in the neighbour when the new cell on this face would be flat or inverted,
+            // which keeps the cavity star-shaped under floating point errors
+            if (neighbour >= 0 && (isInConflict(_cells[neighbour], position) || !isVisible(_cells[index], i, position))) {
+                _cells[neighbour].invalid = true;
+                _cavityStack.push_back(neighbour);
+            } else {
+                _cavityFaces.push_back({_cells[index].vertices, i, neighbour});
+            }
+        }
+    }
+
+    // the boundary of the cavity must be a closed surface, every edge is shared by exactly two faces
+    _cavityEdges.clear();
+    for (auto face = 0; face < static_cast<int32_t>(_cavityFaces.size()); face++) {
+        const auto &vertices = _cavityFaces[face].vertices;
+        const auto opposite = _cavityFaces[face].index;
+        for (auto i = 0; i < 4; i++) {
+            if (i == opposite) {
+                continue;
+            }
+
+            // the face opposite to vertices[i] of the new cell holds the new vertex and the remaining edge
+            auto v0 = -1;
+            auto v1 = -1;
+            for (auto k = 0; k < 4; k++) {
+                if (k != i && k != opposite) {
+                    (v0 < 0 ? v0 : v1) = vertices[k];
+                }
+            }
+            _cavityEdges.push_back({std::min(v0, v1), std::max(v0, v1), face, i});
+        }
+    }
+
+    std::sort(_cavityEdges.begin(), _cavityEdges.end(), [](const CavityEdge &a, const CavityEdge &b) {
+        return a.vertex0 < b.vertex0 || (a.vertex0 == b.vertex0 && a.vertex1 < b.vertex1);
+    });
+    const auto isSameEdge = [this](size_t i, size_t k) {
+        return k < _cavityEdges.size() && _cavityEdges[i].vertex0 == _cavityEdges[k].vertex0 && _cavityEdges[i].vertex1 == _cavityEdges[k].vertex1;
+    };
+    for (size_t i = 0; i < _cavityEdges.size(); i += 2) {
+        if (!isSameEdge(i, i + 1) || isSameEdge(i, i + 2)) {
+            // numerical precision error, leave the mesh untouched and let the caller retry later
+            for (const auto index : _cavity) {
+                _cells[index].invalid = false;
+            }
+            return false;
+        }
+    }
+
+    for (const auto index : _cavity) {
+        freeCell(index);
+    }
+
+    // connect every boundary face of the cavity to the new vertex
+    _cavityStack.clear();
+    for (const auto &face : _cavityFaces) {
+        auto vertices = face.vertices;
+        vertices[face.index] = vertex;
+
+        const auto cell = allocateCell(vertices);
+        _cells[cell].neighbours[face.index] = face.neighbour;
+        if (face.neighbour >= 0) {
+            linkNeighbour(face.neighbour, cell);
+        }
+        _cavityStack.push_back(cell);
+    }
+
+    for (size_t i = 0; i < _cavityEdges.size(); i += 2) {
+        const auto &edge0 = _cavityEdges[i];
+        const auto &edge1 = _cavityEdges[i + 1];
+        const auto cell0 = _cavityStack[edge0.face];
+        const auto cell1 = _cavityStack[edge1.face];
+        _cells[cell0].neighbours[edge0.index] = cell1;
+        _cells[cell1].neighbours[edge1.index] = cell0;
+    }
+
+    return true;
+}
+
+bool Delaunay::removeVertex(int32_t vertex) {
+    auto start = _vertexCells[vertex];
+    if (start < 0 || _cells[start].invalid || !_cells[start].contain(vertex)) {
+        const auto iter = std::find_if(_cells.begin(), _cells.end(), [vertex](const Cell &cell) { return !cell.invalid && cell.contain(vertex); });
+        if (iter == _cells.end()) {
+            return false;
+        }
+        start = static_cast<int32_t>(iter - _cells.begin());
+    }
+
+    // collect the star of the vertex, its link is re-tetrahedralized below
+    ccstd::vector<int32_t> star{start};
+    ccstd::vector<int32_t> link;
+    _cells[start].invalid = true;
+    for (size_t i = 0; i < star.size(); i++) {
+        const auto &cell = _cells[star[i]];
+        for (auto k = 0; k < 4; k++) {
+            const auto other = cell.vertices[k];
+            if (other == vertex) {
+                continue;
+            }
+
+            if (std::find(link.begin(), link.end(), other) == link.end()) {
+                link.push_back(other);
+            }
+
+            const auto neighbour = cell.neighbours[k];
+            if (neighbour >= 0 && !_cells[neighbour].invalid && _cells[neighbour].contain(vertex)) {
+                _cells[neighbour].invalid = true;
+                star.push_back(neighbour);
+            }
+        }
+    }
+
+    for (const auto index : star) {
+        _cells[index].invalid = false;
+    }
+
+    // probes on the convex hull change the hull itself, leave them to a rebuild
+    if (std::find(link.begin(), link.end(), INFINITE_VERTEX) != link.end()) {
+        return false;
+    }
+
+    ccstd::vector<Vertex> linkProbes;
+    linkProbes.reserve(link.size());
+    for (const auto other : link) {
+        linkProbes.emplace_back(getMeshPosition(other));
+    }
+
+    Delaunay local(linkProbes);
+    if (!local.buildMesh()) {
+        return false;
+    }
+
+    // keep the local cells filling the star, then every face has to match either
+    // another new cell or a boundary face of the star
+    struct FaceRecord {
+        ccstd::array<int32_t, 3> key;
+        int32_t cell{-1}; // index in newCells, -1 for a boundary face of the star
+        int32_t index{-1};
+        int32_t neighbour{-1};
+    };
+    auto makeKey = [](int32_t v0, int32_t v1, int32_t v2) {
+        ccstd::array<int32_t, 3> key{v0, v1, v2};
+        std::sort(key.begin(), key.end());
+        return key;
+    };
+
+    ccstd::vector<ccstd::array<int32_t, 4>> newCells;
+    ccstd::vector<FaceRecord> faces;
+    for (const auto &cell : local._cells) {
+        if (cell.invalid || cell.contain(INFINITE_VERTEX)) {
+            continue;
+        }
+
+        Vec3 centroid;
+        for (const auto other : cell.vertices) {
+            centroid += linkProbes[other - 1].position * 0.25F;
+        }
+
+        const auto inside = std::any_of(star.begin(), star.end(), [this, &centroid](int32_t index) {
+            return isInCell(_cells[index], centroid);
+        });
+        if (!inside) {
+            continue;
+        }
+
+        ccstd::array<int32_t, 4> vertices{link[cell.vertices[0] - 1], link[cell.vertices[1] - 1], link[cell.vertices[2] - 1], link[cell.vertices[3] - 1]};
+        for (auto k = 0; k < 4; k++) {
+            faces.push_back({makeKey(vertices[(k + 1) & 3], vertices[(k + 2) & 3], vertices[(k + 3) & 3]), static_cast<int32_t>(newCells.size()), k, -1});
+        }
+        newCells.push_back(vertices);
+    }
+
+    for (const auto index : star) {
+        const auto &cell = _cells[index];
+        for (auto k = 0; k < 4; k++) {
+            if (cell.vertices[k] == vertex) {
+                faces.push_back({makeKey(cell.vertices[(k + 1) & 3], cell.vertices[(k + 2) & 3], cell.vertices[(k + 3) & 3]), -1, -1, cell.neighbours[k]});
+            }
+        }
+    }
+
+    std::sort(faces.begin(), faces.end(), [](const FaceRecord &a, const FaceRecord &b) { return a.key < b.key; });
+    if (faces.size() % 2 != 0) {
+        return false;
+    }
+    for (size_t i = 0; i < faces.size(); i += 2) {
+        if (faces[i].key != faces[i + 1].key || (faces[i].cell < 0 && faces[i + 1].cell < 0)) {
+            return false;
+        }
+    }
+
+    // the star is filled exactly, replace it
+    for (const auto index : star) {
+        freeCell(index);
+    }
+
+    ccstd::vector<int32_t> cellIndices(newCells.size());
+    for (size_t i = 0; i < newCells.size(); i++) {
+        cellIndices[i] = allocateCell(newCells[i]);
+    }
+
+    for (size_t i = 0; i < faces.size(); i += 2) {
+        const auto &face0 = faces[i].cell >= 0 ? faces[i] : faces[i + 1];
+        const auto &face1 = faces[i].cell >= 0 ? faces[i + 1] : faces[i];
+        const auto cell0 = cellIndices[face0.cell];
+        if (face1.cell >= 0) {
+            const auto cell1 = cellIndices[face1.cell];
+            _cells[cell0].neighbours[face0.index] = cell1;
+            _cells[cell1].neighbours[face1.index] = cell0;
+        } else {
+            _cells[cell0].neighbours[face0.index] = face1.neighbour;
+            if (face1.neighbour >= 0) {
+                linkNeighbour(face1.neighbour, cell0);
+            }
+        }
+    }
+
+    _vertexCells[vertex] = -1;
+
+    return true;
+}
+
+int32_t Delaunay::locate(const Vec3 &position) const {
+    auto index = _lastCell;
+    if (index < 0 || _cells[index].invalid) {
+        const auto iter = std::find_if(_cells.begin(), _cells.end(), [](const Cell &cell) { return !cell.invalid; });
+        if (iter == _cells.end()) {
+            return -1;
+        }
+        index = static_cast<int32_t>(iter - _cells.begin());
+    }
+
+    // start the walk from the finite side of a hull cell
+    for (auto i = 0; i < 4; i++) {
+        if (_cells[index].vertices[i] == INFINITE_VERTEX) {
+            index = _cells[index].neighbours[i];
+            break;
+        }
+    }
+
+    // visibility walk, the rotating start face prevents cycling on degenerate configurations
+    for (size_t step = 0; step < _cells.size(); step++) {
+        const auto &cell = _cells[index];
+        if (cell.contain(INFINITE_VERTEX)) {
+            return index; // outside of the convex hull
+        }
+
+        auto next = index;
+        for (auto k = 0; k < 4; k++) {
+            const auto i = static_cast<int32_t>((k + step) & 3U);
+            if (orient(cell, i, position) < 0.0) {
+                next = cell.neighbours[i];
+                break;
+            }
+        }
+
+        if (next == index) {
+            return index;
+        }
+
+        if (next < 0) {
+            return -1;
+        }
+
+        index = next;
+    }
+
+    return -1;
+}
+
+int32_t Delaunay::allocateCell(const ccstd::array<int32_t, 4> &vertices) {
+    int32_t index = 0;
+    if (!_freeCells.empty()) {
+        index = _freeCells.back();
+        _freeCells.pop_back();
+        _cells[index] = {};
+    } else {
+        index = static_cast<int32_t>(_cells.size());
+        _cells.emplace_back();
+    }
+
+    auto &cell = _cells[index];
+    cell.vertices = vertices;
+    initCellSphere(cell);
+    for (const auto vertex : vertices) {
+        _vertexCells[vertex] = index;
+    }
+    _lastCell = index;
+
+    return index;
+}
+
+void Delaunay::freeCell(int32_t index) {
+    _cells[index].invalid = true;
+    _freeCells.push_back(index);
+}
+
+void Delaunay::linkNeighbour(int32_t cell, int32_t neighbour) {
+    // the shared face is opposite to the only vertex of cell which is not in neighbour
+    auto &target = _cells[cell];
+    const auto &other = _cells[neighbour];
+    auto index = -1;
+    for (auto i = 0; i < 4; i++) {
+        if (!other.contain(target.vertices[i])) {
+            if (index >= 0) {
+                return; // no shared face
+            }
+            index = i;
+        }
+    }
+
+    if (index >= 0) {
+        target.neighbours[index] = neighbour;
+    }
+}
+
+void Delaunay::initCellSphere(Cell &cell) const {
+    cell.radiusSquared = -1.0;
+    if (cell.contain(INFINITE_VERTEX)) {
+        return;
+    }
+
+    const auto &p0 = getMeshPosition(cell.vertices[0]);
+    const auto &p1 = getMeshPosition(cell.vertices[1]);
+    const auto &p2 = getMeshPosition(cell.vertices[2]);
+    const auto &p3 = getMeshPosition(cell.vertices[3]);
+
+    const double a[3] = {static_cast<double>(p1.x) - p0.x, static_cast<double>(p1.y) - p0.y, static_cast<double>(p1.z) - p0.z};
+    const double b[3] = {static_cast<double>(p2.x) - p0.x, static_cast<double>(p2.y) - p0.y, static_cast<double>(p2.z) - p0.z};
+    const double c[3] = {static_cast<double>(p3.x) - p0.x, static_cast<double>(p3.y) - p0.y, static_cast<double>(p3.z) - p0.z};
+
+    const double bc[3] = {b[1] * c[2] - b[2] * c[1], b[2] * c[0] - b[0] * c[2], b[0] * c[1] - b[1] * c[0]};
+    const double ca[3] = {c[1] * a[2] - c[2] * a[1], c[2] * a[0] - c[0] * a[2], c[0] * a[1] - c[1] * a[0]};
+    const double ab[3] = {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]};
+    const double det = a[0] * bc[0] + a[1] * bc[1] + a[2] * bc[2];
+
+    // flat cell, never grows a cavity
+    if (std::abs(det) <= std::numeric_limits<double>::epsilon()) {
+        return;
+    }
+
+    const double aa = a[0] * a[0] + a[1] * a[1] + a[2] * a[2];
+    const double bb = b[0] * b[0] + b[1] * b[1] + b[2] * b[2];
+    const double cc = c[0] * c[0] + c[1] * c[1] + c[2] * c[2];
+    const double scale = 0.5 / det;
+
+    double radiusSquared = 0.0;
+    for (auto i = 0; i < 3; i++) {
+        const double offset = (aa * bc[i] + bb * ca[i] + cc * ab[i]) * scale;
+        cell.center[i] = offset;
+        radiusSquared += offset * offset;
+    }
+
+    cell.center[0] += p0.x;
+    cell.center[1] += p0.y;
+    cell.center[2] += p0.z;
+    cell.radiusSquared = radiusSquared;
+}
+
+bool Delaunay::isInCellSphere(const Cell &cell, const Vec3 &position) const {
+    const double x = position.x - cell.center[0];
+    const double y = position.y - cell.center[1];
+    const double z = position.z - cell.center[2];
+
+    return x * x + y * y + z * z < cell.radiusSquared;
+}
+
+bool Delaunay::isInConflict(const Cell &cell, const Vec3 &position) const {
+    for (auto i = 0; i < 4; i++) {
+        if (cell.vertices[i] != INFINITE_VERTEX) {
+            continue;
+        }
+
+        // a hull cell conflicts with points in front of its hull face
+        const auto side = orient(cell, i, position);
+        if (side != 0.0) {
+            return side > 0.0;
+        }
+
+        // on the plane of the hull face, it conflicts if the point is inside the face's circumcircle
+        const auto neighbour = cell.neighbours[i];
+        return neighbour >= 0 && isInCellSphere(_cells[neighbour], position);
+    }
+
+    return isInCellSphere(cell, position);
+}
+
+bool Delaunay::isVisible(const Cell &cell, int32_t index, const Vec3 &position) const {
+    for (auto i = 0; i < 4; i++) {
+        if (i != index && cell.vertices[i] == INFINITE_VERTEX) {
+            return true; // hull faces are handled by the conflict test
+        }
+    }
+
+    return orient(cell, index, position) > 0.0;
+}
+
+bool Delaunay::isInCell(const Cell &cell, const Vec3 &position) const {
+    for (auto i = 0; i < 4; i++) {
+        if (orient(cell, i, position) < 0.0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+double Delaunay::orient(const Cell &cell, int32_t index, const Vec3 &position) const {
+    // signed volume of the cell with vertices[index] replaced by position, cells are positively oriented
+    const auto &p0 = index == 0 ? position : getMeshPosition(cell.vertices[0]);
+    const auto &p1 = index == 1 ? position : getMeshPosition(cell.vertices[1]);
+    const auto &p2 = index == 2 ? position : getMeshPosition(cell.vertices[2]);
+    const auto &p3 = index == 3 ? position : getMeshPosition(cell.vertices[3]);
+
+    return getSignedVolume(p0, p1, p2, p3);
+}
+
+const Vec3 &Delaunay::getMeshPosition(int32_t vertex) const {
+    return _probes[vertex - 1].position;
+}
+
+void Delaunay::sortInsertionOrder(ccstd::vector<int32_t> &order) const {
+    if (order.size() < 2) {
+        return;
+    }
+
+    Vec3 minPos = _probes[order[0]].position;
+    Vec3 maxPos = minPos;
+    for (const auto index : order) {
+        Vec3::min(minPos, _probes[index].position, &minPos);
+        Vec3::max(maxPos, _probes[index].position, &maxPos);
+    }
+
+    const auto extent = maxPos - minPos;
+    const auto gridSize = static_cast<float>((1U << HILBERT_BITS) - 1U);
+    const Vec3 scale(extent.x > 0.0F ? gridSize / extent.x : 0.0F,
+                     extent.y > 0.0F ? gridSize / extent.y : 0.0F,
+                     extent.z > 0.0F ? gridSize / extent.z : 0.0F);
+
+    // BRIO: points are split into rounds of growing size and sorted along a Hilbert curve inside each round,
+    // consecutive insertions are close to each other which keeps the walk in locate() short
+    ccstd::vector<uint64_t> keys(order.size());
+    parallelFor(static_cast<uint32_t>(order.size()), [&](uint32_t begin, uint32_t end) {
+        for (auto i = begin; i < end; i++) {
+            const auto index = order[i];
+            const auto &position = _probes[index].position;
+            const auto hilbert = getHilbertIndex(static_cast<uint32_t>((position.x - minPos.x) * scale.x),
+                                                 static_cast<uint32_t>((position.y - minPos.y) * scale.y),
+                                                 static_cast<uint32_t>((position.z - minPos.z) * scale.z));
+            const auto round = BRIO_MAX_ROUND - getBrioRound(static_cast<uint32_t>(index));
+            keys[i] = (static_cast<uint64_t>(round) << 32U) | hilbert;
+        }
+    });
+
+    ccstd::vector<uint32_t> sorted(order.size());
+    for (uint32_t i = 0; i < sorted.size(); i++) {
+        sorted[i] = i;
+    }
+    std::sort(sorted.begin(), sorted.end(), [&keys](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+
+    ccstd::vector<int32_t> result(order.size());
+    for (size_t i = 0; i < sorted.size(); i++) {
+        result[i] = order[sorted[i]];
+    }
+    order.swap(result);
+}
+
+ccstd::vector<Tetrahedron> Delaunay::extractTetrahedrons() {
+    reset();
+
+    Vec3 minPos = _probes[0].position;
+    Vec3 maxPos = _probes[0].position;
+    for (auto &probe : _probes) {
+        Vec3::min(minPos, probe.position, &minPos);
+        Vec3::max(maxPos, probe.position, &maxPos);
+        probe.normal.setZero();
+    }
+
+    // same order as reorder(), the tetrahedron in the middle is placed at the front
+    const auto center = (maxPos + minPos) * 0.5F;
+    ccstd::vector<std::pair<double, int32_t>> order;
+    for (auto i = 0; i < static_cast<int32_t>(_cells.size()); i++) {
+        const auto &cell = _cells[i];
+        if (!cell.invalid && !cell.contain(INFINITE_VERTEX)) {
+            const double x = cell.center[0] - center.x;
+            const double y = cell.center[1] - center.y;
+            const double z = cell.center[2] - center.z;
+            order.emplace_back(x * x + y * y + z * z, i);
+        }
+    }
+    std::sort(order.begin(), order.end());
+
+    // the mesh already knows every neighbour, so the face and edge matching of computeAdjacency() is not needed
+    const auto tetrahedronCount = static_cast<int32_t>(order.size());
+    ccstd::vector<int32_t> cellTetrahedrons(_cells.size(), -1);
+    _tetrahedrons.reserve(tetrahedronCount * 2);
+    for (auto i = 0; i < tetrahedronCount; i++) {
+        const auto &cell = _cells[order[i].second];
+        _tetrahedrons.emplace_back(this, cell.vertices[0] - 1, cell.vertices[1] - 1, cell.vertices[2] - 1, cell.vertices[3] - 1);
+        cellTetrahedrons[order[i].second] = i;
+    }
+
+    // hull cells become outer cells, placed after all tetrahedrons
+    auto outerCellCount = 0;
+    for (auto i = 0; i < static_cast<int32_t>(_cells.size()); i++) {
+        if (!_cells[i].invalid && _cells[i].contain(INFINITE_VERTEX)) {
+            cellTetrahedrons[i] = tetrahedronCount + outerCellCount++;
+        }
+    }
+
+    for (auto i = 0; i < tetrahedronCount; i++) {
+        const auto &cell = _cells[order[i].second];
+        for (auto k = 0; k < 4; k++) {
+            _tetrahedrons[i].neighbours[k] = cellTetrahedrons[cell.neighbours[k]];
+        }
+    }
+
+    Vec3 normal;
+    for (const auto &cell : _cells) {
+        if (cell.invalid || !cell.contain(INFINITE_VERTEX)) {
+            continue;
+        }
+
+        const auto infinite = static_cast<int32_t>(std::find(cell.vertices.begin(), cell.vertices.end(), INFINITE_VERTEX) - cell.vertices.begin());
+        const auto inner = cell.neighbours[infinite];
+        const auto &innerCell = _cells[inner];
+        auto v0 = cell.vertices[(infinite + 1) & 3];
+        auto v1 = cell.vertices[(infinite + 2) & 3];
+        auto v2 = cell.vertices[(infinite + 3) & 3];
+        auto opposite = -1;
+        for (const auto vertex : innerCell.vertices) {
+            opposite = cell.contain(vertex) ? opposite : vertex;
+        }
+
+        auto &probe0 = _probes[v0 - 1];
+        auto &probe1 = _probes[v1 - 1];
+        auto &probe2 = _probes[v2 - 1];
+        Vec3::cross(probe1.position - probe0.position, probe2.position - probe0.position, &normal);
+        if (normal.dot(getMeshPosition(opposite) - probe0.position) > 0.0F) {
+            normal.negate();
+            std::swap(v1, v2);
+        }
+
+        // accumulate weighted normal
+        probe0.normal += normal;
+        probe1.normal += normal;
+        probe2.normal += normal;
+
+        // create an outer cell with normal facing out
+        Tetrahedron tetrahedron(this, v0 - 1, v1 - 1, v2 - 1);
+        const ccstd::array<int32_t, 3> vertices{v0, v1, v2};
+        for (auto k = 0; k < 3; k++) {
+            // the outer cell across the edge opposite to vertices[k]
+            const auto index = std::find(cell.vertices.begin(), cell.vertices.end(), vertices[k]) - cell.vertices.begin();
+            tetrahedron.neighbours[k] = cellTetrahedrons[cell.neighbours[index]];
+        }
+        tetrahedron.neighbours[3] = cellTetrahedrons[inner];
+        _tetrahedrons.push_back(tetrahedron);
+    }
+
+    // normalize all convex hull probes' normal
+    for (auto &probe : _probes) {
+        if (!probe.normal.isZero()) {
+            probe.normal.normalize();
+        }
+    }
+
+    computeMatrices();
+
+    return std::move(_tetrahedrons);
+}
+
 } // namespace gi
 } // namespace cc
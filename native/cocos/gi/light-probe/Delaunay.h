@@ -221,7 +221,63 @@ public:
 
     ccstd::vector<Tetrahedron> build();
 
+    /**
+     * Incremental interface, the Bowyer-Watson mesh is kept alive between calls so that editing
+     * or streaming probes only re-tetrahedralizes the cavities around the changed probes.
+     * buildIncremental() tetrahedralizes all probes and keeps the mesh,
+     * insertProbes() inserts the probes appended to the probe array since the last call,
+     * removeProbes() erases the probes at the given indices from both the probe array and the mesh.
+     * Each call falls back to a full incremental build if the mesh can not be updated locally.
+     */
+    ccstd::vector<Tetrahedron> buildIncremental();
+    ccstd::vector<Tetrahedron> insertProbes();
+    ccstd::vector<Tetrahedron> removeProbes(ccstd::vector<int32_t> indices);
+
 private:
+    struct Cell {
+        ccstd::array<int32_t, 4> vertices{-1, -1, -1, -1};   // mesh vertex index, 0 is the infinite vertex of hull cells
+        ccstd::array<int32_t, 4> neighbours{-1, -1, -1, -1}; // neighbour cell opposite to each vertex
+        ccstd::array<double, 3> center{0.0, 0.0, 0.0};
+        double radiusSquared{-1.0};
+        bool invalid{false};
+
+        inline bool contain(int32_t vertex) const {
+            return (vertices[0] == vertex || vertices[1] == vertex ||
+                    vertices[2] == vertex || vertices[3] == vertex);
+        }
+    };
+
+    struct CavityFace {
+        ccstd::array<int32_t, 4> vertices; // vertices of the removed cell, the face is opposite to vertices[index]
+        int32_t index{-1};
+        int32_t neighbour{-1};
+    };
+
+    struct CavityEdge {
+        int32_t vertex0{-1};
+        int32_t vertex1{-1};
+        int32_t face{-1}; // index into _cavityFaces
+        int32_t index{-1};
+    };
+
+    bool buildMesh();
+    bool insertVertices(const ccstd::vector<int32_t> &order);
+    bool insertVertex(int32_t vertex);
+    bool removeVertex(int32_t vertex);
+    int32_t locate(const Vec3 &position) const;
+    int32_t allocateCell(const ccstd::array<int32_t, 4> &vertices);
+    void freeCell(int32_t index);
+    void linkNeighbour(int32_t cell, int32_t neighbour);
+    void initCellSphere(Cell &cell) const;
+    bool isInCellSphere(const Cell &cell, const Vec3 &position) const;
+    bool isInConflict(const Cell &cell, const Vec3 &position) const;
+    bool isVisible(const Cell &cell, int32_t index, const Vec3 &position) const;
+    bool isInCell(const Cell &cell, const Vec3 &position) const;
+    double orient(const Cell &cell, int32_t index, const Vec3 &position) const;
+    const Vec3 &getMeshPosition(int32_t vertex) const;
+    void sortInsertionOrder(ccstd::vector<int32_t> &order) const;
+    ccstd::vector<Tetrahedron> extractTetrahedrons();
+
     void reset();
     void tetrahedralize(); // Bowyer-Watson algorithm
     Vec3 initTetrahedron();
@@ -240,6 +296,19 @@ private:
     ccstd::vector<Triangle> _triangles;
     ccstd::vector<Edge> _edges;
 
+    // incremental Bowyer-Watson mesh, probe i is mesh vertex i + 1
+    ccstd::vector<Cell> _cells;
+    ccstd::vector<int32_t> _freeCells;
+    ccstd::vector<int32_t> _vertexCells; // one incident cell of each mesh vertex
+    int32_t _lastCell{-1};
+    int32_t _meshProbeCount{0};
+
+    // scratch buffers reused by every insertion
+    ccstd::vector<int32_t> _cavity;
+    ccstd::vector<int32_t> _cavityStack;
+    ccstd::vector<CavityFace> _cavityFaces;
+    ccstd::vector<CavityEdge> _cavityEdges;
+
     CC_DISALLOW_COPY_MOVE_ASSIGN(Delaunay);
     friend class Tetrahedron;
 };
@@ -24,6 +24,7 @@
 ****************************************************************************/
 
 #include "LightProbe.h"
+#include <algorithm>
 #include "PolynomialSolver.h"
 #include "core/Root.h"
 #include "core/scene-graph/Node.h"
@@ -37,6 +38,8 @@ namespace gi {
 
 void LightProbesData::updateProbes(ccstd::vector<Vec3> &points) {
     _probes.clear();
+    _tetrahedronGrid.clear();
+    _delaunay.reset();
 
     auto pointCount = points.size();
     _probes.reserve(pointCount);
@@ -48,6 +51,135 @@ void LightProbesData::updateProbes(ccstd::vector<Vec3> &points) {
 void LightProbesData::updateTetrahedrons() {
     Delaunay delaunay(_probes);
     _tetrahedrons = delaunay.build();
+    updateTetrahedronGrid();
+}
+
+void LightProbesData::updateProbesAndTetrahedrons(ccstd::vector<Vec3> &points) {
+    const auto probeCount = _probes.size();
+    const auto pointCount = points.size();
+
+    if (_delaunay && pointCount >= probeCount &&
+        std::equal(_probes.begin(), _probes.end(), points.begin(), [](const Vertex &probe, const Vec3 &point) { return probe.position == point; })) {
+        // probes appended
+        for (auto i = probeCount; i < pointCount; i++) {
+            _probes.emplace_back(points[i]);
+        }
+        _tetrahedrons = _delaunay->insertProbes();
+    } else if (_delaunay && pointCount < probeCount) {
+        // probes removed, the remaining ones must keep their order
+        ccstd::vector<int32_t> removed;
+        removed.reserve(probeCount - pointCount);
+        size_t next = 0U;
+        for (auto i = 0; i < probeCount; i++) {
+            if (next < pointCount && _probes[i].position == points[next]) {
+                next++;
+            } else {
+                removed.push_back(i);
+            }
+        }
+
+        if (next == pointCount) {
+            _tetrahedrons = _delaunay->removeProbes(removed);
+        } else {
+            updateProbes(points);
+        }
+    } else {
+        updateProbes(points);
+    }
+
+    if (!_delaunay) {
+        _delaunay = std::make_unique<Delaunay>(_probes);
+        _tetrahedrons = _delaunay->buildIncremental();
+    }
+
+    // coefficients are baked again after the mesh changed, same as recreating all probes
+    for (auto &probe : _probes) {
+        probe.coefficients.clear();
+    }
+
+    updateTetrahedronGrid();
+}
+
+void LightProbesData::updateTetrahedronGrid() {
+    _tetrahedronGrid.clear();
+    _gridResolution = 0U;
+    _gridTetrahedronCount = _tetrahedrons.size();
+
+    if (empty()) {
+        return;
+    }
+
+    Vec3 minPos = _probes[0].position;
+    Vec3 maxPos = _probes[0].position;
+    for (const auto &probe : _probes) {
+        minPos.set(std::min(minPos.x, probe.position.x), std::min(minPos.y, probe.position.y), std::min(minPos.z, probe.position.z));
+        maxPos.set(std::max(maxPos.x, probe.position.x), std::max(maxPos.y, probe.position.y), std::max(maxPos.z, probe.position.z));
+    }
+
+    int32_t innerCount = 0;
+    int32_t tetIndex = -1;
+    for (auto i = 0; i < _tetrahedrons.size(); i++) {
+        if (_tetrahedrons[i].isInnerTetrahedron()) {
+            tetIndex = tetIndex < 0 ? i : tetIndex;
+            innerCount++;
+        }
+    }
+
+    // roughly one inner tetrahedron per cell
+    const auto resolution = static_cast<uint32_t>(std::ceil(std::cbrt(static_cast<float>(innerCount))));
+    _gridResolution = mathutils::clamp(resolution, 1U, MAX_GRID_RESOLUTION);
+    _gridMin = minPos;
+
+    const auto extent = maxPos - minPos;
+    const auto resolutionInv = 1.0F / static_cast<float>(_gridResolution);
+    _gridCellSize.set(std::max(extent.x * resolutionInv, math::EPSILON),
+                      std::max(extent.y * resolutionInv, math::EPSILON),
+                      std::max(extent.z * resolutionInv, math::EPSILON));
+    _gridCellSizeInv.set(1.0F / _gridCellSize.x, 1.0F / _gridCellSize.y, 1.0F / _gridCellSize.z);
+    _tetrahedronGrid.resize(static_cast<size_t>(_gridResolution) * _gridResolution * _gridResolution);
+
+    // walk from the previous cell, neighbouring cells usually end in close tetrahedrons
+    Vec4 weights(0.0F, 0.0F, 0.0F, 0.0F);
+    tetIndex = std::max(tetIndex, 0);
+    for (uint32_t z = 0; z < _gridResolution; z++) {
+        for (uint32_t y = 0; y < _gridResolution; y++) {
+            for (uint32_t x = 0; x < _gridResolution; x++) {
+                const Vec3 center(_gridMin.x + (static_cast<float>(x) + 0.5F) * _gridCellSize.x,
+                                  _gridMin.y + (static_cast<float>(y) + 0.5F) * _gridCellSize.y,
+                                  _gridMin.z + (static_cast<float>(z) + 0.5F) * _gridCellSize.z);
+                tetIndex = getInterpolationWeights(center, tetIndex, weights);
+                _tetrahedronGrid[(z * _gridResolution + y) * _gridResolution + x] = tetIndex;
+            }
+        }
+    }
+}
+
+int32_t LightProbesData::getGridTetrahedronIndex(const Vec3 &position) const {
+    if (_tetrahedronGrid.empty()) {
+        return -1;
+    }
+
+    const auto maxCell = static_cast<int32_t>(_gridResolution) - 1;
+    const auto x = mathutils::clamp(static_cast<int32_t>(std::floor((position.x - _gridMin.x) * _gridCellSizeInv.x)), 0, maxCell);
+    const auto y = mathutils::clamp(static_cast<int32_t>(std::floor((position.y - _gridMin.y) * _gridCellSizeInv.y)), 0, maxCell);
+    const auto z = mathutils::clamp(static_cast<int32_t>(std::floor((position.z - _gridMin.z) * _gridCellSizeInv.z)), 0, maxCell);
+
+    return _tetrahedronGrid[(z * _gridResolution + y) * _gridResolution + x];
+}
+
+int32_t LightProbesData::getStartTetrahedronIndex(const Vec3 &position, const Vec3 &lastPosition, int32_t tetIndex) const {
+    if (!isTetrahedronGridValid()) {
+        return tetIndex;
+    }
+
+    if (tetIndex >= 0 && tetIndex < _tetrahedrons.size()) {
+        const auto delta = position - lastPosition;
+        if (std::abs(delta.x) < _gridCellSize.x && std::abs(delta.y) < _gridCellSize.y && std::abs(delta.z) < _gridCellSize.z) {
+            return tetIndex;
+        }
+    }
+
+    return getGridTetrahedronIndex(position);
 }
 
 bool LightProbesData::getInterpolationSHCoefficients(int32_t tetIndex, const Vec4 &weights, ccstd::vector<Vec3> &coefficients) const {
@@ -296,11 +428,11 @@ void LightProbeInfo::update(bool updateTet) {
         return;
     }
 
-    _data->updateProbes(points);
-
     if (updateTet) {
         resetAllTetraIndices();
-        _data->updateTetrahedrons();
+        _data->updateProbesAndTetrahedrons(points);
+    } else {
+        _data->updateProbes(points);
     }
 }
 
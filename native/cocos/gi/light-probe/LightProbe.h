@@ -25,6 +25,7 @@
 
 #pragma once
 
+#include <memory>
 #include "Delaunay.h"
 #include "SH.h"
 #include "base/Macros.h"
@@ -47,28 +48,66 @@ public:
     LightProbesData() = default;
 
     inline ccstd::vector<Vertex> &getProbes() { return _probes; }
-    inline void setProbes(const ccstd::vector<Vertex> &probes) { _probes = probes; }
+    inline void setProbes(const ccstd::vector<Vertex> &probes) {
+        _probes = probes;
+        _tetrahedronGrid.clear();
+        _delaunay.reset();
+    }
     inline ccstd::vector<Tetrahedron> &getTetrahedrons() { return _tetrahedrons; }
-    inline void setTetrahedrons(const ccstd::vector<Tetrahedron> &tetrahedrons) { _tetrahedrons = tetrahedrons; }
+    inline void setTetrahedrons(const ccstd::vector<Tetrahedron> &tetrahedrons) {
+        _tetrahedrons = tetrahedrons;
+        _tetrahedronGrid.clear();
+        _delaunay.reset();
+    }
 
     inline bool empty() const { return _probes.empty() || _tetrahedrons.empty(); }
     inline void reset() {
         _probes.clear();
         _tetrahedrons.clear();
+        _tetrahedronGrid.clear();
+        _delaunay.reset();
     }
     void updateProbes(ccstd::vector<Vec3> &points);
     void updateTetrahedrons();
 
+    /**
+     * Update both probes and tetrahedrons, appended or removed probes are applied to the
+     * tetrahedral mesh kept from the last call instead of tetrahedralizing all probes again.
+     */
+    void updateProbesAndTetrahedrons(ccstd::vector<Vec3> &points);
+
     inline bool hasCoefficients() const { return !empty() && !_probes[0].coefficients.empty(); }
     bool getInterpolationSHCoefficients(int32_t tetIndex, const Vec4 &weights, ccstd::vector<Vec3> &coefficients) const;
     int32_t getInterpolationWeights(const Vec3 &position, int32_t tetIndex, Vec4 &weights) const;
 
+    /**
+     * Rebuild the uniform grid which caches a nearby tetrahedron for every cell,
+     * must be called on the main thread before querying from job workers.
+     */
+    void updateTetrahedronGrid();
+    inline bool isTetrahedronGridValid() const { return !_tetrahedronGrid.empty() && _gridTetrahedronCount == _tetrahedrons.size(); }
+    int32_t getGridTetrahedronIndex(const Vec3 &position) const;
+    // use the cached index if the position is still close to the last one, otherwise restart from the grid
+    int32_t getStartTetrahedronIndex(const Vec3 &position, const Vec3 &lastPosition, int32_t tetIndex) const;
+
 private:
     static Vec3 getTriangleBarycentricCoord(const Vec3 &p0, const Vec3 &p1, const Vec3 &p2, const Vec3 &position);
     void getBarycentricCoord(const Vec3 &position, const Tetrahedron &tetrahedron, Vec4 &weights) const;
     void getTetrahedronBarycentricCoord(const Vec3 &position, const Tetrahedron &tetrahedron, Vec4 &weights) const;
     void getOuterCellBarycentricCoord(const Vec3 &position, const Tetrahedron &tetrahedron, Vec4 &weights) const;
 
+    static constexpr uint32_t MAX_GRID_RESOLUTION{32U};
+
+    Vec3 _gridMin;
+    Vec3 _gridCellSize;
+    Vec3 _gridCellSizeInv;
+    uint32_t _gridResolution{0U};
+    size_t _gridTetrahedronCount{0U};
+    ccstd::vector<int32_t> _tetrahedronGrid;
+
+    // incremental mesh of _probes, only alive after updateProbesAndTetrahedrons()
+    std::unique_ptr<Delaunay> _delaunay;
+
 public:
     ccstd::vector<Vertex> _probes;
     ccstd::vector<Tetrahedron> _tetrahedrons;
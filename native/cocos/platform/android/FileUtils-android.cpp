@@ -77,6 +77,8 @@ bool FileUtilsAndroid::init() {
     ccstd::string assetsPath(getObbFilePathJNI());
     if (assetsPath.find("/obb/") != ccstd::string::npos) {
         obbfile = ccnew ZipFile(assetsPath);
+        // assets are loaded from several threads, don't serialize them on the minizip handle
+        obbfile->enableConcurrentReads();
     }
 
     return FileUtils::init();
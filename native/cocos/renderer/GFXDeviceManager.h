@@ -27,6 +27,7 @@
 #include "engine/EngineEvents.h"
 
 #include "gfx-agent/DeviceAgent.h"
+#include "gfx-recorder/DeviceRecorder.h"
 #include "gfx-validator/DeviceValidator.h"
 #include "platform/BasePlatform.h"
 
@@ -77,6 +78,10 @@ public:
 
         Device *device = nullptr;
 
+#if defined(CC_DEDICATED_SERVER)
+        // a dedicated server never renders, only the empty device backs the gfx objects created by scripts
+        Device::isSupportDetachDeviceThread = false;
+#else
 #ifdef CC_USE_NVN
         if (tryCreate<CCNVNDevice>(info, &device)) return device;
 #endif
@@ -112,6 +117,7 @@ public:
 #ifdef CC_EDITOR
         Device::isSupportDetachDeviceThread = false;
 #endif
+#endif // CC_DEDICATED_SERVER
         if (tryCreate<EmptyDevice>(info, &device)) return device;
 
         return nullptr;
@@ -123,7 +129,9 @@ public:
 
     static ccstd::string getGFXName() {
         ccstd::string gfx = "unknown";
-#ifdef CC_USE_NVN
+#if defined(CC_DEDICATED_SERVER)
+        gfx = "Empty";
+#elif defined(CC_USE_NVN)
         gfx = "NVN";
 #elif defined(CC_USE_VULKAN)
         gfx = "Vulkan";
@@ -155,6 +163,10 @@ private:
         }
 #endif
 
+#if CC_USE_GFX_RECORDER
+        device = ccnew gfx::DeviceRecorder(device);
+#endif
+
         if (!device->initialize(info)) {
             CC_SAFE_DELETE(device);
             return false;
@@ -120,7 +120,10 @@ void BufferAgent::update(const void *buffer, uint32_t size) {
     auto *mq{DeviceAgent::getInstance()->getMessageQueue()};
 
     getActorBuffer(this, mq, size, &actorBuffer, &needFreeing);
-    memcpy(actorBuffer, buffer, size);
+    // updating from the staging memory of this frame needs no copy
+    if (actorBuffer != buffer) {
+        memcpy(actorBuffer, buffer, size);
+    }
 
     ENQUEUE_MESSAGE_4(
         mq, BufferUpdate,
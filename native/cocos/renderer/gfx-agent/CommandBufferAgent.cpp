@@ -95,6 +95,7 @@ void CommandBufferAgent::initMessageQueue() {
 }
 
 void CommandBufferAgent::destroyMessageQueue() {
+    _encoder.clear(); // nothing recorded after destruction will ever be submitted
     DeviceAgent::getInstance()->getMessageQueue()->kickAndWait();
 
     CC_SAFE_DELETE(_messageQueue);
@@ -136,7 +137,41 @@ void CommandBufferAgent::doDestroy() {
         });
 }
 
+void CommandBufferAgent::setBytecodeEncoding(bool enabled) {
+    if (_bytecodeEncoding == enabled) return;
+    flushBytecode();
+    _bytecodeEncoding = enabled;
+}
+
+bool CommandBufferAgent::reserveBytecode(uint32_t size) {
+    // immediate mode executes right away, batching would only add latency
+    if (!_bytecodeEncoding || _messageQueue->isImmediateMode()) return false;
+    if (!_encoder.hasRoom(size)) flushBytecode();
+    return true;
+}
+
+void CommandBufferAgent::flushBytecode() {
+    if (_encoder.empty()) return;
+
+    uint32_t size = _encoder.size();
+    uint8_t *data = _messageQueue->allocateAndCopy<uint8_t>(size, _encoder.data());
+    _encoder.clear();
+
+    ENQUEUE_MESSAGE_3(
+        _messageQueue, CommandBufferExecuteBytecode,
+        actor, getActor(),
+        data, data,
+        size, size,
+        {
+            CommandEncoder::decode(actor, data, size);
+        });
+}
+
 void CommandBufferAgent::begin(RenderPass *renderPass, uint32_t subpass, Framebuffer *frameBuffer) {
+    _stateFilter.reset();
+    _stateFilter.resetStats();
+    flushBytecode();
+
     ENQUEUE_MESSAGE_4(
         _messageQueue,
         CommandBufferBegin,
@@ -150,6 +185,7 @@ void CommandBufferAgent::begin(RenderPass *renderPass, uint32_t subpass, Framebu
 }
 
 void CommandBufferAgent::end() {
+    flushBytecode();
     ENQUEUE_MESSAGE_1(
         _messageQueue, CommandBufferEnd,
         actor, getActor(),
@@ -159,6 +195,9 @@ void CommandBufferAgent::end() {
 }
 
 void CommandBufferAgent::beginRenderPass(RenderPass *renderPass, Framebuffer *fbo, const Rect &renderArea, const Color *colors, float depth, uint32_t stencil, CommandBuffer *const *secondaryCBs, uint32_t secondaryCBCount) {
+    flushBytecode();
+    _stateFilter.reset();
+
     auto attachmentCount = utils::toUint(renderPass->getColorAttachments().size());
     Color *actorColors = nullptr;
     if (attachmentCount) {
@@ -191,6 +230,9 @@ void CommandBufferAgent::beginRenderPass(RenderPass *renderPass, Framebuffer *fb
 }
 
 void CommandBufferAgent::endRenderPass() {
+    flushBytecode();
+    _stateFilter.reset();
+
     ENQUEUE_MESSAGE_1(
         _messageQueue, CommandBufferEndRenderPass,
         actor, getActor(),
@@ -200,6 +242,7 @@ void CommandBufferAgent::endRenderPass() {
 }
 
 void CommandBufferAgent::insertMarker(const MarkerInfo &marker) {
+    flushBytecode();
     ENQUEUE_MESSAGE_2(
         _messageQueue, CommandBufferInsertMarker,
         actor, getActor(),
@@ -210,6 +253,7 @@ void CommandBufferAgent::insertMarker(const MarkerInfo &marker) {
 }
 
 void CommandBufferAgent::beginMarker(const MarkerInfo &marker) {
+    flushBytecode();
     ENQUEUE_MESSAGE_2(
         _messageQueue, CommandBufferBeginMarker,
         actor, getActor(),
@@ -220,6 +264,7 @@ void CommandBufferAgent::beginMarker(const MarkerInfo &marker) {
 }
 
 void CommandBufferAgent::endMarker() {
+    flushBytecode();
     ENQUEUE_MESSAGE_1(
         _messageQueue, CommandBufferEndMarker,
         actor, getActor(),
@@ -230,6 +275,8 @@ void CommandBufferAgent::endMarker() {
 
 void CommandBufferAgent::execute(CommandBuffer *const *cmdBuffs, uint32_t count) {
     if (!count) return;
+    flushBytecode();
+    _stateFilter.reset();
 
     auto **actorCmdBuffs = _messageQueue->allocate<CommandBuffer *>(count);
     for (uint32_t i = 0; i < count; ++i) {
@@ -247,6 +294,13 @@ void CommandBufferAgent::execute(CommandBuffer *const *cmdBuffs, uint32_t count)
 }
 
 void CommandBufferAgent::bindPipelineState(PipelineState *pso) {
+    if (_stateFilter.filterPipelineState(pso)) return;
+
+    if (reserveBytecode(CommandEncoder::MAX_FIXED_COMMAND_SIZE)) {
+        _encoder.bindPipelineState(static_cast<PipelineStateAgent *>(pso)->getActor());
+        return;
+    }
+
     ENQUEUE_MESSAGE_2(
         _messageQueue, CommandBufferBindPipelineState,
         actor, getActor(),
@@ -257,6 +311,14 @@ void CommandBufferAgent::bindPipelineState(PipelineState *pso) {
 }
 
 void CommandBufferAgent::bindDescriptorSet(uint32_t set, DescriptorSet *descriptorSet, uint32_t dynamicOffsetCount, const uint32_t *dynamicOffsets) {
+    if (_stateFilter.filterDescriptorSet(set, descriptorSet, dynamicOffsetCount, dynamicOffsets)) return;
+
+    uint32_t encodedSize = CommandEncoder::descriptorSetCommandSize(dynamicOffsetCount);
+    if (encodedSize <= CommandEncoder::CAPACITY && reserveBytecode(encodedSize)) {
+        _encoder.bindDescriptorSet(set, static_cast<DescriptorSetAgent *>(descriptorSet)->getActor(), dynamicOffsetCount, dynamicOffsets);
+        return;
+    }
+
     uint32_t *actorDynamicOffsets = nullptr;
     if (dynamicOffsetCount) {
         actorDynamicOffsets = _messageQueue->allocate<uint32_t>(dynamicOffsetCount);
@@ -276,6 +338,13 @@ void CommandBufferAgent::bindDescriptorSet(uint32_t set, DescriptorSet *descript
 }
 
 void CommandBufferAgent::bindInputAssembler(InputAssembler *ia) {
+    if (_stateFilter.filterInputAssembler(ia)) return;
+
+    if (reserveBytecode(CommandEncoder::MAX_FIXED_COMMAND_SIZE)) {
+        _encoder.bindInputAssembler(static_cast<InputAssemblerAgent *>(ia)->getActor());
+        return;
+    }
+
     ENQUEUE_MESSAGE_2(
         _messageQueue, CommandBufferBindInputAssembler,
         actor, getActor(),
@@ -286,6 +355,13 @@ void CommandBufferAgent::bindInputAssembler(InputAssembler *ia) {
 }
 
 void CommandBufferAgent::setViewport(const Viewport &vp) {
+    if (_stateFilter.filterViewport(vp)) return;
+
+    if (reserveBytecode(CommandEncoder::MAX_FIXED_COMMAND_SIZE)) {
+        _encoder.setViewport(vp);
+        return;
+    }
+
     ENQUEUE_MESSAGE_2(
         _messageQueue, CommandBufferSetViewport,
         actor, getActor(),
@@ -296,6 +372,13 @@ void CommandBufferAgent::setViewport(const Viewport &vp) {
 }
 
 void CommandBufferAgent::setScissor(const Rect &rect) {
+    if (_stateFilter.filterScissor(rect)) return;
+
+    if (reserveBytecode(CommandEncoder::MAX_FIXED_COMMAND_SIZE)) {
+        _encoder.setScissor(rect);
+        return;
+    }
+
     ENQUEUE_MESSAGE_2(
         _messageQueue, CommandBufferSetScissor,
         actor, getActor(),
@@ -306,6 +389,13 @@ void CommandBufferAgent::setScissor(const Rect &rect) {
 }
 
 void CommandBufferAgent::setLineWidth(float width) {
+    if (_stateFilter.filterLineWidth(width)) return;
+
+    if (reserveBytecode(CommandEncoder::MAX_FIXED_COMMAND_SIZE)) {
+        _encoder.setLineWidth(width);
+        return;
+    }
+
     ENQUEUE_MESSAGE_2(
         _messageQueue, CommandBufferSetLineWidth,
         actor, getActor(),
@@ -316,6 +406,13 @@ void CommandBufferAgent::setLineWidth(float width) {
 }
 
 void CommandBufferAgent::setDepthBias(float constant, float clamp, float slope) {
+    if (_stateFilter.filterDepthBias(constant, clamp, slope)) return;
+
+    if (reserveBytecode(CommandEncoder::MAX_FIXED_COMMAND_SIZE)) {
+        _encoder.setDepthBias(constant, clamp, slope);
+        return;
+    }
+
     ENQUEUE_MESSAGE_4(
         _messageQueue, CommandBufferSetDepthBias,
         actor, getActor(),
@@ -328,6 +425,13 @@ void CommandBufferAgent::setDepthBias(float constant, float clamp, float slope)
 }
 
 void CommandBufferAgent::setBlendConstants(const Color &constants) {
+    if (_stateFilter.filterBlendConstants(constants)) return;
+
+    if (reserveBytecode(CommandEncoder::MAX_FIXED_COMMAND_SIZE)) {
+        _encoder.setBlendConstants(constants);
+        return;
+    }
+
     ENQUEUE_MESSAGE_2(
         _messageQueue, CommandBufferSetBlendConstants,
         actor, getActor(),
@@ -338,6 +442,13 @@ void CommandBufferAgent::setBlendConstants(const Color &constants) {
 }
 
 void CommandBufferAgent::setDepthBound(float minBounds, float maxBounds) {
+    if (_stateFilter.filterDepthBound(minBounds, maxBounds)) return;
+
+    if (reserveBytecode(CommandEncoder::MAX_FIXED_COMMAND_SIZE)) {
+        _encoder.setDepthBound(minBounds, maxBounds);
+        return;
+    }
+
     ENQUEUE_MESSAGE_3(
         _messageQueue, CommandBufferSetDepthBound,
         actor, getActor(),
@@ -349,6 +460,13 @@ void CommandBufferAgent::setDepthBound(float minBounds, float maxBounds) {
 }
 
 void CommandBufferAgent::setStencilWriteMask(StencilFace face, uint32_t mask) {
+    if (_stateFilter.filterStencilWriteMask(face, mask)) return;
+
+    if (reserveBytecode(CommandEncoder::MAX_FIXED_COMMAND_SIZE)) {
+        _encoder.setStencilWriteMask(face, mask);
+        return;
+    }
+
     ENQUEUE_MESSAGE_3(
         _messageQueue, CommandBufferSetStencilWriteMask,
         actor, getActor(),
@@ -360,6 +478,13 @@ void CommandBufferAgent::setStencilWriteMask(StencilFace face, uint32_t mask) {
 }
 
 void CommandBufferAgent::setStencilCompareMask(StencilFace face, uint32_t ref, uint32_t mask) {
+    if (_stateFilter.filterStencilCompareMask(face, ref, mask)) return;
+
+    if (reserveBytecode(CommandEncoder::MAX_FIXED_COMMAND_SIZE)) {
+        _encoder.setStencilCompareMask(face, ref, mask);
+        return;
+    }
+
     ENQUEUE_MESSAGE_4(
         _messageQueue, CommandBufferSetStencilCompareMask,
         actor, getActor(),
@@ -372,6 +497,9 @@ void CommandBufferAgent::setStencilCompareMask(StencilFace face, uint32_t ref, u
 }
 
 void CommandBufferAgent::nextSubpass() {
+    flushBytecode();
+    _stateFilter.reset();
+
     ENQUEUE_MESSAGE_1(
         _messageQueue, CommandBufferNextSubpass,
         actor, getActor(),
@@ -381,6 +509,11 @@ void CommandBufferAgent::nextSubpass() {
 }
 
 void CommandBufferAgent::draw(const DrawInfo &info) {
+    if (reserveBytecode(CommandEncoder::MAX_FIXED_COMMAND_SIZE)) {
+        _encoder.draw(info);
+        return;
+    }
+
     ENQUEUE_MESSAGE_2(
         _messageQueue, CommandBufferDraw,
         actor, getActor(),
@@ -391,13 +524,17 @@ void CommandBufferAgent::draw(const DrawInfo &info) {
 }
 
 void CommandBufferAgent::updateBuffer(Buffer *buff, const void *data, uint32_t size) {
+    flushBytecode();
     auto *bufferAgent = static_cast<BufferAgent *>(buff);
 
     uint8_t *actorBuffer{nullptr};
     bool needFreeing{false};
 
     BufferAgent::getActorBuffer(bufferAgent, _messageQueue, size, &actorBuffer, &needFreeing);
-    memcpy(actorBuffer, data, size);
+    // updating from the staging memory of this frame needs no copy
+    if (actorBuffer != data) {
+        memcpy(actorBuffer, data, size);
+    }
 
     ENQUEUE_MESSAGE_5(
         _messageQueue, CommandBufferUpdateBuffer,
@@ -413,6 +550,7 @@ void CommandBufferAgent::updateBuffer(Buffer *buff, const void *data, uint32_t s
 }
 
 void CommandBufferAgent::resolveTexture(Texture *srcTexture, Texture *dstTexture, const TextureCopy *regions, uint32_t count) {
+    flushBytecode();
     Texture *actorSrcTexture = nullptr;
     Texture *actorDstTexture = nullptr;
     if (srcTexture) actorSrcTexture = static_cast<TextureAgent *>(srcTexture)->getActor();
@@ -434,6 +572,7 @@ void CommandBufferAgent::resolveTexture(Texture *srcTexture, Texture *dstTexture
 }
 
 void CommandBufferAgent::copyTexture(Texture *srcTexture, Texture *dstTexture, const TextureCopy *regions, uint32_t count) {
+    flushBytecode();
     Texture *actorSrcTexture = nullptr;
     Texture *actorDstTexture = nullptr;
     if (srcTexture) actorSrcTexture = static_cast<TextureAgent *>(srcTexture)->getActor();
@@ -455,6 +594,7 @@ void CommandBufferAgent::copyTexture(Texture *srcTexture, Texture *dstTexture, c
 }
 
 void CommandBufferAgent::blitTexture(Texture *srcTexture, Texture *dstTexture, const TextureBlit *regions, uint32_t count, Filter filter) {
+    flushBytecode();
     Texture *actorSrcTexture = nullptr;
     Texture *actorDstTexture = nullptr;
     if (srcTexture) actorSrcTexture = static_cast<TextureAgent *>(srcTexture)->getActor();
@@ -477,6 +617,7 @@ void CommandBufferAgent::blitTexture(Texture *srcTexture, Texture *dstTexture, c
 }
 
 void CommandBufferAgent::dispatch(const DispatchInfo &info) {
+    flushBytecode();
     DispatchInfo actorInfo = info;
     if (info.indirectBuffer) actorInfo.indirectBuffer = static_cast<BufferAgent *>(info.indirectBuffer)->getActor();
 
@@ -490,6 +631,7 @@ void CommandBufferAgent::dispatch(const DispatchInfo &info) {
 }
 
 void CommandBufferAgent::pipelineBarrier(const GeneralBarrier *barrier, const BufferBarrier *const *bufferBarriers, const Buffer *const *buffers, uint32_t bufferBarrierCount, const TextureBarrier *const *textureBarriers, const Texture *const *textures, uint32_t textureBarrierCount) {
+    flushBytecode();
     TextureBarrier **actorTextureBarriers = nullptr;
     Texture **actorTextures = nullptr;
 
@@ -532,6 +674,7 @@ void CommandBufferAgent::pipelineBarrier(const GeneralBarrier *barrier, const Bu
 }
 
 void CommandBufferAgent::beginQuery(QueryPool *queryPool, uint32_t id) {
+    flushBytecode();
     auto *actorQueryPool = static_cast<QueryPoolAgent *>(queryPool)->getActor();
 
     ENQUEUE_MESSAGE_3(
@@ -545,6 +688,7 @@ void CommandBufferAgent::beginQuery(QueryPool *queryPool, uint32_t id) {
 }
 
 void CommandBufferAgent::endQuery(QueryPool *queryPool, uint32_t id) {
+    flushBytecode();
     auto *actorQueryPool = static_cast<QueryPoolAgent *>(queryPool)->getActor();
 
     ENQUEUE_MESSAGE_3(
@@ -558,6 +702,7 @@ void CommandBufferAgent::endQuery(QueryPool *queryPool, uint32_t id) {
 }
 
 void CommandBufferAgent::resetQueryPool(QueryPool *queryPool) {
+    flushBytecode();
     auto *actorQueryPool = static_cast<QueryPoolAgent *>(queryPool)->getActor();
 
     ENQUEUE_MESSAGE_2(
@@ -570,6 +715,7 @@ void CommandBufferAgent::resetQueryPool(QueryPool *queryPool) {
 }
 
 void CommandBufferAgent::completeQueryPool(QueryPool *queryPool) {
+    flushBytecode();
     auto *actorQueryPool = static_cast<QueryPoolAgent *>(queryPool)->getActor();
 
     ENQUEUE_MESSAGE_2(
@@ -582,6 +728,9 @@ void CommandBufferAgent::completeQueryPool(QueryPool *queryPool) {
 }
 
 void CommandBufferAgent::customCommand(CustomCommand &&cmd) {
+    flushBytecode();
+    _stateFilter.reset();
+
     ENQUEUE_MESSAGE_2(
         _messageQueue, CommandBufferCompleteQueryPool,
         actor, getActor(),
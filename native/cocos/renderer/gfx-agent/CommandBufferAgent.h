@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include "CommandEncoder.h"
 #include "base/Agent.h"
 #include "gfx-base/GFXCommandBuffer.h"
 
@@ -77,9 +78,14 @@ public:
     uint32_t getNumDrawCalls() const override { return _actor->getNumDrawCalls(); }
     uint32_t getNumInstances() const override { return _actor->getNumInstances(); }
     uint32_t getNumTris() const override { return _actor->getNumTris(); }
+    uint32_t getNumFilteredCalls() const override { return _stateFilter.getNumFilteredCalls() + _actor->getNumFilteredCalls(); }
 
     inline MessageQueue *getMessageQueue() { return _messageQueue; }
 
+    // switch between the dense bytecode encoding and one message per command
+    void setBytecodeEncoding(bool enabled);
+    inline bool isBytecodeEncoding() const { return _bytecodeEncoding; }
+
 protected:
     friend class DeviceAgent;
 
@@ -92,6 +98,11 @@ protected:
     void initMessageQueue();
     void destroyMessageQueue();
     MessageQueue *_messageQueue = nullptr;
+
+    bool reserveBytecode(uint32_t size);
+    void flushBytecode();
+    CommandEncoder _encoder;
+    bool _bytecodeEncoding{true};
 };
 
 } // namespace gfx
@@ -0,0 +1,211 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#include "CommandEncoder.h"
+#include "gfx-base/GFXCommandBuffer.h"
+
+namespace cc {
+namespace gfx {
+
+namespace {
+
+class Reader final {
+public:
+    Reader(const uint8_t *data, uint32_t size)
+    : _begin(data), _cursor(data), _end(data + size) {}
+
+    inline bool finished() const { return _cursor >= _end; }
+
+    template <typename T>
+    inline T read() {
+        T value;
+        memcpy(&value, _cursor, sizeof(T));
+        _cursor += sizeof(T);
+        return value;
+    }
+
+    // in-place view of an inline array, valid as long as the encoded block lives
+    inline const uint32_t *readOffsets(uint32_t count) {
+        _cursor = _begin + ((_cursor - _begin + 3) & ~3);
+        const auto *offsets = reinterpret_cast<const uint32_t *>(_cursor);
+        _cursor += count * sizeof(uint32_t);
+        return offsets;
+    }
+
+private:
+    const uint8_t *_begin{nullptr};
+    const uint8_t *_cursor{nullptr};
+    const uint8_t *_end{nullptr};
+};
+
+} // namespace
+
+CommandEncoder::CommandEncoder() {
+    _data.resize(CAPACITY);
+}
+
+void CommandEncoder::bindPipelineState(PipelineState *pso) {
+    writeOpcode(Opcode::BIND_PIPELINE_STATE);
+    write(pso);
+}
+
+void CommandEncoder::bindDescriptorSet(uint32_t set, DescriptorSet *descriptorSet, uint32_t dynamicOffsetCount, const uint32_t *dynamicOffsets) {
+    CC_ASSERT(hasRoom(descriptorSetCommandSize(dynamicOffsetCount)));
+    writeOpcode(Opcode::BIND_DESCRIPTOR_SET);
+    write(descriptorSet);
+    write(set);
+    write(dynamicOffsetCount);
+    if (dynamicOffsetCount) {
+        // the encoded block is copied to 16-byte aligned storage, keep the array word-aligned
+        _size = (_size + 3U) & ~3U;
+        memcpy(_data.data() + _size, dynamicOffsets, dynamicOffsetCount * sizeof(uint32_t));
+        _size += dynamicOffsetCount * sizeof(uint32_t);
+    }
+}
+
+void CommandEncoder::bindInputAssembler(InputAssembler *ia) {
+    writeOpcode(Opcode::BIND_INPUT_ASSEMBLER);
+    write(ia);
+}
+
+void CommandEncoder::setViewport(const Viewport &vp) {
+    writeOpcode(Opcode::SET_VIEWPORT);
+    write(vp);
+}
+
+void CommandEncoder::setScissor(const Rect &rect) {
+    writeOpcode(Opcode::SET_SCISSOR);
+    write(rect);
+}
+
+void CommandEncoder::setLineWidth(float width) {
+    writeOpcode(Opcode::SET_LINE_WIDTH);
+    write(width);
+}
+
+void CommandEncoder::setDepthBias(float constant, float clamp, float slope) {
+    writeOpcode(Opcode::SET_DEPTH_BIAS);
+    write(constant);
+    write(clamp);
+    write(slope);
+}
+
+void CommandEncoder::setBlendConstants(const Color &constants) {
+    writeOpcode(Opcode::SET_BLEND_CONSTANTS);
+    write(constants);
+}
+
+void CommandEncoder::setDepthBound(float minBounds, float maxBounds) {
+    writeOpcode(Opcode::SET_DEPTH_BOUND);
+    write(minBounds);
+    write(maxBounds);
+}
+
+void CommandEncoder::setStencilWriteMask(StencilFace face, uint32_t mask) {
+    writeOpcode(Opcode::SET_STENCIL_WRITE_MASK);
+    write(face);
+    write(mask);
+}
+
+void CommandEncoder::setStencilCompareMask(StencilFace face, uint32_t ref, uint32_t mask) {
+    writeOpcode(Opcode::SET_STENCIL_COMPARE_MASK);
+    write(face);
+    write(ref);
+    write(mask);
+}
+
+void CommandEncoder::draw(const DrawInfo &info) {
+    writeOpcode(Opcode::DRAW);
+    write(info);
+}
+
+uint32_t CommandEncoder::decode(CommandBuffer *actor, const uint8_t *data, uint32_t size) {
+    Reader reader(data, size);
+    uint32_t count = 0U;
+
+    while (!reader.finished()) {
+        switch (reader.read<Opcode>()) {
+            case Opcode::BIND_PIPELINE_STATE: {
+                actor->bindPipelineState(reader.read<PipelineState *>());
+            } break;
+            case Opcode::BIND_DESCRIPTOR_SET: {
+                auto *descriptorSet = reader.read<DescriptorSet *>();
+                auto set = reader.read<uint32_t>();
+                auto dynamicOffsetCount = reader.read<uint32_t>();
+                const uint32_t *dynamicOffsets = dynamicOffsetCount ? reader.readOffsets(dynamicOffsetCount) : nullptr;
+                actor->bindDescriptorSet(set, descriptorSet, dynamicOffsetCount, dynamicOffsets);
+            } break;
+            case Opcode::BIND_INPUT_ASSEMBLER: {
+                actor->bindInputAssembler(reader.read<InputAssembler *>());
+            } break;
+            case Opcode::SET_VIEWPORT: {
+                actor->setViewport(reader.read<Viewport>());
+            } break;
+            case Opcode::SET_SCISSOR: {
+                actor->setScissor(reader.read<Rect>());
+            } break;
+            case Opcode::SET_LINE_WIDTH: {
+                actor->setLineWidth(reader.read<float>());
+            } break;
+            case Opcode::SET_DEPTH_BIAS: {
+                auto constant = reader.read<float>();
+                auto clamp = reader.read<float>();
+                auto slope = reader.read<float>();
+                actor->setDepthBias(constant, clamp, slope);
+            } break;
+            case Opcode::SET_BLEND_CONSTANTS: {
+                actor->setBlendConstants(reader.read<Color>());
+            } break;
+            case Opcode::SET_DEPTH_BOUND: {
+                auto minBounds = reader.read<float>();
+                auto maxBounds = reader.read<float>();
+                actor->setDepthBound(minBounds, maxBounds);
+            } break;
+            case Opcode::SET_STENCIL_WRITE_MASK: {
+                auto face = reader.read<StencilFace>();
+                auto mask = reader.read<uint32_t>();
+                actor->setStencilWriteMask(face, mask);
+            } break;
+            case Opcode::SET_STENCIL_COMPARE_MASK: {
+                auto face = reader.read<StencilFace>();
+                auto ref = reader.read<uint32_t>();
+                auto mask = reader.read<uint32_t>();
+                actor->setStencilCompareMask(face, ref, mask);
+            } break;
+            case Opcode::DRAW: {
+                actor->draw(reader.read<DrawInfo>());
+            } break;
+            default:
+                CC_ABORT(); // corrupted stream
+                return count;
+        }
+        ++count;
+    }
+
+    return count;
+}
+
+} // namespace gfx
+} // namespace cc
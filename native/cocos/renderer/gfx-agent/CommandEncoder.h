@@ -0,0 +1,122 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#pragma once
+
+#include <cstring>
+#include <type_traits>
+#include "gfx-base/GFXDef-common.h"
+
+namespace cc {
+namespace gfx {
+
+class CommandBuffer;
+class DescriptorSet;
+class InputAssembler;
+class PipelineState;
+
+/**
+ * Dense opcode + payload encoding for the hot, fixed-size command buffer calls.
+ * The producer writes actor handles and plain values back to back into a small
+ * staging block, which is then shipped as a single message and decoded by
+ * a switch on the consuming thread.
+ */
+class CC_DLL CommandEncoder final {
+public:
+    enum class Opcode : uint8_t {
+        BIND_PIPELINE_STATE,
+        BIND_DESCRIPTOR_SET,
+        BIND_INPUT_ASSEMBLER,
+        SET_VIEWPORT,
+        SET_SCISSOR,
+        SET_LINE_WIDTH,
+        SET_DEPTH_BIAS,
+        SET_BLEND_CONSTANTS,
+        SET_DEPTH_BOUND,
+        SET_STENCIL_WRITE_MASK,
+        SET_STENCIL_COMPARE_MASK,
+        DRAW,
+        COUNT,
+    };
+
+    // keep the staging block well below the message queue chunk size
+    static constexpr uint32_t CAPACITY = 16 * 1024;
+    // upper bound of every fixed-size command, opcode included
+    static constexpr uint32_t MAX_FIXED_COMMAND_SIZE = 64;
+
+    CommandEncoder();
+
+    inline bool empty() const { return _size == 0; }
+    inline uint32_t size() const { return _size; }
+    inline uint32_t getCommandCount() const { return _commandCount; }
+    inline const uint8_t *data() const { return _data.data(); }
+    inline bool hasRoom(uint32_t bytes) const { return _size + bytes <= CAPACITY; }
+    inline void clear() {
+        _size = 0;
+        _commandCount = 0;
+    }
+
+    static inline uint32_t descriptorSetCommandSize(uint32_t dynamicOffsetCount) {
+        return MAX_FIXED_COMMAND_SIZE + dynamicOffsetCount * sizeof(uint32_t);
+    }
+
+    // all handles are expected to be actors already
+    void bindPipelineState(PipelineState *pso);
+    void bindDescriptorSet(uint32_t set, DescriptorSet *descriptorSet, uint32_t dynamicOffsetCount, const uint32_t *dynamicOffsets);
+    void bindInputAssembler(InputAssembler *ia);
+    void setViewport(const Viewport &vp);
+    void setScissor(const Rect &rect);
+    void setLineWidth(float width);
+    void setDepthBias(float constant, float clamp, float slope);
+    void setBlendConstants(const Color &constants);
+    void setDepthBound(float minBounds, float maxBounds);
+    void setStencilWriteMask(StencilFace face, uint32_t mask);
+    void setStencilCompareMask(StencilFace face, uint32_t ref, uint32_t mask);
+    void draw(const DrawInfo &info);
+
+    // replays an encoded block on the actor, returns the number of decoded commands
+    static uint32_t decode(CommandBuffer *actor, const uint8_t *data, uint32_t size);
+
+private:
+    template <typename T>
+    inline void write(const T &value) {
+        static_assert(std::is_trivially_copyable<T>::value, "only plain values can be encoded");
+        memcpy(_data.data() + _size, &value, sizeof(T));
+        _size += sizeof(T);
+    }
+
+    inline void writeOpcode(Opcode op) {
+        CC_ASSERT(hasRoom(MAX_FIXED_COMMAND_SIZE));
+        write(op);
+        ++_commandCount;
+    }
+
+    ccstd::vector<uint8_t> _data;
+    uint32_t _size{0};
+    uint32_t _commandCount{0};
+};
+
+} // namespace gfx
+} // namespace cc
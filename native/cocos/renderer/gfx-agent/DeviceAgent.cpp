@@ -368,6 +368,7 @@ void DeviceAgent::copyBuffersToTexture(const uint8_t *const *buffers, Texture *d
 }
 
 void CommandBufferAgent::copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint32_t count) {
+    flushBytecode();
     doBufferTextureCopy(buffers, texture, regions, count, _messageQueue, _actor);
 }
 
@@ -395,6 +396,7 @@ void DeviceAgent::flushCommands(CommandBuffer *const *cmdBuffs, uint32_t count)
     for (uint32_t i = 0; i < count; ++i) {
         agentCmdBuffs[i] = static_cast<CommandBufferAgent *const>(cmdBuffs[i]);
         MessageQueue::freeChunksInFreeQueue(agentCmdBuffs[i]->_messageQueue);
+        agentCmdBuffs[i]->flushBytecode();
         agentCmdBuffs[i]->_messageQueue->finishWriting();
     }
 
@@ -44,6 +44,8 @@ public:
     static constexpr uint32_t MAX_CPU_FRAME_AHEAD = 1;
     static constexpr uint32_t MAX_FRAME_INDEX = MAX_CPU_FRAME_AHEAD + 1;
 
+    // Created by DeviceManager, or directly by tests wrapping an EmptyDevice. Takes ownership of the device.
+    explicit DeviceAgent(Device *device);
     ~DeviceAgent() override;
 
     using Device::copyBuffersToTexture;
@@ -96,6 +98,8 @@ public:
     uint32_t getNumDrawCalls() const override { return _actor->getNumDrawCalls(); }
     uint32_t getNumInstances() const override { return _actor->getNumInstances(); }
     uint32_t getNumTris() const override { return _actor->getNumTris(); }
+    // deferred command buffers only write to their own message queues
+    bool isMultithreadedCommandRecording() const override { return _multithreaded || _actor->isMultithreadedCommandRecording(); }
 
     uint32_t getCurrentIndex() const { return _currentIndex; }
     void setMultithreaded(bool multithreaded);
@@ -113,8 +117,6 @@ protected:
     friend class DeviceManager;
     friend class CommandBufferAgent;
 
-    explicit DeviceAgent(Device *device);
-
     bool doInit(const DeviceInfo &info) override;
     void doDestroy() override;
 
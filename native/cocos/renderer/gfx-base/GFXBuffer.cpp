@@ -75,6 +75,10 @@ void Buffer::resize(uint32_t size) {
     if (size != _size) {
         uint32_t count = size / _stride;
         doResize(size, count);
+        if (_data) {
+            // staging memory owned here follows the size, its contents are dropped like the buffer's
+            _data = std::make_unique<uint8_t[]>(size);
+        }
 
         _size = size;
         _count = count;
@@ -64,6 +64,8 @@ public:
     inline bool isBufferView() const { return _isBufferView; }
 
 protected:
+    friend class FrameRingBuffer;
+
     virtual void doInit(const BufferInfo &info) = 0;
     virtual void doInit(const BufferViewInfo &info) = 0;
     virtual void doResize(uint32_t size, uint32_t count) = 0;
@@ -27,6 +27,7 @@
 #include "GFXBuffer.h"
 #include "GFXInputAssembler.h"
 #include "GFXObject.h"
+#include "GFXStateFilter.h"
 #include "base/RefCounted.h"
 #include "base/Utils.h"
 #include "base/std/container/vector.h"
@@ -115,6 +116,8 @@ public:
     virtual uint32_t getNumDrawCalls() const { return _numDrawCalls; }
     virtual uint32_t getNumInstances() const { return _numInstances; }
     virtual uint32_t getNumTris() const { return _numTriangles; }
+    // binds and dynamic state sets dropped as redundant since `begin`
+    virtual uint32_t getNumFilteredCalls() const { return _stateFilter.getNumFilteredCalls(); }
 
 protected:
     virtual void doInit(const CommandBufferInfo &info) = 0;
@@ -126,6 +129,9 @@ protected:
     uint32_t _numDrawCalls = 0;
     uint32_t _numInstances = 0;
     uint32_t _numTriangles = 0;
+
+    // only used by the layers that opt in, see `StateFilter`
+    StateFilter _stateFilter;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -76,6 +76,7 @@ void DescriptorSet::bindTexture(uint32_t binding, Texture *texture, uint32_t ind
         _textures[descriptorIndex].id = newId;
         _textures[descriptorIndex].flags = flags;
         _isDirty = true;
+        ++_textureVersion;
     }
 }
 
@@ -87,6 +88,7 @@ void DescriptorSet::bindBuffer(uint32_t binding, Buffer *buffer, uint32_t index,
         _buffers[descriptorIndex].id = newId;
         _buffers[descriptorIndex].flags = flags;
         _isDirty = true;
+        ++_bufferVersion;
     }
 }
 
@@ -97,6 +99,7 @@ void DescriptorSet::bindSampler(uint32_t binding, Sampler *sampler, uint32_t ind
         _samplers[descriptorIndex].ptr = sampler;
         _samplers[descriptorIndex].id = newId;
         _isDirty = true;
+        ++_samplerVersion;
     }
 }
 
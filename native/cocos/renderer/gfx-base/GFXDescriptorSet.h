@@ -58,6 +58,11 @@ public:
     Sampler *getSampler(uint32_t binding, uint32_t index) const;
 
     inline const DescriptorSetLayout *getLayout() const { return _layout; }
+    // increased whenever a different texture is bound, lets users cache state derived from the bound textures
+    inline uint32_t getTextureVersion() const { return _textureVersion; }
+    // same for buffers and samplers
+    inline uint32_t getBufferVersion() const { return _bufferVersion; }
+    inline uint32_t getSamplerVersion() const { return _samplerVersion; }
 
     inline void bindBuffer(uint32_t binding, Buffer *buffer) { bindBuffer(binding, buffer, 0U); }
     inline void bindTexture(uint32_t binding, Texture *texture) { bindTexture(binding, texture, 0U); }
@@ -83,6 +88,9 @@ protected:
     ccstd::vector<ObjectWithId<Sampler>> _samplers;
 
     bool _isDirty = false;
+    uint32_t _textureVersion = 0;
+    uint32_t _bufferVersion = 0;
+    uint32_t _samplerVersion = 0;
 };
 
 } // namespace gfx
@@ -70,6 +70,8 @@ public:
     virtual uint32_t getNumDrawCalls() const { return _numDrawCalls; }
     virtual uint32_t getNumInstances() const { return _numInstances; }
     virtual uint32_t getNumTris() const { return _numTriangles; }
+    // whether different command buffers can be recorded on different threads at the same time.
+    virtual bool isMultithreadedCommandRecording() const { return _multithreadedCommandRecording; }
 
     inline CommandBuffer *createCommandBuffer(const CommandBufferInfo &info);
     inline Queue *createQueue(const QueueInfo &info);
@@ -135,6 +137,7 @@ protected:
 
     friend class DeviceAgent;
     friend class DeviceValidator;
+    friend class DeviceRecorder;
     friend class DeviceManager;
 
     Device();
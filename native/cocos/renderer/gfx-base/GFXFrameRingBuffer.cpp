@@ -0,0 +1,182 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "GFXFrameRingBuffer.h"
+#include <algorithm>
+#include <cstring>
+#include "GFXBuffer.h"
+#include "GFXCommandBuffer.h"
+#include "GFXDevice.h"
+#include "base/Utils.h"
+
+namespace cc {
+namespace gfx {
+
+namespace {
+constexpr uint32_t DEFAULT_ALIGNMENT{16};
+
+uint32_t nextCapacity(uint32_t capacity, uint32_t required) {
+    while (capacity < required) {
+        capacity *= 2;
+    }
+    return capacity;
+}
+} // namespace
+
+FrameRingBuffer::FrameRingBuffer(Device *device, const FrameRingBufferInfo &info)
+: _device(device),
+  _usage(info.usage) {
+    _alignment = info.alignment;
+    if (_alignment == 0) {
+        _alignment = hasFlag(info.usage, BufferUsageBit::UNIFORM) ? device->getCapabilities().uboOffsetAlignment : DEFAULT_ALIGNMENT;
+    }
+    _alignment = std::max(_alignment, 4U);
+    _capacity = utils::alignTo(std::max(info.capacity, _alignment), _alignment);
+
+    const uint32_t frameCount = std::max(info.frameCount, 1U);
+    _buffers.resize(frameCount);
+    _bufferSizes.resize(frameCount, _capacity);
+    _bufferViews.resize(frameCount);
+    for (auto &buffer : _buffers) {
+        // staging writes: the agent hands its per-frame staging memory to the render thread without a copy
+        buffer = device->createBuffer({_usage, MemoryUsageBit::DEVICE | MemoryUsageBit::HOST, _capacity, _alignment, BufferFlagBit::ENABLE_STAGING_WRITE});
+    }
+    _staging = _buffers[_frameIndex]->getStagingAddress();
+    _stats.capacity = _capacity;
+}
+
+FrameRingBuffer::~FrameRingBuffer() {
+    for (auto &views : _bufferViews) {
+        for (auto &view : views) {
+            view->destroy();
+        }
+    }
+    for (auto &buffer : _buffers) {
+        buffer->destroy();
+    }
+}
+
+void FrameRingBuffer::beginFrame() {
+    if (!_flushed) {
+        // the previous frame was not flushed, its allocations are discarded
+        _stats.lastFrameBytes = 0;
+        _stats.lastFrameAllocations = 0;
+    }
+    _flushed = false;
+    _flushedBytes = 0;
+
+    const auto overflow = _overflowBytes.exchange(0, std::memory_order_relaxed);
+    const auto failed = _failedAllocations.exchange(0, std::memory_order_relaxed);
+    _stats.failedAllocations += failed;
+    if (overflow > 0) {
+        // grow for the demand of the overflowed frame, allocations of this frame haven't started yet
+        const auto required = std::min(_head.load(std::memory_order_relaxed), _capacity) + overflow;
+        _capacity = nextCapacity(_capacity, required);
+        _stats.capacity = _capacity;
+        ++_stats.resizes;
+    }
+
+    _frameIndex = (_frameIndex + 1) % getFrameCount();
+    if (_frameIndex == 0) {
+        ++_stats.ringWraps;
+    }
+    // the buffer of this frame is no longer read by the GPU, it can be grown safely
+    if (_bufferSizes[_frameIndex] < _capacity) {
+        for (auto &view : _bufferViews[_frameIndex]) {
+            view->destroy();
+        }
+        _bufferViews[_frameIndex].clear();
+        _buffers[_frameIndex]->resize(_capacity);
+        _bufferSizes[_frameIndex] = _capacity;
+    }
+    // the staging memory may move with the frame index of the backend, fetch it once per frame
+    _staging = _buffers[_frameIndex]->getStagingAddress();
+
+    _head.store(0, std::memory_order_relaxed);
+    _allocations.store(0, std::memory_order_relaxed);
+}
+
+FrameRingAllocation FrameRingBuffer::allocate(uint32_t size) {
+    const uint32_t alignedSize = utils::alignTo(size, _alignment);
+    uint32_t head = _head.load(std::memory_order_relaxed);
+    do {
+        if (head + alignedSize > _capacity) {
+            _failedAllocations.fetch_add(1, std::memory_order_relaxed);
+            _overflowBytes.fetch_add(alignedSize, std::memory_order_relaxed);
+            return {};
+        }
+    } while (!_head.compare_exchange_weak(head, head + alignedSize, std::memory_order_relaxed));
+
+    _allocations.fetch_add(1, std::memory_order_relaxed);
+    return {_staging + head, head, size};
+}
+
+FrameRingAllocation FrameRingBuffer::allocate(const void *data, uint32_t size) {
+    auto allocation = allocate(size);
+    if (allocation.isValid()) {
+        memcpy(allocation.data, data, size);
+    }
+    return allocation;
+}
+
+void FrameRingBuffer::flush() {
+    const uint32_t used = getUsedBytes();
+    if (used > _flushedBytes) {
+        // the buffer can only be updated from its start, the source is its own staging memory
+        _buffers[_frameIndex]->update(_staging, used);
+        _flushedBytes = used;
+    }
+    updateFlushStats(used);
+}
+
+void FrameRingBuffer::flush(CommandBuffer *cmdBuffer) {
+    const uint32_t used = getUsedBytes();
+    if (used > _flushedBytes) {
+        // the data is copied when the command is recorded, later allocations are uploaded by the next flush
+        cmdBuffer->updateBuffer(_buffers[_frameIndex], _staging, used);
+        _flushedBytes = used;
+    }
+    updateFlushStats(used);
+}
+
+void FrameRingBuffer::updateFlushStats(uint32_t used) {
+    _flushed = true;
+    _stats.lastFrameBytes = used;
+    _stats.lastFrameAllocations = _allocations.load(std::memory_order_relaxed);
+    _stats.peakFrameBytes = std::max(_stats.peakFrameBytes, used);
+}
+
+Buffer *FrameRingBuffer::getBufferView(uint32_t range) {
+    auto &views = _bufferViews[_frameIndex];
+    for (const auto &view : views) {
+        if (view->getSize() == range) {
+            return view;
+        }
+    }
+    views.emplace_back(_device->createBuffer({_buffers[_frameIndex], 0, range}));
+    return views.back();
+}
+
+} // namespace gfx
+} // namespace cc
@@ -0,0 +1,151 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include "GFXDef.h"
+#include "base/Ptr.h"
+#include "base/RefCounted.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+namespace gfx {
+
+class Device;
+class Buffer;
+class CommandBuffer;
+
+struct FrameRingBufferInfo {
+    BufferUsage usage{BufferUsageBit::UNIFORM | BufferUsageBit::TRANSFER_DST};
+    // Initial size of the buffer of each frame, grown when a frame overflows.
+    uint32_t capacity{64 * 1024};
+    // 0 uses uboOffsetAlignment of the device for uniform buffers, 16 otherwise.
+    uint32_t alignment{0};
+    // Buffers in the ring, at least the frames the GPU may still be reading plus the one being written.
+    uint32_t frameCount{3};
+};
+
+struct FrameRingAllocation {
+    // Points into the staging memory of the frame buffer, writes must be done before the ring is flushed.
+    uint8_t *data{nullptr};
+    uint32_t offset{0};
+    uint32_t size{0};
+
+    inline bool isValid() const { return data != nullptr; }
+};
+
+struct FrameRingBufferStats {
+    uint32_t lastFrameBytes{0};
+    uint32_t lastFrameAllocations{0};
+    uint32_t peakFrameBytes{0};
+    uint32_t capacity{0};
+    // allocations which didn't fit in the frame, the capacity is grown for the next frames
+    uint64_t failedAllocations{0};
+    uint64_t ringWraps{0};
+    uint64_t resizes{0};
+};
+
+/**
+ * @en Sub-allocator of dynamic buffers which change every frame, such as local UBOs and instance data.
+ * There is one buffer per frame in flight, allocations bump an atomic offset in it and are bound with dynamic offsets.
+ * The buffers are created with ENABLE_STAGING_WRITE and allocations point straight into their staging memory,
+ * allocate() and the writes to the allocations are thread safe, flush() hands the written range to the backend.
+ * @zh 每帧变化的动态缓冲（如局部 UBO、实例数据）的子分配器。每个在途帧一个缓冲，分配通过原子偏移递增完成，并以动态偏移绑定。
+ * 缓冲以 ENABLE_STAGING_WRITE 创建，分配结果直接指向其暂存内存；allocate() 及对分配结果的写入是线程安全的，flush() 将写入的范围交给后端。
+ */
+class CC_DLL FrameRingBuffer final : public RefCounted {
+public:
+    FrameRingBuffer(Device *device, const FrameRingBufferInfo &info);
+    ~FrameRingBuffer() override;
+
+    /**
+     * @en Moves to the buffer of the next frame. The buffers of the frames in flight are not touched.
+     * @zh 切换到下一帧的缓冲，不触碰仍在使用中的帧缓冲。
+     */
+    void beginFrame();
+
+    FrameRingAllocation allocate(uint32_t size);
+    FrameRingAllocation allocate(const void *data, uint32_t size);
+
+    /**
+     * @en Uploads everything allocated in this frame so far, must be called before the commands using it are submitted.
+     * Calling it again in the same frame only uploads if more was allocated since.
+     * @zh 上传本帧目前分配的全部数据，须在提交使用这些数据的命令之前调用。同一帧内再次调用时，仅在有新分配时才上传。
+     */
+    void flush();
+
+    /**
+     * @en Same as flush(), but records the upload in the command buffer, so that it is ordered before the commands recorded after it.
+     * Needed when the consumers are recorded before the frame is submitted, as backends executing commands immediately draw while recording.
+     * @zh 同 flush()，但将上传录制到命令缓冲中，使其先于之后录制的命令执行。当使用者在帧提交前录制时需要调用，因为立即执行命令的后端在录制时即已绘制。
+     */
+    void flush(CommandBuffer *cmdBuffer);
+
+    /**
+     * @en A view of the buffer of this frame starting at 0, for dynamic uniform buffers bound with the offsets of the allocations.
+     * The view changes with the frame and when the buffer is grown, so it has to be bound again every frame.
+     * @zh 本帧缓冲从 0 开始的视图，用于以分配偏移作为动态偏移绑定的动态 uniform 缓冲。视图随帧及缓冲扩容而变化，须每帧重新绑定。
+     */
+    Buffer *getBufferView(uint32_t range);
+
+    inline Buffer *getBuffer() const { return _buffers[_frameIndex]; }
+    inline Buffer *getBuffer(uint32_t frameIndex) const { return _buffers[frameIndex]; }
+    inline uint32_t getFrameIndex() const { return _frameIndex; }
+    inline uint32_t getFrameCount() const { return static_cast<uint32_t>(_buffers.size()); }
+    inline uint32_t getCapacity() const { return _capacity; }
+    inline uint32_t getAlignment() const { return _alignment; }
+    inline uint32_t getUsedBytes() const { return std::min(_head.load(std::memory_order_relaxed), _capacity); }
+    inline const FrameRingBufferStats &getStats() const { return _stats; }
+
+private:
+    Device *_device{nullptr};
+    BufferUsage _usage{BufferUsageBit::NONE};
+    ccstd::vector<IntrusivePtr<Buffer>> _buffers;
+    // capacity of each frame buffer, the buffers are grown lazily when their frame comes
+    ccstd::vector<uint32_t> _bufferSizes;
+    // views of each frame buffer, dropped when it is grown
+    ccstd::vector<ccstd::vector<IntrusivePtr<Buffer>>> _bufferViews;
+    // staging memory of the buffer of this frame
+    uint8_t *_staging{nullptr};
+    uint32_t _capacity{0};
+    uint32_t _alignment{1};
+    uint32_t _frameIndex{0};
+    std::atomic<uint32_t> _head{0};
+    std::atomic<uint32_t> _allocations{0};
+    std::atomic<uint32_t> _failedAllocations{0};
+    std::atomic<uint32_t> _overflowBytes{0};
+    uint32_t _flushedBytes{0};
+    bool _flushed{false};
+
+    void updateFlushStats(uint32_t used);
+
+    FrameRingBufferStats _stats;
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(FrameRingBuffer);
+};
+
+} // namespace gfx
+} // namespace cc
@@ -0,0 +1,196 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <algorithm>
+
+#include "GFXDescriptorSet.h"
+#include "GFXInputAssembler.h"
+#include "GFXPipelineState.h"
+#include "GFXStateFilter.h"
+#include "math/Math.h"
+
+namespace cc {
+namespace gfx {
+
+void StateFilter::reset() {
+    _pipelineState = nullptr;
+    _pipelineStateID = 0U;
+    _inputAssembler = nullptr;
+    _inputAssemblerID = 0U;
+    for (auto &bound : _descriptorSets) {
+        bound.descriptorSet = nullptr;
+        bound.objectID = 0U;
+        bound.dynamicOffsets.clear();
+    }
+    _validStates = 0U;
+}
+
+bool StateFilter::check(uint32_t states, bool unchanged) {
+    if ((_validStates & states) == states && unchanged) {
+        ++_numFilteredCalls;
+        return true;
+    }
+    _validStates |= states;
+    return false;
+}
+
+bool StateFilter::filterPipelineState(const PipelineState *pso) {
+    const uint32_t objectID = GFXObject::getObjectID(pso);
+    if (_pipelineState == pso && _pipelineStateID == objectID) {
+        ++_numFilteredCalls;
+        return true;
+    }
+    _pipelineState = pso;
+    _pipelineStateID = objectID;
+    return false;
+}
+
+bool StateFilter::filterDescriptorSet(uint32_t set, const DescriptorSet *descriptorSet, uint32_t dynamicOffsetCount, const uint32_t *dynamicOffsets) {
+    if (set >= _descriptorSets.size()) {
+        _descriptorSets.resize(set + 1);
+    }
+
+    auto &bound = _descriptorSets[set];
+    const uint32_t objectID = GFXObject::getObjectID(descriptorSet);
+    const uint32_t textureVersion = descriptorSet ? descriptorSet->getTextureVersion() : 0U;
+    const uint32_t bufferVersion = descriptorSet ? descriptorSet->getBufferVersion() : 0U;
+    const uint32_t samplerVersion = descriptorSet ? descriptorSet->getSamplerVersion() : 0U;
+    if (bound.descriptorSet == descriptorSet && bound.objectID == objectID &&
+        bound.textureVersion == textureVersion && bound.bufferVersion == bufferVersion &&
+        bound.samplerVersion == samplerVersion &&
+        bound.dynamicOffsets.size() == dynamicOffsetCount &&
+        std::equal(dynamicOffsets, dynamicOffsets + dynamicOffsetCount, bound.dynamicOffsets.begin())) {
+        ++_numFilteredCalls;
+        return true;
+    }
+    bound.descriptorSet = descriptorSet;
+    bound.objectID = objectID;
+    bound.textureVersion = textureVersion;
+    bound.bufferVersion = bufferVersion;
+    bound.samplerVersion = samplerVersion;
+    bound.dynamicOffsets.assign(dynamicOffsets, dynamicOffsets + dynamicOffsetCount);
+    return false;
+}
+
+bool StateFilter::filterInputAssembler(const InputAssembler *ia) {
+    const uint32_t objectID = GFXObject::getObjectID(ia);
+    if (_inputAssembler == ia && _inputAssemblerID == objectID) {
+        ++_numFilteredCalls;
+        return true;
+    }
+    _inputAssembler = ia;
+    _inputAssemblerID = objectID;
+    return false;
+}
+
+bool StateFilter::filterViewport(const Viewport &vp) {
+    const auto &cur = _dynamicStates.viewport;
+    const bool unchanged = cur.left == vp.left && cur.top == vp.top &&
+                           cur.width == vp.width && cur.height == vp.height &&
+                           math::isEqualF(cur.minDepth, vp.minDepth) &&
+                           math::isEqualF(cur.maxDepth, vp.maxDepth);
+    if (check(VIEWPORT, unchanged)) return true;
+    _dynamicStates.viewport = vp;
+    return false;
+}
+
+bool StateFilter::filterScissor(const Rect &rect) {
+    const auto &cur = _dynamicStates.scissor;
+    const bool unchanged = cur.x == rect.x && cur.y == rect.y &&
+                           cur.width == rect.width && cur.height == rect.height;
+    if (check(SCISSOR, unchanged)) return true;
+    _dynamicStates.scissor = rect;
+    return false;
+}
+
+bool StateFilter::filterLineWidth(float width) {
+    if (check(LINE_WIDTH, math::isEqualF(_dynamicStates.lineWidth, width))) return true;
+    _dynamicStates.lineWidth = width;
+    return false;
+}
+
+bool StateFilter::filterDepthBias(float constant, float clamp, float slope) {
+    const bool unchanged = math::isEqualF(_dynamicStates.depthBiasConstant, constant) &&
+                           math::isEqualF(_dynamicStates.depthBiasClamp, clamp) &&
+                           math::isEqualF(_dynamicStates.depthBiasSlope, slope);
+    if (check(DEPTH_BIAS, unchanged)) return true;
+    _dynamicStates.depthBiasConstant = constant;
+    _dynamicStates.depthBiasClamp = clamp;
+    _dynamicStates.depthBiasSlope = slope;
+    return false;
+}
+
+bool StateFilter::filterBlendConstants(const Color &constants) {
+    const auto &cur = _dynamicStates.blendConstant;
+    const bool unchanged = math::isEqualF(cur.x, constants.x) && math::isEqualF(cur.y, constants.y) &&
+                           math::isEqualF(cur.z, constants.z) && math::isEqualF(cur.w, constants.w);
+    if (check(BLEND_CONSTANTS, unchanged)) return true;
+    _dynamicStates.blendConstant = constants;
+    return false;
+}
+
+bool StateFilter::filterDepthBound(float minBounds, float maxBounds) {
+    const bool unchanged = math::isEqualF(_dynamicStates.depthMinBounds, minBounds) &&
+                           math::isEqualF(_dynamicStates.depthMaxBounds, maxBounds);
+    if (check(DEPTH_BOUNDS, unchanged)) return true;
+    _dynamicStates.depthMinBounds = minBounds;
+    _dynamicStates.depthMaxBounds = maxBounds;
+    return false;
+}
+
+bool StateFilter::filterStencilWriteMask(StencilFace face, uint32_t mask) {
+    const bool front = hasFlag(face, StencilFace::FRONT);
+    const bool back = hasFlag(face, StencilFace::BACK);
+    const uint32_t states = (front ? STENCIL_WRITE_MASK_FRONT : 0U) | (back ? STENCIL_WRITE_MASK_BACK : 0U);
+    const bool unchanged = (!front || _dynamicStates.stencilStatesFront.writeMask == mask) &&
+                           (!back || _dynamicStates.stencilStatesBack.writeMask == mask);
+    if (check(states, unchanged)) return true;
+    if (front) _dynamicStates.stencilStatesFront.writeMask = mask;
+    if (back) _dynamicStates.stencilStatesBack.writeMask = mask;
+    return false;
+}
+
+bool StateFilter::filterStencilCompareMask(StencilFace face, uint32_t ref, uint32_t mask) {
+    auto matches = [&](const DynamicStencilStates &states) {
+        return states.reference == ref && states.compareMask == mask;
+    };
+    const bool front = hasFlag(face, StencilFace::FRONT);
+    const bool back = hasFlag(face, StencilFace::BACK);
+    const uint32_t states = (front ? STENCIL_COMPARE_MASK_FRONT : 0U) | (back ? STENCIL_COMPARE_MASK_BACK : 0U);
+    const bool unchanged = (!front || matches(_dynamicStates.stencilStatesFront)) &&
+                           (!back || matches(_dynamicStates.stencilStatesBack));
+    if (check(states, unchanged)) return true;
+    if (front) {
+        _dynamicStates.stencilStatesFront.reference = ref;
+        _dynamicStates.stencilStatesFront.compareMask = mask;
+    }
+    if (back) {
+        _dynamicStates.stencilStatesBack.reference = ref;
+        _dynamicStates.stencilStatesBack.compareMask = mask;
+    }
+    return false;
+}
+
+} // namespace gfx
+} // namespace cc
@@ -0,0 +1,100 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include "GFXDef.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+namespace gfx {
+
+/**
+ * Tracks the bound objects and dynamic states of a command buffer, so redundant
+ * binds and dynamic state sets can be dropped before they reach the backend.
+ *
+ * Every `filterXXX` function returns true if the call changes nothing and should
+ * be skipped; otherwise the new state is remembered and false is returned.
+ * Command buffers must `reset` the tracked state wherever the backend forgets it,
+ * i.e. on `begin`, render pass and subpass boundaries and secondary command buffer execution.
+ */
+class CC_DLL StateFilter final {
+public:
+    void reset();
+    void resetStats() { _numFilteredCalls = 0U; }
+
+    bool filterPipelineState(const PipelineState *pso);
+    bool filterDescriptorSet(uint32_t set, const DescriptorSet *descriptorSet, uint32_t dynamicOffsetCount, const uint32_t *dynamicOffsets);
+    bool filterInputAssembler(const InputAssembler *ia);
+    bool filterViewport(const Viewport &vp);
+    bool filterScissor(const Rect &rect);
+    bool filterLineWidth(float width);
+    bool filterDepthBias(float constant, float clamp, float slope);
+    bool filterBlendConstants(const Color &constants);
+    bool filterDepthBound(float minBounds, float maxBounds);
+    bool filterStencilWriteMask(StencilFace face, uint32_t mask);
+    bool filterStencilCompareMask(StencilFace face, uint32_t ref, uint32_t mask);
+
+    inline uint32_t getNumFilteredCalls() const { return _numFilteredCalls; }
+
+private:
+    static constexpr uint32_t VIEWPORT = 1U << 0;
+    static constexpr uint32_t SCISSOR = 1U << 1;
+    static constexpr uint32_t LINE_WIDTH = 1U << 2;
+    static constexpr uint32_t DEPTH_BIAS = 1U << 3;
+    static constexpr uint32_t BLEND_CONSTANTS = 1U << 4;
+    static constexpr uint32_t DEPTH_BOUNDS = 1U << 5;
+    static constexpr uint32_t STENCIL_WRITE_MASK_FRONT = 1U << 6;
+    static constexpr uint32_t STENCIL_WRITE_MASK_BACK = 1U << 7;
+    static constexpr uint32_t STENCIL_COMPARE_MASK_FRONT = 1U << 8;
+    static constexpr uint32_t STENCIL_COMPARE_MASK_BACK = 1U << 9;
+
+    // object ids (0 is invalid) guard against a destroyed object whose address gets reused,
+    // versions against bindings changed on the same set between binds
+    struct BoundDescriptorSet {
+        const DescriptorSet *descriptorSet{nullptr};
+        uint32_t objectID{0U};
+        uint32_t textureVersion{0U};
+        uint32_t bufferVersion{0U};
+        uint32_t samplerVersion{0U};
+        ccstd::vector<uint32_t> dynamicOffsets;
+    };
+
+    // counts the call as filtered if `states` are all tracked and unchanged, marks them tracked otherwise
+    bool check(uint32_t states, bool unchanged);
+
+    const PipelineState *_pipelineState{nullptr};
+    uint32_t _pipelineStateID{0U};
+    const InputAssembler *_inputAssembler{nullptr};
+    uint32_t _inputAssemblerID{0U};
+    ccstd::vector<BoundDescriptorSet> _descriptorSets;
+
+    uint32_t _validStates{0U};
+    DynamicStates _dynamicStates;
+
+    uint32_t _numFilteredCalls{0U};
+};
+
+} // namespace gfx
+} // namespace cc
@@ -40,6 +40,9 @@ void EmptyBuffer::doDestroy() {
 }
 
 void EmptyBuffer::update(const void *buffer, uint32_t size) {
+    ++_updateCount;
+    _lastUpdateSize = size;
+    _lastUpdateData = buffer;
 }
 
 } // namespace gfx
@@ -33,11 +33,20 @@ class CC_DLL EmptyBuffer final : public Buffer {
 public:
     void update(const void *buffer, uint32_t size) override;
 
+    // Nothing is uploaded, the updates are only counted so that tests can check the upload pattern.
+    inline uint32_t getUpdateCount() const { return _updateCount; }
+    inline uint32_t getLastUpdateSize() const { return _lastUpdateSize; }
+    inline const void *getLastUpdateData() const { return _lastUpdateData; }
+
 protected:
     void doInit(const BufferInfo &info) override;
     void doInit(const BufferViewInfo &info) override;
     void doResize(uint32_t size, uint32_t count) override;
     void doDestroy() override;
+
+    uint32_t _updateCount{0};
+    uint32_t _lastUpdateSize{0};
+    const void *_lastUpdateData{nullptr};
 };
 
 } // namespace gfx
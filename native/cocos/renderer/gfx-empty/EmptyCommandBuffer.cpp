@@ -31,18 +31,24 @@ void EmptyCommandBuffer::doInit(const CommandBufferInfo &info) {
 }
 
 void EmptyCommandBuffer::doDestroy() {
+    _draws.clear();
 }
 
 void EmptyCommandBuffer::begin(RenderPass *renderPass, uint32_t subpass, Framebuffer *frameBuffer) {
+    _stateFilter.reset();
+    _stateFilter.resetStats();
+    _draws.clear();
 }
 
 void EmptyCommandBuffer::end() {
 }
 
 void EmptyCommandBuffer::beginRenderPass(RenderPass *renderPass, Framebuffer *fbo, const Rect &renderArea, const Color *colors, float depth, uint32_t stencil, CommandBuffer *const *secondaryCBs, uint32_t secondaryCBCount) {
+    _stateFilter.reset();
 }
 
 void EmptyCommandBuffer::endRenderPass() {
+    _stateFilter.reset();
 }
 
 void EmptyCommandBuffer::insertMarker(const MarkerInfo &marker) {
@@ -55,45 +61,63 @@ void EmptyCommandBuffer::endMarker() {
 }
 
 void EmptyCommandBuffer::execute(CommandBuffer *const *cmdBuffs, uint32_t count) {
+    for (uint32_t i = 0; i < count; ++i) {
+        const auto &draws = static_cast<const EmptyCommandBuffer *>(cmdBuffs[i])->_draws;
+        _draws.insert(_draws.end(), draws.begin(), draws.end());
+    }
+    _stateFilter.reset();
 }
 
 void EmptyCommandBuffer::bindPipelineState(PipelineState *pso) {
+    _stateFilter.filterPipelineState(pso);
 }
 
 void EmptyCommandBuffer::bindDescriptorSet(uint32_t set, DescriptorSet *descriptorSet, uint32_t dynamicOffsetCount, const uint32_t *dynamicOffsets) {
+    _stateFilter.filterDescriptorSet(set, descriptorSet, dynamicOffsetCount, dynamicOffsets);
 }
 
 void EmptyCommandBuffer::bindInputAssembler(InputAssembler *ia) {
+    _stateFilter.filterInputAssembler(ia);
 }
 
 void EmptyCommandBuffer::setViewport(const Viewport &vp) {
+    _stateFilter.filterViewport(vp);
 }
 
 void EmptyCommandBuffer::setScissor(const Rect &rect) {
+    _stateFilter.filterScissor(rect);
 }
 
 void EmptyCommandBuffer::setLineWidth(float width) {
+    _stateFilter.filterLineWidth(width);
 }
 
 void EmptyCommandBuffer::setDepthBias(float constant, float clamp, float slope) {
+    _stateFilter.filterDepthBias(constant, clamp, slope);
 }
 
 void EmptyCommandBuffer::setBlendConstants(const Color &constants) {
+    _stateFilter.filterBlendConstants(constants);
 }
 
 void EmptyCommandBuffer::setDepthBound(float minBounds, float maxBounds) {
+    _stateFilter.filterDepthBound(minBounds, maxBounds);
 }
 
 void EmptyCommandBuffer::setStencilWriteMask(StencilFace face, uint32_t mask) {
+    _stateFilter.filterStencilWriteMask(face, mask);
 }
 
 void EmptyCommandBuffer::setStencilCompareMask(StencilFace face, uint32_t ref, uint32_t mask) {
+    _stateFilter.filterStencilCompareMask(face, ref, mask);
 }
 
 void EmptyCommandBuffer::nextSubpass() {
+    _stateFilter.reset();
 }
 
 void EmptyCommandBuffer::draw(const DrawInfo &info) {
+    _draws.emplace_back(info);
 }
 
 void EmptyCommandBuffer::updateBuffer(Buffer *buff, const void *data, uint32_t size) {
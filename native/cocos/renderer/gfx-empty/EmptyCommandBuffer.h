@@ -63,9 +63,16 @@ public:
     void endQuery(QueryPool *queryPool, uint32_t id) override;
     void resetQueryPool(QueryPool *queryPool) override;
 
+    // Nothing is drawn, the draws since begin() are kept so that tests can check the recorded order.
+    // Executing secondary command buffers appends their draws.
+    // Binds and dynamic states go through the state filter like on the GLES3 backend, see getNumFilteredCalls.
+    inline const ccstd::vector<DrawInfo> &getDraws() const { return _draws; }
+
 protected:
     void doInit(const CommandBufferInfo &info) override;
     void doDestroy() override;
+
+    ccstd::vector<DrawInfo> _draws;
 };
 
 } // namespace gfx
@@ -33,6 +33,8 @@ class CC_DLL EmptyDevice final : public Device {
 public:
     static EmptyDevice *getInstance();
 
+    // Created by DeviceManager, or directly by tests which need a device without any graphics API.
+    EmptyDevice();
     ~EmptyDevice() override;
 
     using Device::copyBuffersToTexture;
@@ -82,8 +84,6 @@ protected:
 
     friend class DeviceManager;
 
-    EmptyDevice();
-
     bool doInit(const DeviceInfo &info) override;
     void doDestroy() override;
 };
@@ -84,6 +84,8 @@ void GLES2CommandBuffer::doDestroy() {
 }
 
 void GLES2CommandBuffer::begin(RenderPass * /*renderPass*/, uint32_t /*subpass*/, Framebuffer * /*frameBuffer*/) {
+    _stateFilter.reset();
+    _stateFilter.resetStats();
     _cmdAllocator->clearCmds(_curCmdPackage);
     _curGPUPipelineState = nullptr;
     _curGPUInputAssember = nullptr;
@@ -109,6 +111,7 @@ void GLES2CommandBuffer::end() {
 }
 
 void GLES2CommandBuffer::beginRenderPass(RenderPass *renderPass, Framebuffer *fbo, const Rect &renderArea, const Color *colors, float depth, uint32_t stencil, CommandBuffer *const * /*secondaryCBs*/, uint32_t /*secondaryCBCount*/) {
+    _stateFilter.reset();
     _curSubpassIdx = 0U;
 
     GLES2CmdBeginRenderPass *cmd = _cmdAllocator->beginRenderPassCmdPool.alloc();
@@ -127,10 +130,12 @@ void GLES2CommandBuffer::beginRenderPass(RenderPass *renderPass, Framebuffer *fb
 }
 
 void GLES2CommandBuffer::endRenderPass() {
+    _stateFilter.reset();
     _curCmdPackage->cmds.push(GLESCmdType::END_RENDER_PASS);
 }
 
 void GLES2CommandBuffer::nextSubpass() {
+    _stateFilter.reset();
     _curCmdPackage->cmds.push(GLESCmdType::END_RENDER_PASS);
     GLES2CmdBeginRenderPass *cmd = _cmdAllocator->beginRenderPassCmdPool.alloc();
     cmd->subpassIdx = ++_curSubpassIdx;
@@ -148,6 +153,8 @@ void GLES2CommandBuffer::endMarker() {
 }
 
 void GLES2CommandBuffer::bindPipelineState(PipelineState *pso) {
+    if (_stateFilter.filterPipelineState(pso)) return;
+
     GLES2GPUPipelineState *gpuPipelineState = static_cast<GLES2PipelineState *>(pso)->gpuPipelineState();
     if (_curGPUPipelineState != gpuPipelineState) {
         _curGPUPipelineState = gpuPipelineState;
@@ -156,6 +163,8 @@ void GLES2CommandBuffer::bindPipelineState(PipelineState *pso) {
 }
 
 void GLES2CommandBuffer::bindDescriptorSet(uint32_t set, DescriptorSet *descriptorSet, uint32_t dynamicOffsetCount, const uint32_t *dynamicOffsets) {
+    if (_stateFilter.filterDescriptorSet(set, descriptorSet, dynamicOffsetCount, dynamicOffsets)) return;
+
     CC_ASSERT(_curGPUDescriptorSets.size() > set);
 
     GLES2GPUDescriptorSet *gpuDescriptorSet = static_cast<GLES2DescriptorSet *>(descriptorSet)->gpuDescriptorSet();
@@ -173,11 +182,15 @@ void GLES2CommandBuffer::bindDescriptorSet(uint32_t set, DescriptorSet *descript
 }
 
 void GLES2CommandBuffer::bindInputAssembler(InputAssembler *ia) {
+    if (_stateFilter.filterInputAssembler(ia)) return;
+
     _curGPUInputAssember = static_cast<GLES2InputAssembler *>(ia)->gpuInputAssembler();
     _isStateInvalid = true;
 }
 
 void GLES2CommandBuffer::setViewport(const Viewport &vp) {
+    if (_stateFilter.filterViewport(vp)) return;
+
     if ((_curDynamicStates.viewport.left != vp.left) ||
         (_curDynamicStates.viewport.top != vp.top) ||
         (_curDynamicStates.viewport.width != vp.width) ||
@@ -190,6 +203,8 @@ void GLES2CommandBuffer::setViewport(const Viewport &vp) {
 }
 
 void GLES2CommandBuffer::setScissor(const Rect &rect) {
+    if (_stateFilter.filterScissor(rect)) return;
+
     if ((_curDynamicStates.scissor.x != rect.x) ||
         (_curDynamicStates.scissor.y != rect.y) ||
         (_curDynamicStates.scissor.width != rect.width) ||
@@ -200,6 +215,8 @@ void GLES2CommandBuffer::setScissor(const Rect &rect) {
 }
 
 void GLES2CommandBuffer::setLineWidth(float width) {
+    if (_stateFilter.filterLineWidth(width)) return;
+
     if (math::isNotEqualF(_curDynamicStates.lineWidth, width)) {
         _curDynamicStates.lineWidth = width;
         _isStateInvalid = true;
@@ -207,6 +224,8 @@ void GLES2CommandBuffer::setLineWidth(float width) {
 }
 
 void GLES2CommandBuffer::setDepthBias(float constant, float clamp, float slope) {
+    if (_stateFilter.filterDepthBias(constant, clamp, slope)) return;
+
     if (math::isNotEqualF(_curDynamicStates.depthBiasConstant, constant) ||
         math::isNotEqualF(_curDynamicStates.depthBiasClamp, clamp) ||
         math::isNotEqualF(_curDynamicStates.depthBiasSlope, slope)) {
@@ -218,6 +237,8 @@ void GLES2CommandBuffer::setDepthBias(float constant, float clamp, float slope)
 }
 
 void GLES2CommandBuffer::setBlendConstants(const Color &constants) {
+    if (_stateFilter.filterBlendConstants(constants)) return;
+
     if (math::isNotEqualF(_curDynamicStates.blendConstant.x, constants.x) ||
         math::isNotEqualF(_curDynamicStates.blendConstant.y, constants.y) ||
         math::isNotEqualF(_curDynamicStates.blendConstant.z, constants.z) ||
@@ -231,6 +252,8 @@ void GLES2CommandBuffer::setBlendConstants(const Color &constants) {
 }
 
 void GLES2CommandBuffer::setDepthBound(float minBounds, float maxBounds) {
+    if (_stateFilter.filterDepthBound(minBounds, maxBounds)) return;
+
     if (math::isNotEqualF(_curDynamicStates.depthMinBounds, minBounds) ||
         math::isNotEqualF(_curDynamicStates.depthMaxBounds, maxBounds)) {
         _curDynamicStates.depthMinBounds = minBounds;
@@ -240,6 +263,8 @@ void GLES2CommandBuffer::setDepthBound(float minBounds, float maxBounds) {
 }
 
 void GLES2CommandBuffer::setStencilWriteMask(StencilFace face, uint32_t mask) {
+    if (_stateFilter.filterStencilWriteMask(face, mask)) return;
+
     auto update = [&](DynamicStencilStates &stencilState) {
         if (stencilState.writeMask != mask) {
             stencilState.writeMask = mask;
@@ -251,6 +276,8 @@ void GLES2CommandBuffer::setStencilWriteMask(StencilFace face, uint32_t mask) {
 }
 
 void GLES2CommandBuffer::setStencilCompareMask(StencilFace face, uint32_t ref, uint32_t mask) {
+    if (_stateFilter.filterStencilCompareMask(face, ref, mask)) return;
+
     auto update = [&](DynamicStencilStates &stencilState) {
         if ((stencilState.reference != ref) ||
             (stencilState.compareMask != mask)) {
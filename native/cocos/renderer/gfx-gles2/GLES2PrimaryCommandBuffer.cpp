@@ -44,6 +44,8 @@ GLES2PrimaryCommandBuffer::~GLES2PrimaryCommandBuffer() {
 }
 
 void GLES2PrimaryCommandBuffer::begin(RenderPass * /*renderPass*/, uint32_t /*subpass*/, Framebuffer * /*frameBuffer*/) {
+    _stateFilter.reset();
+    _stateFilter.resetStats();
     _curGPUPipelineState = nullptr;
     _curGPUInputAssember = nullptr;
     _curGPUDescriptorSets.assign(_curGPUDescriptorSets.size(), nullptr);
@@ -60,6 +62,7 @@ void GLES2PrimaryCommandBuffer::end() {
 }
 
 void GLES2PrimaryCommandBuffer::beginRenderPass(RenderPass *renderPass, Framebuffer *fbo, const Rect &renderArea, const Color *colors, float depth, uint32_t stencil, CommandBuffer *const * /*secondaryCBs*/, uint32_t /*secondaryCBCount*/) {
+    _stateFilter.reset();
     _curSubpassIdx = 0U;
 
     GLES2GPURenderPass *gpuRenderPass = static_cast<GLES2RenderPass *>(renderPass)->gpuRenderPass();
@@ -72,10 +75,12 @@ void GLES2PrimaryCommandBuffer::beginRenderPass(RenderPass *renderPass, Framebuf
 }
 
 void GLES2PrimaryCommandBuffer::endRenderPass() {
+    _stateFilter.reset();
     cmdFuncGLES2EndRenderPass(GLES2Device::getInstance());
 }
 
 void GLES2PrimaryCommandBuffer::nextSubpass() {
+    _stateFilter.reset();
     cmdFuncGLES2EndRenderPass(GLES2Device::getInstance());
     cmdFuncGLES2BeginRenderPass(GLES2Device::getInstance(), ++_curSubpassIdx);
 }
@@ -201,6 +206,7 @@ void GLES2PrimaryCommandBuffer::blitTexture(Texture *srcTexture, Texture *dstTex
 }
 
 void GLES2PrimaryCommandBuffer::execute(CommandBuffer *const *cmdBuffs, uint32_t count) {
+    _stateFilter.reset();
     for (uint32_t i = 0; i < count; ++i) {
         auto *cmdBuff = static_cast<GLES2PrimaryCommandBuffer *>(cmdBuffs[i]);
 
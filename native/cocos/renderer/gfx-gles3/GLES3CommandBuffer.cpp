@@ -83,6 +83,8 @@ void GLES3CommandBuffer::doDestroy() {
 }
 
 void GLES3CommandBuffer::begin(RenderPass * /*renderPass*/, uint32_t /*subpass*/, Framebuffer * /*frameBuffer*/) {
+    _stateFilter.reset();
+    _stateFilter.resetStats();
     _curGPUPipelineState = nullptr;
     _curGPUInputAssember = nullptr;
     _curGPUDescriptorSets.assign(_curGPUDescriptorSets.size(), nullptr);
@@ -109,6 +111,7 @@ void GLES3CommandBuffer::end() {
 }
 
 void GLES3CommandBuffer::beginRenderPass(RenderPass *renderPass, Framebuffer *fbo, const Rect &renderArea, const Color *colors, float depth, uint32_t stencil, CommandBuffer *const * /*secondaryCBs*/, uint32_t /*secondaryCBCount*/) {
+    _stateFilter.reset();
     _curSubpassIdx = 0U;
 
     GLES3CmdBeginRenderPass *cmd = _cmdAllocator->beginRenderPassCmdPool.alloc();
@@ -128,10 +131,12 @@ void GLES3CommandBuffer::beginRenderPass(RenderPass *renderPass, Framebuffer *fb
 }
 
 void GLES3CommandBuffer::endRenderPass() {
+    _stateFilter.reset();
     _curCmdPackage->cmds.push(GLESCmdType::END_RENDER_PASS);
 }
 
 void GLES3CommandBuffer::nextSubpass() {
+    _stateFilter.reset();
     _curCmdPackage->cmds.push(GLESCmdType::END_RENDER_PASS);
     GLES3CmdBeginRenderPass *cmd = _cmdAllocator->beginRenderPassCmdPool.alloc();
     cmd->subpassIdx = ++_curSubpassIdx;
@@ -149,6 +154,8 @@ void GLES3CommandBuffer::endMarker() {
 }
 
 void GLES3CommandBuffer::bindPipelineState(PipelineState *pso) {
+    if (_stateFilter.filterPipelineState(pso)) return;
+
     GLES3GPUPipelineState *gpuPipelineState = static_cast<GLES3PipelineState *>(pso)->gpuPipelineState();
     if (_curGPUPipelineState != gpuPipelineState) {
         _curGPUPipelineState = gpuPipelineState;
@@ -157,6 +164,8 @@ void GLES3CommandBuffer::bindPipelineState(PipelineState *pso) {
 }
 
 void GLES3CommandBuffer::bindDescriptorSet(uint32_t set, DescriptorSet *descriptorSet, uint32_t dynamicOffsetCount, const uint32_t *dynamicOffsets) {
+    if (_stateFilter.filterDescriptorSet(set, descriptorSet, dynamicOffsetCount, dynamicOffsets)) return;
+
     CC_ASSERT(_curGPUDescriptorSets.size() > set);
 
     GLES3GPUDescriptorSet *gpuDescriptorSet = static_cast<GLES3DescriptorSet *>(descriptorSet)->gpuDescriptorSet();
@@ -174,11 +183,15 @@ void GLES3CommandBuffer::bindDescriptorSet(uint32_t set, DescriptorSet *descript
 }
 
 void GLES3CommandBuffer::bindInputAssembler(InputAssembler *ia) {
+    if (_stateFilter.filterInputAssembler(ia)) return;
+
     _curGPUInputAssember = static_cast<GLES3InputAssembler *>(ia)->gpuInputAssembler();
     _isStateInvalid = true;
 }
 
 void GLES3CommandBuffer::setViewport(const Viewport &vp) {
+    if (_stateFilter.filterViewport(vp)) return;
+
     if ((_curDynamicStates.viewport.left != vp.left) ||
         (_curDynamicStates.viewport.top != vp.top) ||
         (_curDynamicStates.viewport.width != vp.width) ||
@@ -191,6 +204,8 @@ void GLES3CommandBuffer::setViewport(const Viewport &vp) {
 }
 
 void GLES3CommandBuffer::setScissor(const Rect &rect) {
+    if (_stateFilter.filterScissor(rect)) return;
+
     if ((_curDynamicStates.scissor.x != rect.x) ||
         (_curDynamicStates.scissor.y != rect.y) ||
         (_curDynamicStates.scissor.width != rect.width) ||
@@ -201,6 +216,8 @@ void GLES3CommandBuffer::setScissor(const Rect &rect) {
 }
 
 void GLES3CommandBuffer::setLineWidth(float width) {
+    if (_stateFilter.filterLineWidth(width)) return;
+
     if (math::isNotEqualF(_curDynamicStates.lineWidth, width)) {
         _curDynamicStates.lineWidth = width;
         _isStateInvalid = true;
@@ -208,6 +225,8 @@ void GLES3CommandBuffer::setLineWidth(float width) {
 }
 
 void GLES3CommandBuffer::setDepthBias(float constant, float clamp, float slope) {
+    if (_stateFilter.filterDepthBias(constant, clamp, slope)) return;
+
     if (math::isNotEqualF(_curDynamicStates.depthBiasConstant, constant) ||
         math::isNotEqualF(_curDynamicStates.depthBiasClamp, clamp) ||
         math::isNotEqualF(_curDynamicStates.depthBiasSlope, slope)) {
@@ -219,6 +238,8 @@ void GLES3CommandBuffer::setDepthBias(float constant, float clamp, float slope)
 }
 
 void GLES3CommandBuffer::setBlendConstants(const Color &constants) {
+    if (_stateFilter.filterBlendConstants(constants)) return;
+
     if (math::isNotEqualF(_curDynamicStates.blendConstant.x, constants.x) ||
         math::isNotEqualF(_curDynamicStates.blendConstant.y, constants.y) ||
         math::isNotEqualF(_curDynamicStates.blendConstant.z, constants.z) ||
@@ -232,6 +253,8 @@ void GLES3CommandBuffer::setBlendConstants(const Color &constants) {
 }
 
 void GLES3CommandBuffer::setDepthBound(float minBounds, float maxBounds) {
+    if (_stateFilter.filterDepthBound(minBounds, maxBounds)) return;
+
     if (math::isNotEqualF(_curDynamicStates.depthMinBounds, minBounds) ||
         math::isNotEqualF(_curDynamicStates.depthMaxBounds, maxBounds)) {
         _curDynamicStates.depthMinBounds = minBounds;
@@ -241,6 +264,8 @@ void GLES3CommandBuffer::setDepthBound(float minBounds, float maxBounds) {
 }
 
 void GLES3CommandBuffer::setStencilWriteMask(StencilFace face, uint32_t mask) {
+    if (_stateFilter.filterStencilWriteMask(face, mask)) return;
+
     auto update = [&](DynamicStencilStates &stencilState) {
         if (stencilState.writeMask != mask) {
             stencilState.writeMask = mask;
@@ -252,6 +277,8 @@ void GLES3CommandBuffer::setStencilWriteMask(StencilFace face, uint32_t mask) {
 }
 
 void GLES3CommandBuffer::setStencilCompareMask(StencilFace face, uint32_t ref, uint32_t mask) {
+    if (_stateFilter.filterStencilCompareMask(face, ref, mask)) return;
+
     auto update = [&](DynamicStencilStates &stencilState) {
         if ((stencilState.reference != ref) ||
             (stencilState.compareMask != mask)) {
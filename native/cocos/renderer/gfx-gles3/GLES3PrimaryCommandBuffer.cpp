@@ -46,6 +46,8 @@ GLES3PrimaryCommandBuffer::~GLES3PrimaryCommandBuffer() {
 }
 
 void GLES3PrimaryCommandBuffer::begin(RenderPass * /*renderPass*/, uint32_t /*subpass*/, Framebuffer * /*frameBuffer*/) {
+    _stateFilter.reset();
+    _stateFilter.resetStats();
     _curGPUPipelineState = nullptr;
     _curGPUInputAssember = nullptr;
     _curGPUDescriptorSets.assign(_curGPUDescriptorSets.size(), nullptr);
@@ -62,6 +64,7 @@ void GLES3PrimaryCommandBuffer::end() {
 }
 
 void GLES3PrimaryCommandBuffer::beginRenderPass(RenderPass *renderPass, Framebuffer *fbo, const Rect &renderArea, const Color *colors, float depth, uint32_t stencil, CommandBuffer *const * /*secondaryCBs*/, uint32_t /*secondaryCBCount*/) {
+    _stateFilter.reset();
     _curSubpassIdx = 0U;
 
     auto *gpuRenderPass = static_cast<GLES3RenderPass *>(renderPass)->gpuRenderPass();
@@ -73,10 +76,12 @@ void GLES3PrimaryCommandBuffer::beginRenderPass(RenderPass *renderPass, Framebuf
 }
 
 void GLES3PrimaryCommandBuffer::endRenderPass() {
+    _stateFilter.reset();
     cmdFuncGLES3EndRenderPass(GLES3Device::getInstance());
 }
 
 void GLES3PrimaryCommandBuffer::nextSubpass() {
+    _stateFilter.reset();
     ++_curSubpassIdx;
 }
 
@@ -211,6 +216,7 @@ void GLES3PrimaryCommandBuffer::getQueryPoolResults(QueryPool *queryPool) {
 }
 
 void GLES3PrimaryCommandBuffer::execute(CommandBuffer *const *cmdBuffs, uint32_t count) {
+    _stateFilter.reset();
     for (uint32_t i = 0; i < count; ++i) {
         auto *cmdBuff = static_cast<GLES3PrimaryCommandBuffer *>(cmdBuffs[i]);
 
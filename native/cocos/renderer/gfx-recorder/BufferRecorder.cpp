@@ -0,0 +1,138 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+
+#include "BufferRecorder.h"
+#include "DeviceRecorder.h"
+
+namespace cc {
+namespace gfx {
+
+BufferRecorder::BufferRecorder(Buffer *actor)
+: Agent<Buffer>(actor) {
+    _typedID = actor->getTypedID();
+}
+
+BufferRecorder::~BufferRecorder() {
+    CC_SAFE_DELETE(_actor);
+}
+
+void BufferRecorder::doInit(const BufferInfo &info) {
+    DeviceRecorder::getInstance()->forget(this);
+    _contents.assign(info.size, 0U);
+
+    _actor->initialize(info);
+}
+
+void BufferRecorder::doInit(const BufferViewInfo &info) {
+    DeviceRecorder::getInstance()->forget(this);
+    _source = static_cast<BufferRecorder *>(info.buffer);
+
+    BufferViewInfo actorInfo = info;
+    actorInfo.buffer = _source->getActor();
+
+    _actor->initialize(actorInfo);
+}
+
+void BufferRecorder::doResize(uint32_t size, uint32_t /*count*/) {
+    auto *device = DeviceRecorder::getInstance();
+    device->reference(this);
+    device->writeRecord([&](CaptureWriter &writer) {
+        writer.writeOp(RecordOp::RESIZE_BUFFER);
+        writer.writeID(this);
+        writer.write(size);
+    });
+    _contents.resize(size);
+
+    _actor->resize(size);
+}
+
+void BufferRecorder::doDestroy() {
+    _source = nullptr;
+    _contents.clear();
+    _contents.shrink_to_fit();
+
+    _actor->destroy();
+}
+
+void BufferRecorder::update(const void *buffer, uint32_t size) {
+    recordUpdate(buffer, size);
+
+    _actor->update(buffer, size);
+}
+
+void BufferRecorder::flush(const uint8_t *buffer) {
+    recordUpdate(buffer, _size);
+
+    Buffer::flushBuffer(_actor, buffer);
+}
+
+uint8_t *BufferRecorder::getStagingAddress() const {
+    return Buffer::getBufferStagingAddress(_actor);
+}
+
+void BufferRecorder::recordUpdate(const void *buffer, uint32_t size) {
+    auto *device = DeviceRecorder::getInstance();
+    // the creation record carries the contents prior to this update
+    device->reference(this);
+    device->writeRecord([&](CaptureWriter &writer) {
+        writer.writeOp(RecordOp::UPDATE_BUFFER);
+        writer.writeID(this);
+        writer.write(size);
+        writer.writeBytes(buffer, size);
+    });
+
+    memcpy(_contents.data(), buffer, std::min(size, static_cast<uint32_t>(_contents.size())));
+
+    RecorderFrameStats stats;
+    stats.bytesUploaded = size;
+    device->mergeFrameStats(stats);
+}
+
+void BufferRecorder::record(CaptureWriter &writer) const {
+    if (_isBufferView) {
+        DeviceRecorder::getInstance()->reference(_source);
+        writer.writeOp(RecordOp::CREATE_BUFFER_VIEW);
+        writer.writeID(this);
+        writer.writeID(_source);
+        writer.write(_offset);
+        writer.write(_size);
+        return;
+    }
+
+    writer.writeOp(RecordOp::CREATE_BUFFER);
+    writer.writeID(this);
+    writer.write(_usage);
+    writer.write(_memUsage);
+    writer.write(_size);
+    writer.write(_stride);
+    writer.write(_flags);
+    writer.write(static_cast<uint32_t>(_contents.size()));
+    writer.writeBytes(_contents.data(), static_cast<uint32_t>(_contents.size()));
+}
+
+} // namespace gfx
+} // namespace cc
@@ -0,0 +1,62 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include "base/Agent.h"
+#include "gfx-base/GFXBuffer.h"
+
+namespace cc {
+namespace gfx {
+
+class CaptureWriter;
+
+class CC_DLL BufferRecorder final : public Agent<Buffer> {
+public:
+    explicit BufferRecorder(Buffer *actor);
+    ~BufferRecorder() override;
+
+    void update(const void *buffer, uint32_t size) override;
+
+    void record(CaptureWriter &writer) const;
+
+protected:
+    friend class CommandBufferRecorder;
+
+    void doInit(const BufferInfo &info) override;
+    void doInit(const BufferViewInfo &info) override;
+    void doResize(uint32_t size, uint32_t count) override;
+    void doDestroy() override;
+
+    void flush(const uint8_t *buffer) override;
+    uint8_t *getStagingAddress() const override;
+
+    void recordUpdate(const void *buffer, uint32_t size);
+
+    BufferRecorder *_source{nullptr}; // weak reference
+    ccstd::vector<uint8_t> _contents;
+};
+
+} // namespace gfx
+} // namespace cc
@@ -0,0 +1,628 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <algorithm>
+
+#include "base/Log.h"
+#include "gfx-base/GFXDevice.h"
+
+#include "CaptureReplayer.h"
+
+namespace cc {
+namespace gfx {
+
+namespace {
+
+template <typename T>
+void destroyObject(GFXObject *object) {
+    auto *typed = static_cast<T *>(object);
+    CC_SAFE_DESTROY_AND_DELETE(typed);
+}
+
+} // namespace
+
+CaptureReplayer::CaptureReplayer(Device *device)
+: _device(device) {}
+
+CaptureReplayer::~CaptureReplayer() {
+    destroy();
+}
+
+bool CaptureReplayer::load(ccstd::vector<uint8_t> &&capture) {
+    destroy();
+
+    CaptureReader reader(capture.data(), static_cast<uint32_t>(capture.size()));
+    const auto magic = reader.read<uint32_t>();
+    const auto version = reader.read<uint32_t>();
+    if (!reader.isValid() || magic != CAPTURE_MAGIC) {
+        CC_LOG_ERROR("CaptureReplayer: invalid capture.");
+        return false;
+    }
+    if (version != CAPTURE_VERSION) {
+        CC_LOG_ERROR("CaptureReplayer: unsupported capture version %u.", version);
+        return false;
+    }
+
+    _capture = std::move(capture);
+    return true;
+}
+
+void CaptureReplayer::destroy() {
+    destroyObjects();
+    _capture.clear();
+    _stats = {};
+    _recordedStats = {};
+}
+
+bool CaptureReplayer::replay() {
+    if (_capture.empty()) return false;
+
+    destroyObjects();
+    _stats = {};
+
+    CaptureReader reader(_capture.data(), static_cast<uint32_t>(_capture.size()));
+    reader.skip(sizeof(CAPTURE_MAGIC) + sizeof(CAPTURE_VERSION));
+
+    while (!reader.isEnd()) {
+        const auto op = reader.read<RecordOp>();
+        if (!reader.isValid() || !replayRecord(reader, op)) {
+            CC_LOG_ERROR("CaptureReplayer: malformed record %u.", static_cast<uint32_t>(op));
+            return false;
+        }
+    }
+
+    return reader.isValid();
+}
+
+void CaptureReplayer::own(uint32_t id, GFXObject *object) {
+    _objects[id] = object;
+    _ownedObjects.push_back(object);
+}
+
+void CaptureReplayer::destroyObjects() {
+    // release in reverse creation order so dependents go first
+    for (auto iter = _ownedObjects.rbegin(); iter != _ownedObjects.rend(); ++iter) {
+        GFXObject *object = *iter;
+        switch (object->getObjectType()) {
+            case ObjectType::BUFFER: destroyObject<Buffer>(object); break;
+            case ObjectType::TEXTURE: destroyObject<Texture>(object); break;
+            case ObjectType::RENDER_PASS: destroyObject<RenderPass>(object); break;
+            case ObjectType::FRAMEBUFFER: destroyObject<Framebuffer>(object); break;
+            case ObjectType::SHADER: destroyObject<Shader>(object); break;
+            case ObjectType::DESCRIPTOR_SET_LAYOUT: destroyObject<DescriptorSetLayout>(object); break;
+            case ObjectType::PIPELINE_LAYOUT: destroyObject<PipelineLayout>(object); break;
+            case ObjectType::PIPELINE_STATE: destroyObject<PipelineState>(object); break;
+            case ObjectType::DESCRIPTOR_SET: destroyObject<DescriptorSet>(object); break;
+            case ObjectType::INPUT_ASSEMBLER: destroyObject<InputAssembler>(object); break;
+            case ObjectType::COMMAND_BUFFER: destroyObject<CommandBuffer>(object); break;
+            case ObjectType::QUEUE: destroyObject<Queue>(object); break;
+            case ObjectType::QUERY_POOL: destroyObject<QueryPool>(object); break;
+            default: CC_ABORT(); break;
+        }
+    }
+    _ownedObjects.clear();
+    _objects.clear();
+}
+
+bool CaptureReplayer::replayRecord(CaptureReader &reader, RecordOp op) {
+    switch (op) {
+        case RecordOp::DEVICE_OBJECTS: {
+            _objects[reader.read<uint32_t>()] = _device->getQueue();
+            _objects[reader.read<uint32_t>()] = _device->getCommandBuffer();
+            _objects[reader.read<uint32_t>()] = _device->getQueryPool();
+        } break;
+        case RecordOp::FRAME_BEGIN: {
+            const auto count = reader.readCount();
+            reader.skip(count * sizeof(uint32_t));
+            if (_swapchain) {
+                _device->acquire(&_swapchain, 1U);
+            } else {
+                _device->acquire(nullptr, 0U);
+            }
+        } break;
+        case RecordOp::FRAME_END: {
+            _recordedStats = reader.read<RecorderFrameStats>();
+            _device->present();
+        } break;
+        case RecordOp::CREATE_QUEUE: {
+            const auto id = reader.read<uint32_t>();
+            QueueInfo info;
+            info.type = reader.read<QueueType>();
+            own(id, _device->createQueue(info));
+        } break;
+        case RecordOp::CREATE_COMMAND_BUFFER: {
+            const auto id = reader.read<uint32_t>();
+            CommandBufferInfo info;
+            info.queue = lookup<Queue>(reader);
+            info.type = reader.read<CommandBufferType>();
+            own(id, _device->createCommandBuffer(info));
+        } break;
+        case RecordOp::CREATE_QUERY_POOL: {
+            const auto id = reader.read<uint32_t>();
+            QueryPoolInfo info;
+            info.type = reader.read<QueryType>();
+            info.maxQueryObjects = reader.read<uint32_t>();
+            info.forceWait = reader.read<bool>();
+            own(id, _device->createQueryPool(info));
+        } break;
+        case RecordOp::CREATE_SWAPCHAIN_TEXTURE: {
+            const auto id = reader.read<uint32_t>();
+            reader.read<uint32_t>(); // swapchain
+            TextureInfo info;
+            deserialize(reader, info);
+            if (_swapchain) {
+                const bool isDepth = GFX_FORMAT_INFOS[toNumber(info.format)].hasDepth;
+                _objects[id] = isDepth ? _swapchain->getDepthStencilTexture() : _swapchain->getColorTexture();
+            } else {
+                own(id, _device->createTexture(info));
+            }
+        } break;
+        case RecordOp::CREATE_BUFFER: {
+            const auto id = reader.read<uint32_t>();
+            BufferInfo info;
+            info.usage = reader.read<BufferUsage>();
+            info.memUsage = reader.read<MemoryUsage>();
+            info.size = reader.read<uint32_t>();
+            info.stride = reader.read<uint32_t>();
+            info.flags = reader.read<BufferFlags>();
+            const auto contentsSize = reader.read<uint32_t>();
+            const uint8_t *contents = reader.skip(contentsSize);
+            Buffer *buffer = _device->createBuffer(info);
+            if (contents && contentsSize) buffer->update(contents, contentsSize);
+            own(id, buffer);
+        } break;
+        case RecordOp::CREATE_BUFFER_VIEW: {
+            const auto id = reader.read<uint32_t>();
+            BufferViewInfo info;
+            info.buffer = lookup<Buffer>(reader);
+            info.offset = reader.read<uint32_t>();
+            info.range = reader.read<uint32_t>();
+            if (!info.buffer) return false;
+            own(id, _device->createBuffer(info));
+        } break;
+        case RecordOp::CREATE_TEXTURE: {
+            const auto id = reader.read<uint32_t>();
+            TextureInfo info;
+            deserialize(reader, info);
+            own(id, _device->createTexture(info));
+        } break;
+        case RecordOp::CREATE_TEXTURE_VIEW: {
+            const auto id = reader.read<uint32_t>();
+            TextureViewInfo info;
+            info.texture = lookup<Texture>(reader);
+            info.type = reader.read<TextureType>();
+            info.format = reader.read<Format>();
+            info.baseLevel = reader.read<uint32_t>();
+            info.levelCount = reader.read<uint32_t>();
+            info.baseLayer = reader.read<uint32_t>();
+            info.layerCount = reader.read<uint32_t>();
+            info.basePlane = reader.read<uint32_t>();
+            info.planeCount = reader.read<uint32_t>();
+            if (!info.texture) return false;
+            own(id, _device->createTexture(info));
+        } break;
+        case RecordOp::CREATE_SHADER: {
+            const auto id = reader.read<uint32_t>();
+            ShaderInfo info;
+            deserialize(reader, info);
+            own(id, _device->createShader(info));
+        } break;
+        case RecordOp::CREATE_INPUT_ASSEMBLER: {
+            const auto id = reader.read<uint32_t>();
+            InputAssemblerInfo info;
+            deserialize(reader, info.attributes);
+            info.vertexBuffers.resize(reader.readCount());
+            for (auto &vertexBuffer : info.vertexBuffers) {
+                vertexBuffer = lookup<Buffer>(reader);
+            }
+            info.indexBuffer = lookup<Buffer>(reader);
+            info.indirectBuffer = lookup<Buffer>(reader);
+            InputAssembler *ia = _device->createInputAssembler(info);
+            ia->setDrawInfo(reader.read<DrawInfo>());
+            own(id, ia);
+        } break;
+        case RecordOp::CREATE_RENDER_PASS: {
+            const auto id = reader.read<uint32_t>();
+            RenderPassInfo info;
+            deserialize(reader, info, _device);
+            own(id, _device->createRenderPass(info));
+        } break;
+        case RecordOp::CREATE_FRAMEBUFFER: {
+            const auto id = reader.read<uint32_t>();
+            FramebufferInfo info;
+            info.renderPass = lookup<RenderPass>(reader);
+            info.colorTextures.resize(reader.readCount());
+            for (auto &colorTexture : info.colorTextures) {
+                colorTexture = lookup<Texture>(reader);
+            }
+            info.depthStencilTexture = lookup<Texture>(reader);
+            info.depthStencilResolveTexture = lookup<Texture>(reader);
+            if (!info.renderPass) return false;
+            own(id, _device->createFramebuffer(info));
+        } break;
+        case RecordOp::CREATE_DESCRIPTOR_SET_LAYOUT: {
+            const auto id = reader.read<uint32_t>();
+            DescriptorSetLayoutInfo info;
+            deserialize(reader, info, _device);
+            own(id, _device->createDescriptorSetLayout(info));
+        } break;
+        case RecordOp::CREATE_PIPELINE_LAYOUT: {
+            const auto id = reader.read<uint32_t>();
+            PipelineLayoutInfo info;
+            info.setLayouts.resize(reader.readCount());
+            for (auto &setLayout : info.setLayouts) {
+                setLayout = lookup<DescriptorSetLayout>(reader);
+            }
+            own(id, _device->createPipelineLayout(info));
+        } break;
+        case RecordOp::CREATE_PIPELINE_STATE: {
+            const auto id = reader.read<uint32_t>();
+            PipelineStateInfo info;
+            info.shader = lookup<Shader>(reader);
+            info.pipelineLayout = lookup<PipelineLayout>(reader);
+            info.renderPass = lookup<RenderPass>(reader);
+            info.subpass = reader.read<uint32_t>();
+            deserialize(reader, info.inputState.attributes);
+            info.rasterizerState = reader.read<RasterizerState>();
+            info.depthStencilState = reader.read<DepthStencilState>();
+            deserialize(reader, info.blendState);
+            info.primitive = reader.read<PrimitiveMode>();
+            info.dynamicStates = reader.read<DynamicStateFlags>();
+            info.bindPoint = reader.read<PipelineBindPoint>();
+            if (!info.shader || !info.pipelineLayout) return false;
+            own(id, _device->createPipelineState(info));
+        } break;
+        case RecordOp::CREATE_DESCRIPTOR_SET: {
+            const auto id = reader.read<uint32_t>();
+            DescriptorSetInfo info;
+            info.layout = lookup<DescriptorSetLayout>(reader);
+            if (!info.layout) return false;
+            DescriptorSet *descriptorSet = _device->createDescriptorSet(info);
+            replayDescriptors(reader, descriptorSet);
+            own(id, descriptorSet);
+        } break;
+        case RecordOp::UPDATE_DESCRIPTOR_SET: {
+            auto *descriptorSet = lookup<DescriptorSet>(reader);
+            if (!descriptorSet) return false;
+            replayDescriptors(reader, descriptorSet);
+        } break;
+        case RecordOp::UPDATE_BUFFER: {
+            auto *buffer = lookup<Buffer>(reader);
+            const auto size = reader.read<uint32_t>();
+            const uint8_t *data = reader.skip(size);
+            if (!buffer || !data) return false;
+            buffer->update(data, size);
+            _stats.bytesUploaded += size;
+        } break;
+        case RecordOp::RESIZE_BUFFER: {
+            auto *buffer = lookup<Buffer>(reader);
+            const auto size = reader.read<uint32_t>();
+            if (!buffer) return false;
+            buffer->resize(size);
+        } break;
+        case RecordOp::RESIZE_TEXTURE: {
+            auto *texture = lookup<Texture>(reader);
+            const auto width = reader.read<uint32_t>();
+            const auto height = reader.read<uint32_t>();
+            if (!texture) return false;
+            // swapchain textures follow the replaying swapchain
+            const bool isSwapchainTexture = _swapchain && (texture == _swapchain->getColorTexture() || texture == _swapchain->getDepthStencilTexture());
+            if (!isSwapchainTexture) texture->resize(width, height);
+        } break;
+        case RecordOp::COPY_BUFFERS_TO_TEXTURE: {
+            auto *texture = lookup<Texture>(reader);
+            BufferTextureCopyList regions;
+            BufferDataList buffers;
+            deserializeTextureUpload(reader, regions, buffers);
+            if (!texture || !reader.isValid()) return false;
+            _device->copyBuffersToTexture(buffers, texture, regions);
+            _stats.bytesUploaded += getTextureUploadSize(texture->getInfo(), regions.data(), static_cast<uint32_t>(regions.size()));
+        } break;
+        case RecordOp::COPY_TEXTURE_TO_BUFFERS: {
+            // read-backs have no effect on the replayed frame
+            reader.read<uint32_t>();
+            const auto count = reader.readCount();
+            reader.skip(count * sizeof(BufferTextureCopy));
+        } break;
+        case RecordOp::FLUSH_COMMANDS: {
+            _cmdBuffs.resize(reader.readCount());
+            for (auto &cmdBuff : _cmdBuffs) {
+                cmdBuff = lookup<CommandBuffer>(reader);
+                if (!cmdBuff) return false;
+            }
+            _device->flushCommands(_cmdBuffs);
+        } break;
+        case RecordOp::QUEUE_SUBMIT: {
+            auto *queue = lookup<Queue>(reader);
+            _cmdBuffs.resize(reader.readCount());
+            for (auto &cmdBuff : _cmdBuffs) {
+                cmdBuff = lookup<CommandBuffer>(reader);
+                if (!cmdBuff) return false;
+            }
+            if (!queue) return false;
+            queue->submit(_cmdBuffs);
+            ++_stats.submits;
+        } break;
+        case RecordOp::COMMAND_BLOCK: {
+            auto *cmdBuff = lookup<CommandBuffer>(reader);
+            const auto size = reader.read<uint32_t>();
+            const uint8_t *data = reader.skip(size);
+            if (!cmdBuff || !data) return false;
+
+            CaptureReader commands(data, size);
+            while (!commands.isEnd()) {
+                const auto cmdOp = commands.read<RecordOp>();
+                if (!commands.isValid() || !replayCommand(commands, cmdOp, cmdBuff)) return false;
+            }
+        } break;
+        default:
+            return false;
+    }
+
+    return reader.isValid();
+}
+
+void CaptureReplayer::replayDescriptors(CaptureReader &reader, DescriptorSet *descriptorSet) {
+    const auto count = reader.readCount();
+    ccstd::vector<Buffer *> buffers(count);
+    ccstd::vector<AccessFlags> bufferFlags(count);
+    ccstd::vector<Texture *> textures(count);
+    ccstd::vector<AccessFlags> textureFlags(count);
+    ccstd::vector<Sampler *> samplers(count);
+    for (uint32_t i = 0U; i < count; ++i) {
+        buffers[i] = lookup<Buffer>(reader);
+        bufferFlags[i] = reader.read<AccessFlags>();
+        textures[i] = lookup<Texture>(reader);
+        textureFlags[i] = reader.read<AccessFlags>();
+        samplers[i] = deserializeSampler(reader, _device);
+    }
+
+    // descriptors are recorded in descriptor index order, map them back to bindings
+    const auto *layout = descriptorSet->getLayout();
+    const auto &descriptorIndices = layout->getDescriptorIndices();
+    for (const auto &binding : layout->getBindings()) {
+        for (uint32_t i = 0U; i < binding.count; ++i) {
+            const uint32_t index = descriptorIndices[binding.binding] + i;
+            if (index >= count) continue;
+            if (buffers[index]) descriptorSet->bindBuffer(binding.binding, buffers[index], i, bufferFlags[index]);
+            if (textures[index]) descriptorSet->bindTexture(binding.binding, textures[index], i, textureFlags[index]);
+            if (samplers[index]) descriptorSet->bindSampler(binding.binding, samplers[index], i);
+        }
+    }
+    descriptorSet->update();
+}
+
+bool CaptureReplayer::replayCommand(CaptureReader &reader, RecordOp op, CommandBuffer *cmdBuff) {
+    switch (op) {
+        case RecordOp::CMD_BEGIN: {
+            auto *renderPass = lookup<RenderPass>(reader);
+            const auto subpass = reader.read<uint32_t>();
+            auto *framebuffer = lookup<Framebuffer>(reader);
+            cmdBuff->begin(renderPass, subpass, framebuffer);
+        } break;
+        case RecordOp::CMD_END: {
+            cmdBuff->end();
+        } break;
+        case RecordOp::CMD_BEGIN_RENDER_PASS: {
+            auto *renderPass = lookup<RenderPass>(reader);
+            auto *framebuffer = lookup<Framebuffer>(reader);
+            const auto renderArea = reader.read<Rect>();
+            _colors.resize(reader.readCount());
+            reader.readBytes(_colors.data(), static_cast<uint32_t>(_colors.size() * sizeof(Color)));
+            const auto depth = reader.read<float>();
+            const auto stencil = reader.read<uint32_t>();
+            _cmdBuffs.resize(reader.readCount());
+            for (auto &secondaryCB : _cmdBuffs) {
+                secondaryCB = lookup<CommandBuffer>(reader);
+            }
+            if (!renderPass || !framebuffer) return false;
+            cmdBuff->beginRenderPass(renderPass, framebuffer, renderArea, _colors.data(), depth, stencil, _cmdBuffs.data(), static_cast<uint32_t>(_cmdBuffs.size()));
+            ++_stats.renderPasses;
+        } break;
+        case RecordOp::CMD_END_RENDER_PASS: {
+            cmdBuff->endRenderPass();
+        } break;
+        case RecordOp::CMD_NEXT_SUBPASS: {
+            cmdBuff->nextSubpass();
+        } break;
+        case RecordOp::CMD_INSERT_MARKER: {
+            MarkerInfo marker;
+            deserialize(reader, marker);
+            cmdBuff->insertMarker(marker);
+        } break;
+        case RecordOp::CMD_BEGIN_MARKER: {
+            MarkerInfo marker;
+            deserialize(reader, marker);
+            cmdBuff->beginMarker(marker);
+        } break;
+        case RecordOp::CMD_END_MARKER: {
+            cmdBuff->endMarker();
+        } break;
+        case RecordOp::CMD_BIND_PIPELINE_STATE: {
+            auto *pso = lookup<PipelineState>(reader);
+            if (!pso) return false;
+            cmdBuff->bindPipelineState(pso);
+            ++_stats.pipelineBinds;
+        } break;
+        case RecordOp::CMD_BIND_DESCRIPTOR_SET: {
+            const auto set = reader.read<uint32_t>();
+            auto *descriptorSet = lookup<DescriptorSet>(reader);
+            _dynamicOffsets.resize(reader.readCount());
+            reader.readBytes(_dynamicOffsets.data(), static_cast<uint32_t>(_dynamicOffsets.size() * sizeof(uint32_t)));
+            if (!descriptorSet) return false;
+            cmdBuff->bindDescriptorSet(set, descriptorSet, _dynamicOffsets);
+            ++_stats.descriptorSetBinds;
+        } break;
+        case RecordOp::CMD_BIND_INPUT_ASSEMBLER: {
+            auto *ia = lookup<InputAssembler>(reader);
+            if (!ia) return false;
+            cmdBuff->bindInputAssembler(ia);
+            ++_stats.inputAssemblerBinds;
+        } break;
+        case RecordOp::CMD_SET_VIEWPORT: {
+            cmdBuff->setViewport(reader.read<Viewport>());
+        } break;
+        case RecordOp::CMD_SET_SCISSOR: {
+            cmdBuff->setScissor(reader.read<Rect>());
+        } break;
+        case RecordOp::CMD_SET_LINE_WIDTH: {
+            cmdBuff->setLineWidth(reader.read<float>());
+        } break;
+        case RecordOp::CMD_SET_DEPTH_BIAS: {
+            const auto constant = reader.read<float>();
+            const auto clamp = reader.read<float>();
+            const auto slope = reader.read<float>();
+            cmdBuff->setDepthBias(constant, clamp, slope);
+        } break;
+        case RecordOp::CMD_SET_BLEND_CONSTANTS: {
+            cmdBuff->setBlendConstants(reader.read<Color>());
+        } break;
+        case RecordOp::CMD_SET_DEPTH_BOUND: {
+            const auto minBounds = reader.read<float>();
+            const auto maxBounds = reader.read<float>();
+            cmdBuff->setDepthBound(minBounds, maxBounds);
+        } break;
+        case RecordOp::CMD_SET_STENCIL_WRITE_MASK: {
+            const auto face = reader.read<StencilFace>();
+            const auto mask = reader.read<uint32_t>();
+            cmdBuff->setStencilWriteMask(face, mask);
+        } break;
+        case RecordOp::CMD_SET_STENCIL_COMPARE_MASK: {
+            const auto face = reader.read<StencilFace>();
+            const auto ref = reader.read<uint32_t>();
+            const auto mask = reader.read<uint32_t>();
+            cmdBuff->setStencilCompareMask(face, ref, mask);
+        } break;
+        case RecordOp::CMD_DRAW: {
+            const auto info = reader.read<DrawInfo>();
+            cmdBuff->draw(info);
+            ++_stats.drawCalls;
+            _stats.instances += std::max(info.instanceCount, 1U);
+        } break;
+        case RecordOp::CMD_UPDATE_BUFFER: {
+            auto *buffer = lookup<Buffer>(reader);
+            const auto size = reader.read<uint32_t>();
+            const uint8_t *data = reader.skip(size);
+            if (!buffer || !data) return false;
+            cmdBuff->updateBuffer(buffer, data, size);
+            _stats.bytesUploaded += size;
+        } break;
+        case RecordOp::CMD_COPY_BUFFERS_TO_TEXTURE: {
+            auto *texture = lookup<Texture>(reader);
+            BufferTextureCopyList regions;
+            BufferDataList buffers;
+            deserializeTextureUpload(reader, regions, buffers);
+            if (!texture || !reader.isValid()) return false;
+            cmdBuff->copyBuffersToTexture(buffers, texture, regions);
+            _stats.bytesUploaded += getTextureUploadSize(texture->getInfo(), regions.data(), static_cast<uint32_t>(regions.size()));
+        } break;
+        case RecordOp::CMD_BLIT_TEXTURE: {
+            auto *srcTexture = lookup<Texture>(reader);
+            auto *dstTexture = lookup<Texture>(reader);
+            TextureBlitList regions(reader.readCount());
+            reader.readBytes(regions.data(), static_cast<uint32_t>(regions.size() * sizeof(TextureBlit)));
+            const auto filter = reader.read<Filter>();
+            cmdBuff->blitTexture(srcTexture, dstTexture, regions, filter);
+        } break;
+        case RecordOp::CMD_COPY_TEXTURE:
+        case RecordOp::CMD_RESOLVE_TEXTURE: {
+            auto *srcTexture = lookup<Texture>(reader);
+            auto *dstTexture = lookup<Texture>(reader);
+            ccstd::vector<TextureCopy> regions(reader.readCount());
+            reader.readBytes(regions.data(), static_cast<uint32_t>(regions.size() * sizeof(TextureCopy)));
+            const auto count = static_cast<uint32_t>(regions.size());
+            if (op == RecordOp::CMD_COPY_TEXTURE) {
+                cmdBuff->copyTexture(srcTexture, dstTexture, regions.data(), count);
+            } else {
+                cmdBuff->resolveTexture(srcTexture, dstTexture, regions.data(), count);
+            }
+        } break;
+        case RecordOp::CMD_EXECUTE: {
+            _cmdBuffs.resize(reader.readCount());
+            for (auto &secondaryCB : _cmdBuffs) {
+                secondaryCB = lookup<CommandBuffer>(reader);
+                if (!secondaryCB) return false;
+            }
+            cmdBuff->execute(_cmdBuffs, static_cast<uint32_t>(_cmdBuffs.size()));
+        } break;
+        case RecordOp::CMD_DISPATCH: {
+            DispatchInfo info;
+            info.groupCountX = reader.read<uint32_t>();
+            info.groupCountY = reader.read<uint32_t>();
+            info.groupCountZ = reader.read<uint32_t>();
+            info.indirectBuffer = lookup<Buffer>(reader);
+            info.indirectOffset = reader.read<uint32_t>();
+            cmdBuff->dispatch(info);
+            ++_stats.dispatches;
+        } break;
+        case RecordOp::CMD_PIPELINE_BARRIER: {
+            const GeneralBarrier *barrier = deserializeGeneralBarrier(reader, _device);
+            const auto bufferBarrierCount = reader.readCount();
+            _bufferBarriers.resize(bufferBarrierCount);
+            _barrierBuffers.resize(bufferBarrierCount);
+            for (uint32_t i = 0U; i < bufferBarrierCount; ++i) {
+                _bufferBarriers[i] = deserializeBufferBarrier(reader, _device);
+                _barrierBuffers[i] = lookup<Buffer>(reader);
+            }
+            const auto textureBarrierCount = reader.readCount();
+            _textureBarriers.resize(textureBarrierCount);
+            _barrierTextures.resize(textureBarrierCount);
+            for (uint32_t i = 0U; i < textureBarrierCount; ++i) {
+                _textureBarriers[i] = deserializeTextureBarrier(reader, _device);
+                _barrierTextures[i] = lookup<Texture>(reader);
+            }
+            cmdBuff->pipelineBarrier(barrier, _bufferBarriers.data(), _barrierBuffers.data(), bufferBarrierCount,
+                                     _textureBarriers.data(), _barrierTextures.data(), textureBarrierCount);
+            ++_stats.barriers;
+        } break;
+        case RecordOp::CMD_BEGIN_QUERY:
+        case RecordOp::CMD_END_QUERY: {
+            auto *queryPool = lookup<QueryPool>(reader);
+            const auto id = reader.read<uint32_t>();
+            if (!queryPool) return false;
+            if (op == RecordOp::CMD_BEGIN_QUERY) {
+                cmdBuff->beginQuery(queryPool, id);
+            } else {
+                cmdBuff->endQuery(queryPool, id);
+            }
+        } break;
+        case RecordOp::CMD_RESET_QUERY_POOL: {
+            auto *queryPool = lookup<QueryPool>(reader);
+            if (!queryPool) return false;
+            cmdBuff->resetQueryPool(queryPool);
+        } break;
+        case RecordOp::CMD_COMPLETE_QUERY_POOL: {
+            auto *queryPool = lookup<QueryPool>(reader);
+            if (!queryPool) return false;
+            cmdBuff->completeQueryPool(queryPool);
+        } break;
+        default:
+            return false;
+    }
+
+    return reader.isValid();
+}
+
+} // namespace gfx
+} // namespace cc
@@ -0,0 +1,99 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include "base/std/container/unordered_map.h"
+#include "base/std/container/vector.h"
+#include "gfx-base/GFXDef-common.h"
+
+#include "RecorderUtils.h"
+
+namespace cc {
+namespace gfx {
+
+class Device;
+class Swapchain;
+
+/**
+ * Replays a frame captured by `DeviceRecorder` on any device.
+ *
+ * Every `replay` re-creates the captured resources with their recorded contents and
+ * re-submits the captured frame, so it can be invoked repeatedly to profile one frame
+ * in isolation. Swapchain textures resolve to the swapchain set by `setSwapchain`,
+ * or to offscreen textures of the recorded size when there is none.
+ */
+class CC_DLL CaptureReplayer final {
+public:
+    explicit CaptureReplayer(Device *device);
+    ~CaptureReplayer();
+
+    bool load(ccstd::vector<uint8_t> &&capture);
+    bool replay();
+    void destroy();
+
+    inline void setSwapchain(Swapchain *swapchain) { _swapchain = swapchain; }
+    // counted while replaying
+    inline const RecorderFrameStats &getStats() const { return _stats; }
+    // as recorded by the capturing device
+    inline const RecorderFrameStats &getRecordedStats() const { return _recordedStats; }
+
+private:
+    bool replayRecord(CaptureReader &reader, RecordOp op);
+    bool replayCommand(CaptureReader &reader, RecordOp op, CommandBuffer *cmdBuff);
+    void replayDescriptors(CaptureReader &reader, DescriptorSet *descriptorSet);
+
+    template <typename T>
+    T *lookup(CaptureReader &reader) {
+        const auto id = reader.read<uint32_t>();
+        auto iter = _objects.find(id);
+        return iter != _objects.end() ? static_cast<T *>(iter->second) : nullptr;
+    }
+
+    // objects re-created within one replay stay alive until the next one,
+    // commands recorded before the re-creation may still use them
+    void own(uint32_t id, GFXObject *object);
+    void destroyObjects();
+
+    Device *_device{nullptr};
+    Swapchain *_swapchain{nullptr};
+
+    ccstd::vector<uint8_t> _capture;
+    ccstd::unordered_map<uint32_t, GFXObject *> _objects;
+    ccstd::vector<GFXObject *> _ownedObjects;
+
+    RecorderFrameStats _stats;
+    RecorderFrameStats _recordedStats;
+
+    ccstd::vector<Color> _colors;
+    ccstd::vector<uint32_t> _dynamicOffsets;
+    ccstd::vector<CommandBuffer *> _cmdBuffs;
+    ccstd::vector<const BufferBarrier *> _bufferBarriers;
+    ccstd::vector<const Buffer *> _barrierBuffers;
+    ccstd::vector<const TextureBarrier *> _textureBarriers;
+    ccstd::vector<const Texture *> _barrierTextures;
+};
+
+} // namespace gfx
+} // namespace cc
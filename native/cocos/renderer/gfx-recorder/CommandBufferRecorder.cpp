@@ -0,0 +1,532 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+
+#include "BufferRecorder.h"
+#include "CommandBufferRecorder.h"
+#include "DescriptorSetRecorder.h"
+#include "DeviceRecorder.h"
+#include "FramebufferRecorder.h"
+#include "InputAssemblerRecorder.h"
+#include "PipelineStateRecorder.h"
+#include "QueryPoolRecorder.h"
+#include "QueueRecorder.h"
+#include "RenderPassRecorder.h"
+#include "TextureRecorder.h"
+
+namespace cc {
+namespace gfx {
+
+CommandBufferRecorder::CommandBufferRecorder(CommandBuffer *actor)
+: Agent<CommandBuffer>(actor) {
+    _typedID = actor->getTypedID();
+}
+
+CommandBufferRecorder::~CommandBufferRecorder() {
+    CC_SAFE_DELETE(_actor);
+}
+
+void CommandBufferRecorder::doInit(const CommandBufferInfo &info) {
+    DeviceRecorder::getInstance()->forget(this);
+
+    CommandBufferInfo actorInfo = info;
+    actorInfo.queue = static_cast<QueueRecorder *>(info.queue)->getActor();
+
+    _actor->initialize(actorInfo);
+}
+
+void CommandBufferRecorder::doDestroy() {
+    _commands.clear();
+    _capturing = false;
+
+    _actor->destroy();
+}
+
+void CommandBufferRecorder::begin(RenderPass *renderPass, uint32_t subpass, Framebuffer *frameBuffer) {
+    auto *device = DeviceRecorder::getInstance();
+    // latch the capture state, a command buffer is either captured as a whole or not at all
+    _capturing = device->isCapturing();
+    _commands.clear();
+    _stats = {};
+
+    if (_capturing) {
+        device->reference(static_cast<RenderPassRecorder *>(renderPass));
+        device->reference(static_cast<FramebufferRecorder *>(frameBuffer));
+        _commands.writeOp(RecordOp::CMD_BEGIN);
+        _commands.writeID(renderPass);
+        _commands.write(subpass);
+        _commands.writeID(frameBuffer);
+    }
+
+    RenderPass *renderPassActor = renderPass ? static_cast<RenderPassRecorder *>(renderPass)->getActor() : nullptr;
+    Framebuffer *framebufferActor = frameBuffer ? static_cast<FramebufferRecorder *>(frameBuffer)->getActor() : nullptr;
+
+    _actor->begin(renderPassActor, subpass, framebufferActor);
+}
+
+void CommandBufferRecorder::end() {
+    auto *device = DeviceRecorder::getInstance();
+    if (_capturing) {
+        _commands.writeOp(RecordOp::CMD_END);
+        device->appendCommandBlock(this, _commands);
+        _commands.clear();
+        _capturing = false;
+    }
+    device->mergeFrameStats(_stats);
+    _stats = {};
+
+    _actor->end();
+}
+
+void CommandBufferRecorder::beginRenderPass(RenderPass *renderPass, Framebuffer *fbo, const Rect &renderArea, const Color *colors, float depth, uint32_t stencil, CommandBuffer *const *secondaryCBs, uint32_t secondaryCBCount) {
+    ++_stats.renderPasses;
+
+    if (_capturing) {
+        auto *device = DeviceRecorder::getInstance();
+        device->reference(static_cast<RenderPassRecorder *>(renderPass));
+        device->reference(static_cast<FramebufferRecorder *>(fbo));
+
+        const auto colorCount = static_cast<uint32_t>(renderPass->getColorAttachments().size());
+        _commands.writeOp(RecordOp::CMD_BEGIN_RENDER_PASS);
+        _commands.writeID(renderPass);
+        _commands.writeID(fbo);
+        _commands.write(renderArea);
+        _commands.write(colorCount);
+        _commands.writeBytes(colors, colorCount * sizeof(Color));
+        _commands.write(depth);
+        _commands.write(stencil);
+        _commands.write(secondaryCBCount);
+        for (uint32_t i = 0U; i < secondaryCBCount; ++i) {
+            _commands.writeID(secondaryCBs[i]);
+        }
+    }
+
+    _cmdBuffActors.resize(secondaryCBCount);
+
+    CommandBuffer **actorSecondaryCBs = nullptr;
+    if (secondaryCBCount) {
+        actorSecondaryCBs = _cmdBuffActors.data();
+        for (uint32_t i = 0; i < secondaryCBCount; ++i) {
+            actorSecondaryCBs[i] = static_cast<CommandBufferRecorder *>(secondaryCBs[i])->getActor();
+        }
+    }
+
+    RenderPass *renderPassActor = static_cast<RenderPassRecorder *>(renderPass)->getActor();
+    Framebuffer *framebufferActor = static_cast<FramebufferRecorder *>(fbo)->getActor();
+
+    _actor->beginRenderPass(renderPassActor, framebufferActor, renderArea, colors, depth, stencil, actorSecondaryCBs, secondaryCBCount);
+}
+
+void CommandBufferRecorder::nextSubpass() {
+    if (_capturing) _commands.writeOp(RecordOp::CMD_NEXT_SUBPASS);
+
+    _actor->nextSubpass();
+}
+
+void CommandBufferRecorder::endRenderPass() {
+    if (_capturing) _commands.writeOp(RecordOp::CMD_END_RENDER_PASS);
+
+    _actor->endRenderPass();
+}
+
+void CommandBufferRecorder::insertMarker(const MarkerInfo &marker) {
+    if (_capturing) {
+        _commands.writeOp(RecordOp::CMD_INSERT_MARKER);
+        serialize(_commands, marker);
+    }
+
+    _actor->insertMarker(marker);
+}
+
+void CommandBufferRecorder::beginMarker(const MarkerInfo &marker) {
+    if (_capturing) {
+        _commands.writeOp(RecordOp::CMD_BEGIN_MARKER);
+        serialize(_commands, marker);
+    }
+
+    _actor->beginMarker(marker);
+}
+
+void CommandBufferRecorder::endMarker() {
+    if (_capturing) _commands.writeOp(RecordOp::CMD_END_MARKER);
+
+    _actor->endMarker();
+}
+
+void CommandBufferRecorder::execute(CommandBuffer *const *cmdBuffs, uint32_t count) {
+    if (!count) return;
+
+    if (_capturing) {
+        _commands.writeOp(RecordOp::CMD_EXECUTE);
+        _commands.write(count);
+        for (uint32_t i = 0U; i < count; ++i) {
+            _commands.writeID(cmdBuffs[i]);
+        }
+    }
+
+    _cmdBuffActors.resize(count);
+
+    for (uint32_t i = 0U; i < count; ++i) {
+        _cmdBuffActors[i] = static_cast<CommandBufferRecorder *>(cmdBuffs[i])->getActor();
+    }
+
+    _actor->execute(_cmdBuffActors.data(), count);
+}
+
+void CommandBufferRecorder::bindPipelineState(PipelineState *pso) {
+    ++_stats.pipelineBinds;
+
+    if (_capturing) {
+        DeviceRecorder::getInstance()->reference(static_cast<PipelineStateRecorder *>(pso));
+        _commands.writeOp(RecordOp::CMD_BIND_PIPELINE_STATE);
+        _commands.writeID(pso);
+    }
+
+    _actor->bindPipelineState(static_cast<PipelineStateRecorder *>(pso)->getActor());
+}
+
+void CommandBufferRecorder::bindDescriptorSet(uint32_t set, DescriptorSet *descriptorSet, uint32_t dynamicOffsetCount, const uint32_t *dynamicOffsets) {
+    ++_stats.descriptorSetBinds;
+
+    if (_capturing) {
+        DeviceRecorder::getInstance()->reference(static_cast<DescriptorSetRecorder *>(descriptorSet));
+        _commands.writeOp(RecordOp::CMD_BIND_DESCRIPTOR_SET);
+        _commands.write(set);
+        _commands.writeID(descriptorSet);
+        _commands.write(dynamicOffsetCount);
+        _commands.writeBytes(dynamicOffsets, dynamicOffsetCount * sizeof(uint32_t));
+    }
+
+    _actor->bindDescriptorSet(set, static_cast<DescriptorSetRecorder *>(descriptorSet)->getActor(), dynamicOffsetCount, dynamicOffsets);
+}
+
+void CommandBufferRecorder::bindInputAssembler(InputAssembler *ia) {
+    ++_stats.inputAssemblerBinds;
+
+    if (_capturing) {
+        DeviceRecorder::getInstance()->reference(static_cast<InputAssemblerRecorder *>(ia));
+        _commands.writeOp(RecordOp::CMD_BIND_INPUT_ASSEMBLER);
+        _commands.writeID(ia);
+    }
+
+    _actor->bindInputAssembler(static_cast<InputAssemblerRecorder *>(ia)->getActor());
+}
+
+void CommandBufferRecorder::setViewport(const Viewport &vp) {
+    if (_capturing) {
+        _commands.writeOp(RecordOp::CMD_SET_VIEWPORT);
+        _commands.write(vp);
+    }
+
+    _actor->setViewport(vp);
+}
+
+void CommandBufferRecorder::setScissor(const Rect &rect) {
+    if (_capturing) {
+        _commands.writeOp(RecordOp::CMD_SET_SCISSOR);
+        _commands.write(rect);
+    }
+
+    _actor->setScissor(rect);
+}
+
+void CommandBufferRecorder::setLineWidth(float width) {
+    if (_capturing) {
+        _commands.writeOp(RecordOp::CMD_SET_LINE_WIDTH);
+        _commands.write(width);
+    }
+
+    _actor->setLineWidth(width);
+}
+
+void CommandBufferRecorder::setDepthBias(float constant, float clamp, float slope) {
+    if (_capturing) {
+        _commands.writeOp(RecordOp::CMD_SET_DEPTH_BIAS);
+        _commands.write(constant);
+        _commands.write(clamp);
+        _commands.write(slope);
+    }
+
+    _actor->setDepthBias(constant, clamp, slope);
+}
+
+void CommandBufferRecorder::setBlendConstants(const Color &constants) {
+    if (_capturing) {
+        _commands.writeOp(RecordOp::CMD_SET_BLEND_CONSTANTS);
+        _commands.write(constants);
+    }
+
+    _actor->setBlendConstants(constants);
+}
+
+void CommandBufferRecorder::setDepthBound(float minBounds, float maxBounds) {
+    if (_capturing) {
+        _commands.writeOp(RecordOp::CMD_SET_DEPTH_BOUND);
+        _commands.write(minBounds);
+        _commands.write(maxBounds);
+    }
+
+    _actor->setDepthBound(minBounds, maxBounds);
+}
+
+void CommandBufferRecorder::setStencilWriteMask(StencilFace face, uint32_t mask) {
+    if (_capturing) {
+        _commands.writeOp(RecordOp::CMD_SET_STENCIL_WRITE_MASK);
+        _commands.write(face);
+        _commands.write(mask);
+    }
+
+    _actor->setStencilWriteMask(face, mask);
+}
+
+void CommandBufferRecorder::setStencilCompareMask(StencilFace face, uint32_t ref, uint32_t mask) {
+    if (_capturing) {
+        _commands.writeOp(RecordOp::CMD_SET_STENCIL_COMPARE_MASK);
+        _commands.write(face);
+        _commands.write(ref);
+        _commands.write(mask);
+    }
+
+    _actor->setStencilCompareMask(face, ref, mask);
+}
+
+void CommandBufferRecorder::draw(const DrawInfo &info) {
+    ++_stats.drawCalls;
+    _stats.instances += std::max(info.instanceCount, 1U);
+
+    if (_capturing) {
+        _commands.writeOp(RecordOp::CMD_DRAW);
+        _commands.write(info);
+    }
+
+    _actor->draw(info);
+}
+
+void CommandBufferRecorder::updateBuffer(Buffer *buff, const void *data, uint32_t size) {
+    auto *bufferRecorder = static_cast<BufferRecorder *>(buff);
+    _stats.bytesUploaded += size;
+
+    if (_capturing) {
+        DeviceRecorder::getInstance()->reference(bufferRecorder);
+        _commands.writeOp(RecordOp::CMD_UPDATE_BUFFER);
+        _commands.writeID(buff);
+        _commands.write(size);
+        _commands.writeBytes(data, size);
+    }
+    // keep the shadow copy in sync so later captures restore the latest contents
+    auto &contents = bufferRecorder->_contents;
+    memcpy(contents.data(), data, std::min(size, static_cast<uint32_t>(contents.size())));
+
+    _actor->updateBuffer(bufferRecorder->getActor(), data, size);
+}
+
+void CommandBufferRecorder::copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint32_t count) {
+    _stats.bytesUploaded += getTextureUploadSize(texture->getInfo(), regions, count);
+
+    if (_capturing) {
+        DeviceRecorder::getInstance()->reference(static_cast<TextureRecorder *>(texture));
+        _commands.writeOp(RecordOp::CMD_COPY_BUFFERS_TO_TEXTURE);
+        _commands.writeID(texture);
+        serializeTextureUpload(_commands, texture->getInfo(), buffers, regions, count);
+    }
+
+    _actor->copyBuffersToTexture(buffers, static_cast<TextureRecorder *>(texture)->getActor(), regions, count);
+}
+
+void CommandBufferRecorder::recordTextureCopy(RecordOp op, Texture *srcTexture, Texture *dstTexture, const TextureCopy *regions, uint32_t count) {
+    auto *device = DeviceRecorder::getInstance();
+    device->reference(static_cast<TextureRecorder *>(srcTexture));
+    device->reference(static_cast<TextureRecorder *>(dstTexture));
+    _commands.writeOp(op);
+    _commands.writeID(srcTexture);
+    _commands.writeID(dstTexture);
+    _commands.write(count);
+    _commands.writeBytes(regions, count * sizeof(TextureCopy));
+}
+
+void CommandBufferRecorder::resolveTexture(Texture *srcTexture, Texture *dstTexture, const TextureCopy *regions, uint32_t count) {
+    if (_capturing) recordTextureCopy(RecordOp::CMD_RESOLVE_TEXTURE, srcTexture, dstTexture, regions, count);
+
+    Texture *actorSrcTexture = nullptr;
+    Texture *actorDstTexture = nullptr;
+    if (srcTexture) actorSrcTexture = static_cast<TextureRecorder *>(srcTexture)->getActor();
+    if (dstTexture) actorDstTexture = static_cast<TextureRecorder *>(dstTexture)->getActor();
+
+    _actor->resolveTexture(actorSrcTexture, actorDstTexture, regions, count);
+}
+
+void CommandBufferRecorder::copyTexture(Texture *srcTexture, Texture *dstTexture, const TextureCopy *regions, uint32_t count) {
+    if (_capturing) recordTextureCopy(RecordOp::CMD_COPY_TEXTURE, srcTexture, dstTexture, regions, count);
+
+    Texture *actorSrcTexture = nullptr;
+    Texture *actorDstTexture = nullptr;
+    if (srcTexture) actorSrcTexture = static_cast<TextureRecorder *>(srcTexture)->getActor();
+    if (dstTexture) actorDstTexture = static_cast<TextureRecorder *>(dstTexture)->getActor();
+
+    _actor->copyTexture(actorSrcTexture, actorDstTexture, regions, count);
+}
+
+void CommandBufferRecorder::blitTexture(Texture *srcTexture, Texture *dstTexture, const TextureBlit *regions, uint32_t count, Filter filter) {
+    if (_capturing) {
+        auto *device = DeviceRecorder::getInstance();
+        device->reference(static_cast<TextureRecorder *>(srcTexture));
+        device->reference(static_cast<TextureRecorder *>(dstTexture));
+        _commands.writeOp(RecordOp::CMD_BLIT_TEXTURE);
+        _commands.writeID(srcTexture);
+        _commands.writeID(dstTexture);
+        _commands.write(count);
+        _commands.writeBytes(regions, count * sizeof(TextureBlit));
+        _commands.write(filter);
+    }
+
+    Texture *actorSrcTexture = nullptr;
+    Texture *actorDstTexture = nullptr;
+    if (srcTexture) actorSrcTexture = static_cast<TextureRecorder *>(srcTexture)->getActor();
+    if (dstTexture) actorDstTexture = static_cast<TextureRecorder *>(dstTexture)->getActor();
+
+    _actor->blitTexture(actorSrcTexture, actorDstTexture, regions, count, filter);
+}
+
+void CommandBufferRecorder::dispatch(const DispatchInfo &info) {
+    ++_stats.dispatches;
+
+    if (_capturing) {
+        DeviceRecorder::getInstance()->reference(static_cast<BufferRecorder *>(info.indirectBuffer));
+        _commands.writeOp(RecordOp::CMD_DISPATCH);
+        _commands.write(info.groupCountX);
+        _commands.write(info.groupCountY);
+        _commands.write(info.groupCountZ);
+        _commands.writeID(info.indirectBuffer);
+        _commands.write(info.indirectOffset);
+    }
+
+    DispatchInfo actorInfo = info;
+    if (info.indirectBuffer) actorInfo.indirectBuffer = static_cast<BufferRecorder *>(info.indirectBuffer)->getActor();
+
+    _actor->dispatch(actorInfo);
+}
+
+void CommandBufferRecorder::pipelineBarrier(const GeneralBarrier *barrier, const BufferBarrier *const *bufferBarriers, const Buffer *const *buffers, uint32_t bufferBarrierCount, const TextureBarrier *const *textureBarriers, const Texture *const *textures, uint32_t textureBarrierCount) {
+    ++_stats.barriers;
+
+    if (_capturing) {
+        auto *device = DeviceRecorder::getInstance();
+        _commands.writeOp(RecordOp::CMD_PIPELINE_BARRIER);
+        serialize(_commands, barrier);
+        _commands.write(bufferBarrierCount);
+        for (uint32_t i = 0U; i < bufferBarrierCount; ++i) {
+            device->reference(static_cast<const BufferRecorder *>(buffers[i]));
+            serialize(_commands, bufferBarriers[i]);
+            _commands.writeID(buffers[i]);
+        }
+        _commands.write(textureBarrierCount);
+        for (uint32_t i = 0U; i < textureBarrierCount; ++i) {
+            device->reference(static_cast<const TextureRecorder *>(textures[i]));
+            serialize(_commands, textureBarriers[i]);
+            _commands.writeID(textures[i]);
+        }
+    }
+
+    _textureActors.resize(textureBarrierCount);
+
+    Texture **actorTextures = nullptr;
+    if (textureBarrierCount) {
+        actorTextures = _textureActors.data();
+        for (uint32_t i = 0U; i < textureBarrierCount; ++i) {
+            actorTextures[i] = textures[i] ? static_cast<const TextureRecorder *>(textures[i])->getActor() : nullptr;
+        }
+    }
+
+    _bufferActors.resize(bufferBarrierCount);
+
+    Buffer **actorBuffers = nullptr;
+    if (bufferBarrierCount) {
+        actorBuffers = _bufferActors.data();
+        for (uint32_t i = 0U; i < bufferBarrierCount; ++i) {
+            actorBuffers[i] = buffers[i] ? static_cast<const BufferRecorder *>(buffers[i])->getActor() : nullptr;
+        }
+    }
+
+    _actor->pipelineBarrier(barrier, bufferBarriers, actorBuffers, bufferBarrierCount, textureBarriers, actorTextures, textureBarrierCount);
+}
+
+void CommandBufferRecorder::beginQuery(QueryPool *queryPool, uint32_t id) {
+    if (_capturing) {
+        DeviceRecorder::getInstance()->reference(static_cast<QueryPoolRecorder *>(queryPool));
+        _commands.writeOp(RecordOp::CMD_BEGIN_QUERY);
+        _commands.writeID(queryPool);
+        _commands.write(id);
+    }
+
+    _actor->beginQuery(static_cast<QueryPoolRecorder *>(queryPool)->getActor(), id);
+}
+
+void CommandBufferRecorder::endQuery(QueryPool *queryPool, uint32_t id) {
+    if (_capturing) {
+        DeviceRecorder::getInstance()->reference(static_cast<QueryPoolRecorder *>(queryPool));
+        _commands.writeOp(RecordOp::CMD_END_QUERY);
+        _commands.writeID(queryPool);
+        _commands.write(id);
+    }
+
+    _actor->endQuery(static_cast<QueryPoolRecorder *>(queryPool)->getActor(), id);
+}
+
+void CommandBufferRecorder::resetQueryPool(QueryPool *queryPool) {
+    if (_capturing) {
+        DeviceRecorder::getInstance()->reference(static_cast<QueryPoolRecorder *>(queryPool));
+        _commands.writeOp(RecordOp::CMD_RESET_QUERY_POOL);
+        _commands.writeID(queryPool);
+    }
+
+    _actor->resetQueryPool(static_cast<QueryPoolRecorder *>(queryPool)->getActor());
+}
+
+void CommandBufferRecorder::completeQueryPool(QueryPool *queryPool) {
+    if (_capturing) {
+        DeviceRecorder::getInstance()->reference(static_cast<QueryPoolRecorder *>(queryPool));
+        _commands.writeOp(RecordOp::CMD_COMPLETE_QUERY_POOL);
+        _commands.writeID(queryPool);
+    }
+
+    _actor->completeQueryPool(static_cast<QueryPoolRecorder *>(queryPool)->getActor());
+}
+
+void CommandBufferRecorder::customCommand(CustomCommand &&cmd) {
+    // opaque callbacks can't be serialized, they are skipped in captures
+    _actor->customCommand(std::move(cmd));
+}
+
+void CommandBufferRecorder::record(CaptureWriter &writer) const {
+    DeviceRecorder::getInstance()->reference(static_cast<QueueRecorder *>(_queue));
+    writer.writeOp(RecordOp::CREATE_COMMAND_BUFFER);
+    writer.writeID(this);
+    writer.writeID(_queue);
+    writer.write(_type);
+}
+
+} // namespace gfx
+} // namespace cc
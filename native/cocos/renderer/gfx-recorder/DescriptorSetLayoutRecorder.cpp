@@ -0,0 +1,60 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "DescriptorSetLayoutRecorder.h"
+#include "DeviceRecorder.h"
+
+namespace cc {
+namespace gfx {
+
+DescriptorSetLayoutRecorder::DescriptorSetLayoutRecorder(DescriptorSetLayout *actor)
+: Agent<DescriptorSetLayout>(actor) {
+    _typedID = actor->getTypedID();
+}
+
+DescriptorSetLayoutRecorder::~DescriptorSetLayoutRecorder() {
+    CC_SAFE_DELETE(_actor);
+}
+
+void DescriptorSetLayoutRecorder::doInit(const DescriptorSetLayoutInfo &info) {
+    DeviceRecorder::getInstance()->forget(this);
+
+    _actor->initialize(info);
+}
+
+void DescriptorSetLayoutRecorder::doDestroy() {
+    _actor->destroy();
+}
+
+void DescriptorSetLayoutRecorder::record(CaptureWriter &writer) const {
+    DescriptorSetLayoutInfo info;
+    info.bindings = _bindings;
+
+    writer.writeOp(RecordOp::CREATE_DESCRIPTOR_SET_LAYOUT);
+    writer.writeID(this);
+    serialize(writer, info);
+}
+
+} // namespace gfx
+} // namespace cc
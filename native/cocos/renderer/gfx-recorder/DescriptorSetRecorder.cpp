@@ -0,0 +1,139 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "BufferRecorder.h"
+#include "DescriptorSetLayoutRecorder.h"
+#include "DescriptorSetRecorder.h"
+#include "DeviceRecorder.h"
+#include "TextureRecorder.h"
+
+namespace cc {
+namespace gfx {
+
+DescriptorSetRecorder::DescriptorSetRecorder(DescriptorSet *actor)
+: Agent<DescriptorSet>(actor) {
+    _typedID = actor->getTypedID();
+}
+
+DescriptorSetRecorder::~DescriptorSetRecorder() {
+    CC_SAFE_DELETE(_actor);
+}
+
+void DescriptorSetRecorder::doInit(const DescriptorSetInfo &info) {
+    DeviceRecorder::getInstance()->forget(this);
+
+    DescriptorSetInfo actorInfo;
+    actorInfo.layout = static_cast<const DescriptorSetLayoutRecorder *>(info.layout)->getActor();
+
+    _actor->initialize(actorInfo);
+}
+
+void DescriptorSetRecorder::doDestroy() {
+    _actor->destroy();
+}
+
+void DescriptorSetRecorder::update() {
+    if (!_isDirty) return;
+
+    recordUpdate();
+
+    _actor->update();
+    _isDirty = false;
+}
+
+void DescriptorSetRecorder::forceUpdate() {
+    recordUpdate();
+
+    _isDirty = true;
+    _actor->forceUpdate();
+    _isDirty = false;
+}
+
+void DescriptorSetRecorder::bindBuffer(uint32_t binding, Buffer *buffer, uint32_t index, AccessFlags flags) {
+    DescriptorSet::bindBuffer(binding, buffer, index, flags);
+
+    _actor->bindBuffer(binding, buffer ? static_cast<BufferRecorder *>(buffer)->getActor() : nullptr, index, flags);
+}
+
+void DescriptorSetRecorder::bindTexture(uint32_t binding, Texture *texture, uint32_t index, AccessFlags flags) {
+    DescriptorSet::bindTexture(binding, texture, index, flags);
+
+    _actor->bindTexture(binding, texture ? static_cast<TextureRecorder *>(texture)->getActor() : nullptr, index, flags);
+}
+
+void DescriptorSetRecorder::bindSampler(uint32_t binding, Sampler *sampler, uint32_t index) {
+    DescriptorSet::bindSampler(binding, sampler, index);
+
+    _actor->bindSampler(binding, sampler, index);
+}
+
+void DescriptorSetRecorder::recordUpdate() {
+    auto *device = DeviceRecorder::getInstance();
+    if (!device->isCapturing()) return;
+
+    // a set referenced for the first time is created with the current descriptors,
+    // the update record is only redundant in that case
+    device->reference(this);
+    referenceDescriptors();
+    device->writeRecord([&](CaptureWriter &writer) {
+        writer.writeOp(RecordOp::UPDATE_DESCRIPTOR_SET);
+        writer.writeID(this);
+        writeDescriptors(writer);
+    });
+}
+
+void DescriptorSetRecorder::referenceDescriptors() const {
+    auto *device = DeviceRecorder::getInstance();
+    for (const auto &buffer : _buffers) {
+        device->reference(static_cast<BufferRecorder *>(buffer.ptr));
+    }
+    for (const auto &texture : _textures) {
+        device->reference(static_cast<TextureRecorder *>(texture.ptr));
+    }
+}
+
+void DescriptorSetRecorder::writeDescriptors(CaptureWriter &writer) const {
+    // descriptors are stored in layout order, the replayed layout yields the same indices
+    writer.write(static_cast<uint32_t>(_buffers.size()));
+    for (size_t i = 0U; i < _buffers.size(); ++i) {
+        writer.writeID(_buffers[i].ptr);
+        writer.write(_buffers[i].flags);
+        writer.writeID(_textures[i].ptr);
+        writer.write(_textures[i].flags);
+        serialize(writer, _samplers[i].ptr);
+    }
+}
+
+void DescriptorSetRecorder::record(CaptureWriter &writer) const {
+    DeviceRecorder::getInstance()->reference(static_cast<const DescriptorSetLayoutRecorder *>(_layout));
+    referenceDescriptors();
+
+    writer.writeOp(RecordOp::CREATE_DESCRIPTOR_SET);
+    writer.writeID(this);
+    writer.writeID(_layout);
+    writeDescriptors(writer);
+}
+
+} // namespace gfx
+} // namespace cc
@@ -0,0 +1,374 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "base/Log.h"
+
+#include "BufferRecorder.h"
+#include "CommandBufferRecorder.h"
+#include "DescriptorSetLayoutRecorder.h"
+#include "DescriptorSetRecorder.h"
+#include "DeviceRecorder.h"
+#include "FramebufferRecorder.h"
+#include "InputAssemblerRecorder.h"
+#include "PipelineLayoutRecorder.h"
+#include "PipelineStateRecorder.h"
+#include "QueryPoolRecorder.h"
+#include "QueueRecorder.h"
+#include "RenderPassRecorder.h"
+#include "ShaderRecorder.h"
+#include "SwapchainRecorder.h"
+#include "TextureRecorder.h"
+
+#include <cstring>
+
+namespace cc {
+namespace gfx {
+
+DeviceRecorder *DeviceRecorder::instance = nullptr;
+
+DeviceRecorder *DeviceRecorder::getInstance() {
+    return DeviceRecorder::instance;
+}
+
+DeviceRecorder::DeviceRecorder(Device *device) : Agent(device) {
+    DeviceRecorder::instance = this;
+}
+
+DeviceRecorder::~DeviceRecorder() {
+    CC_SAFE_DELETE(_actor);
+    DeviceRecorder::instance = nullptr;
+}
+
+bool DeviceRecorder::doInit(const DeviceInfo &info) {
+    if (!_actor->initialize(info)) {
+        return false;
+    }
+    _api = _actor->getGfxAPI();
+    _deviceName = _actor->getDeviceName();
+    _queue = ccnew QueueRecorder(_actor->getQueue());
+    _queryPool = ccnew QueryPoolRecorder(_actor->getQueryPool());
+    _cmdBuff = ccnew CommandBufferRecorder(_actor->getCommandBuffer());
+    _renderer = _actor->getRenderer();
+    _vendor = _actor->getVendor();
+    _caps = _actor->_caps;
+    memcpy(_features.data(), _actor->_features.data(), static_cast<uint32_t>(Feature::COUNT) * sizeof(bool));
+    memcpy(_formatFeatures.data(), _actor->_formatFeatures.data(), static_cast<uint32_t>(Format::COUNT) * sizeof(FormatFeatureBit));
+
+    static_cast<CommandBufferRecorder *>(_cmdBuff)->_queue = _queue;
+
+    CC_LOG_INFO("Device recorder enabled.");
+
+    return true;
+}
+
+void DeviceRecorder::doDestroy() {
+    if (_cmdBuff) {
+        static_cast<CommandBufferRecorder *>(_cmdBuff)->_actor = nullptr;
+        delete _cmdBuff;
+        _cmdBuff = nullptr;
+    }
+    if (_queryPool) {
+        static_cast<QueryPoolRecorder *>(_queryPool)->_actor = nullptr;
+        delete _queryPool;
+        _queryPool = nullptr;
+    }
+    if (_queue) {
+        static_cast<QueueRecorder *>(_queue)->_actor = nullptr;
+        delete _queue;
+        _queue = nullptr;
+    }
+
+    _capturing = false;
+    _captureRequested = false;
+    _writer.clear();
+    _referenced.clear();
+    _capture.clear();
+
+    _actor->destroy();
+}
+
+void DeviceRecorder::acquire(Swapchain *const *swapchains, uint32_t count) {
+    if (_captureRequested) {
+        beginCapture(swapchains, count);
+    }
+
+    static ccstd::vector<Swapchain *> swapchainActors;
+    swapchainActors.resize(count);
+
+    for (uint32_t i = 0U; i < count; ++i) {
+        auto *swapchain = static_cast<SwapchainRecorder *>(swapchains[i]);
+        swapchainActors[i] = swapchain->getActor();
+    }
+
+    if (_onAcquire) _onAcquire->execute();
+    _actor->acquire(swapchainActors.data(), count);
+}
+
+void DeviceRecorder::present() {
+    {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+        _lastFrameStats = _frameStats;
+        _frameStats = {};
+        if (_capturing) {
+            endCapture();
+        }
+    }
+
+    _actor->present();
+}
+
+void DeviceRecorder::beginCapture(Swapchain *const *swapchains, uint32_t count) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    _captureRequested = false;
+    // the recorded stats cover the captured records only, so they compare to the replayed ones
+    _frameStats = {};
+
+    _writer.clear();
+    _referenced.clear();
+    _writer.write(CAPTURE_MAGIC);
+    _writer.write(CAPTURE_VERSION);
+
+    // the implicit device objects are mapped to their counterparts on replay
+    _writer.writeOp(RecordOp::DEVICE_OBJECTS);
+    _writer.writeID(_queue);
+    _writer.writeID(_cmdBuff);
+    _writer.writeID(_queryPool);
+    _referenced.emplace(_queue->getObjectID());
+    _referenced.emplace(_cmdBuff->getObjectID());
+    _referenced.emplace(_queryPool->getObjectID());
+
+    _capturing.store(true, std::memory_order_release);
+
+    for (uint32_t i = 0U; i < count; ++i) {
+        reference(static_cast<TextureRecorder *>(swapchains[i]->getColorTexture()));
+        reference(static_cast<TextureRecorder *>(swapchains[i]->getDepthStencilTexture()));
+    }
+
+    _writer.writeOp(RecordOp::FRAME_BEGIN);
+    _writer.write(count);
+    for (uint32_t i = 0U; i < count; ++i) {
+        _writer.writeID(swapchains[i]);
+    }
+}
+
+void DeviceRecorder::endCapture() {
+    _writer.writeOp(RecordOp::FRAME_END);
+    _writer.write(_lastFrameStats);
+
+    _capture = _writer.release();
+    _referenced.clear();
+    _capturing.store(false, std::memory_order_release);
+
+    CC_LOG_INFO("Frame captured, %u bytes.", static_cast<uint32_t>(_capture.size()));
+}
+
+void DeviceRecorder::forget(const GFXObject *object) {
+    if (!isCapturing()) return;
+
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    _referenced.erase(object->getObjectID());
+}
+
+void DeviceRecorder::appendCommandBlock(const CommandBuffer *cmdBuff, const CaptureWriter &commands) {
+    if (!isCapturing()) return;
+
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    if (!_capturing) return;
+
+    reference(static_cast<const CommandBufferRecorder *>(cmdBuff));
+    _writer.writeOp(RecordOp::COMMAND_BLOCK);
+    _writer.writeID(cmdBuff);
+    _writer.write(commands.size());
+    _writer.append(commands);
+}
+
+void DeviceRecorder::mergeFrameStats(const RecorderFrameStats &stats) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    _frameStats += stats;
+}
+
+CommandBuffer *DeviceRecorder::createCommandBuffer(const CommandBufferInfo &info, bool hasAgent) {
+    CommandBuffer *actor = _actor->createCommandBuffer(info, hasAgent);
+    return ccnew CommandBufferRecorder(actor);
+}
+
+Queue *DeviceRecorder::createQueue() {
+    Queue *actor = _actor->createQueue();
+    return ccnew QueueRecorder(actor);
+}
+
+QueryPool *DeviceRecorder::createQueryPool() {
+    QueryPool *actor = _actor->createQueryPool();
+    return ccnew QueryPoolRecorder(actor);
+}
+
+Swapchain *DeviceRecorder::createSwapchain() {
+    Swapchain *actor = _actor->createSwapchain();
+    return ccnew SwapchainRecorder(actor);
+}
+
+Buffer *DeviceRecorder::createBuffer() {
+    Buffer *actor = _actor->createBuffer();
+    return ccnew BufferRecorder(actor);
+}
+
+Texture *DeviceRecorder::createTexture() {
+    Texture *actor = _actor->createTexture();
+    return ccnew TextureRecorder(actor);
+}
+
+Shader *DeviceRecorder::createShader() {
+    Shader *actor = _actor->createShader();
+    return ccnew ShaderRecorder(actor);
+}
+
+InputAssembler *DeviceRecorder::createInputAssembler() {
+    InputAssembler *actor = _actor->createInputAssembler();
+    return ccnew InputAssemblerRecorder(actor);
+}
+
+RenderPass *DeviceRecorder::createRenderPass() {
+    RenderPass *actor = _actor->createRenderPass();
+    return ccnew RenderPassRecorder(actor);
+}
+
+Framebuffer *DeviceRecorder::createFramebuffer() {
+    Framebuffer *actor = _actor->createFramebuffer();
+    return ccnew FramebufferRecorder(actor);
+}
+
+DescriptorSet *DeviceRecorder::createDescriptorSet() {
+    DescriptorSet *actor = _actor->createDescriptorSet();
+    return ccnew DescriptorSetRecorder(actor);
+}
+
+DescriptorSetLayout *DeviceRecorder::createDescriptorSetLayout() {
+    DescriptorSetLayout *actor = _actor->createDescriptorSetLayout();
+    return ccnew DescriptorSetLayoutRecorder(actor);
+}
+
+PipelineLayout *DeviceRecorder::createPipelineLayout() {
+    PipelineLayout *actor = _actor->createPipelineLayout();
+    return ccnew PipelineLayoutRecorder(actor);
+}
+
+PipelineState *DeviceRecorder::createPipelineState() {
+    PipelineState *actor = _actor->createPipelineState();
+    return ccnew PipelineStateRecorder(actor);
+}
+
+Sampler *DeviceRecorder::getSampler(const SamplerInfo &info) {
+    return _actor->getSampler(info);
+}
+
+GeneralBarrier *DeviceRecorder::getGeneralBarrier(const GeneralBarrierInfo &info) {
+    return _actor->getGeneralBarrier(info);
+}
+
+TextureBarrier *DeviceRecorder::getTextureBarrier(const TextureBarrierInfo &info) {
+    return _actor->getTextureBarrier(info);
+}
+
+BufferBarrier *DeviceRecorder::getBufferBarrier(const BufferBarrierInfo &info) {
+    return _actor->getBufferBarrier(info);
+}
+
+void DeviceRecorder::copyBuffersToTexture(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint32_t count) {
+    auto *textureRecorder = static_cast<TextureRecorder *>(dst);
+
+    reference(textureRecorder);
+    writeRecord([&](CaptureWriter &writer) {
+        writer.writeOp(RecordOp::COPY_BUFFERS_TO_TEXTURE);
+        writer.writeID(dst);
+        serializeTextureUpload(writer, dst->getInfo(), buffers, regions, count);
+    });
+
+    RecorderFrameStats stats;
+    stats.bytesUploaded = getTextureUploadSize(dst->getInfo(), regions, count);
+    mergeFrameStats(stats);
+
+    _actor->copyBuffersToTexture(buffers, textureRecorder->getActor(), regions, count);
+}
+
+void DeviceRecorder::copyTextureToBuffers(Texture *src, uint8_t *const *buffers, const BufferTextureCopy *regions, uint32_t count) {
+    auto *textureRecorder = static_cast<TextureRecorder *>(src);
+
+    // read-backs only matter for the ordering of the replayed stream
+    reference(textureRecorder);
+    writeRecord([&](CaptureWriter &writer) {
+        writer.writeOp(RecordOp::COPY_TEXTURE_TO_BUFFERS);
+        writer.writeID(src);
+        writer.write(count);
+        writer.writeBytes(regions, count * sizeof(BufferTextureCopy));
+    });
+
+    _actor->copyTextureToBuffers(textureRecorder->getActor(), buffers, regions, count);
+}
+
+void DeviceRecorder::flushCommands(CommandBuffer *const *cmdBuffs, uint32_t count) {
+    if (!count) return;
+
+    writeRecord([&](CaptureWriter &writer) {
+        writer.writeOp(RecordOp::FLUSH_COMMANDS);
+        writer.write(count);
+        for (uint32_t i = 0U; i < count; ++i) {
+            writer.writeID(cmdBuffs[i]);
+        }
+    });
+
+    static ccstd::vector<CommandBuffer *> cmdBuffActors;
+    cmdBuffActors.resize(count);
+
+    for (uint32_t i = 0U; i < count; ++i) {
+        cmdBuffActors[i] = static_cast<CommandBufferRecorder *>(cmdBuffs[i])->getActor();
+    }
+
+    _actor->flushCommands(cmdBuffActors.data(), count);
+}
+
+void DeviceRecorder::getQueryPoolResults(QueryPool *queryPool) {
+    auto *actorQueryPool = static_cast<QueryPoolRecorder *>(queryPool)->getActor();
+
+    _actor->getQueryPoolResults(actorQueryPool);
+
+    auto *actorQueryPoolRecorder = static_cast<QueryPoolRecorder *>(actorQueryPool);
+    auto *queryPoolRecorder = static_cast<QueryPoolRecorder *>(queryPool);
+    std::lock_guard<std::mutex> lock(actorQueryPoolRecorder->_mutex);
+    queryPoolRecorder->_results = actorQueryPoolRecorder->_results;
+}
+
+void DeviceRecorder::enableAutoBarrier(bool en) {
+    _actor->enableAutoBarrier(en);
+}
+
+void DeviceRecorder::frameSync() {
+    _actor->frameSync();
+}
+
+SampleCount DeviceRecorder::getMaxSampleCount(Format format, TextureUsage usage, TextureFlags flags) const {
+    return _actor->getMaxSampleCount(format, usage, flags);
+}
+
+} // namespace gfx
+} // namespace cc
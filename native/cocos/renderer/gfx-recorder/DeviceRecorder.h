@@ -0,0 +1,177 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include "base/Agent.h"
+#include "base/std/container/unordered_set.h"
+#include "gfx-base/GFXDevice.h"
+
+#include "RecorderUtils.h"
+
+namespace cc {
+namespace gfx {
+
+/**
+ * A device layer that records the GFX command stream. Draw, bind, barrier and upload
+ * statistics are gathered every frame; on request, one whole frame (from `acquire` to
+ * `present`) is serialized into a self-contained binary capture, including every
+ * resource the frame references, which `CaptureReplayer` can replay on any backend.
+ *
+ * Buffers keep a CPU copy of their contents so captures can restore them;
+ * texture contents uploaded before the captured frame are not restored.
+ */
+class CC_DLL DeviceRecorder final : public Agent<Device> {
+public:
+    static DeviceRecorder *getInstance();
+
+    // Created by DeviceManager, or directly by tests wrapping an EmptyDevice. Takes ownership of the device.
+    explicit DeviceRecorder(Device *device);
+    ~DeviceRecorder() override;
+
+    using Device::copyBuffersToTexture;
+    using Device::createBuffer;
+    using Device::createBufferBarrier;
+    using Device::createCommandBuffer;
+    using Device::createDescriptorSet;
+    using Device::createDescriptorSetLayout;
+    using Device::createFramebuffer;
+    using Device::createGeneralBarrier;
+    using Device::createInputAssembler;
+    using Device::createPipelineLayout;
+    using Device::createPipelineState;
+    using Device::createQueryPool;
+    using Device::createQueue;
+    using Device::createRenderPass;
+    using Device::createSampler;
+    using Device::createShader;
+    using Device::createTexture;
+    using Device::createTextureBarrier;
+
+    void frameSync() override;
+    void acquire(Swapchain *const *swapchains, uint32_t count) override;
+    void present() override;
+
+    CommandBuffer *createCommandBuffer(const CommandBufferInfo &info, bool hasAgent) override;
+    Queue *createQueue() override;
+    QueryPool *createQueryPool() override;
+    Swapchain *createSwapchain() override;
+    Buffer *createBuffer() override;
+    Texture *createTexture() override;
+    Shader *createShader() override;
+    InputAssembler *createInputAssembler() override;
+    RenderPass *createRenderPass() override;
+    Framebuffer *createFramebuffer() override;
+    DescriptorSet *createDescriptorSet() override;
+    DescriptorSetLayout *createDescriptorSetLayout() override;
+    PipelineLayout *createPipelineLayout() override;
+    PipelineState *createPipelineState() override;
+
+    Sampler *getSampler(const SamplerInfo &info) override;
+    GeneralBarrier *getGeneralBarrier(const GeneralBarrierInfo &info) override;
+    TextureBarrier *getTextureBarrier(const TextureBarrierInfo &info) override;
+    BufferBarrier *getBufferBarrier(const BufferBarrierInfo &info) override;
+
+    void copyBuffersToTexture(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint32_t count) override;
+    void copyTextureToBuffers(Texture *src, uint8_t *const *buffers, const BufferTextureCopy *region, uint32_t count) override;
+    void getQueryPoolResults(QueryPool *queryPool) override;
+
+    void flushCommands(CommandBuffer *const *cmdBuffs, uint32_t count) override;
+    MemoryStatus &getMemoryStatus() override { return _actor->getMemoryStatus(); }
+    uint32_t getNumDrawCalls() const override { return _actor->getNumDrawCalls(); }
+    uint32_t getNumInstances() const override { return _actor->getNumInstances(); }
+    uint32_t getNumTris() const override { return _actor->getNumTris(); }
+    bool isMultithreadedCommandRecording() const override { return _actor->isMultithreadedCommandRecording(); }
+
+    void enableAutoBarrier(bool enable) override;
+    SampleCount getMaxSampleCount(Format format, TextureUsage usage, TextureFlags flags) const override;
+
+    // capture the next frame, the result is available through `getCapture` after its `present`
+    inline void requestCapture() { _captureRequested = true; }
+    inline bool isCapturing() const { return _capturing.load(std::memory_order_acquire); }
+    inline const ccstd::vector<uint8_t> &getCapture() const { return _capture; }
+    inline const RecorderFrameStats &getFrameStats() const { return _lastFrameStats; }
+
+    // emits the creation record of `object` (and its dependencies) on its first reference in the current capture
+    template <typename T>
+    void reference(T *object);
+    // the object has been re-initialized, emit its creation record again on the next reference
+    void forget(const GFXObject *object);
+
+    // writes a device level record, `fn` is only invoked while capturing
+    template <typename Fn>
+    void writeRecord(Fn &&fn);
+
+    void appendCommandBlock(const CommandBuffer *cmdBuff, const CaptureWriter &commands);
+    void mergeFrameStats(const RecorderFrameStats &stats);
+
+protected:
+    static DeviceRecorder *instance;
+
+    friend class DeviceManager;
+
+    bool doInit(const DeviceInfo &info) override;
+    void doDestroy() override;
+
+    void bindContext(bool bound) override { _actor->bindContext(bound); }
+
+    void beginCapture(Swapchain *const *swapchains, uint32_t count);
+    void endCapture();
+
+    std::recursive_mutex _mutex;
+    std::atomic<bool> _capturing{false};
+    bool _captureRequested{false};
+
+    CaptureWriter _writer;
+    ccstd::unordered_set<uint32_t> _referenced;
+    ccstd::vector<uint8_t> _capture;
+
+    RecorderFrameStats _frameStats;
+    RecorderFrameStats _lastFrameStats;
+};
+
+template <typename T>
+void DeviceRecorder::reference(T *object) {
+    if (!object || !isCapturing()) return;
+
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    if (_capturing && _referenced.emplace(object->getObjectID()).second) {
+        object->record(_writer);
+    }
+}
+
+template <typename Fn>
+void DeviceRecorder::writeRecord(Fn &&fn) {
+    if (!isCapturing()) return;
+
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    if (_capturing) {
+        fn(_writer);
+    }
+}
+
+} // namespace gfx
+} // namespace cc
@@ -0,0 +1,87 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "DeviceRecorder.h"
+#include "FramebufferRecorder.h"
+#include "RenderPassRecorder.h"
+#include "TextureRecorder.h"
+
+namespace cc {
+namespace gfx {
+
+FramebufferRecorder::FramebufferRecorder(Framebuffer *actor)
+: Agent<Framebuffer>(actor) {
+    _typedID = actor->getTypedID();
+}
+
+FramebufferRecorder::~FramebufferRecorder() {
+    CC_SAFE_DELETE(_actor);
+}
+
+void FramebufferRecorder::doInit(const FramebufferInfo &info) {
+    DeviceRecorder::getInstance()->forget(this);
+
+    FramebufferInfo actorInfo = info;
+    for (uint32_t i = 0U; i < info.colorTextures.size(); ++i) {
+        if (info.colorTextures[i]) {
+            actorInfo.colorTextures[i] = static_cast<TextureRecorder *>(info.colorTextures[i])->getActor();
+        }
+    }
+    if (info.depthStencilTexture) {
+        actorInfo.depthStencilTexture = static_cast<TextureRecorder *>(info.depthStencilTexture)->getActor();
+    }
+    if (info.depthStencilResolveTexture) {
+        actorInfo.depthStencilResolveTexture = static_cast<TextureRecorder *>(info.depthStencilResolveTexture)->getActor();
+    }
+    actorInfo.renderPass = static_cast<RenderPassRecorder *>(info.renderPass)->getActor();
+
+    _actor->initialize(actorInfo);
+}
+
+void FramebufferRecorder::doDestroy() {
+    _actor->destroy();
+}
+
+void FramebufferRecorder::record(CaptureWriter &writer) const {
+    auto *device = DeviceRecorder::getInstance();
+    device->reference(static_cast<RenderPassRecorder *>(_renderPass));
+    for (auto *colorTexture : _colorTextures) {
+        device->reference(static_cast<TextureRecorder *>(colorTexture));
+    }
+    device->reference(static_cast<TextureRecorder *>(_depthStencilTexture));
+    device->reference(static_cast<TextureRecorder *>(_depthStencilResolveTexture));
+
+    writer.writeOp(RecordOp::CREATE_FRAMEBUFFER);
+    writer.writeID(this);
+    writer.writeID(_renderPass);
+    writer.write(static_cast<uint32_t>(_colorTextures.size()));
+    for (const auto *colorTexture : _colorTextures) {
+        writer.writeID(colorTexture);
+    }
+    writer.writeID(_depthStencilTexture);
+    writer.writeID(_depthStencilResolveTexture);
+}
+
+} // namespace gfx
+} // namespace cc
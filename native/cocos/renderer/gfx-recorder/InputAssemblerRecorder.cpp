@@ -0,0 +1,83 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "BufferRecorder.h"
+#include "DeviceRecorder.h"
+#include "InputAssemblerRecorder.h"
+
+namespace cc {
+namespace gfx {
+
+InputAssemblerRecorder::InputAssemblerRecorder(InputAssembler *actor)
+: Agent<InputAssembler>(actor) {
+    _typedID = actor->getTypedID();
+}
+
+InputAssemblerRecorder::~InputAssemblerRecorder() {
+    CC_SAFE_DELETE(_actor);
+}
+
+void InputAssemblerRecorder::doInit(const InputAssemblerInfo &info) {
+    DeviceRecorder::getInstance()->forget(this);
+
+    InputAssemblerInfo actorInfo = info;
+    for (auto &vertexBuffer : actorInfo.vertexBuffers) {
+        vertexBuffer = static_cast<BufferRecorder *>(vertexBuffer)->getActor();
+    }
+    if (actorInfo.indexBuffer) {
+        actorInfo.indexBuffer = static_cast<BufferRecorder *>(actorInfo.indexBuffer)->getActor();
+    }
+    if (actorInfo.indirectBuffer) {
+        actorInfo.indirectBuffer = static_cast<BufferRecorder *>(actorInfo.indirectBuffer)->getActor();
+    }
+
+    _actor->initialize(actorInfo);
+}
+
+void InputAssemblerRecorder::doDestroy() {
+    _actor->destroy();
+}
+
+void InputAssemblerRecorder::record(CaptureWriter &writer) const {
+    auto *device = DeviceRecorder::getInstance();
+    for (auto *vertexBuffer : _vertexBuffers) {
+        device->reference(static_cast<BufferRecorder *>(vertexBuffer));
+    }
+    device->reference(static_cast<BufferRecorder *>(_indexBuffer));
+    device->reference(static_cast<BufferRecorder *>(_indirectBuffer));
+
+    writer.writeOp(RecordOp::CREATE_INPUT_ASSEMBLER);
+    writer.writeID(this);
+    serialize(writer, _attributes);
+    writer.write(static_cast<uint32_t>(_vertexBuffers.size()));
+    for (const auto *vertexBuffer : _vertexBuffers) {
+        writer.writeID(vertexBuffer);
+    }
+    writer.writeID(_indexBuffer);
+    writer.writeID(_indirectBuffer);
+    writer.write(_drawInfo);
+}
+
+} // namespace gfx
+} // namespace cc
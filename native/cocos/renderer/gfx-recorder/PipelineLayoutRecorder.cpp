@@ -0,0 +1,72 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "DescriptorSetLayoutRecorder.h"
+#include "DeviceRecorder.h"
+#include "PipelineLayoutRecorder.h"
+
+namespace cc {
+namespace gfx {
+
+PipelineLayoutRecorder::PipelineLayoutRecorder(PipelineLayout *actor)
+: Agent<PipelineLayout>(actor) {
+    _typedID = actor->getTypedID();
+}
+
+PipelineLayoutRecorder::~PipelineLayoutRecorder() {
+    CC_SAFE_DELETE(_actor);
+}
+
+void PipelineLayoutRecorder::doInit(const PipelineLayoutInfo &info) {
+    DeviceRecorder::getInstance()->forget(this);
+
+    PipelineLayoutInfo actorInfo;
+    actorInfo.setLayouts.resize(info.setLayouts.size());
+    for (uint32_t i = 0U; i < info.setLayouts.size(); i++) {
+        actorInfo.setLayouts[i] = static_cast<DescriptorSetLayoutRecorder *>(info.setLayouts[i])->getActor();
+    }
+
+    _actor->initialize(actorInfo);
+}
+
+void PipelineLayoutRecorder::doDestroy() {
+    _actor->destroy();
+}
+
+void PipelineLayoutRecorder::record(CaptureWriter &writer) const {
+    auto *device = DeviceRecorder::getInstance();
+    for (auto *setLayout : _setLayouts) {
+        device->reference(static_cast<DescriptorSetLayoutRecorder *>(setLayout));
+    }
+
+    writer.writeOp(RecordOp::CREATE_PIPELINE_LAYOUT);
+    writer.writeID(this);
+    writer.write(static_cast<uint32_t>(_setLayouts.size()));
+    for (const auto *setLayout : _setLayouts) {
+        writer.writeID(setLayout);
+    }
+}
+
+} // namespace gfx
+} // namespace cc
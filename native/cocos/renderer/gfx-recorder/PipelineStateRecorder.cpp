@@ -0,0 +1,80 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "DeviceRecorder.h"
+#include "PipelineLayoutRecorder.h"
+#include "PipelineStateRecorder.h"
+#include "RenderPassRecorder.h"
+#include "ShaderRecorder.h"
+
+namespace cc {
+namespace gfx {
+
+PipelineStateRecorder::PipelineStateRecorder(PipelineState *actor)
+: Agent<PipelineState>(actor) {
+    _typedID = actor->getTypedID();
+}
+
+PipelineStateRecorder::~PipelineStateRecorder() {
+    CC_SAFE_DELETE(_actor);
+}
+
+void PipelineStateRecorder::doInit(const PipelineStateInfo &info) {
+    DeviceRecorder::getInstance()->forget(this);
+
+    PipelineStateInfo actorInfo = info;
+    actorInfo.shader = static_cast<ShaderRecorder *>(info.shader)->getActor();
+    actorInfo.pipelineLayout = static_cast<PipelineLayoutRecorder *>(info.pipelineLayout)->getActor();
+    if (info.renderPass) actorInfo.renderPass = static_cast<RenderPassRecorder *>(info.renderPass)->getActor();
+
+    _actor->initialize(actorInfo);
+}
+
+void PipelineStateRecorder::doDestroy() {
+    _actor->destroy();
+}
+
+void PipelineStateRecorder::record(CaptureWriter &writer) const {
+    auto *device = DeviceRecorder::getInstance();
+    device->reference(static_cast<ShaderRecorder *>(_shader));
+    device->reference(static_cast<PipelineLayoutRecorder *>(_pipelineLayout));
+    device->reference(static_cast<RenderPassRecorder *>(_renderPass));
+
+    writer.writeOp(RecordOp::CREATE_PIPELINE_STATE);
+    writer.writeID(this);
+    writer.writeID(_shader);
+    writer.writeID(_pipelineLayout);
+    writer.writeID(_renderPass);
+    writer.write(_subpass);
+    serialize(writer, _inputState.attributes);
+    writer.write(_rasterizerState);
+    writer.write(_depthStencilState);
+    serialize(writer, _blendState);
+    writer.write(_primitive);
+    writer.write(_dynamicStates);
+    writer.write(_bindPoint);
+}
+
+} // namespace gfx
+} // namespace cc
@@ -0,0 +1,89 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "CommandBufferRecorder.h"
+#include "DeviceRecorder.h"
+#include "QueueRecorder.h"
+
+namespace cc {
+namespace gfx {
+
+QueueRecorder::QueueRecorder(Queue *actor)
+: Agent<Queue>(actor) {
+    _typedID = actor->getTypedID();
+}
+
+QueueRecorder::~QueueRecorder() {
+    CC_SAFE_DELETE(_actor);
+}
+
+void QueueRecorder::doInit(const QueueInfo &info) {
+    DeviceRecorder::getInstance()->forget(this);
+
+    _actor->initialize(info);
+}
+
+void QueueRecorder::doDestroy() {
+    _actor->destroy();
+}
+
+void QueueRecorder::submit(CommandBuffer *const *cmdBuffs, uint32_t count) {
+    if (!count) return;
+
+    auto *device = DeviceRecorder::getInstance();
+    device->reference(this);
+    for (uint32_t i = 0U; i < count; ++i) {
+        device->reference(static_cast<CommandBufferRecorder *>(cmdBuffs[i]));
+    }
+    device->writeRecord([&](CaptureWriter &writer) {
+        writer.writeOp(RecordOp::QUEUE_SUBMIT);
+        writer.writeID(this);
+        writer.write(count);
+        for (uint32_t i = 0U; i < count; ++i) {
+            writer.writeID(cmdBuffs[i]);
+        }
+    });
+
+    RecorderFrameStats stats;
+    stats.submits = 1U;
+    device->mergeFrameStats(stats);
+
+    static ccstd::vector<CommandBuffer *> cmdBuffActors;
+    cmdBuffActors.resize(count);
+
+    for (uint32_t i = 0U; i < count; ++i) {
+        cmdBuffActors[i] = static_cast<CommandBufferRecorder *>(cmdBuffs[i])->getActor();
+    }
+
+    _actor->submit(cmdBuffActors.data(), count);
+}
+
+void QueueRecorder::record(CaptureWriter &writer) const {
+    writer.writeOp(RecordOp::CREATE_QUEUE);
+    writer.writeID(this);
+    writer.write(_type);
+}
+
+} // namespace gfx
+} // namespace cc
@@ -0,0 +1,545 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "RecorderUtils.h"
+
+#include <algorithm>
+#include "gfx-base/GFXDevice.h"
+
+namespace cc {
+namespace gfx {
+
+namespace {
+
+template <typename T>
+void writeList(CaptureWriter &writer, const ccstd::vector<T> &list) {
+    writer.write(static_cast<uint32_t>(list.size()));
+    if (!list.empty()) {
+        writer.writeBytes(list.data(), static_cast<uint32_t>(list.size() * sizeof(T)));
+    }
+}
+
+template <typename T>
+void readList(CaptureReader &reader, ccstd::vector<T> &list) {
+    list.resize(reader.readCount());
+    if (!list.empty()) {
+        reader.readBytes(list.data(), static_cast<uint32_t>(list.size() * sizeof(T)));
+    }
+}
+
+// uniform descriptions only differ in a few fields, so they share one layout on the wire
+template <typename T>
+void writeUniforms(CaptureWriter &writer, const ccstd::vector<T> &uniforms) {
+    writer.write(static_cast<uint32_t>(uniforms.size()));
+    for (const auto &uniform : uniforms) {
+        writer.write(uniform.set);
+        writer.write(uniform.binding);
+        writer.writeString(uniform.name);
+        writer.write(uniform.count);
+        writer.write(uniform.flattened);
+    }
+}
+
+template <typename T>
+void readUniforms(CaptureReader &reader, ccstd::vector<T> &uniforms) {
+    uniforms.resize(reader.readCount());
+    for (auto &uniform : uniforms) {
+        uniform.set = reader.read<uint32_t>();
+        uniform.binding = reader.read<uint32_t>();
+        uniform.name = reader.readString();
+        uniform.count = reader.read<uint32_t>();
+        uniform.flattened = reader.read<uint32_t>();
+    }
+}
+
+void serialize(CaptureWriter &writer, const DepthStencilAttachment &attachment) {
+    writer.write(attachment.format);
+    writer.write(attachment.sampleCount);
+    writer.write(attachment.depthLoadOp);
+    writer.write(attachment.depthStoreOp);
+    writer.write(attachment.stencilLoadOp);
+    writer.write(attachment.stencilStoreOp);
+    serialize(writer, attachment.barrier);
+}
+
+void deserialize(CaptureReader &reader, DepthStencilAttachment &attachment, Device *device) {
+    attachment.format = reader.read<Format>();
+    attachment.sampleCount = reader.read<SampleCount>();
+    attachment.depthLoadOp = reader.read<LoadOp>();
+    attachment.depthStoreOp = reader.read<StoreOp>();
+    attachment.stencilLoadOp = reader.read<LoadOp>();
+    attachment.stencilStoreOp = reader.read<StoreOp>();
+    attachment.barrier = deserializeGeneralBarrier(reader, device);
+}
+
+uint32_t getRegionBufferCount(const TextureInfo &info, const BufferTextureCopy &region) {
+    // 3D textures take all slices from a single buffer, everything else takes one buffer per layer
+    return info.type == TextureType::TEX3D ? 1U : std::max(region.texSubres.layerCount, 1U);
+}
+
+uint32_t getRegionBufferSize(const TextureInfo &info, const BufferTextureCopy &region) {
+    const uint32_t width = region.buffStride > 0 ? region.buffStride : region.texExtent.width;
+    const uint32_t height = region.buffTexHeight > 0 ? region.buffTexHeight : region.texExtent.height;
+    const uint32_t depth = info.type == TextureType::TEX3D ? std::max(region.texExtent.depth, 1U) : 1U;
+    return formatSize(info.format, width, height, depth);
+}
+
+} // namespace
+
+RecorderFrameStats &RecorderFrameStats::operator+=(const RecorderFrameStats &rhs) {
+    drawCalls += rhs.drawCalls;
+    instances += rhs.instances;
+    dispatches += rhs.dispatches;
+    renderPasses += rhs.renderPasses;
+    pipelineBinds += rhs.pipelineBinds;
+    descriptorSetBinds += rhs.descriptorSetBinds;
+    inputAssemblerBinds += rhs.inputAssemblerBinds;
+    barriers += rhs.barriers;
+    submits += rhs.submits;
+    bytesUploaded += rhs.bytesUploaded;
+    return *this;
+}
+
+void CaptureWriter::writeBytes(const void *data, uint32_t size) {
+    if (!size) return;
+    const auto *bytes = static_cast<const uint8_t *>(data);
+    _data.insert(_data.end(), bytes, bytes + size);
+}
+
+void CaptureWriter::writeString(const ccstd::string &str) {
+    write(static_cast<uint32_t>(str.size()));
+    writeBytes(str.data(), static_cast<uint32_t>(str.size()));
+}
+
+void CaptureWriter::append(const CaptureWriter &other) {
+    _data.insert(_data.end(), other._data.begin(), other._data.end());
+}
+
+void CaptureReader::readBytes(void *dst, uint32_t size) {
+    const uint8_t *src = skip(size);
+    if (src) {
+        memcpy(dst, src, size);
+    } else {
+        memset(dst, 0, size);
+    }
+}
+
+ccstd::string CaptureReader::readString() {
+    auto size = read<uint32_t>();
+    const uint8_t *src = skip(size);
+    return src ? ccstd::string(reinterpret_cast<const char *>(src), size) : ccstd::string();
+}
+
+uint32_t CaptureReader::readCount() {
+    const auto count = read<uint32_t>();
+    if (!_valid || count > _size - _offset) {
+        _valid = false;
+        return 0U;
+    }
+    return count;
+}
+
+const uint8_t *CaptureReader::skip(uint32_t size) {
+    if (!_valid || size > _size - _offset) {
+        _valid = false;
+        return nullptr;
+    }
+    const uint8_t *result = _data + _offset;
+    _offset += size;
+    return result;
+}
+
+void serialize(CaptureWriter &writer, const AttributeList &attributes) {
+    writer.write(static_cast<uint32_t>(attributes.size()));
+    for (const auto &attribute : attributes) {
+        writer.writeString(attribute.name);
+        writer.write(attribute.format);
+        writer.write(attribute.isNormalized);
+        writer.write(attribute.stream);
+        writer.write(attribute.isInstanced);
+        writer.write(attribute.location);
+    }
+}
+
+void deserialize(CaptureReader &reader, AttributeList &attributes) {
+    attributes.resize(reader.readCount());
+    for (auto &attribute : attributes) {
+        attribute.name = reader.readString();
+        attribute.format = reader.read<Format>();
+        attribute.isNormalized = reader.read<bool>();
+        attribute.stream = reader.read<uint32_t>();
+        attribute.isInstanced = reader.read<bool>();
+        attribute.location = reader.read<uint32_t>();
+    }
+}
+
+void serialize(CaptureWriter &writer, const ShaderInfo &info) {
+    writer.writeString(info.name);
+    writer.write(info.hash);
+    writer.write(static_cast<uint32_t>(info.stages.size()));
+    for (const auto &stage : info.stages) {
+        writer.write(stage.stage);
+        writer.writeString(stage.source);
+    }
+    serialize(writer, info.attributes);
+    writer.write(static_cast<uint32_t>(info.blocks.size()));
+    for (const auto &block : info.blocks) {
+        writer.write(block.set);
+        writer.write(block.binding);
+        writer.writeString(block.name);
+        writer.write(static_cast<uint32_t>(block.members.size()));
+        for (const auto &member : block.members) {
+            writer.writeString(member.name);
+            writer.write(member.type);
+            writer.write(member.count);
+        }
+        writer.write(block.count);
+        writer.write(block.flattened);
+    }
+    writeUniforms(writer, info.buffers);
+    writeUniforms(writer, info.samplerTextures);
+    writeUniforms(writer, info.samplers);
+    writeUniforms(writer, info.textures);
+    writeUniforms(writer, info.images);
+    writeUniforms(writer, info.subpassInputs);
+    // the fields not covered by the shared layout
+    for (const auto &buffer : info.buffers) writer.write(buffer.memoryAccess);
+    for (const auto &samplerTexture : info.samplerTextures) writer.write(samplerTexture.type);
+    for (const auto &texture : info.textures) writer.write(texture.type);
+    for (const auto &image : info.images) {
+        writer.write(image.type);
+        writer.write(image.memoryAccess);
+    }
+}
+
+void deserialize(CaptureReader &reader, ShaderInfo &info) {
+    info.name = reader.readString();
+    info.hash = reader.read<ccstd::hash_t>();
+    info.stages.resize(reader.readCount());
+    for (auto &stage : info.stages) {
+        stage.stage = reader.read<ShaderStageFlagBit>();
+        stage.source = reader.readString();
+    }
+    deserialize(reader, info.attributes);
+    info.blocks.resize(reader.readCount());
+    for (auto &block : info.blocks) {
+        block.set = reader.read<uint32_t>();
+        block.binding = reader.read<uint32_t>();
+        block.name = reader.readString();
+        block.members.resize(reader.readCount());
+        for (auto &member : block.members) {
+            member.name = reader.readString();
+            member.type = reader.read<Type>();
+            member.count = reader.read<uint32_t>();
+        }
+        block.count = reader.read<uint32_t>();
+        block.flattened = reader.read<uint32_t>();
+    }
+    readUniforms(reader, info.buffers);
+    readUniforms(reader, info.samplerTextures);
+    readUniforms(reader, info.samplers);
+    readUniforms(reader, info.textures);
+    readUniforms(reader, info.images);
+    readUniforms(reader, info.subpassInputs);
+    for (auto &buffer : info.buffers) buffer.memoryAccess = reader.read<MemoryAccess>();
+    for (auto &samplerTexture : info.samplerTextures) samplerTexture.type = reader.read<Type>();
+    for (auto &texture : info.textures) texture.type = reader.read<Type>();
+    for (auto &image : info.images) {
+        image.type = reader.read<Type>();
+        image.memoryAccess = reader.read<MemoryAccess>();
+    }
+}
+
+void serialize(CaptureWriter &writer, const RenderPassInfo &info) {
+    writer.write(static_cast<uint32_t>(info.colorAttachments.size()));
+    for (const auto &attachment : info.colorAttachments) {
+        writer.write(attachment.format);
+        writer.write(attachment.sampleCount);
+        writer.write(attachment.loadOp);
+        writer.write(attachment.storeOp);
+        serialize(writer, attachment.barrier);
+    }
+    serialize(writer, info.depthStencilAttachment);
+    serialize(writer, info.depthStencilResolveAttachment);
+    writer.write(static_cast<uint32_t>(info.subpasses.size()));
+    for (const auto &subpass : info.subpasses) {
+        writeList(writer, subpass.inputs);
+        writeList(writer, subpass.colors);
+        writeList(writer, subpass.resolves);
+        writeList(writer, subpass.preserves);
+        writer.write(subpass.depthStencil);
+        writer.write(subpass.depthStencilResolve);
+        writer.write(subpass.shadingRate);
+        writer.write(subpass.depthResolveMode);
+        writer.write(subpass.stencilResolveMode);
+    }
+    writer.write(static_cast<uint32_t>(info.dependencies.size()));
+    for (const auto &dependency : info.dependencies) {
+        writer.write(dependency.srcSubpass);
+        writer.write(dependency.dstSubpass);
+        serialize(writer, dependency.generalBarrier);
+        writer.write(dependency.prevAccesses);
+        writer.write(dependency.nextAccesses);
+    }
+}
+
+void deserialize(CaptureReader &reader, RenderPassInfo &info, Device *device) {
+    info.colorAttachments.resize(reader.readCount());
+    for (auto &attachment : info.colorAttachments) {
+        attachment.format = reader.read<Format>();
+        attachment.sampleCount = reader.read<SampleCount>();
+        attachment.loadOp = reader.read<LoadOp>();
+        attachment.storeOp = reader.read<StoreOp>();
+        attachment.barrier = deserializeGeneralBarrier(reader, device);
+    }
+    deserialize(reader, info.depthStencilAttachment, device);
+    deserialize(reader, info.depthStencilResolveAttachment, device);
+    info.subpasses.resize(reader.readCount());
+    for (auto &subpass : info.subpasses) {
+        readList(reader, subpass.inputs);
+        readList(reader, subpass.colors);
+        readList(reader, subpass.resolves);
+        readList(reader, subpass.preserves);
+        subpass.depthStencil = reader.read<uint32_t>();
+        subpass.depthStencilResolve = reader.read<uint32_t>();
+        subpass.shadingRate = reader.read<uint32_t>();
+        subpass.depthResolveMode = reader.read<ResolveMode>();
+        subpass.stencilResolveMode = reader.read<ResolveMode>();
+    }
+    info.dependencies.resize(reader.readCount());
+    for (auto &dependency : info.dependencies) {
+        dependency.srcSubpass = reader.read<uint32_t>();
+        dependency.dstSubpass = reader.read<uint32_t>();
+        dependency.generalBarrier = deserializeGeneralBarrier(reader, device);
+        dependency.prevAccesses = reader.read<AccessFlags>();
+        dependency.nextAccesses = reader.read<AccessFlags>();
+    }
+}
+
+void serialize(CaptureWriter &writer, const DescriptorSetLayoutInfo &info) {
+    writer.write(static_cast<uint32_t>(info.bindings.size()));
+    for (const auto &binding : info.bindings) {
+        writer.write(binding.binding);
+        writer.write(binding.descriptorType);
+        writer.write(binding.count);
+        writer.write(binding.stageFlags);
+        writer.write(static_cast<uint32_t>(binding.immutableSamplers.size()));
+        for (const auto *sampler : binding.immutableSamplers) {
+            serialize(writer, sampler);
+        }
+    }
+}
+
+void deserialize(CaptureReader &reader, DescriptorSetLayoutInfo &info, Device *device) {
+    info.bindings.resize(reader.readCount());
+    for (auto &binding : info.bindings) {
+        binding.binding = reader.read<uint32_t>();
+        binding.descriptorType = reader.read<DescriptorType>();
+        binding.count = reader.read<uint32_t>();
+        binding.stageFlags = reader.read<ShaderStageFlags>();
+        binding.immutableSamplers.resize(reader.readCount());
+        for (auto &sampler : binding.immutableSamplers) {
+            sampler = deserializeSampler(reader, device);
+        }
+    }
+}
+
+void serialize(CaptureWriter &writer, const TextureInfo &info) {
+    writer.write(info.type);
+    writer.write(info.usage);
+    writer.write(info.format);
+    writer.write(info.width);
+    writer.write(info.height);
+    writer.write(info.flags);
+    writer.write(info.layerCount);
+    writer.write(info.levelCount);
+    writer.write(info.samples);
+    writer.write(info.depth);
+    // external resources can't outlive the process, they are replayed as regular textures
+}
+
+void deserialize(CaptureReader &reader, TextureInfo &info) {
+    info.type = reader.read<TextureType>();
+    info.usage = reader.read<TextureUsage>();
+    info.format = reader.read<Format>();
+    info.width = reader.read<uint32_t>();
+    info.height = reader.read<uint32_t>();
+    info.flags = reader.read<TextureFlags>() & ~TextureFlagBit::EXTERNAL_NORMAL & ~TextureFlagBit::EXTERNAL_OES;
+    info.layerCount = reader.read<uint32_t>();
+    info.levelCount = reader.read<uint32_t>();
+    info.samples = reader.read<SampleCount>();
+    info.depth = reader.read<uint32_t>();
+    info.externalRes = nullptr;
+}
+
+void serialize(CaptureWriter &writer, const BlendState &state) {
+    writer.write(state.isA2C);
+    writer.write(state.isIndepend);
+    writer.write(state.blendColor);
+    writeList(writer, state.targets);
+}
+
+void deserialize(CaptureReader &reader, BlendState &state) {
+    state.isA2C = reader.read<uint32_t>();
+    state.isIndepend = reader.read<uint32_t>();
+    state.blendColor = reader.read<Color>();
+    readList(reader, state.targets);
+}
+
+void serialize(CaptureWriter &writer, const MarkerInfo &marker) {
+    writer.writeString(marker.name);
+    writer.write(marker.color);
+}
+
+void deserialize(CaptureReader &reader, MarkerInfo &marker) {
+    marker.name = reader.readString();
+    marker.color = reader.read<Color>();
+}
+
+void serialize(CaptureWriter &writer, const GeneralBarrier *barrier) {
+    writer.write(barrier != nullptr);
+    if (!barrier) return;
+    const auto &info = barrier->getInfo();
+    writer.write(info.prevAccesses);
+    writer.write(info.nextAccesses);
+    writer.write(info.type);
+}
+
+void serialize(CaptureWriter &writer, const TextureBarrier *barrier) {
+    writer.write(barrier != nullptr);
+    if (!barrier) return;
+    const auto &info = barrier->getInfo();
+    writer.write(info.prevAccesses);
+    writer.write(info.nextAccesses);
+    writer.write(info.type);
+    writer.write(info.range);
+    writer.write(info.discardContents);
+    // queue ownership transfers are replayed on the device queue
+    writer.write(info.srcQueue != nullptr);
+    writer.write(info.dstQueue != nullptr);
+}
+
+void serialize(CaptureWriter &writer, const BufferBarrier *barrier) {
+    writer.write(barrier != nullptr);
+    if (!barrier) return;
+    const auto &info = barrier->getInfo();
+    writer.write(info.prevAccesses);
+    writer.write(info.nextAccesses);
+    writer.write(info.type);
+    writer.write(info.offset);
+    writer.write(info.size);
+    writer.write(info.discardContents);
+    writer.write(info.srcQueue != nullptr);
+    writer.write(info.dstQueue != nullptr);
+}
+
+void serialize(CaptureWriter &writer, const Sampler *sampler) {
+    writer.write(sampler != nullptr);
+    if (!sampler) return;
+    writer.write(sampler->getInfo());
+}
+
+GeneralBarrier *deserializeGeneralBarrier(CaptureReader &reader, Device *device) {
+    if (!reader.read<bool>()) return nullptr;
+    GeneralBarrierInfo info;
+    info.prevAccesses = reader.read<AccessFlags>();
+    info.nextAccesses = reader.read<AccessFlags>();
+    info.type = reader.read<BarrierType>();
+    return device->getGeneralBarrier(info);
+}
+
+TextureBarrier *deserializeTextureBarrier(CaptureReader &reader, Device *device) {
+    if (!reader.read<bool>()) return nullptr;
+    TextureBarrierInfo info;
+    info.prevAccesses = reader.read<AccessFlags>();
+    info.nextAccesses = reader.read<AccessFlags>();
+    info.type = reader.read<BarrierType>();
+    info.range = reader.read<ResourceRange>();
+    info.discardContents = reader.read<uint64_t>();
+    info.srcQueue = reader.read<bool>() ? device->getQueue() : nullptr;
+    info.dstQueue = reader.read<bool>() ? device->getQueue() : nullptr;
+    return device->getTextureBarrier(info);
+}
+
+BufferBarrier *deserializeBufferBarrier(CaptureReader &reader, Device *device) {
+    if (!reader.read<bool>()) return nullptr;
+    BufferBarrierInfo info;
+    info.prevAccesses = reader.read<AccessFlags>();
+    info.nextAccesses = reader.read<AccessFlags>();
+    info.type = reader.read<BarrierType>();
+    info.offset = reader.read<uint32_t>();
+    info.size = reader.read<uint32_t>();
+    info.discardContents = reader.read<uint64_t>();
+    info.srcQueue = reader.read<bool>() ? device->getQueue() : nullptr;
+    info.dstQueue = reader.read<bool>() ? device->getQueue() : nullptr;
+    return device->getBufferBarrier(info);
+}
+
+Sampler *deserializeSampler(CaptureReader &reader, Device *device) {
+    if (!reader.read<bool>()) return nullptr;
+    return device->getSampler(reader.read<SamplerInfo>());
+}
+
+uint64_t getTextureUploadSize(const TextureInfo &info, const BufferTextureCopy *regions, uint32_t count) {
+    uint64_t size{0U};
+    for (uint32_t i = 0U; i < count; ++i) {
+        size += static_cast<uint64_t>(getRegionBufferSize(info, regions[i])) * getRegionBufferCount(info, regions[i]);
+    }
+    return size;
+}
+
+void serializeTextureUpload(CaptureWriter &writer, const TextureInfo &info, const uint8_t *const *buffers, const BufferTextureCopy *regions, uint32_t count) {
+    writer.write(count);
+    uint32_t bufferCount{0U};
+    for (uint32_t i = 0U; i < count; ++i) {
+        BufferTextureCopy region = regions[i];
+        region.buffOffset = 0U; // only the addressed bytes are stored
+        writer.write(region);
+        bufferCount += getRegionBufferCount(info, regions[i]);
+    }
+
+    writer.write(bufferCount);
+    for (uint32_t i = 0U, n = 0U; i < count; ++i) {
+        const uint32_t size = getRegionBufferSize(info, regions[i]);
+        for (uint32_t j = 0U; j < getRegionBufferCount(info, regions[i]); ++j) {
+            writer.write(size);
+            writer.writeBytes(buffers[n++] + regions[i].buffOffset, size);
+        }
+    }
+}
+
+void deserializeTextureUpload(CaptureReader &reader, BufferTextureCopyList &regions, BufferDataList &buffers) {
+    regions.resize(reader.readCount());
+    for (auto &region : regions) {
+        region = reader.read<BufferTextureCopy>();
+    }
+
+    buffers.resize(reader.readCount());
+    for (auto &buffer : buffers) {
+        buffer = reader.skip(reader.read<uint32_t>());
+    }
+}
+
+} // namespace gfx
+} // namespace cc
@@ -0,0 +1,218 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstring>
+#include <type_traits>
+#include "base/std/container/string.h"
+#include "base/std/container/vector.h"
+#include "gfx-base/GFXDef.h"
+#include "gfx-base/GFXObject.h"
+
+namespace cc {
+namespace gfx {
+
+/**
+ * Captures start with a fixed header followed by a flat list of records.
+ * Every record begins with a one-byte `RecordOp`, GFX objects are referred to
+ * by the object ID of their recorder wrapper, and the first reference to an
+ * object inside a capture is always preceded by its creation record.
+ */
+constexpr uint32_t CAPTURE_MAGIC{0x43474343}; // 'CCGC'
+constexpr uint32_t CAPTURE_VERSION{1U};
+
+enum class RecordOp : uint8_t {
+    // device level records
+    DEVICE_OBJECTS,
+    FRAME_BEGIN,
+    FRAME_END,
+    CREATE_QUEUE,
+    CREATE_COMMAND_BUFFER,
+    CREATE_QUERY_POOL,
+    CREATE_SWAPCHAIN_TEXTURE,
+    CREATE_BUFFER,
+    CREATE_BUFFER_VIEW,
+    CREATE_TEXTURE,
+    CREATE_TEXTURE_VIEW,
+    CREATE_SHADER,
+    CREATE_INPUT_ASSEMBLER,
+    CREATE_RENDER_PASS,
+    CREATE_FRAMEBUFFER,
+    CREATE_DESCRIPTOR_SET_LAYOUT,
+    CREATE_PIPELINE_LAYOUT,
+    CREATE_PIPELINE_STATE,
+    CREATE_DESCRIPTOR_SET,
+    UPDATE_DESCRIPTOR_SET,
+    UPDATE_BUFFER,
+    RESIZE_BUFFER,
+    RESIZE_TEXTURE,
+    COPY_BUFFERS_TO_TEXTURE,
+    COPY_TEXTURE_TO_BUFFERS,
+    FLUSH_COMMANDS,
+    QUEUE_SUBMIT,
+    COMMAND_BLOCK,
+
+    // command buffer level records, only valid inside a COMMAND_BLOCK
+    CMD_BEGIN,
+    CMD_END,
+    CMD_BEGIN_RENDER_PASS,
+    CMD_END_RENDER_PASS,
+    CMD_NEXT_SUBPASS,
+    CMD_INSERT_MARKER,
+    CMD_BEGIN_MARKER,
+    CMD_END_MARKER,
+    CMD_BIND_PIPELINE_STATE,
+    CMD_BIND_DESCRIPTOR_SET,
+    CMD_BIND_INPUT_ASSEMBLER,
+    CMD_SET_VIEWPORT,
+    CMD_SET_SCISSOR,
+    CMD_SET_LINE_WIDTH,
+    CMD_SET_DEPTH_BIAS,
+    CMD_SET_BLEND_CONSTANTS,
+    CMD_SET_DEPTH_BOUND,
+    CMD_SET_STENCIL_WRITE_MASK,
+    CMD_SET_STENCIL_COMPARE_MASK,
+    CMD_DRAW,
+    CMD_UPDATE_BUFFER,
+    CMD_COPY_BUFFERS_TO_TEXTURE,
+    CMD_BLIT_TEXTURE,
+    CMD_COPY_TEXTURE,
+    CMD_RESOLVE_TEXTURE,
+    CMD_EXECUTE,
+    CMD_DISPATCH,
+    CMD_PIPELINE_BARRIER,
+    CMD_BEGIN_QUERY,
+    CMD_END_QUERY,
+    CMD_RESET_QUERY_POOL,
+    CMD_COMPLETE_QUERY_POOL,
+
+    COUNT,
+};
+
+struct RecorderFrameStats {
+    uint32_t drawCalls{0U};
+    uint32_t instances{0U};
+    uint32_t dispatches{0U};
+    uint32_t renderPasses{0U};
+    uint32_t pipelineBinds{0U};
+    uint32_t descriptorSetBinds{0U};
+    uint32_t inputAssemblerBinds{0U};
+    uint32_t barriers{0U};
+    uint32_t submits{0U};
+    uint64_t bytesUploaded{0U};
+
+    RecorderFrameStats &operator+=(const RecorderFrameStats &rhs);
+};
+
+class CC_DLL CaptureWriter final {
+public:
+    template <typename T>
+    void write(const T &value) {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be written directly.");
+        writeBytes(&value, sizeof(T));
+    }
+
+    void writeBytes(const void *data, uint32_t size);
+    void writeString(const ccstd::string &str);
+    void append(const CaptureWriter &other);
+
+    inline void writeOp(RecordOp op) { write(op); }
+    inline void writeID(const GFXObject *object) { write(GFXObject::getObjectID(object)); }
+
+    inline void clear() { _data.clear(); }
+    inline bool empty() const { return _data.empty(); }
+    inline uint32_t size() const { return static_cast<uint32_t>(_data.size()); }
+    inline const ccstd::vector<uint8_t> &data() const { return _data; }
+    inline ccstd::vector<uint8_t> release() { return std::move(_data); }
+
+private:
+    ccstd::vector<uint8_t> _data;
+};
+
+class CC_DLL CaptureReader final {
+public:
+    CaptureReader(const uint8_t *data, uint32_t size) : _data(data), _size(size) {}
+
+    template <typename T>
+    T read() {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be read directly.");
+        T value{};
+        readBytes(&value, sizeof(T));
+        return value;
+    }
+
+    void readBytes(void *dst, uint32_t size);
+    ccstd::string readString();
+    // reads an element count, every element takes at least one byte so a count
+    // beyond the remaining bytes marks the capture invalid and yields 0
+    uint32_t readCount();
+
+    // returns the in-place address of the next `size` bytes and skips them,
+    // or nullptr if the capture is truncated
+    const uint8_t *skip(uint32_t size);
+
+    inline bool isValid() const { return _valid; }
+    inline bool isEnd() const { return _offset >= _size; }
+
+private:
+    const uint8_t *_data{nullptr};
+    uint32_t _size{0U};
+    uint32_t _offset{0U};
+    bool _valid{true};
+};
+
+void serialize(CaptureWriter &writer, const AttributeList &attributes);
+void serialize(CaptureWriter &writer, const ShaderInfo &info);
+void serialize(CaptureWriter &writer, const RenderPassInfo &info);
+void serialize(CaptureWriter &writer, const DescriptorSetLayoutInfo &info);
+void serialize(CaptureWriter &writer, const TextureInfo &info);
+void serialize(CaptureWriter &writer, const BlendState &state);
+void serialize(CaptureWriter &writer, const MarkerInfo &marker);
+void serialize(CaptureWriter &writer, const GeneralBarrier *barrier);
+void serialize(CaptureWriter &writer, const TextureBarrier *barrier);
+void serialize(CaptureWriter &writer, const BufferBarrier *barrier);
+void serialize(CaptureWriter &writer, const Sampler *sampler);
+
+// objects that are cached by the device (samplers, barriers) are resolved through `device`
+void deserialize(CaptureReader &reader, AttributeList &attributes);
+void deserialize(CaptureReader &reader, ShaderInfo &info);
+void deserialize(CaptureReader &reader, RenderPassInfo &info, Device *device);
+void deserialize(CaptureReader &reader, DescriptorSetLayoutInfo &info, Device *device);
+void deserialize(CaptureReader &reader, TextureInfo &info);
+void deserialize(CaptureReader &reader, BlendState &state);
+void deserialize(CaptureReader &reader, MarkerInfo &marker);
+GeneralBarrier *deserializeGeneralBarrier(CaptureReader &reader, Device *device);
+TextureBarrier *deserializeTextureBarrier(CaptureReader &reader, Device *device);
+BufferBarrier *deserializeBufferBarrier(CaptureReader &reader, Device *device);
+Sampler *deserializeSampler(CaptureReader &reader, Device *device);
+
+// the number of bytes `copyBuffersToTexture` reads from the source buffers
+uint64_t getTextureUploadSize(const TextureInfo &info, const BufferTextureCopy *regions, uint32_t count);
+// the buffers are stored in place, `buffers` points into the reader's storage
+void serializeTextureUpload(CaptureWriter &writer, const TextureInfo &info, const uint8_t *const *buffers, const BufferTextureCopy *regions, uint32_t count);
+void deserializeTextureUpload(CaptureReader &reader, BufferTextureCopyList &regions, BufferDataList &buffers);
+
+} // namespace gfx
+} // namespace cc
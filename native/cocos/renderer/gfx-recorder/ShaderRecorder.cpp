@@ -0,0 +1,70 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "ShaderRecorder.h"
+#include "DeviceRecorder.h"
+
+namespace cc {
+namespace gfx {
+
+ShaderRecorder::ShaderRecorder(Shader *actor)
+: Agent<Shader>(actor) {
+    _typedID = actor->getTypedID();
+}
+
+ShaderRecorder::~ShaderRecorder() {
+    CC_SAFE_DELETE(_actor);
+}
+
+void ShaderRecorder::doInit(const ShaderInfo &info) {
+    DeviceRecorder::getInstance()->forget(this);
+
+    _actor->initialize(info);
+}
+
+void ShaderRecorder::doDestroy() {
+    _actor->destroy();
+}
+
+void ShaderRecorder::record(CaptureWriter &writer) const {
+    ShaderInfo info;
+    info.name = _name;
+    info.stages = _stages;
+    info.attributes = _attributes;
+    info.blocks = _blocks;
+    info.buffers = _buffers;
+    info.samplerTextures = _samplerTextures;
+    info.samplers = _samplers;
+    info.textures = _textures;
+    info.images = _images;
+    info.subpassInputs = _subpassInputs;
+    info.hash = _hash;
+
+    writer.writeOp(RecordOp::CREATE_SHADER);
+    writer.writeID(this);
+    serialize(writer, info);
+}
+
+} // namespace gfx
+} // namespace cc
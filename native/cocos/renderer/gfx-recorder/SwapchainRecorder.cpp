@@ -0,0 +1,104 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "SwapchainRecorder.h"
+#include "TextureRecorder.h"
+
+namespace cc {
+namespace gfx {
+
+SwapchainRecorder::SwapchainRecorder(Swapchain *actor)
+: Agent<Swapchain>(actor) {
+    _typedID = actor->getTypedID();
+    _preRotationEnabled = static_cast<SwapchainRecorder *>(actor)->_preRotationEnabled;
+}
+
+SwapchainRecorder::~SwapchainRecorder() {
+    CC_SAFE_DELETE(_actor);
+}
+
+void SwapchainRecorder::doInit(const SwapchainInfo &info) {
+    _actor->initialize(info);
+
+    auto *colorTexture = ccnew TextureRecorder(_actor->getColorTexture());
+    colorTexture->renounceOwnership();
+    _colorTexture = colorTexture;
+
+    auto *depthStencilTexture = ccnew TextureRecorder(_actor->getDepthStencilTexture());
+    depthStencilTexture->renounceOwnership();
+    _depthStencilTexture = depthStencilTexture;
+
+    SwapchainTextureInfo textureInfo;
+    textureInfo.swapchain = this;
+    textureInfo.format = _actor->getColorTexture()->getFormat();
+    textureInfo.width = _actor->getWidth();
+    textureInfo.height = _actor->getHeight();
+    initTexture(textureInfo, _colorTexture);
+
+    textureInfo.format = _actor->getDepthStencilTexture()->getFormat();
+    initTexture(textureInfo, _depthStencilTexture);
+
+    _transform = _actor->getSurfaceTransform();
+}
+
+void SwapchainRecorder::doDestroy() {
+    _depthStencilTexture = nullptr;
+    _colorTexture = nullptr;
+
+    _actor->destroy();
+}
+
+void SwapchainRecorder::updateInfo() {
+    _generation = _actor->getGeneration();
+    SwapchainTextureInfo textureInfo;
+    textureInfo.swapchain = this;
+    textureInfo.format = _actor->getColorTexture()->getFormat();
+    textureInfo.width = _actor->getWidth();
+    textureInfo.height = _actor->getHeight();
+    updateTextureInfo(textureInfo, _colorTexture);
+
+    textureInfo.format = _actor->getDepthStencilTexture()->getFormat();
+    updateTextureInfo(textureInfo, _depthStencilTexture);
+
+    _transform = _actor->getSurfaceTransform();
+}
+
+void SwapchainRecorder::doResize(uint32_t width, uint32_t height, SurfaceTransform transform) {
+    _actor->resize(width, height, transform);
+
+    updateInfo();
+}
+
+void SwapchainRecorder::doDestroySurface() {
+    _actor->destroySurface();
+}
+
+void SwapchainRecorder::doCreateSurface(void *windowHandle) {
+    _actor->createSurface(windowHandle);
+
+    updateInfo();
+}
+
+} // namespace gfx
+} // namespace cc
@@ -0,0 +1,107 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "TextureRecorder.h"
+#include "DeviceRecorder.h"
+
+namespace cc {
+namespace gfx {
+
+TextureRecorder::TextureRecorder(Texture *actor)
+: Agent<Texture>(actor) {
+    _typedID = actor->getTypedID();
+}
+
+TextureRecorder::~TextureRecorder() {
+    if (_ownTheActor) CC_SAFE_DELETE(_actor);
+}
+
+void TextureRecorder::doInit(const TextureInfo &info) {
+    DeviceRecorder::getInstance()->forget(this);
+
+    _actor->initialize(info);
+}
+
+void TextureRecorder::doInit(const TextureViewInfo &info) {
+    DeviceRecorder::getInstance()->forget(this);
+
+    TextureViewInfo actorInfo = info;
+    actorInfo.texture = static_cast<TextureRecorder *>(info.texture)->getActor();
+
+    _actor->initialize(actorInfo);
+}
+
+void TextureRecorder::doInit(const SwapchainTextureInfo & /*info*/) {
+    // the actor is already initialized
+}
+
+void TextureRecorder::doDestroy() {
+    _actor->destroy();
+}
+
+void TextureRecorder::doResize(uint32_t width, uint32_t height, uint32_t /*size*/) {
+    auto *device = DeviceRecorder::getInstance();
+    device->reference(this);
+    device->writeRecord([&](CaptureWriter &writer) {
+        writer.writeOp(RecordOp::RESIZE_TEXTURE);
+        writer.writeID(this);
+        writer.write(width);
+        writer.write(height);
+    });
+
+    _actor->resize(width, height);
+}
+
+void TextureRecorder::record(CaptureWriter &writer) const {
+    if (_swapchain) {
+        writer.writeOp(RecordOp::CREATE_SWAPCHAIN_TEXTURE);
+        writer.writeID(this);
+        writer.writeID(_swapchain);
+        serialize(writer, _info);
+        return;
+    }
+
+    if (_isTextureView) {
+        DeviceRecorder::getInstance()->reference(static_cast<TextureRecorder *>(_viewInfo.texture));
+        writer.writeOp(RecordOp::CREATE_TEXTURE_VIEW);
+        writer.writeID(this);
+        writer.writeID(_viewInfo.texture);
+        writer.write(_viewInfo.type);
+        writer.write(_viewInfo.format);
+        writer.write(_viewInfo.baseLevel);
+        writer.write(_viewInfo.levelCount);
+        writer.write(_viewInfo.baseLayer);
+        writer.write(_viewInfo.layerCount);
+        writer.write(_viewInfo.basePlane);
+        writer.write(_viewInfo.planeCount);
+        return;
+    }
+
+    writer.writeOp(RecordOp::CREATE_TEXTURE);
+    writer.writeID(this);
+    serialize(writer, _info);
+}
+
+} // namespace gfx
+} // namespace cc
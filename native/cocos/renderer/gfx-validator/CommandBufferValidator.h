@@ -74,6 +74,7 @@ public:
     uint32_t getNumDrawCalls() const override { return _actor->getNumDrawCalls(); }
     uint32_t getNumInstances() const override { return _actor->getNumInstances(); }
     uint32_t getNumTris() const override { return _actor->getNumTris(); }
+    uint32_t getNumFilteredCalls() const override { return _actor->getNumFilteredCalls(); }
 
     inline bool isInited() const { return _inited; }
     inline bool isCommandsFlushed() const { return _commandsFlushed; }
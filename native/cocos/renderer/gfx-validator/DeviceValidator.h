@@ -89,6 +89,7 @@ public:
     uint32_t getNumDrawCalls() const override { return _actor->getNumDrawCalls(); }
     uint32_t getNumInstances() const override { return _actor->getNumInstances(); }
     uint32_t getNumTris() const override { return _actor->getNumTris(); }
+    bool isMultithreadedCommandRecording() const override { return _actor->isMultithreadedCommandRecording(); }
 
     inline void enableRecording(bool recording) { _recording = recording; }
     inline bool isRecording() const { return _recording; }
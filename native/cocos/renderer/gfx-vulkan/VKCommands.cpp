@@ -1034,7 +1034,7 @@ void cmdFuncCCVKCreateGraphicsPipelineState(CCVKDevice *device, CCVKGPUPipelineS
             if (shaderAttrs[i].name == attr.name) {
                 attributeDescriptions[i].location = shaderAttrs[i].location;
                 attributeDescriptions[i].binding = attr.stream;
-                attributeDescriptions[i].format = mapVkFormat(attr.format, device->gpuDevice());
+                attributeDescriptions[i].format = mapVkVertexFormat(attr.format, attr.isNormalized, device->gpuDevice());
                 attributeDescriptions[i].offset = offsets[attr.stream];
                 attributeFound = true;
                 break;
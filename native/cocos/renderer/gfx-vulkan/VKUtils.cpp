@@ -168,6 +168,31 @@ VkFormat mapVkFormat(Format format, const CCVKGPUDevice *gpuDevice) {
     }
 }
 
+VkFormat mapVkVertexFormat(Format format, bool isNormalized, const CCVKGPUDevice *gpuDevice) {
+    if (isNormalized) {
+        switch (format) {
+            case Format::R8UI: return VK_FORMAT_R8_UNORM;
+            case Format::R8I: return VK_FORMAT_R8_SNORM;
+            case Format::RG8UI: return VK_FORMAT_R8G8_UNORM;
+            case Format::RG8I: return VK_FORMAT_R8G8_SNORM;
+            case Format::RGB8UI: return VK_FORMAT_R8G8B8_UNORM;
+            case Format::RGB8I: return VK_FORMAT_R8G8B8_SNORM;
+            case Format::RGBA8UI: return VK_FORMAT_R8G8B8A8_UNORM;
+            case Format::RGBA8I: return VK_FORMAT_R8G8B8A8_SNORM;
+            case Format::R16UI: return VK_FORMAT_R16_UNORM;
+            case Format::R16I: return VK_FORMAT_R16_SNORM;
+            case Format::RG16UI: return VK_FORMAT_R16G16_UNORM;
+            case Format::RG16I: return VK_FORMAT_R16G16_SNORM;
+            case Format::RGB16UI: return VK_FORMAT_R16G16B16_UNORM;
+            case Format::RGB16I: return VK_FORMAT_R16G16B16_SNORM;
+            case Format::RGBA16UI: return VK_FORMAT_R16G16B16A16_UNORM;
+            case Format::RGBA16I: return VK_FORMAT_R16G16B16A16_SNORM;
+            default: break;
+        }
+    }
+    return mapVkFormat(format, gpuDevice);
+}
+
 VkAttachmentLoadOp mapVkLoadOp(LoadOp loadOp) {
     switch (loadOp) {
         case LoadOp::CLEAR: return VK_ATTACHMENT_LOAD_OP_CLEAR;
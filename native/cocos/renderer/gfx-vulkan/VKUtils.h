@@ -53,6 +53,7 @@ class CCVKGPUDevice;
 
 VkQueryType mapVkQueryType(QueryType type);
 VkFormat mapVkFormat(Format format, const CCVKGPUDevice *gpuDevice);
+VkFormat mapVkVertexFormat(Format format, bool isNormalized, const CCVKGPUDevice *gpuDevice);
 VkAttachmentLoadOp mapVkLoadOp(LoadOp loadOp);
 VkAttachmentStoreOp mapVkStoreOp(StoreOp storeOp);
 VkBufferUsageFlagBits mapVkBufferUsageFlagBits(BufferUsage usage);
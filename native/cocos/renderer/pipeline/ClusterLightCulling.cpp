@@ -23,12 +23,16 @@
 ****************************************************************************/
 
 #include "ClusterLightCulling.h"
+#include <algorithm>
+#include <cmath>
 #include "Define.h"
 #include "PipelineSceneData.h"
 #include "PipelineUBO.h"
 #include "base/StringUtil.h"
+#include "base/job-system/JobSystem.h"
 #include "deferred/DeferredPipeline.h"
 #include "frame-graph/FrameGraph.h"
+#include "profiler/Profiler.h"
 #include "renderer/gfx-base/GFXDevice.h"
 #include "renderer/pipeline/RenderPipeline.h"
 #include "scene/Camera.h"
@@ -37,6 +41,14 @@
 #include "scene/PointLight.h"
 #include "scene/RangedDirectionalLight.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define CC_CLUSTER_SSE2 1
+#elif (defined(__ARM_NEON) || defined(__ARM_NEON__)) && defined(__aarch64__)
+    #include <arm_neon.h>
+    #define CC_CLUSTER_NEON 1
+#endif
+
 namespace cc {
 namespace pipeline {
 
@@ -45,6 +57,7 @@ framegraph::StringHandle fgStrHandleClusterGlobalIndexBuffer = framegraph::Frame
 framegraph::StringHandle fgStrHandleClusterLightBuffer = framegraph::FrameGraph::stringToHandle("clusterLightBuffer");
 framegraph::StringHandle fgStrHandleClusterLightIndexBuffer = framegraph::FrameGraph::stringToHandle("lightIndexBuffer");
 framegraph::StringHandle fgStrHandleClusterLightGridBuffer = framegraph::FrameGraph::stringToHandle("lightGridBuffer");
+framegraph::StringHandle fgStrHandleClusterLightDataTexture = framegraph::FrameGraph::stringToHandle("clusterLightDataTexture");
 
 framegraph::StringHandle fgStrHandleClusterBuildPass = framegraph::FrameGraph::stringToHandle("clusterBuildPass");
 framegraph::StringHandle fgStrHandleClusterCullingPass = framegraph::FrameGraph::stringToHandle("clusterCullingPass");
@@ -54,9 +67,30 @@ ClusterLightCulling::ClusterLightCulling(RenderPipeline *pipeline) : _pipeline(p
 
 ClusterLightCulling::~ClusterLightCulling() = default;
 
+bool ClusterLightCulling::isSupported(const gfx::Device *device) {
+    if (device->hasFeature(gfx::Feature::COMPUTE_SHADER)) {
+        return true;
+    }
+    return hasFlag(device->getFormatFeatures(gfx::Format::RGBA32F), gfx::FormatFeature::SAMPLED_TEXTURE);
+}
+
+bool ClusterLightCulling::usesLightDataTexture(const gfx::Device *device) {
+    return !device->hasFeature(gfx::Feature::COMPUTE_SHADER);
+}
+
 void ClusterLightCulling::initialize(gfx::Device *dev) {
     _device = dev;
-    if (!_device->hasFeature(gfx::Feature::COMPUTE_SHADER)) return;
+    _lightBufferStride = 4 * sizeof(Vec4);
+    if (usesLightDataTexture(_device)) {
+        // lights are assigned on the CPU and the lighting pass reads them from
+        // a float texture, see CC_CLUSTER_LIGHT_DATA_TEXTURE in the shading chunk
+        if (!isSupported(_device)) return;
+        _lightTextureData.resize(4 * LIGHT_DATA_TEXTURE_WIDTH * LIGHT_DATA_TEXTURE_HEIGHT);
+        _lightDataTexture = true;
+        _cpuCulling = true;
+        _initialized = true;
+        return;
+    }
 
     uint32_t maxInvocations = _device->getCapabilities().maxComputeWorkGroupInvocations;
     if (CLUSTERS_X_THREADS * CLUSTERS_Y_THREADS * 4 <= maxInvocations) {
@@ -77,7 +111,6 @@ void ClusterLightCulling::initialize(gfx::Device *dev) {
         gfx::BufferFlagBit::NONE,
     });
 
-    _lightBufferStride = 4 * sizeof(Vec4);
     _buildingDispatchInfo = {CLUSTERS_X / CLUSTERS_X_THREADS, CLUSTERS_Y / CLUSTERS_Y_THREADS, CLUSTERS_Z / clusterZThreads};
     _resetDispatchInfo = {1, 1, 1};
     _cullingDispatchInfo = {CLUSTERS_X / CLUSTERS_X_THREADS, CLUSTERS_Y / CLUSTERS_Y_THREADS, CLUSTERS_Z / clusterZThreads};
@@ -110,7 +143,9 @@ void ClusterLightCulling::update() {
     memcpy(_constants.data() + MAT_VIEW_OFFSET, _camera->getMatView().m, sizeof(cc::Mat4));
     memcpy(_constants.data() + MAT_PROJ_INV_OFFSET, _camera->getMatProjInv().m, sizeof(cc::Mat4));
 
-    _constantsBuffer->update(_constants.data(), 2 * sizeof(Vec4) + 2 * sizeof(Mat4));
+    if (_constantsBuffer) {
+        _constantsBuffer->update(_constants.data(), 2 * sizeof(Vec4) + 2 * sizeof(Mat4));
+    }
     updateLights();
 
     uint32_t cameraIndex = _pipeline->getPipelineUBO()->getCurrentCameraUBOOffset();
@@ -717,8 +752,22 @@ void ClusterLightCulling::clusterLightCulling(scene::Camera *camera) {
     if (!_initialized || _pipeline->getPipelineUBO()->getCurrentCameraUBOOffset() != 0) return;
     _camera = camera;
     update(); // update ubo and light data
+
+    if (_lightDataTexture) {
+        // uploaded even without lights, the texture is always sampled by the lighting pass
+        cullLightsCpu();
+        packLightDataTexture();
+        addLightDataTexturePass();
+        return;
+    }
     if (_validLights.empty()) return;
 
+    if (_cpuCulling) {
+        cullLightsCpu();
+        addCpuCullingPass();
+        return;
+    }
+
     struct DataClusterBuild {
         framegraph::BufferHandle clusterBuffer;     // cluster build storage buffer
         framegraph::BufferHandle globalIndexBuffer; // global light index storage buffer
@@ -876,6 +925,406 @@ void ClusterLightCulling::clusterLightCulling(scene::Camera *camera) {
     pipeline->getFrameGraph().addPass<DataLightCulling>(insertPoint++, fgStrHandleClusterCullingPass, lightCullingSetup, lightCullingExec);
 }
 
+void ClusterLightCulling::setCpuCullingEnabled(bool enable) {
+    if (_device && !_device->hasFeature(gfx::Feature::COMPUTE_SHADER)) {
+        enable = true;
+    }
+    if (_cpuCulling != enable) {
+        // clusters of the other path are out of date, force a rebuild
+        _oldCamProjMats.clear();
+        _clusterBounds.clear();
+    }
+    _cpuCulling = enable;
+}
+
+void ClusterLightCulling::buildClustersCpu() {
+    const float nearClip = _constants[NEAR_FAR_OFFSET + 0];
+    const float farClip = _constants[NEAR_FAR_OFFSET + 1];
+    const float viewportX = _constants[VIEW_PORT_OFFSET + 0];
+    const float viewportY = _constants[VIEW_PORT_OFFSET + 1];
+    const float viewportW = _constants[VIEW_PORT_OFFSET + 2];
+    const float viewportH = _constants[VIEW_PORT_OFFSET + 3];
+    const float clusterSizeX = std::ceil(viewportW / static_cast<float>(CLUSTERS_X));
+    const float clusterSizeY = std::ceil(viewportH / static_cast<float>(CLUSTERS_Y));
+    const auto &matProjInv = _camera->getMatProjInv();
+
+    // same math as the building stage: eye space directions of the cluster corners on the far plane
+    ccstd::array<Vec3, (CLUSTERS_X + 1) * (CLUSTERS_Y + 1)> corners;
+    for (uint32_t y = 0; y <= CLUSTERS_Y; ++y) {
+        for (uint32_t x = 0; x <= CLUSTERS_X; ++x) {
+            Vec4 eye(
+                2.F * (static_cast<float>(x) * clusterSizeX - viewportX) / viewportW - 1.F,
+                2.F * (static_cast<float>(y) * clusterSizeY - viewportY) / viewportH - 1.F,
+                1.F, 1.F);
+            matProjInv.transformVector(&eye);
+            corners[y * (CLUSTERS_X + 1) + x].set(eye.x / eye.w, eye.y / eye.w, eye.z / eye.w);
+        }
+    }
+
+    _clusterBounds.resize(6 * CLUSTER_COUNT);
+    _sliceDepthRanges.resize(2 * CLUSTERS_Z);
+    const float depthRatio = farClip / nearClip;
+    for (uint32_t z = 0; z < CLUSTERS_Z; ++z) {
+        const float clusterNear = -nearClip * std::pow(depthRatio, static_cast<float>(z) / static_cast<float>(CLUSTERS_Z));
+        const float clusterFar = -nearClip * std::pow(depthRatio, static_cast<float>(z + 1) / static_cast<float>(CLUSTERS_Z));
+        float *bounds = _clusterBounds.data() + z * 6 * CLUSTERS_PER_SLICE;
+        float sliceMin = std::numeric_limits<float>::max();
+        float sliceMax = std::numeric_limits<float>::lowest();
+        for (uint32_t y = 0; y < CLUSTERS_Y; ++y) {
+            for (uint32_t x = 0; x < CLUSTERS_X; ++x) {
+                const auto &minEye = corners[y * (CLUSTERS_X + 1) + x];
+                const auto &maxEye = corners[(y + 1) * (CLUSTERS_X + 1) + x + 1];
+                const Vec3 minNear = minEye * (clusterNear / minEye.z);
+                const Vec3 minFar = minEye * (clusterFar / minEye.z);
+                const Vec3 maxNear = maxEye * (clusterNear / maxEye.z);
+                const Vec3 maxFar = maxEye * (clusterFar / maxEye.z);
+                const uint32_t i = y * CLUSTERS_X + x;
+                bounds[0 * CLUSTERS_PER_SLICE + i] = std::min({minNear.x, minFar.x, maxNear.x, maxFar.x});
+                bounds[1 * CLUSTERS_PER_SLICE + i] = std::min({minNear.y, minFar.y, maxNear.y, maxFar.y});
+                bounds[2 * CLUSTERS_PER_SLICE + i] = std::min({minNear.z, minFar.z, maxNear.z, maxFar.z});
+                bounds[3 * CLUSTERS_PER_SLICE + i] = std::max({minNear.x, minFar.x, maxNear.x, maxFar.x});
+                bounds[4 * CLUSTERS_PER_SLICE + i] = std::max({minNear.y, minFar.y, maxNear.y, maxFar.y});
+                bounds[5 * CLUSTERS_PER_SLICE + i] = std::max({minNear.z, minFar.z, maxNear.z, maxFar.z});
+                sliceMin = std::min(sliceMin, bounds[2 * CLUSTERS_PER_SLICE + i]);
+                sliceMax = std::max(sliceMax, bounds[5 * CLUSTERS_PER_SLICE + i]);
+            }
+        }
+        _sliceDepthRanges[2 * z + 0] = sliceMin;
+        _sliceDepthRanges[2 * z + 1] = sliceMax;
+    }
+}
+
+// Tests one light against clusters [first, first + 4) of a Z slice, returns a bit per visible cluster.
+// Point lights use sphere vs AABB, spot lights are additionally tested with the cone
+// vs bounding sphere test of the culling stage.
+uint32_t ClusterLightCulling::intersectClusters4(const float *bounds, uint32_t first, const CpuLight &light) {
+    const float *minX = bounds + 0 * CLUSTERS_PER_SLICE + first;
+    const float *minY = bounds + 1 * CLUSTERS_PER_SLICE + first;
+    const float *minZ = bounds + 2 * CLUSTERS_PER_SLICE + first;
+    const float *maxX = bounds + 3 * CLUSTERS_PER_SLICE + first;
+    const float *maxY = bounds + 4 * CLUSTERS_PER_SLICE + first;
+    const float *maxZ = bounds + 5 * CLUSTERS_PER_SLICE + first;
+#if CC_CLUSTER_SSE2
+    const __m128 bMinX = _mm_loadu_ps(minX);
+    const __m128 bMinY = _mm_loadu_ps(minY);
+    const __m128 bMinZ = _mm_loadu_ps(minZ);
+    const __m128 bMaxX = _mm_loadu_ps(maxX);
+    const __m128 bMaxY = _mm_loadu_ps(maxY);
+    const __m128 bMaxZ = _mm_loadu_ps(maxZ);
+    const __m128 px = _mm_set1_ps(light.position.x);
+    const __m128 py = _mm_set1_ps(light.position.y);
+    const __m128 pz = _mm_set1_ps(light.position.z);
+    const __m128 dx = _mm_sub_ps(_mm_max_ps(bMinX, _mm_min_ps(px, bMaxX)), px);
+    const __m128 dy = _mm_sub_ps(_mm_max_ps(bMinY, _mm_min_ps(py, bMaxY)), py);
+    const __m128 dz = _mm_sub_ps(_mm_max_ps(bMinZ, _mm_min_ps(pz, bMaxZ)), pz);
+    const __m128 distSqr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+    __m128 visible = _mm_cmple_ps(distSqr, _mm_set1_ps(light.range * light.range));
+    if (light.spot) {
+        const __m128 half = _mm_set1_ps(0.5F);
+        const __m128 hx = _mm_mul_ps(_mm_sub_ps(bMaxX, bMinX), half);
+        const __m128 hy = _mm_mul_ps(_mm_sub_ps(bMaxY, bMinY), half);
+        const __m128 hz = _mm_mul_ps(_mm_sub_ps(bMaxZ, bMinZ), half);
+        const __m128 radius = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(hx, hx), _mm_mul_ps(hy, hy)), _mm_mul_ps(hz, hz)));
+        const __m128 vx = _mm_sub_ps(_mm_add_ps(bMinX, hx), px);
+        const __m128 vy = _mm_sub_ps(_mm_add_ps(bMinY, hy), py);
+        const __m128 vz = _mm_sub_ps(_mm_add_ps(bMinZ, hz), pz);
+        const __m128 lenSqr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)), _mm_mul_ps(vz, vz));
+        const __m128 v1Len = _mm_add_ps(_mm_add_ps(
+                                            _mm_mul_ps(vx, _mm_set1_ps(light.direction.x)),
+                                            _mm_mul_ps(vy, _mm_set1_ps(light.direction.y))),
+                                        _mm_mul_ps(vz, _mm_set1_ps(light.direction.z)));
+        const __m128 closest = _mm_sub_ps(
+            _mm_mul_ps(_mm_set1_ps(light.cosAngle), _mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(lenSqr, _mm_mul_ps(v1Len, v1Len)), _mm_setzero_ps()))),
+            _mm_mul_ps(v1Len, _mm_set1_ps(light.sinAngle)));
+        const __m128 culled = _mm_or_ps(
+            _mm_or_ps(_mm_cmpgt_ps(closest, radius), _mm_cmpgt_ps(v1Len, _mm_add_ps(radius, _mm_set1_ps(light.range)))),
+            _mm_cmplt_ps(v1Len, _mm_sub_ps(_mm_setzero_ps(), radius)));
+        visible = _mm_andnot_ps(culled, visible);
+    }
+    return static_cast<uint32_t>(_mm_movemask_ps(visible));
+#elif CC_CLUSTER_NEON
+    const float32x4_t bMinX = vld1q_f32(minX);
+    const float32x4_t bMinY = vld1q_f32(minY);
+    const float32x4_t bMinZ = vld1q_f32(minZ);
+    const float32x4_t bMaxX = vld1q_f32(maxX);
+    const float32x4_t bMaxY = vld1q_f32(maxY);
+    const float32x4_t bMaxZ = vld1q_f32(maxZ);
+    const float32x4_t px = vdupq_n_f32(light.position.x);
+    const float32x4_t py = vdupq_n_f32(light.position.y);
+    const float32x4_t pz = vdupq_n_f32(light.position.z);
+    const float32x4_t dx = vsubq_f32(vmaxq_f32(bMinX, vminq_f32(px, bMaxX)), px);
+    const float32x4_t dy = vsubq_f32(vmaxq_f32(bMinY, vminq_f32(py, bMaxY)), py);
+    const float32x4_t dz = vsubq_f32(vmaxq_f32(bMinZ, vminq_f32(pz, bMaxZ)), pz);
+    const float32x4_t distSqr = vmlaq_f32(vmlaq_f32(vmulq_f32(dx, dx), dy, dy), dz, dz);
+    uint32x4_t visible = vcleq_f32(distSqr, vdupq_n_f32(light.range * light.range));
+    if (light.spot) {
+        const float32x4_t hx = vmulq_n_f32(vsubq_f32(bMaxX, bMinX), 0.5F);
+        const float32x4_t hy = vmulq_n_f32(vsubq_f32(bMaxY, bMinY), 0.5F);
+        const float32x4_t hz = vmulq_n_f32(vsubq_f32(bMaxZ, bMinZ), 0.5F);
+        const float32x4_t radius = vsqrtq_f32(vmlaq_f32(vmlaq_f32(vmulq_f32(hx, hx), hy, hy), hz, hz));
+        const float32x4_t vx = vsubq_f32(vaddq_f32(bMinX, hx), px);
+        const float32x4_t vy = vsubq_f32(vaddq_f32(bMinY, hy), py);
+        const float32x4_t vz = vsubq_f32(vaddq_f32(bMinZ, hz), pz);
+        const float32x4_t lenSqr = vmlaq_f32(vmlaq_f32(vmulq_f32(vx, vx), vy, vy), vz, vz);
+        const float32x4_t v1Len = vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(vx, light.direction.x), vy, light.direction.y), vz, light.direction.z);
+        const float32x4_t closest = vsubq_f32(
+            vmulq_n_f32(vsqrtq_f32(vmaxq_f32(vmlsq_f32(lenSqr, v1Len, v1Len), vdupq_n_f32(0.F))), light.cosAngle),
+            vmulq_n_f32(v1Len, light.sinAngle));
+        const uint32x4_t culled = vorrq_u32(
+            vorrq_u32(vcgtq_f32(closest, radius), vcgtq_f32(v1Len, vaddq_f32(radius, vdupq_n_f32(light.range)))),
+            vcltq_f32(v1Len, vnegq_f32(radius)));
+        visible = vbicq_u32(visible, culled);
+    }
+    const uint32_t bits[4] = {1, 2, 4, 8};
+    return vaddvq_u32(vandq_u32(visible, vld1q_u32(bits)));
+#else
+    uint32_t mask = 0;
+    for (uint32_t i = 0; i < 4; ++i) {
+        const float dx = std::max(minX[i], std::min(light.position.x, maxX[i])) - light.position.x;
+        const float dy = std::max(minY[i], std::min(light.position.y, maxY[i])) - light.position.y;
+        const float dz = std::max(minZ[i], std::min(light.position.z, maxZ[i])) - light.position.z;
+        bool visible = dx * dx + dy * dy + dz * dz <= light.range * light.range;
+        if (visible && light.spot) {
+            const Vec3 halfExtents((maxX[i] - minX[i]) * 0.5F, (maxY[i] - minY[i]) * 0.5F, (maxZ[i] - minZ[i]) * 0.5F);
+            const float radius = halfExtents.length();
+            const Vec3 v = Vec3(minX[i], minY[i], minZ[i]) + halfExtents - light.position;
+            const float v1Len = v.dot(light.direction);
+            const float closest = light.cosAngle * std::sqrt(std::max(v.lengthSquared() - v1Len * v1Len, 0.F)) - v1Len * light.sinAngle;
+            visible = !(closest > radius || v1Len > radius + light.range || v1Len < -radius);
+        }
+        mask |= visible ? (1U << i) : 0U;
+    }
+    return mask;
+#endif
+}
+
+void ClusterLightCulling::cullLightsCpu() {
+    CC_PROFILE(ClusterLightCullingCpu);
+    if (_rebuildClusters || _clusterBounds.empty()) {
+        buildClustersCpu();
+    }
+
+    // lights in view space, in the order of the light buffer
+    const auto &matView = _camera->getMatView();
+    auto numLights = static_cast<uint32_t>(_validLights.size());
+    if (_lightDataTexture) {
+        numLights = std::min(numLights, MAX_LIGHTS_GLOBAL);
+    }
+    _cpuLights.resize(numLights);
+    for (uint32_t l = 0; l < numLights; ++l) {
+        const auto *light = _validLights[l];
+        auto &cpuLight = _cpuLights[l];
+        cpuLight = {};
+        switch (light->getType()) {
+            case scene::LightType::SPHERE: {
+                const auto *sphereLight = static_cast<const scene::SphereLight *>(light);
+                Vec3::transformMat4(sphereLight->getPosition(), matView, &cpuLight.position);
+                cpuLight.range = sphereLight->getRange();
+            } break;
+            case scene::LightType::SPOT: {
+                const auto *spotLight = static_cast<const scene::SpotLight *>(light);
+                Vec3::transformMat4(spotLight->getPosition(), matView, &cpuLight.position);
+                Vec3::transformMat4Normal(spotLight->getDirection(), matView, &cpuLight.direction);
+                cpuLight.direction.normalize();
+                cpuLight.range = spotLight->getRange();
+                cpuLight.cosAngle = spotLight->getSpotAngle();
+                cpuLight.sinAngle = std::sqrt(std::max(1.F - cpuLight.cosAngle * cpuLight.cosAngle, 0.F));
+                cpuLight.spot = true;
+            } break;
+            case scene::LightType::POINT: {
+                const auto *pointLight = static_cast<const scene::PointLight *>(light);
+                Vec3::transformMat4(pointLight->getPosition(), matView, &cpuLight.position);
+                cpuLight.range = pointLight->getRange();
+            } break;
+            case scene::LightType::RANGED_DIRECTIONAL: {
+                // bounded by the sphere around its box
+                const auto *rangedDirLight = static_cast<const scene::RangedDirectionalLight *>(light);
+                Vec3::transformMat4(rangedDirLight->getPosition(), matView, &cpuLight.position);
+                cpuLight.range = (rangedDirLight->getScale() * 0.5F).length();
+            } break;
+            default:
+                break;
+        }
+    }
+
+    _lightIndexData.resize(CLUSTER_COUNT * MAX_LIGHTS_PER_CLUSTER);
+    _lightGridData.assign(CLUSTER_COUNT * 4, 0);
+
+    // clusters of a slice are written by one job only, each cluster owns MAX_LIGHTS_PER_CLUSTER indices
+    auto cullSlice = [this, numLights](uint32_t z) {
+        const float *bounds = _clusterBounds.data() + z * 6 * CLUSTERS_PER_SLICE;
+        const float sliceMin = _sliceDepthRanges[2 * z + 0];
+        const float sliceMax = _sliceDepthRanges[2 * z + 1];
+        for (uint32_t l = 0; l < numLights; ++l) {
+            const auto &light = _cpuLights[l];
+            if (light.position.z - light.range > sliceMax || light.position.z + light.range < sliceMin) {
+                continue;
+            }
+            for (uint32_t first = 0; first < CLUSTERS_PER_SLICE; first += 4) {
+                const auto mask = intersectClusters4(bounds, first, light);
+                for (uint32_t i = 0; mask >> i; ++i) {
+                    if (!(mask & (1U << i))) {
+                        continue;
+                    }
+                    const uint32_t clusterIndex = z * CLUSTERS_PER_SLICE + first + i;
+                    auto &count = _lightGridData[4 * clusterIndex + 1];
+                    if (count < MAX_LIGHTS_PER_CLUSTER) {
+                        _lightIndexData[clusterIndex * MAX_LIGHTS_PER_CLUSTER + count++] = l;
+                    }
+                }
+            }
+        }
+    };
+
+    if (JobSystem::getInstance()->threadCount() > 1) {
+        JobGraph g(JobSystem::getInstance());
+        g.createForEachIndexJob(0U, CLUSTERS_Z, 1U, cullSlice);
+        g.run();
+        g.waitForAll();
+    } else {
+        for (uint32_t z = 0; z < CLUSTERS_Z; ++z) {
+            cullSlice(z);
+        }
+    }
+
+    // pack the indices, the grid stores (offset, count, 0, 0) of each cluster
+    uint32_t offset = 0;
+    for (uint32_t clusterIndex = 0; clusterIndex < CLUSTER_COUNT; ++clusterIndex) {
+        const auto count = _lightGridData[4 * clusterIndex + 1];
+        const auto *src = _lightIndexData.data() + clusterIndex * MAX_LIGHTS_PER_CLUSTER;
+        std::copy(src, src + count, _lightIndexData.data() + offset);
+        _lightGridData[4 * clusterIndex] = offset;
+        offset += count;
+    }
+    _numLightIndices = offset;
+    CC_PROFILE_OBJECT_UPDATE(ClusterLightIndices, _numLightIndices);
+}
+
+void ClusterLightCulling::addCpuCullingPass() {
+    struct DataLightUpload {
+        framegraph::BufferHandle lightBuffer;      // light storage buffer
+        framegraph::BufferHandle lightIndexBuffer; // light index storage buffer
+        framegraph::BufferHandle lightGridBuffer;  // light grid storage buffer
+    };
+
+    auto lightUploadSetup = [&](framegraph::PassNodeBuilder &builder, DataLightUpload &data) {
+        data.lightBuffer = framegraph::BufferHandle(builder.readFromBlackboard(fgStrHandleClusterLightBuffer));
+        if (!data.lightBuffer.isValid() || _lightBufferResized) {
+            framegraph::Buffer::Descriptor bufferInfo;
+            bufferInfo.usage = gfx::BufferUsageBit::STORAGE | gfx::BufferUsageBit::TRANSFER_DST;
+            bufferInfo.memUsage = gfx::MemoryUsageBit::HOST | gfx::MemoryUsageBit::DEVICE;
+            bufferInfo.size = _lightBufferStride * _lightBufferCount;
+            bufferInfo.stride = _lightBufferStride;
+            bufferInfo.flags = gfx::BufferFlagBit::NONE;
+            data.lightBuffer = builder.create(fgStrHandleClusterLightBuffer, bufferInfo);
+            _lightBufferResized = false;
+        }
+        data.lightBuffer = builder.write(data.lightBuffer);
+        builder.writeToBlackboard(fgStrHandleClusterLightBuffer, data.lightBuffer);
+
+        data.lightIndexBuffer = framegraph::BufferHandle(builder.readFromBlackboard(fgStrHandleClusterLightIndexBuffer));
+        if (!data.lightIndexBuffer.isValid()) {
+            uint32_t lightIndicesBufferSize = MAX_LIGHTS_PER_CLUSTER * CLUSTER_COUNT * sizeof(int);
+
+            framegraph::Buffer::Descriptor bufferInfo;
+            bufferInfo.usage = gfx::BufferUsageBit::STORAGE | gfx::BufferUsageBit::TRANSFER_DST;
+            bufferInfo.memUsage = gfx::MemoryUsageBit::DEVICE;
+            bufferInfo.size = lightIndicesBufferSize;
+            bufferInfo.stride = lightIndicesBufferSize;
+            bufferInfo.flags = gfx::BufferFlagBit::NONE;
+            data.lightIndexBuffer = builder.create(fgStrHandleClusterLightIndexBuffer, bufferInfo);
+        }
+        data.lightIndexBuffer = builder.write(data.lightIndexBuffer);
+        builder.writeToBlackboard(fgStrHandleClusterLightIndexBuffer, data.lightIndexBuffer);
+
+        data.lightGridBuffer = framegraph::BufferHandle(builder.readFromBlackboard(fgStrHandleClusterLightGridBuffer));
+        if (!data.lightGridBuffer.isValid()) {
+            uint32_t lightGridBufferSize = CLUSTER_COUNT * 4 * sizeof(uint32_t);
+
+            framegraph::Buffer::Descriptor bufferInfo;
+            bufferInfo.usage = gfx::BufferUsageBit::STORAGE | gfx::BufferUsageBit::TRANSFER_DST;
+            bufferInfo.memUsage = gfx::MemoryUsageBit::DEVICE;
+            bufferInfo.size = lightGridBufferSize;
+            bufferInfo.stride = lightGridBufferSize;
+            bufferInfo.flags = gfx::BufferFlagBit::NONE;
+            data.lightGridBuffer = builder.create(fgStrHandleClusterLightGridBuffer, bufferInfo);
+        }
+        data.lightGridBuffer = builder.write(data.lightGridBuffer);
+        builder.writeToBlackboard(fgStrHandleClusterLightGridBuffer, data.lightGridBuffer);
+    };
+
+    auto lightUploadExec = [&](DataLightUpload const &data, const framegraph::DevicePassResourceTable &table) {
+        auto *cmdBuff = _pipeline->getCommandBuffers()[0];
+        cmdBuff->updateBuffer(table.getWrite(data.lightBuffer), _lightBufferData.data(),
+                              static_cast<uint32_t>(_lightBufferData.size() * sizeof(float)));
+        if (_numLightIndices > 0) {
+            cmdBuff->updateBuffer(table.getWrite(data.lightIndexBuffer), _lightIndexData.data(),
+                                  static_cast<uint32_t>(_numLightIndices * sizeof(uint32_t)));
+        }
+        cmdBuff->updateBuffer(table.getWrite(data.lightGridBuffer), _lightGridData.data(),
+                              static_cast<uint32_t>(_lightGridData.size() * sizeof(uint32_t)));
+    };
+
+    auto *pipeline = static_cast<DeferredPipeline *>(_pipeline);
+    auto insertPoint = static_cast<uint32_t>(DeferredInsertPoint::DIP_CLUSTER);
+    pipeline->getFrameGraph().addPass<DataLightUpload>(insertPoint, fgStrHandleClusterCullingPass, lightUploadSetup, lightUploadExec);
+}
+
+void ClusterLightCulling::packLightDataTexture() {
+    float *texels = _lightTextureData.data();
+
+    for (uint32_t clusterIndex = 0; clusterIndex < CLUSTER_COUNT; ++clusterIndex) {
+        texels[4 * clusterIndex + 0] = static_cast<float>(_lightGridData[4 * clusterIndex + 0]);
+        texels[4 * clusterIndex + 1] = static_cast<float>(_lightGridData[4 * clusterIndex + 1]);
+    }
+
+    const auto numLights = static_cast<uint32_t>(_cpuLights.size());
+    std::copy(_lightBufferData.data(), _lightBufferData.data() + 16 * numLights, texels + 4 * LIGHT_DATA_LIGHTS_OFFSET);
+
+    // indices stay below 2^24, floats hold them exactly
+    float *indices = texels + 4 * LIGHT_DATA_INDICES_OFFSET;
+    for (uint32_t i = 0; i < _numLightIndices; ++i) {
+        indices[i] = static_cast<float>(_lightIndexData[i]);
+    }
+
+    const uint32_t usedTexels = LIGHT_DATA_INDICES_OFFSET + (_numLightIndices + 3) / 4;
+    _lightTextureRows = (usedTexels + LIGHT_DATA_TEXTURE_WIDTH - 1) / LIGHT_DATA_TEXTURE_WIDTH;
+}
+
+void ClusterLightCulling::addLightDataTexturePass() {
+    struct DataLightTextureUpload {
+        framegraph::TextureHandle lightDataTexture; // light grid, lights and light indices
+    };
+
+    auto lightTextureSetup = [&](framegraph::PassNodeBuilder &builder, DataLightTextureUpload &data) {
+        data.lightDataTexture = framegraph::TextureHandle(builder.readFromBlackboard(fgStrHandleClusterLightDataTexture));
+        if (!data.lightDataTexture.isValid()) {
+            framegraph::Texture::Descriptor textureInfo;
+            textureInfo.format = gfx::Format::RGBA32F;
+            textureInfo.usage = gfx::TextureUsageBit::SAMPLED | gfx::TextureUsageBit::TRANSFER_DST;
+            textureInfo.width = LIGHT_DATA_TEXTURE_WIDTH;
+            textureInfo.height = LIGHT_DATA_TEXTURE_HEIGHT;
+            data.lightDataTexture = builder.create(fgStrHandleClusterLightDataTexture, textureInfo);
+        }
+        data.lightDataTexture = builder.write(data.lightDataTexture);
+        builder.writeToBlackboard(fgStrHandleClusterLightDataTexture, data.lightDataTexture);
+    };
+
+    auto lightTextureExec = [&](DataLightTextureUpload const &data, const framegraph::DevicePassResourceTable &table) {
+        auto *cmdBuff = _pipeline->getCommandBuffers()[0];
+        // only the rows holding indices of this frame are uploaded
+        gfx::BufferTextureCopy region;
+        region.texExtent.width = LIGHT_DATA_TEXTURE_WIDTH;
+        region.texExtent.height = _lightTextureRows;
+        const auto *buffer = reinterpret_cast<const uint8_t *>(_lightTextureData.data());
+        cmdBuff->copyBuffersToTexture(&buffer, table.getWrite(data.lightDataTexture), &region, 1);
+    };
+
+    auto *pipeline = static_cast<DeferredPipeline *>(_pipeline);
+    auto insertPoint = static_cast<uint32_t>(DeferredInsertPoint::DIP_CLUSTER);
+    pipeline->getFrameGraph().addPass<DataLightTextureUpload>(insertPoint, fgStrHandleClusterCullingPass, lightTextureSetup, lightTextureExec);
+}
+
 ccstd::string &ClusterLightCulling::getShaderSource(ShaderStrings &sources) {
     switch (_device->getGfxAPI()) {
         case gfx::API::GLES2:
@@ -58,11 +58,40 @@ public:
 
     static constexpr uint32_t MAX_LIGHTS_GLOBAL = 1000;
 
+    static constexpr uint32_t CLUSTERS_PER_SLICE = CLUSTERS_X * CLUSTERS_Y;
+
+    // RGBA32F light data texture used instead of storage buffers without compute support:
+    // the light grid, 4 texels per light, then the light indices packed 4 per texel.
+    // Mirrored by CLUSTER_LIGHT_DATA_* in shading-cluster-additive.chunk
+    static constexpr uint32_t LIGHT_DATA_TEXTURE_WIDTH = 1024;
+    static constexpr uint32_t LIGHT_DATA_LIGHTS_OFFSET = CLUSTER_COUNT;
+    static constexpr uint32_t LIGHT_DATA_INDICES_OFFSET = LIGHT_DATA_LIGHTS_OFFSET + 4 * MAX_LIGHTS_GLOBAL;
+    static constexpr uint32_t LIGHT_DATA_TEXTURE_HEIGHT =
+        (LIGHT_DATA_INDICES_OFFSET + CLUSTER_COUNT * MAX_LIGHTS_PER_CLUSTER / 4 + LIGHT_DATA_TEXTURE_WIDTH - 1) / LIGHT_DATA_TEXTURE_WIDTH;
+
+    // cluster shading needs compute shaders, or float textures for the CPU path
+    static bool isSupported(const gfx::Device *device);
+    // whether the lighting pass reads the light lists from the light data texture
+    static bool usesLightDataTexture(const gfx::Device *device);
+
     void initialize(gfx::Device *dev);
 
     void clusterLightCulling(scene::Camera *camera);
 
+    // Assign lights to clusters on the CPU and upload the result, instead of
+    // running the compute stages. Always on when compute shaders are unavailable.
+    inline bool isCpuCullingEnabled() const { return _cpuCulling; }
+    void setCpuCullingEnabled(bool enable);
+
 private:
+    struct CpuLight {
+        Vec3 position;
+        float range{0.F};
+        Vec3 direction;
+        float cosAngle{0.F};
+        float sinAngle{0.F};
+        bool spot{false};
+    };
     ccstd::string &getShaderSource(ShaderStrings &sources);
 
     void initBuildingSatge();
@@ -75,6 +104,18 @@ private:
 
     void updateLights();
 
+    void buildClustersCpu();
+
+    void cullLightsCpu();
+
+    void addCpuCullingPass();
+
+    void packLightDataTexture();
+
+    void addLightDataTexturePass();
+
+    static uint32_t intersectClusters4(const float *bounds, uint32_t first, const CpuLight &light);
+
     static bool isProjMatChange(const Mat4 &curProj, const Mat4 &oldProj) {
         for (uint32_t i = 0; i < sizeof(curProj.m) / sizeof(float); i++) {
             if (math::isNotEqualF(curProj.m[i], oldProj.m[i])) {
@@ -136,6 +177,20 @@ private:
     bool _rebuildClusters{false};
     ccstd::vector<Mat4> _oldCamProjMats;
 
+    // view space cluster AABBs, per Z slice: minX, minY, minZ, maxX, maxY, maxZ of all clusters in the slice
+    ccstd::vector<float> _clusterBounds;
+    // view space depth range of each Z slice
+    ccstd::vector<float> _sliceDepthRanges;
+    ccstd::vector<CpuLight> _cpuLights;
+    ccstd::vector<uint32_t> _lightIndexData;
+    ccstd::vector<uint32_t> _lightGridData;
+    uint32_t _numLightIndices{0};
+    bool _cpuCulling{false};
+
+    ccstd::vector<float> _lightTextureData;
+    uint32_t _lightTextureRows{0};
+    bool _lightDataTexture{false};
+
     bool _initialized{false};
 };
 
@@ -139,12 +139,6 @@ struct CC_DLL InternalBindingInst : public InternalBindingDesc {
     gfx::Texture *texture = nullptr;
 };
 
-struct CC_DLL RenderQueueCreateInfo {
-    bool isTransparent = false;
-    uint32_t phases = 0;
-    std::function<bool(const RenderPass &a, const RenderPass &b)> sortFunc;
-};
-
 enum class CC_DLL RenderPriority {
     MIN = 0,
     MAX = 0xff,
@@ -158,6 +152,15 @@ enum class CC_DLL RenderQueueSortMode {
 };
 CC_ENUM_CONVERSION_OPERATOR(RenderQueueSortMode)
 
+struct CC_DLL RenderQueueCreateInfo {
+    bool isTransparent = false;
+    uint32_t phases = 0;
+    std::function<bool(const RenderPass &a, const RenderPass &b)> sortFunc;
+    // sort by packed 64-bit keys instead of sortFunc, sortFunc must then be the comparator of sortMode
+    bool sortByKey = false;
+    RenderQueueSortMode sortMode = RenderQueueSortMode::FRONT_TO_BACK;
+};
+
 class CC_DLL RenderQueueDesc : public RefCounted {
 public:
     RenderQueueDesc() = default;
@@ -42,6 +42,17 @@ InstancedBuffer::~InstancedBuffer() {
     destroy();
 }
 
+InstancedBufferStats &InstancedBufferStats::operator+=(const InstancedBufferStats &rhs) {
+    draws += rhs.draws;
+    instances += rhs.instances;
+    mergeMisses += rhs.mergeMisses;
+    capacityMisses += rhs.capacityMisses;
+    meshMisses += rhs.meshMisses;
+    shaderMisses += rhs.shaderMisses;
+    bindingMisses += rhs.bindingMisses;
+    return *this;
+}
+
 void InstancedBuffer::destroy() {
     for (auto &instance : _instances) {
         CC_SAFE_DESTROY_AND_DELETE(instance.vb);
@@ -49,6 +60,8 @@ void InstancedBuffer::destroy() {
         CC_FREE(instance.data);
     }
     _instances.clear();
+    _firstInstances.clear();
+    _lastMergedInstance = UINT32_MAX;
 }
 
 void InstancedBuffer::merge(scene::SubModel *subModel, uint32_t passIdx) {
@@ -63,58 +76,76 @@ void InstancedBuffer::merge(scene::SubModel *subModel, uint32_t passIdx, gfx::Sh
 
     auto *sourceIA = subModel->getInputAssembler();
     auto *descriptorSet = subModel->getDescriptorSet();
-    auto *lightingMap = descriptorSet->getTexture(LIGHTMAPTEXTURE::BINDING);
-    auto *reflectionProbeCubemap = descriptorSet->getTexture(REFLECTIONPROBECUBEMAP::BINDING);
-    auto *reflectionProbePlanarMap = descriptorSet->getTexture(REFLECTIONPROBEPLANARMAP::BINDING);
-    auto *reflectionProbeBlendCubemap = descriptorSet->getTexture(REFLECTIONPROBEBLENDCUBEMAP::BINDING);
-    uint32_t reflectionProbeType = subModel->getReflectionProbeType();
     auto *shader = shaderImplant;
     if (!shader) {
         shader = subModel->getShader(passIdx);
     }
 
-    for (auto &instance : _instances) {
-        if (instance.ia->getIndexBuffer() != sourceIA->getIndexBuffer() || instance.drawInfo.instanceCount >= MAX_CAPACITY) {
-            continue;
-        }
-
-        // check same binding
-        if (instance.lightingMap != lightingMap) {
-            continue;
-        }
-
-        if (instance.reflectionProbeType != reflectionProbeType) {
-            continue;
-        }
-        if (instance.reflectionProbeCubemap != reflectionProbeCubemap) {
-            continue;
-        }
-        if (instance.reflectionProbePlanarMap != reflectionProbePlanarMap) {
-            continue;
-        }
-        if (instance.reflectionProbeBlendCubemap != reflectionProbeBlendCubemap) {
-            continue;
-        }
+    auto *indexBuffer = sourceIA->getIndexBuffer();
+    auto *lightingMap = descriptorSet->getTexture(LIGHTMAPTEXTURE::BINDING);
+    auto *reflectionProbeCubemap = descriptorSet->getTexture(REFLECTIONPROBECUBEMAP::BINDING);
+    auto *reflectionProbePlanarMap = descriptorSet->getTexture(REFLECTIONPROBEPLANARMAP::BINDING);
+    auto *reflectionProbeBlendCubemap = descriptorSet->getTexture(REFLECTIONPROBEBLENDCUBEMAP::BINDING);
+    uint32_t reflectionProbeType = subModel->getReflectionProbeType();
 
-        if (instance.stride != stride) {
-            continue;
-        }
-        if (instance.drawInfo.instanceCount >= instance.capacity) { // resize buffers
-            instance.capacity <<= 1;
-            const auto newSize = instance.stride * instance.capacity;
-            instance.data = static_cast<uint8_t *>(CC_REALLOC(instance.data, newSize));
-            instance.vb->resize(newSize);
-        }
-        if (instance.shader != shader) {
-            instance.shader = shader;
+    // the hash only selects the bucket, items of a bucket are still compared by their bindings
+    ccstd::hash_t hash = subModel->getInstancingHash();
+    ccstd::hash_combine(hash, shader);
+
+    ++_stats.instances;
+    uint32_t *nextIndex = nullptr;
+    auto iter = _firstInstances.find(hash);
+    if (iter != _firstInstances.end()) {
+        bool hasCompatible = false;
+        bool hasFull = false;
+        for (auto index = iter->second; index != UINT32_MAX; index = _instances[index].nextWithSameHash) {
+            auto &instance = _instances[index];
+            nextIndex = &instance.nextWithSameHash;
+            if (instance.stride != stride || instance.shader != shader ||
+                instance.ia->getIndexBuffer() != indexBuffer ||
+                instance.lightingMap != lightingMap ||
+                instance.reflectionProbeType != reflectionProbeType ||
+                instance.reflectionProbeCubemap != reflectionProbeCubemap ||
+                instance.reflectionProbePlanarMap != reflectionProbePlanarMap ||
+                instance.reflectionProbeBlendCubemap != reflectionProbeBlendCubemap) {
+                continue;
+            }
+            hasCompatible = true;
+            if (instance.drawInfo.instanceCount >= MAX_CAPACITY) {
+                hasFull = true;
+                continue;
+            }
+            if (instance.drawInfo.instanceCount >= instance.capacity) { // resize buffers
+                instance.capacity <<= 1;
+                const auto newSize = instance.stride * instance.capacity;
+                instance.data = static_cast<uint8_t *>(CC_REALLOC(instance.data, newSize));
+                instance.vb->resize(newSize);
+            }
+            if (instance.descriptorSet != descriptorSet) {
+                instance.descriptorSet = descriptorSet;
+            }
+            if (!instance.drawInfo.instanceCount) {
+                ++_stats.draws;
+                if (hasFull) {
+                    ++_stats.capacityMisses;
+                } else {
+                    updateMissStats(subModel, shader);
+                }
+            }
+            memcpy(instance.data + instance.stride * instance.drawInfo.instanceCount++, attrs.buffer.buffer()->getData(), stride);
+            _lastMergedInstance = index;
+            _hasPendingModels = true;
+            return;
         }
-        if (instance.descriptorSet != descriptorSet) {
-            instance.descriptorSet = descriptorSet;
+        if (hasCompatible) {
+            ++_stats.capacityMisses;
+        } else {
+            updateMissStats(subModel, shader);
         }
-        memcpy(instance.data + instance.stride * instance.drawInfo.instanceCount++, attrs.buffer.buffer()->getData(), stride);
-        _hasPendingModels = true;
-        return;
+    } else {
+        updateMissStats(subModel, shader);
     }
+    ++_stats.draws;
 
     // Create a new instance
     const auto newSize = stride * INITIAL_CAPACITY;
@@ -127,7 +158,6 @@ void InstancedBuffer::merge(scene::SubModel *subModel, uint32_t passIdx, gfx::Sh
 
     auto vertexBuffers = sourceIA->getVertexBuffers();
     auto attributes = sourceIA->getAttributes();
-    auto *indexBuffer = sourceIA->getIndexBuffer();
 
     for (const auto &attribute : attrs.attributes) {
         attributes.emplace_back(gfx::Attribute{
@@ -146,12 +176,34 @@ void InstancedBuffer::merge(scene::SubModel *subModel, uint32_t passIdx, gfx::Sh
     auto *ia = _device->createInputAssembler(iaInfo);
     InstancedItem item = {INITIAL_CAPACITY, vb, data, ia, stride, shader, descriptorSet,
                           lightingMap, reflectionProbeCubemap, reflectionProbePlanarMap, reflectionProbeType, reflectionProbeBlendCubemap,
-                          ia->getDrawInfo()};
+                          ia->getDrawInfo(), hash};
     item.drawInfo.instanceCount = 1;
+    const auto index = static_cast<uint32_t>(_instances.size());
+    if (nextIndex) {
+        *nextIndex = index;
+    } else {
+        _firstInstances.emplace(hash, index);
+    }
     _instances.emplace_back(item);
+    _lastMergedInstance = index;
     _hasPendingModels = true;
 }
 
+void InstancedBuffer::updateMissStats(const scene::SubModel *subModel, gfx::Shader *shader) {
+    ++_stats.mergeMisses;
+    if (_lastMergedInstance >= _instances.size()) {
+        return;
+    }
+    const auto &last = _instances[_lastMergedInstance];
+    if (last.ia->getIndexBuffer() != subModel->getInputAssembler()->getIndexBuffer()) {
+        ++_stats.meshMisses;
+    } else if (last.shader != shader) {
+        ++_stats.shaderMisses;
+    } else {
+        ++_stats.bindingMisses;
+    }
+}
+
 void InstancedBuffer::uploadBuffers(gfx::CommandBuffer *cmdBuff) const {
     for (const auto &instance : _instances) {
         if (!instance.drawInfo.instanceCount) continue;
@@ -166,6 +218,8 @@ void InstancedBuffer::clear() {
         instance.drawInfo.instanceCount = 0;
     }
     _hasPendingModels = false;
+    _stats = {};
+    _lastMergedInstance = UINT32_MAX;
 }
 
 void InstancedBuffer::setDynamicOffset(uint32_t idx, uint32_t value) {
@@ -27,6 +27,7 @@
 #include "Define.h"
 #include "base/RefCounted.h"
 #include "base/std/container/unordered_map.h"
+#include "base/std/hash/hash.h"
 #include "scene/Model.h"
 #include "scene/Pass.h"
 
@@ -51,8 +52,31 @@ struct CC_DLL InstancedItem {
     uint32_t reflectionProbeType = 0;
     gfx::Texture *reflectionProbeBlendCubemap = nullptr;
     gfx::DrawInfo drawInfo;
+    // SubModel::getInstancingHash combined with the shader
+    ccstd::hash_t hash = 0;
+    // next item with the same hash, used once this one is full
+    uint32_t nextWithSameHash = UINT32_MAX;
 };
 using InstancedItemList = ccstd::vector<InstancedItem>;
+
+// per frame merge statistics, reset by InstancedBuffer::clear
+struct CC_DLL InstancedBufferStats {
+    // instanced draws with at least one instance
+    uint32_t draws = 0;
+    uint32_t instances = 0;
+    // merges that started a draw because no draw with the same shader and bound state was open
+    uint32_t mergeMisses = 0;
+    // merges that started a draw because the compatible draws were full
+    uint32_t capacityMisses = 0;
+    // what differed from the draw of the previous merge when mergeMisses was increased
+    uint32_t meshMisses = 0;
+    uint32_t shaderMisses = 0;
+    uint32_t bindingMisses = 0;
+
+    inline float getInstancesPerDraw() const { return draws ? static_cast<float>(instances) / static_cast<float>(draws) : 0.F; }
+
+    InstancedBufferStats &operator+=(const InstancedBufferStats &rhs);
+};
 using DynamicOffsetList = ccstd::vector<uint32_t>;
 
 class InstancedBuffer : public RefCounted {
@@ -75,9 +99,16 @@ public:
     inline void setPass(const scene::Pass *pass) noexcept { _pass = pass; }
     inline bool hasPendingModels() const { return _hasPendingModels; }
     inline const DynamicOffsetList &dynamicOffsets() const { return _dynamicOffsets; }
+    inline const InstancedBufferStats &getStats() const { return _stats; }
 
 private:
+    void updateMissStats(const scene::SubModel *subModel, gfx::Shader *shader);
+
     InstancedItemList _instances;
+    // first item of every hash, the others are chained by InstancedItem::nextWithSameHash
+    ccstd::unordered_map<ccstd::hash_t, uint32_t> _firstInstances;
+    InstancedBufferStats _stats;
+    uint32_t _lastMergedInstance{UINT32_MAX};
     // weak reference
     const scene::Pass *_pass{nullptr};
     bool _hasPendingModels{false};
@@ -46,7 +46,10 @@ gfx::PipelineState *PipelineStateManager::getOrCreatePipelineState(const scene::
         hash = hash << subpass;
     }
 
-    auto *pso = psoHashMap[static_cast<ccstd::hash_t>(hash)].get();
+    // Lookups must not modify the map, so that command buffers can be recorded
+    // in parallel once every pipeline state of a pass has been created.
+    auto iter = psoHashMap.find(static_cast<ccstd::hash_t>(hash));
+    gfx::PipelineState *pso = iter != psoHashMap.end() ? iter->second.get() : nullptr;
     if (!pso) {
         auto *pipelineLayout = pass->getPipelineLayout();
 
@@ -31,6 +31,7 @@
 #include "PipelineUBO.h"
 #include "RenderInstancedQueue.h"
 #include "base/Utils.h"
+#include "core/Root.h"
 #include "forward/ForwardPipeline.h"
 #include "gfx-base/GFXDevice.h"
 #include "scene/Camera.h"
@@ -138,7 +139,7 @@ void RenderAdditiveLightQueue::gatherLightPasses(const scene::Camera *camera, gf
                 continue;
             }
             auto *descriptorSet = subModel->getDescriptorSet();
-            descriptorSet->bindBuffer(UBOForwardLight::BINDING, _firstLightBufferView);
+            descriptorSet->bindBuffer(UBOForwardLight::BINDING, _lightBufferView);
             descriptorSet->update();
 
             addRenderQueue(subModel, model, pass, lightPassIdx);
@@ -151,7 +152,7 @@ void RenderAdditiveLightQueue::gatherLightPasses(const scene::Camera *camera, gf
     for (uint32_t l = 0; l < _validPunctualLights.size(); l++) {
         const auto *light = _validPunctualLights[l];
         _instancedLightPass.lights.emplace_back(light);
-        _instancedLightPass.dynamicOffsets.emplace_back(_lightBufferStride * l);
+        _instancedLightPass.dynamicOffsets.emplace_back(_lightBufferOffset + _lightBufferStride * l);
     }
     for (const auto &instancedQueue : _instancedQueues) {
         instancedQueue->uploadBuffers(cmdBuffer);
@@ -222,7 +223,7 @@ void RenderAdditiveLightQueue::addRenderQueue(scene::SubModel *subModel, const s
                 } break;
                 case scene::BatchingSchemes::NONE: {
                     lightPass.lights.emplace_back(light);
-                    lightPass.dynamicOffsets.emplace_back(_lightBufferStride * lightIdx);
+                    lightPass.dynamicOffsets.emplace_back(_lightBufferOffset + _lightBufferStride * lightIdx);
                 } break;
             }
         }
@@ -241,16 +242,31 @@ void RenderAdditiveLightQueue::updateUBOs(const scene::Camera *camera, gfx::Comm
     const auto *sceneData = _pipeline->getPipelineSceneData();
     const auto *shadowInfo = sceneData->getShadows();
 
-    size_t offset = 0;
-    if (validLightCount > _lightBufferCount) {
-        _lightBufferCount = nextPow2(static_cast<uint32_t>(validLightCount));
-        _lightBuffer->resize(utils::toUint(_lightBufferStride * _lightBufferCount));
-        _lightBufferData.resize(static_cast<size_t>(_lightBufferElementCount) * _lightBufferCount);
-
-        auto *device = gfx::Device::getInstance();
-        _firstLightBufferView = device->createBuffer({_lightBuffer, 0, UBOForwardLight::SIZE});
+    // the UBOs of each camera are suballocated from the uniform ring, the own buffer is the fallback when it is full
+    auto *ring = Root::getInstance()->getUniformRingBuffer();
+    const auto allocation = ring ? ring->allocate(utils::toUint(_lightBufferStride * validLightCount)) : gfx::FrameRingAllocation{};
+    float *lightBufferData = nullptr;
+    if (allocation.isValid()) {
+        memset(allocation.data, 0, allocation.size);
+        lightBufferData = reinterpret_cast<float *>(allocation.data);
+        _lightBufferOffset = allocation.offset;
+        _lightBufferView = ring->getBufferView(UBOForwardLight::SIZE);
+    } else {
+        if (validLightCount > _lightBufferCount) {
+            _lightBufferCount = nextPow2(static_cast<uint32_t>(validLightCount));
+            _lightBuffer->resize(utils::toUint(_lightBufferStride * _lightBufferCount));
+            _lightBufferData.resize(static_cast<size_t>(_lightBufferElementCount) * _lightBufferCount);
+
+            auto *device = gfx::Device::getInstance();
+            _firstLightBufferView = device->createBuffer({_lightBuffer, 0, UBOForwardLight::SIZE});
+        }
+        lightBufferData = _lightBufferData.data();
+        _lightBufferOffset = 0;
+        _lightBufferView = _firstLightBufferView;
     }
 
+    size_t offset = 0;
+
     for (unsigned l = 0; l < validLightCount; l++, offset += _lightBufferElementCount) {
         const auto *light = _validPunctualLights[l];
         Vec3 position = Vec3(0.0F, 0.0F, 0.0F);
@@ -288,44 +304,44 @@ void RenderAdditiveLightQueue::updateUBOs(const scene::Camera *camera, gfx::Comm
             luminanceLDR = rangedDirLight->getIlluminanceLDR();
         }
         auto index = offset + UBOForwardLight::LIGHT_POS_OFFSET;
-        _lightBufferData[index++] = position.x;
-        _lightBufferData[index++] = position.y;
-        _lightBufferData[index] = position.z;
+        lightBufferData[index++] = position.x;
+        lightBufferData[index++] = position.y;
+        lightBufferData[index] = position.z;
 
         index = offset + UBOForwardLight::LIGHT_SIZE_RANGE_ANGLE_OFFSET;
-        _lightBufferData[index++] = size;
-        _lightBufferData[index] = range;
+        lightBufferData[index++] = size;
+        lightBufferData[index] = range;
 
         index = offset + UBOForwardLight::LIGHT_COLOR_OFFSET;
         const auto &color = light->getColor();
         if (light->isUseColorTemperature()) {
             const auto &tempRGB = light->getColorTemperatureRGB();
-            _lightBufferData[index++] = color.x * tempRGB.x;
-            _lightBufferData[index++] = color.y * tempRGB.y;
-            _lightBufferData[index++] = color.z * tempRGB.z;
+            lightBufferData[index++] = color.x * tempRGB.x;
+            lightBufferData[index++] = color.y * tempRGB.y;
+            lightBufferData[index++] = color.z * tempRGB.z;
         } else {
-            _lightBufferData[index++] = color.x;
-            _lightBufferData[index++] = color.y;
-            _lightBufferData[index++] = color.z;
+            lightBufferData[index++] = color.x;
+            lightBufferData[index++] = color.y;
+            lightBufferData[index++] = color.z;
         }
 
         if (sceneData->isHDR()) {
-            _lightBufferData[index] = luminanceHDR * exposure * _lightMeterScale;
+            lightBufferData[index] = luminanceHDR * exposure * _lightMeterScale;
         } else {
-            _lightBufferData[index] = luminanceLDR;
+            lightBufferData[index] = luminanceLDR;
         }
 
         switch (light->getType()) {
             case scene::LightType::SPHERE:
-                _lightBufferData[offset + UBOForwardLight::LIGHT_POS_OFFSET + 3] = static_cast<float>(scene::LightType::SPHERE);
-                _lightBufferData[offset + UBOForwardLight::LIGHT_SIZE_RANGE_ANGLE_OFFSET + 2] = 0;
-                _lightBufferData[offset + UBOForwardLight::LIGHT_SIZE_RANGE_ANGLE_OFFSET + 3] = 0;
+                lightBufferData[offset + UBOForwardLight::LIGHT_POS_OFFSET + 3] = static_cast<float>(scene::LightType::SPHERE);
+                lightBufferData[offset + UBOForwardLight::LIGHT_SIZE_RANGE_ANGLE_OFFSET + 2] = 0;
+                lightBufferData[offset + UBOForwardLight::LIGHT_SIZE_RANGE_ANGLE_OFFSET + 3] = 0;
                 break;
             case scene::LightType::SPOT: {
                 const auto *spotLight = static_cast<const scene::SpotLight *>(light);
-                _lightBufferData[offset + UBOForwardLight::LIGHT_POS_OFFSET + 3] = static_cast<float>(scene::LightType::SPOT);
-                _lightBufferData[offset + UBOForwardLight::LIGHT_SIZE_RANGE_ANGLE_OFFSET + 2] = spotLight->getSpotAngle();
-                _lightBufferData[offset + UBOForwardLight::LIGHT_SIZE_RANGE_ANGLE_OFFSET + 3] = (shadowInfo->isEnabled() &&
+                lightBufferData[offset + UBOForwardLight::LIGHT_POS_OFFSET + 3] = static_cast<float>(scene::LightType::SPOT);
+                lightBufferData[offset + UBOForwardLight::LIGHT_SIZE_RANGE_ANGLE_OFFSET + 2] = spotLight->getSpotAngle();
+                lightBufferData[offset + UBOForwardLight::LIGHT_SIZE_RANGE_ANGLE_OFFSET + 3] = (shadowInfo->isEnabled() &&
                                                                                                  spotLight->isShadowEnabled() &&
                                                                                                  shadowInfo->getType() == scene::ShadowType::SHADOW_MAP)
                                                                                                     ? 1.0F
@@ -333,48 +349,53 @@ void RenderAdditiveLightQueue::updateUBOs(const scene::Camera *camera, gfx::Comm
 
                 index = offset + UBOForwardLight::LIGHT_DIR_OFFSET;
                 const auto &direction = spotLight->getDirection();
-                _lightBufferData[index++] = direction.x;
-                _lightBufferData[index++] = direction.y;
-                _lightBufferData[index] = direction.z;
-
-                _lightBufferData[offset + UBOForwardLight::LIGHT_BOUNDING_SIZE_VS_OFFSET + 0] = 0.0F;
-                _lightBufferData[offset + UBOForwardLight::LIGHT_BOUNDING_SIZE_VS_OFFSET + 1] = 0.0F;
-                _lightBufferData[offset + UBOForwardLight::LIGHT_BOUNDING_SIZE_VS_OFFSET + 2] = 0.0F;
-                _lightBufferData[offset + UBOForwardLight::LIGHT_BOUNDING_SIZE_VS_OFFSET + 3] = spotLight->getAngleAttenuationStrength();
+                lightBufferData[index++] = direction.x;
+                lightBufferData[index++] = direction.y;
+                lightBufferData[index] = direction.z;
+
+                lightBufferData[offset + UBOForwardLight::LIGHT_BOUNDING_SIZE_VS_OFFSET + 0] = 0.0F;
+                lightBufferData[offset + UBOForwardLight::LIGHT_BOUNDING_SIZE_VS_OFFSET + 1] = 0.0F;
+                lightBufferData[offset + UBOForwardLight::LIGHT_BOUNDING_SIZE_VS_OFFSET + 2] = 0.0F;
+                lightBufferData[offset + UBOForwardLight::LIGHT_BOUNDING_SIZE_VS_OFFSET + 3] = spotLight->getAngleAttenuationStrength();
             } break;
             case scene::LightType::POINT:
-                _lightBufferData[offset + UBOForwardLight::LIGHT_POS_OFFSET + 3] = static_cast<float>(scene::LightType::POINT);
-                _lightBufferData[offset + UBOForwardLight::LIGHT_SIZE_RANGE_ANGLE_OFFSET + 2] = 0;
-                _lightBufferData[offset + UBOForwardLight::LIGHT_SIZE_RANGE_ANGLE_OFFSET + 3] = 0;
+                lightBufferData[offset + UBOForwardLight::LIGHT_POS_OFFSET + 3] = static_cast<float>(scene::LightType::POINT);
+                lightBufferData[offset + UBOForwardLight::LIGHT_SIZE_RANGE_ANGLE_OFFSET + 2] = 0;
+                lightBufferData[offset + UBOForwardLight::LIGHT_SIZE_RANGE_ANGLE_OFFSET + 3] = 0;
                 break;
             case scene::LightType::RANGED_DIRECTIONAL: {
-                _lightBufferData[offset + UBOForwardLight::LIGHT_POS_OFFSET + 3] = static_cast<float>(scene::LightType::RANGED_DIRECTIONAL);
+                lightBufferData[offset + UBOForwardLight::LIGHT_POS_OFFSET + 3] = static_cast<float>(scene::LightType::RANGED_DIRECTIONAL);
 
                 const auto *rangedDirLight = static_cast<const scene::RangedDirectionalLight *>(light);
                 const Vec3 &right = rangedDirLight->getRight();
-                _lightBufferData[offset + UBOForwardLight::LIGHT_SIZE_RANGE_ANGLE_OFFSET + 0] = right.x;
-                _lightBufferData[offset + UBOForwardLight::LIGHT_SIZE_RANGE_ANGLE_OFFSET + 1] = right.y;
-                _lightBufferData[offset + UBOForwardLight::LIGHT_SIZE_RANGE_ANGLE_OFFSET + 2] = right.z;
-                _lightBufferData[offset + UBOForwardLight::LIGHT_SIZE_RANGE_ANGLE_OFFSET + 3] = 0;
+                lightBufferData[offset + UBOForwardLight::LIGHT_SIZE_RANGE_ANGLE_OFFSET + 0] = right.x;
+                lightBufferData[offset + UBOForwardLight::LIGHT_SIZE_RANGE_ANGLE_OFFSET + 1] = right.y;
+                lightBufferData[offset + UBOForwardLight::LIGHT_SIZE_RANGE_ANGLE_OFFSET + 2] = right.z;
+                lightBufferData[offset + UBOForwardLight::LIGHT_SIZE_RANGE_ANGLE_OFFSET + 3] = 0;
 
                 const auto &direction = rangedDirLight->getDirection();
-                _lightBufferData[offset + UBOForwardLight::LIGHT_DIR_OFFSET + 0] = direction.x;
-                _lightBufferData[offset + UBOForwardLight::LIGHT_DIR_OFFSET + 1] = direction.y;
-                _lightBufferData[offset + UBOForwardLight::LIGHT_DIR_OFFSET + 2] = direction.z;
-                _lightBufferData[offset + UBOForwardLight::LIGHT_DIR_OFFSET + 3] = 0;
+                lightBufferData[offset + UBOForwardLight::LIGHT_DIR_OFFSET + 0] = direction.x;
+                lightBufferData[offset + UBOForwardLight::LIGHT_DIR_OFFSET + 1] = direction.y;
+                lightBufferData[offset + UBOForwardLight::LIGHT_DIR_OFFSET + 2] = direction.z;
+                lightBufferData[offset + UBOForwardLight::LIGHT_DIR_OFFSET + 3] = 0;
 
                 const auto &scale = rangedDirLight->getScale();
-                _lightBufferData[offset + UBOForwardLight::LIGHT_BOUNDING_SIZE_VS_OFFSET + 0] = scale.x * 0.5F;
-                _lightBufferData[offset + UBOForwardLight::LIGHT_BOUNDING_SIZE_VS_OFFSET + 1] = scale.y * 0.5F;
-                _lightBufferData[offset + UBOForwardLight::LIGHT_BOUNDING_SIZE_VS_OFFSET + 2] = scale.z * 0.5F;
-                _lightBufferData[offset + UBOForwardLight::LIGHT_BOUNDING_SIZE_VS_OFFSET + 3] = 0;
+                lightBufferData[offset + UBOForwardLight::LIGHT_BOUNDING_SIZE_VS_OFFSET + 0] = scale.x * 0.5F;
+                lightBufferData[offset + UBOForwardLight::LIGHT_BOUNDING_SIZE_VS_OFFSET + 1] = scale.y * 0.5F;
+                lightBufferData[offset + UBOForwardLight::LIGHT_BOUNDING_SIZE_VS_OFFSET + 2] = scale.z * 0.5F;
+                lightBufferData[offset + UBOForwardLight::LIGHT_BOUNDING_SIZE_VS_OFFSET + 3] = 0;
             } break;
             default:
                 break;
         }
     }
 
-    cmdBuffer->updateBuffer(_lightBuffer, _lightBufferData.data(), static_cast<uint32_t>(_lightBufferData.size() * sizeof(float)));
+    // uploaded before the light passes are recorded, backends without a render thread draw while recording
+    if (allocation.isValid()) {
+        ring->flush(cmdBuffer);
+    } else {
+        cmdBuffer->updateBuffer(_lightBuffer, _lightBufferData.data(), static_cast<uint32_t>(_lightBufferData.size() * sizeof(float)));
+    }
 }
 
 void RenderAdditiveLightQueue::updateLightDescriptorSet(const scene::Camera *camera, gfx::CommandBuffer *cmdBuffer) {
@@ -83,6 +83,9 @@ private:
 
     IntrusivePtr<gfx::Buffer> _lightBuffer;
     IntrusivePtr<gfx::Buffer> _firstLightBufferView;
+    // weak reference, the view bound this frame, of the uniform ring or of _lightBuffer
+    gfx::Buffer *_lightBufferView{nullptr};
+    uint32_t _lightBufferOffset{0};
 
     float _lightMeterScale{10000.0F};
 
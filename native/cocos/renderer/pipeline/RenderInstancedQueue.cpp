@@ -99,5 +99,13 @@ void RenderInstancedQueue::add(InstancedBuffer *instancedBuffer) {
     _queues.emplace(instancedBuffer);
 }
 
+InstancedBufferStats RenderInstancedQueue::getStats() const {
+    InstancedBufferStats stats;
+    for (const auto *instancedBuffer : _queues) {
+        stats += instancedBuffer->getStats();
+    }
+    return stats;
+}
+
 } // namespace pipeline
 } // namespace cc
@@ -42,6 +42,7 @@ class DescriptorSet;
 namespace pipeline {
 
 class InstancedBuffer;
+struct InstancedBufferStats;
 
 class CC_DLL RenderInstancedQueue final : public RefCounted {
 public:
@@ -54,6 +55,8 @@ public:
     void sort();
     void clear();
     bool empty() { return _queues.empty(); }
+    // merge statistics of all instanced buffers added to the queue in this frame
+    InstancedBufferStats getStats() const;
 
 private:
     // `InstancedBuffer *`: weak reference
@@ -26,6 +26,7 @@
 #if CC_USE_GEOMETRY_RENDERER
     #include "GeometryRenderer.h"
 #endif
+#include "ClusterLightCulling.h"
 #include "GlobalDescriptorSetManager.h"
 #include "InstancedBuffer.h"
 #include "PipelineSceneData.h"
@@ -299,6 +300,7 @@ void RenderPipeline::generateConstantMacros() {
         R"(
 #define CC_DEVICE_SUPPORT_FLOAT_TEXTURE %d
 #define CC_ENABLE_CLUSTERED_LIGHT_CULLING %d
+#define CC_CLUSTER_LIGHT_DATA_TEXTURE %d
 #define CC_DEVICE_MAX_VERTEX_UNIFORM_VECTORS %d
 #define CC_DEVICE_MAX_FRAGMENT_UNIFORM_VECTORS %d
 #define CC_DEVICE_CAN_BENEFIT_FROM_INPUT_ATTACHMENT %d
@@ -308,6 +310,7 @@ void RenderPipeline::generateConstantMacros() {
         )",
         hasAnyFlags(_device->getFormatFeatures(gfx::Format::RGBA32F), gfx::FormatFeature::RENDER_TARGET | gfx::FormatFeature::SAMPLED_TEXTURE),
         _clusterEnabled ? 1 : 0,
+        _clusterEnabled && ClusterLightCulling::usesLightDataTexture(_device) ? 1 : 0,
         _device->getCapabilities().maxVertexUniformVectors,
         _device->getCapabilities().maxFragmentUniformVectors,
         _device->hasFeature(gfx::Feature::INPUT_ATTACHMENT_BENEFIT),
@@ -24,10 +24,13 @@
 
 #include "RenderQueue.h"
 
+#include <cstring>
 #include <utility>
 #include "PipelineSceneData.h"
 #include "PipelineStateManager.h"
 #include "RenderPipeline.h"
+#include "base/job-system/JobSystem.h"
+#include "base/std/container/array.h"
 #include "gfx-base/GFXCommandBuffer.h"
 #include "gfx-base/GFXDevice.h"
 #include "gfx-base/GFXShader.h"
@@ -38,6 +41,27 @@
 namespace cc {
 namespace pipeline {
 
+namespace {
+// shorter queues are sorted by the comparator, the radix passes don't pay off
+constexpr size_t KEY_SORT_MIN_SIZE{128};
+// total entries of all queues before sortQueues uses the job workers
+constexpr size_t PARALLEL_SORT_MIN_SIZE{4096};
+
+// 4 bytes of shader id followed by 8 bytes of key, from the least significant
+constexpr uint32_t RADIX_PASS_COUNT{12};
+
+// maps the float order onto the unsigned integer order
+inline uint32_t depthToSortableBits(float depth) {
+    uint32_t bits{0};
+    memcpy(&bits, &depth, sizeof(bits));
+    return (bits & 0x80000000U) ? ~bits : (bits | 0x80000000U);
+}
+
+inline uint32_t radixDigit(uint64_t key, uint32_t shaderID, uint32_t pass) {
+    return pass < 4 ? (shaderID >> (pass * 8)) & 0xFFU : static_cast<uint32_t>(key >> ((pass - 4) * 8)) & 0xFFU;
+}
+} // namespace
+
 RenderQueue::RenderQueue(RenderPipeline *pipeline, RenderQueueCreateInfo desc, bool useOcclusionQuery)
 : _pipeline(pipeline), _passDesc(std::move(desc)), _useOcclusionQuery(useOcclusionQuery) {
 }
@@ -67,6 +91,12 @@ bool RenderQueue::insertRenderPass(const RenderObject &renderObj, uint32_t subMo
 }
 
 void RenderQueue::sort() {
+    if (!_passDesc.sortByKey || _queue.size() < KEY_SORT_MIN_SIZE || !sortByKey()) {
+        sortByFunc();
+    }
+}
+
+void RenderQueue::sortByFunc() {
 #if CC_PLATFORM != CC_PLATFORM_LINUX && CC_PLATFORM != CC_PLATFORM_QNX
     std::sort(_queue.begin(), _queue.end(), _passDesc.sortFunc);
 #else
@@ -77,6 +107,85 @@ void RenderQueue::sort() {
 #endif
 }
 
+// LSD radix sort of (key, shaderID) pairs, stable passes give the order of opaqueCompareFn / transparentCompareFn:
+// FRONT_TO_BACK key: hash(24) | depth(32)
+// BACK_TO_FRONT key: priority(8) | hash(24) | ~depth(32)
+// shaderID is the last tie breaker, so it is sorted first. Depths within the epsilon of math::isNotEqualF are
+// ordered by value instead of by shaderID. Returns false if priority or hash do not fit into the key.
+bool RenderQueue::sortByKey() {
+    const auto count = static_cast<uint32_t>(_queue.size());
+    const bool backToFront = _passDesc.sortMode == RenderQueueSortMode::BACK_TO_FRONT;
+
+    _sortEntries.resize(count);
+    _sortScratch.resize(count);
+    ccstd::array<ccstd::array<uint32_t, 256>, RADIX_PASS_COUNT> histograms{};
+    for (uint32_t i = 0; i < count; ++i) {
+        const auto &renderPass = _queue[i];
+        if (renderPass.hash > 0xFFFFFFU || (backToFront && renderPass.priority > 0xFFU)) {
+            return false;
+        }
+        const uint32_t depthBits = depthToSortableBits(renderPass.depth);
+        uint64_t key = static_cast<uint64_t>(renderPass.hash) << 32;
+        if (backToFront) {
+            key |= static_cast<uint64_t>(renderPass.priority) << 56 | static_cast<uint64_t>(~depthBits);
+        } else {
+            key |= depthBits;
+        }
+        _sortEntries[i] = {key, renderPass.shaderID, i};
+        for (uint32_t pass = 0; pass < RADIX_PASS_COUNT; ++pass) {
+            ++histograms[pass][radixDigit(key, renderPass.shaderID, pass)];
+        }
+    }
+
+    auto *src = _sortEntries.data();
+    auto *dst = _sortScratch.data();
+    for (uint32_t pass = 0; pass < RADIX_PASS_COUNT; ++pass) {
+        auto &histogram = histograms[pass];
+        // all entries share this digit, the pass would not change the order
+        if (histogram[radixDigit(src[0].key, src[0].shaderID, pass)] == count) {
+            continue;
+        }
+        uint32_t offset = 0;
+        for (auto &bucket : histogram) {
+            const auto bucketSize = bucket;
+            bucket = offset;
+            offset += bucketSize;
+        }
+        for (uint32_t i = 0; i < count; ++i) {
+            const auto &entry = src[i];
+            dst[histogram[radixDigit(entry.key, entry.shaderID, pass)]++] = entry;
+        }
+        std::swap(src, dst);
+    }
+
+    _sortedQueue.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        _sortedQueue[i] = _queue[src[i].index];
+    }
+    _queue.swap(_sortedQueue);
+    return true;
+}
+
+void RenderQueue::sortQueues(const ccstd::vector<RenderQueue *> &queues) {
+    size_t totalSize = 0;
+    for (const auto *queue : queues) {
+        totalSize += queue->_queue.size();
+    }
+
+    if (queues.size() > 1 && totalSize >= PARALLEL_SORT_MIN_SIZE && JobSystem::getInstance()->threadCount() > 1) {
+        JobGraph g(JobSystem::getInstance());
+        g.createForEachIndexJob(0U, static_cast<uint32_t>(queues.size()), 1U, [&queues](uint32_t i) {
+            queues[i]->sort();
+        });
+        g.run();
+        g.waitForAll();
+    } else {
+        for (auto *queue : queues) {
+            queue->sort();
+        }
+    }
+}
+
 void RenderQueue::recordCommandBuffer(gfx::Device * /*device*/, scene::Camera *camera, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuff, uint32_t subpassIndex) {
     PipelineSceneData *const sceneData = _pipeline->getPipelineSceneData();
     bool enableOcclusionQuery = _pipeline->isOcclusionQueryEnabled() && _useOcclusionQuery;
@@ -40,14 +40,32 @@ public:
 
     void clear();
     bool insertRenderPass(const RenderObject &renderObj, uint32_t subModelIdx, uint32_t passIdx);
+    // inserts a render pass built by the caller, it is not filtered by the queue description
+    void insertRenderPass(const RenderPass &renderPass) { _queue.emplace_back(renderPass); }
     void recordCommandBuffer(gfx::Device *device, scene::Camera *camera, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuff, uint32_t subpassIndex = 0);
     void sort();
     bool empty() { return _queue.empty(); }
+    inline const RenderPassList &getRenderPasses() const { return _queue; }
+
+    // sorts the queues on job workers when there is enough work
+    static void sortQueues(const ccstd::vector<RenderQueue *> &queues);
 
 private:
+    struct SortEntry {
+        uint64_t key{0};
+        uint32_t shaderID{0};
+        uint32_t index{0};
+    };
+
+    void sortByFunc();
+    bool sortByKey();
+
     // weak reference
     RenderPipeline *_pipeline{nullptr};
     RenderPassList _queue;
+    RenderPassList _sortedQueue;
+    ccstd::vector<SortEntry> _sortEntries;
+    ccstd::vector<SortEntry> _sortScratch;
     RenderQueueCreateInfo _passDesc;
     bool _useOcclusionQuery{false};
 };
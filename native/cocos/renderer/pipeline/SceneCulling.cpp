@@ -134,6 +134,15 @@ void shadowCulling(const RenderPipeline *pipeline, const scene::Camera *camera,
 
     if (csmLayers->getLayerObjects().empty()) return;
 
+    // Static casters of a cached cascade are only culled again when the cache is invalidated,
+    // and they are never removed as duplicates so that every cached cascade sees the same static casters.
+    const bool isStaticCacheEnabled = mainLight->isCSMStaticCacheEnabled();
+    const bool isStaticCachedLayer = layer->isStaticCacheEnabled();
+    const bool isStaticCullingNeeded = isStaticCachedLayer && !layer->isStaticCacheValid(csmLayers->getStaticCasterVersion());
+    if (isStaticCullingNeeded) {
+        layer->clearStaticShadowObjects();
+    }
+
     for (auto it = csmLayers->getLayerObjects().begin(); it != csmLayers->getLayerObjects().end();) {
         const auto *model = it->model;
         if (!model || !model->isEnabled() || !model->getNode()) {
@@ -150,15 +159,25 @@ void shadowCulling(const RenderPipeline *pipeline, const scene::Camera *camera,
             continue;
         }
 
+        const bool isStaticCaster = isStaticCacheEnabled && node->isStatic();
+        if (isStaticCaster && isStaticCachedLayer && !isStaticCullingNeeded) {
+            ++it;
+            continue;
+        }
+
         // frustum culling
         const bool accurate = model->getWorldBounds()->aabbFrustum(layer->getValidFrustum());
         if (!accurate) {
             ++it;
             continue;
         }
-        layer->addShadowObject(genRenderObject(model, camera));
+        if (isStaticCaster && isStaticCachedLayer) {
+            layer->addStaticShadowObject(genRenderObject(model, camera));
+        } else {
+            layer->addShadowObject(genRenderObject(model, camera));
+        }
         if (layer->getLevel() < static_cast<uint32_t>(mainLight->getCSMLevel())) {
-            if (mainLight->getCSMOptimizationMode() == scene::CSMOptimizationMode::REMOVE_DUPLICATES &&
+            if (mainLight->getCSMOptimizationMode() == scene::CSMOptimizationMode::REMOVE_DUPLICATES && !isStaticCaster &&
                 aabbFrustumCompletelyInside(*model->getWorldBounds(), layer->getValidFrustum())) {
                 it = csmLayers->getLayerObjects().erase(it);
             } else {
@@ -168,6 +187,10 @@ void shadowCulling(const RenderPipeline *pipeline, const scene::Camera *camera,
             ++it;
         }
     }
+
+    if (isStaticCullingNeeded) {
+        layer->setStaticCasterVersion(csmLayers->getStaticCasterVersion());
+    }
 }
 
 void sceneCulling(const RenderPipeline *pipeline, scene::Camera *camera) {
@@ -190,6 +213,21 @@ void sceneCulling(const RenderPipeline *pipeline, scene::Camera *camera) {
     csmLayers->clearCastShadowObjects();
     csmLayers->clearLayerObjects();
 
+    // the static casters feed the cached cascades, any change of the set or of a static transform invalidates them
+    const bool isStaticCacheEnabled = mainLight && mainLight->isCSMStaticCacheEnabled();
+    ccstd::hash_t staticCasterHash = camera->getVisibility();
+    bool isStaticCasterChanged = false;
+    const auto addShadowCaster = [&](const scene::Model *model) {
+        csmLayers->addCastShadowObject(genRenderObject(model, camera));
+        csmLayers->addLayerObject(genRenderObject(model, camera));
+
+        const auto *node = model->getNode();
+        if (isStaticCacheEnabled && node && node->isStatic()) {
+            ccstd::hash_combine(staticCasterHash, model);
+            isStaticCasterChanged = isStaticCasterChanged || node->getChangedFlags() != 0;
+        }
+    };
+
     auto clearFlagValue = static_cast<uint32_t>(camera->getClearFlag());
     if (clearFlagValue & skyboxFlag) {
         if (skyBox != nullptr && skyBox->isEnabled() && skyBox->getModel()) {
@@ -209,8 +247,7 @@ void sceneCulling(const RenderPipeline *pipeline, scene::Camera *camera) {
                 }
 
                 if (model->isCastShadow()) {
-                    csmLayers->addCastShadowObject(genRenderObject(model, camera));
-                    csmLayers->addLayerObject(genRenderObject(model, camera));
+                    addShadowCaster(model);
                 }
 
                 const auto visibility = camera->getVisibility();
@@ -231,9 +268,6 @@ void sceneCulling(const RenderPipeline *pipeline, scene::Camera *camera) {
         models.reserve(scene->getModels().size() / 4);
         octree->queryVisibility(camera, camera->getFrustum(), false, models);
         for (const auto &model : models) {
-            if (scene->isCulledByLod(camera, model)) {
-                continue;
-            }
             sceneData->addRenderObject(genRenderObject(model, camera));
         }
     } else {
@@ -248,8 +282,7 @@ void sceneCulling(const RenderPipeline *pipeline, scene::Camera *camera) {
 
                 // cast shadow render Object
                 if (model->isCastShadow()) {
-                    csmLayers->addCastShadowObject(genRenderObject(model, camera));
-                    csmLayers->addLayerObject(genRenderObject(model, camera));
+                    addShadowCaster(model);
                 }
 
                 if ((model->getNode() && ((visibility & node->getLayer()) == node->getLayer())) ||
@@ -269,6 +302,10 @@ void sceneCulling(const RenderPipeline *pipeline, scene::Camera *camera) {
         }
     }
 
+    if (isStaticCacheEnabled) {
+        csmLayers->updateStaticCasters(staticCasterHash, isStaticCasterChanged);
+    }
+
     csmLayers = nullptr;
 }
 
@@ -105,6 +105,16 @@ void ShadowMapBatchedQueue::gatherLightPasses(const scene::Camera *camera, const
     }
 }
 
+void ShadowMapBatchedQueue::gatherShadowObjects(const RenderObjectList &shadowObjects, gfx::CommandBuffer *cmdBuffer) {
+    clear();
+
+    for (const auto &ro : shadowObjects) {
+        add(ro.model);
+    }
+
+    _instancedQueue->uploadBuffers(cmdBuffer);
+}
+
 void ShadowMapBatchedQueue::clear() {
     _subModels.clear();
     _shaders.clear();
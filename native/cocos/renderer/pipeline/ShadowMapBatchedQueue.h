@@ -46,6 +46,7 @@ public:
 
     void clear();
     void gatherLightPasses(const scene::Camera *, const scene::Light *, gfx::CommandBuffer *, uint32_t level = 0);
+    void gatherShadowObjects(const RenderObjectList &, gfx::CommandBuffer *);
     void add(const scene::Model *);
     void recordCommandBuffer(gfx::Device *, gfx::RenderPass *, gfx::CommandBuffer *) const;
 
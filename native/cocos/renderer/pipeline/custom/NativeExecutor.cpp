@@ -27,11 +27,14 @@
 #include "FGDispatcherGraphs.h"
 #include "LayoutGraphGraphs.h"
 #include "NativeBuiltinUtils.h"
+#include "NativeExecutorDetail.h"
 #include "NativeExecutorRenderGraph.h"
 #include "NativePipelineTypes.h"
 #include "PrivateTypes.h"
 #include "RenderGraphGraphs.h"
 #include "RenderGraphTypes.h"
+#include "cocos/base/job-system/JobSystem.h"
+#include "cocos/core/Root.h"
 #include "cocos/renderer/gfx-base/GFXDef-common.h"
 #include "cocos/renderer/gfx-base/GFXDevice.h"
 #include "cocos/renderer/pipeline/Define.h"
@@ -45,6 +48,7 @@
 #include "details/GraphView.h"
 #include "details/GslUtils.h"
 #include "details/Range.h"
+#include "profiler/Profiler.h"
 
 #if CC_USE_GEOMETRY_RENDERER
     #include "cocos/renderer/pipeline/GeometryRenderer.h"
@@ -319,6 +323,9 @@ void submitProfilerCommands(
     cmdBuff->draw(ia);
 }
 
+constexpr SceneFlags MAIN_THREAD_SCENE_FLAGS =
+    SceneFlags::UI | SceneFlags::GEOMETRY | SceneFlags::REFLECTION_PROBE;
+
 struct RenderGraphVisitor : boost::dfs_visitor<> {
     void submitBarriers(const std::vector<Barrier>& barriers) const {
         auto& resg = ctx.resourceGraph;
@@ -377,37 +384,46 @@ struct RenderGraphVisitor : boost::dfs_visitor<> {
         }
     }
     void tryBindPassDescriptorSet(RenderGraph::vertex_descriptor passOrSubpassID) const {
+        tryBindPassDescriptorSet(passOrSubpassID, ctx.cmdBuff);
+    }
+    void tryBindPassDescriptorSet(RenderGraph::vertex_descriptor passOrSubpassID, gfx::CommandBuffer* cmdBuff) const {
         auto iter = ctx.renderGraphDescriptorSet.find(passOrSubpassID);
         if (iter != ctx.renderGraphDescriptorSet.end()) {
             CC_ENSURES(get<0>(iter->second));
-            ctx.cmdBuff->bindDescriptorSet(
+            cmdBuff->bindDescriptorSet(
                 static_cast<uint32_t>(pipeline::SetIndex::GLOBAL),
                 get<0>(iter->second));
         }
     }
     void tryBindQueueDescriptorSets(RenderGraph::vertex_descriptor queueID) const {
+        tryBindQueueDescriptorSets(queueID, ctx.cmdBuff);
+    }
+    void tryBindQueueDescriptorSets(RenderGraph::vertex_descriptor queueID, gfx::CommandBuffer* cmdBuff) const {
         auto iter = ctx.renderGraphDescriptorSet.find(queueID);
         if (iter != ctx.renderGraphDescriptorSet.end()) {
             const auto& [passSet, queueSet] = iter->second;
             CC_EXPECTS(passSet || queueSet);
             if (passSet) {
-                ctx.cmdBuff->bindDescriptorSet(
+                cmdBuff->bindDescriptorSet(
                     static_cast<uint32_t>(pipeline::SetIndex::GLOBAL),
                     passSet);
             }
             if (queueSet) {
                 static_assert(static_cast<uint32_t>(pipeline::SetIndex::COUNT) == 3);
-                ctx.cmdBuff->bindDescriptorSet(
+                cmdBuff->bindDescriptorSet(
                     static_cast<uint32_t>(pipeline::SetIndex::COUNT),
                     queueSet);
             }
         }
     }
     void tryBindLeafOverwritePerPassDescriptorSet(RenderGraph::vertex_descriptor leafID) const {
+        tryBindLeafOverwritePerPassDescriptorSet(leafID, ctx.cmdBuff);
+    }
+    void tryBindLeafOverwritePerPassDescriptorSet(RenderGraph::vertex_descriptor leafID, gfx::CommandBuffer* cmdBuff) const {
         auto iter = ctx.renderGraphDescriptorSet.find(leafID);
         if (iter != ctx.renderGraphDescriptorSet.end()) {
             CC_ENSURES(get<0>(iter->second));
-            ctx.cmdBuff->bindDescriptorSet(
+            cmdBuff->bindDescriptorSet(
                 static_cast<uint32_t>(pipeline::SetIndex::GLOBAL),
                 get<0>(iter->second));
         }
@@ -421,6 +437,187 @@ struct RenderGraphVisitor : boost::dfs_visitor<> {
                 iter->second);
         }
     }
+    static uint32_t getNumDraws(const NativeRenderQueue& queue, QueueSection section) {
+        switch (section) {
+            case QueueSection::OPAQUE_DRAWS:
+                return static_cast<uint32_t>(queue.opaqueQueue.instances.size());
+            case QueueSection::OPAQUE_INSTANCING:
+                return render::getNumDraws(queue.opaqueInstancingQueue);
+            case QueueSection::BLEND_DRAWS:
+                return static_cast<uint32_t>(queue.transparentQueue.instances.size());
+            case QueueSection::BLEND_INSTANCING:
+            default:
+                return render::getNumDraws(queue.transparentInstancingQueue);
+        }
+    }
+    bool canRecordInParallel(const RasterPass& pass) const {
+        const auto& recorder = getParallelCommandRecorder();
+        if (!recorder.enabled || pass.showStatistics || !pass.subpassGraph.subpasses.empty()) {
+            return false;
+        }
+        // Metal parallel encoders are created by the primary render pass,
+        // which must be replayed before the secondary command buffers.
+        if (!ctx.device->isMultithreadedCommandRecording() ||
+            ctx.device->getGfxAPI() == gfx::API::METAL) {
+            return false;
+        }
+        return JobSystem::getInstance() && JobSystem::getInstance()->threadCount() > 1;
+    }
+    // Split the scene queues of a raster pass into ranges of draws, and group
+    // the ranges into tasks of similar size, keeping the graph order.
+    // Returns false if the pass should be recorded inline.
+    bool buildRecordTasks(
+        const RasterPass& pass, RenderGraph::vertex_descriptor passID,
+        gfx::RenderPass* renderPass,
+        ccstd::pmr::vector<RecordRange>& ranges,
+        ccstd::pmr::vector<RecordTask>& tasks) const {
+        if (!canRecordInParallel(pass)) {
+            return false;
+        }
+        const auto& g = ctx.g;
+        const auto& sceneCulling = ctx.context.sceneCulling;
+
+        // collect sections, only scene queues can be recorded by workers
+        ccstd::pmr::vector<RecordRange> sections(ctx.scratch);
+        uint32_t numDraws = 0;
+        for (const auto e0 : makeRange(children(passID, g))) {
+            const auto queueID = target(e0, g);
+            if (!ctx.validPasses[queueID]) {
+                continue;
+            }
+            if (!holds<QueueTag>(queueID, g) || !get(RenderGraph::DataTag{}, g, queueID).custom.empty()) {
+                return false;
+            }
+            for (const auto e1 : makeRange(children(queueID, g))) {
+                const auto sceneID = target(e1, g);
+                if (!ctx.validPasses[sceneID]) {
+                    continue;
+                }
+                if (!holds<SceneTag>(sceneID, g) || !get(RenderGraph::DataTag{}, g, sceneID).custom.empty()) {
+                    return false;
+                }
+                const auto& sceneData = get(SceneTag{}, sceneID, g);
+                if (any(sceneData.flags & MAIN_THREAD_SCENE_FLAGS)) {
+                    return false;
+                }
+                const auto& queueDesc = sceneCulling.renderQueueQueryIndex.at(sceneID);
+                const auto& queue = sceneCulling.renderQueues[queueDesc.renderQueueTarget.value];
+                const bool bOpaque = any(sceneData.flags & (SceneFlags::OPAQUE | SceneFlags::MASK));
+                const bool bBlend = any(sceneData.flags & SceneFlags::BLEND);
+                for (const auto section : {
+                         QueueSection::OPAQUE_DRAWS,
+                         QueueSection::OPAQUE_INSTANCING,
+                         QueueSection::BLEND_DRAWS,
+                         QueueSection::BLEND_INSTANCING,
+                     }) {
+                    const bool bEnabled =
+                        section == QueueSection::OPAQUE_DRAWS || section == QueueSection::OPAQUE_INSTANCING
+                            ? bOpaque
+                            : bBlend;
+                    const auto count = bEnabled ? getNumDraws(queue, section) : 0;
+                    if (count) {
+                        sections.emplace_back(RecordRange{sceneID, &queue, section, 0, count});
+                        numDraws += count;
+                    }
+                }
+            }
+        }
+
+        const auto minDraws = getParallelCommandRecorder().minDrawsPerCommandBuffer;
+        if (numDraws < 2 * minDraws) {
+            return false;
+        }
+
+        // PipelineStateManager is not thread safe, create all pipeline states beforehand
+        for (const auto& section : sections) {
+            const auto& queue = *section.queue;
+            switch (section.section) {
+                case QueueSection::OPAQUE_DRAWS:
+                    preparePipelineStates(queue.opaqueQueue, renderPass, 0);
+                    break;
+                case QueueSection::OPAQUE_INSTANCING:
+                    preparePipelineStates(queue.opaqueInstancingQueue, renderPass, 0);
+                    break;
+                case QueueSection::BLEND_DRAWS:
+                    preparePipelineStates(queue.transparentQueue, renderPass, 0);
+                    break;
+                case QueueSection::BLEND_INSTANCING:
+                default:
+                    preparePipelineStates(queue.transparentInstancingQueue, renderPass, 0);
+                    break;
+            }
+        }
+
+        const auto numWorkers = static_cast<uint32_t>(JobSystem::getInstance()->threadCount());
+        return splitRecordTasks(sections, numDraws, minDraws, numWorkers, ranges, tasks);
+    }
+    void recordRange(
+        const RecordRange& range, gfx::RenderPass* renderPass,
+        gfx::CommandBuffer* cmdBuff) const {
+        const auto& queue = *range.queue;
+        switch (range.section) {
+            case QueueSection::OPAQUE_DRAWS:
+                recordCommandBuffer(
+                    queue.opaqueQueue, renderPass, 0, cmdBuff, queue.lightByteOffset, range.first, range.count);
+                break;
+            case QueueSection::OPAQUE_INSTANCING:
+                queue.opaqueInstancingQueue.recordCommandBuffer(
+                    renderPass, 0, cmdBuff, queue.lightByteOffset);
+                break;
+            case QueueSection::BLEND_DRAWS:
+                recordCommandBuffer(
+                    queue.transparentQueue, renderPass, 0, cmdBuff, queue.lightByteOffset, range.first, range.count);
+                break;
+            case QueueSection::BLEND_INSTANCING:
+            default:
+                queue.transparentInstancingQueue.recordCommandBuffer(
+                    renderPass, 0, cmdBuff, queue.lightByteOffset);
+                break;
+        }
+    }
+    // Called from job workers, only reads the render graph and the scene queues.
+    void recordTask(
+        const RecordTask& task, const ccstd::pmr::vector<RecordRange>& ranges,
+        RenderGraph::vertex_descriptor passID,
+        gfx::RenderPass* renderPass, gfx::Framebuffer* framebuffer,
+        const gfx::Viewport& passViewport, const gfx::Rect& scissor) const {
+        auto* cmdBuff = task.cmdBuff;
+        cmdBuff->begin(renderPass, 0, framebuffer);
+        // secondary command buffers do not inherit dynamic states
+        cmdBuff->setScissor(scissor);
+        auto lastSceneID = RenderGraph::null_vertex();
+        for (uint32_t i = task.rangeBegin; i != task.rangeEnd; ++i) {
+            const auto& range = ranges[i];
+            if (range.sceneID != lastSceneID) {
+                lastSceneID = range.sceneID;
+                const auto queueID = parent(range.sceneID, ctx.g);
+                const auto& queueData = get(QueueTag{}, queueID, ctx.g);
+                const bool bQueueViewport = queueData.viewport.width != 0 && queueData.viewport.height != 0;
+                cmdBuff->setViewport(bQueueViewport ? queueData.viewport : passViewport);
+                tryBindPassDescriptorSet(passID, cmdBuff);
+                tryBindQueueDescriptorSets(queueID, cmdBuff);
+                if (get(SceneTag{}, range.sceneID, ctx.g).camera) {
+                    tryBindLeafOverwritePerPassDescriptorSet(range.sceneID, cmdBuff);
+                }
+            }
+            recordRange(range, renderPass, cmdBuff);
+        }
+        cmdBuff->end();
+    }
+    void recordTasks(
+        const ccstd::pmr::vector<RecordTask>& tasks,
+        const ccstd::pmr::vector<RecordRange>& ranges,
+        RenderGraph::vertex_descriptor passID,
+        gfx::RenderPass* renderPass, gfx::Framebuffer* framebuffer,
+        const gfx::Viewport& passViewport, const gfx::Rect& scissor) const {
+        CC_EXPECTS(tasks.size() > 1);
+        JobGraph g(JobSystem::getInstance());
+        g.createForEachIndexJob(0U, static_cast<uint32_t>(tasks.size()), 1U, [&](uint32_t taskID) {
+            recordTask(tasks[taskID], ranges, passID, renderPass, framebuffer, passViewport, scissor);
+        });
+        g.run();
+        g.waitForAll();
+    }
     void begin(const RasterPass& pass, RenderGraph::vertex_descriptor vertID) const {
         const auto& renderData = get(RenderGraph::DataTag{}, ctx.g, vertID);
         if (!renderData.custom.empty()) {
@@ -446,18 +643,47 @@ struct RenderGraphVisitor : boost::dfs_visitor<> {
         scissor.width = std::min(scissor.width, pass.width - scissor.x);
         scissor.height = std::min(scissor.height, pass.height - scissor.y);
 
+        ctx.passBeginTime = std::chrono::steady_clock::now();
+        getParallelCommandRecorder().passStatistics.emplace_back(PassRecordStatistics{vertID});
+
         // render pass
         {
             ctx.currentInFlightPassID = vertID;
             auto& res = fetchOrCreateFramebuffer(ctx, pass, ctx.scratch);
             const auto& data = res;
             auto* cmdBuff = ctx.cmdBuff;
+
+            // large passes are recorded into secondary command buffers by job workers
+            ccstd::pmr::vector<RecordRange> ranges(ctx.scratch);
+            ccstd::pmr::vector<RecordTask> tasks(ctx.scratch);
+            ccstd::pmr::vector<gfx::CommandBuffer*> secondaryCBs(ctx.scratch);
+            if (buildRecordTasks(pass, vertID, data.renderPass.get(), ranges, tasks)) {
+                secondaryCBs.reserve(tasks.size());
+                for (auto& task : tasks) {
+                    task.cmdBuff = getParallelCommandRecorder().allocateCommandBuffer(ctx.device);
+                    secondaryCBs.emplace_back(task.cmdBuff);
+                }
+            }
+            const auto numSecondaryCBs = static_cast<uint32_t>(secondaryCBs.size());
+
             cmdBuff->beginRenderPass(
                 data.renderPass.get(),
                 data.framebuffer.get(),
                 scissor, data.clearColors.data(),
-                data.clearDepth, data.clearStencil);
+                data.clearDepth, data.clearStencil,
+                secondaryCBs.data(), numSecondaryCBs);
             ctx.currentPass = data.renderPass.get();
+
+            if (numSecondaryCBs) {
+                recordTasks(
+                    tasks, ranges, vertID,
+                    data.renderPass.get(), data.framebuffer.get(), vp, scissor);
+                cmdBuff->execute(secondaryCBs.data(), numSecondaryCBs);
+                getParallelCommandRecorder().passStatistics.back().numCommandBuffers = numSecondaryCBs;
+                ctx.parallelPassID = vertID;
+                ctx.viewportStack.emplace_back(vp);
+                return;
+            }
         }
 
         // Set viewport
@@ -838,8 +1064,15 @@ struct RenderGraphVisitor : boost::dfs_visitor<> {
         }
         ctx.cmdBuff->endRenderPass();
         ctx.currentPass = nullptr;
+        ctx.parallelPassID = RenderGraph::null_vertex();
         ctx.viewportStack.pop_back();
         CC_ENSURES(ctx.viewportStack.empty());
+
+        auto& stats = getParallelCommandRecorder().passStatistics.back();
+        CC_EXPECTS(stats.passID == vertID);
+        stats.recordTime = std::chrono::duration<float, std::milli>(
+                               std::chrono::steady_clock::now() - ctx.passBeginTime)
+                               .count();
     }
     void end(const RasterSubpass& subpass, RenderGraph::vertex_descriptor vertID) const { // NOLINT(readability-convert-member-functions-to-static)
         const auto& renderData = get(RenderGraph::DataTag{}, ctx.g, vertID);
@@ -1041,6 +1274,9 @@ struct RenderGraphVisitor : boost::dfs_visitor<> {
         RenderGraph::vertex_descriptor vertID,
         const boost::filtered_graph<AddressableView<RenderGraph>, boost::keep_all, RenderGraphFilter>& gv) const {
         std::ignore = gv;
+        if (ctx.parallelPassID != RenderGraph::null_vertex()) {
+            return; // already recorded in secondary command buffers
+        }
 
         visitObject(
             vertID, ctx.g,
@@ -1099,6 +1335,9 @@ struct RenderGraphVisitor : boost::dfs_visitor<> {
         RenderGraph::vertex_descriptor vertID,
         const boost::filtered_graph<AddressableView<RenderGraph>, boost::keep_all, RenderGraphFilter>& gv) const {
         std::ignore = gv;
+        if (ctx.parallelPassID != RenderGraph::null_vertex() && ctx.parallelPassID != vertID) {
+            return; // already recorded in secondary command buffers
+        }
         visitObject(
             vertID, ctx.g,
             [&](const RasterPass& pass) {
@@ -1175,6 +1414,7 @@ struct RenderGraphContextCleaner {
         context.clearPreviousResources(prevFenceValue);
         context.renderSceneResources.clear();
         context.sceneCulling.clear();
+        getParallelCommandRecorder().clear();
     }
     RenderGraphContextCleaner(const RenderGraphContextCleaner&) = delete;
     RenderGraphContextCleaner& operator=(const RenderGraphContextCleaner&) = delete;
@@ -1184,8 +1424,11 @@ struct RenderGraphContextCleaner {
 };
 
 struct CommandSubmitter {
-    CommandSubmitter(gfx::Device* deviceIn, const std::vector<gfx::CommandBuffer*>& cmdBuffersIn)
-    : device(deviceIn), cmdBuffers(cmdBuffersIn) {
+    CommandSubmitter(
+        gfx::Device* deviceIn,
+        const std::vector<gfx::CommandBuffer*>& cmdBuffersIn,
+        const ccstd::vector<gfx::CommandBuffer*>& secondaryCmdBuffersIn)
+    : device(deviceIn), cmdBuffers(cmdBuffersIn), secondaryCmdBuffers(secondaryCmdBuffersIn) {
         CC_EXPECTS(cmdBuffers.size() == 1);
         primaryCommandBuffer = cmdBuffers.at(0);
         primaryCommandBuffer->begin();
@@ -1194,11 +1437,22 @@ struct CommandSubmitter {
     CommandSubmitter& operator=(const CommandSubmitter&) = delete;
     ~CommandSubmitter() noexcept {
         primaryCommandBuffer->end();
+        // uniforms suballocated from the ring and not yet uploaded by their consumers
+        if (auto* ring = Root::getInstance()->getUniformRingBuffer()) {
+            ring->flush();
+        }
+        // secondary command buffers must be flushed before the primary one executes them
+        if (!secondaryCmdBuffers.empty()) {
+            device->flushCommands(
+                secondaryCmdBuffers.data(),
+                static_cast<uint32_t>(secondaryCmdBuffers.size()));
+        }
         device->flushCommands(cmdBuffers);
         device->getQueue()->submit(cmdBuffers);
     }
     gfx::Device* device = nullptr;
     const std::vector<gfx::CommandBuffer*>& cmdBuffers;
+    const ccstd::vector<gfx::CommandBuffer*>& secondaryCmdBuffers;
     gfx::CommandBuffer* primaryCommandBuffer = nullptr;
 };
 
@@ -1250,6 +1504,201 @@ void collectStatistics(const NativePipeline& ppl, PipelineStatistics& stats) {
     }
 }
 
+void hashComputeViews(
+    ccstd::hash_t& seed,
+    const PmrTransparentMap<ccstd::pmr::string, ccstd::pmr::vector<ComputeView>>& computeViews) {
+    for (const auto& [name, views] : computeViews) {
+        ccstd::hash_combine(seed, name);
+        ccstd::hash_range(seed, views.begin(), views.end());
+    }
+}
+
+void hashRasterViews(
+    ccstd::hash_t& seed,
+    const PmrTransparentMap<ccstd::pmr::string, RasterView>& rasterViews) {
+    for (const auto& [name, view] : rasterViews) {
+        ccstd::hash_combine(seed, name);
+        ccstd::hash_combine(seed, view);
+    }
+}
+
+template <class Pair>
+void hashTransferPair(ccstd::hash_t& seed, const Pair& pair) {
+    ccstd::hash_combine(seed, pair.target);
+    ccstd::hash_combine(seed, pair.mipLevels);
+    ccstd::hash_combine(seed, pair.numSlices);
+    ccstd::hash_combine(seed, pair.targetMostDetailedMip);
+    ccstd::hash_combine(seed, pair.targetFirstSlice);
+    ccstd::hash_combine(seed, pair.targetPlaneSlice);
+}
+
+// Everything FrameGraphDispatcher::run() reads: the pass hierarchy, the resources
+// accessed by each pass, and the descriptors and current states of the resources.
+// Per-frame data (queues, scenes, uniforms) does not change the compiled result.
+ccstd::hash_t hashRenderGraph(
+    const RenderGraph& rg, const ResourceGraph& resg, const LayoutGraphData& lg) {
+    ccstd::hash_t seed = 0;
+    ccstd::hash_combine(seed, &rg);
+    ccstd::hash_combine(seed, &lg);
+    ccstd::hash_combine(seed, num_vertices(rg));
+    for (const auto vertID : makeRange(vertices(rg))) {
+        ccstd::hash_combine(seed, rg._vertices[vertID].handle.index());
+        ccstd::hash_combine(seed, get(RenderGraph::NameTag{}, rg, vertID));
+        ccstd::hash_combine(seed, get(RenderGraph::LayoutTag{}, rg, vertID));
+        for (const auto& e : rg.objects[vertID].parents) {
+            ccstd::hash_combine(seed, e.target);
+        }
+        for (const auto& e : rg._vertices[vertID].outEdges) {
+            ccstd::hash_combine(seed, e.target);
+        }
+        visitObject(
+            vertID, rg,
+            [&](const RasterPass& pass) {
+                ccstd::hash_combine(seed, pass);
+            },
+            [&](const RasterSubpass& subpass) {
+                hashRasterViews(seed, subpass.rasterViews);
+                hashComputeViews(seed, subpass.computeViews);
+                ccstd::hash_range(seed, subpass.resolvePairs.begin(), subpass.resolvePairs.end());
+                ccstd::hash_combine(seed, subpass.subpassID);
+                ccstd::hash_combine(seed, subpass.count);
+                ccstd::hash_combine(seed, subpass.quality);
+            },
+            [&](const ComputeSubpass& subpass) {
+                hashRasterViews(seed, subpass.rasterViews);
+                hashComputeViews(seed, subpass.computeViews);
+                ccstd::hash_combine(seed, subpass.subpassID);
+            },
+            [&](const ComputePass& pass) {
+                hashComputeViews(seed, pass.computeViews);
+                for (const auto& [name, stages] : pass.textures) {
+                    ccstd::hash_combine(seed, name);
+                    ccstd::hash_combine(seed, stages);
+                }
+            },
+            [&](const ResolvePass& pass) {
+                ccstd::hash_range(seed, pass.resolvePairs.begin(), pass.resolvePairs.end());
+            },
+            [&](const CopyPass& pass) {
+                for (const auto& pair : pass.copyPairs) {
+                    ccstd::hash_combine(seed, pair.source);
+                    ccstd::hash_combine(seed, pair.sourceMostDetailedMip);
+                    ccstd::hash_combine(seed, pair.sourceFirstSlice);
+                    ccstd::hash_combine(seed, pair.sourcePlaneSlice);
+                    hashTransferPair(seed, pair);
+                }
+                for (const auto& pair : pass.uploadPairs) {
+                    hashTransferPair(seed, pair);
+                }
+            },
+            [&](const MovePass& pass) {
+                for (const auto& pair : pass.movePairs) {
+                    ccstd::hash_combine(seed, pair.source);
+                    hashTransferPair(seed, pair);
+                }
+            },
+            [&](const RaytracePass& pass) {
+                hashComputeViews(seed, pass.computeViews);
+            },
+            [&](const auto& /*data*/) {});
+    }
+    ccstd::hash_range(seed, rg.sortedVertices.begin(), rg.sortedVertices.end());
+
+    ccstd::hash_combine(seed, num_vertices(resg));
+    ccstd::hash_combine(seed, resg.version);
+    for (const auto resID : makeRange(vertices(resg))) {
+        const auto& desc = get(ResourceGraph::DescTag{}, resg, resID);
+        ccstd::hash_combine(seed, get(ResourceGraph::NameTag{}, resg, resID));
+        ccstd::hash_combine(seed, desc.dimension);
+        ccstd::hash_combine(seed, desc.width);
+        ccstd::hash_combine(seed, desc.height);
+        ccstd::hash_combine(seed, desc.depthOrArraySize);
+        ccstd::hash_combine(seed, desc.mipLevels);
+        ccstd::hash_combine(seed, desc.format);
+        ccstd::hash_combine(seed, desc.sampleCount);
+        ccstd::hash_combine(seed, desc.textureFlags);
+        ccstd::hash_combine(seed, desc.flags);
+        ccstd::hash_combine(seed, desc.viewType);
+        ccstd::hash_combine(seed, get(ResourceGraph::TraitsTag{}, resg, resID).residency);
+        ccstd::hash_combine(seed, get(ResourceGraph::StatesTag{}, resg, resID).states);
+    }
+    return seed;
+}
+
+template <class Graph>
+bool matchNames(const ccstd::vector<ccstd::string>& names, const Graph& g) {
+    if (names.size() != num_vertices(g)) {
+        return false;
+    }
+    for (const auto vertID : makeRange(vertices(g))) {
+        if (std::string_view{get(typename Graph::NameTag{}, g, vertID)} != names[vertID]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <class Graph>
+void recordNames(ccstd::vector<ccstd::string>& names, const Graph& g) {
+    names.clear();
+    names.reserve(num_vertices(g));
+    for (const auto vertID : makeRange(vertices(g))) {
+        names.emplace_back(std::string_view{get(typename Graph::NameTag{}, g, vertID)});
+    }
+}
+
+// Reuses last frame's dispatcher when the render graph and resources are unchanged.
+// run() writes the final access states of the resources back to the ResourceGraph,
+// they are recorded on a miss and restored on a hit.
+const FrameGraphDispatcher& compileRenderGraph(
+    NativePipeline& ppl, const RenderGraph& rg, const LayoutGraphData& lg) {
+    CC_PROFILE(RenderGraphCompile);
+    const auto start = std::chrono::steady_clock::now();
+
+    auto& cache = getRenderGraphCompileCache();
+    auto& resg = ppl.resourceGraph;
+    const auto hash = cache.enabled ? hashRenderGraph(rg, resg, lg) : 0;
+
+    if (cache.enabled && cache.dispatcher && cache.hash == hash &&
+        cache.resourceStates.size() == num_vertices(resg) &&
+        matchNames(cache.passNames, rg) && matchNames(cache.resourceNames, resg)) {
+        for (const auto resID : makeRange(vertices(resg))) {
+            get(ResourceGraph::StatesTag{}, resg, resID).states = cache.resourceStates[resID];
+        }
+        ++cache.numHits;
+    } else {
+        cache.dispatcher.reset();
+        cache.dispatcher = std::make_unique<FrameGraphDispatcher>(
+            resg, rg, lg, &ppl.unsyncPool, &ppl.unsyncPool);
+        auto& fgd = *cache.dispatcher;
+        fgd.enableMemoryAliasing(false);
+        fgd.enablePassReorder(false);
+        fgd.setParalellWeight(0);
+        fgd.run();
+
+        cache.hash = hash;
+        cache.resourceStates.clear();
+        cache.passNames.clear();
+        cache.resourceNames.clear();
+        if (cache.enabled) {
+            cache.resourceStates.reserve(num_vertices(resg));
+            for (const auto resID : makeRange(vertices(resg))) {
+                cache.resourceStates.emplace_back(get(ResourceGraph::StatesTag{}, resg, resID).states);
+            }
+            recordNames(cache.passNames, rg);
+            recordNames(cache.resourceNames, resg);
+        }
+        ++cache.numMisses;
+    }
+
+    cache.compileTime = std::chrono::duration<float, std::milli>(
+                            std::chrono::steady_clock::now() - start)
+                            .count();
+    CC_PROFILE_OBJECT_UPDATE(RenderGraphCacheHitRate, static_cast<uint32_t>(cache.getHitRate() * 100.0F));
+
+    return *cache.dispatcher;
+}
+
 } // namespace
 
 void NativePipeline::executeRenderGraph(const RenderGraph& rg) {
@@ -1262,13 +1711,7 @@ void NativePipeline::executeRenderGraph(const RenderGraph& rg) {
     ResourceCleaner cleaner(ppl.resourceGraph);
 
     auto& lg = ppl.programLibrary->layoutGraph;
-    FrameGraphDispatcher fgd(
-        ppl.resourceGraph, rg,
-        lg, &ppl.unsyncPool, scratch);
-    fgd.enableMemoryAliasing(false);
-    fgd.enablePassReorder(false);
-    fgd.setParalellWeight(0);
-    fgd.run();
+    const auto& fgd = compileRenderGraph(ppl, rg, lg);
 
     AddressableView<RenderGraph> graphView(rg);
     ccstd::pmr::vector<bool> validPasses(num_vertices(rg), true, scratch);
@@ -1328,7 +1771,9 @@ void NativePipeline::executeRenderGraph(const RenderGraph& rg) {
             boost::keep_all, RenderGraphFilter>
             fg(graphView, boost::keep_all{}, RenderGraphFilter{&validPasses});
 
-        CommandSubmitter submit(ppl.device, ppl.getCommandBuffers());
+        CommandSubmitter submit(
+            ppl.device, ppl.getCommandBuffers(),
+            getParallelCommandRecorder().recordedCommandBuffers);
 
         // upload buffers
         {
@@ -0,0 +1,139 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#pragma once
+#include <cstdint>
+#include <memory>
+#include "cocos/base/Ptr.h"
+#include "cocos/base/std/container/string.h"
+#include "cocos/base/std/container/vector.h"
+#include "cocos/base/std/hash/hash.h"
+#include "cocos/renderer/pipeline/custom/FGDispatcherTypes.h"
+#include "cocos/renderer/pipeline/custom/NativePipelineFwd.h"
+#include "cocos/renderer/pipeline/custom/RenderGraphTypes.h"
+
+namespace cc {
+
+namespace gfx {
+class CommandBuffer;
+class Device;
+class RenderPass;
+} // namespace gfx
+
+namespace render {
+
+struct PassRecordStatistics {
+    RenderGraph::vertex_descriptor passID{RenderGraph::null_vertex()};
+    uint32_t numDraws{0};
+    uint32_t numCommandBuffers{0};
+    // main-thread record time of the pass, in milliseconds
+    float recordTime{0};
+};
+
+enum class QueueSection : uint8_t {
+    OPAQUE_DRAWS,
+    OPAQUE_INSTANCING,
+    BLEND_DRAWS,
+    BLEND_INSTANCING,
+};
+
+// Draws [first, first + count) of a section of a scene queue
+struct RecordRange {
+    RenderGraph::vertex_descriptor sceneID{RenderGraph::null_vertex()};
+    const NativeRenderQueue* queue{nullptr};
+    QueueSection section{QueueSection::OPAQUE_DRAWS};
+    uint32_t first{0};
+    uint32_t count{0};
+};
+
+// Ranges [rangeBegin, rangeEnd) recorded into one secondary command buffer
+struct RecordTask {
+    gfx::CommandBuffer* cmdBuff{nullptr};
+    uint32_t rangeBegin{0};
+    uint32_t rangeEnd{0};
+};
+
+// Splits the sections, in graph order, into ranges and groups them into tasks of similar size.
+// Instancing sections are never split. Returns false if there are less than 2 tasks.
+bool splitRecordTasks(
+    const ccstd::pmr::vector<RecordRange>& sections,
+    uint32_t numDraws, uint32_t minDrawsPerTask, uint32_t numWorkers,
+    ccstd::pmr::vector<RecordRange>& ranges,
+    ccstd::pmr::vector<RecordTask>& tasks);
+
+// Secondary command buffers of the raster passes recorded by job workers.
+// Command buffers are kept across frames, and are reused in allocation order.
+struct ParallelCommandRecorder {
+    void clear() noexcept;
+    void destroy() noexcept;
+    gfx::CommandBuffer* allocateCommandBuffer(gfx::Device* device);
+
+    ccstd::vector<IntrusivePtr<gfx::CommandBuffer>> commandBuffers;
+    ccstd::vector<gfx::CommandBuffer*> recordedCommandBuffers;
+    ccstd::vector<PassRecordStatistics> passStatistics;
+    uint32_t minDrawsPerCommandBuffer{128};
+    bool enabled{false};
+};
+
+// There is only one NativePipeline, see Factory::createPipeline
+ParallelCommandRecorder& getParallelCommandRecorder() noexcept;
+
+// FrameGraphDispatcher of the last compiled render graph, reused while the graph is unchanged.
+// The names are a cheap check against hash collisions.
+struct RenderGraphCompileCache {
+    void clear() noexcept;
+    float getHitRate() const noexcept;
+
+    std::unique_ptr<FrameGraphDispatcher> dispatcher;
+    ccstd::vector<gfx::AccessFlagBit> resourceStates;
+    ccstd::vector<ccstd::string> passNames;
+    ccstd::vector<ccstd::string> resourceNames;
+    ccstd::hash_t hash{0};
+    uint64_t numHits{0};
+    uint64_t numMisses{0};
+    // milliseconds
+    float compileTime{0};
+    bool enabled{true};
+};
+
+// There is only one NativePipeline, see Factory::createPipeline
+RenderGraphCompileCache& getRenderGraphCompileCache() noexcept;
+
+// Pipeline states must be created on the main thread before workers record the queue
+void preparePipelineStates(const RenderDrawQueue& queue, gfx::RenderPass* renderPass, uint32_t subpassIndex);
+void preparePipelineStates(const RenderInstancingQueue& queue, gfx::RenderPass* renderPass, uint32_t subpassIndex);
+
+uint32_t getNumDraws(const RenderInstancingQueue& queue) noexcept;
+
+// Records the instances [first, first + count) of the queue
+void recordCommandBuffer(
+    const RenderDrawQueue& queue,
+    gfx::RenderPass* renderPass, uint32_t subpassIndex,
+    gfx::CommandBuffer* cmdBuffer,
+    uint32_t lightByteOffset, uint32_t first, uint32_t count);
+
+} // namespace render
+
+} // namespace cc
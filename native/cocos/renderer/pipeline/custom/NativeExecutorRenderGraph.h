@@ -23,6 +23,7 @@
 ****************************************************************************/
 
 #pragma once
+#include <chrono>
 #include "FGDispatcherTypes.h"
 #include "LayoutGraphTypes.h"
 #include "NativePipelineTypes.h"
@@ -78,6 +79,8 @@ struct RenderGraphVisitorContext {
     gfx::RenderPass* currentPass = nullptr;
     uint32_t subpassIndex = 0;
     RenderGraph::vertex_descriptor currentInFlightPassID = RenderGraph::null_vertex();
+    RenderGraph::vertex_descriptor parallelPassID = RenderGraph::null_vertex();
+    std::chrono::steady_clock::time_point passBeginTime;
     Mat4 currentProjMatrix;
 };
 
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include "NativeExecutorDetail.h"
 #include "NativePipelineTypes.h"
 #include "details/GslUtils.h"
 
@@ -144,6 +146,98 @@ gfx::DescriptorSet* DescriptorSetPool::allocateDescriptorSet() {
     return ptr;
 }
 
+void ParallelCommandRecorder::clear() noexcept {
+    recordedCommandBuffers.clear();
+    passStatistics.clear();
+}
+
+void ParallelCommandRecorder::destroy() noexcept {
+    clear();
+    commandBuffers.clear();
+}
+
+gfx::CommandBuffer* ParallelCommandRecorder::allocateCommandBuffer(gfx::Device* device) {
+    const auto id = recordedCommandBuffers.size();
+    if (id == commandBuffers.size()) {
+        commandBuffers.emplace_back(device->createCommandBuffer(gfx::CommandBufferInfo{
+            device->getQueue(),
+            gfx::CommandBufferType::SECONDARY,
+        }));
+    }
+    CC_ENSURES(id < commandBuffers.size());
+    auto* cmdBuff = commandBuffers[id].get();
+    recordedCommandBuffers.emplace_back(cmdBuff);
+    return cmdBuff;
+}
+
+bool splitRecordTasks(
+    const ccstd::pmr::vector<RecordRange>& sections,
+    uint32_t numDraws, uint32_t minDrawsPerTask, uint32_t numWorkers,
+    ccstd::pmr::vector<RecordRange>& ranges,
+    ccstd::pmr::vector<RecordTask>& tasks) {
+    CC_EXPECTS(minDrawsPerTask);
+    const auto numTasks = std::max(std::min(numDraws / minDrawsPerTask, numWorkers + 1), 1U);
+    const auto drawsPerTask = (numDraws + numTasks - 1) / numTasks;
+    uint32_t budget = drawsPerTask;
+    uint32_t taskBegin = 0;
+    const auto closeTask = [&]() {
+        const auto rangeEnd = static_cast<uint32_t>(ranges.size());
+        if (rangeEnd != taskBegin) {
+            tasks.emplace_back(RecordTask{nullptr, taskBegin, rangeEnd});
+            taskBegin = rangeEnd;
+        }
+        budget = drawsPerTask;
+    };
+    for (const auto& section : sections) {
+        if (section.section == QueueSection::OPAQUE_DRAWS ||
+            section.section == QueueSection::BLEND_DRAWS) {
+            for (uint32_t first = 0; first != section.count;) {
+                const auto count = std::min(section.count - first, budget);
+                ranges.emplace_back(RecordRange{section.sceneID, section.queue, section.section, first, count});
+                first += count;
+                budget -= count;
+                if (!budget) {
+                    closeTask();
+                }
+            }
+        } else {
+            ranges.emplace_back(section);
+            budget -= std::min(budget, section.count);
+            if (!budget) {
+                closeTask();
+            }
+        }
+    }
+    closeTask();
+    return tasks.size() > 1;
+}
+
+ParallelCommandRecorder& getParallelCommandRecorder() noexcept {
+    static ParallelCommandRecorder sRecorder;
+    return sRecorder;
+}
+
+void RenderGraphCompileCache::clear() noexcept {
+    dispatcher.reset();
+    resourceStates.clear();
+    passNames.clear();
+    resourceNames.clear();
+    hash = 0;
+}
+
+float RenderGraphCompileCache::getHitRate() const noexcept {
+    const auto numCompiles = numHits + numMisses;
+    if (numCompiles == 0) {
+        return 0;
+    }
+    return static_cast<float>(numHits) / static_cast<float>(numCompiles);
+}
+
+RenderGraphCompileCache& getRenderGraphCompileCache() noexcept {
+    static RenderGraphCompileCache sCache;
+    return sCache;
+}
+
 } // namespace render
 
 } // namespace cc
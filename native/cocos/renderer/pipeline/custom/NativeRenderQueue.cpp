@@ -23,6 +23,7 @@
 ****************************************************************************/
 
 #include <algorithm>
+#include "NativeExecutorDetail.h"
 #include "NativePipelineTypes.h"
 #include "cocos/renderer/pipeline/Define.h"
 #include "cocos/renderer/pipeline/InstancedBuffer.h"
@@ -130,11 +131,33 @@ void RenderDrawQueue::sortTransparent() {
     });
 }
 
+void preparePipelineStates(const RenderDrawQueue &queue, gfx::RenderPass *renderPass, uint32_t subpassIndex) {
+    for (const auto &instance : queue.instances) {
+        const auto *subModel = instance.subModel;
+        const auto passIdx = instance.passIndex;
+        pipeline::PipelineStateManager::getOrCreatePipelineState(
+            subModel->getPass(passIdx), subModel->getShader(passIdx),
+            subModel->getInputAssembler(), renderPass, subpassIndex);
+    }
+}
+
 void RenderDrawQueue::recordCommandBuffer(
     gfx::RenderPass *renderPass, uint32_t subpassIndex,
     gfx::CommandBuffer *cmdBuff,
     uint32_t lightByteOffset) const {
-    for (const auto &instance : instances) {
+    render::recordCommandBuffer(
+        *this, renderPass, subpassIndex, cmdBuff, lightByteOffset,
+        0, static_cast<uint32_t>(instances.size()));
+}
+
+void recordCommandBuffer(
+    const RenderDrawQueue &queue,
+    gfx::RenderPass *renderPass, uint32_t subpassIndex,
+    gfx::CommandBuffer *cmdBuff,
+    uint32_t lightByteOffset, uint32_t first, uint32_t count) {
+    CC_EXPECTS(first + count <= queue.instances.size());
+    for (uint32_t i = first; i != first + count; ++i) {
+        const auto &instance = queue.instances[i];
         const auto *subModel = instance.subModel;
 
         const auto passIdx = instance.passIndex;
@@ -210,6 +233,32 @@ void RenderInstancingQueue::uploadBuffers(gfx::CommandBuffer *cmdBuffer) const {
     }
 }
 
+void preparePipelineStates(const RenderInstancingQueue &queue, gfx::RenderPass *renderPass, uint32_t subpassIndex) {
+    for (const auto *instanceBuffer : queue.sortedBatches) {
+        if (!instanceBuffer->hasPendingModels()) {
+            continue;
+        }
+        const auto *drawPass = instanceBuffer->getPass();
+        for (const auto &instance : instanceBuffer->getInstances()) {
+            if (!instance.drawInfo.instanceCount) {
+                continue;
+            }
+            pipeline::PipelineStateManager::getOrCreatePipelineState(
+                drawPass, instance.shader, instance.ia, renderPass, subpassIndex);
+        }
+    }
+}
+
+uint32_t getNumDraws(const RenderInstancingQueue &queue) noexcept {
+    uint32_t numDraws = 0;
+    for (const auto *instanceBuffer : queue.sortedBatches) {
+        if (instanceBuffer->hasPendingModels()) {
+            numDraws += static_cast<uint32_t>(instanceBuffer->getInstances().size());
+        }
+    }
+    return numDraws;
+}
+
 void RenderInstancingQueue::recordCommandBuffer(
     gfx::RenderPass *renderPass, uint32_t subpassIndex,
     gfx::CommandBuffer *cmdBuffer,
@@ -1,7 +1,10 @@
+#include "cocos/base/job-system/JobSystem.h"
+#include "cocos/core/Root.h"
 #include "cocos/renderer/pipeline/Define.h"
 #include "cocos/renderer/pipeline/custom/LayoutGraphUtils.h"
 #include "cocos/renderer/pipeline/custom/NativeBuiltinUtils.h"
 #include "cocos/renderer/pipeline/custom/NativePipelineTypes.h"
+#include "cocos/renderer/pipeline/custom/NativeSceneCulling.h"
 #include "cocos/renderer/pipeline/custom/RenderGraphGraphs.h"
 #include "cocos/renderer/pipeline/custom/details/GslUtils.h"
 #include "cocos/renderer/pipeline/custom/details/Range.h"
@@ -267,21 +270,17 @@ void octreeCulling(
         if (!model.isEnabled() || !model.getNode() || model.getWorldBounds() || (bCastShadow && !model.isCastShadow())) {
             continue;
         }
+        // lod culling
+        if (scene.isCulledByLod(&camera, &model)) {
+            continue;
+        }
         // filter model by view visibility
         if (isNodeVisible(model.getNode(), visibility) || isModelVisible(model, visibility)) {
             models.emplace_back(&model);
         }
     }
-    // add instances with world bounds
+    // add instances with world bounds, lod culling is done by the octree query
     octree.queryVisibility(&camera, cameraOrLightFrustum, bCastShadow, models);
-
-    // TODO(zhouzhenglong): move lod culling into octree query
-    auto iter = std::remove_if(
-        models.begin(), models.end(),
-        [&](const scene::Model* model) {
-            return scene.isCulledByLod(&camera, model);
-        });
-    models.erase(iter, models.end());
 }
 
 void bruteForceCulling(
@@ -542,6 +541,16 @@ bool isBlend(const scene::Pass& pass) {
     return bBlend;
 }
 
+void addInstancingObject(
+    NativeRenderQueue& queue,
+    const scene::Pass& pass, scene::SubModel& subModel, uint32_t passIdx, bool bBlend) {
+    if (bBlend) {
+        queue.transparentInstancingQueue.add(pass, subModel, passIdx);
+    } else {
+        queue.opaqueInstancingQueue.add(pass, subModel, passIdx);
+    }
+}
+
 float computeSortingDepth(const scene::Camera& camera, const scene::Model& model) {
     float depth = 0;
     if (model.getNode()) {
@@ -554,6 +563,7 @@ float computeSortingDepth(const scene::Camera& camera, const scene::Model& model
     return depth;
 }
 
+template <class AddInstancing>
 void addRenderObject(
     LayoutGraphData::vertex_descriptor phaseLayoutID,
     const bool bDrawOpaqueOrMask,
@@ -561,7 +571,8 @@ void addRenderObject(
     const bool bDrawProbe,
     const scene::Camera& camera,
     const scene::Model& model,
-    NativeRenderQueue& queue) {
+    NativeRenderQueue& queue,
+    AddInstancing&& addInstancing) {
     if (bDrawProbe) {
         queue.probeQueue.applyMacro(*kLayoutGraph, model, phaseLayoutID);
     }
@@ -597,11 +608,7 @@ void addRenderObject(
 
             // add object to queue
             if (pass.getBatchingScheme() == scene::BatchingSchemes::INSTANCING) {
-                if (bBlend) {
-                    queue.transparentInstancingQueue.add(pass, *subModel, passIdx);
-                } else {
-                    queue.opaqueInstancingQueue.add(pass, *subModel, passIdx);
-                }
+                addInstancing(pass, *subModel, passIdx, bBlend);
             } else {
                 // TODO(zhouzhenglong): change camera to frustum
                 const float depth = computeSortingDepth(camera, model);
@@ -661,7 +668,10 @@ void SceneCulling::fillRenderQueues() {
         for (const auto* const model : sourceModels) {
             addRenderObject(
                 phaseLayoutID, bDrawOpaqueOrMask, bDrawBlend,
-                bDrawProbe, *camera, *model, nativeQueue);
+                bDrawProbe, *camera, *model, nativeQueue,
+                [&nativeQueue](const scene::Pass& pass, scene::SubModel& subModel, uint32_t passIdx, bool bBlend) {
+                    addInstancingObject(nativeQueue, pass, subModel, passIdx, bBlend);
+                });
         }
 
         // post-processing
@@ -669,12 +679,367 @@ void SceneCulling::fillRenderQueues() {
     }
 }
 
+namespace {
+
+// models per job of the single-pass culling
+constexpr uint32_t VISIBILITY_BATCH_SIZE = 256;
+
+struct FrustumQuery {
+    const scene::Camera* camera{nullptr};
+    // nullptr if nothing can be visible, e.g. a csm level without frustum
+    const geometry::Frustum* frustum{nullptr};
+    const scene::ReflectionProbe* probe{nullptr};
+    uint32_t column{0};
+    uint32_t visibility{0};
+    bool bCastShadow{false};
+    bool bProbePass{false};
+    bool bSkybox{false};
+};
+
+struct LightQuery {
+    geometry::AABB bounds;
+    // spot lights only
+    const geometry::Frustum* frustum{nullptr};
+    uint32_t frustumColumn{0};
+    uint32_t column{0};
+};
+
+FrustumQuery makeFrustumQuery(
+    const NativePipeline& ppl, const FrustumCullingKey& key, uint32_t column) {
+    CC_EXPECTS(key.camera);
+    const auto& camera = key.probe ? *key.probe->getCamera() : *key.camera;
+    FrustumQuery query{};
+    query.camera = &camera;
+    query.probe = key.probe;
+    query.column = column;
+    query.visibility = camera.getVisibility();
+    query.bCastShadow = key.castShadow;
+    query.bProbePass = key.probePass;
+    query.bSkybox = !key.castShadow && (static_cast<int32_t>(camera.getClearFlag()) & scene::Camera::SKYBOX_FLAG);
+
+    // same frustum selection as batchFrustumCulling
+    if (key.probe || !key.light) {
+        query.frustum = &camera.getFrustum();
+        return query;
+    }
+    switch (key.light->getType()) {
+        case scene::LightType::SPOT:
+            query.frustum = &dynamic_cast<const scene::SpotLight*>(key.light)->getFrustum();
+            break;
+        case scene::LightType::DIRECTIONAL: {
+            const auto* mainLight = dynamic_cast<const scene::DirectionalLight*>(key.light);
+            query.frustum = getBuiltinShadowFrustum(ppl, camera, mainLight, key.lightLevel);
+        } break;
+        default:
+            break;
+    }
+    // skybox is only added by actual culling passes
+    query.bSkybox = query.bSkybox && query.frustum;
+    return query;
+}
+
+bool makeLightQuery(const LightBoundsCullingKey& key, uint32_t column, LightQuery& query) {
+    query.frustumColumn = key.frustumCullingID.value;
+    query.column = column;
+    query.frustum = nullptr;
+    switch (key.cullingLight->getType()) {
+        case scene::LightType::SPHERE:
+            query.bounds = dynamic_cast<const scene::SphereLight*>(key.cullingLight)->getAABB();
+            return true;
+        case scene::LightType::SPOT: {
+            const auto* light = dynamic_cast<const scene::SpotLight*>(key.cullingLight);
+            query.bounds = light->getAABB();
+            query.frustum = &light->getFrustum();
+        }
+            return true;
+        case scene::LightType::POINT:
+            query.bounds = dynamic_cast<const scene::PointLight*>(key.cullingLight)->getAABB();
+            return true;
+        case scene::LightType::RANGED_DIRECTIONAL: {
+            const auto* light = dynamic_cast<const scene::RangedDirectionalLight*>(key.cullingLight);
+            const geometry::AABB rangedDirLightBoundingBox(0.0F, 0.0F, 0.0F, 0.5F, 0.5F, 0.5F);
+            rangedDirLightBoundingBox.transform(light->getNode()->getWorldMatrix(), &query.bounds);
+        }
+            return true;
+        default:
+            return false;
+    }
+}
+
+// same tests as bruteForceCulling, for a model that is enabled and has a node
+bool isModelVisibleInQuery(
+    const scene::RenderScene& scene, const scene::Model& model, const FrustumQuery& query) {
+    if (!query.frustum || (query.bCastShadow && !model.isCastShadow())) {
+        return false;
+    }
+    if (scene.isCulledByLod(query.camera, &model)) {
+        return false;
+    }
+    const auto* probe = query.probe;
+    if (query.bProbePass && (!probe || probe->getProbeType() != cc::scene::ReflectionProbe::ProbeType::CUBE)) {
+        return isReflectProbeMask(model);
+    }
+    if (!isNodeVisible(model.getNode(), query.visibility) && !isModelVisible(model, query.visibility)) {
+        return false;
+    }
+    const auto* const wBounds = model.getWorldBounds();
+    if (!wBounds) {
+        return true;
+    }
+    if (probe) {
+        return !isIntersectAABB(*wBounds, *probe->getBoundingBox());
+    }
+    return !isFrustumCulled(model, *query.frustum, query.bCastShadow);
+}
+
+bool isModelLitByQuery(const scene::Model& model, const LightQuery& query) {
+    const auto* const modelBounds = model.getWorldBounds();
+    return !modelBounds ||
+           (modelBounds->aabbAabb(query.bounds) && (!query.frustum || modelBounds->aabbFrustum(*query.frustum)));
+}
+
+inline void setVisibilityBit(uint64_t* bits, uint32_t column) {
+    bits[column / 64] |= uint64_t{1} << (column % 64);
+}
+
+inline bool testVisibilityBit(const uint64_t* bits, uint32_t column) {
+    return (bits[column / 64] >> (column % 64)) & 1;
+}
+
+template <class Func>
+void parallelFor(uint32_t jobCount, Func&& func) {
+    if (jobCount > 1 && JobSystem::getInstance()->threadCount() > 1) {
+        JobGraph g(JobSystem::getInstance());
+        g.createForEachIndexJob(0U, jobCount, 1U, func);
+        g.run();
+        g.waitForAll();
+    } else {
+        for (uint32_t i = 0U; i < jobCount; ++i) {
+            func(i);
+        }
+    }
+}
+
+} // namespace
+
+void SinglePassCulling::cull(const SceneCulling& sceneCulling, const NativePipeline& ppl) {
+    const auto& pplSceneData = *ppl.getPipelineSceneData();
+    const auto* const skybox = pplSceneData.getSkybox();
+    const auto* const skyboxModel = skybox && skybox->isEnabled() ? skybox->getModel() : nullptr;
+
+    // one column per frustum culling, followed by one per light bounds culling
+    const uint32_t numColumns = sceneCulling.numFrustumCulling + sceneCulling.numLightBoundsCulling;
+    wordsPerModel = (numColumns + 63) / 64;
+    models.clear();
+    mask.clear();
+    queryRanges.assign(numColumns, VisibilityQueryRange{});
+
+    ccstd::vector<FrustumQuery> frustumQueries;
+    ccstd::vector<LightQuery> lightQueries;
+    for (const auto& [renderScene, queries] : sceneCulling.frustumCullings) {
+        CC_ENSURES(renderScene);
+        const auto& scene = *renderScene;
+
+        frustumQueries.clear();
+        bool bSkybox = false;
+        for (const auto& [key, frustomCulledResultID] : queries.resultIndex) {
+            CC_EXPECTS(key.camera->getScene() == nullptr || key.camera->getScene() == &scene);
+            frustumQueries.emplace_back(makeFrustumQuery(ppl, key, frustomCulledResultID.value));
+            bSkybox = bSkybox || frustumQueries.back().bSkybox;
+        }
+        lightQueries.clear();
+        auto lightIter = sceneCulling.lightBoundsCullings.find(&scene);
+        if (lightIter != sceneCulling.lightBoundsCullings.end()) {
+            for (const auto& [key, cullingID] : lightIter->second.resultIndex) {
+                LightQuery query{};
+                if (makeLightQuery(key, sceneCulling.numFrustumCulling + cullingID.value, query)) {
+                    lightQueries.emplace_back(query);
+                }
+            }
+        }
+
+        // rows of this scene, the skybox goes first as it is not part of the scene models
+        const auto modelBegin = static_cast<uint32_t>(models.size());
+        const bool bSkyboxRow = bSkybox && skyboxModel;
+        if (bSkyboxRow) {
+            models.emplace_back(skyboxModel);
+        }
+        for (const auto& pModel : scene.getModels()) {
+            CC_EXPECTS(pModel);
+            models.emplace_back(pModel.get());
+        }
+        const auto modelEnd = static_cast<uint32_t>(models.size());
+        mask.resize(static_cast<size_t>(modelEnd) * wordsPerModel, 0);
+        for (const auto& query : frustumQueries) {
+            queryRanges[query.column] = {modelBegin, modelEnd};
+        }
+        for (const auto& query : lightQueries) {
+            queryRanges[query.column] = {modelBegin, modelEnd};
+        }
+
+        // every model is loaded once and tested against all queries of the frame
+        const auto* const sceneModels = models.data() + modelBegin;
+        auto* const sceneMask = mask.data() + static_cast<size_t>(modelBegin) * wordsPerModel;
+        const auto numWords = wordsPerModel;
+        const auto count = modelEnd - modelBegin;
+        const auto* const pScene = &scene;
+        const auto* const pFrustumQueries = &frustumQueries;
+        const auto* const pLightQueries = &lightQueries;
+        const auto batchCount = (count + VISIBILITY_BATCH_SIZE - 1) / VISIBILITY_BATCH_SIZE;
+        parallelFor(batchCount, [=](uint32_t batch) {
+            const auto end = std::min(count, (batch + 1) * VISIBILITY_BATCH_SIZE);
+            for (auto i = batch * VISIBILITY_BATCH_SIZE; i < end; ++i) {
+                auto* const bits = sceneMask + static_cast<size_t>(i) * numWords;
+                if (bSkyboxRow && i == 0) {
+                    for (const auto& query : *pFrustumQueries) {
+                        if (query.bSkybox) {
+                            setVisibilityBit(bits, query.column);
+                        }
+                    }
+                    continue;
+                }
+                const auto& model = *sceneModels[i];
+                if (!model.isEnabled() || !model.getNode()) {
+                    continue;
+                }
+                for (const auto& query : *pFrustumQueries) {
+                    if (isModelVisibleInQuery(*pScene, model, query)) {
+                        setVisibilityBit(bits, query.column);
+                    }
+                }
+                for (const auto& query : *pLightQueries) {
+                    if (testVisibilityBit(bits, query.frustumColumn) && isModelLitByQuery(model, query)) {
+                        setVisibilityBit(bits, query.column);
+                    }
+                }
+            }
+        });
+    }
+}
+
+void SinglePassCulling::fillRenderQueues(SceneCulling& sceneCulling) {
+    struct QueueTask {
+        NativeRenderQueue* queue{nullptr};
+        LayoutGraphData::vertex_descriptor phaseLayoutID{LayoutGraphData::null_vertex()};
+        uint32_t column{0};
+        uint32_t queueID{0};
+    };
+    ccstd::vector<QueueTask> tasks;
+    tasks.reserve(sceneCulling.renderQueueIndex.size());
+    if (pendingInstancingItems.size() < sceneCulling.numRenderQueues) {
+        pendingInstancingItems.resize(sceneCulling.numRenderQueues);
+    }
+
+    const auto* const pMask = mask.data();
+    const auto numWords = wordsPerModel;
+    const auto* const pModels = models.data();
+    auto fillQueue = [&](const QueueTask& task, auto&& addInstancing) {
+        auto& queue = *task.queue;
+        const bool bDrawBlend = any(queue.sceneFlags & SceneFlags::BLEND);
+        const bool bDrawOpaqueOrMask = any(queue.sceneFlags & (SceneFlags::OPAQUE | SceneFlags::MASK));
+        const bool bDrawProbe = any(queue.sceneFlags & SceneFlags::REFLECTION_PROBE);
+        const auto& range = queryRanges[task.column];
+        for (auto i = range.modelBegin; i < range.modelEnd; ++i) {
+            if (testVisibilityBit(pMask + static_cast<size_t>(i) * numWords, task.column)) {
+                addRenderObject(
+                    task.phaseLayoutID, bDrawOpaqueOrMask, bDrawBlend,
+                    bDrawProbe, *queue.camera, *pModels[i], queue, addInstancing);
+            }
+        }
+    };
+
+    for (const auto& [key, targetID] : sceneCulling.renderQueueIndex) {
+        CC_EXPECTS(targetID.value < sceneCulling.renderQueues.size());
+        auto& nativeQueue = sceneCulling.renderQueues[targetID.value];
+        CC_EXPECTS(nativeQueue.empty());
+        CC_EXPECTS(nativeQueue.camera);
+
+        const bool bDrawBlend = any(nativeQueue.sceneFlags & SceneFlags::BLEND);
+        const bool bDrawOpaqueOrMask = any(nativeQueue.sceneFlags & (SceneFlags::OPAQUE | SceneFlags::MASK));
+        const bool bDrawShadowCaster = any(nativeQueue.sceneFlags & SceneFlags::SHADOW_CASTER);
+        const bool bDrawProbe = any(nativeQueue.sceneFlags & SceneFlags::REFLECTION_PROBE);
+        if (!bDrawShadowCaster && !bDrawBlend && !bDrawOpaqueOrMask && !bDrawProbe) {
+            // nothing to draw
+            continue;
+        }
+        CC_EXPECTS(key.queueLayoutID != LayoutGraphData::null_vertex());
+        CC_EXPECTS(key.frustumCulledResultID.value < sceneCulling.numFrustumCulling);
+
+        QueueTask task{&nativeQueue, key.queueLayoutID, key.frustumCulledResultID.value, targetID.value};
+        if (key.lightBoundsCulledResultID.value != 0xFFFFFFFF) {
+            CC_EXPECTS(key.lightBoundsCulledResultID.value < sceneCulling.numLightBoundsCulling);
+            task.column = sceneCulling.numFrustumCulling + key.lightBoundsCulledResultID.value;
+        }
+
+        if (bDrawProbe) {
+            // probe queues patch model macros, keep them on this thread
+            fillQueue(task, [&nativeQueue](const scene::Pass& pass, scene::SubModel& subModel, uint32_t passIdx, bool bBlend) {
+                addInstancingObject(nativeQueue, pass, subModel, passIdx, bBlend);
+            });
+            nativeQueue.sort();
+            continue;
+        }
+        tasks.emplace_back(task);
+    }
+
+    // draw queues are filled and sorted in parallel, each job only writes its own queue.
+    // instancing may create gfx buffers, so instances are merged afterwards on this thread
+    const auto* const pTasks = tasks.data();
+    auto* const pendingItems = pendingInstancingItems.data();
+    parallelFor(static_cast<uint32_t>(tasks.size()), [&](uint32_t taskID) {
+        const auto& task = pTasks[taskID];
+        auto& items = pendingItems[task.queueID];
+        fillQueue(task, [&items](const scene::Pass& pass, scene::SubModel& subModel, uint32_t passIdx, bool bBlend) {
+            items.emplace_back(PendingInstancingItem{&pass, &subModel, passIdx, bBlend});
+        });
+        task.queue->opaqueQueue.sortOpaqueOrCutout();
+        task.queue->transparentQueue.sortTransparent();
+    });
+
+    for (const auto& task : tasks) {
+        auto& items = pendingInstancingItems[task.queueID];
+        for (const auto& item : items) {
+            addInstancingObject(*task.queue, *item.pass, *item.subModel, item.passIndex, item.blend);
+        }
+        items.clear();
+        task.queue->opaqueInstancingQueue.sort();
+        task.queue->transparentInstancingQueue.sort();
+    }
+}
+
+void SinglePassCulling::clear() noexcept {
+    // capacities are kept
+    models.clear();
+    mask.clear();
+    queryRanges.clear();
+    for (auto& items : pendingInstancingItems) {
+        items.clear();
+    }
+    wordsPerModel = 0;
+}
+
+SinglePassCulling& getSinglePassCulling() noexcept {
+    static SinglePassCulling sSinglePassCulling;
+    return sSinglePassCulling;
+}
+
+LightRingBuffer& getLightRingBuffer() noexcept {
+    static LightRingBuffer sLightRingBuffer;
+    return sLightRingBuffer;
+}
+
 void SceneCulling::buildRenderQueues(
     const RenderGraph& rg, const LayoutGraphData& lg,
     const NativePipeline& ppl) {
     kPipelineSceneData = ppl.pipelineSceneData;
     kLayoutGraph = &lg;
     collectCullingQueries(rg);
+    auto& singlePassCulling = getSinglePassCulling();
+    if (singlePassCulling.enabled) {
+        singlePassCulling.cull(*this, ppl);
+        singlePassCulling.fillRenderQueues(*this);
+        return;
+    }
     batchFrustumCulling(ppl);
     batchLightBoundsCulling(); // cull frustum-culling's results by light bounds
     fillRenderQueues();
@@ -704,6 +1069,9 @@ void SceneCulling::clear() noexcept {
     // clear render graph scene vertex query index
     renderQueueQueryIndex.clear();
 
+    // single-pass visibility
+    getSinglePassCulling().clear();
+
     // reset all counters
     numFrustumCulling = 0;
     numLightBoundsCulling = 0;
@@ -809,6 +1177,20 @@ void LightResource::buildLights(
         }
     }
 
+    // suballocate the light buffer of this frame from the uniform ring
+    auto& ringLights = getLightRingBuffer();
+    ringLights = {};
+    auto* ring = Root::getInstance()->getUniformRingBuffer();
+    if (ring && !lights.empty()) {
+        const auto allocation = ring->allocate(
+            cpuBuffer.data(),
+            static_cast<uint32_t>(lights.size()) * elementSize);
+        if (allocation.isValid()) {
+            ringLights.view = ring->getBufferView(elementSize);
+            ringLights.byteOffset = allocation.offset;
+        }
+    }
+
     // assign light byte offset to each queue
     for (const auto& [sceneID, desc] : sceneCulling.renderQueueQueryIndex) {
         if (desc.lightBoundsCulledResultID.value == 0xFFFFFFFF) {
@@ -818,7 +1200,7 @@ void LightResource::buildLights(
                                          .at(desc.lightBoundsCulledResultID.value)
                                          .lightByteOffset;
 
-        sceneCulling.renderQueues.at(desc.renderQueueTarget.value).lightByteOffset = lightByteOffset;
+        sceneCulling.renderQueues.at(desc.renderQueueTarget.value).lightByteOffset = ringLights.byteOffset + lightByteOffset;
     }
 }
 
@@ -832,6 +1214,11 @@ void LightResource::buildLightBuffer(gfx::CommandBuffer* cmdBuffer) const {
     if (lights.empty()) {
         return;
     }
+    // recorded before the render passes, backends without a render thread draw while recording
+    if (getLightRingBuffer().view) {
+        Root::getInstance()->getUniformRingBuffer()->flush(cmdBuffer);
+        return;
+    }
     cmdBuffer->updateBuffer(
         lightBuffer,
         cpuBuffer.data(),
@@ -843,14 +1230,20 @@ void LightResource::tryUpdateRenderSceneLocalDescriptorSet(const SceneCulling& s
         return;
     }
 
+    // the view of the ring changes with the frame
+    auto* view = getLightRingBuffer().view;
+    if (!view) {
+        view = firstLightBufferView.get();
+    }
+
     for (const auto& [scene, culling] : sceneCulling.frustumCullings) {
         for (const auto& model : scene->getModels()) {
             CC_EXPECTS(model);
             for (const auto& submodel : model->getSubModels()) {
                 auto* set = submodel->getDescriptorSet();
                 const auto& prev = set->getBuffer(binding);
-                if (resized || prev != firstLightBufferView) {
-                    set->bindBuffer(binding, firstLightBufferView);
+                if (resized || prev != view) {
+                    set->bindBuffer(binding, view);
                     set->update();
                 }
             }
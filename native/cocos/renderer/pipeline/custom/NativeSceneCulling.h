@@ -0,0 +1,91 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#pragma once
+#include <cstdint>
+#include "cocos/base/std/container/vector.h"
+#include "cocos/renderer/pipeline/custom/NativePipelineFwd.h"
+
+namespace cc {
+
+namespace gfx {
+class Buffer;
+} // namespace gfx
+
+namespace scene {
+class Model;
+class Pass;
+class SubModel;
+} // namespace scene
+
+namespace render {
+
+// models of one scene, tested by a single query
+struct VisibilityQueryRange {
+    uint32_t modelBegin{0};
+    uint32_t modelEnd{0};
+};
+
+// instancing added by a job worker, merged into the queue on the calling thread
+struct PendingInstancingItem {
+    const scene::Pass* pass{nullptr};
+    scene::SubModel* subModel{nullptr};
+    uint32_t passIndex{0};
+    bool blend{false};
+};
+
+// Single-pass visibility culling of SceneCulling.
+// Every model of a scene is visited once and tested against all the queries of the frame,
+// the results are stored in a model x query bitmask, one column per query.
+// The columns of frustum cullings come first, followed by the light bounds cullings.
+struct SinglePassCulling {
+    void cull(const SceneCulling& sceneCulling, const NativePipeline& ppl);
+    void fillRenderQueues(SceneCulling& sceneCulling);
+    void clear() noexcept;
+
+    ccstd::vector<const scene::Model*> models;
+    ccstd::vector<uint64_t> mask;
+    ccstd::vector<VisibilityQueryRange> queryRanges;
+    ccstd::vector<ccstd::vector<PendingInstancingItem>> pendingInstancingItems;
+    uint32_t wordsPerModel{0};
+    bool enabled{false};
+};
+
+// There is only one NativePipeline, see Factory::createPipeline
+SinglePassCulling& getSinglePassCulling() noexcept;
+
+// Light UBOs of LightResource, suballocated from the uniform ring of Root in this frame.
+// The light byte offsets of the render queues include byteOffset.
+// view is null when the ring is full, the lights are uploaded to LightResource::lightBuffer instead.
+struct LightRingBuffer {
+    gfx::Buffer* view{nullptr};
+    uint32_t byteOffset{0};
+};
+
+LightRingBuffer& getLightRingBuffer() noexcept;
+
+} // namespace render
+
+} // namespace cc
@@ -32,6 +32,7 @@
 #include "../shadow/ShadowFlow.h"
 #include "DeferredPipelineSceneData.h"
 #include "MainFlow.h"
+#include "core/Root.h"
 #include "gfx-base/GFXBuffer.h"
 #include "gfx-base/GFXCommandBuffer.h"
 #include "gfx-base/GFXDef.h"
@@ -148,6 +149,11 @@ void DeferredPipeline::render(const ccstd::vector<scene::Camera *> &cameras) {
         _commandBuffers[0]->completeQueryPool(_queryPools[0]);
     }
 
+    // uniforms suballocated from the ring and not yet uploaded by their consumers
+    if (auto *ring = Root::getInstance()->getUniformRingBuffer()) {
+        ring->flush();
+    }
+
     _commandBuffers[0]->end();
     _device->flushCommands(_commandBuffers);
     _device->getQueue()->submit(_commandBuffers);
@@ -69,7 +69,7 @@ void GbufferStage::activate(RenderPipeline *pipeline, RenderFlow *flow) {
     for (const auto &descriptor : _renderQueueDescriptors) {
         uint32_t phase = convertPhase(descriptor->stages);
         RenderQueueSortFunc sortFunc = convertQueueSortFunc(descriptor->sortMode);
-        RenderQueueCreateInfo info = {descriptor->isTransparent, phase, sortFunc};
+        RenderQueueCreateInfo info = {descriptor->isTransparent, phase, sortFunc, true, descriptor->sortMode};
         _renderQueues.emplace_back(ccnew RenderQueue(_pipeline, std::move(info), true));
     }
     _planarShadowQueue = ccnew PlanarShadowQueue(_pipeline);
@@ -116,9 +116,7 @@ void GbufferStage::dispenseRenderObject2Queues() {
         }
     }
 
-    for (auto *queue : _renderQueues) {
-        queue->sort();
-    }
+    RenderQueue::sortQueues(_renderQueues);
 }
 void GbufferStage::recordCommands(DeferredPipeline *pipeline, scene::Camera *camera, gfx::RenderPass *renderPass) {
     auto *cmdBuff = pipeline->getCommandBuffers()[0];
@@ -65,6 +65,7 @@ framegraph::StringHandle ssprRenderPass[MAX_REFLECTOR_SIZE];
 framegraph::StringHandle fgStrHandleClusterLightBuffer = framegraph::FrameGraph::stringToHandle("clusterLightBuffer");
 framegraph::StringHandle fgStrHandleClusterLightIndexBuffer = framegraph::FrameGraph::stringToHandle("lightIndexBuffer");
 framegraph::StringHandle fgStrHandleClusterLightGridBuffer = framegraph::FrameGraph::stringToHandle("lightGridBuffer");
+framegraph::StringHandle fgStrHandleClusterLightDataTexture = framegraph::FrameGraph::stringToHandle("clusterLightDataTexture");
 
 void initStrHandle() {
     ccstd::string tmp;
@@ -390,7 +391,7 @@ void LightingStage::activate(RenderPipeline *pipeline, RenderFlow *flow) {
     for (const auto &descriptor : _renderQueueDescriptors) {
         uint32_t phase = convertPhase(descriptor->stages);
         RenderQueueSortFunc sortFunc = convertQueueSortFunc(descriptor->sortMode);
-        RenderQueueCreateInfo info = {descriptor->isTransparent, phase, sortFunc};
+        RenderQueueCreateInfo info = {descriptor->isTransparent, phase, sortFunc, true, descriptor->sortMode};
         _renderQueues.emplace_back(ccnew RenderQueue(_pipeline, std::move(info), true));
     }
 
@@ -410,7 +411,7 @@ void LightingStage::activate(RenderPipeline *pipeline, RenderFlow *flow) {
     _planarShadowQueue = ccnew PlanarShadowQueue(_pipeline);
 
     // create reflection resource
-    RenderQueueCreateInfo info = {true, _reflectionPhaseID, transparentCompareFn};
+    RenderQueueCreateInfo info = {true, _reflectionPhaseID, transparentCompareFn, true, RenderQueueSortMode::BACK_TO_FRONT};
     _reflectionComp = ccnew ReflectionComp();
     _reflectionComp->init(_device, 8, 8);
 
@@ -443,9 +444,10 @@ void LightingStage::fgLightingPass(scene::Camera *camera) {
         framegraph::TextureHandle outputTex;  // output texture
         framegraph::TextureHandle depth;
         framegraph::TextureHandle depthStencil;
-        framegraph::BufferHandle lightBuffer;      // light storage buffer
-        framegraph::BufferHandle lightIndexBuffer; // light index storage buffer
-        framegraph::BufferHandle lightGridBuffer;  // light grid storage buffer
+        framegraph::BufferHandle lightBuffer;       // light storage buffer
+        framegraph::BufferHandle lightIndexBuffer;  // light index storage buffer
+        framegraph::BufferHandle lightGridBuffer;   // light grid storage buffer
+        framegraph::TextureHandle lightDataTexture; // light grid, lights and indices without storage buffers
     };
 
     auto *pipeline = static_cast<DeferredPipeline *>(_pipeline);
@@ -490,6 +492,10 @@ void LightingStage::fgLightingPass(scene::Camera *camera) {
             if (data.lightGridBuffer.isValid()) {
                 builder.read(data.lightGridBuffer);
             }
+            data.lightDataTexture = framegraph::TextureHandle(builder.readFromBlackboard(fgStrHandleClusterLightDataTexture));
+            if (data.lightDataTexture.isValid()) {
+                builder.read(data.lightDataTexture);
+            }
         }
 
         // write to lighting output
@@ -549,6 +555,12 @@ void LightingStage::fgLightingPass(scene::Camera *camera) {
             if (data.lightGridBuffer.isValid()) {
                 pass->getDescriptorSet()->bindBuffer(CLUSTER_LIGHT_GRID_BINDING, table.getRead(data.lightGridBuffer));
             }
+            // light lists encoded in a float texture when storage buffers are unavailable
+            if (data.lightDataTexture.isValid()) {
+                const auto binding = pass->getBinding("cc_clusterLightData");
+                pass->getDescriptorSet()->bindTexture(binding, table.getRead(data.lightDataTexture));
+                pass->getDescriptorSet()->bindSampler(binding, _defaultSampler);
+            }
         }
 
         pass->getDescriptorSet()->update();
@@ -31,6 +31,7 @@
 #include "../reflection-probe/ReflectionProbeFlow.h"
 #include "../shadow/ShadowFlow.h"
 #include "ForwardFlow.h"
+#include "core/Root.h"
 #include "gfx-base/GFXDevice.h"
 #include "profiler/Profiler.h"
 #include "scene/Camera.h"
@@ -135,6 +136,11 @@ void ForwardPipeline::render(const ccstd::vector<scene::Camera *> &cameras) {
         _commandBuffers[0]->completeQueryPool(_queryPools[0]);
     }
 
+    // uniforms suballocated from the ring and not yet uploaded by their consumers
+    if (auto *ring = Root::getInstance()->getUniformRingBuffer()) {
+        ring->flush();
+    }
+
     _commandBuffers[0]->end();
     _device->flushCommands(_commandBuffers);
     _device->getQueue()->submit(_commandBuffers);
@@ -73,7 +73,7 @@ void ForwardStage::activate(RenderPipeline *pipeline, RenderFlow *flow) {
     for (const auto &descriptor : _renderQueueDescriptors) {
         uint32_t phase = convertPhase(descriptor->stages);
         RenderQueueSortFunc sortFunc = convertQueueSortFunc(descriptor->sortMode);
-        RenderQueueCreateInfo info = {descriptor->isTransparent, phase, sortFunc};
+        RenderQueueCreateInfo info = {descriptor->isTransparent, phase, sortFunc, true, descriptor->sortMode};
         _renderQueues.emplace_back(ccnew RenderQueue(_pipeline, std::move(info), true));
     }
 
@@ -128,10 +128,15 @@ void ForwardStage::dispenseRenderObject2Queues() {
     }
 
     _instancedQueue->sort();
+#if CC_USE_PROFILER
+    const auto stats = _instancedQueue->getStats();
+    CC_PROFILE_OBJECT_UPDATE(InstancedDraws, stats.draws);
+    CC_PROFILE_OBJECT_UPDATE(InstancedInstances, stats.instances);
+    CC_PROFILE_OBJECT_UPDATE(InstancedMergeMisses, stats.mergeMisses);
+    CC_PROFILE_OBJECT_UPDATE(InstancedCapacityMisses, stats.capacityMisses);
+#endif
 
-    for (auto *queue : _renderQueues) {
-        queue->sort();
-    }
+    RenderQueue::sortQueues(_renderQueues);
 }
 
 void ForwardStage::render(scene::Camera *camera) {
@@ -35,13 +35,19 @@ namespace pipeline {
 float ShadowTransformInfo::_maxLayerPosz{0.0F};
 float ShadowTransformInfo::_maxLayerFarPlane{0.0F};
 
+namespace {
+// Depth range quantization of cached cascades, relative to the cascade's ortho size.
+constexpr float STATIC_CACHE_DEPTH_STEP = 0.125F;
+} // namespace
+
 ShadowTransformInfo::ShadowTransformInfo(uint32_t level) : _level(level) {
     _validFrustum.setType(geometry::ShapeEnum::SHAPE_FRUSTUM_ACCURATE);
+    _cachedValidFrustum.setType(geometry::ShapeEnum::SHAPE_FRUSTUM_ACCURATE);
     _splitFrustum.setType(geometry::ShapeEnum::SHAPE_FRUSTUM_ACCURATE);
     _lightViewFrustum.setType(geometry::ShapeEnum::SHAPE_FRUSTUM_ACCURATE);
 }
 
-void ShadowTransformInfo::createMatrix(const geometry::Frustum &splitFrustum, const scene::DirectionalLight *dirLight, float shadowMapWidth, bool isOnlyCulling) {
+void ShadowTransformInfo::createMatrix(const geometry::Frustum &splitFrustum, const scene::DirectionalLight *dirLight, float shadowMapWidth, bool isOnlyCulling, bool isStableDepth) {
     const float invisibleOcclusionRange = dirLight->getShadowInvisibleOcclusionRange();
     const gfx::Device *device = gfx::Device::getInstance();
     const Root *root = Root::getInstance();
@@ -82,6 +88,15 @@ void ShadowTransformInfo::createMatrix(const geometry::Frustum &splitFrustum, co
         }
     }
 
+    // The xy range is already snapped to texels, quantize the depth range as well so that the shadow camera
+    // of a cached cascade does not change while the view camera moves or rotates inside the quantization step.
+    if (isStableDepth && dirLight->getCSMOptimizationMode() != scene::CSMOptimizationMode::DISABLE_ROTATION_FIX) {
+        const float step = orthoSizeWidth * STATIC_CACHE_DEPTH_STEP;
+        const float halfExtentZ = fmaxf(_castLightViewBoundingBox.halfExtents.z, orthoSizeWidth * 0.5F);
+        _castLightViewBoundingBox.halfExtents.z = ceilf(halfExtentZ / step) * step + step;
+        _castLightViewBoundingBox.center.z = roundf(_castLightViewBoundingBox.center.z / step) * step;
+    }
+
     const float r = _castLightViewBoundingBox.getHalfExtents().z;
     _shadowCameraFar = r * 2.0F + invisibleOcclusionRange;
     const Vec3 &center = _castLightViewBoundingBox.getCenter();
@@ -125,6 +140,45 @@ void ShadowTransformInfo::createMatrix(const geometry::Frustum &splitFrustum, co
     _validFrustum.createOrtho(orthoSizeWidth, orthoSizeHeight, 0.1F, _shadowCameraFar, matShadowTrans);
 }
 
+void ShadowTransformInfo::updateStaticCache(bool enabled) {
+    if (!enabled) {
+        _staticCacheEnabled = false;
+        _staticFrustumDirty = true;
+        _staticRedrawPending = false;
+        _staticShadowObjects.clear();
+        return;
+    }
+
+    if (_staticCacheEnabled && !_staticFrustumDirty && _matShadowViewProj.approxEquals(_cachedMatShadowViewProj)) {
+        // keep the exact shadow camera the cached depth was rendered with
+        _shadowCameraFar = _cachedShadowCameraFar;
+        _matShadowView = _cachedMatShadowView;
+        _matShadowProj = _cachedMatShadowProj;
+        _matShadowViewProj = _cachedMatShadowViewProj;
+        geometry::Frustum::copy(&_validFrustum, _cachedValidFrustum);
+        return;
+    }
+
+    _staticCacheEnabled = true;
+    _staticFrustumDirty = true;
+    _cachedShadowCameraFar = _shadowCameraFar;
+    _cachedMatShadowView = _matShadowView;
+    _cachedMatShadowProj = _matShadowProj;
+    _cachedMatShadowViewProj = _matShadowViewProj;
+    geometry::Frustum::copy(&_cachedValidFrustum, _validFrustum);
+}
+
+void ShadowTransformInfo::setStaticCasterVersion(uint32_t staticCasterVersion) {
+    _staticCasterVersion = staticCasterVersion;
+    _staticFrustumDirty = false;
+    _staticRedrawPending = true;
+}
+
+void ShadowTransformInfo::markStaticRedrawn() {
+    _staticRedrawPending = false;
+    ++_staticRedrawCount;
+}
+
 void ShadowTransformInfo::copyToValidFrustum(const geometry::Frustum &validFrustum) {
     geometry::Frustum::copy(&_validFrustum, validFrustum);
 }
@@ -261,7 +315,10 @@ void CSMLayers::calculateCSM(const scene::Camera *camera, const scene::Direction
         const float nearClamp = layer->getSplitCameraNear();
         const float farClamp = layer->getSplitCameraFar();
         layer->calculateSplitFrustum(nearClamp, farClamp, camera->getAspect(), camera->getFov(), mat4Trans);
-        layer->createMatrix(layer->getSplitFrustum(), dirLight, shadowMapWidth, false);
+        const bool isStaticCached = dirLight->isCSMStaticCacheEnabled() && level != scene::CSMLevel::LEVEL_1 &&
+                                    static_cast<uint32_t>(i) >= CSM_STATIC_CACHE_MIN_LEVEL;
+        layer->createMatrix(layer->getSplitFrustum(), dirLight, shadowMapWidth, false, isStaticCached);
+        layer->updateStaticCache(isStaticCached);
     }
 
     if (level == scene::CSMLevel::LEVEL_1) {
@@ -276,6 +333,13 @@ void CSMLayers::calculateCSM(const scene::Camera *camera, const scene::Direction
     }
 }
 
+void CSMLayers::updateStaticCasters(ccstd::hash_t staticCasterHash, bool isStaticCasterChanged) {
+    if (isStaticCasterChanged || staticCasterHash != _staticCasterHash) {
+        _staticCasterHash = staticCasterHash;
+        ++_staticCasterVersion;
+    }
+}
+
 Mat4 CSMLayers::getCameraWorldMatrix(const scene::Camera *camera) {
     const Node *cameraNode = camera->getNode();
     const Vec3 &position = cameraNode->getWorldPosition();
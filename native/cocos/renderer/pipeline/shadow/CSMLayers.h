@@ -34,6 +34,9 @@ namespace cc {
 namespace pipeline {
 class PipelineSceneData;
 
+// The first cascade follows the camera too closely to be cached, farther cascades may keep their static casters.
+constexpr uint32_t CSM_STATIC_CACHE_MIN_LEVEL = 1U;
+
 class ShadowTransformInfo {
 public:
     explicit ShadowTransformInfo(uint32_t level);
@@ -66,7 +69,7 @@ public:
 
     inline const geometry::AABB &getCastLightViewBoundingBox() const { return _castLightViewBoundingBox; }
 
-    void createMatrix(const geometry::Frustum &splitFrustum, const scene::DirectionalLight *dirLight, float shadowMapWidth, bool isOnlyCulling);
+    void createMatrix(const geometry::Frustum &splitFrustum, const scene::DirectionalLight *dirLight, float shadowMapWidth, bool isOnlyCulling, bool isStableDepth = false);
 
     void copyToValidFrustum(const geometry::Frustum &validFrustum);
 
@@ -74,6 +77,22 @@ public:
 
     void calculateSplitFrustum(float start, float end, float aspect, float fov, const Mat4 &transform);
 
+    // static caster cache
+    inline bool isStaticCacheEnabled() const { return _staticCacheEnabled; }
+    inline bool isStaticCacheValid(uint32_t staticCasterVersion) const {
+        return _staticCacheEnabled && !_staticFrustumDirty && _staticCasterVersion == staticCasterVersion;
+    }
+    inline bool isStaticRedrawPending() const { return _staticRedrawPending; }
+    inline uint32_t getStaticRedrawCount() const { return _staticRedrawCount; }
+
+    inline const RenderObjectList &getStaticShadowObjects() const { return _staticShadowObjects; }
+    inline void addStaticShadowObject(RenderObject &&obj) { _staticShadowObjects.emplace_back(obj); }
+    inline void clearStaticShadowObjects() { _staticShadowObjects.clear(); }
+
+    void updateStaticCache(bool enabled);
+    void setStaticCasterVersion(uint32_t staticCasterVersion);
+    void markStaticRedrawn();
+
 private:
     // global set
     static float _maxLayerPosz;
@@ -95,6 +114,20 @@ private:
     geometry::AABB _castLightViewBoundingBox;
 
     RenderObjectList _shadowObjects;
+
+    // Static casters of a cached cascade are culled and rendered with the shadow camera below,
+    // which is kept as long as the new snapped shadow camera matches it.
+    bool _staticCacheEnabled{false};
+    bool _staticFrustumDirty{true};
+    bool _staticRedrawPending{false};
+    uint32_t _staticCasterVersion{0U};
+    uint32_t _staticRedrawCount{0U};
+    float _cachedShadowCameraFar{0.0F};
+    Mat4 _cachedMatShadowView;
+    Mat4 _cachedMatShadowProj;
+    Mat4 _cachedMatShadowViewProj;
+    geometry::Frustum _cachedValidFrustum;
+    RenderObjectList _staticShadowObjects;
 };
 
 class CSMLayerInfo : public ShadowTransformInfo {
@@ -140,6 +173,11 @@ public:
 
     inline ShadowTransformInfo *getSpecialLayer() const { return _specialLayer; }
 
+    // Bumped whenever the static casters of the scene change, see DirectionalLight::isCSMStaticCacheEnabled().
+    inline uint32_t getStaticCasterVersion() const { return _staticCasterVersion; }
+    void updateStaticCasters(ccstd::hash_t staticCasterHash, bool isStaticCasterChanged);
+    inline void invalidateStaticCasters() { ++_staticCasterVersion; }
+
 private:
     static Mat4 getCameraWorldMatrix(const scene::Camera *camera);
 
@@ -155,6 +193,9 @@ private:
 
     float _shadowDistance{0.0F};
 
+    ccstd::hash_t _staticCasterHash{0U};
+    uint32_t _staticCasterVersion{0U};
+
     ccstd::array<CSMLayerInfo *, 4> _layers{};
 
     RenderObjectList _castShadowObjects;
@@ -226,7 +226,7 @@ void ShadowFlow::resizeShadowMap(const scene::Light *light, gfx::DescriptorSet *
 
     auto *colorTexture = gfx::Device::getInstance()->createTexture({
         gfx::TextureType::TEX2D,
-        gfx::TextureUsageBit::COLOR_ATTACHMENT | gfx::TextureUsageBit::SAMPLED,
+        gfx::TextureUsageBit::COLOR_ATTACHMENT | gfx::TextureUsageBit::SAMPLED | gfx::TextureUsageBit::TRANSFER_DST,
         format,
         width,
         height,
@@ -253,7 +253,7 @@ void ShadowFlow::resizeShadowMap(const scene::Light *light, gfx::DescriptorSet *
 
     auto *depthStencilTexture = device->createTexture({
         gfx::TextureType::TEX2D,
-        gfx::TextureUsageBit::DEPTH_STENCIL_ATTACHMENT,
+        gfx::TextureUsageBit::DEPTH_STENCIL_ATTACHMENT | gfx::TextureUsageBit::TRANSFER_DST,
         gfx::Format::DEPTH,
         width,
         height,
@@ -320,7 +320,7 @@ void ShadowFlow::initShadowFrameBuffer(const RenderPipeline *pipeline, const sce
 
     auto *colorTexture = device->createTexture({
         gfx::TextureType::TEX2D,
-        gfx::TextureUsageBit::COLOR_ATTACHMENT | gfx::TextureUsageBit::SAMPLED,
+        gfx::TextureUsageBit::COLOR_ATTACHMENT | gfx::TextureUsageBit::SAMPLED | gfx::TextureUsageBit::TRANSFER_DST,
         format,
         width,
         height,
@@ -329,7 +329,7 @@ void ShadowFlow::initShadowFrameBuffer(const RenderPipeline *pipeline, const sce
 
     gfx::Texture *depthStencilTexture = device->createTexture({
         gfx::TextureType::TEX2D,
-        gfx::TextureUsageBit::DEPTH_STENCIL_ATTACHMENT | gfx::TextureUsageBit::SAMPLED,
+        gfx::TextureUsageBit::DEPTH_STENCIL_ATTACHMENT | gfx::TextureUsageBit::SAMPLED | gfx::TextureUsageBit::TRANSFER_DST,
         gfx::Format::DEPTH,
         width,
         height,
@@ -27,8 +27,11 @@
 #include "../PipelineSceneData.h"
 #include "../PipelineUBO.h"
 #include "../RenderPipeline.h"
+#include "../SceneCulling.h"
 #include "../ShadowMapBatchedQueue.h"
+#include "CSMLayers.h"
 #include "gfx-base/GFXCommandBuffer.h"
+#include "gfx-base/GFXDevice.h"
 #include "gfx-base/GFXFramebuffer.h"
 #include "math/Vec2.h"
 #include "profiler/Profiler.h"
@@ -41,6 +44,25 @@
 namespace cc {
 namespace pipeline {
 
+namespace {
+void reportStaticRedraws(uint32_t level, uint32_t count) {
+    switch (level) {
+        case 1:
+            CC_PROFILE_OBJECT_UPDATE(CSMCascade1StaticRedraws, count);
+            break;
+        case 2:
+            CC_PROFILE_OBJECT_UPDATE(CSMCascade2StaticRedraws, count);
+            break;
+        case 3:
+            CC_PROFILE_OBJECT_UPDATE(CSMCascade3StaticRedraws, count);
+            break;
+        default:
+            break;
+    }
+    CC_UNUSED_PARAM(count);
+}
+} // namespace
+
 ShadowStage::ShadowStage() = default;
 ShadowStage::~ShadowStage() = default;
 
@@ -87,7 +109,6 @@ void ShadowStage::render(scene::Camera *camera) {
 
     auto *cmdBuffer = _pipeline->getCommandBuffers()[0];
     _pipeline->getPipelineUBO()->updateShadowUBOLight(_globalDS, _light, _level);
-    _additiveShadowQueue->gatherLightPasses(camera, _light, cmdBuffer, _level);
 
     const Vec2 &shadowMapSize = shadowInfo->getSize();
     switch (_light->getType()) {
@@ -124,6 +145,17 @@ void ShadowStage::render(scene::Camera *camera) {
     }
 
     _clearColors[0] = {1.0F, 1.0F, 1.0F, 1.0F};
+    auto *cachedLayer = getStaticCachedLayer();
+    if (cachedLayer) {
+        renderStaticCached(camera, cachedLayer);
+        return;
+    }
+    if (_level < _staticCaches.size()) {
+        _staticCaches[_level].isShadowMapValid = false;
+    }
+
+    _additiveShadowQueue->gatherLightPasses(camera, _light, cmdBuffer, _level);
+
     auto *renderPass = _framebuffer->getRenderPass();
 
     cmdBuffer->beginRenderPass(renderPass, _framebuffer, _renderArea,
@@ -137,11 +169,176 @@ void ShadowStage::render(scene::Camera *camera) {
     _isShadowMapCleared = false;
 }
 
+ShadowTransformInfo *ShadowStage::getStaticCachedLayer() const {
+    if (_light->getType() != scene::LightType::DIRECTIONAL || _level >= _staticCaches.size()) {
+        return nullptr;
+    }
+
+    const auto *dirLight = static_cast<const scene::DirectionalLight *>(_light);
+    if (!dirLight->isCSMStaticCacheEnabled() || dirLight->isShadowFixedArea()) {
+        return nullptr;
+    }
+
+    auto *layer = _pipeline->getPipelineSceneData()->getCSMLayers()->getLayers()[_level];
+    return layer->isStaticCacheEnabled() ? layer : nullptr;
+}
+
+void ShadowStage::initStaticCache(StaticCascadeCache &cache) {
+    const auto format = _framebuffer->getColorTextures()[0]->getFormat();
+
+    if (!_staticCacheRenderPass || _staticCacheRenderPass->getColorAttachments()[0].format != format) {
+        // the cache is only ever read by copies into the shadow map
+        gfx::RenderPassInfo cacheInfo;
+        cacheInfo.colorAttachments.push_back({
+            format,
+            gfx::SampleCount::X1,
+            gfx::LoadOp::CLEAR,
+            gfx::StoreOp::STORE,
+            _device->getGeneralBarrier({
+                gfx::AccessFlagBit::TRANSFER_READ,
+                gfx::AccessFlagBit::TRANSFER_READ,
+            }),
+        });
+        cacheInfo.depthStencilAttachment = {
+            gfx::Format::DEPTH,
+            gfx::SampleCount::X1,
+            gfx::LoadOp::CLEAR,
+            gfx::StoreOp::STORE,
+            gfx::LoadOp::CLEAR,
+            gfx::StoreOp::DISCARD,
+            _device->getGeneralBarrier({
+                gfx::AccessFlagBit::TRANSFER_READ,
+                gfx::AccessFlagBit::TRANSFER_READ,
+            }),
+        };
+        _staticCacheRenderPass = _device->createRenderPass(cacheInfo);
+
+        // dynamic casters are drawn over the copied static casters
+        gfx::RenderPassInfo loadInfo;
+        loadInfo.colorAttachments.push_back({
+            format,
+            gfx::SampleCount::X1,
+            gfx::LoadOp::LOAD,
+            gfx::StoreOp::STORE,
+            _device->getGeneralBarrier({
+                gfx::AccessFlagBit::TRANSFER_WRITE,
+                gfx::AccessFlagBit::FRAGMENT_SHADER_READ_TEXTURE,
+            }),
+        });
+        loadInfo.depthStencilAttachment = {
+            gfx::Format::DEPTH,
+            gfx::SampleCount::X1,
+            gfx::LoadOp::LOAD,
+            gfx::StoreOp::DISCARD,
+            gfx::LoadOp::DISCARD,
+            gfx::StoreOp::DISCARD,
+            _device->getGeneralBarrier({
+                gfx::AccessFlagBit::TRANSFER_WRITE,
+                gfx::AccessFlagBit::DEPTH_STENCIL_ATTACHMENT_WRITE,
+            }),
+        };
+        _staticLoadRenderPass = _device->createRenderPass(loadInfo);
+
+        for (auto &other : _staticCaches) {
+            other.framebuffer = nullptr;
+        }
+    }
+
+    cache.colorTexture = _device->createTexture({
+        gfx::TextureType::TEX2D,
+        gfx::TextureUsageBit::COLOR_ATTACHMENT | gfx::TextureUsageBit::TRANSFER_SRC,
+        format,
+        _renderArea.width,
+        _renderArea.height,
+    });
+    cache.depthStencilTexture = _device->createTexture({
+        gfx::TextureType::TEX2D,
+        gfx::TextureUsageBit::DEPTH_STENCIL_ATTACHMENT | gfx::TextureUsageBit::TRANSFER_SRC,
+        gfx::Format::DEPTH,
+        _renderArea.width,
+        _renderArea.height,
+    });
+    cache.framebuffer = _device->createFramebuffer({
+        _staticCacheRenderPass,
+        {cache.colorTexture},
+        cache.depthStencilTexture,
+    });
+    cache.shadowMap = nullptr;
+    cache.isShadowMapValid = false;
+}
+
+void ShadowStage::renderStaticCached(scene::Camera *camera, ShadowTransformInfo *layer) {
+    auto *cmdBuffer = _pipeline->getCommandBuffers()[0];
+    auto &cache = _staticCaches[_level];
+
+    if (camera->isCullingEnabled()) {
+        shadowCulling(_pipeline, camera, layer);
+    }
+
+    const bool isCacheOutdated = !cache.framebuffer ||
+                                 cache.colorTexture->getWidth() != _renderArea.width ||
+                                 cache.colorTexture->getHeight() != _renderArea.height ||
+                                 cache.colorTexture->getFormat() != _framebuffer->getColorTextures()[0]->getFormat();
+    if (isCacheOutdated) {
+        initStaticCache(cache);
+    }
+
+    const ccstd::array<uint32_t, 1> globalOffsets = {_pipeline->getPipelineUBO()->getCurrentCameraUBOOffset()};
+    if (isCacheOutdated || layer->isStaticRedrawPending()) {
+        _additiveShadowQueue->gatherShadowObjects(layer->getStaticShadowObjects(), cmdBuffer);
+
+        const gfx::Rect cacheArea{0, 0, _renderArea.width, _renderArea.height};
+        cmdBuffer->beginRenderPass(_staticCacheRenderPass, cache.framebuffer, cacheArea,
+                                   _clearColors, camera->getClearDepth(), camera->getClearStencil());
+        cmdBuffer->bindDescriptorSet(globalSet, _globalDS, utils::toUint(globalOffsets.size()), globalOffsets.data());
+        _additiveShadowQueue->recordCommandBuffer(_device, _staticCacheRenderPass, cmdBuffer);
+        cmdBuffer->endRenderPass();
+
+        layer->markStaticRedrawn();
+        cache.isShadowMapValid = false;
+    }
+    reportStaticRedraws(_level, layer->getStaticRedrawCount());
+
+    // no dynamic caster drawn over the static casters since the last copy, nothing to do
+    gfx::Texture *shadowMap = _framebuffer->getColorTextures()[0];
+    const RenderObjectList &dynamicObjects = layer->getShadowObjects();
+    if (cache.isShadowMapValid && cache.shadowMap == shadowMap && dynamicObjects.empty()) {
+        return;
+    }
+
+    gfx::TextureCopy region;
+    region.dstOffset = {_renderArea.x, _renderArea.y, 0};
+    region.extent = {_renderArea.width, _renderArea.height, 1};
+    cmdBuffer->copyTexture(cache.colorTexture, shadowMap, &region, 1);
+    cache.shadowMap = shadowMap;
+    cache.isShadowMapValid = dynamicObjects.empty();
+    _isShadowMapCleared = false;
+
+    if (dynamicObjects.empty()) {
+        return;
+    }
+
+    cmdBuffer->copyTexture(cache.depthStencilTexture, _framebuffer->getDepthStencilTexture(), &region, 1);
+    _additiveShadowQueue->gatherShadowObjects(dynamicObjects, cmdBuffer);
+
+    cmdBuffer->beginRenderPass(_staticLoadRenderPass, _framebuffer, _renderArea,
+                               _clearColors, camera->getClearDepth(), camera->getClearStencil());
+    cmdBuffer->bindDescriptorSet(globalSet, _globalDS, utils::toUint(globalOffsets.size()), globalOffsets.data());
+    _additiveShadowQueue->recordCommandBuffer(_device, _staticLoadRenderPass, cmdBuffer);
+    cmdBuffer->endRenderPass();
+}
+
 void ShadowStage::destroy() {
     _framebuffer = nullptr;
     _globalDS = nullptr;
     _light = nullptr;
 
+    for (auto &cache : _staticCaches) {
+        cache = {};
+    }
+    _staticCacheRenderPass = nullptr;
+    _staticLoadRenderPass = nullptr;
+
     CC_SAFE_DESTROY_AND_DELETE(_additiveShadowQueue);
 
     RenderStage::destroy();
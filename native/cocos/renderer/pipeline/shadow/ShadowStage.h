@@ -24,11 +24,17 @@
 
 #pragma once
 #include "../RenderStage.h"
+#include "base/Ptr.h"
+#include "base/std/container/array.h"
+#include "gfx-base/GFXFramebuffer.h"
+#include "gfx-base/GFXRenderPass.h"
+#include "gfx-base/GFXTexture.h"
 
 namespace cc {
 namespace pipeline {
 class RenderQueue;
 class ShadowMapBatchedQueue;
+class ShadowTransformInfo;
 
 class CC_DLL ShadowStage : public RenderStage {
 public:
@@ -53,6 +59,21 @@ public:
     void clearFramebuffer(const scene::Camera *camera);
 
 private:
+    // static casters of a cached cascade, copied into the shadow map before the dynamic casters are drawn
+    struct StaticCascadeCache {
+        IntrusivePtr<gfx::Texture> colorTexture;
+        IntrusivePtr<gfx::Texture> depthStencilTexture;
+        IntrusivePtr<gfx::Framebuffer> framebuffer;
+        // weak reference, shadow map the cache was last copied to
+        const gfx::Texture *shadowMap{nullptr};
+        // the shadow map region holds nothing but the cached static casters
+        bool isShadowMapValid{false};
+    };
+
+    ShadowTransformInfo *getStaticCachedLayer() const;
+    void initStaticCache(StaticCascadeCache &cache);
+    void renderStaticCached(scene::Camera *camera, ShadowTransformInfo *layer);
+
     static RenderStageInfo initInfo;
 
     bool _isShadowMapCleared{false};
@@ -65,6 +86,10 @@ private:
     ShadowMapBatchedQueue *_additiveShadowQueue{nullptr};
 
     gfx::Rect _renderArea;
+
+    ccstd::array<StaticCascadeCache, 4> _staticCaches;
+    IntrusivePtr<gfx::RenderPass> _staticCacheRenderPass;
+    IntrusivePtr<gfx::RenderPass> _staticLoadRenderPass;
 };
 
 } // namespace pipeline
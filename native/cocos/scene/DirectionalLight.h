@@ -72,6 +72,7 @@ public:
         activate();
     }
     inline void setCSMTransitionRange(bool csmTransitionRange) { _csmTransitionRange = csmTransitionRange; }
+    inline void setCSMStaticCacheEnabled(bool enabled) { _csmStaticCacheEnabled = enabled; }
 
     inline bool isShadowEnabled() const { return _shadowEnabled; }
     inline PCFType getShadowPcf() const { return _shadowPcf; }
@@ -88,6 +89,8 @@ public:
     inline float getShadowNear() const { return _shadowNear; }
     inline float getShadowFar() const { return _shadowFar; }
     inline float getShadowOrthoSize() const { return _shadowOrthoSize; }
+    // Far cascades only re-render static casters when the light, the snapped cascade frustum or a static caster changes.
+    inline bool isCSMStaticCacheEnabled() const { return _csmStaticCacheEnabled; }
 
     inline const Vec3 &getDirection() const { return _dir; }
     inline void setDirection(const Vec3 &dir) { _dir = dir; }
@@ -107,6 +110,7 @@ private:
     bool _isCSMNeedUpdate{false};
     bool _shadowFixedArea{false};
     bool _csmLayersTransition{false};
+    bool _csmStaticCacheEnabled{false};
 
     PCFType _shadowPcf{PCFType::HARD};
     CSMLevel _csmLevel{CSMLevel::LEVEL_3};
@@ -42,17 +42,21 @@ LODGroup::LODGroup() = default;
 LODGroup::~LODGroup() = default;
 
 int8_t LODGroup::getVisibleLODLevel(const Camera *camera) const {
-    float screenUsagePercentage = getScreenUsagePercentage(camera);
-
-    int8_t lodIndex = -1;
-    for (auto i = 0; i < _vecLODData.size(); ++i) {
-        const auto &lod = _vecLODData[i];
-        if (screenUsagePercentage >= lod->getScreenUsagePercentage()) {
-            lodIndex = i;
-            break;
+    return selectLODLevel(getScreenUsagePercentage(camera), -1, 0.F);
+}
+
+int8_t LODGroup::selectLODLevel(float screenUsagePercentage, int8_t currentLevel, float hysteresis) const {
+    const auto count = static_cast<int8_t>(_vecLODData.size());
+    // -1 means culled, which is coarser than any level
+    const int8_t current = currentLevel < 0 ? count : currentLevel;
+    for (int8_t i = 0; i < count; ++i) {
+        float threshold = _vecLODData[i]->getScreenUsagePercentage();
+        threshold *= i < current ? 1.F + hysteresis : 1.F - hysteresis;
+        if (screenUsagePercentage >= threshold) {
+            return i;
         }
     }
-    return lodIndex;
+    return -1;
 }
 
 float LODGroup::getScreenUsagePercentage(const Camera *camera) const {
@@ -82,6 +82,29 @@ public:
 
     int8_t getVisibleLODLevel(const Camera *camera) const;
 
+    /**
+     * @en Select the LOD level for a screen usage percentage. The thresholds of levels finer than currentLevel are scaled by
+     * (1 + hysteresis) and the others by (1 - hysteresis), so the current level is kept until the usage leaves its band.
+     * @zh 根据屏占比选择 LOD 层级，当前层级附近的阈值按 hysteresis 放宽，避免在阈值附近来回切换。
+     */
+    int8_t selectLODLevel(float screenUsagePercentage, int8_t currentLevel, float hysteresis) const;
+
+    /**
+     * @en Relative width of the band around the screen usage thresholds in which the current level is kept, 0 disables it.
+     * @zh 屏占比阈值的滞后范围（相对值），0 表示不使用。
+     */
+    inline float getHysteresis() const { return _hysteresis; }
+    inline void setHysteresis(float val) { _hysteresis = val; }
+
+    /**
+     * @en Time in seconds during which the previous level stays visible after a level change, 0 disables cross-fading.
+     * @zh 切换层级后上一层级继续可见的时间（秒），0 表示不做淡入淡出。
+     */
+    inline float getCrossFadeDuration() const { return _crossFadeDuration; }
+    inline void setCrossFadeDuration(float val) { _crossFadeDuration = val; }
+
+    float getWorldSpaceSize() const;
+
     inline const ccstd::vector<uint8_t> &getLockedLODLevels() const { return _vecLockedLevels; }
     void lockLODLevels(ccstd::vector<int> &levels);
     inline bool isLockLevelChanged() const { return _isLockLevelChanged; }
@@ -96,7 +119,6 @@ public:
 private:
     float getScreenUsagePercentage(const Camera *camera) const;
     static float distanceToScreenUsagePercentage(const Camera *camera, float distance, float size);
-    float getWorldSpaceSize() const;
 
     ccstd::vector<IntrusivePtr<LODData>> _vecLODData;
     ccstd::vector<uint8_t> _vecLockedLevels;
@@ -104,6 +126,8 @@ private:
     RenderScene *_scene{nullptr};
     Vec3 _localBoundaryCenter;
     float _objectSize{1.F};
+    float _hysteresis{0.F};
+    float _crossFadeDuration{0.F};
     bool _enabled{true};
     bool _isLockLevelChanged{false};
 
@@ -0,0 +1,101 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "scene/LODVisibility.h"
+#include <algorithm>
+#include <utility>
+#include "base/Macros.h"
+
+namespace cc {
+namespace scene {
+
+uint32_t LODVisibility::addCamera() {
+    _masks.resize(static_cast<size_t>(_cameraCount + 1) * _wordCount, 0U);
+    return _cameraCount++;
+}
+
+void LODVisibility::removeCamera(uint32_t camera) {
+    CC_ASSERT(camera < _cameraCount);
+    const uint32_t last = _cameraCount - 1;
+    if (camera != last) {
+        std::copy_n(_masks.begin() + last * _wordCount, _wordCount, _masks.begin() + camera * _wordCount);
+    }
+    _masks.resize(static_cast<size_t>(last) * _wordCount);
+    _cameraCount = last;
+}
+
+uint32_t LODVisibility::addModel() {
+    if (!_freeModels.empty()) {
+        const uint32_t model = _freeModels.back();
+        _freeModels.pop_back();
+        return model;
+    }
+    reserveModels(_modelCount + 1);
+    return _modelCount++;
+}
+
+void LODVisibility::removeModel(uint32_t model) {
+    CC_ASSERT(model < _modelCount);
+    // the index is reused invisible
+    setVisibleForAll(model, false);
+    _freeModels.emplace_back(model);
+}
+
+void LODVisibility::setVisible(uint32_t camera, uint32_t model, bool visible) {
+    auto &word = _masks[camera * _wordCount + (model >> 6)];
+    const uint64_t bit = uint64_t{1} << (model & 63U);
+    word = visible ? (word | bit) : (word & ~bit);
+}
+
+void LODVisibility::setVisibleForAll(uint32_t model, bool visible) {
+    for (uint32_t camera = 0; camera < _cameraCount; ++camera) {
+        setVisible(camera, model, visible);
+    }
+}
+
+void LODVisibility::clear() {
+    _masks.clear();
+    _freeModels.clear();
+    _wordCount = 0;
+    _cameraCount = 0;
+    _modelCount = 0;
+}
+
+void LODVisibility::reserveModels(uint32_t count) {
+    const uint32_t wordCount = (count + 63) >> 6;
+    if (wordCount <= _wordCount) {
+        return;
+    }
+    // grow geometrically, every camera row moves when the row length changes
+    const uint32_t newWordCount = std::max(wordCount, _wordCount * 2);
+    ccstd::vector<uint64_t> masks(static_cast<size_t>(_cameraCount) * newWordCount, 0U);
+    for (uint32_t camera = 0; camera < _cameraCount; ++camera) {
+        std::copy_n(_masks.begin() + camera * _wordCount, _wordCount, masks.begin() + camera * newWordCount);
+    }
+    _masks = std::move(masks);
+    _wordCount = newWordCount;
+}
+
+} // namespace scene
+} // namespace cc
@@ -0,0 +1,76 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include "base/std/container/vector.h"
+
+namespace cc {
+namespace scene {
+
+/**
+ * @en The cameras which see the models used by LOD groups, stored as one bitset of model indices per camera.
+ * Cameras and models get dense indices: removing a camera moves the last camera into its index,
+ * removed model indices are reused by the next added models.
+ * @zh LOD 组所用模型的可见相机，以每个相机一组模型索引位集的形式存储。相机与模型使用连续索引：
+ * 移除相机时最后一个相机移到它的位置，移除的模型索引会被之后添加的模型复用。
+ */
+class LODVisibility final {
+public:
+    static constexpr uint32_t INVALID_INDEX{0xFFFFFFFF};
+
+    uint32_t addCamera();
+    void removeCamera(uint32_t camera);
+
+    /**
+     * @en Adds a model which is invisible for all cameras.
+     * @zh 添加一个对所有相机都不可见的模型。
+     */
+    uint32_t addModel();
+    void removeModel(uint32_t model);
+
+    void setVisible(uint32_t camera, uint32_t model, bool visible);
+    void setVisibleForAll(uint32_t model, bool visible);
+    inline bool isVisible(uint32_t camera, uint32_t model) const {
+        return (_masks[camera * _wordCount + (model >> 6)] >> (model & 63U)) & 1U;
+    }
+
+    void clear();
+
+    inline uint32_t getCameraCount() const { return _cameraCount; }
+
+private:
+    void reserveModels(uint32_t count);
+
+    // _wordCount words per camera
+    ccstd::vector<uint64_t> _masks;
+    ccstd::vector<uint32_t> _freeModels;
+    uint32_t _wordCount{0};
+    uint32_t _cameraCount{0};
+    uint32_t _modelCount{0};
+};
+
+} // namespace scene
+} // namespace cc
@@ -21,6 +21,7 @@
  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  THE SOFTWARE.
 ****************************************************************************/
+#include <cstring>
 #include "base/std/container/array.h"
 
 // #include "core/Director.h"
@@ -74,6 +75,8 @@ const ccstd::vector<cc::scene::IMacroPatch> HIGHP_LIGHTMAP_PATHES{{"CC_LIGHT_MAP
 namespace cc {
 namespace scene {
 
+CC_SLAB_ALLOCATOR_IMPL(Model, 128)
+
 Model::Model() {
     _device = Root::getInstance()->getDevice();
 }
@@ -101,10 +104,13 @@ void Model::destroy() {
     CC_SAFE_DESTROY_NULL(_localSHBuffer);
     CC_SAFE_DESTROY_NULL(_worldBoundBuffer);
 
+    _pooledLocalBufferSlot = INVALID_LOCAL_BUFFER_SLOT;
+
     _worldBounds = nullptr;
     _modelBounds = nullptr;
     _inited = false;
     _localDataUpdated = true;
+    setTransformTracking(false);
     _transform = nullptr;
     _node = nullptr;
     _isDynamicBatching = false;
@@ -187,65 +193,149 @@ void Model::updateUBOs(uint32_t stamp) {
     _localDataUpdated = false;
     getTransform()->updateWorldTransform();
     const auto &worldMatrix = getTransform()->getWorldMatrix();
+    const bool hasNonInstancingPass = updateInstancedWorldMatrices(worldMatrix);
+
+    if ((hasNonInstancingPass || forceUpdateUBO) && _localBuffer) {
+        fillLocalData(worldMatrix, [this](const auto &value, uint32_t offset) {
+            _localBuffer->write(value, sizeof(float) * offset);
+        });
+        _localBuffer->update();
+        const bool enableOcclusionQuery = Root::getInstance()->getPipeline()->isOcclusionQueryEnabled();
+        if (enableOcclusionQuery) {
+            updateWorldBoundUBOs();
+        }
+    }
+}
+
+bool Model::updateInstancedWorldMatrices(const Mat4 &worldMatrix) {
     bool hasNonInstancingPass = false;
     for (const auto &subModel : _subModels) {
         const auto idx = subModel->getInstancedWorldMatrixIndex();
         if (idx >= 0) {
-            ccstd::vector<TypedArray> &attrs = subModel->getInstancedAttributeBlock().views;
             subModel->updateInstancedWorldMatrix(worldMatrix, idx);
         } else {
             hasNonInstancingPass = true;
         }
     }
+    return hasNonInstancingPass;
+}
 
-    if ((hasNonInstancingPass || forceUpdateUBO) && _localBuffer) {
-        Mat4 mat4;
-        Mat4::inverseTranspose(worldMatrix, &mat4);
-
-        _localBuffer->write(worldMatrix, sizeof(float) * pipeline::UBOLocal::MAT_WORLD_OFFSET);
-        _localBuffer->write(mat4, sizeof(float) * pipeline::UBOLocal::MAT_WORLD_IT_OFFSET);
-        _localBuffer->write(_lightmapUVParam, sizeof(float) * pipeline::UBOLocal::LIGHTINGMAP_UVPARAM);
-        _localBuffer->write(_shadowBias, sizeof(float) * (pipeline::UBOLocal::LOCAL_SHADOW_BIAS));
-
-        auto *probe = scene::ReflectionProbeManager::getInstance()->getReflectionProbeById(_reflectionProbeId);
-        auto *blendProbe = scene::ReflectionProbeManager::getInstance()->getReflectionProbeById(_reflectionProbeBlendId);
-        if (probe) {
-            if (probe->getProbeType() == scene::ReflectionProbe::ProbeType::PLANAR) {
-                const Vec4 plane = {probe->getNode()->getUp().x, probe->getNode()->getUp().y, probe->getNode()->getUp().z, 1.F};
-                _localBuffer->write(plane, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_DATA1));
-                const Vec4 depthScale = {1.F, 0.F, 0.F, 1.F};
-                _localBuffer->write(depthScale, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_DATA2));
-            } else {
-                uint16_t mipAndUseRGBE = probe->isRGBE() ? 1000 : 0;
-                const Vec4 pos = {probe->getNode()->getWorldPosition().x, probe->getNode()->getWorldPosition().y, probe->getNode()->getWorldPosition().z, 0.F};
-                _localBuffer->write(pos, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_DATA1));
-                const Vec4 boxSize = {probe->getBoudingSize().x, probe->getBoudingSize().y, probe->getBoudingSize().z, static_cast<float>(probe->getCubeMap() ? probe->getCubeMap()->mipmapLevel() + mipAndUseRGBE : 1 + mipAndUseRGBE)};
-                _localBuffer->write(boxSize, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_DATA2));
-            }
-            if (_reflectionProbeType == scene::UseReflectionProbeType::BLEND_PROBES ||
-                _reflectionProbeType == scene::UseReflectionProbeType::BLEND_PROBES_AND_SKYBOX) {
-                if (blendProbe) {
-                    uint16_t mipAndUseRGBE = blendProbe->isRGBE() ? 1000 : 0;
-                    const Vec3 worldPos = blendProbe->getNode()->getWorldPosition();
-                    Vec3 boudingBox = blendProbe->getBoudingSize();
-                    const Vec4 pos = {worldPos.x, worldPos.y, worldPos.z, _reflectionProbeBlendWeight};
-                    _localBuffer->write(pos, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_BLEND_DATA1));
-                    const Vec4 boxSize = {boudingBox.x, boudingBox.y, boudingBox.z, static_cast<float>(blendProbe->getCubeMap() ? blendProbe->getCubeMap()->mipmapLevel() + mipAndUseRGBE : 1 + mipAndUseRGBE)};
-                    _localBuffer->write(boxSize, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_BLEND_DATA2));
-                } else if (_reflectionProbeType == scene::UseReflectionProbeType::BLEND_PROBES_AND_SKYBOX) {
-                    // blend with skybox
-                    const Vec4 pos = {0.F, 0.F, 0.F, _reflectionProbeBlendWeight};
-                    _localBuffer->write(pos, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_BLEND_DATA1));
-                }
+template <typename Writer>
+void Model::fillLocalData(const Mat4 &worldMatrix, const Writer &write) const {
+    Mat4 mat4;
+    Mat4::inverseTranspose(worldMatrix, &mat4);
+
+    write(worldMatrix, pipeline::UBOLocal::MAT_WORLD_OFFSET);
+    write(mat4, pipeline::UBOLocal::MAT_WORLD_IT_OFFSET);
+    write(_lightmapUVParam, pipeline::UBOLocal::LIGHTINGMAP_UVPARAM);
+    write(_shadowBias, pipeline::UBOLocal::LOCAL_SHADOW_BIAS);
+
+    auto *probe = scene::ReflectionProbeManager::getInstance()->getReflectionProbeById(_reflectionProbeId);
+    auto *blendProbe = scene::ReflectionProbeManager::getInstance()->getReflectionProbeById(_reflectionProbeBlendId);
+    if (probe) {
+        if (probe->getProbeType() == scene::ReflectionProbe::ProbeType::PLANAR) {
+            const Vec4 plane = {probe->getNode()->getUp().x, probe->getNode()->getUp().y, probe->getNode()->getUp().z, 1.F};
+            write(plane, pipeline::UBOLocal::REFLECTION_PROBE_DATA1);
+            const Vec4 depthScale = {1.F, 0.F, 0.F, 1.F};
+            write(depthScale, pipeline::UBOLocal::REFLECTION_PROBE_DATA2);
+        } else {
+            uint16_t mipAndUseRGBE = probe->isRGBE() ? 1000 : 0;
+            const Vec4 pos = {probe->getNode()->getWorldPosition().x, probe->getNode()->getWorldPosition().y, probe->getNode()->getWorldPosition().z, 0.F};
+            write(pos, pipeline::UBOLocal::REFLECTION_PROBE_DATA1);
+            const Vec4 boxSize = {probe->getBoudingSize().x, probe->getBoudingSize().y, probe->getBoudingSize().z, static_cast<float>(probe->getCubeMap() ? probe->getCubeMap()->mipmapLevel() + mipAndUseRGBE : 1 + mipAndUseRGBE)};
+            write(boxSize, pipeline::UBOLocal::REFLECTION_PROBE_DATA2);
+        }
+        if (_reflectionProbeType == scene::UseReflectionProbeType::BLEND_PROBES ||
+            _reflectionProbeType == scene::UseReflectionProbeType::BLEND_PROBES_AND_SKYBOX) {
+            if (blendProbe) {
+                uint16_t mipAndUseRGBE = blendProbe->isRGBE() ? 1000 : 0;
+                const Vec3 worldPos = blendProbe->getNode()->getWorldPosition();
+                Vec3 boudingBox = blendProbe->getBoudingSize();
+                const Vec4 pos = {worldPos.x, worldPos.y, worldPos.z, _reflectionProbeBlendWeight};
+                write(pos, pipeline::UBOLocal::REFLECTION_PROBE_BLEND_DATA1);
+                const Vec4 boxSize = {boudingBox.x, boudingBox.y, boudingBox.z, static_cast<float>(blendProbe->getCubeMap() ? blendProbe->getCubeMap()->mipmapLevel() + mipAndUseRGBE : 1 + mipAndUseRGBE)};
+                write(boxSize, pipeline::UBOLocal::REFLECTION_PROBE_BLEND_DATA2);
+            } else if (_reflectionProbeType == scene::UseReflectionProbeType::BLEND_PROBES_AND_SKYBOX) {
+                // blend with skybox
+                const Vec4 pos = {0.F, 0.F, 0.F, _reflectionProbeBlendWeight};
+                write(pos, pipeline::UBOLocal::REFLECTION_PROBE_BLEND_DATA1);
             }
         }
+    }
+}
 
-        _localBuffer->update();
-        const bool enableOcclusionQuery = Root::getInstance()->getPipeline()->isOcclusionQueryEnabled();
-        if (enableOcclusionQuery) {
-            updateWorldBoundUBOs();
+void Model::setTransform(Node *node) {
+    if (_transformTracking) {
+        setTransformTracking(false);
+        _transform = node;
+        setTransformTracking(true);
+        _localDataUpdated = true;
+    } else {
+        _transform = node;
+    }
+}
+
+void Model::setTransformTracking(bool enabled) {
+    if (_transformTracking && _transform) {
+        _transform->off(_transformInvalidatedId);
+    }
+    _transformTracking = enabled;
+    if (enabled && _transform) {
+        _transformInvalidatedId = _transform->on<Node::TransformInvalidated>([this](Node * /*emitter*/) {
+            _localDataUpdated = true;
+        });
+    }
+}
+
+bool Model::prepareLocalData() {
+    Node *node = _transform;
+    const bool transformChanged = node->getChangedFlags() || node->isTransformDirty();
+    node->updateWorldTransform();
+
+    // the probe nodes are read by computeLocalData on the job workers, resolve their lazy world transform here
+    for (const auto probeId : {_reflectionProbeId, _reflectionProbeBlendId}) {
+        auto *probe = scene::ReflectionProbeManager::getInstance()->getReflectionProbeById(probeId);
+        if (probe && probe->getNode()) {
+            probe->getNode()->updateWorldTransform();
         }
     }
+    return transformChanged;
+}
+
+void Model::computeLocalData(bool transformChanged, uint8_t *localData) {
+    _localDataUpdated = false;
+    const auto &worldMatrix = _transform->getWorldMatrix();
+    if (transformChanged && _modelBounds != nullptr && _modelBounds->isValid() && _worldBounds != nullptr) {
+        _modelBounds->transform(worldMatrix, _worldBounds);
+        _worldBoundsDirty = true;
+    }
+    updateInstancedWorldMatrices(worldMatrix);
+    fillLocalData(worldMatrix, [localData](const auto &value, uint32_t offset) {
+        memcpy(localData + sizeof(float) * offset, &value, sizeof(value));
+    });
+}
+
+void Model::flushLocalData(uint32_t stamp) {
+    _updateStamp = stamp;
+    updateSHUBOs();
+    const auto *pipeline = Root::getInstance()->getPipeline();
+    if (pipeline && pipeline->isOcclusionQueryEnabled()) {
+        updateWorldBoundUBOs();
+    }
+    updateOctree();
+}
+
+void Model::setPooledLocalBuffer(gfx::Buffer *view, uint32_t slot) {
+    CC_SAFE_DESTROY_NULL(_localBuffer);
+    _pooledLocalBufferSlot = view ? slot : INVALID_LOCAL_BUFFER_SLOT;
+    _localBuffer = view;
+    if (!_localBuffer && !_subModels.empty()) {
+        initLocalDescriptors(0);
+    }
+    for (index_t i = 0; i < static_cast<index_t>(_subModels.size()); ++i) {
+        updateLocalDescriptors(i, _subModels[i]->getDescriptorSet());
+    }
+    _localDataUpdated = true;
 }
 
 void Model::updateOctree() {
@@ -255,6 +345,39 @@ void Model::updateOctree() {
     }
 }
 
+void Model::setClusterCulling(bool enabled) {
+    _clusterCulling = enabled;
+    if (!enabled) {
+        for (const auto &subModel : _subModels) {
+            subModel->setClusterCulling(false);
+        }
+    }
+}
+
+void Model::cullClusters(const ccstd::vector<MeshletCullingView> &views) {
+    const bool active = _clusterCulling && !_castShadow && _transform;
+    for (const auto &subModel : _subModels) {
+        if (subModel->isClusterCullingEnabled() != active) {
+            subModel->setClusterCulling(active);
+        }
+        if (subModel->isClusterCullingEnabled()) {
+            subModel->cullClusters(_transform->getWorldMatrix(), views.data(), static_cast<uint32_t>(views.size()));
+        }
+    }
+}
+
+MeshletCullingStats Model::getClusterCullingStats() const {
+    MeshletCullingStats stats;
+    for (const auto &subModel : _subModels) {
+        const auto &subModelStats = subModel->getClusterCullingStats();
+        stats.meshletCount += subModelStats.meshletCount;
+        stats.visibleMeshlets += subModelStats.visibleMeshlets;
+        stats.triangleCount += subModelStats.triangleCount;
+        stats.culledTriangles += subModelStats.culledTriangles;
+    }
+    return stats;
+}
+
 void Model::updateWorldBoundUBOs() {
     if (_worldBoundBuffer) {
         const Vec3 &center = _worldBounds ? _worldBounds->getCenter() : Vec3{0.0F, 0.0F, 0.0F};
@@ -413,25 +536,41 @@ void Model::clearSHUBOs() {
 }
 
 void Model::updateSHUBOs() {
+    if (needUpdateSHUBOs()) {
+        ccstd::vector<Vec3> coefficients;
+        const auto *pipeline = Root::getInstance()->getPipeline();
+        updateSHUBOData(pipeline->getPipelineSceneData()->getLightProbes(), coefficients);
+    }
+
+    if (_localSHDataDirty) {
+        _localSHDataDirty = false;
+        updateSHBuffer();
+    }
+}
+
+bool Model::needUpdateSHUBOs() const {
     if (!isLightProbeAvailable()) {
-        return;
+        return false;
     }
 
-    const auto center = _worldBounds->getCenter();
 #if !CC_EDITOR
-    if (center.approxEquals(_lastWorldBoundCenter, math::EPSILON)) {
-        return;
+    if (_worldBounds->getCenter().approxEquals(_lastWorldBoundCenter, math::EPSILON)) {
+        return false;
     }
 #endif
 
-    ccstd::vector<Vec3> coefficients;
+    return true;
+}
+
+void Model::updateSHUBOData(const gi::LightProbes *lightProbes, ccstd::vector<Vec3> &coefficients) {
+    const auto center = _worldBounds->getCenter();
+    const auto *data = lightProbes->getData();
     Vec4 weights(0.0F, 0.0F, 0.0F, 0.0F);
-    const auto *pipeline = Root::getInstance()->getPipeline();
-    const auto *lightProbes = pipeline->getPipelineSceneData()->getLightProbes();
 
+    const auto startIndex = data->getStartTetrahedronIndex(center, _lastWorldBoundCenter, _tetrahedronIndex);
     _lastWorldBoundCenter.set(center);
-    _tetrahedronIndex = lightProbes->getData()->getInterpolationWeights(center, _tetrahedronIndex, weights);
-    bool result = lightProbes->getData()->getInterpolationSHCoefficients(_tetrahedronIndex, weights, coefficients);
+    _tetrahedronIndex = data->getInterpolationWeights(center, startIndex, weights);
+    bool result = data->getInterpolationSHCoefficients(_tetrahedronIndex, weights, coefficients);
     if (!result) {
         return;
     }
@@ -442,7 +581,7 @@ void Model::updateSHUBOs() {
 
     gi::SH::reduceRinging(coefficients, lightProbes->getReduceRinging());
     gi::SH::updateUBOData(_localSHData, pipeline::UBOSH::SH_LINEAR_CONST_R_OFFSET, coefficients);
-    updateSHBuffer();
+    _localSHDataDirty = true;
 }
 
 ccstd::vector<IMacroPatch> Model::getMacroPatches(index_t subModelIndex) {
@@ -35,6 +35,7 @@
 #include "core/builtin/BuiltinResMgr.h"
 #include "core/event/EventTarget.h"
 #include "core/geometry/AABB.h"
+#include "core/memop/SlabAllocator.h"
 #include "core/scene-graph/Layers.h"
 #include "core/scene-graph/Node.h"
 #include "renderer/gfx-base/GFXBuffer.h"
@@ -46,6 +47,10 @@ namespace cc {
 
 class Material;
 
+namespace gi {
+class LightProbes;
+} // namespace gi
+
 namespace scene {
 
 /**
@@ -90,6 +95,8 @@ class Pass;
 struct IMacroPatch;
 
 class Model : public RefCounted {
+    CC_SLAB_ALLOCATED
+
     IMPL_EVENT_TARGET(Model)
 
     DECLARE_TARGET_EVENT_BEGIN(Model)
@@ -142,6 +149,9 @@ public:
     void updateLightingmap(Texture2D *texture, const Vec4 &uvParam);
     void clearSHUBOs();
     void updateSHUBOs();
+    bool needUpdateSHUBOs() const;
+    // Thread safe as long as each model is handled by one worker, the GPU buffer is uploaded later in updateSHUBOs
+    void updateSHUBOData(const gi::LightProbes *lightProbes, ccstd::vector<Vec3> &coefficients);
     void updateOctree();
     void updateWorldBoundUBOs();
     void updateLocalShadowBias();
@@ -151,6 +161,43 @@ public:
     void updateReflectionProbeDataMap(Texture2D *texture);
     void updateReflectionProbeBlendCubemap(TextureCube *texture);
 
+    /**
+     * @en Draws only the meshlets visible to the cameras of the scene, for meshes built with MeshOptimizeFlagBit::MESHLETS.
+     * It is suspended while the model casts shadows, as shadow passes draw the same index buffer.
+     * @zh 仅绘制场景相机可见的网格簇，需要网格使用 MeshOptimizeFlagBit::MESHLETS 构建。模型投射阴影时不生效。
+     */
+    void setClusterCulling(bool enabled);
+    inline bool isClusterCulling() const { return _clusterCulling; }
+    void cullClusters(const ccstd::vector<MeshletCullingView> &views);
+    MeshletCullingStats getClusterCullingStats() const;
+
+    /**
+     * @en Flags the local data dirty from the transform notifications of the node instead of polling the node in updateTransform,
+     * used by the dirty model update of RenderScene.
+     * @zh 通过节点的变换通知标记本地数据需要更新，而不是在 updateTransform 中轮询节点，供 RenderScene 的脏模型更新使用。
+     */
+    void setTransformTracking(bool enabled);
+    inline bool isTransformTracking() const { return _transformTracking; }
+    /**
+     * @en Split form of updateTransform and updateUBOs for the tracked models. prepareLocalData resolves the world transform
+     * on the main thread and returns whether it changed, computeLocalData may then run on job workers for different models
+     * and writes the local UBO into localData, flushLocalData updates the remaining buffers on the main thread.
+     * @zh 供跟踪变换的模型使用的 updateTransform 与 updateUBOs 拆分形式。prepareLocalData 在主线程计算世界变换，
+     * computeLocalData 可在工作线程上并行处理不同模型并写入本地 UBO 数据，flushLocalData 在主线程更新其余缓冲。
+     */
+    bool prepareLocalData();
+    void computeLocalData(bool transformChanged, uint8_t *localData);
+    void flushLocalData(uint32_t stamp);
+    /**
+     * @en Uses a view of the local buffer pool of the scene as local UBO, nullptr restores a local buffer owned by the model.
+     * @zh 使用场景本地缓冲池中的视图作为本地 UBO，传入 nullptr 时恢复为模型自己的本地缓冲。
+     */
+    void setPooledLocalBuffer(gfx::Buffer *view, uint32_t slot);
+    inline uint32_t getPooledLocalBufferSlot() const { return _pooledLocalBufferSlot; }
+    // index of the model in the LOD visibility of its scene, see LODVisibility
+    inline uint32_t getLODVisibilityIndex() const { return _lodVisibilityIndex; }
+    inline void setLODVisibilityIndex(uint32_t index) { _lodVisibilityIndex = index; }
+
     inline void attachToScene(RenderScene *scene) {
         _scene = scene;
         _localDataUpdated = true;
@@ -169,7 +216,7 @@ public:
     }
     inline void setShadowBias(float bias) { _shadowBias.x = bias; }
     inline void setShadowNormalBias(float normalBias) { _shadowBias.y = normalBias; }
-    inline void setTransform(Node *node) { _transform = node; }
+    void setTransform(Node *node);
     inline void setVisFlags(Layers::Enum flags) { _visFlags = flags; }
     inline void setBounds(geometry::AABB *world) {
         _worldBounds = world;
@@ -257,6 +304,11 @@ protected:
     void updateAttributesAndBinding(index_t subModelIndex);
     bool isLightProbeAvailable() const;
     void updateSHBuffer();
+    bool updateInstancedWorldMatrices(const Mat4 &worldMatrix);
+    template <typename Writer>
+    void fillLocalData(const Mat4 &worldMatrix, const Writer &write) const;
+
+    static constexpr uint32_t INVALID_LOCAL_BUFFER_SLOT{0xFFFFFFFF};
 
     // Please declare variables in descending order of memory size occupied by variables.
     Type _type{Type::DEFAULT};
@@ -267,6 +319,8 @@ protected:
     uint32_t _descriptorSetCount{1};
     uint32_t _priority{0};
     uint32_t _updateStamp{0};
+    uint32_t _pooledLocalBufferSlot{INVALID_LOCAL_BUFFER_SLOT};
+    uint32_t _lodVisibilityIndex{0xFFFFFFFF};
     int32_t _reflectionProbeId{-1};
     int32_t _reflectionProbeBlendId{ -1 };
     float _reflectionProbeBlendWeight{0.F};
@@ -292,11 +346,16 @@ protected:
     bool _localDataUpdated{false};
     bool _worldBoundsDirty{true};
     bool _useLightProbe = false;
+    bool _localSHDataDirty{false};
     bool _bakeToReflectionProbe{true};
     bool _receiveDirLight{true};
+    bool _clusterCulling{false};
+    bool _transformTracking{false};
     // For JS
     bool _isCalledFromJS{false};
 
+    Node::TransformInvalidated::EventID _transformInvalidatedId;
+
     Vec3 _lastWorldBoundCenter{INFINITY, INFINITY, INFINITY};
 
     Vec4 _shadowBias{0.F, 0.F, -1.F, -1.F};
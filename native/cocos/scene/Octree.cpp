@@ -27,6 +27,7 @@
 #include <utility>
 #include "scene/Camera.h"
 #include "scene/Model.h"
+#include "scene/RenderScene.h"
 
 namespace cc {
 namespace scene {
@@ -223,10 +224,15 @@ void OctreeNode::gatherModels(ccstd::vector<Model *> &results) const { // NOLINT
 
 void OctreeNode::doQueryVisibility(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<const Model *> &results) const {
     const auto visibility = camera->getVisibility();
+    const auto *scene = camera->getScene();
     for (auto *model : _models) {
         if (!model->isEnabled()) {
             continue;
         }
+        // models of the LOD levels not selected for the camera are masked out before their bounds are tested
+        if (scene && scene->isCulledByLod(camera, model)) {
+            continue;
+        }
 
         const Node *node = model->getNode();
         if ((node && ((visibility & node->getLayer()) == node->getLayer())) ||
@@ -44,6 +44,8 @@
 namespace cc {
 namespace scene {
 
+CC_SLAB_ALLOCATOR_IMPL(Pass, 256)
+
 namespace {
 
 constexpr uint32_t INVALID_ID = 0xFFFFFFFF;
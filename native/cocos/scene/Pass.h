@@ -31,6 +31,7 @@
 #include "core/ArrayBuffer.h"
 #include "core/TypedArray.h"
 #include "core/assets/EffectAsset.h"
+#include "core/memop/SlabAllocator.h"
 #include "renderer/core/PassUtils.h"
 #include "renderer/gfx-base/GFXBuffer.h"
 #include "renderer/gfx-base/GFXDef-common.h"
@@ -66,6 +67,8 @@ struct IBlockRef {
 };
 
 class Pass : public RefCounted {
+    CC_SLAB_ALLOCATED
+
 public:
     /**
      * @en Get the type of member in uniform buffer object with the handle
@@ -25,19 +25,27 @@
 #include "scene/RenderScene.h"
 #include "scene/Camera.h"
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
 #include <utility>
 #include "3d/models/BakedSkinningModel.h"
 #include "3d/models/SkinningModel.h"
 #include "base/Log.h"
+#include "base/Utils.h"
+#include "base/job-system/JobSystem.h"
 #include "core/Root.h"
 #include "core/scene-graph/Node.h"
+#include "gi/light-probe/LightProbe.h"
 #include "profiler/Profiler.h"
+#include "renderer/gfx-base/GFXDevice.h"
 #include "renderer/pipeline/PipelineSceneData.h"
 #include "renderer/pipeline/custom/RenderInterfaceTypes.h"
 #include "scene/Camera.h"
 #include "scene/DirectionalLight.h"
 #include "scene/DrawBatch2D.h"
 #include "scene/LODGroup.h"
+#include "scene/LODVisibility.h"
 #include "scene/Model.h"
 #include "scene/Octree.h"
 #include "scene/PointLight.h"
@@ -45,9 +53,66 @@
 #include "scene/SphereLight.h"
 #include "scene/SpotLight.h"
 
+#ifdef __SSE__
+    #include <xmmintrin.h>
+#endif
+
 namespace cc {
 namespace scene {
 
+namespace {
+// models interpolated by one job, keeps the per job overhead small against the tetrahedron walking
+constexpr uint32_t SH_UPDATE_BATCH_SIZE{64U};
+// dirty models whose local data is computed by one job
+constexpr uint32_t MODEL_UPDATE_BATCH_SIZE{64U};
+
+constexpr uint8_t LOD_GROUP_EVALUATED{1U};
+constexpr uint8_t LOD_GROUP_CHANGED{2U};
+
+// avoids the division by zero when the camera is at the boundary center, any usage above 1 selects the first level anyway
+constexpr float LOD_MIN_DISTANCE{1e-4F};
+
+// Screen usage percentage of every LODGroup against one camera, see LODGroup::distanceToScreenUsagePercentage.
+// count must be a multiple of 4, padded entries have zero size.
+void computeLODScreenUsage(const Camera *camera, uint32_t count, const float *x, const float *y, const float *z, const float *size, float *out) {
+    // note: matProj.m11 is 1 / tan(fov / 2.0)
+    const float projScale = fabsf(camera->getMatProj().m[5]);
+    if (camera->getProjectionType() != CameraProjection::PERSPECTIVE) {
+        for (uint32_t i = 0; i < count; ++i) {
+            out[i] = size[i] * projScale * 0.5F;
+        }
+        return;
+    }
+
+    const auto &eye = camera->getNode()->getWorldPosition();
+    const float halfScale = projScale * 0.5F;
+#ifdef __SSE__
+    const __m128 eyeX = _mm_set1_ps(eye.x);
+    const __m128 eyeY = _mm_set1_ps(eye.y);
+    const __m128 eyeZ = _mm_set1_ps(eye.z);
+    const __m128 scale = _mm_set1_ps(halfScale);
+    const __m128 minDistance = _mm_set1_ps(LOD_MIN_DISTANCE);
+    for (uint32_t i = 0; i < count; i += 4) {
+        const __m128 dx = _mm_sub_ps(_mm_loadu_ps(x + i), eyeX);
+        const __m128 dy = _mm_sub_ps(_mm_loadu_ps(y + i), eyeY);
+        const __m128 dz = _mm_sub_ps(_mm_loadu_ps(z + i), eyeZ);
+        const __m128 sqrDistance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+        const __m128 distance = _mm_max_ps(_mm_sqrt_ps(sqrDistance), minDistance);
+        _mm_storeu_ps(out + i, _mm_div_ps(_mm_mul_ps(_mm_loadu_ps(size + i), scale), distance));
+    }
+#else
+    // branch free so that it is vectorized by the compiler on NEON
+    for (uint32_t i = 0; i < count; ++i) {
+        const float dx = x[i] - eye.x;
+        const float dy = y[i] - eye.y;
+        const float dz = z[i] - eye.z;
+        const float distance = std::max(sqrtf(dx * dx + dy * dy + dz * dz), LOD_MIN_DISTANCE);
+        out[i] = size[i] * halfScale / distance;
+    }
+#endif
+}
+} // namespace
+
 /**
  * @zh 管理LODGroup的使用状态，包含使用层级及其上的model可见相机列表；便于判断当前model是否被LODGroup裁剪
  * @en Manage the usage status of LODGroup, including the usage level and the list of visible cameras on its models; easy to determine whether the current mod is cropped by LODGroup。
@@ -60,8 +125,23 @@ public:
          * @en Which level of LOD is currently in use, -1 means no levels are used
          */
         int8_t usedLevel{-1};
-        int8_t lastUsedLevel{-1};
+        /**
+         * @zh 正在淡出的 LOD 层级, -1 表示没有
+         * @en The level of LOD which is fading out, -1 means none
+         */
+        int8_t fadeOutLevel{-1};
         bool transformDirty{true};
+        float fadeProgress{0.F};
+    };
+
+    struct CameraLODState {
+        /**
+         * @zh 每个 LODGroup 的使用状态，与 RenderScene 中 LODGroup 的顺序一致
+         * @en Usage state of every LODGroup, in the order of the LODGroups in RenderScene
+         */
+        ccstd::vector<LODInfo> lodInfos;
+        uint32_t fadingCount{0};
+        bool dirty{true};
     };
 
     explicit LodStateCache(RenderScene *scene) : _renderScene(scene){};
@@ -73,51 +153,180 @@ public:
 
     void addLodGroup(const LODGroup *lodGroup);
 
-    void removeLodGroup(const LODGroup *lodGroup);
+    void removeLodGroup(const LODGroup *lodGroup, uint32_t index);
 
-    void removeModel(const Model *model);
+    void removeModel(Model *model);
 
     void updateLodState();
 
-    bool isLodModelCulled(const Camera *camera, const Model *model);
+    bool isLodModelCulled(const Camera *camera, const Model *model) const;
+
+    const LODInfo *getLODInfo(const Camera *camera, uint32_t index) const;
 
     void clearCache();
 
 private:
+    void addVisibleCamera(const Camera *camera);
+
+    inline uint32_t findCamera(const Camera *camera) const {
+        // a handful of cameras, cheaper than hashing
+        const auto iter = std::find(_cameras.begin(), _cameras.end(), camera);
+        return iter != _cameras.end() ? static_cast<uint32_t>(iter - _cameras.begin()) : LODVisibility::INVALID_INDEX;
+    }
+
+    uint32_t acquireModel(Model *model);
+
+    void releaseModel(Model *model);
+
+    void setLevelInvisibleForAll(uint32_t groupIndex);
+
+    void updateLockedLodGroup(LODGroup *lodGroup, uint32_t index);
+
+    void setLevelVisible(uint32_t groupIndex, int8_t level, uint32_t camera, bool visible);
+
     /**
-     * @zh LOD使用的model集合以及每个model当前能被看到的相机列表；包含每个LODGroup的每一级LOD
-     * @en The set of models used by the LOD and the list of cameras that each models can currently be seen, contains each level of LOD for each LODGroup.
+     * @zh LOD 使用的所有模型在每个相机下是否可见，模型索引保存在 Model::getLODVisibilityIndex 中
+     * @en Whether the models used by the LODs are visible under each camera, the model indices are stored in Model::getLODVisibilityIndex.
      */
-    ccstd::unordered_map<const Model *, ccstd::unordered_map<const Camera *, bool>> _modelsInLODGroup;
+    LODVisibility _visibility;
 
     /**
-     * @zh 指定相机下，LODGroup使用哪一级的LOD
-     * @en Specify which level of LOD is used by the LODGroup under the camera.
+     * @zh 能看到 LODGroup 的相机及其 LOD 状态，与 _visibility 中的相机索引一致
+     * @en The cameras which can see LODGroups and their LOD states, in the camera order of _visibility.
      */
-    ccstd::unordered_map<const Camera *, ccstd::unordered_map<const LODGroup *, LODInfo>> _lodStateInCamera;
+    ccstd::vector<const Camera *> _cameras;
+    ccstd::vector<CameraLODState> _cameraStates;
 
     /**
-     * @zh 上一帧添加的LODGroup
-     * @en The LODGroup added in the previous frame.
+     * @zh 每个 LODGroup 每一级 LOD 上的所有模型，与 RenderScene 中 LODGroup 的顺序一致
+     * @en All models on each LOD of every LODGroup, in the order of the LODGroups in RenderScene.
      */
-    ccstd::vector<const LODGroup *> _newAddedLodGroupVec;
+    ccstd::vector<ccstd::vector<ccstd::vector<Model *>>> _levelModels;
 
     /**
-     * @zh 每个LOD上的所有models，包含所有LODGroup中的所有LOD
-     * @en All mods on each LOD, containing all LODs in all LODGroups.
+     * @zh 上一帧添加、模型尚未登记的 LODGroup
+     * @en The LODGroups added in the previous frame, whose models are not registered yet.
      */
-    ccstd::unordered_map<const LODGroup *, ccstd::unordered_map<uint8_t, ccstd::vector<const Model *>>> _levelModels;
+    ccstd::vector<uint8_t> _pendingGroups;
+    uint32_t _pendingGroupCount{0};
+
+    /**
+     * @zh 每帧 LODGroup 的世界空间包围中心和尺寸，按 4 个对齐补零，供所有相机批量计算屏占比
+     * @en World space boundary centers and sizes of the LODGroups in this frame, zero padded to a multiple of 4,
+     * shared by the batched screen usage evaluation of all cameras.
+     */
+    ccstd::vector<float> _centerX;
+    ccstd::vector<float> _centerY;
+    ccstd::vector<float> _centerZ;
+    ccstd::vector<float> _worldSize;
+    ccstd::vector<float> _screenUsage;
+    // 1: evaluated by screen usage this frame, 2: the node of the group changed this frame
+    ccstd::vector<uint8_t> _groupFlags;
 
     RenderScene *_renderScene{nullptr};
 };
 
+/**
+ * @en The local UBOs of the models tracked by the dirty model update. Each one is a view into a page of a uniform buffer,
+ * the jobs write the local data into a CPU copy of the pages, and every touched page is uploaded with one buffer update.
+ */
+class LocalBufferPool : public RefCounted {
+public:
+    explicit LocalBufferPool(gfx::Device *device);
+    ~LocalBufferPool() override;
+
+    gfx::Buffer *allocate(uint32_t *slot);
+    void free(uint32_t slot);
+    void markDirty(uint32_t slot);
+    void flush(ModelUpdateStats *stats);
+
+    inline uint8_t *getData(uint32_t slot) { return _pages[slot / PAGE_SLOT_COUNT].data.data() + (slot % PAGE_SLOT_COUNT) * _stride; }
+
+private:
+    static constexpr uint32_t PAGE_SLOT_COUNT{256U};
+
+    struct Page {
+        IntrusivePtr<gfx::Buffer> buffer;
+        ccstd::vector<uint8_t> data;
+        // the slots below are uploaded by the next flush
+        uint32_t dirtyEnd{0};
+    };
+
+    gfx::Device *_device{nullptr};
+    uint32_t _stride{0};
+    ccstd::vector<Page> _pages;
+    // min heap, the lowest slots are reused first to keep the uploaded ranges short
+    ccstd::vector<uint32_t> _freeSlots;
+};
+
+LocalBufferPool::LocalBufferPool(gfx::Device *device)
+: _device(device),
+  _stride(utils::alignTo(pipeline::UBOLocal::SIZE, device->getCapabilities().uboOffsetAlignment)) {}
+
+LocalBufferPool::~LocalBufferPool() {
+    for (auto &page : _pages) {
+        CC_SAFE_DESTROY_NULL(page.buffer);
+    }
+}
+
+gfx::Buffer *LocalBufferPool::allocate(uint32_t *slot) {
+    if (_freeSlots.empty()) {
+        const auto pageIndex = static_cast<uint32_t>(_pages.size());
+        auto &page = _pages.emplace_back();
+        page.buffer = _device->createBuffer({gfx::BufferUsageBit::UNIFORM | gfx::BufferUsageBit::TRANSFER_DST,
+                                             gfx::MemoryUsageBit::DEVICE,
+                                             PAGE_SLOT_COUNT * _stride,
+                                             _stride,
+                                             gfx::BufferFlagBit::ENABLE_STAGING_WRITE});
+        page.data.resize(PAGE_SLOT_COUNT * _stride);
+        for (uint32_t i = 0; i < PAGE_SLOT_COUNT; ++i) {
+            _freeSlots.emplace_back(pageIndex * PAGE_SLOT_COUNT + i);
+        }
+        std::make_heap(_freeSlots.begin(), _freeSlots.end(), std::greater<>());
+    }
+    std::pop_heap(_freeSlots.begin(), _freeSlots.end(), std::greater<>());
+    *slot = _freeSlots.back();
+    _freeSlots.pop_back();
+
+    return _device->createBuffer(gfx::BufferViewInfo{_pages[*slot / PAGE_SLOT_COUNT].buffer.get(), (*slot % PAGE_SLOT_COUNT) * _stride, pipeline::UBOLocal::SIZE});
+}
+
+void LocalBufferPool::free(uint32_t slot) {
+    _freeSlots.emplace_back(slot);
+    std::push_heap(_freeSlots.begin(), _freeSlots.end(), std::greater<>());
+}
+
+void LocalBufferPool::markDirty(uint32_t slot) {
+    auto &page = _pages[slot / PAGE_SLOT_COUNT];
+    page.dirtyEnd = std::max(page.dirtyEnd, slot % PAGE_SLOT_COUNT + 1);
+}
+
+void LocalBufferPool::flush(ModelUpdateStats *stats) {
+    stats->localBufferUploads = 0;
+    stats->localBufferBytes = 0;
+    for (auto &page : _pages) {
+        if (!page.dirtyEnd) {
+            continue;
+        }
+        // gfx only updates buffers from their start, the untouched slots below are uploaded again from the CPU copy
+        const uint32_t size = (page.dirtyEnd - 1) * _stride + pipeline::UBOLocal::SIZE;
+        page.buffer->update(page.data.data(), size);
+        page.dirtyEnd = 0;
+        ++stats->localBufferUploads;
+        stats->localBufferBytes += size;
+    }
+}
+
 RenderScene::RenderScene() = default;
 
 RenderScene::~RenderScene() = default;
 
 void RenderScene::activate() {
+    // no pipeline in a dedicated server, the scene is never culled by an octree
+#if !defined(CC_DEDICATED_SERVER)
     const auto *sceneData = Root::getInstance()->getPipeline()->getPipelineSceneData();
     _octree = sceneData->getOctree();
+#endif
 }
 
 bool RenderScene::initialize(const IRenderSceneInfo &info) {
@@ -135,7 +344,7 @@ void RenderScene::addLODGroup(LODGroup *group) {
 void RenderScene::removeLODGroup(LODGroup *group) {
     auto iter = std::find(_lodGroups.begin(), _lodGroups.end(), group);
     if (iter != _lodGroups.end()) {
-        _lodStateCache->removeLodGroup(group);
+        _lodStateCache->removeLodGroup(group, static_cast<uint32_t>(iter - _lodGroups.begin()));
         group->detachFromScene();
         _lodGroups.erase(iter);
     } else {
@@ -144,8 +353,10 @@ void RenderScene::removeLODGroup(LODGroup *group) {
 }
 
 void RenderScene::removeLODGroups() {
-    for (const auto &group : _lodGroups) {
-        _lodStateCache->removeLodGroup(group);
+    // from back to front, the state of the groups is stored by index in LodStateCache
+    for (auto i = static_cast<uint32_t>(_lodGroups.size()); i > 0; --i) {
+        const auto &group = _lodGroups[i - 1];
+        _lodStateCache->removeLodGroup(group, i - 1);
         group->detachFromScene();
     }
     _lodGroups.clear();
@@ -155,6 +366,30 @@ bool RenderScene::isCulledByLod(const Camera *camera, const Model *model) const
     return _lodStateCache->isLodModelCulled(camera, model);
 }
 
+int8_t RenderScene::getLODLevel(const Camera *camera, const LODGroup *group) const {
+    const auto iter = std::find(_lodGroups.begin(), _lodGroups.end(), group);
+    if (iter == _lodGroups.end()) {
+        return -1;
+    }
+    const auto *lodInfo = _lodStateCache->getLODInfo(camera, static_cast<uint32_t>(iter - _lodGroups.begin()));
+    return lodInfo ? lodInfo->usedLevel : -1;
+}
+
+int8_t RenderScene::getLODCrossFade(const Camera *camera, const LODGroup *group, float *progress) const {
+    const auto iter = std::find(_lodGroups.begin(), _lodGroups.end(), group);
+    if (iter == _lodGroups.end()) {
+        return -1;
+    }
+    const auto *lodInfo = _lodStateCache->getLODInfo(camera, static_cast<uint32_t>(iter - _lodGroups.begin()));
+    if (!lodInfo || lodInfo->fadeOutLevel < 0) {
+        return -1;
+    }
+    if (progress) {
+        *progress = lodInfo->fadeProgress;
+    }
+    return lodInfo->fadeOutLevel;
+}
+
 void RenderScene::setMainLight(DirectionalLight *dl) {
     _mainLight = dl;
     if (_mainLight) _mainLight->activate();
@@ -178,13 +413,26 @@ void RenderScene::update(uint32_t stamp) {
     for (const auto &light : _rangedDirLights) {
         light->update();
     }
-    for (const auto &model : _models) {
-        if (model->isEnabled()) {
-            model->updateTransform(stamp);
-            model->updateUBOs(stamp);
-            model->updateOctree();
+    if (_dirtyModelUpdate) {
+        updateDirtyModels(stamp);
+    } else {
+        for (const auto &model : _models) {
+            if (model->isEnabled()) {
+                model->updateTransform(stamp);
+            }
+        }
+#if !CC_EDITOR
+        // interpolate light probes of all moved models at once, the buffers are uploaded in Model::updateUBOs
+        updateSHUBOs();
+#endif
+        for (const auto &model : _models) {
+            if (model->isEnabled()) {
+                model->updateUBOs(stamp);
+                model->updateOctree();
+            }
         }
     }
+    cullClusters();
 
     CC_PROFILE_OBJECT_UPDATE(Models, _models.size());
     CC_PROFILE_OBJECT_UPDATE(Cameras, _cameras.size());
@@ -343,6 +591,9 @@ void RenderScene::removeRangedDirLights() {
 void RenderScene::addModel(Model *model) {
     model->attachToScene(this);
     _models.emplace_back(model);
+    if (_dirtyModelUpdate) {
+        setModelTracking(model, true);
+    }
     if (_octree && _octree->isEnabled()) {
         _octree->insert(model);
     }
@@ -355,6 +606,7 @@ void RenderScene::removeModel(Model *model) {
             _octree->remove(*iter);
         }
         _lodStateCache->removeModel(model);
+        setModelTracking(model, false);
         model->detachFromScene();
         _models.erase(iter);
     } else {
@@ -368,6 +620,7 @@ void RenderScene::removeModels() {
             _octree->remove(model);
         }
         _lodStateCache->removeModel(model);
+        setModelTracking(model, false);
         model->detachFromScene();
         CC_SAFE_DESTROY(model);
     }
@@ -396,6 +649,199 @@ void RenderScene::updateOctree(Model *model) {
     }
 }
 
+void RenderScene::cullClusters() {
+    ccstd::vector<MeshletCullingView> views;
+    for (const auto &model : _models) {
+        if (!model->isEnabled() || !model->isClusterCulling()) {
+            continue;
+        }
+        // a meshlet is kept if any camera which renders the model sees it
+        views.clear();
+        const auto *node = model->getNode();
+        for (const auto &camera : _cameras) {
+            const uint32_t visibility = camera->getVisibility();
+            if (!camera->isEnabled() ||
+                (!(node && (visibility & node->getLayer()) == node->getLayer()) && !(visibility & static_cast<uint32_t>(model->getVisFlags())))) {
+                continue;
+            }
+            views.push_back({&camera->getFrustum(), camera->getPosition(), camera->getProjectionType() == CameraProjection::PERSPECTIVE});
+        }
+        model->cullClusters(views);
+    }
+}
+
+void RenderScene::setDirtyModelUpdate(bool enabled) {
+    if (_dirtyModelUpdate == enabled) {
+        return;
+    }
+    _dirtyModelUpdate = enabled;
+    if (enabled && !_localBufferPool) {
+        _localBufferPool = ccnew LocalBufferPool(Root::getInstance()->getDevice());
+    }
+    for (const auto &model : _models) {
+        setModelTracking(model, enabled);
+    }
+    _modelUpdateStats = {};
+}
+
+const uint8_t *RenderScene::getPooledLocalData(const Model *model) const {
+    if (!model->isTransformTracking()) {
+        return nullptr;
+    }
+    return _localBufferPool->getData(model->getPooledLocalBufferSlot());
+}
+
+void RenderScene::setModelTracking(Model *model, bool enabled) {
+    // skinning models and models implemented in JS update their own buffers every frame
+    if (model->getType() != Model::Type::DEFAULT || model->isTransformTracking() == enabled) {
+        return;
+    }
+    if (enabled) {
+        uint32_t slot = 0;
+        auto *view = _localBufferPool->allocate(&slot);
+        model->setPooledLocalBuffer(view, slot);
+    } else {
+        _localBufferPool->free(model->getPooledLocalBufferSlot());
+        model->setPooledLocalBuffer(nullptr, 0);
+    }
+    model->setTransformTracking(enabled);
+}
+
+void RenderScene::updateDirtyModels(uint32_t stamp) {
+    CC_PROFILE(RenderSceneUpdateDirtyModels);
+
+    // tracked models are flagged by the transform notifications of their node or by their own setters,
+    // the others still poll their node every frame
+    _dirtyModels.clear();
+    _untrackedModels.clear();
+    for (const auto &model : _models) {
+        if (!model->isEnabled()) {
+            continue;
+        }
+        if (!model->isTransformTracking() || !model->getTransform()) {
+            model->updateTransform(stamp);
+            _untrackedModels.emplace_back(model.get());
+            continue;
+        }
+        // the passes and descriptor sets only upload what changed
+        for (const auto &subModel : model->getSubModels()) {
+            subModel->update();
+        }
+        if (model->isLocalDataUpdated()) {
+            _dirtyModels.emplace_back(model.get());
+        }
+    }
+
+    const auto count = static_cast<uint32_t>(_dirtyModels.size());
+    _transformChanged.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        _transformChanged[i] = _dirtyModels[i]->prepareLocalData() ? 1 : 0;
+        _localBufferPool->markDirty(_dirtyModels[i]->getPooledLocalBufferSlot());
+    }
+
+    const auto batchCount = count ? (count - 1) / MODEL_UPDATE_BATCH_SIZE + 1 : 0;
+    auto *const *models = _dirtyModels.data();
+    const auto *transformChanged = _transformChanged.data();
+    auto *pool = _localBufferPool.get();
+    auto compute = [models, transformChanged, pool, count](uint32_t batch) {
+        const auto end = std::min(count, (batch + 1) * MODEL_UPDATE_BATCH_SIZE);
+        for (auto i = batch * MODEL_UPDATE_BATCH_SIZE; i < end; ++i) {
+            models[i]->computeLocalData(transformChanged[i] != 0, pool->getData(models[i]->getPooledLocalBufferSlot()));
+        }
+    };
+
+    if (batchCount > 1 && JobSystem::getInstance()->threadCount() > 1) {
+        JobGraph g(JobSystem::getInstance());
+        g.createForEachIndexJob(0U, batchCount, 1U, compute);
+        g.run();
+        g.waitForAll();
+    } else {
+        for (uint32_t i = 0U; i < batchCount; ++i) {
+            compute(i);
+        }
+    }
+
+#if !CC_EDITOR
+    updateSHUBOs();
+#endif
+    for (auto *model : _untrackedModels) {
+        model->updateUBOs(stamp);
+        model->updateOctree();
+    }
+    for (auto *model : _dirtyModels) {
+        model->flushLocalData(stamp);
+    }
+    _localBufferPool->flush(&_modelUpdateStats);
+
+    _modelUpdateStats.dirtyModels = count;
+    _modelUpdateStats.untrackedModels = static_cast<uint32_t>(_untrackedModels.size());
+    CC_PROFILE_OBJECT_UPDATE(DirtyModels, count);
+}
+
+void RenderScene::updateSHUBOs() {
+    CC_PROFILE(RenderSceneUpdateSHUBOs);
+
+    // no pipeline in a dedicated server, and no light probes
+    const auto *pipeline = Root::getInstance()->getPipeline();
+    if (!pipeline) {
+        return;
+    }
+    const auto *lightProbes = pipeline->getPipelineSceneData()->getLightProbes();
+    if (!lightProbes || lightProbes->empty() || !lightProbes->getData()->hasCoefficients()) {
+        return;
+    }
+
+    _shDirtyModels.clear();
+    if (_dirtyModelUpdate) {
+        // only the models updated this frame can have moved
+        for (auto *models : {&_dirtyModels, &_untrackedModels}) {
+            for (auto *model : *models) {
+                if (model->needUpdateSHUBOs()) {
+                    _shDirtyModels.emplace_back(model);
+                }
+            }
+        }
+    } else {
+        for (const auto &model : _models) {
+            if (model->isEnabled() && model->needUpdateSHUBOs()) {
+                _shDirtyModels.emplace_back(model.get());
+            }
+        }
+    }
+
+    CC_PROFILE_OBJECT_UPDATE(LightProbeModels, _shDirtyModels.size());
+    if (_shDirtyModels.empty()) {
+        return;
+    }
+
+    auto *data = lightProbes->getData();
+    if (!data->isTetrahedronGridValid()) {
+        data->updateTetrahedronGrid();
+    }
+
+    const auto count = static_cast<uint32_t>(_shDirtyModels.size());
+    const auto batchCount = (count - 1) / SH_UPDATE_BATCH_SIZE + 1;
+    auto *const *models = _shDirtyModels.data();
+    auto interpolate = [models, count, lightProbes](uint32_t batch) {
+        ccstd::vector<Vec3> coefficients;
+        const auto end = std::min(count, (batch + 1) * SH_UPDATE_BATCH_SIZE);
+        for (auto i = batch * SH_UPDATE_BATCH_SIZE; i < end; ++i) {
+            models[i]->updateSHUBOData(lightProbes, coefficients);
+        }
+    };
+
+    if (batchCount > 1 && JobSystem::getInstance()->threadCount() > 1) {
+        JobGraph g(JobSystem::getInstance());
+        g.createForEachIndexJob(0U, batchCount, 1U, interpolate);
+        g.run();
+        g.waitForAll();
+    } else {
+        for (uint32_t i = 0U; i < batchCount; ++i) {
+            interpolate(i);
+        }
+    }
+}
+
 void RenderScene::onGlobalPipelineStateChanged() {
     for (const auto &model : _models) {
         model->onGlobalPipelineStateChanged();
@@ -403,190 +849,323 @@ void RenderScene::onGlobalPipelineStateChanged() {
 }
 
 void LodStateCache::addCamera(const Camera *camera) {
+    if (findCamera(camera) != LODVisibility::INVALID_INDEX) {
+        return;
+    }
     for (const auto &lodGroup : _renderScene->getLODGroups()) {
         auto layer = lodGroup->getNode()->getLayer();
         if ((camera->getVisibility() & layer) == layer) {
-            if (_lodStateInCamera.count(camera) == 0) {
-                _lodStateInCamera[camera] = {};
-            }
+            addVisibleCamera(camera);
             break;
         }
     }
 }
 
+void LodStateCache::addVisibleCamera(const Camera *camera) {
+    _cameras.emplace_back(camera);
+    _cameraStates.emplace_back().lodInfos.resize(_renderScene->getLODGroups().size());
+    _visibility.addCamera();
+}
+
 void LodStateCache::removeCamera(const Camera *camera) {
-    if (_lodStateInCamera.count(camera) != 0) {
-        _lodStateInCamera.erase(camera);
+    const auto index = findCamera(camera);
+    if (index == LODVisibility::INVALID_INDEX) {
+        return;
     }
+    // same swap with the last camera as LODVisibility::removeCamera
+    _cameras[index] = _cameras.back();
+    _cameras.pop_back();
+    _cameraStates[index] = std::move(_cameraStates.back());
+    _cameraStates.pop_back();
+    _visibility.removeCamera(index);
 }
 
 void LodStateCache::addLodGroup(const LODGroup *lodGroup) {
-    _newAddedLodGroupVec.push_back(lodGroup);
-
+    // lodGroup is already appended to the groups of the scene, its models are registered in the next updateLodState
+    _levelModels.emplace_back();
+    _pendingGroups.emplace_back(1U);
+    ++_pendingGroupCount;
+
+    const auto groupCount = _renderScene->getLODGroups().size();
+    for (auto &state : _cameraStates) {
+        state.lodInfos.resize(groupCount);
+        state.dirty = true;
+    }
+    const auto layer = lodGroup->getNode()->getLayer();
     for (const auto &camera : _renderScene->getCameras()) {
-        if (_lodStateInCamera.count(camera)) {
-            continue;
-        }
-        auto layer = lodGroup->getNode()->getLayer();
-        if ((camera->getVisibility() & layer) == layer) {
-            _lodStateInCamera[camera] = {};
+        if ((camera->getVisibility() & layer) == layer && findCamera(camera) == LODVisibility::INVALID_INDEX) {
+            addVisibleCamera(camera);
         }
     }
 }
 
-void LodStateCache::removeLodGroup(const LODGroup *lodGroup) {
-    for (auto index = 0; index < lodGroup->getLodCount(); index++) {
-        const auto &lod = lodGroup->getLodDataArray()[index];
+void LodStateCache::removeLodGroup(const LODGroup *lodGroup, uint32_t index) {
+    for (auto level = 0; level < lodGroup->getLodCount(); level++) {
+        const auto &lod = lodGroup->getLodDataArray()[level];
         for (const auto &model : lod->getModels()) {
-            _modelsInLODGroup.erase(model);
+            releaseModel(model);
+        }
+    }
+    for (auto &state : _cameraStates) {
+        auto &lodInfos = state.lodInfos;
+        if (index < lodInfos.size()) {
+            lodInfos.erase(lodInfos.begin() + index);
+        }
+    }
+    if (index < _levelModels.size()) {
+        _levelModels.erase(_levelModels.begin() + index);
+        _pendingGroupCount -= _pendingGroups[index];
+        _pendingGroups.erase(_pendingGroups.begin() + index);
+    }
+}
+
+void LodStateCache::removeModel(Model *model) {
+    releaseModel(model);
+}
+
+uint32_t LodStateCache::acquireModel(Model *model) {
+    auto index = model->getLODVisibilityIndex();
+    if (index == LODVisibility::INVALID_INDEX) {
+        index = _visibility.addModel();
+        model->setLODVisibilityIndex(index);
+    }
+    return index;
+}
+
+void LodStateCache::releaseModel(Model *model) {
+    const auto index = model->getLODVisibilityIndex();
+    if (index != LODVisibility::INVALID_INDEX) {
+        _visibility.removeModel(index);
+        model->setLODVisibilityIndex(LODVisibility::INVALID_INDEX);
+    }
+}
+
+void LodStateCache::setLevelInvisibleForAll(uint32_t groupIndex) {
+    for (const auto &models : _levelModels[groupIndex]) {
+        for (auto *model : models) {
+            _visibility.setVisibleForAll(acquireModel(model), false);
         }
     }
-    for (auto &visibleCamera : _lodStateInCamera) {
-        visibleCamera.second.erase(lodGroup);
+}
+
+void LodStateCache::setLevelVisible(uint32_t groupIndex, int8_t level, uint32_t camera, bool visible) {
+    const auto &levels = _levelModels[groupIndex];
+    if (level < 0 || level >= static_cast<int8_t>(levels.size())) {
+        return;
+    }
+    for (auto *model : levels[level]) {
+        if (!visible) {
+            _visibility.setVisible(camera, acquireModel(model), false);
+        } else if (model->getNode() && model->getNode()->isActive()) {
+            _visibility.setVisible(camera, acquireModel(model), true);
+        }
     }
-    _levelModels.erase(lodGroup);
 }
 
-void LodStateCache::removeModel(const Model *model) {
-    if (_modelsInLODGroup.count(model) != 0) {
-        _modelsInLODGroup.erase(model);
+void LodStateCache::updateLockedLodGroup(LODGroup *lodGroup, uint32_t index) {
+    //Update the dirty flag to make it easier to update the visible index of lod after lifting the forced use of lod.
+    if (lodGroup->getNode()->getChangedFlags() > 0) {
+        for (auto &state : _cameraStates) {
+            state.lodInfos[index].transformDirty = true;
+        }
+    }
+    //Update the visible camera list of all models on lodGroup when the visible level changes.
+    if (!lodGroup->isLockLevelChanged()) {
+        return;
+    }
+    lodGroup->resetLockChangeFlag();
+    setLevelInvisibleForAll(index);
+
+    const auto &levels = _levelModels[index];
+    for (uint8_t visibleIndex : lodGroup->getLockedLODLevels()) {
+        if (visibleIndex >= levels.size()) {
+            continue;
+        }
+        for (auto *model : levels[visibleIndex]) {
+            if (model->getNode() && model->getNode()->isActive()) {
+                _visibility.setVisibleForAll(acquireModel(model), true);
+            }
+        }
     }
 }
 
-// Update list of visible cameras on _modelsInLODGroup and update lod usage level under specified camera.
+// Update the visible cameras of the LOD models and update lod usage level under specified camera.
 void LodStateCache::updateLodState() {
-    //insert _newAddedLodGroupVec's model into _modelsInLODGroup
-    for (const auto &addedLodGroup : _newAddedLodGroupVec) {
-        auto &lodModels = _levelModels[addedLodGroup];
+    const auto &lodGroups = _renderScene->getLODGroups();
+    const auto groupCount = static_cast<uint32_t>(lodGroups.size());
+
+    //register the models of the LODGroups added since the last update, they are invisible until a level is selected
+    for (uint32_t i = 0; _pendingGroupCount > 0 && i < groupCount; ++i) {
+        if (!_pendingGroups[i]) {
+            continue;
+        }
+        _pendingGroups[i] = 0;
+        --_pendingGroupCount;
+        const auto *addedLodGroup = lodGroups[i].get();
+        auto &levels = _levelModels[i];
+        levels.resize(addedLodGroup->getLodCount());
         for (uint8_t index = 0; index < addedLodGroup->getLodCount(); index++) {
-            auto &vecModels = lodModels[index];
             const auto &lod = addedLodGroup->getLodDataArray()[index];
             for (const auto &model : lod->getModels()) {
-                auto &modelInfo = _modelsInLODGroup[model];
-                vecModels.push_back(model);
+                acquireModel(model);
+                levels[index].push_back(model);
             }
         }
     }
-    _newAddedLodGroupVec.clear();
 
-    //update current visible lod index & model's visible cameras list
-    for (const auto &lodGroup : _renderScene->getLODGroups()) {
-        if (lodGroup->isEnabled()) {
-            const auto &lodLevels = lodGroup->getLockedLODLevels();
-            // lodLevels is not empty, indicating that the user force to use certain layers of LOD
-            if (!lodLevels.empty()) {
-                //Update the dirty flag to make it easier to update the visible index of lod after lifting the forced use of lod.
-                if (lodGroup->getNode()->getChangedFlags() > 0) {
-                    for (auto &visibleCamera : _lodStateInCamera) {
-                        auto &lodInfo = visibleCamera.second[lodGroup];
-                        lodInfo.transformDirty = true;
-                    }
-                }
-                //Update the visible camera list of all models on lodGroup when the visible level changes.
-                if (lodGroup->isLockLevelChanged()) {
-                    lodGroup->resetLockChangeFlag();
-                    const auto &lodModels = _levelModels[lodGroup];
-                    for (const auto &level : lodModels) {
-                        const auto &vecModels = lodModels.at(level.first);
-                        for (const auto &model : vecModels) {
-                            _modelsInLODGroup[model].clear();
-                        }
-                    }
+    const auto paddedCount = (groupCount + 3U) & ~3U;
+    // resize keeps the capacity, there is no allocation unless the group count grows
+    _centerX.resize(paddedCount);
+    _centerY.resize(paddedCount);
+    _centerZ.resize(paddedCount);
+    _worldSize.resize(paddedCount);
+    _screenUsage.resize(paddedCount);
+    _groupFlags.resize(groupCount);
+
+    //gather the boundaries of the LODGroups evaluated by screen usage, locked groups are resolved here directly
+    bool anyGroupChanged = false;
+    for (uint32_t i = 0; i < paddedCount; ++i) {
+        _worldSize[i] = 0.F;
+        _centerX[i] = _centerY[i] = _centerZ[i] = 0.F;
+    }
+    for (uint32_t i = 0; i < groupCount; ++i) {
+        auto *lodGroup = lodGroups[i].get();
+        _groupFlags[i] = 0;
+        if (!lodGroup->isEnabled() || !lodGroup->getNode()) {
+            continue;
+        }
+        // lodLevels is not empty, indicating that the user force to use certain layers of LOD
+        if (!lodGroup->getLockedLODLevels().empty()) {
+            updateLockedLodGroup(lodGroup, i);
+            continue;
+        }
+        //The LOD of the last frame is forced to be used, all cameras need to select their levels again.
+        if (lodGroup->isLockLevelChanged()) {
+            lodGroup->resetLockChangeFlag();
+            setLevelInvisibleForAll(i);
+            for (auto &state : _cameraStates) {
+                state.lodInfos[i] = {};
+                state.dirty = true;
+            }
+        }
 
-                    for (uint8_t visibleIndex : lodLevels) {
-                        const auto &vecModels = lodModels.at(visibleIndex);
-                        for (const auto &model : vecModels) {
-                            if (model->getNode() && model->getNode()->isActive()) {
-                                auto &modelInfo = _modelsInLODGroup[model];
-                                for (const auto &visibleCamera : _lodStateInCamera) {
-                                    modelInfo.emplace(visibleCamera.first, true);
-                                }
-                            }
-                        }
-                    }
-                }
+        const auto *node = lodGroup->getNode();
+        Vec3 center{lodGroup->getLocalBoundaryCenter()};
+        center.transformMat4(node->getWorldMatrix());
+        _centerX[i] = center.x;
+        _centerY[i] = center.y;
+        _centerZ[i] = center.z;
+        _worldSize[i] = lodGroup->getWorldSpaceSize();
+        _groupFlags[i] = LOD_GROUP_EVALUATED;
+        if (node->getChangedFlags() > 0) {
+            _groupFlags[i] |= LOD_GROUP_CHANGED;
+            anyGroupChanged = true;
+        }
+    }
+
+    //select the levels of all LODGroups for every camera, and update the visibility of the models whose level changed
+    const float deltaTime = Root::getInstance()->getFrameTime();
+    for (uint32_t c = 0; c < static_cast<uint32_t>(_cameras.size()); ++c) {
+        const auto *camera = _cameras[c];
+        auto &state = _cameraStates[c];
+        const bool cameraChanged = camera->getNode()->getChangedFlags() > 0;
+        //Changes in the camera matrix or changes in the matrix of the node where lodGroup is located or the transformDirty marker is true, etc. All need to recalculate the visible level of LOD.
+        if (!cameraChanged && !anyGroupChanged && !state.dirty && state.fadingCount == 0) {
+            continue;
+        }
+        state.dirty = false;
+        state.fadingCount = 0;
+
+        computeLODScreenUsage(camera, paddedCount, _centerX.data(), _centerY.data(), _centerZ.data(), _worldSize.data(), _screenUsage.data());
+
+        for (uint32_t i = 0; i < groupCount; ++i) {
+            const auto flags = _groupFlags[i];
+            if (!(flags & LOD_GROUP_EVALUATED)) {
                 continue;
             }
+            const auto *lodGroup = lodGroups[i].get();
+            auto &lodInfo = state.lodInfos[i];
+            const auto lastUsedLevel = lodInfo.usedLevel;
+            const auto lastFadeOutLevel = lodInfo.fadeOutLevel;
+
+            if (lodInfo.fadeOutLevel >= 0) {
+                const float duration = lodGroup->getCrossFadeDuration();
+                lodInfo.fadeProgress = duration > 0.F ? lodInfo.fadeProgress + deltaTime / duration : 1.F;
+                if (lodInfo.fadeProgress >= 1.F) {
+                    lodInfo.fadeOutLevel = -1;
+                    lodInfo.fadeProgress = 0.F;
+                }
+            }
 
-            //Normal Process, no LOD is forced.
-            bool hasUpdated = false;
-            for (auto &visibleCamera : _lodStateInCamera) {
-                auto cameraChangeFlags = visibleCamera.first->getNode()->getChangedFlags();
-                auto lodGroupChangeFlags = lodGroup->getNode()->getChangedFlags();
-                auto &lodInfo = visibleCamera.second[lodGroup];
-                //Changes in the camera matrix or changes in the matrix of the node where lodGroup is located or the transformDirty marker is true, etc. All need to recalculate the visible level of LOD.
-                if (cameraChangeFlags > 0 || lodGroupChangeFlags > 0 || lodInfo.transformDirty) {
-                    if (lodInfo.transformDirty) {
-                        lodInfo.transformDirty = false;
+            if (cameraChanged || (flags & LOD_GROUP_CHANGED) || lodInfo.transformDirty) {
+                // no hysteresis for the first selection, there is no valid level to stick to
+                const float hysteresis = lodInfo.transformDirty ? 0.F : lodGroup->getHysteresis();
+                const bool isFirstSelection = lodInfo.transformDirty;
+                lodInfo.transformDirty = false;
+                const int8_t index = lodGroup->selectLODLevel(_screenUsage[i], lodInfo.usedLevel, hysteresis);
+                if (index != lodInfo.usedLevel) {
+                    if (!isFirstSelection && lodInfo.usedLevel >= 0 && lodGroup->getCrossFadeDuration() > 0.F) {
+                        lodInfo.fadeOutLevel = lodInfo.usedLevel;
+                        lodInfo.fadeProgress = 0.F;
                     }
-
-                    int8_t index = lodGroup->getVisibleLODLevel(visibleCamera.first);
-                    if (index != lodInfo.usedLevel) {
-                        lodInfo.lastUsedLevel = lodInfo.usedLevel;
-                        lodInfo.usedLevel = index;
-                        hasUpdated = true;
+                    if (lodInfo.fadeOutLevel == index) {
+                        lodInfo.fadeOutLevel = -1;
                     }
+                    lodInfo.usedLevel = index;
                 }
             }
 
-            //The LOD of the last frame is forced to be used, the list of visible cameras of modelInfo needs to be updated.
-            const auto &lodModels = _levelModels[lodGroup];
-            if (lodGroup->isLockLevelChanged()) {
-                lodGroup->resetLockChangeFlag();
+            if (lodInfo.fadeOutLevel >= 0) {
+                ++state.fadingCount;
+            }
 
-                for (const auto &level : lodModels) {
-                    const auto &vecModels = lodModels.at(level.first);
-                    for (const auto &model : vecModels) {
-                        _modelsInLODGroup[model].clear();
-                    }
-                }
-                hasUpdated = true;
-            } else if (hasUpdated) {
-                for (auto &visibleCamera : _lodStateInCamera) {
-                    const auto &lodInfo = visibleCamera.second[lodGroup];
-                    int8_t usedLevel = lodInfo.usedLevel;
-                    if (lodInfo.usedLevel != lodInfo.lastUsedLevel && lodInfo.lastUsedLevel >= 0) {
-                        const auto &vecModels = lodModels.at(static_cast<uint8_t>(lodInfo.lastUsedLevel));
-                        for (const auto &model : vecModels) {
-                            _modelsInLODGroup[model].clear();
-                        }
-                    }
-                }
+            //Update the visibility of the models on the levels which become visible or invisible.
+            if (lodInfo.usedLevel == lastUsedLevel && lodInfo.fadeOutLevel == lastFadeOutLevel) {
+                continue;
             }
-            //Update the visible camera list of all models on lodGroup.
-            if (hasUpdated) {
-                for (auto &visibleCamera : _lodStateInCamera) {
-                    int8_t usedLevel = visibleCamera.second[lodGroup].usedLevel;
-                    if (usedLevel >= 0) {
-                        const auto &vecModels = lodModels.at(static_cast<uint8_t>(usedLevel));
-                        for (const auto &model : vecModels) {
-                            if (model->getNode() && model->getNode()->isActive()) {
-                                auto &modelInfo = _modelsInLODGroup[model];
-                                modelInfo.emplace(visibleCamera.first, true);
-                            }
-                        }
-                    }
-                }
+            if (lastUsedLevel != lodInfo.usedLevel && lastUsedLevel != lodInfo.fadeOutLevel) {
+                setLevelVisible(i, lastUsedLevel, c, false);
             }
+            if (lastFadeOutLevel != lodInfo.usedLevel && lastFadeOutLevel != lodInfo.fadeOutLevel) {
+                setLevelVisible(i, lastFadeOutLevel, c, false);
+            }
+            setLevelVisible(i, lodInfo.usedLevel, c, true);
+            setLevelVisible(i, lodInfo.fadeOutLevel, c, true);
         }
     }
 }
 
-bool LodStateCache::isLodModelCulled(const Camera *camera, const Model *model) {
-    const auto &itModel = _modelsInLODGroup.find(model);
-    if (itModel == _modelsInLODGroup.end()) {
+bool LodStateCache::isLodModelCulled(const Camera *camera, const Model *model) const {
+    const auto index = model->getLODVisibilityIndex();
+    if (index == LODVisibility::INVALID_INDEX) {
         return false;
     }
+    const auto cameraIndex = findCamera(camera);
+    return cameraIndex == LODVisibility::INVALID_INDEX || !_visibility.isVisible(cameraIndex, index);
+}
 
-    const auto &visibleCamera = itModel->second;
-    return visibleCamera.count(camera) == 0;
+const LodStateCache::LODInfo *LodStateCache::getLODInfo(const Camera *camera, uint32_t index) const {
+    const auto cameraIndex = findCamera(camera);
+    if (cameraIndex == LODVisibility::INVALID_INDEX || index >= _cameraStates[cameraIndex].lodInfos.size()) {
+        return nullptr;
+    }
+    return &_cameraStates[cameraIndex].lodInfos[index];
 }
 
 void LodStateCache::clearCache() {
+    for (const auto &levels : _levelModels) {
+        for (const auto &models : levels) {
+            for (auto *model : models) {
+                model->setLODVisibilityIndex(LODVisibility::INVALID_INDEX);
+            }
+        }
+    }
     _levelModels.clear();
-    _modelsInLODGroup.clear();
-    _lodStateInCamera.clear();
-    _newAddedLodGroupVec.clear();
+    _pendingGroups.clear();
+    _pendingGroupCount = 0;
+    _visibility.clear();
+    _cameras.clear();
+    _cameraStates.clear();
 }
 
 } // namespace scene
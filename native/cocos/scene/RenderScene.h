@@ -50,12 +50,23 @@ class SpotLight;
 class PointLight;
 class RangedDirectionalLight;
 class LodStateCache;
+class LocalBufferPool;
 
 struct IRaycastResult {
     Node *node{nullptr};
     float distance{0.F};
 };
 
+struct ModelUpdateStats {
+    // models whose local data was recomputed by the dirty model update in the last frame
+    uint32_t dirtyModels{0};
+    // models which can't be tracked and are still updated every frame, e.g. skinning models or models implemented in JS
+    uint32_t untrackedModels{0};
+    // buffer updates issued for the pooled local UBOs and the bytes they uploaded
+    uint32_t localBufferUploads{0};
+    uint32_t localBufferBytes{0};
+};
+
 struct IRenderSceneInfo {
     ccstd::string name;
 };
@@ -79,6 +90,16 @@ public:
     void removeLODGroup(LODGroup *group);
     void removeLODGroups();
     bool isCulledByLod(const Camera *camera, const Model *model) const;
+    /**
+     * @en The LOD level selected for the camera in the last update, -1 if no level is used.
+     * @zh 上一次更新中该相机下 LODGroup 使用的层级，-1 表示没有层级被使用。
+     */
+    int8_t getLODLevel(const Camera *camera, const LODGroup *group) const;
+    /**
+     * @en The LOD level which is fading out under the camera and its fading progress in [0, 1), -1 if not cross-fading.
+     * @zh 该相机下正在淡出的 LOD 层级及其进度 [0, 1)，-1 表示没有在淡入淡出。
+     */
+    int8_t getLODCrossFade(const Camera *camera, const LODGroup *group, float *progress) const;
 
     void unsetMainLight(DirectionalLight *dl);
     void addDirectionalLight(DirectionalLight *dl);
@@ -110,6 +131,21 @@ public:
 
     void onGlobalPipelineStateChanged();
 
+    /**
+     * @en Only updates the models flagged by the transform notifications of their node or by their own setters,
+     * on the job workers, and uploads their local UBOs from a shared staging memory with one buffer update per page.
+     * @zh 只更新由节点变换通知或自身属性标记为脏的模型，在工作线程中并行计算，并将本地 UBO 写入共享的暂存内存，每页只上传一次。
+     */
+    void setDirtyModelUpdate(bool enabled);
+    inline bool isDirtyModelUpdate() const { return _dirtyModelUpdate; }
+    inline const ModelUpdateStats &getModelUpdateStats() const { return _modelUpdateStats; }
+    /**
+     * @en The staging copy of the local UBO of a model tracked by the dirty model update, as uploaded by the last update.
+     * nullptr for the models which are not tracked.
+     * @zh 脏模型更新所跟踪模型的本地 UBO 暂存数据，即上次更新所上传的内容。未被跟踪的模型返回 nullptr。
+     */
+    const uint8_t *getPooledLocalData(const Model *model) const;
+
     inline DirectionalLight *getMainLight() const { return _mainLight.get(); }
     void setMainLight(DirectionalLight *dl);
 
@@ -127,10 +163,16 @@ public:
     inline const ccstd::vector<DrawBatch2D *> &getBatches() const { return _batches; }
 
 private:
+    void updateSHUBOs();
+    void updateDirtyModels(uint32_t stamp);
+    void setModelTracking(Model *model, bool enabled);
+    void cullClusters();
+
     ccstd::string _name;
     uint64_t _modelId{0};
     IntrusivePtr<DirectionalLight> _mainLight;
     IntrusivePtr<LodStateCache> _lodStateCache;
+    IntrusivePtr<LocalBufferPool> _localBufferPool;
     ccstd::vector<IntrusivePtr<Model>> _models;
     ccstd::vector<IntrusivePtr<Camera>> _cameras;
     ccstd::vector<IntrusivePtr<DirectionalLight>> _directionalLights;
@@ -140,7 +182,13 @@ private:
     ccstd::vector<IntrusivePtr<PointLight>> _pointLights;
     ccstd::vector<IntrusivePtr<RangedDirectionalLight>> _rangedDirLights;
     ccstd::vector<DrawBatch2D *> _batches;
+    ccstd::vector<Model *> _shDirtyModels;
+    ccstd::vector<Model *> _dirtyModels;
+    ccstd::vector<Model *> _untrackedModels;
+    ccstd::vector<uint8_t> _transformChanged;
+    ModelUpdateStats _modelUpdateStats;
     Octree *_octree{nullptr};
+    bool _dirtyModelUpdate{false};
 
     CC_DISALLOW_COPY_MOVE_ASSIGN(RenderScene);
 };
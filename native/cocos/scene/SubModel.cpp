@@ -37,8 +37,36 @@
 namespace cc {
 namespace scene {
 
+CC_SLAB_ALLOCATOR_IMPL(SubModel, 256)
+
 const ccstd::string INST_MAT_WORLD = "a_matWorld0";
 const ccstd::string INST_SH = "a_sh_linear_const_r";
+const ccstd::string OCT_NORMAL_MACRO = "CC_USE_OCT_NORMAL";
+
+namespace {
+
+// Normals packed by MeshOptimizer are two normalized shorts in octahedral mapping,
+// the shader has to unpack them.
+bool hasOctahedralNormal(const RenderingSubMesh *subMesh) {
+    for (const auto &attr : subMesh->getAttributes()) {
+        if (attr.name == gfx::ATTR_NAME_NORMAL) {
+            return attr.format == gfx::Format::RG16I && attr.isNormalized;
+        }
+    }
+    return false;
+}
+
+void patchSubMeshMacros(ccstd::vector<IMacroPatch> &patches, const RenderingSubMesh *subMesh) {
+    patches.erase(std::remove_if(patches.begin(), patches.end(), [](const IMacroPatch &patch) {
+                      return patch.name == OCT_NORMAL_MACRO;
+                  }),
+                  patches.end());
+    if (subMesh && hasOctahedralNormal(subMesh)) {
+        patches.emplace_back(OCT_NORMAL_MACRO, true);
+    }
+}
+
+} // namespace
 
 cc::TypedArray getTypedArrayConstructor(const cc::gfx::FormatInfo &info, cc::ArrayBuffer *buffer, uint32_t byteOffset, uint32_t length) {
     const uint32_t stride = info.size / info.count;
@@ -100,6 +128,7 @@ void SubModel::setPasses(const SharedPassArray &pPasses) {
 
     _passes = pPasses;
     flushPassInfo();
+    _isInstancingHashDirty = true;
 
     const auto &passes = *_passes;
     // DS layout might change too
@@ -145,7 +174,9 @@ void SubModel::initialize(RenderingSubMesh *subMesh, const SharedPassArray &pPas
     }
 
     _subMesh = subMesh;
+    _isInstancingHashDirty = true;
     ccstd::vector<IMacroPatch> tmp = patches;
+    patchSubMeshMacros(tmp, subMesh);
     std::sort(tmp.begin(), tmp.end(), IMacroPatch::compare);
     _patches = tmp;
     _passes = pPasses;
@@ -192,6 +223,8 @@ void SubModel::initialize(RenderingSubMesh *subMesh, const SharedPassArray &pPas
 }
 
 void SubModel::destroy() {
+    CC_SAFE_DESTROY_NULL(_clusterIndexBuffer);
+    _clusterIndices.clear();
     CC_SAFE_DESTROY_NULL(_descriptorSet);
     CC_SAFE_DESTROY_NULL(_inputAssembler);
     CC_SAFE_DESTROY_NULL(_worldBoundDescriptorSet);
@@ -240,6 +273,7 @@ void SubModel::onMacroPatchesStateChanged(const ccstd::vector<IMacroPatch> &patc
     }
 
     ccstd::vector<IMacroPatch> tmp = patches;
+    patchSubMeshMacros(tmp, _subMesh);
     std::sort(tmp.begin(), tmp.end(), IMacroPatch::compare);
     if (std::equal(std::begin(tmp), std::end(tmp), std::begin(_patches), std::end(_patches))) {
         return;
@@ -357,9 +391,112 @@ void SubModel::flushPassInfo() {
 
 void SubModel::setSubMesh(RenderingSubMesh *subMesh) {
     const auto &passes = *_passes;
+    const bool clusterCulling = isClusterCullingEnabled();
+    if (clusterCulling) {
+        setClusterCulling(false);
+    }
     _inputAssembler->destroy();
     _inputAssembler->initialize(subMesh->getIaInfo());
+    const bool normalLayoutChanged = !_subMesh || hasOctahedralNormal(_subMesh) != hasOctahedralNormal(subMesh);
     _subMesh = subMesh;
+    _isInstancingHashDirty = true;
+
+    if (normalLayoutChanged) {
+        patchSubMeshMacros(_patches, subMesh);
+        std::sort(_patches.begin(), _patches.end(), IMacroPatch::compare);
+        for (Pass *pass : passes) {
+            pass->beginChangeStatesSilently();
+            pass->tryCompile(); // force update shaders
+            pass->endChangeStatesSilently();
+        }
+        flushPassInfo();
+    }
+    if (clusterCulling) {
+        setClusterCulling(true);
+    }
+}
+
+bool SubModel::setClusterCulling(bool enabled) {
+    if (enabled == isClusterCullingEnabled()) {
+        return enabled;
+    }
+
+    if (!enabled) {
+        CC_SAFE_DESTROY_NULL(_clusterIndexBuffer);
+        _clusterIndices.clear();
+        _clusterCullingStats = {};
+        _inputAssembler->destroy();
+        _inputAssembler->initialize(_subMesh->getIaInfo());
+        _isInstancingHashDirty = true;
+        return false;
+    }
+
+    const auto &indices = _subMesh->getMeshletIndices();
+    if (_subMesh->getMeshlets().empty() || indices.empty()) {
+        return false;
+    }
+    // every instance culls differently, they can't share one draw
+    for (const auto &pass : *_passes) {
+        if (pass->getBatchingScheme() == BatchingSchemes::INSTANCING) {
+            return false;
+        }
+    }
+
+    const auto size = static_cast<uint32_t>(indices.size() * sizeof(uint32_t));
+    _clusterIndexBuffer = _device->createBuffer({
+        gfx::BufferUsageBit::INDEX | gfx::BufferUsageBit::TRANSFER_DST,
+        gfx::MemoryUsageBit::HOST | gfx::MemoryUsageBit::DEVICE,
+        size,
+        sizeof(uint32_t),
+    });
+    _clusterIndexBuffer->update(indices.data(), size);
+    _clusterIndices.resize(indices.size());
+
+    auto iaInfo = _subMesh->getIaInfo();
+    iaInfo.indexBuffer = _clusterIndexBuffer;
+    _inputAssembler->destroy();
+    _inputAssembler->initialize(iaInfo);
+    _inputAssembler->setFirstIndex(0);
+    _inputAssembler->setIndexCount(static_cast<uint32_t>(indices.size()));
+    _isInstancingHashDirty = true;
+    return true;
+}
+
+void SubModel::cullClusters(const Mat4 &worldMatrix, const MeshletCullingView *views, uint32_t viewCount) {
+    if (!isClusterCullingEnabled()) {
+        return;
+    }
+
+    // the normal cone test is only valid if back faces are culled in every pass
+    bool backfaceCulling = true;
+    for (const auto &pass : *_passes) {
+        backfaceCulling = backfaceCulling && pass->getRasterizerState()->cullMode == gfx::CullMode::BACK;
+    }
+
+    const uint32_t indexCount = MeshCluster::cull(_subMesh->getMeshlets(), _subMesh->getMeshletIndices().data(), worldMatrix,
+                                                  views, viewCount, backfaceCulling, _clusterIndices.data(), &_clusterCullingStats);
+    if (indexCount > 0) {
+        _clusterIndexBuffer->update(_clusterIndices.data(), indexCount * sizeof(uint32_t));
+    }
+    _inputAssembler->setIndexCount(indexCount);
+}
+
+ccstd::hash_t SubModel::getInstancingHash() {
+    if (!_isInstancingHashDirty && _instancingHashTextureVersion == _descriptorSet->getTextureVersion()) {
+        return _instancingHash;
+    }
+
+    ccstd::hash_t hash = 0;
+    ccstd::hash_combine(hash, _inputAssembler->getIndexBuffer());
+    ccstd::hash_combine(hash, _descriptorSet->getTexture(pipeline::LIGHTMAPTEXTURE::BINDING));
+    ccstd::hash_combine(hash, _descriptorSet->getTexture(pipeline::REFLECTIONPROBECUBEMAP::BINDING));
+    ccstd::hash_combine(hash, _descriptorSet->getTexture(pipeline::REFLECTIONPROBEPLANARMAP::BINDING));
+    ccstd::hash_combine(hash, _descriptorSet->getTexture(pipeline::REFLECTIONPROBEBLENDCUBEMAP::BINDING));
+    ccstd::hash_combine(hash, _reflectionProbeType);
+    _instancingHash = hash;
+    _instancingHashTextureVersion = _descriptorSet->getTextureVersion();
+    _isInstancingHashDirty = false;
+    return _instancingHash;
 }
 
 void SubModel::setInstancedAttribute(const ccstd::string &name, const TypedArray &value) {
@@ -28,7 +28,9 @@
 #include <memory>
 #include "base/Ptr.h"
 #include "base/RefCounted.h"
+#include "base/std/hash/hash.h"
 #include "core/assets/RenderingSubMesh.h"
+#include "core/memop/SlabAllocator.h"
 #include "renderer/gfx-base/GFXDescriptorSet.h"
 #include "renderer/gfx-base/GFXInputAssembler.h"
 #include "renderer/gfx-base/GFXShader.h"
@@ -47,6 +49,8 @@ struct InstancedAttributeBlock {
 using SharedPassArray = std::shared_ptr<ccstd::vector<IntrusivePtr<Pass>>>;
 
 class SubModel : public RefCounted {
+    CC_SLAB_ALLOCATED
+
 public:
     SubModel();
     ~SubModel() override = default;
@@ -57,8 +61,14 @@ public:
     Pass *getPass(uint32_t) const;
 
     inline void setWorldBoundDescriptorSet(gfx::DescriptorSet *descriptorSet) { _worldBoundDescriptorSet = descriptorSet; }
-    inline void setDescriptorSet(gfx::DescriptorSet *descriptorSet) { _descriptorSet = descriptorSet; }
-    inline void setInputAssembler(gfx::InputAssembler *ia) { _inputAssembler = ia; }
+    inline void setDescriptorSet(gfx::DescriptorSet *descriptorSet) {
+        _descriptorSet = descriptorSet;
+        _isInstancingHashDirty = true;
+    }
+    inline void setInputAssembler(gfx::InputAssembler *ia) {
+        _inputAssembler = ia;
+        _isInstancingHashDirty = true;
+    }
     inline void setShaders(const ccstd::vector<IntrusivePtr<gfx::Shader>> &shaders) { _shaders = shaders; }
     void setPasses(const SharedPassArray &passes);
     inline void setPriority(pipeline::RenderPriority priority) { _priority = priority; }
@@ -92,7 +102,28 @@ public:
     void updateInstancedWorldMatrix(const Mat4 &mat, int32_t idx);
     void updateInstancedSH(const Float32Array &data, int32_t idx);
     inline int32_t getReflectionProbeType() const { return _reflectionProbeType; }
-    void setReflectionProbeType(int32_t val) { _reflectionProbeType = val; }
+    void setReflectionProbeType(int32_t val) {
+        _reflectionProbeType = val;
+        _isInstancingHashDirty = true;
+    }
+
+    /**
+     * @en Hash of the state that sub models merged into one instanced draw must share: index buffer, lightmap,
+     * reflection probe textures and reflection probe type. It is only recomputed after that state changed.
+     * @zh 合批到同一个实例化绘制的子模型必须相同的状态的哈希值，仅在这些状态变化后重新计算。
+     */
+    ccstd::hash_t getInstancingHash();
+
+    /**
+     * @en Draws only the meshlets which survive cullClusters(), through an index buffer owned by this sub model.
+     * Requires a sub mesh with meshlets and no instanced pass.
+     * @zh 仅绘制通过 cullClusters() 的网格簇，使用此子模型独有的索引缓冲。需要子网格带有网格簇且没有实例化的 pass。
+     * @return Whether cluster culling is enabled.
+     */
+    bool setClusterCulling(bool enabled);
+    inline bool isClusterCullingEnabled() const { return _clusterIndexBuffer != nullptr; }
+    void cullClusters(const Mat4 &worldMatrix, const MeshletCullingView *views, uint32_t viewCount);
+    inline const MeshletCullingStats &getClusterCullingStats() const { return _clusterCullingStats; }
 
 protected:
     void flushPassInfo();
@@ -123,6 +154,14 @@ protected:
 
     int32_t _reflectionProbeType{0};
 
+    IntrusivePtr<gfx::Buffer> _clusterIndexBuffer;
+    ccstd::vector<uint32_t> _clusterIndices;
+    MeshletCullingStats _clusterCullingStats;
+
+    ccstd::hash_t _instancingHash{0};
+    uint32_t _instancingHashTextureVersion{0};
+    bool _isInstancingHashDirty{true};
+
 private:
     static inline int32_t generateId() {
         static int32_t generator = 0;
@@ -0,0 +1,216 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <cstring>
+
+#include "gtest/gtest.h"
+#include "renderer/gfx-base/GFXBuffer.h"
+#include "renderer/gfx-base/GFXCommandBuffer.h"
+#include "renderer/gfx-base/GFXDescriptorSet.h"
+#include "renderer/gfx-base/GFXDescriptorSetLayout.h"
+#include "renderer/gfx-base/GFXFramebuffer.h"
+#include "renderer/gfx-base/GFXInputAssembler.h"
+#include "renderer/gfx-base/GFXPipelineLayout.h"
+#include "renderer/gfx-base/GFXPipelineState.h"
+#include "renderer/gfx-base/GFXQueue.h"
+#include "renderer/gfx-base/GFXRenderPass.h"
+#include "renderer/gfx-base/GFXShader.h"
+#include "renderer/gfx-empty/EmptyDevice.h"
+#include "renderer/gfx-recorder/CaptureReplayer.h"
+#include "renderer/gfx-recorder/DeviceRecorder.h"
+
+using namespace cc;
+using namespace cc::gfx;
+
+namespace {
+
+void expectStatsEqual(const RecorderFrameStats &lhs, const RecorderFrameStats &rhs) {
+    EXPECT_EQ(lhs.drawCalls, rhs.drawCalls);
+    EXPECT_EQ(lhs.instances, rhs.instances);
+    EXPECT_EQ(lhs.dispatches, rhs.dispatches);
+    EXPECT_EQ(lhs.renderPasses, rhs.renderPasses);
+    EXPECT_EQ(lhs.pipelineBinds, rhs.pipelineBinds);
+    EXPECT_EQ(lhs.descriptorSetBinds, rhs.descriptorSetBinds);
+    EXPECT_EQ(lhs.inputAssemblerBinds, rhs.inputAssemblerBinds);
+    EXPECT_EQ(lhs.barriers, rhs.barriers);
+    EXPECT_EQ(lhs.submits, rhs.submits);
+    EXPECT_EQ(lhs.bytesUploaded, rhs.bytesUploaded);
+}
+
+// records one frame drawing a quad twice on an EmptyDevice behind the recorder
+ccstd::vector<uint8_t> captureFrame(RecorderFrameStats &frameStats) {
+    auto *device = ccnew DeviceRecorder(ccnew EmptyDevice());
+    device->initialize({});
+
+    const float vertices[12]{};
+    const float uniforms[16]{1.F};
+
+    auto *vertexBuffer = device->createBuffer({BufferUsageBit::VERTEX, MemoryUsageBit::DEVICE, sizeof(vertices), 3 * sizeof(float)});
+    vertexBuffer->update(vertices);
+    auto *uniformBuffer = device->createBuffer({BufferUsageBit::UNIFORM, MemoryUsageBit::HOST | MemoryUsageBit::DEVICE, sizeof(uniforms)});
+
+    auto *inputAssembler = device->createInputAssembler({{{"a_position", Format::RGB32F}}, {vertexBuffer}});
+    auto *setLayout = device->createDescriptorSetLayout({{{0, DescriptorType::UNIFORM_BUFFER, 1, ShaderStageFlagBit::VERTEX}}});
+    auto *pipelineLayout = device->createPipelineLayout({{setLayout}});
+    auto *descriptorSet = device->createDescriptorSet({setLayout});
+    descriptorSet->bindBuffer(0, uniformBuffer);
+    descriptorSet->update();
+
+    ShaderInfo shaderInfo;
+    shaderInfo.name = "capture-test";
+    auto *shader = device->createShader(shaderInfo);
+    auto *renderPass = device->createRenderPass(RenderPassInfo{});
+    auto *framebuffer = device->createFramebuffer({renderPass});
+
+    PipelineStateInfo psoInfo;
+    psoInfo.shader = shader;
+    psoInfo.pipelineLayout = pipelineLayout;
+    psoInfo.renderPass = renderPass;
+    auto *pipelineState = device->createPipelineState(psoInfo);
+
+    device->requestCapture();
+    device->acquire(nullptr, 0);
+
+    uniformBuffer->update(uniforms);
+    auto *cmdBuff = device->getCommandBuffer();
+    cmdBuff->begin();
+    cmdBuff->updateBuffer(uniformBuffer, uniforms, sizeof(uniforms));
+    const Color clearColor{0.F, 0.F, 0.F, 1.F};
+    cmdBuff->beginRenderPass(renderPass, framebuffer, {0, 0, 4, 4}, &clearColor, 1.F, 0);
+    cmdBuff->bindPipelineState(pipelineState);
+    cmdBuff->bindDescriptorSet(0, descriptorSet);
+    cmdBuff->bindInputAssembler(inputAssembler);
+    DrawInfo drawInfo;
+    drawInfo.vertexCount = 4;
+    cmdBuff->draw(drawInfo);
+    drawInfo.instanceCount = 3;
+    cmdBuff->draw(drawInfo);
+    cmdBuff->endRenderPass();
+    cmdBuff->end();
+    device->getQueue()->submit(&cmdBuff, 1);
+
+    device->present();
+    EXPECT_FALSE(device->isCapturing());
+
+    frameStats = device->getFrameStats();
+    auto capture = device->getCapture();
+
+    CC_SAFE_DESTROY_AND_DELETE(pipelineState);
+    CC_SAFE_DESTROY_AND_DELETE(framebuffer);
+    CC_SAFE_DESTROY_AND_DELETE(renderPass);
+    CC_SAFE_DESTROY_AND_DELETE(shader);
+    CC_SAFE_DESTROY_AND_DELETE(descriptorSet);
+    CC_SAFE_DESTROY_AND_DELETE(pipelineLayout);
+    CC_SAFE_DESTROY_AND_DELETE(setLayout);
+    CC_SAFE_DESTROY_AND_DELETE(inputAssembler);
+    CC_SAFE_DESTROY_AND_DELETE(uniformBuffer);
+    CC_SAFE_DESTROY_AND_DELETE(vertexBuffer);
+    device->destroy();
+    delete device;
+
+    return capture;
+}
+
+} // namespace
+
+TEST(CaptureReplayerTest, replayOnEmptyDevice) {
+    RecorderFrameStats frameStats;
+    auto capture = captureFrame(frameStats);
+    ASSERT_FALSE(capture.empty());
+    EXPECT_EQ(frameStats.drawCalls, 2U);
+    EXPECT_EQ(frameStats.instances, 4U);
+    EXPECT_EQ(frameStats.renderPasses, 1U);
+    EXPECT_EQ(frameStats.submits, 1U);
+    // the device level and the command buffer update of the uniform buffer
+    EXPECT_EQ(frameStats.bytesUploaded, 2 * 16 * sizeof(float));
+
+    auto *device = ccnew EmptyDevice();
+    device->initialize({});
+    {
+        CaptureReplayer replayer(device);
+        ASSERT_TRUE(replayer.load(std::move(capture)));
+        // replays are repeatable
+        for (uint32_t i = 0; i != 2; ++i) {
+            ASSERT_TRUE(replayer.replay());
+            expectStatsEqual(replayer.getRecordedStats(), frameStats);
+            expectStatsEqual(replayer.getStats(), replayer.getRecordedStats());
+        }
+    }
+    device->destroy();
+    delete device;
+}
+
+TEST(CaptureReplayerTest, rejectMalformedCapture) {
+    RecorderFrameStats frameStats;
+    const auto capture = captureFrame(frameStats);
+    ASSERT_GT(capture.size(), 64U);
+
+    auto *device = ccnew EmptyDevice();
+    device->initialize({});
+    {
+        CaptureReplayer replayer(device);
+
+        // the header is checked on load
+        EXPECT_FALSE(replayer.load({}));
+        auto badMagic = capture;
+        badMagic[0] ^= 0xFF;
+        EXPECT_FALSE(replayer.load(std::move(badMagic)));
+        auto badVersion = capture;
+        badVersion[sizeof(CAPTURE_MAGIC)] ^= 0xFF;
+        EXPECT_FALSE(replayer.load(std::move(badVersion)));
+
+        // records cut short are rejected on replay
+        auto truncated = capture;
+        truncated.resize(capture.size() - 8);
+        ASSERT_TRUE(replayer.load(std::move(truncated)));
+        EXPECT_FALSE(replayer.replay());
+
+        // an unknown record
+        auto badOp = capture;
+        badOp[sizeof(CAPTURE_MAGIC) + sizeof(CAPTURE_VERSION)] = static_cast<uint8_t>(RecordOp::COUNT);
+        ASSERT_TRUE(replayer.load(std::move(badOp)));
+        EXPECT_FALSE(replayer.replay());
+
+        // element counts beyond the end of the capture, the captured frame
+        // begins with the device objects followed by the swapchain count
+        constexpr uint32_t frameBeginOffset = sizeof(CAPTURE_MAGIC) + sizeof(CAPTURE_VERSION) + sizeof(RecordOp) + 3 * sizeof(uint32_t);
+        ASSERT_EQ(static_cast<RecordOp>(capture[frameBeginOffset]), RecordOp::FRAME_BEGIN);
+        const uint32_t countOffset = frameBeginOffset + sizeof(RecordOp);
+        auto badCount = capture;
+        const uint32_t hugeCount = 0xFFFFFFF0U;
+        memcpy(badCount.data() + countOffset, &hugeCount, sizeof(hugeCount));
+        ASSERT_TRUE(replayer.load(std::move(badCount)));
+        EXPECT_FALSE(replayer.replay());
+
+        // the reader itself stays in bounds
+        CaptureReader shortReader(capture.data(), 2);
+        EXPECT_EQ(shortReader.read<uint32_t>(), 0U);
+        EXPECT_FALSE(shortReader.isValid());
+        EXPECT_EQ(shortReader.skip(1), nullptr);
+        EXPECT_EQ(shortReader.readCount(), 0U);
+    }
+    device->destroy();
+    delete device;
+}
@@ -0,0 +1,409 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include "base/threading/MessageQueue.h"
+#include "gtest/gtest.h"
+#include "renderer/gfx-agent/CommandEncoder.h"
+#include "renderer/gfx-base/GFXCommandBuffer.h"
+
+using namespace cc;
+using namespace cc::gfx;
+
+namespace {
+
+constexpr uint32_t DRAW_CALLS = 50000;
+constexpr uint32_t COMMANDS_PER_DRAW = 4;
+
+// Discards every command. The encoded handles are fake, so the actor must not look at them,
+// unlike the empty backend whose state filter reads the bound objects.
+class NullCommandBuffer : public CommandBuffer {
+public:
+    void begin(RenderPass * /*renderPass*/, uint32_t /*subpass*/, Framebuffer * /*frameBuffer*/) override {}
+    void end() override {}
+    void beginRenderPass(RenderPass * /*renderPass*/, Framebuffer * /*fbo*/, const Rect & /*renderArea*/, const Color * /*colors*/, float /*depth*/, uint32_t /*stencil*/, CommandBuffer *const * /*secondaryCBs*/, uint32_t /*secondaryCBCount*/) override {}
+    void endRenderPass() override {}
+    void insertMarker(const MarkerInfo & /*marker*/) override {}
+    void beginMarker(const MarkerInfo & /*marker*/) override {}
+    void endMarker() override {}
+    void bindPipelineState(PipelineState * /*pso*/) override {}
+    void bindDescriptorSet(uint32_t /*set*/, DescriptorSet * /*descriptorSet*/, uint32_t /*dynamicOffsetCount*/, const uint32_t * /*dynamicOffsets*/) override {}
+    void bindInputAssembler(InputAssembler * /*ia*/) override {}
+    void setViewport(const Viewport & /*vp*/) override {}
+    void setScissor(const Rect & /*rect*/) override {}
+    void setLineWidth(float /*width*/) override {}
+    void setDepthBias(float /*constant*/, float /*clamp*/, float /*slope*/) override {}
+    void setBlendConstants(const Color & /*constants*/) override {}
+    void setDepthBound(float /*minBounds*/, float /*maxBounds*/) override {}
+    void setStencilWriteMask(StencilFace /*face*/, uint32_t /*mask*/) override {}
+    void setStencilCompareMask(StencilFace /*face*/, uint32_t /*ref*/, uint32_t /*mask*/) override {}
+    void nextSubpass() override {}
+    void draw(const DrawInfo & /*info*/) override {}
+    void updateBuffer(Buffer * /*buff*/, const void * /*data*/, uint32_t /*size*/) override {}
+    void copyBuffersToTexture(const uint8_t *const * /*buffers*/, Texture * /*texture*/, const BufferTextureCopy * /*regions*/, uint32_t /*count*/) override {}
+    void blitTexture(Texture * /*srcTexture*/, Texture * /*dstTexture*/, const TextureBlit * /*regions*/, uint32_t /*count*/, Filter /*filter*/) override {}
+    void copyTexture(Texture * /*srcTexture*/, Texture * /*dstTexture*/, const TextureCopy * /*regions*/, uint32_t /*count*/) override {}
+    void resolveTexture(Texture * /*srcTexture*/, Texture * /*dstTexture*/, const TextureCopy * /*regions*/, uint32_t /*count*/) override {}
+    void execute(CommandBuffer *const * /*cmdBuffs*/, uint32_t /*count*/) override {}
+    void dispatch(const DispatchInfo & /*info*/) override {}
+    void beginQuery(QueryPool * /*queryPool*/, uint32_t /*id*/) override {}
+    void endQuery(QueryPool * /*queryPool*/, uint32_t /*id*/) override {}
+    void resetQueryPool(QueryPool * /*queryPool*/) override {}
+    void pipelineBarrier(const GeneralBarrier * /*barrier*/, const BufferBarrier *const * /*bufferBarriers*/, const Buffer *const * /*buffers*/, uint32_t /*bufferBarrierCount*/, const TextureBarrier *const * /*textureBarriers*/, const Texture *const * /*textures*/, uint32_t /*textureBarrierCount*/) override {}
+
+protected:
+    void doInit(const CommandBufferInfo & /*info*/) override {}
+    void doDestroy() override {}
+};
+
+// Keeps the arguments of every call the encoder supports, in call order.
+class RecordingCommandBuffer final : public NullCommandBuffer {
+public:
+    using Opcode = CommandEncoder::Opcode;
+
+    struct Call {
+        Opcode op{Opcode::COUNT};
+        const void *handle{nullptr};
+        uint32_t set{0};
+        ccstd::vector<uint32_t> dynamicOffsets;
+        bool dynamicOffsetsAligned{true};
+        Viewport viewport;
+        Rect rect;
+        float values[3]{};
+        Color color;
+        StencilFace face{StencilFace::FRONT};
+        uint32_t ref{0};
+        uint32_t mask{0};
+        DrawInfo drawInfo;
+    };
+
+    void bindPipelineState(PipelineState *pso) override {
+        add(Opcode::BIND_PIPELINE_STATE).handle = pso;
+    }
+    void bindDescriptorSet(uint32_t set, DescriptorSet *descriptorSet, uint32_t dynamicOffsetCount, const uint32_t *dynamicOffsets) override {
+        auto &call = add(Opcode::BIND_DESCRIPTOR_SET);
+        call.handle = descriptorSet;
+        call.set = set;
+        call.dynamicOffsets.assign(dynamicOffsets, dynamicOffsets + dynamicOffsetCount);
+        call.dynamicOffsetsAligned = reinterpret_cast<uintptr_t>(dynamicOffsets) % alignof(uint32_t) == 0;
+    }
+    void bindInputAssembler(InputAssembler *ia) override {
+        add(Opcode::BIND_INPUT_ASSEMBLER).handle = ia;
+    }
+    void setViewport(const Viewport &vp) override {
+        add(Opcode::SET_VIEWPORT).viewport = vp;
+    }
+    void setScissor(const Rect &rect) override {
+        add(Opcode::SET_SCISSOR).rect = rect;
+    }
+    void setLineWidth(float width) override {
+        add(Opcode::SET_LINE_WIDTH).values[0] = width;
+    }
+    void setDepthBias(float constant, float clamp, float slope) override {
+        auto &call = add(Opcode::SET_DEPTH_BIAS);
+        call.values[0] = constant;
+        call.values[1] = clamp;
+        call.values[2] = slope;
+    }
+    void setBlendConstants(const Color &constants) override {
+        add(Opcode::SET_BLEND_CONSTANTS).color = constants;
+    }
+    void setDepthBound(float minBounds, float maxBounds) override {
+        auto &call = add(Opcode::SET_DEPTH_BOUND);
+        call.values[0] = minBounds;
+        call.values[1] = maxBounds;
+    }
+    void setStencilWriteMask(StencilFace face, uint32_t mask) override {
+        auto &call = add(Opcode::SET_STENCIL_WRITE_MASK);
+        call.face = face;
+        call.mask = mask;
+    }
+    void setStencilCompareMask(StencilFace face, uint32_t ref, uint32_t mask) override {
+        auto &call = add(Opcode::SET_STENCIL_COMPARE_MASK);
+        call.face = face;
+        call.ref = ref;
+        call.mask = mask;
+    }
+    void draw(const DrawInfo &info) override {
+        add(Opcode::DRAW).drawInfo = info;
+    }
+
+    ccstd::vector<Call> calls;
+
+private:
+    Call &add(Opcode op) {
+        calls.emplace_back();
+        calls.back().op = op;
+        return calls.back();
+    }
+};
+
+template <typename T>
+T *fakeHandle(uintptr_t value) {
+    return reinterpret_cast<T *>(value);
+}
+
+// typical per-draw sequence: pso, material set, local set with a dynamic offset, ia, draw
+void recordWithMessages(MessageQueue *queue, CommandBuffer *actor) {
+    DrawInfo drawInfo;
+    drawInfo.indexCount = 36;
+    for (uint32_t i = 0; i < DRAW_CALLS; ++i) {
+        auto *pso = reinterpret_cast<PipelineState *>(static_cast<uintptr_t>(i & 7U) + 1);
+        auto *ds = reinterpret_cast<DescriptorSet *>(static_cast<uintptr_t>(i) + 1);
+        auto *ia = reinterpret_cast<InputAssembler *>(static_cast<uintptr_t>(i) + 1);
+        uint32_t offset = i * 256;
+
+        ENQUEUE_MESSAGE_2(
+            queue, BenchBindPipelineState,
+            actor, actor,
+            pso, pso,
+            {
+                actor->bindPipelineState(pso);
+            });
+
+        auto *offsets = queue->allocate<uint32_t>(1);
+        *offsets = offset;
+        ENQUEUE_MESSAGE_5(
+            queue, BenchBindDescriptorSet,
+            actor, actor,
+            set, 2U,
+            ds, ds,
+            count, 1U,
+            offsets, offsets,
+            {
+                actor->bindDescriptorSet(set, ds, count, offsets);
+            });
+
+        ENQUEUE_MESSAGE_2(
+            queue, BenchBindInputAssembler,
+            actor, actor,
+            ia, ia,
+            {
+                actor->bindInputAssembler(ia);
+            });
+
+        ENQUEUE_MESSAGE_2(
+            queue, BenchDraw,
+            actor, actor,
+            info, drawInfo,
+            {
+                actor->draw(info);
+            });
+    }
+}
+
+void submitEncoded(MessageQueue *queue, CommandBuffer *actor, CommandEncoder &encoder, uint32_t *decoded) {
+    uint32_t size = encoder.size();
+    uint8_t *data = queue->allocateAndCopy<uint8_t>(size, encoder.data());
+    encoder.clear();
+
+    ENQUEUE_MESSAGE_4(
+        queue, BenchExecuteBytecode,
+        actor, actor,
+        data, data,
+        size, size,
+        decoded, decoded,
+        {
+            *decoded += CommandEncoder::decode(actor, data, size);
+        });
+}
+
+void recordWithBytecode(MessageQueue *queue, CommandBuffer *actor, uint32_t *decoded) {
+    CommandEncoder encoder;
+    DrawInfo drawInfo;
+    drawInfo.indexCount = 36;
+    for (uint32_t i = 0; i < DRAW_CALLS; ++i) {
+        auto *pso = reinterpret_cast<PipelineState *>(static_cast<uintptr_t>(i & 7U) + 1);
+        auto *ds = reinterpret_cast<DescriptorSet *>(static_cast<uintptr_t>(i) + 1);
+        auto *ia = reinterpret_cast<InputAssembler *>(static_cast<uintptr_t>(i) + 1);
+        uint32_t offset = i * 256;
+
+        if (!encoder.hasRoom(CommandEncoder::MAX_FIXED_COMMAND_SIZE * 3 + CommandEncoder::descriptorSetCommandSize(1))) {
+            submitEncoded(queue, actor, encoder, decoded);
+        }
+        encoder.bindPipelineState(pso);
+        encoder.bindDescriptorSet(2, ds, 1, &offset);
+        encoder.bindInputAssembler(ia);
+        encoder.draw(drawInfo);
+    }
+    if (!encoder.empty()) submitEncoded(queue, actor, encoder, decoded);
+}
+
+template <typename F>
+double measure(F &&record) {
+    auto *queue = ccnew MessageQueue;
+    queue->setImmediateMode(false);
+
+    auto start = std::chrono::steady_clock::now();
+    record(queue);
+    queue->finishWriting();
+    queue->flushMessages();
+    auto end = std::chrono::steady_clock::now();
+
+    delete queue;
+    return std::chrono::duration<double>(end - start).count();
+}
+
+} // namespace
+
+TEST(CommandEncoderTest, roundTrip) {
+    using Opcode = CommandEncoder::Opcode;
+    CommandEncoder encoder;
+
+    // the pso command leaves the offsets of the first set off a 4-byte boundary
+    const uint32_t offsets[3] = {16, 32, 64};
+    const uint32_t moreOffsets[1] = {1024};
+    DrawInfo drawInfo;
+    drawInfo.vertexCount = 3;
+    drawInfo.firstVertex = 4;
+    drawInfo.indexCount = 36;
+    drawInfo.firstIndex = 6;
+    drawInfo.vertexOffset = -2;
+    drawInfo.instanceCount = 5;
+    drawInfo.firstInstance = 7;
+
+    encoder.bindPipelineState(fakeHandle<PipelineState>(0x10));
+    encoder.bindDescriptorSet(0, fakeHandle<DescriptorSet>(0x20), 3, offsets);
+    encoder.bindDescriptorSet(1, fakeHandle<DescriptorSet>(0x30), 0, nullptr);
+    encoder.bindInputAssembler(fakeHandle<InputAssembler>(0x40));
+    encoder.setViewport({1, 2, 128, 64, 0.25F, 0.75F});
+    encoder.setScissor({3, 4, 100, 50});
+    encoder.setLineWidth(2.F);
+    encoder.setDepthBias(0.5F, 1.5F, 2.5F);
+    encoder.setBlendConstants({0.1F, 0.2F, 0.3F, 0.4F});
+    encoder.setDepthBound(0.125F, 0.875F);
+    encoder.setStencilWriteMask(StencilFace::ALL, 0xf0);
+    encoder.setStencilCompareMask(StencilFace::FRONT, 1, 0x0f);
+    // the stencil command leaves this one unaligned too
+    encoder.bindDescriptorSet(2, fakeHandle<DescriptorSet>(0x50), 1, moreOffsets);
+    encoder.draw(drawInfo);
+    EXPECT_EQ(encoder.getCommandCount(), 14);
+
+    // decoded in place and from a 16-byte aligned copy, as the agent ships it
+    alignas(16) uint8_t copy[CommandEncoder::CAPACITY];
+    memcpy(copy, encoder.data(), encoder.size());
+    for (const uint8_t *data : {encoder.data(), static_cast<const uint8_t *>(copy)}) {
+        RecordingCommandBuffer actor;
+        EXPECT_EQ(CommandEncoder::decode(&actor, data, encoder.size()), 14);
+        const auto &calls = actor.calls;
+        ASSERT_EQ(calls.size(), 14);
+
+        EXPECT_EQ(calls[0].op, Opcode::BIND_PIPELINE_STATE);
+        EXPECT_EQ(calls[0].handle, fakeHandle<PipelineState>(0x10));
+
+        EXPECT_EQ(calls[1].op, Opcode::BIND_DESCRIPTOR_SET);
+        EXPECT_EQ(calls[1].set, 0);
+        EXPECT_EQ(calls[1].handle, fakeHandle<DescriptorSet>(0x20));
+        EXPECT_EQ(calls[1].dynamicOffsets, ccstd::vector<uint32_t>(offsets, offsets + 3));
+        EXPECT_TRUE(calls[1].dynamicOffsetsAligned);
+
+        EXPECT_EQ(calls[2].op, Opcode::BIND_DESCRIPTOR_SET);
+        EXPECT_EQ(calls[2].set, 1);
+        EXPECT_EQ(calls[2].handle, fakeHandle<DescriptorSet>(0x30));
+        EXPECT_TRUE(calls[2].dynamicOffsets.empty());
+
+        EXPECT_EQ(calls[3].op, Opcode::BIND_INPUT_ASSEMBLER);
+        EXPECT_EQ(calls[3].handle, fakeHandle<InputAssembler>(0x40));
+
+        EXPECT_EQ(calls[4].op, Opcode::SET_VIEWPORT);
+        EXPECT_EQ(calls[4].viewport.left, 1);
+        EXPECT_EQ(calls[4].viewport.top, 2);
+        EXPECT_EQ(calls[4].viewport.width, 128);
+        EXPECT_EQ(calls[4].viewport.height, 64);
+        EXPECT_EQ(calls[4].viewport.minDepth, 0.25F);
+        EXPECT_EQ(calls[4].viewport.maxDepth, 0.75F);
+
+        EXPECT_EQ(calls[5].op, Opcode::SET_SCISSOR);
+        EXPECT_EQ(calls[5].rect.x, 3);
+        EXPECT_EQ(calls[5].rect.y, 4);
+        EXPECT_EQ(calls[5].rect.width, 100);
+        EXPECT_EQ(calls[5].rect.height, 50);
+
+        EXPECT_EQ(calls[6].op, Opcode::SET_LINE_WIDTH);
+        EXPECT_EQ(calls[6].values[0], 2.F);
+
+        EXPECT_EQ(calls[7].op, Opcode::SET_DEPTH_BIAS);
+        EXPECT_EQ(calls[7].values[0], 0.5F);
+        EXPECT_EQ(calls[7].values[1], 1.5F);
+        EXPECT_EQ(calls[7].values[2], 2.5F);
+
+        EXPECT_EQ(calls[8].op, Opcode::SET_BLEND_CONSTANTS);
+        EXPECT_EQ(calls[8].color.x, 0.1F);
+        EXPECT_EQ(calls[8].color.y, 0.2F);
+        EXPECT_EQ(calls[8].color.z, 0.3F);
+        EXPECT_EQ(calls[8].color.w, 0.4F);
+
+        EXPECT_EQ(calls[9].op, Opcode::SET_DEPTH_BOUND);
+        EXPECT_EQ(calls[9].values[0], 0.125F);
+        EXPECT_EQ(calls[9].values[1], 0.875F);
+
+        EXPECT_EQ(calls[10].op, Opcode::SET_STENCIL_WRITE_MASK);
+        EXPECT_EQ(calls[10].face, StencilFace::ALL);
+        EXPECT_EQ(calls[10].mask, 0xf0);
+
+        EXPECT_EQ(calls[11].op, Opcode::SET_STENCIL_COMPARE_MASK);
+        EXPECT_EQ(calls[11].face, StencilFace::FRONT);
+        EXPECT_EQ(calls[11].ref, 1);
+        EXPECT_EQ(calls[11].mask, 0x0f);
+
+        EXPECT_EQ(calls[12].op, Opcode::BIND_DESCRIPTOR_SET);
+        EXPECT_EQ(calls[12].set, 2);
+        EXPECT_EQ(calls[12].handle, fakeHandle<DescriptorSet>(0x50));
+        EXPECT_EQ(calls[12].dynamicOffsets, ccstd::vector<uint32_t>(1, 1024));
+        EXPECT_TRUE(calls[12].dynamicOffsetsAligned);
+
+        // the draw info right behind the padded offsets
+        EXPECT_EQ(calls[13].op, Opcode::DRAW);
+        EXPECT_EQ(calls[13].drawInfo.vertexCount, 3);
+        EXPECT_EQ(calls[13].drawInfo.firstVertex, 4);
+        EXPECT_EQ(calls[13].drawInfo.indexCount, 36);
+        EXPECT_EQ(calls[13].drawInfo.firstIndex, 6);
+        EXPECT_EQ(calls[13].drawInfo.vertexOffset, -2);
+        EXPECT_EQ(calls[13].drawInfo.instanceCount, 5);
+        EXPECT_EQ(calls[13].drawInfo.firstInstance, 7);
+    }
+
+    encoder.clear();
+    EXPECT_TRUE(encoder.empty());
+    RecordingCommandBuffer actor;
+    EXPECT_EQ(CommandEncoder::decode(&actor, encoder.data(), encoder.size()), 0);
+    EXPECT_TRUE(actor.calls.empty());
+}
+
+TEST(CommandEncoderTest, DISABLED_throughput) {
+    NullCommandBuffer actor;
+    uint32_t decoded = 0;
+
+    double messageTime = measure([&](MessageQueue *queue) { recordWithMessages(queue, &actor); });
+    double bytecodeTime = measure([&](MessageQueue *queue) { recordWithBytecode(queue, &actor, &decoded); });
+
+    constexpr double COMMANDS = DRAW_CALLS * COMMANDS_PER_DRAW;
+    printf("message encoding:  %.2f M commands/s\n", COMMANDS / messageTime * 1e-6);
+    printf("bytecode encoding: %.2f M commands/s\n", COMMANDS / bytecodeTime * 1e-6);
+
+    EXPECT_EQ(decoded, DRAW_CALLS * COMMANDS_PER_DRAW);
+}
@@ -0,0 +1,179 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include <thread>
+#include "gtest/gtest.h"
+#include "renderer/gfx-base/GFXBuffer.h"
+#include "renderer/gfx-base/GFXFrameRingBuffer.h"
+#include "renderer/gfx-empty/EmptyBuffer.h"
+#include "renderer/gfx-empty/EmptyDevice.h"
+
+using namespace cc;
+using namespace cc::gfx;
+
+namespace {
+
+struct EmptyDeviceHolder {
+    EmptyDeviceHolder() {
+        device = ccnew EmptyDevice();
+        device->initialize({});
+    }
+    ~EmptyDeviceHolder() {
+        device->destroy();
+        delete device;
+    }
+    Device *device{nullptr};
+};
+
+} // namespace
+
+TEST(gfxFrameRingBufferTest, allocate) {
+    EmptyDeviceHolder holder;
+    IntrusivePtr<FrameRingBuffer> ring = ccnew FrameRingBuffer(holder.device, {BufferUsageBit::UNIFORM | BufferUsageBit::TRANSFER_DST, 1024, 256, 3});
+    EXPECT_EQ(ring->getFrameCount(), 3U);
+    EXPECT_EQ(ring->getCapacity(), 1024U);
+
+    ring->beginFrame();
+    auto *firstBuffer = ring->getBuffer();
+    const float value[4]{1.F, 2.F, 3.F, 4.F};
+    auto a = ring->allocate(value, sizeof(value));
+    auto b = ring->allocate(100);
+    ASSERT_TRUE(a.isValid());
+    ASSERT_TRUE(b.isValid());
+    EXPECT_EQ(a.offset, 0U);
+    EXPECT_EQ(b.offset, 256U);
+    EXPECT_EQ(memcmp(a.data, value, sizeof(value)), 0);
+    EXPECT_EQ(ring->getUsedBytes(), 512U);
+
+    // doesn't fit, the ring grows in the next frame
+    EXPECT_FALSE(ring->allocate(1024).isValid());
+    ring->flush();
+    // the whole frame is uploaded at once, straight from the staging memory the allocations were written to
+    auto *firstEmptyBuffer = static_cast<EmptyBuffer *>(firstBuffer);
+    EXPECT_EQ(firstEmptyBuffer->getUpdateCount(), 1U);
+    EXPECT_EQ(firstEmptyBuffer->getLastUpdateSize(), 512U);
+    EXPECT_EQ(firstEmptyBuffer->getLastUpdateData(), a.data);
+    EXPECT_EQ(ring->getStats().lastFrameBytes, 512U);
+    EXPECT_EQ(ring->getStats().lastFrameAllocations, 2U);
+
+    // flushing again uploads only what was allocated since
+    ring->flush();
+    EXPECT_EQ(firstEmptyBuffer->getUpdateCount(), 1U);
+    EXPECT_TRUE(ring->allocate(16).isValid());
+    ring->flush();
+    EXPECT_EQ(firstEmptyBuffer->getUpdateCount(), 2U);
+    EXPECT_EQ(firstEmptyBuffer->getLastUpdateSize(), 768U);
+
+    ring->beginFrame();
+    EXPECT_NE(ring->getBuffer(), firstBuffer);
+    EXPECT_EQ(ring->getStats().failedAllocations, 1U);
+    EXPECT_EQ(ring->getStats().resizes, 1U);
+    EXPECT_GE(ring->getCapacity(), 1792U);
+    EXPECT_GE(ring->getBuffer()->getSize(), ring->getCapacity());
+    auto c = ring->allocate(1024);
+    ASSERT_TRUE(c.isValid());
+    // the staging memory follows the grown buffer
+    memset(c.data, 0xFF, c.size);
+    ring->flush();
+    EXPECT_EQ(static_cast<EmptyBuffer *>(ring->getBuffer())->getLastUpdateData(), c.data);
+
+    ring->beginFrame();
+    ring->beginFrame();
+    EXPECT_EQ(ring->getBuffer(), firstBuffer);
+    EXPECT_EQ(ring->getStats().ringWraps, 1U);
+    // grown lazily when its frame came round
+    EXPECT_EQ(firstBuffer->getSize(), ring->getCapacity());
+    EXPECT_EQ(ring->getStats().peakFrameBytes, 1024U);
+}
+
+TEST(gfxFrameRingBufferTest, flushToCommandBuffer) {
+    EmptyDeviceHolder holder;
+    IntrusivePtr<FrameRingBuffer> ring = ccnew FrameRingBuffer(holder.device, {BufferUsageBit::UNIFORM | BufferUsageBit::TRANSFER_DST, 1024, 256, 2});
+    auto *cmdBuffer = holder.device->getCommandBuffer();
+
+    ring->beginFrame();
+    auto *buffer = static_cast<EmptyBuffer *>(ring->getBuffer());
+    ASSERT_TRUE(ring->allocate(64).isValid());
+    // recorded in the command buffer instead of updating the buffer directly
+    ring->flush(cmdBuffer);
+    EXPECT_EQ(buffer->getUpdateCount(), 0U);
+    EXPECT_EQ(ring->getStats().lastFrameBytes, 256U);
+    EXPECT_EQ(ring->getStats().lastFrameAllocations, 1U);
+
+    // the flush before submit has nothing left to upload
+    ring->flush();
+    EXPECT_EQ(buffer->getUpdateCount(), 0U);
+    ASSERT_TRUE(ring->allocate(64).isValid());
+    ring->flush();
+    EXPECT_EQ(buffer->getUpdateCount(), 1U);
+    EXPECT_EQ(buffer->getLastUpdateSize(), 512U);
+}
+
+TEST(gfxFrameRingBufferTest, bufferView) {
+    EmptyDeviceHolder holder;
+    IntrusivePtr<FrameRingBuffer> ring = ccnew FrameRingBuffer(holder.device, {BufferUsageBit::UNIFORM | BufferUsageBit::TRANSFER_DST, 1024, 256, 2});
+
+    ring->beginFrame();
+    auto *view = ring->getBufferView(64);
+    ASSERT_NE(view, nullptr);
+    EXPECT_TRUE(view->isBufferView());
+    EXPECT_EQ(view->getSize(), 64U);
+    // cached for the frame
+    EXPECT_EQ(ring->getBufferView(64), view);
+    EXPECT_NE(ring->getBufferView(128), view);
+
+    // the other frame has its own views
+    ring->beginFrame();
+    EXPECT_NE(ring->getBufferView(64), view);
+    ring->beginFrame();
+    EXPECT_EQ(ring->getBufferView(64), view);
+}
+
+TEST(gfxFrameRingBufferTest, concurrentAllocate) {
+    EmptyDeviceHolder holder;
+    constexpr uint32_t THREAD_COUNT = 4;
+    constexpr uint32_t ALLOCATIONS_PER_THREAD = 1000;
+    IntrusivePtr<FrameRingBuffer> ring = ccnew FrameRingBuffer(holder.device, {BufferUsageBit::UNIFORM | BufferUsageBit::TRANSFER_DST, THREAD_COUNT * ALLOCATIONS_PER_THREAD * 64, 64, 2});
+    ring->beginFrame();
+
+    ccstd::vector<std::thread> threads;
+    for (uint32_t t = 0; t < THREAD_COUNT; ++t) {
+        threads.emplace_back([&ring, t]() {
+            for (uint32_t i = 0; i < ALLOCATIONS_PER_THREAD; ++i) {
+                auto allocation = ring->allocate(48);
+                ASSERT_TRUE(allocation.isValid());
+                memset(allocation.data, static_cast<int>(t + 1), allocation.size);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    ring->flush();
+
+    // every allocation got its own aligned slot
+    EXPECT_EQ(ring->getUsedBytes(), THREAD_COUNT * ALLOCATIONS_PER_THREAD * 64);
+    EXPECT_EQ(ring->getStats().lastFrameAllocations, THREAD_COUNT * ALLOCATIONS_PER_THREAD);
+    EXPECT_EQ(ring->getStats().failedAllocations, 0U);
+}
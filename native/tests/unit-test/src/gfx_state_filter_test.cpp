@@ -0,0 +1,269 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <new>
+
+#include "gtest/gtest.h"
+#include "renderer/gfx-base/GFXBuffer.h"
+#include "renderer/gfx-base/GFXCommandBuffer.h"
+#include "renderer/gfx-base/GFXDescriptorSet.h"
+#include "renderer/gfx-base/GFXDescriptorSetLayout.h"
+#include "renderer/gfx-base/GFXFramebuffer.h"
+#include "renderer/gfx-base/GFXInputAssembler.h"
+#include "renderer/gfx-base/GFXPipelineLayout.h"
+#include "renderer/gfx-base/GFXRenderPass.h"
+#include "renderer/gfx-base/GFXShader.h"
+#include "renderer/gfx-base/GFXTexture.h"
+#include "renderer/gfx-empty/EmptyDevice.h"
+#include "renderer/gfx-empty/EmptyPipelineState.h"
+
+using namespace cc;
+using namespace cc::gfx;
+
+namespace {
+
+// the objects bound by the tests, all created on an EmptyDevice
+struct StateFilterFixture {
+    StateFilterFixture() {
+        device = ccnew EmptyDevice();
+        device->initialize({});
+
+        const float vertices[12]{};
+        vertexBuffer = device->createBuffer({BufferUsageBit::VERTEX, MemoryUsageBit::DEVICE, sizeof(vertices), 3 * sizeof(float)});
+        uniformBuffers[0] = device->createBuffer({BufferUsageBit::UNIFORM, MemoryUsageBit::HOST | MemoryUsageBit::DEVICE, 256});
+        uniformBuffers[1] = device->createBuffer({BufferUsageBit::UNIFORM, MemoryUsageBit::HOST | MemoryUsageBit::DEVICE, 256});
+        for (auto *&texture : textures) {
+            texture = device->createTexture({TextureType::TEX2D, TextureUsageBit::SAMPLED, Format::RGBA8, 4, 4});
+        }
+
+        inputAssembler = device->createInputAssembler({{{"a_position", Format::RGB32F}}, {vertexBuffer}});
+        setLayout = device->createDescriptorSetLayout({{
+            {0, DescriptorType::DYNAMIC_UNIFORM_BUFFER, 1, ShaderStageFlagBit::VERTEX},
+            {1, DescriptorType::SAMPLER_TEXTURE, 1, ShaderStageFlagBit::FRAGMENT},
+        }});
+        pipelineLayout = device->createPipelineLayout({{setLayout}});
+        descriptorSet = device->createDescriptorSet({setLayout});
+        descriptorSet->bindBuffer(0, uniformBuffers[0]);
+        descriptorSet->bindTexture(1, textures[0]);
+        descriptorSet->update();
+
+        ShaderInfo shaderInfo;
+        shaderInfo.name = "state-filter-test";
+        shader = device->createShader(shaderInfo);
+        renderPass = device->createRenderPass(RenderPassInfo{});
+        framebuffer = device->createFramebuffer({renderPass});
+
+        psoInfo.shader = shader;
+        psoInfo.pipelineLayout = pipelineLayout;
+        psoInfo.renderPass = renderPass;
+        pipelineState = device->createPipelineState(psoInfo);
+
+        cmdBuff = device->getCommandBuffer();
+    }
+
+    ~StateFilterFixture() {
+        CC_SAFE_DESTROY_AND_DELETE(pipelineState);
+        CC_SAFE_DESTROY_AND_DELETE(framebuffer);
+        CC_SAFE_DESTROY_AND_DELETE(renderPass);
+        CC_SAFE_DESTROY_AND_DELETE(shader);
+        CC_SAFE_DESTROY_AND_DELETE(descriptorSet);
+        CC_SAFE_DESTROY_AND_DELETE(pipelineLayout);
+        CC_SAFE_DESTROY_AND_DELETE(setLayout);
+        CC_SAFE_DESTROY_AND_DELETE(inputAssembler);
+        for (auto *texture : textures) {
+            CC_SAFE_DESTROY_AND_DELETE(texture);
+        }
+        for (auto *buffer : uniformBuffers) {
+            CC_SAFE_DESTROY_AND_DELETE(buffer);
+        }
+        CC_SAFE_DESTROY_AND_DELETE(vertexBuffer);
+        device->destroy();
+        delete device;
+    }
+
+    void beginRenderPass() {
+        const Color clearColor{0.F, 0.F, 0.F, 1.F};
+        cmdBuff->beginRenderPass(renderPass, framebuffer, {0, 0, 4, 4}, &clearColor, 1.F, 0);
+    }
+
+    Device *device{nullptr};
+    Buffer *vertexBuffer{nullptr};
+    Buffer *uniformBuffers[2]{};
+    Texture *textures[2]{};
+    InputAssembler *inputAssembler{nullptr};
+    DescriptorSetLayout *setLayout{nullptr};
+    PipelineLayout *pipelineLayout{nullptr};
+    DescriptorSet *descriptorSet{nullptr};
+    Shader *shader{nullptr};
+    RenderPass *renderPass{nullptr};
+    Framebuffer *framebuffer{nullptr};
+    PipelineStateInfo psoInfo;
+    PipelineState *pipelineState{nullptr};
+    CommandBuffer *cmdBuff{nullptr};
+};
+
+} // namespace
+
+TEST(StateFilterTest, filterRedundantCalls) {
+    StateFilterFixture fixture;
+    auto *cmdBuff = fixture.cmdBuff;
+    const uint32_t offset = 0;
+
+    cmdBuff->begin();
+    fixture.beginRenderPass();
+    for (uint32_t i = 0; i < 3; ++i) {
+        cmdBuff->bindPipelineState(fixture.pipelineState);
+        cmdBuff->bindDescriptorSet(0, fixture.descriptorSet, 1, &offset);
+        cmdBuff->bindInputAssembler(fixture.inputAssembler);
+        cmdBuff->setViewport({0, 0, 4, 4});
+        cmdBuff->setScissor({0, 0, 4, 4});
+        cmdBuff->setStencilWriteMask(StencilFace::ALL, 0xFF);
+    }
+    // only the first of each call goes through
+    EXPECT_EQ(cmdBuff->getNumFilteredCalls(), 2U * 6);
+
+    // a changed dynamic state is not filtered, setting it again is
+    cmdBuff->setViewport({0, 0, 2, 2});
+    EXPECT_EQ(cmdBuff->getNumFilteredCalls(), 2U * 6);
+    cmdBuff->setViewport({0, 0, 2, 2});
+    EXPECT_EQ(cmdBuff->getNumFilteredCalls(), 2U * 6 + 1);
+    // one face of a state set on both faces
+    cmdBuff->setStencilWriteMask(StencilFace::FRONT, 0xFF);
+    EXPECT_EQ(cmdBuff->getNumFilteredCalls(), 2U * 6 + 2);
+    cmdBuff->endRenderPass();
+    cmdBuff->end();
+
+    // the stats restart with the command buffer
+    cmdBuff->begin();
+    EXPECT_EQ(cmdBuff->getNumFilteredCalls(), 0U);
+    cmdBuff->end();
+}
+
+TEST(StateFilterTest, resetAtRenderPassBoundaries) {
+    StateFilterFixture fixture;
+    auto *cmdBuff = fixture.cmdBuff;
+
+    cmdBuff->begin();
+    fixture.beginRenderPass();
+    cmdBuff->bindPipelineState(fixture.pipelineState);
+    cmdBuff->bindDescriptorSet(0, fixture.descriptorSet);
+    cmdBuff->bindInputAssembler(fixture.inputAssembler);
+    cmdBuff->setScissor({0, 0, 4, 4});
+    cmdBuff->endRenderPass();
+    EXPECT_EQ(cmdBuff->getNumFilteredCalls(), 0U);
+
+    // the backend forgets the bound state with the render pass, nothing is filtered
+    fixture.beginRenderPass();
+    cmdBuff->bindPipelineState(fixture.pipelineState);
+    cmdBuff->bindDescriptorSet(0, fixture.descriptorSet);
+    cmdBuff->bindInputAssembler(fixture.inputAssembler);
+    cmdBuff->setScissor({0, 0, 4, 4});
+    EXPECT_EQ(cmdBuff->getNumFilteredCalls(), 0U);
+
+    // same for subpasses
+    cmdBuff->nextSubpass();
+    cmdBuff->bindPipelineState(fixture.pipelineState);
+    EXPECT_EQ(cmdBuff->getNumFilteredCalls(), 0U);
+    cmdBuff->bindPipelineState(fixture.pipelineState);
+    EXPECT_EQ(cmdBuff->getNumFilteredCalls(), 1U);
+    cmdBuff->endRenderPass();
+    cmdBuff->end();
+}
+
+TEST(StateFilterTest, rebindChangedDescriptorSet) {
+    StateFilterFixture fixture;
+    auto *cmdBuff = fixture.cmdBuff;
+    auto *descriptorSet = fixture.descriptorSet;
+    const uint32_t offsets[2]{0, 256};
+
+    cmdBuff->begin();
+    fixture.beginRenderPass();
+    cmdBuff->bindDescriptorSet(0, descriptorSet, 1, &offsets[0]);
+
+    // changed dynamic offsets
+    cmdBuff->bindDescriptorSet(0, descriptorSet, 1, &offsets[1]);
+    EXPECT_EQ(cmdBuff->getNumFilteredCalls(), 0U);
+    cmdBuff->bindDescriptorSet(0, descriptorSet, 1, &offsets[1]);
+    EXPECT_EQ(cmdBuff->getNumFilteredCalls(), 1U);
+    // a different number of dynamic offsets
+    cmdBuff->bindDescriptorSet(0, descriptorSet, 2, offsets);
+    EXPECT_EQ(cmdBuff->getNumFilteredCalls(), 1U);
+
+    // a buffer bound to the same set since the last bind
+    descriptorSet->bindBuffer(0, fixture.uniformBuffers[1]);
+    descriptorSet->update();
+    cmdBuff->bindDescriptorSet(0, descriptorSet, 2, offsets);
+    EXPECT_EQ(cmdBuff->getNumFilteredCalls(), 1U);
+    cmdBuff->bindDescriptorSet(0, descriptorSet, 2, offsets);
+    EXPECT_EQ(cmdBuff->getNumFilteredCalls(), 2U);
+
+    // a texture bound to the same set since the last bind
+    descriptorSet->bindTexture(1, fixture.textures[1]);
+    descriptorSet->update();
+    cmdBuff->bindDescriptorSet(0, descriptorSet, 2, offsets);
+    EXPECT_EQ(cmdBuff->getNumFilteredCalls(), 2U);
+
+    // rebinding the same objects doesn't change the versions
+    descriptorSet->bindBuffer(0, fixture.uniformBuffers[1]);
+    descriptorSet->bindTexture(1, fixture.textures[1]);
+    cmdBuff->bindDescriptorSet(0, descriptorSet, 2, offsets);
+    EXPECT_EQ(cmdBuff->getNumFilteredCalls(), 3U);
+
+    // sets are tracked per slot
+    cmdBuff->bindDescriptorSet(1, descriptorSet, 2, offsets);
+    EXPECT_EQ(cmdBuff->getNumFilteredCalls(), 3U);
+    cmdBuff->endRenderPass();
+    cmdBuff->end();
+}
+
+TEST(StateFilterTest, rebindReusedAddress) {
+    StateFilterFixture fixture;
+    auto *cmdBuff = fixture.cmdBuff;
+
+    // a pipeline state destroyed and another one created at the same address
+    alignas(EmptyPipelineState) uint8_t storage[sizeof(EmptyPipelineState)];
+    auto *pipelineState = new (storage) EmptyPipelineState();
+    pipelineState->initialize(fixture.psoInfo);
+
+    cmdBuff->begin();
+    fixture.beginRenderPass();
+    cmdBuff->bindPipelineState(pipelineState);
+
+    pipelineState->destroy();
+    pipelineState->~EmptyPipelineState();
+    auto *reused = new (storage) EmptyPipelineState();
+    reused->initialize(fixture.psoInfo);
+    ASSERT_EQ(static_cast<PipelineState *>(reused), static_cast<PipelineState *>(pipelineState));
+
+    cmdBuff->bindPipelineState(reused);
+    EXPECT_EQ(cmdBuff->getNumFilteredCalls(), 0U);
+    cmdBuff->bindPipelineState(reused);
+    EXPECT_EQ(cmdBuff->getNumFilteredCalls(), 1U);
+    cmdBuff->endRenderPass();
+    cmdBuff->end();
+
+    reused->destroy();
+    reused->~EmptyPipelineState();
+}
@@ -0,0 +1,141 @@
+/****************************************************************************
+Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include "cocos/gi/light-probe/Delaunay.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+ccstd::vector<cc::gi::Vertex> createProbes(uint32_t count, uint32_t seed) {
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<float> distribution(-10.0F, 10.0F);
+
+    ccstd::vector<cc::gi::Vertex> probes;
+    probes.reserve(count);
+    for (uint32_t i = 0; i < count; i++) {
+        probes.emplace_back(cc::Vec3(distribution(random), distribution(random), distribution(random)));
+    }
+
+    return probes;
+}
+
+size_t getInnerTetrahedronCount(const ccstd::vector<cc::gi::Tetrahedron> &tetrahedrons) {
+    return std::count_if(tetrahedrons.begin(), tetrahedrons.end(), [](const cc::gi::Tetrahedron &tetrahedron) {
+        return tetrahedron.isInnerTetrahedron();
+    });
+}
+
+size_t buildInnerTetrahedronCount(const ccstd::vector<cc::gi::Vertex> &probes) {
+    ccstd::vector<cc::gi::Vertex> copied;
+    for (const auto &probe : probes) {
+        copied.emplace_back(probe.position);
+    }
+
+    cc::gi::Delaunay delaunay(copied);
+    return getInnerTetrahedronCount(delaunay.build());
+}
+
+} // namespace
+
+TEST(giDelaunayTest, buildIncremental) {
+    auto probes = createProbes(1000, 1);
+    const auto expected = buildInnerTetrahedronCount(probes);
+
+    cc::gi::Delaunay delaunay(probes);
+    const auto tetrahedrons = delaunay.buildIncremental();
+    EXPECT_EQ(getInnerTetrahedronCount(tetrahedrons), expected);
+
+    for (const auto &tetrahedron : tetrahedrons) {
+        for (const auto neighbour : tetrahedron.neighbours) {
+            if (tetrahedron.isInnerTetrahedron()) {
+                EXPECT_GE(neighbour, 0);
+            }
+        }
+    }
+}
+
+TEST(giDelaunayTest, insertAndRemoveProbes) {
+    auto probes = createProbes(1000, 2);
+    cc::gi::Delaunay delaunay(probes);
+    delaunay.buildIncremental();
+
+    const auto appended = createProbes(100, 3);
+    probes.insert(probes.end(), appended.begin(), appended.end());
+    EXPECT_EQ(getInnerTetrahedronCount(delaunay.insertProbes()), buildInnerTetrahedronCount(probes));
+
+    ccstd::vector<int32_t> removed;
+    for (int32_t i = 0; i < static_cast<int32_t>(probes.size()); i += 7) {
+        removed.push_back(i);
+    }
+    const auto tetrahedrons = delaunay.removeProbes(removed);
+    EXPECT_EQ(probes.size(), 1100 - removed.size());
+    EXPECT_EQ(getInnerTetrahedronCount(tetrahedrons), buildInnerTetrahedronCount(probes));
+}
+
+// run with --gtest_also_run_disabled_tests to compare against the tetgen build,
+// Delaunay::build() tetrahedralizes with tetgen
+TEST(giDelaunayTest, DISABLED_benchmark) {
+    using Clock = std::chrono::steady_clock;
+    const auto elapsed = [](Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    };
+
+    for (const uint32_t count : {10000U, 50000U, 100000U}) {
+        auto probes = createProbes(count, 4);
+        auto copied = probes;
+
+        auto start = Clock::now();
+        cc::gi::Delaunay tetgen(copied);
+        const auto tetgenCount = getInnerTetrahedronCount(tetgen.build());
+        const auto tetgenTime = elapsed(start);
+
+        start = Clock::now();
+        cc::gi::Delaunay incremental(probes);
+        const auto incrementalCount = getInnerTetrahedronCount(incremental.buildIncremental());
+        const auto incrementalTime = elapsed(start);
+        EXPECT_EQ(incrementalCount, tetgenCount);
+
+        const auto appended = createProbes(100, 5);
+        probes.insert(probes.end(), appended.begin(), appended.end());
+        start = Clock::now();
+        const auto insertedCount = getInnerTetrahedronCount(incremental.insertProbes());
+        const auto insertTime = elapsed(start);
+        EXPECT_EQ(insertedCount, buildInnerTetrahedronCount(probes));
+
+        ccstd::vector<int32_t> removed;
+        for (int32_t i = 0; i < 100; i++) {
+            removed.push_back(i * static_cast<int32_t>(count / 100));
+        }
+        start = Clock::now();
+        const auto removedCount = getInnerTetrahedronCount(incremental.removeProbes(removed));
+        const auto removeTime = elapsed(start);
+        EXPECT_EQ(removedCount, buildInnerTetrahedronCount(probes));
+
+        printf("%u probes, %zu tetrahedrons: tetgen build %.1fms, buildIncremental %.1fms, insert 100 %.1fms, remove 100 %.1fms\n",
+               count, tetgenCount, tetgenTime, incrementalTime, insertTime, removeTime);
+    }
+}
@@ -0,0 +1,126 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "core/scene-graph/IncrementalInstantiator.h"
+#include "core/scene-graph/Node.h"
+#include "gtest/gtest.h"
+#include "scene/Model.h"
+
+using namespace cc;
+
+namespace {
+
+// a root with `width` children, each with `width` leaves
+IntrusivePtr<Node> createTree(uint32_t width) {
+    IntrusivePtr<Node> root = ccnew Node("root");
+    for (uint32_t i = 0; i < width; ++i) {
+        auto *child = ccnew Node("child" + std::to_string(i));
+        child->setPosition(static_cast<float>(i), 0.F, 0.F);
+        child->setParent(root);
+        for (uint32_t j = 0; j < width; ++j) {
+            auto *leaf = ccnew Node("leaf" + std::to_string(j));
+            leaf->setLayer(1U << j % 8);
+            leaf->setParent(child);
+        }
+    }
+    return root;
+}
+
+bool sameTree(const Node *a, const Node *b) {
+    if (a->getName() != b->getName() || a->getLayer() != b->getLayer() || a->getPosition() != b->getPosition() || a->getChildren().size() != b->getChildren().size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a->getChildren().size(); ++i) {
+        if (!sameTree(a->getChildren()[i], b->getChildren()[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+TEST(IncrementalInstantiatorTest, buildInChunks) {
+    constexpr uint32_t WIDTH = 40;
+    auto source = createTree(WIDTH);
+    IntrusivePtr<Node> parent = ccnew Node("parent");
+
+    IntrusivePtr<IncrementalInstantiator> instantiator = ccnew IncrementalInstantiator(source, parent, nullptr);
+    // a budget this small ends a chunk at every budget check
+    instantiator->setBudget(1e-6F);
+
+    // one model per leaf, checked to be registered only once the subtree of its node completes
+    uint32_t createdModels = 0;
+    instantiator->setNodeCallback([&](const Node *src, Node * /*clone*/, IncrementalInstantiator::ModelList &models) {
+        if (src->getChildren().empty()) {
+            models.emplace_back(ccnew scene::Model());
+            ++createdModels;
+        }
+    });
+    uint32_t progressEvents = 0;
+    Node *completedRoot = nullptr;
+    instantiator->on<IncrementalInstantiator::Progress>([&](IncrementalInstantiator * /*emitter*/, const InstantiateProgress &progress) {
+        ++progressEvents;
+        EXPECT_LE(progress.registeredModels, createdModels);
+    });
+    instantiator->on<IncrementalInstantiator::Completed>([&](IncrementalInstantiator * /*emitter*/, Node *root) {
+        completedRoot = root;
+    });
+
+    uint32_t steps = 0;
+    while (!instantiator->step()) {
+        ++steps;
+        ASSERT_LT(steps, 10000U);
+    }
+
+    const auto &progress = instantiator->getProgress();
+    EXPECT_TRUE(progress.done);
+    EXPECT_EQ(progress.totalNodes, 1 + WIDTH + WIDTH * WIDTH);
+    EXPECT_EQ(progress.builtNodes, progress.totalNodes);
+    EXPECT_EQ(progress.allocatedNodes, progress.totalNodes);
+    EXPECT_GT(progress.chunks, 1U);
+    EXPECT_EQ(progressEvents, progress.chunks);
+    EXPECT_EQ(progress.registeredModels, WIDTH * WIDTH);
+    EXPECT_FLOAT_EQ(progress.getRatio(), 1.F);
+
+    ASSERT_NE(instantiator->getRoot(), nullptr);
+    EXPECT_EQ(completedRoot, instantiator->getRoot());
+    EXPECT_EQ(instantiator->getRoot()->getParent(), parent.get());
+    EXPECT_TRUE(sameTree(source, instantiator->getRoot()));
+}
+
+TEST(IncrementalInstantiatorTest, childrenOnlyAndCancel) {
+    auto source = createTree(4);
+    IntrusivePtr<Node> parent = ccnew Node("scene");
+
+    IntrusivePtr<IncrementalInstantiator> instantiator = ccnew IncrementalInstantiator(source, parent, nullptr, true);
+    instantiator->finish();
+    EXPECT_EQ(instantiator->getRoot(), nullptr);
+    EXPECT_EQ(instantiator->getProgress().builtNodes, 4U + 16U);
+    ASSERT_EQ(parent->getChildren().size(), 4U);
+    EXPECT_TRUE(sameTree(source->getChildren()[2], parent->getChildren()[2]));
+
+    instantiator->cancel();
+    EXPECT_TRUE(parent->getChildren().empty());
+}
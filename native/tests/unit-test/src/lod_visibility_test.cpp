@@ -0,0 +1,168 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include "base/std/container/unordered_map.h"
+#include "cocos/scene/LODVisibility.h"
+#include "gtest/gtest.h"
+
+using cc::scene::LODVisibility;
+
+TEST(LODVisibilityTest, addAndRemove) {
+    LODVisibility visibility;
+    const auto camera0 = visibility.addCamera();
+    const auto camera1 = visibility.addCamera();
+    EXPECT_EQ(visibility.getCameraCount(), 2U);
+
+    ccstd::vector<uint32_t> models;
+    for (uint32_t i = 0; i < 130; ++i) {
+        models.push_back(visibility.addModel());
+        EXPECT_FALSE(visibility.isVisible(camera0, models.back()));
+        EXPECT_FALSE(visibility.isVisible(camera1, models.back()));
+    }
+
+    visibility.setVisible(camera1, models[129], true);
+    visibility.setVisibleForAll(models[64], true);
+    EXPECT_FALSE(visibility.isVisible(camera0, models[129]));
+    EXPECT_TRUE(visibility.isVisible(camera1, models[129]));
+    EXPECT_TRUE(visibility.isVisible(camera0, models[64]));
+    EXPECT_TRUE(visibility.isVisible(camera1, models[64]));
+
+    // the last camera takes the index of the removed one
+    visibility.removeCamera(camera0);
+    EXPECT_EQ(visibility.getCameraCount(), 1U);
+    EXPECT_TRUE(visibility.isVisible(0, models[129]));
+
+    // a reused model index starts invisible again
+    visibility.removeModel(models[64]);
+    const auto reused = visibility.addModel();
+    EXPECT_EQ(reused, models[64]);
+    EXPECT_FALSE(visibility.isVisible(0, reused));
+
+    // a new camera sees nothing
+    const auto camera2 = visibility.addCamera();
+    EXPECT_FALSE(visibility.isVisible(camera2, models[129]));
+
+    visibility.clear();
+    EXPECT_EQ(visibility.getCameraCount(), 0U);
+    EXPECT_EQ(visibility.addModel(), 0U);
+}
+
+TEST(LODVisibilityTest, DISABLED_benchmark) {
+    // 5000 LOD groups with 3 levels under 4 cameras, compared with the nested hash maps used before
+    constexpr uint32_t GROUP_COUNT = 5000;
+    constexpr uint32_t LEVEL_COUNT = 3;
+    constexpr uint32_t CAMERA_COUNT = 4;
+    constexpr uint32_t MODEL_COUNT = GROUP_COUNT * LEVEL_COUNT;
+    constexpr uint32_t FRAME_COUNT = 20;
+
+    LODVisibility visibility;
+    ccstd::unordered_map<uint32_t, ccstd::unordered_map<uint32_t, bool>> legacy;
+    for (uint32_t c = 0; c < CAMERA_COUNT; ++c) {
+        visibility.addCamera();
+    }
+    for (uint32_t m = 0; m < MODEL_COUNT; ++m) {
+        EXPECT_EQ(visibility.addModel(), m);
+        legacy[m];
+    }
+
+    std::mt19937 random(7);
+    std::uniform_int_distribution<uint32_t> levelDistribution(0, LEVEL_COUNT - 1);
+    ccstd::vector<uint32_t> usedLevels(GROUP_COUNT * CAMERA_COUNT, LEVEL_COUNT);
+    ccstd::vector<uint32_t> nextLevels(GROUP_COUNT * CAMERA_COUNT);
+
+    double legacyUpdate = 0.0;
+    double legacyQuery = 0.0;
+    double flatUpdate = 0.0;
+    double flatQuery = 0.0;
+    uint32_t legacyCulled = 0;
+    uint32_t flatCulled = 0;
+    for (uint32_t frame = 0; frame < FRAME_COUNT; ++frame) {
+        // about a tenth of the groups switch level every frame
+        for (uint32_t i = 0; i < GROUP_COUNT * CAMERA_COUNT; ++i) {
+            nextLevels[i] = (frame == 0 || random() % 10 == 0) ? levelDistribution(random) : usedLevels[i];
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t c = 0; c < CAMERA_COUNT; ++c) {
+            for (uint32_t g = 0; g < GROUP_COUNT; ++g) {
+                const auto last = usedLevels[c * GROUP_COUNT + g];
+                const auto next = nextLevels[c * GROUP_COUNT + g];
+                if (last == next) {
+                    continue;
+                }
+                if (last < LEVEL_COUNT) {
+                    legacy[g * LEVEL_COUNT + last].erase(c);
+                }
+                legacy[g * LEVEL_COUNT + next].emplace(c, true);
+            }
+        }
+        auto end = std::chrono::steady_clock::now();
+        legacyUpdate += std::chrono::duration<double, std::milli>(end - start).count();
+
+        start = std::chrono::steady_clock::now();
+        for (uint32_t c = 0; c < CAMERA_COUNT; ++c) {
+            for (uint32_t g = 0; g < GROUP_COUNT; ++g) {
+                const auto last = usedLevels[c * GROUP_COUNT + g];
+                const auto next = nextLevels[c * GROUP_COUNT + g];
+                if (last == next) {
+                    continue;
+                }
+                if (last < LEVEL_COUNT) {
+                    visibility.setVisible(c, g * LEVEL_COUNT + last, false);
+                }
+                visibility.setVisible(c, g * LEVEL_COUNT + next, true);
+            }
+        }
+        end = std::chrono::steady_clock::now();
+        flatUpdate += std::chrono::duration<double, std::milli>(end - start).count();
+        usedLevels.swap(nextLevels);
+
+        start = std::chrono::steady_clock::now();
+        for (uint32_t c = 0; c < CAMERA_COUNT; ++c) {
+            for (uint32_t m = 0; m < MODEL_COUNT; ++m) {
+                const auto iter = legacy.find(m);
+                legacyCulled += iter != legacy.end() && iter->second.count(c) == 0;
+            }
+        }
+        end = std::chrono::steady_clock::now();
+        legacyQuery += std::chrono::duration<double, std::milli>(end - start).count();
+
+        start = std::chrono::steady_clock::now();
+        for (uint32_t c = 0; c < CAMERA_COUNT; ++c) {
+            for (uint32_t m = 0; m < MODEL_COUNT; ++m) {
+                flatCulled += !visibility.isVisible(c, m);
+            }
+        }
+        end = std::chrono::steady_clock::now();
+        flatQuery += std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    EXPECT_EQ(flatCulled, legacyCulled);
+    EXPECT_EQ(flatCulled, FRAME_COUNT * CAMERA_COUNT * (MODEL_COUNT - GROUP_COUNT));
+    printf("LOD visibility of %u models under %u cameras, %u frames: hash maps update %.2fms query %.2fms, bitsets update %.2fms query %.2fms\n",
+           MODEL_COUNT, CAMERA_COUNT, FRAME_COUNT, legacyUpdate, legacyQuery, flatUpdate, flatQuery);
+}
@@ -0,0 +1,179 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include "3d/misc/MeshCluster.h"
+#include "core/geometry/Frustum.h"
+#include "gtest/gtest.h"
+#include "math/Quaternion.h"
+
+using namespace cc;
+
+namespace {
+
+constexpr uint32_t RINGS = 64;
+constexpr uint32_t SECTORS = 128;
+
+// unit sphere with counter clockwise, outward facing triangles
+void createSphere(ccstd::vector<float> &positions, ccstd::vector<uint32_t> &indices) {
+    for (uint32_t r = 0; r <= RINGS; ++r) {
+        const float theta = static_cast<float>(r) / RINGS * math::PI;
+        for (uint32_t s = 0; s <= SECTORS; ++s) {
+            const float phi = static_cast<float>(s) / SECTORS * math::PI * 2.F;
+            positions.insert(positions.end(), {std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)});
+        }
+    }
+    const auto position = [&](uint32_t i) {
+        return Vec3{positions[i * 3], positions[i * 3 + 1], positions[i * 3 + 2]};
+    };
+    for (uint32_t r = 0; r < RINGS; ++r) {
+        for (uint32_t s = 0; s < SECTORS; ++s) {
+            const uint32_t a = r * (SECTORS + 1) + s;
+            const uint32_t b = a + SECTORS + 1;
+            for (auto tri : {std::array<uint32_t, 3>{a, b, a + 1}, std::array<uint32_t, 3>{a + 1, b, b + 1}}) {
+                Vec3 n;
+                Vec3::cross(position(tri[1]) - position(tri[0]), position(tri[2]) - position(tri[0]), &n);
+                if (n.lengthSquared() < 1e-12F) {
+                    continue; // degenerate at the poles
+                }
+                if (Vec3::dot(n, position(tri[0]) + position(tri[1]) + position(tri[2])) < 0.F) {
+                    std::swap(tri[1], tri[2]);
+                }
+                indices.insert(indices.end(), tri.begin(), tri.end());
+            }
+        }
+    }
+}
+
+ccstd::vector<std::array<uint32_t, 3>> sortedTriangles(const uint32_t *indices, uint32_t count) {
+    ccstd::vector<std::array<uint32_t, 3>> triangles;
+    for (uint32_t i = 0; i < count; i += 3) {
+        triangles.push_back({indices[i], indices[i + 1], indices[i + 2]});
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+} // namespace
+
+TEST(MeshClusterTest, buildKeepsTriangles) {
+    ccstd::vector<float> positions;
+    ccstd::vector<uint32_t> indices;
+    createSphere(positions, indices);
+    const auto before = sortedTriangles(indices.data(), static_cast<uint32_t>(indices.size()));
+
+    const auto meshlets = MeshCluster::build(indices, positions.data(), 3, static_cast<uint32_t>(positions.size() / 3));
+    EXPECT_EQ(sortedTriangles(indices.data(), static_cast<uint32_t>(indices.size())), before);
+
+    uint32_t nextIndex = 0;
+    for (const auto &meshlet : meshlets) {
+        EXPECT_EQ(meshlet.firstIndex, nextIndex);
+        EXPECT_LE(meshlet.indexCount, MeshCluster::MAX_MESHLET_TRIANGLES * 3);
+        nextIndex += meshlet.indexCount;
+        for (uint32_t i = meshlet.firstIndex; i < meshlet.firstIndex + meshlet.indexCount; ++i) {
+            const Vec3 p{positions[indices[i] * 3], positions[indices[i] * 3 + 1], positions[indices[i] * 3 + 2]};
+            EXPECT_LE(meshlet.center.distance(p), meshlet.radius + 1e-4F);
+        }
+    }
+    EXPECT_EQ(nextIndex, indices.size());
+}
+
+TEST(MeshClusterTest, cullAgainstCamera) {
+    ccstd::vector<float> positions;
+    ccstd::vector<uint32_t> indices;
+    createSphere(positions, indices);
+    const auto meshlets = MeshCluster::build(indices, positions.data(), 3, static_cast<uint32_t>(positions.size() / 3));
+    const auto triangleCount = static_cast<uint32_t>(indices.size() / 3);
+
+    // camera at +z looking at the sphere
+    Mat4 cameraTransform;
+    Mat4::createTranslation(0.F, 0.F, 5.F, &cameraTransform);
+    geometry::Frustum frustum;
+    geometry::Frustum::createPerspective(&frustum, math::PI / 3.F, 1.F, 0.1F, 100.F, cameraTransform);
+    MeshletCullingView view{&frustum, Vec3{0.F, 0.F, 5.F}, true};
+
+    ccstd::vector<uint32_t> out(indices.size());
+    MeshletCullingStats stats;
+    const uint32_t count = MeshCluster::cull(meshlets, indices.data(), Mat4::IDENTITY, &view, 1, true, out.data(), &stats);
+
+    EXPECT_EQ(stats.triangleCount, triangleCount);
+    EXPECT_EQ(count, (triangleCount - stats.culledTriangles) * 3);
+    // the back half faces away, cones are conservative so not all of it is culled
+    EXPECT_GT(stats.culledTriangles, triangleCount / 4);
+    EXPECT_LT(stats.culledTriangles, triangleCount / 2 + triangleCount / 10);
+
+    // every triangle facing the camera survives
+    const auto visible = sortedTriangles(out.data(), count);
+    for (uint32_t i = 0; i < indices.size(); i += 3) {
+        const Vec3 a{positions[indices[i] * 3], positions[indices[i] * 3 + 1], positions[indices[i] * 3 + 2]};
+        const Vec3 b{positions[indices[i + 1] * 3], positions[indices[i + 1] * 3 + 1], positions[indices[i + 1] * 3 + 2]};
+        const Vec3 c{positions[indices[i + 2] * 3], positions[indices[i + 2] * 3 + 1], positions[indices[i + 2] * 3 + 2]};
+        Vec3 n;
+        Vec3::cross(b - a, c - a, &n);
+        if (Vec3::dot(n, view.position - a) > 0.F) {
+            EXPECT_TRUE(std::binary_search(visible.begin(), visible.end(), std::array<uint32_t, 3>{indices[i], indices[i + 1], indices[i + 2]}));
+        }
+    }
+
+    // without back face culling only the frustum applies, and the sphere is fully inside
+    EXPECT_EQ(MeshCluster::cull(meshlets, indices.data(), Mat4::IDENTITY, &view, 1, false, out.data()), indices.size());
+
+    // moved behind the camera
+    Mat4 behind;
+    Mat4::createTranslation(0.F, 0.F, 10.F, &behind);
+    EXPECT_EQ(MeshCluster::cull(meshlets, indices.data(), behind, &view, 1, true, out.data(), &stats), 0);
+    EXPECT_EQ(stats.culledTriangles, triangleCount);
+}
+
+TEST(MeshClusterTest, DISABLED_benchmark) {
+    constexpr uint32_t ITERATIONS = 1000;
+    ccstd::vector<float> positions;
+    ccstd::vector<uint32_t> indices;
+    createSphere(positions, indices);
+
+    auto start = std::chrono::steady_clock::now();
+    const auto meshlets = MeshCluster::build(indices, positions.data(), 3, static_cast<uint32_t>(positions.size() / 3));
+    const auto buildTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    Mat4 cameraTransform;
+    Mat4::createTranslation(0.F, 0.F, 5.F, &cameraTransform);
+    geometry::Frustum frustum;
+    geometry::Frustum::createPerspective(&frustum, math::PI / 3.F, 1.F, 0.1F, 100.F, cameraTransform);
+    MeshletCullingView view{&frustum, Vec3{0.F, 0.F, 5.F}, true};
+
+    ccstd::vector<uint32_t> out(indices.size());
+    MeshletCullingStats stats;
+    start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < ITERATIONS; ++i) {
+        MeshCluster::cull(meshlets, indices.data(), Mat4::IDENTITY, &view, 1, true, out.data(), &stats);
+    }
+    const auto cullTime = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / ITERATIONS;
+    printf("%u meshlets built in %.2f ms, %u of %u triangles culled in %.1f us\n", stats.meshletCount, buildTime, stats.culledTriangles, stats.triangleCount, cullTime);
+    EXPECT_GT(stats.culledTriangles, 0U);
+}
@@ -0,0 +1,236 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <random>
+#include "3d/misc/MeshOptimizer.h"
+#include "gtest/gtest.h"
+
+using namespace cc;
+
+namespace {
+
+constexpr uint32_t GRID_SIZE = 64;
+constexpr uint32_t VERTEX_STRIDE = (3 + 3 + 2) * sizeof(float);
+
+using Vertex = std::array<float, 8>;
+using Triangle = std::array<uint32_t, 3>;
+
+// Interleaved position, normal and uv, triangles shuffled to defeat the vertex cache.
+void createMesh(const ccstd::vector<Vertex> &vertices, ccstd::vector<Triangle> triangles, Mesh::IStruct &structInfo, Uint8Array &data) {
+    const auto vertexCount = static_cast<uint32_t>(vertices.size());
+    const auto indexCount = static_cast<uint32_t>(triangles.size() * 3);
+    const uint32_t vertexBytes = vertexCount * VERTEX_STRIDE;
+    data = Uint8Array(vertexBytes + indexCount * sizeof(uint32_t));
+    uint8_t *bytes = data.buffer()->getData();
+    memcpy(bytes, vertices.data(), vertexBytes);
+    std::shuffle(triangles.begin(), triangles.end(), std::mt19937(42));
+    memcpy(bytes + vertexBytes, triangles.data(), indexCount * sizeof(uint32_t));
+
+    Mesh::IVertexBundle bundle;
+    bundle.view.offset = 0;
+    bundle.view.length = vertexBytes;
+    bundle.view.count = vertexCount;
+    bundle.view.stride = VERTEX_STRIDE;
+    bundle.attributes = {
+        gfx::Attribute{gfx::ATTR_NAME_POSITION, gfx::Format::RGB32F},
+        gfx::Attribute{gfx::ATTR_NAME_NORMAL, gfx::Format::RGB32F},
+        gfx::Attribute{gfx::ATTR_NAME_TEX_COORD, gfx::Format::RG32F},
+    };
+    structInfo.vertexBundles = {bundle};
+
+    Mesh::ISubMesh primitive;
+    primitive.vertexBundelIndices = {0};
+    primitive.primitiveMode = gfx::PrimitiveMode::TRIANGLE_LIST;
+    Mesh::IBufferView indexView;
+    indexView.offset = vertexBytes;
+    indexView.length = indexCount * sizeof(uint32_t);
+    indexView.count = indexCount;
+    indexView.stride = sizeof(uint32_t);
+    primitive.indexView = indexView;
+    structInfo.primitives = {primitive};
+}
+
+// Triangulates a rows x columns vertex lattice, `wrap` closes it along the columns.
+ccstd::vector<Triangle> createLatticeTriangles(uint32_t rows, uint32_t columns, bool wrap) {
+    ccstd::vector<Triangle> triangles;
+    for (uint32_t y = 0; y + 1 < rows; ++y) {
+        for (uint32_t x = 0; x + 1 < columns || (wrap && x + 1 == columns); ++x) {
+            const uint32_t i = y * columns + x;
+            const uint32_t right = y * columns + (x + 1) % columns;
+            triangles.push_back({i, i + columns, right});
+            triangles.push_back({right, i + columns, right + columns});
+        }
+    }
+    return triangles;
+}
+
+// A bumpy grid whose normals all point up.
+void createShuffledGrid(Mesh::IStruct &structInfo, Uint8Array &data) {
+    ccstd::vector<Vertex> vertices;
+    for (uint32_t y = 0; y < GRID_SIZE; ++y) {
+        for (uint32_t x = 0; x < GRID_SIZE; ++x) {
+            const float u = static_cast<float>(x) / (GRID_SIZE - 1);
+            const float v = static_cast<float>(y) / (GRID_SIZE - 1);
+            const float nx = std::sin(u * 6.F);
+            const float nz = std::cos(v * 6.F);
+            const float length = std::sqrt(nx * nx + 1.F + nz * nz);
+            vertices.push_back({u, std::sin(u * 6.F) * std::cos(v * 6.F), v, nx / length, 1.F / length, nz / length, u, v});
+        }
+    }
+    createMesh(vertices, createLatticeTriangles(GRID_SIZE, GRID_SIZE, false), structInfo, data);
+}
+
+void createShuffledSphere(uint32_t rings, uint32_t segments, Mesh::IStruct &structInfo, Uint8Array &data) {
+    constexpr float PI = 3.14159265F;
+    ccstd::vector<Vertex> vertices;
+    for (uint32_t y = 0; y < rings; ++y) {
+        const float v = static_cast<float>(y) / (rings - 1);
+        for (uint32_t x = 0; x < segments; ++x) {
+            const float u = static_cast<float>(x) / segments;
+            const float n[3] = {std::sin(v * PI) * std::cos(u * 2.F * PI), std::cos(v * PI), std::sin(v * PI) * std::sin(u * 2.F * PI)};
+            vertices.push_back({n[0], n[1], n[2], n[0], n[1], n[2], u, v});
+        }
+    }
+    createMesh(vertices, createLatticeTriangles(rings, segments, true), structInfo, data);
+}
+
+void createShuffledTorus(uint32_t rings, uint32_t segments, Mesh::IStruct &structInfo, Uint8Array &data) {
+    constexpr float PI = 3.14159265F;
+    constexpr float RADIUS = 1.F;
+    constexpr float TUBE = 0.25F;
+    ccstd::vector<Vertex> vertices;
+    for (uint32_t y = 0; y < rings; ++y) {
+        const float v = static_cast<float>(y) / (rings - 1);
+        for (uint32_t x = 0; x < segments; ++x) {
+            const float u = static_cast<float>(x) / segments;
+            const float n[3] = {std::cos(v * 2.F * PI) * std::cos(u * 2.F * PI), std::sin(u * 2.F * PI), std::sin(v * 2.F * PI) * std::cos(u * 2.F * PI)};
+            const float center[3] = {std::cos(v * 2.F * PI) * RADIUS, 0.F, std::sin(v * 2.F * PI) * RADIUS};
+            vertices.push_back({center[0] + n[0] * TUBE, center[1] + n[1] * TUBE, center[2] + n[2] * TUBE, n[0], n[1], n[2], u, v});
+        }
+    }
+    createMesh(vertices, createLatticeTriangles(rings, segments, true), structInfo, data);
+}
+
+} // namespace
+
+TEST(MeshOptimizerTest, octahedralNormalRoundTrip) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> dist(-1.F, 1.F);
+    float maxError = 0.F;
+    for (uint32_t i = 0; i < 10000; ++i) {
+        float n[3] = {dist(rng), dist(rng), dist(rng)};
+        const float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        if (length < 1e-3F) continue;
+        for (float &c : n) c /= length;
+
+        int16_t encoded[2];
+        float decoded[3];
+        MeshOptimizer::encodeOctahedralNormal(n, encoded);
+        MeshOptimizer::decodeOctahedralNormal(encoded, decoded);
+        for (uint32_t c = 0; c < 3; ++c) {
+            maxError = std::max(maxError, std::abs(decoded[c] - n[c]));
+        }
+    }
+    EXPECT_LT(maxError, 1e-3F);
+}
+
+TEST(MeshOptimizerTest, optimizeShuffledGrid) {
+    Mesh::IStruct structInfo;
+    Uint8Array data;
+    createShuffledGrid(structInfo, data);
+
+    MeshOptimizeReport report;
+    MeshOptimizer::optimize(structInfo, data, MeshOptimizeFlagBit::ALL, &report);
+
+    EXPECT_LT(report.acmrAfter, report.acmrBefore);
+    // 12 bytes position, 4 bytes octahedral normal, 4 bytes uv
+    const auto &bundle = structInfo.vertexBundles[0];
+    EXPECT_EQ(bundle.view.stride, 20);
+    EXPECT_EQ(report.vertexBytesAfter, bundle.view.stride * bundle.view.count);
+    EXPECT_EQ(bundle.attributes[1].format, gfx::Format::RG16I);
+    EXPECT_TRUE(bundle.attributes[1].isNormalized);
+    EXPECT_EQ(bundle.attributes[2].format, gfx::Format::RG16UI);
+    EXPECT_TRUE(bundle.attributes[2].isNormalized);
+
+    // every vertex still decodes to a unit normal pointing up, uvs stay inside the grid
+    const uint8_t *bytes = data.buffer()->getData() + bundle.view.offset;
+    for (uint32_t i = 0; i < bundle.view.count; ++i) {
+        const uint8_t *vertex = bytes + i * bundle.view.stride;
+        float normal[4];
+        ASSERT_EQ(MeshOptimizer::decodeAttribute(bundle.attributes[1], vertex + 12, normal), 3);
+        EXPECT_GT(normal[1], 0.F);
+        EXPECT_NEAR(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2], 1.F, 1e-3F);
+
+        float uv[4];
+        ASSERT_EQ(MeshOptimizer::decodeAttribute(bundle.attributes[2], vertex + 16, uv), 2);
+        float position[3];
+        memcpy(position, vertex, sizeof(position));
+        EXPECT_NEAR(uv[0], position[0], 1e-4F);
+        EXPECT_NEAR(uv[1], position[2], 1e-4F);
+    }
+    // full precision attributes are left to the regular readers
+    float unused[4];
+    EXPECT_EQ(MeshOptimizer::decodeAttribute(bundle.attributes[0], bytes, unused), 0);
+}
+
+TEST(MeshOptimizerTest, DISABLED_benchmark) {
+    struct Sample {
+        const char *name;
+        std::function<void(Mesh::IStruct &, Uint8Array &)> create;
+    };
+    const Sample samples[] = {
+        {"grid", createShuffledGrid},
+        {"sphere", [](Mesh::IStruct &structInfo, Uint8Array &data) { createShuffledSphere(128, 256, structInfo, data); }},
+        {"torus", [](Mesh::IStruct &structInfo, Uint8Array &data) { createShuffledTorus(256, 64, structInfo, data); }},
+    };
+    const std::pair<const char *, MeshOptimizeFlagBit> levels[] = {
+        {"cache", MeshOptimizeFlagBit::VERTEX_CACHE},
+        {"cache+overdraw+fetch", MeshOptimizeFlagBit::VERTEX_CACHE | MeshOptimizeFlagBit::OVERDRAW | MeshOptimizeFlagBit::VERTEX_FETCH},
+        {"+quantize", MeshOptimizeFlagBit::VERTEX_CACHE | MeshOptimizeFlagBit::OVERDRAW | MeshOptimizeFlagBit::VERTEX_FETCH | MeshOptimizeFlagBit::QUANTIZE},
+        {"all", MeshOptimizeFlagBit::ALL},
+    };
+    for (const auto &sample : samples) {
+        for (const auto &level : levels) {
+            Mesh::IStruct structInfo;
+            Uint8Array data;
+            sample.create(structInfo, data);
+
+            MeshOptimizeReport report;
+            const auto start = std::chrono::steady_clock::now();
+            MeshOptimizer::optimize(structInfo, data, level.second, &report);
+            const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            printf("%-6s %-20s vertex bytes %8u -> %8u, ACMR %.3f -> %.3f, %.2f ms\n", sample.name, level.first,
+                   report.vertexBytesBefore, report.vertexBytesAfter, report.acmrBefore, report.acmrAfter, elapsed);
+            EXPECT_LE(report.acmrAfter, report.acmrBefore);
+        }
+    }
+}
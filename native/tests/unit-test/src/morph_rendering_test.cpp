@@ -0,0 +1,142 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include "3d/assets/MorphRendering.h"
+#include "gtest/gtest.h"
+
+using namespace cc;
+
+namespace {
+
+// not a multiple of 4, so the SIMD path also sees the last partial group
+constexpr uint32_t VERTEX_COUNT = 203;
+
+// displaces the first `displacedCount` vertices of a random permutation
+Float32Array createDisplacements(std::mt19937 &random, uint32_t displacedCount) {
+    ccstd::vector<uint32_t> vertices(VERTEX_COUNT);
+    for (uint32_t iVertex = 0; iVertex < VERTEX_COUNT; ++iVertex) {
+        vertices[iVertex] = iVertex;
+    }
+    std::shuffle(vertices.begin(), vertices.end(), random);
+
+    std::uniform_real_distribution<float> distribution(-1.F, 1.F);
+    Float32Array displacements(3 * VERTEX_COUNT);
+    for (uint32_t i = 0; i < displacedCount; ++i) {
+        const uint32_t iVertex = vertices[i];
+        displacements[3 * iVertex + 0] = distribution(random);
+        displacements[3 * iVertex + 1] = distribution(random);
+        // a displacement along one axis only still counts
+        displacements[3 * iVertex + 2] = i % 3 ? distribution(random) : 0.F;
+    }
+    return displacements;
+}
+
+// the dense blend CpuComputing used before targets were converted
+void blendDense(Float32Array &values, const ccstd::vector<Float32Array> &targets, const ccstd::vector<float> &weights) {
+    for (size_t iTarget = 0; iTarget < targets.size(); ++iTarget) {
+        const auto &targetDisplacements = targets[iTarget];
+        const float weight = weights[iTarget];
+        const uint32_t nVertices = targetDisplacements.length() / 3;
+        if (iTarget == 0) {
+            for (uint32_t iVertex = 0; iVertex < nVertices; ++iVertex) {
+                values[4 * iVertex + 0] = targetDisplacements[3 * iVertex + 0] * weight;
+                values[4 * iVertex + 1] = targetDisplacements[3 * iVertex + 1] * weight;
+                values[4 * iVertex + 2] = targetDisplacements[3 * iVertex + 2] * weight;
+            }
+        } else if (std::fabs(weight) >= std::numeric_limits<float>::epsilon()) {
+            for (uint32_t iVertex = 0; iVertex < nVertices; ++iVertex) {
+                values[4 * iVertex + 0] += targetDisplacements[3 * iVertex + 0] * weight;
+                values[4 * iVertex + 1] += targetDisplacements[3 * iVertex + 1] * weight;
+                values[4 * iVertex + 2] += targetDisplacements[3 * iVertex + 2] * weight;
+            }
+        }
+    }
+}
+
+} // namespace
+
+TEST(MorphRenderingTest, sparseTargetLayout) {
+    std::mt19937 random(7);
+    const auto threshold = static_cast<uint32_t>(VERTEX_COUNT * MORPH_SPARSE_TARGET_RATIO);
+
+    // just below the threshold, only the displaced vertices are kept
+    auto sparse = createCpuMorphAttributeTarget(createDisplacements(random, threshold), VERTEX_COUNT);
+    EXPECT_EQ(sparse.vertexIndices.size(), threshold);
+    EXPECT_EQ(sparse.displacements.size(), 4 * threshold);
+    EXPECT_TRUE(std::is_sorted(sparse.vertexIndices.begin(), sparse.vertexIndices.end()));
+
+    // just over the threshold, all vertices are kept in order
+    auto dense = createCpuMorphAttributeTarget(createDisplacements(random, threshold + 1), VERTEX_COUNT);
+    EXPECT_TRUE(dense.vertexIndices.empty());
+    EXPECT_EQ(dense.displacements.size(), 4 * VERTEX_COUNT);
+
+    auto empty = createCpuMorphAttributeTarget(createDisplacements(random, 0), VERTEX_COUNT);
+    EXPECT_TRUE(empty.vertexIndices.empty());
+    EXPECT_TRUE(empty.displacements.empty());
+}
+
+TEST(MorphRenderingTest, blendMatchesDense) {
+    std::mt19937 random(11);
+    const auto threshold = static_cast<uint32_t>(VERTEX_COUNT * MORPH_SPARSE_TARGET_RATIO);
+    // all, just over and just under the sparse threshold, a few, and none of the vertices
+    const uint32_t displacedCounts[] = {VERTEX_COUNT, threshold + 1, threshold, 17, 1, 0};
+    const float weightSets[][6] = {
+        {1.F, 0.5F, -0.25F, 2.F, 0.75F, 1.F},
+        {0.F, 1.F, 0.F, 0.3F, 0.F, 0.F},
+        {0.F, 0.F, 0.F, 0.F, 0.F, 0.F},
+        {-1.F, 0.F, 1.F, 0.F, -0.5F, 0.5F},
+    };
+
+    ccstd::vector<Float32Array> displacements;
+    ccstd::vector<CpuMorphAttributeTarget> targets;
+    for (const auto displacedCount : displacedCounts) {
+        displacements.emplace_back(createDisplacements(random, displacedCount));
+        targets.emplace_back(createCpuMorphAttributeTarget(displacements.back(), VERTEX_COUNT));
+    }
+
+    for (const auto &weightSet : weightSets) {
+        const ccstd::vector<float> weights(std::begin(weightSet), std::end(weightSet));
+
+        Float32Array expected(4 * VERTEX_COUNT);
+        blendDense(expected, displacements, weights);
+
+        // as CpuComputingRenderingInstance::setWeights blends
+        ccstd::vector<float> values(4 * VERTEX_COUNT, 0.F);
+        for (size_t iTarget = 0; iTarget < targets.size(); ++iTarget) {
+            if (std::fabs(weights[iTarget]) < std::numeric_limits<float>::epsilon()) {
+                continue;
+            }
+            accumulateDisplacements(values.data(), targets[iTarget], weights[iTarget]);
+        }
+
+        for (uint32_t i = 0; i < 4 * VERTEX_COUNT; ++i) {
+            EXPECT_NEAR(values[i], expected[i], 1e-5F) << "component " << i;
+        }
+    }
+}
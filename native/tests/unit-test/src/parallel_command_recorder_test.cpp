@@ -0,0 +1,193 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <algorithm>
+
+#include "base/job-system/JobSystem.h"
+#include "gtest/gtest.h"
+#include "renderer/gfx-agent/CommandBufferAgent.h"
+#include "renderer/gfx-agent/DeviceAgent.h"
+#include "renderer/gfx-base/GFXFramebuffer.h"
+#include "renderer/gfx-base/GFXQueue.h"
+#include "renderer/gfx-base/GFXRenderPass.h"
+#include "renderer/gfx-empty/EmptyCommandBuffer.h"
+#include "renderer/gfx-empty/EmptyDevice.h"
+#include "renderer/pipeline/custom/NativeExecutorDetail.h"
+
+using namespace cc;
+using namespace cc::gfx;
+using cc::render::QueueSection;
+using cc::render::RecordRange;
+using cc::render::RecordTask;
+
+namespace {
+
+constexpr uint32_t MIN_DRAWS_PER_TASK = 128;
+constexpr uint32_t NUM_WORKERS = 3;
+
+// two scenes of a pass in graph order, 540 draws in total
+ccstd::pmr::vector<RecordRange> makeSections() {
+    ccstd::pmr::vector<RecordRange> sections;
+    sections.emplace_back(RecordRange{1, nullptr, QueueSection::OPAQUE_DRAWS, 0, 300});
+    sections.emplace_back(RecordRange{1, nullptr, QueueSection::OPAQUE_INSTANCING, 0, 40});
+    sections.emplace_back(RecordRange{2, nullptr, QueueSection::BLEND_DRAWS, 0, 200});
+    return sections;
+}
+
+uint32_t getNumDraws(const ccstd::pmr::vector<RecordRange> &sections) {
+    uint32_t numDraws = 0;
+    for (const auto &section : sections) {
+        numDraws += section.count;
+    }
+    return numDraws;
+}
+
+} // namespace
+
+TEST(ParallelCommandRecorderTest, splitRecordTasks) {
+    const auto sections = makeSections();
+    ccstd::pmr::vector<RecordRange> ranges;
+    ccstd::pmr::vector<RecordTask> tasks;
+    ASSERT_TRUE(render::splitRecordTasks(sections, getNumDraws(sections), MIN_DRAWS_PER_TASK, NUM_WORKERS, ranges, tasks));
+    // one task per worker plus the main thread, 135 draws each
+    EXPECT_EQ(tasks.size(), NUM_WORKERS + 1);
+
+    // the tasks cover the ranges in order, and the ranges cover the sections in graph order
+    uint32_t rangeID = 0;
+    for (const auto &task : tasks) {
+        EXPECT_EQ(task.rangeBegin, rangeID);
+        EXPECT_LT(task.rangeBegin, task.rangeEnd);
+        rangeID = task.rangeEnd;
+    }
+    EXPECT_EQ(rangeID, ranges.size());
+
+    uint32_t sectionID = 0;
+    uint32_t first = 0;
+    for (const auto &range : ranges) {
+        ASSERT_LT(sectionID, sections.size());
+        const auto &section = sections[sectionID];
+        EXPECT_EQ(range.sceneID, section.sceneID);
+        EXPECT_EQ(range.section, section.section);
+        EXPECT_EQ(range.first, first);
+        first += range.count;
+        if (first == section.count) {
+            ++sectionID;
+            first = 0;
+        }
+    }
+    EXPECT_EQ(sectionID, sections.size());
+
+    // instancing batches are never split
+    const auto instancing = std::count_if(ranges.begin(), ranges.end(), [](const RecordRange &range) {
+        return range.section == QueueSection::OPAQUE_INSTANCING;
+    });
+    EXPECT_EQ(instancing, 1);
+
+    // too few draws for more than one task
+    ranges.clear();
+    tasks.clear();
+    EXPECT_FALSE(render::splitRecordTasks(sections, 100, MIN_DRAWS_PER_TASK, NUM_WORKERS, ranges, tasks));
+}
+
+TEST(ParallelCommandRecorderTest, recordOnEmptyDevice) {
+    auto *device = ccnew DeviceAgent(ccnew EmptyDevice());
+    ASSERT_TRUE(device->initialize({}));
+    // deferred command buffers of the agent can be recorded by workers
+    EXPECT_TRUE(device->isMultithreadedCommandRecording());
+
+    auto *renderPass = device->createRenderPass(RenderPassInfo{});
+    auto *framebuffer = device->createFramebuffer(FramebufferInfo{renderPass});
+
+    const auto sections = makeSections();
+    const auto numDraws = getNumDraws(sections);
+    ccstd::pmr::vector<RecordRange> ranges;
+    ccstd::pmr::vector<RecordTask> tasks;
+    ASSERT_TRUE(render::splitRecordTasks(sections, numDraws, MIN_DRAWS_PER_TASK, NUM_WORKERS, ranges, tasks));
+
+    // the draw index of the first draw of each range, in graph order
+    ccstd::vector<uint32_t> firstDraws(ranges.size());
+    for (uint32_t i = 1; i < ranges.size(); ++i) {
+        firstDraws[i] = firstDraws[i - 1] + ranges[i - 1].count;
+    }
+
+    auto &recorder = render::getParallelCommandRecorder();
+    for (uint32_t frame = 0; frame != 2; ++frame) {
+        recorder.clear();
+        ccstd::vector<CommandBuffer *> secondaryCBs;
+        for (auto &task : tasks) {
+            task.cmdBuff = recorder.allocateCommandBuffer(device);
+            secondaryCBs.emplace_back(task.cmdBuff);
+        }
+        EXPECT_EQ(recorder.recordedCommandBuffers.size(), tasks.size());
+        // reused in allocation order across frames
+        EXPECT_EQ(recorder.commandBuffers.size(), tasks.size());
+
+        // each draw is tagged with its index in graph order
+        JobGraph g(JobSystem::getInstance());
+        g.createForEachIndexJob(0U, static_cast<uint32_t>(tasks.size()), 1U, [&](uint32_t taskID) {
+            const auto &task = tasks[taskID];
+            task.cmdBuff->begin(renderPass, 0, framebuffer);
+            for (uint32_t i = task.rangeBegin; i != task.rangeEnd; ++i) {
+                for (uint32_t draw = 0; draw != ranges[i].count; ++draw) {
+                    DrawInfo info;
+                    info.firstVertex = firstDraws[i] + draw;
+                    task.cmdBuff->draw(info);
+                }
+            }
+            task.cmdBuff->end();
+        });
+        g.run();
+        g.waitForAll();
+
+        auto *primary = device->getCommandBuffer();
+        const auto numSecondaryCBs = static_cast<uint32_t>(secondaryCBs.size());
+        primary->begin();
+        primary->beginRenderPass(renderPass, framebuffer, {}, nullptr, 1.F, 0, secondaryCBs.data(), numSecondaryCBs);
+        primary->execute(secondaryCBs.data(), numSecondaryCBs);
+        primary->endRenderPass();
+        primary->end();
+
+        device->flushCommands(secondaryCBs.data(), numSecondaryCBs);
+        device->flushCommands(&primary, 1);
+        device->getQueue()->submit(&primary, 1);
+        // waits for the render thread to execute everything
+        device->setMultithreaded(false);
+
+        const auto &draws = static_cast<EmptyCommandBuffer *>(static_cast<CommandBufferAgent *>(primary)->getActor())->getDraws();
+        ASSERT_EQ(draws.size(), numDraws);
+        for (uint32_t i = 0; i != numDraws; ++i) {
+            EXPECT_EQ(draws[i].firstVertex, i);
+        }
+        device->setMultithreaded(true);
+    }
+
+    recorder.destroy();
+    framebuffer->destroy();
+    delete framebuffer;
+    renderPass->destroy();
+    delete renderPass;
+    device->destroy();
+    delete device;
+}
@@ -0,0 +1,124 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include <algorithm>
+#include <random>
+#include "cocos/renderer/pipeline/Define.h"
+#include "cocos/renderer/pipeline/RenderQueue.h"
+#include "gtest/gtest.h"
+
+using cc::pipeline::RenderPass;
+using cc::pipeline::RenderPassList;
+using cc::pipeline::RenderQueue;
+using cc::pipeline::RenderQueueCreateInfo;
+using cc::pipeline::RenderQueueSortMode;
+
+namespace {
+
+RenderQueueCreateInfo makeQueueInfo(bool transparent) {
+    RenderQueueCreateInfo info;
+    info.isTransparent = transparent;
+    info.sortFunc = transparent ? cc::pipeline::transparentCompareFn : cc::pipeline::opaqueCompareFn;
+    info.sortByKey = true;
+    info.sortMode = transparent ? RenderQueueSortMode::BACK_TO_FRONT : RenderQueueSortMode::FRONT_TO_BACK;
+    return info;
+}
+
+// Few distinct values, so that every key field has ties. Depths are apart by far more
+// than the epsilon of math::isNotEqualF, which the key sort orders by value instead.
+RenderPassList makeRenderPasses(std::mt19937 &rng, uint32_t count) {
+    std::uniform_int_distribution<uint32_t> priority(0, 3);
+    std::uniform_int_distribution<uint32_t> hash(0, 7);
+    std::uniform_int_distribution<int32_t> depth(-16, 16);
+    std::uniform_int_distribution<uint32_t> shader(0, 5);
+
+    RenderPassList passes(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        auto &pass = passes[i];
+        pass.priority = priority(rng) * 0x40U;
+        pass.hash = hash(rng) * 0x1FFFFFU;
+        pass.depth = static_cast<float>(depth(rng)) * 0.5F;
+        pass.shaderID = shader(rng) * 0x33333333U;
+        // identifies the entry after sorting
+        pass.passIndex = i;
+    }
+    return passes;
+}
+
+void expectSameOrder(const RenderPassList &expected, const RenderPassList &actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(expected[i].passIndex, actual[i].passIndex) << "at " << i;
+    }
+}
+
+void testSort(bool transparent, uint32_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    const auto passes = makeRenderPasses(rng, count);
+
+    RenderQueue queue(nullptr, makeQueueInfo(transparent));
+    for (const auto &pass : passes) {
+        queue.insertRenderPass(pass);
+    }
+    queue.sort();
+
+    auto expected = passes;
+    std::stable_sort(expected.begin(), expected.end(), transparent ? cc::pipeline::transparentCompareFn : cc::pipeline::opaqueCompareFn);
+    expectSameOrder(expected, queue.getRenderPasses());
+}
+
+} // namespace
+
+TEST(RenderQueueSortTest, opaqueKeySort) {
+    testSort(false, 1000, 1);
+}
+
+TEST(RenderQueueSortTest, transparentKeySort) {
+    testSort(true, 1000, 2);
+}
+
+// enough entries in total for sortQueues to use the job workers
+TEST(RenderQueueSortTest, parallelKeySort) {
+    std::mt19937 rng(3);
+    ccstd::vector<RenderPassList> passes;
+    ccstd::vector<std::unique_ptr<RenderQueue>> queues;
+    ccstd::vector<RenderQueue *> queuePtrs;
+    for (uint32_t i = 0; i < 4; ++i) {
+        const bool transparent = i % 2 == 1;
+        passes.emplace_back(makeRenderPasses(rng, 2000));
+        queues.emplace_back(std::make_unique<RenderQueue>(nullptr, makeQueueInfo(transparent)));
+        for (const auto &pass : passes.back()) {
+            queues.back()->insertRenderPass(pass);
+        }
+        queuePtrs.emplace_back(queues.back().get());
+    }
+    RenderQueue::sortQueues(queuePtrs);
+
+    for (uint32_t i = 0; i < 4; ++i) {
+        const bool transparent = i % 2 == 1;
+        auto expected = passes[i];
+        std::stable_sort(expected.begin(), expected.end(), transparent ? cc::pipeline::transparentCompareFn : cc::pipeline::opaqueCompareFn);
+        expectSameOrder(expected, queues[i]->getRenderPasses());
+    }
+}
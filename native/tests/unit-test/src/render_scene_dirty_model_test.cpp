@@ -0,0 +1,140 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <cstring>
+
+#include "base/Ptr.h"
+#include "base/Utils.h"
+#include "core/Root.h"
+#include "core/scene-graph/Node.h"
+#include "gtest/gtest.h"
+#include "renderer/gfx-base/GFXDevice.h"
+#include "renderer/pipeline/Define.h"
+#include "scene/Model.h"
+#include "scene/RenderScene.h"
+
+using namespace cc;
+
+namespace {
+
+// the world matrix leads the local UBO
+void expectWorldMatrix(const scene::RenderScene *renderScene, const scene::Model *model) {
+    const uint8_t *localData = renderScene->getPooledLocalData(model);
+    ASSERT_NE(localData, nullptr);
+    float worldMatrix[16];
+    memcpy(worldMatrix, localData + sizeof(float) * pipeline::UBOLocal::MAT_WORLD_OFFSET, sizeof(worldMatrix));
+    const auto &expected = model->getTransform()->getWorldMatrix();
+    for (uint32_t i = 0; i < 16; ++i) {
+        EXPECT_FLOAT_EQ(worldMatrix[i], expected.m[i]);
+    }
+}
+
+} // namespace
+
+// Runs on the EmptyDevice created by main, without a render pipeline. The changed flags of the nodes are reset after
+// every update like at the end of a frame.
+TEST(RenderSceneTest, dirtyModelUpdate) {
+    constexpr uint32_t MODEL_COUNT = 4;
+    auto *device = Root::getInstance()->getDevice();
+    const uint32_t stride = utils::alignTo(pipeline::UBOLocal::SIZE, device->getCapabilities().uboOffsetAlignment);
+
+    IntrusivePtr<scene::RenderScene> renderScene = ccnew scene::RenderScene();
+    renderScene->initialize({"dirty-model-test"});
+    renderScene->setDirtyModelUpdate(true);
+
+    // the last node is a child of the second one
+    ccstd::vector<IntrusivePtr<Node>> nodes;
+    ccstd::vector<IntrusivePtr<scene::Model>> models;
+    for (uint32_t i = 0; i < MODEL_COUNT; ++i) {
+        auto *node = nodes.emplace_back(ccnew Node()).get();
+        node->setPosition(static_cast<float>(i), 0.F, 0.F);
+        auto *model = models.emplace_back(ccnew scene::Model()).get();
+        model->initialize();
+        model->setNode(node);
+        model->setTransform(node);
+        renderScene->addModel(model);
+    }
+    nodes[MODEL_COUNT - 1]->setParent(nodes[1]);
+
+    // every model is uploaded once it is tracked, all pooled slots share one page
+    renderScene->update(1);
+    Node::resetChangedFlags();
+    EXPECT_EQ(renderScene->getModelUpdateStats().dirtyModels, MODEL_COUNT);
+    EXPECT_EQ(renderScene->getModelUpdateStats().untrackedModels, 0U);
+    EXPECT_EQ(renderScene->getModelUpdateStats().localBufferUploads, 1U);
+    for (const auto &model : models) {
+        EXPECT_TRUE(model->isTransformTracking());
+        EXPECT_FALSE(model->isLocalDataUpdated());
+        expectWorldMatrix(renderScene, model);
+    }
+
+    // nothing moved, nothing is recomputed or uploaded
+    renderScene->update(2);
+    Node::resetChangedFlags();
+    EXPECT_EQ(renderScene->getModelUpdateStats().dirtyModels, 0U);
+    EXPECT_EQ(renderScene->getModelUpdateStats().localBufferUploads, 0U);
+    EXPECT_EQ(renderScene->getModelUpdateStats().localBufferBytes, 0U);
+
+    // only the moved model, its page is uploaded up to its slot
+    nodes[2]->setPosition(5.F, 6.F, 7.F);
+    EXPECT_TRUE(models[2]->isLocalDataUpdated());
+    EXPECT_FALSE(models[0]->isLocalDataUpdated());
+    renderScene->update(3);
+    Node::resetChangedFlags();
+    EXPECT_EQ(renderScene->getModelUpdateStats().dirtyModels, 1U);
+    EXPECT_EQ(renderScene->getModelUpdateStats().localBufferUploads, 1U);
+    EXPECT_EQ(renderScene->getModelUpdateStats().localBufferBytes, models[2]->getPooledLocalBufferSlot() * stride + pipeline::UBOLocal::SIZE);
+    expectWorldMatrix(renderScene, models[2]);
+    const uint8_t *movedData = renderScene->getPooledLocalData(models[2]);
+    float translation[3];
+    memcpy(translation, movedData + sizeof(float) * (pipeline::UBOLocal::MAT_WORLD_OFFSET + 12), sizeof(translation));
+    EXPECT_FLOAT_EQ(translation[0], 5.F);
+    EXPECT_FLOAT_EQ(translation[1], 6.F);
+    EXPECT_FLOAT_EQ(translation[2], 7.F);
+
+    // the static models keep the data of the first update
+    for (const uint32_t i : {0U, 1U, 3U}) {
+        EXPECT_FALSE(models[i]->isLocalDataUpdated());
+        expectWorldMatrix(renderScene, models[i]);
+    }
+
+    // moving a parent dirties the models of its children
+    nodes[1]->setPosition(0.F, 1.F, 0.F);
+    renderScene->update(4);
+    Node::resetChangedFlags();
+    EXPECT_EQ(renderScene->getModelUpdateStats().dirtyModels, 2U);
+    expectWorldMatrix(renderScene, models[1]);
+    expectWorldMatrix(renderScene, models[MODEL_COUNT - 1]);
+
+    // untracked models get their own buffers back
+    renderScene->setDirtyModelUpdate(false);
+    for (const auto &model : models) {
+        EXPECT_FALSE(model->isTransformTracking());
+        EXPECT_EQ(renderScene->getPooledLocalData(model), nullptr);
+    }
+
+    renderScene->removeModels();
+    renderScene->destroy();
+}
@@ -0,0 +1,139 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "engine/ServerWorld.h"
+#include "base/Scheduler.h"
+#include "engine/EngineEvents.h"
+#include "gtest/gtest.h"
+
+using namespace cc;
+
+TEST(serverWorldTest, fixedStep) {
+    IntrusivePtr<ServerWorld> world = ccnew ServerWorld(1);
+    world->setFixedTimeStep(0.1F);
+
+    uint32_t scheduled = 0;
+    float scheduledTime = 0.F;
+    world->getScheduler()->schedule([&](float dt) {
+        ++scheduled;
+        scheduledTime += dt;
+    },
+                                    world.get(), 0.F, false, "step");
+    uint32_t afterSteps = 0;
+    world->on<ServerWorld::AfterStep>([&](ServerWorld * /*world*/, float dt) {
+        EXPECT_FLOAT_EQ(dt, 0.1F);
+        ++afterSteps;
+    });
+
+    // 0.25s is two steps, the remaining half step is carried over
+    world->advance(0.25F);
+    EXPECT_EQ(world->getStepCount(), 2U);
+    EXPECT_EQ(afterSteps, 2U);
+    EXPECT_EQ(scheduled, 2U);
+    EXPECT_NEAR(scheduledTime, 0.2F, 1e-5F);
+    EXPECT_NEAR(world->getInterpolationAlpha(), 0.5F, 1e-3F);
+
+    world->advance(0.06F);
+    EXPECT_EQ(world->getStepCount(), 3U);
+    EXPECT_EQ(world->getStats().lastTickSteps, 1U);
+
+    // a late tick is limited to maxStepsPerTick
+    world->setMaxStepsPerTick(2);
+    world->advance(0.5F);
+    EXPECT_EQ(world->getStepCount(), 5U);
+    EXPECT_EQ(world->getStats().droppedSteps, 3U);
+    EXPECT_EQ(world->getStats().totalSteps, 5U);
+
+    world->setPaused(true);
+    world->advance(1.F);
+    EXPECT_EQ(world->getStepCount(), 5U);
+
+    world->getScheduler()->unscheduleAll();
+}
+
+TEST(serverWorldTest, manager) {
+    ServerWorldManager manager;
+    EXPECT_EQ(ServerWorldManager::getInstance(), &manager);
+
+    auto *fast = manager.createWorld();
+    auto *slow = manager.createWorld();
+    EXPECT_NE(fast->getId(), slow->getId());
+    EXPECT_EQ(manager.getWorld(slow->getId()), slow);
+    fast->setFixedTimeStep(1.F / 60.F);
+    slow->setFixedTimeStep(1.F / 20.F);
+    fast->setTickBudget(1000.F);
+
+    for (int i = 0; i < 10; ++i) {
+        manager.tick(0.05F);
+    }
+    EXPECT_NEAR(static_cast<float>(fast->getStepCount()), 30.F, 1.F);
+    EXPECT_NEAR(static_cast<float>(slow->getStepCount()), 10.F, 1.F);
+    EXPECT_EQ(fast->getStats().overBudgetTicks, 0U);
+    EXPECT_GT(fast->getStats().averageBudgetUsage, 0.F);
+    EXPECT_GE(fast->getStats().maxTickMs, fast->getStats().lastTickMs);
+
+    manager.destroyWorld(fast);
+    EXPECT_EQ(manager.getWorlds().size(), 1U);
+    EXPECT_EQ(manager.getWorld(slow->getId()), slow);
+}
+
+TEST(serverWorldTest, animation) {
+    ServerWorldManager manager;
+    auto *first = manager.createWorld();
+    auto *second = manager.createWorld();
+    EXPECT_TRUE(first->isAnimationEnabled());
+    EXPECT_FALSE(second->isAnimationEnabled());
+
+    uint32_t animationSteps = 0;
+    events::ServerAnimationStep::Listener listener;
+    listener.bind([&](float dt) {
+        EXPECT_FLOAT_EQ(dt, ServerWorld::DEFAULT_FIXED_TIME_STEP);
+        ++animationSteps;
+    });
+
+    // both worlds step, animation is only advanced once per step
+    manager.tick(ServerWorld::DEFAULT_FIXED_TIME_STEP * 2.5F);
+    EXPECT_EQ(first->getStepCount(), 2U);
+    EXPECT_EQ(second->getStepCount(), 2U);
+    EXPECT_EQ(animationSteps, 2U);
+
+    // a second world can't advance the animation states of the VM as well
+    EXPECT_FALSE(second->setAnimationEnabled(true));
+    EXPECT_FALSE(second->isAnimationEnabled());
+    manager.tick(ServerWorld::DEFAULT_FIXED_TIME_STEP);
+    EXPECT_EQ(animationSteps, 3U);
+
+    // until the first one gives it up
+    EXPECT_TRUE(first->setAnimationEnabled(false));
+    EXPECT_TRUE(second->setAnimationEnabled(true));
+    EXPECT_FALSE(first->setAnimationEnabled(true));
+    EXPECT_TRUE(second->setAnimationEnabled(false));
+    EXPECT_TRUE(first->setAnimationEnabled(true));
+
+    // the next world takes over the animation, also when the destroyed world is still referenced
+    IntrusivePtr<ServerWorld> destroyed{first};
+    manager.destroyWorld(first);
+    EXPECT_FALSE(destroyed->isAnimationEnabled());
+    EXPECT_TRUE(second->isAnimationEnabled());
+}
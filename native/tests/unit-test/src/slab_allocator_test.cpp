@@ -0,0 +1,197 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include "base/Ptr.h"
+#include "base/RefCounted.h"
+#include "base/std/container/vector.h"
+#include "core/memop/SlabAllocator.h"
+#include "gtest/gtest.h"
+
+using namespace cc;
+
+namespace {
+
+class Particle : public RefCounted {
+    CC_SLAB_ALLOCATED
+
+public:
+    ~Particle() override = default;
+
+    float position[4]{};
+    float velocity[4]{};
+    uint32_t id{0};
+};
+
+CC_SLAB_ALLOCATOR_IMPL(Particle, 1024)
+
+class BigParticle final : public Particle {
+public:
+    float extra[16]{};
+};
+
+class HeapParticle : public RefCounted {
+public:
+    float position[4]{};
+    float velocity[4]{};
+    uint32_t id{0};
+};
+
+} // namespace
+
+TEST(SlabAllocatorTest, reuseAndStats) {
+    memop::SlabAllocator allocator("test", 40, 8, 4);
+    EXPECT_EQ(allocator.getSlotSize(), 40);
+
+    ccstd::vector<void *> ptrs;
+    for (int i = 0; i < 6; ++i) {
+        ptrs.push_back(allocator.allocate(40));
+    }
+    auto stats = allocator.getStats();
+    EXPECT_EQ(stats.slabCount, 2);
+    EXPECT_EQ(stats.capacity, 8);
+    EXPECT_EQ(stats.liveObjects, 6);
+    EXPECT_FLOAT_EQ(stats.getOccupancy(), 0.75F);
+    EXPECT_FLOAT_EQ(stats.getFragmentation(), 0.F);
+
+    // freed slots are handed out again, most recent first
+    allocator.deallocate(ptrs[1], 40);
+    allocator.deallocate(ptrs[4], 40);
+    allocator.deallocate(ptrs[5], 40);
+    stats = allocator.getStats();
+    EXPECT_EQ(stats.liveObjects, 3);
+    EXPECT_EQ(stats.peakLiveObjects, 6);
+    EXPECT_FLOAT_EQ(stats.getFragmentation(), 0.5F);
+    EXPECT_EQ(allocator.allocate(40), ptrs[5]);
+    EXPECT_EQ(allocator.allocate(40), ptrs[4]);
+    EXPECT_EQ(allocator.allocate(40), ptrs[1]);
+    EXPECT_EQ(allocator.getStats().slabCount, 2);
+
+    // larger requests go to the heap
+    void *big = allocator.allocate(100);
+    EXPECT_FALSE(allocator.owns(big));
+    EXPECT_TRUE(allocator.owns(ptrs[0]));
+    EXPECT_EQ(allocator.getStats().overflowAllocations, 1);
+    allocator.deallocate(big, 100);
+
+    for (auto *ptr : ptrs) {
+        allocator.deallocate(ptr);
+    }
+    EXPECT_EQ(allocator.getStats().liveObjects, 0);
+}
+
+TEST(SlabAllocatorTest, reserve) {
+    memop::SlabAllocator allocator("reserve", 16, 16, 8);
+    void *first = allocator.allocate(16);
+    allocator.reserve(20);
+    auto stats = allocator.getStats();
+    EXPECT_EQ(stats.slabCount, 3);
+    EXPECT_GE(stats.capacity, 20);
+
+    // pre-warmed slots are used before any new slab is allocated
+    ccstd::vector<void *> ptrs;
+    for (uint32_t i = 1; i < stats.capacity; ++i) {
+        void *ptr = allocator.allocate(16);
+        EXPECT_TRUE(allocator.owns(ptr));
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % 16, 0);
+        ptrs.push_back(ptr);
+    }
+    EXPECT_EQ(allocator.getStats().slabCount, 3);
+    EXPECT_EQ(allocator.getStats().liveObjects, stats.capacity);
+
+    allocator.deallocate(first, 16);
+    for (auto *ptr : ptrs) {
+        allocator.deallocate(ptr, 16);
+    }
+}
+
+TEST(SlabAllocatorTest, classOperators) {
+    auto &allocator = Particle::getSlabAllocator();
+    const auto before = allocator.getStats();
+
+    IntrusivePtr<Particle> particle = ccnew Particle();
+    IntrusivePtr<Particle> big = ccnew BigParticle();
+    EXPECT_TRUE(allocator.owns(particle.get()));
+    EXPECT_FALSE(allocator.owns(big.get()));
+
+    auto stats = allocator.getStats();
+    EXPECT_EQ(stats.liveObjects, before.liveObjects + 1);
+    EXPECT_EQ(stats.overflowAllocations, before.overflowAllocations + 1);
+
+    Particle *address = particle.get();
+    particle = nullptr;
+    big = nullptr;
+    EXPECT_EQ(allocator.getStats().liveObjects, before.liveObjects);
+    particle = ccnew Particle();
+    EXPECT_EQ(particle.get(), address);
+
+    bool found = false;
+    for (const auto &allStats : memop::SlabAllocator::getAllStats()) {
+        found |= std::strcmp(allStats.name, "Particle") == 0;
+    }
+    EXPECT_TRUE(found);
+}
+
+namespace {
+
+template <typename T>
+double spawnDespawn(uint32_t frames, uint32_t perFrame, uint32_t lifetime) {
+    ccstd::vector<ccstd::vector<IntrusivePtr<T>>> generations(lifetime);
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t frame = 0; frame < frames; ++frame) {
+        // despawn the oldest generation and spawn a new one in its place
+        auto &generation = generations[frame % lifetime];
+        generation.clear();
+        for (uint32_t i = 0; i < perFrame; ++i) {
+            auto *obj = ccnew T();
+            obj->id = i;
+            generation.emplace_back(obj);
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+} // namespace
+
+TEST(SlabAllocatorTest, DISABLED_spawnDespawnBenchmark) {
+    // 100k spawns and 100k despawns per second at 60 fps, for 10 seconds
+    constexpr uint32_t FRAMES = 600;
+    constexpr uint32_t PER_FRAME = 100000 / 60;
+    constexpr uint32_t LIFETIME = 30;
+
+    Particle::getSlabAllocator().reserve(PER_FRAME * LIFETIME);
+    const uint32_t reservedSlabs = Particle::getSlabAllocator().getStats().slabCount;
+    const double slabMs = spawnDespawn<Particle>(FRAMES, PER_FRAME, LIFETIME);
+    const double heapMs = spawnDespawn<HeapParticle>(FRAMES, PER_FRAME, LIFETIME);
+
+    const auto stats = Particle::getSlabAllocator().getStats();
+    printf("spawn/despawn %u objects: slab %.2f ms, heap %.2f ms, slabs %u, peak %u\n",
+           FRAMES * PER_FRAME, slabMs, heapMs, stats.slabCount, stats.peakLiveObjects);
+    EXPECT_EQ(stats.liveObjects, 0);
+    // steady churn is served entirely by the pre-warmed slabs
+    EXPECT_EQ(stats.slabCount, reservedSlabs);
+}
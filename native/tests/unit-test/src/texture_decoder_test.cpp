@@ -0,0 +1,228 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include "base/astc.h"
+#include "base/etc2.h"
+#include "base/std/container/vector.h"
+#include "core/assets/TextureDecoder.h"
+#include "gtest/gtest.h"
+
+using namespace cc;
+
+namespace {
+
+constexpr uint32_t STRIDE = 4 * 4;
+
+void setBits(uint8_t *block, uint32_t start, uint32_t count, uint32_t value) {
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint32_t bit = start + i;
+        if ((value >> i) & 1U) {
+            block[bit >> 3] |= static_cast<uint8_t>(1U << (bit & 7U));
+        }
+    }
+}
+
+// ASTC weights are stored bit reversed from the top of the block
+void setReversedBits(uint8_t *block, uint32_t start, uint32_t count, uint32_t value) {
+    for (uint32_t i = 0; i < count; ++i) {
+        if ((value >> i) & 1U) {
+            setBits(block, 127 - (start + i), 1, 1);
+        }
+    }
+}
+
+// 4x4 block, one partition, direct RGB endpoints and 2 bit weights
+void makeASTCBlock(uint8_t *block, const uint8_t *endpoints, const uint32_t *weights) {
+    memset(block, 0, ASTC_BLOCK_SIZE);
+    setBits(block, 0, 11, 0x42);
+    setBits(block, 13, 4, 8);
+    for (uint32_t i = 0; i < 6; ++i) {
+        setBits(block, 17 + i * 8, 8, endpoints[i]);
+    }
+    for (uint32_t i = 0; i < 16; ++i) {
+        setReversedBits(block, i * 2, 2, weights[i]);
+    }
+}
+
+const uint8_t *texel(const uint8_t *out, uint32_t x, uint32_t y) {
+    return out + y * STRIDE + x * 4;
+}
+
+} // namespace
+
+TEST(TextureDecoderTest, etc1Individual) {
+    // R 0x8, G 0x4, B 0xC in both sub blocks, codeword 0: {2, 8, -2, -8}
+    uint8_t block[ETC2_ENCODED_BLOCK_SIZE] = {0x88, 0x44, 0xCC, 0x00, 0x00, 0x10, 0x00, 0x11};
+    uint8_t out[STRIDE * 4];
+    etc2_decode_rgb_block(block, out, STRIDE, false);
+
+    const uint8_t *p = texel(out, 0, 0);
+    EXPECT_EQ(p[0], 144);
+    EXPECT_EQ(p[1], 76);
+    EXPECT_EQ(p[2], 212);
+    EXPECT_EQ(p[3], 255);
+    p = texel(out, 1, 0);
+    EXPECT_EQ(p[0], 128);
+    EXPECT_EQ(p[1], 60);
+    EXPECT_EQ(p[2], 196);
+    p = texel(out, 3, 3);
+    EXPECT_EQ(p[0], 138);
+    EXPECT_EQ(p[1], 70);
+    EXPECT_EQ(p[2], 206);
+}
+
+TEST(TextureDecoderTest, etc2Differential) {
+    // base (16, 8, 24), the right sub block adds 3 to red
+    uint8_t block[ETC2_ENCODED_BLOCK_SIZE] = {16 << 3 | 3, 8 << 3, 24 << 3, 0x02, 0x00, 0x00, 0x00, 0x00};
+    uint8_t out[STRIDE * 4];
+    etc2_decode_rgb_block(block, out, STRIDE, false);
+
+    const uint8_t *p = texel(out, 1, 3);
+    EXPECT_EQ(p[0], 134);
+    EXPECT_EQ(p[1], 68);
+    EXPECT_EQ(p[2], 200);
+    p = texel(out, 2, 0);
+    EXPECT_EQ(p[0], 158);
+    EXPECT_EQ(p[1], 68);
+    EXPECT_EQ(p[2], 200);
+}
+
+TEST(TextureDecoderTest, eacAlpha) {
+    // base 128, multiplier 1, table 0, index 4 (+2) everywhere but index 7 (+14) on the first texel
+    uint8_t block[ETC2_ENCODED_BLOCK_SIZE] = {128, 0x10, 0xF2, 0x49, 0x24, 0x92, 0x49, 0x24};
+    uint8_t out[STRIDE * 4] = {};
+    etc2_decode_eac_block(block, out, STRIDE, 3);
+
+    EXPECT_EQ(texel(out, 0, 0)[3], 142);
+    EXPECT_EQ(texel(out, 0, 1)[3], 130);
+    EXPECT_EQ(texel(out, 3, 3)[3], 130);
+    EXPECT_EQ(texel(out, 3, 3)[0], 0);
+}
+
+TEST(TextureDecoderTest, astcVoidExtent) {
+    uint8_t block[ASTC_BLOCK_SIZE] = {0xFC, 0xFD, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                                      0xFF, 0xFF, 0x00, 0x80, 0x00, 0x00, 0xFF, 0xFF};
+    uint8_t out[6 * 6 * 4];
+    EXPECT_TRUE(astcDecodeBlock(block, 6, 6, out, 6 * 4));
+    for (uint32_t i = 0; i < 6 * 6; ++i) {
+        EXPECT_EQ(out[i * 4 + 0], 255);
+        EXPECT_EQ(out[i * 4 + 1], 128);
+        EXPECT_EQ(out[i * 4 + 2], 0);
+        EXPECT_EQ(out[i * 4 + 3], 255);
+    }
+}
+
+TEST(TextureDecoderTest, astcDirectRGB) {
+    const uint8_t endpoints[6] = {0, 255, 0, 255, 0, 255};
+    const uint32_t weights[16] = {0, 1, 2, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3};
+    uint8_t block[ASTC_BLOCK_SIZE];
+    makeASTCBlock(block, endpoints, weights);
+
+    uint8_t out[STRIDE * 4];
+    EXPECT_TRUE(astcDecodeBlock(block, 4, 4, out, STRIDE));
+    // QUANT_4 weights unquantize to 0, 21, 43, 64
+    const uint8_t expected[4] = {0, 84, 171, 255};
+    for (uint32_t x = 0; x < 4; ++x) {
+        EXPECT_EQ(texel(out, x, 0)[0], expected[x]);
+        EXPECT_EQ(texel(out, x, 0)[1], expected[x]);
+        EXPECT_EQ(texel(out, x, 0)[2], expected[x]);
+        EXPECT_EQ(texel(out, x, 0)[3], 255);
+    }
+    EXPECT_EQ(texel(out, 2, 3)[0], 255);
+
+    // reserved block modes decode to the error color
+    memset(block, 0, ASTC_BLOCK_SIZE);
+    EXPECT_FALSE(astcDecodeBlock(block, 4, 4, out, STRIDE));
+    EXPECT_EQ(texel(out, 0, 0)[0], 255);
+    EXPECT_EQ(texel(out, 0, 0)[1], 0);
+    EXPECT_EQ(texel(out, 0, 0)[2], 255);
+}
+
+TEST(TextureDecoderTest, croppedImage) {
+    uint8_t block[ETC2_ENCODED_BLOCK_SIZE] = {0x88, 0x44, 0xCC, 0x00, 0x00, 0x00, 0x00, 0x00};
+    ccstd::vector<uint8_t> src;
+    for (uint32_t i = 0; i < 4; ++i) {
+        src.insert(src.end(), block, block + ETC2_ENCODED_BLOCK_SIZE);
+    }
+    ccstd::vector<uint8_t> dst(6 * 5 * 4);
+    EXPECT_TRUE(TextureDecoder::decode(gfx::Format::ETC_RGB8, src.data(), 6, 5, dst.data()));
+    EXPECT_EQ(dst[(4 * 6 + 5) * 4 + 0], 138);
+    EXPECT_EQ(dst[(4 * 6 + 5) * 4 + 3], 255);
+
+    EXPECT_EQ(TextureDecoder::getDecodedFormat(gfx::Format::ETC2_SRGB8), gfx::Format::SRGB8_A8);
+    EXPECT_EQ(TextureDecoder::getDecodedFormat(gfx::Format::ASTC_RGBA_8X8), gfx::Format::RGBA8);
+    EXPECT_FALSE(TextureDecoder::decode(gfx::Format::RGBA8, src.data(), 4, 4, dst.data()));
+}
+
+TEST(TextureDecoderTest, DISABLED_throughput) {
+    constexpr uint32_t SIZE = 1024;
+    constexpr uint32_t ROUNDS = 8;
+
+    const uint8_t endpoints[6] = {10, 240, 20, 230, 30, 220};
+    const uint32_t weights[16] = {0, 1, 2, 3, 1, 2, 3, 0, 2, 3, 0, 1, 3, 0, 1, 2};
+    uint8_t astcBlock[ASTC_BLOCK_SIZE];
+    makeASTCBlock(astcBlock, endpoints, weights);
+
+    struct Case {
+        const char *name;
+        gfx::Format format;
+        uint32_t blockBytes;
+    };
+    const Case cases[] = {
+        {"ETC2_RGB8", gfx::Format::ETC2_RGB8, 8},
+        {"ETC2_RGBA8", gfx::Format::ETC2_RGBA8, 16},
+        {"ASTC_4X4", gfx::Format::ASTC_RGBA_4X4, 16},
+    };
+
+    ccstd::vector<uint8_t> dst(SIZE * SIZE * 4);
+    for (const auto &c : cases) {
+        const uint32_t blockCount = (SIZE / 4) * (SIZE / 4);
+        ccstd::vector<uint8_t> src(blockCount * c.blockBytes);
+        uint32_t seed = 1;
+        for (uint32_t i = 0; i < blockCount; ++i) {
+            uint8_t *pBlock = src.data() + i * c.blockBytes;
+            if (c.format == gfx::Format::ASTC_RGBA_4X4) {
+                memcpy(pBlock, astcBlock, ASTC_BLOCK_SIZE);
+                continue;
+            }
+            // random ETC2 blocks cover every mode
+            for (uint32_t b = 0; b < c.blockBytes; ++b) {
+                seed = seed * 1664525U + 1013904223U;
+                pBlock[b] = static_cast<uint8_t>(seed >> 24);
+            }
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < ROUNDS; ++i) {
+            EXPECT_TRUE(TextureDecoder::decode(c.format, src.data(), SIZE, SIZE, dst.data()));
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        const double megabytes = static_cast<double>(dst.size()) * ROUNDS / (1024.0 * 1024.0);
+        printf("%-10s decoded %.0f MB of RGBA8 at %.1f MB/s\n", c.name, megabytes, megabytes / elapsed.count());
+    }
+}
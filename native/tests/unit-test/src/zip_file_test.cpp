@@ -0,0 +1,204 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <zlib.h>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include "base/ZipUtils.h"
+#include "base/std/container/string.h"
+#include "base/std/container/vector.h"
+#include "gtest/gtest.h"
+
+using namespace cc;
+
+namespace {
+
+struct TestEntry {
+    ccstd::string name;
+    ccstd::string content;
+    bool deflate;
+};
+
+void writeLE16(ccstd::vector<unsigned char> &out, uint32_t value) {
+    out.push_back(static_cast<unsigned char>(value));
+    out.push_back(static_cast<unsigned char>(value >> 8));
+}
+
+void writeLE32(ccstd::vector<unsigned char> &out, uint32_t value) {
+    writeLE16(out, value & 0xFFFF);
+    writeLE16(out, value >> 16);
+}
+
+ccstd::string rawDeflate(const ccstd::string &content) {
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+    ccstd::string out(deflateBound(&stream, static_cast<uLong>(content.size())), '\0');
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(content.data()));
+    stream.avail_in = static_cast<uInt>(content.size());
+    stream.next_out = reinterpret_cast<Bytef *>(&out[0]);
+    stream.avail_out = static_cast<uInt>(out.size());
+    deflate(&stream, Z_FINISH);
+    out.resize(stream.total_out);
+    deflateEnd(&stream);
+    return out;
+}
+
+// A minimal zip archive: local headers and data, then the central directory.
+ccstd::vector<unsigned char> makeZip(const ccstd::vector<TestEntry> &entries) {
+    ccstd::vector<unsigned char> zip;
+    ccstd::vector<unsigned char> directory;
+    for (const auto &entry : entries) {
+        const ccstd::string data = entry.deflate ? rawDeflate(entry.content) : entry.content;
+        const auto crc = static_cast<uint32_t>(crc32(0, reinterpret_cast<const Bytef *>(entry.content.data()), static_cast<uInt>(entry.content.size())));
+        const auto method = entry.deflate ? Z_DEFLATED : 0;
+        const auto offset = static_cast<uint32_t>(zip.size());
+
+        writeLE32(zip, 0x04034b50);
+        writeLE16(zip, 20);
+        writeLE16(zip, 0);
+        writeLE16(zip, method);
+        writeLE32(zip, 0);
+        writeLE32(zip, crc);
+        writeLE32(zip, static_cast<uint32_t>(data.size()));
+        writeLE32(zip, static_cast<uint32_t>(entry.content.size()));
+        writeLE16(zip, static_cast<uint32_t>(entry.name.size()));
+        writeLE16(zip, 4); // an extra field only the local header has
+        zip.insert(zip.end(), entry.name.begin(), entry.name.end());
+        writeLE32(zip, 0xCAFE0000);
+        zip.insert(zip.end(), data.begin(), data.end());
+
+        writeLE32(directory, 0x02014b50);
+        writeLE16(directory, 20);
+        writeLE16(directory, 20);
+        writeLE16(directory, 0);
+        writeLE16(directory, method);
+        writeLE32(directory, 0);
+        writeLE32(directory, crc);
+        writeLE32(directory, static_cast<uint32_t>(data.size()));
+        writeLE32(directory, static_cast<uint32_t>(entry.content.size()));
+        writeLE16(directory, static_cast<uint32_t>(entry.name.size()));
+        writeLE16(directory, 0);
+        writeLE16(directory, 0);
+        writeLE16(directory, 0);
+        writeLE16(directory, 0);
+        writeLE32(directory, 0);
+        writeLE32(directory, offset);
+        directory.insert(directory.end(), entry.name.begin(), entry.name.end());
+    }
+
+    const auto directoryOffset = static_cast<uint32_t>(zip.size());
+    zip.insert(zip.end(), directory.begin(), directory.end());
+    writeLE32(zip, 0x06054b50);
+    writeLE16(zip, 0);
+    writeLE16(zip, 0);
+    writeLE16(zip, static_cast<uint32_t>(entries.size()));
+    writeLE16(zip, static_cast<uint32_t>(entries.size()));
+    writeLE32(zip, static_cast<uint32_t>(directory.size()));
+    writeLE32(zip, directoryOffset);
+    writeLE16(zip, 0);
+    return zip;
+}
+
+ccstd::vector<TestEntry> makeEntries() {
+    ccstd::vector<TestEntry> entries;
+    for (uint32_t i = 0; i < 16; ++i) {
+        ccstd::string content;
+        for (uint32_t j = 0; j < 1000 + i * 100; ++j) {
+            content += static_cast<char>('a' + (i + j / 7) % 26);
+        }
+        entries.push_back({"assets/file" + std::to_string(i), content, (i & 1U) != 0});
+    }
+    entries.push_back({"assets/empty", "", false});
+    entries.push_back({"other/file", "outside of the filter", false});
+    return entries;
+}
+
+} // namespace
+
+TEST(ZipFileTest, concurrentReads) {
+    const auto entries = makeEntries();
+    const auto zip = makeZip(entries);
+    std::unique_ptr<ZipFile> zipFile(ZipFile::createWithBuffer(zip.data(), static_cast<uint32_t>(zip.size())));
+    ASSERT_NE(zipFile, nullptr);
+    ASSERT_TRUE(zipFile->enableConcurrentReads());
+    EXPECT_TRUE(zipFile->isConcurrentReadsEnabled());
+
+    ccstd::vector<std::thread> threads;
+    ccstd::vector<uint32_t> mismatches(4, 0);
+    for (uint32_t t = 0; t < mismatches.size(); ++t) {
+        threads.emplace_back([&, t]() {
+            for (uint32_t round = 0; round < 200; ++round) {
+                for (const auto &entry : entries) {
+                    uint32_t size = 0;
+                    unsigned char *data = zipFile->getFileData(entry.name, &size);
+                    if (!data || size != entry.content.size() || memcmp(data, entry.content.data(), size) != 0) {
+                        ++mismatches[t];
+                    }
+                    free(data);
+
+                    ccstd::string buffer;
+                    ResizableBufferAdapter<ccstd::string> adapter(&buffer);
+                    if (!zipFile->getFileData(entry.name, &adapter) || buffer != entry.content) {
+                        ++mismatches[t];
+                    }
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    for (auto count : mismatches) {
+        EXPECT_EQ(count, 0);
+    }
+}
+
+TEST(ZipFileTest, storedEntryView) {
+    const auto entries = makeEntries();
+    const auto zip = makeZip(entries);
+    std::unique_ptr<ZipFile> zipFile(ZipFile::createWithBuffer(zip.data(), static_cast<uint32_t>(zip.size())));
+    ASSERT_NE(zipFile, nullptr);
+
+    uint32_t size = 1;
+    EXPECT_EQ(zipFile->getFileView("assets/file0", &size), nullptr);
+    EXPECT_EQ(size, 0);
+    ASSERT_TRUE(zipFile->enableConcurrentReads());
+
+    // stored entries point into the archive, deflated ones have no view
+    const unsigned char *view = zipFile->getFileView("assets/file0", &size);
+    ASSERT_NE(view, nullptr);
+    EXPECT_GE(view, zip.data());
+    EXPECT_LT(view, zip.data() + zip.size());
+    EXPECT_EQ(size, entries[0].content.size());
+    EXPECT_EQ(memcmp(view, entries[0].content.data(), size), 0);
+    EXPECT_EQ(zipFile->getFileView("assets/file1", &size), nullptr);
+    EXPECT_EQ(zipFile->getFileView("missing", &size), nullptr);
+
+    ASSERT_TRUE(zipFile->setFilter("assets/"));
+    EXPECT_EQ(zipFile->getFileView("other/file", &size), nullptr);
+    EXPECT_NE(zipFile->getFileView("assets/file2", &size), nullptr);
+}